@@ -0,0 +1 @@
+../../src/cluster/inverted_index.h
\ No newline at end of file
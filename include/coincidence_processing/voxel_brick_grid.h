@@ -0,0 +1 @@
+../../src/coincidence_processing/voxel_brick_grid.h
\ No newline at end of file
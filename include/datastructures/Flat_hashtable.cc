@@ -0,0 +1 @@
+../../src/datastructures/Flat_hashtable.cc
\ No newline at end of file
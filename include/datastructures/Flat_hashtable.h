@@ -0,0 +1 @@
+../../src/datastructures/Flat_hashtable.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/datastructures/packed_descriptor.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/delaunay/delaunay_triangulator.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/general/numeric_text_reader.h
\ No newline at end of file
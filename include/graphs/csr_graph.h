@@ -0,0 +1 @@
+../../src/graphs/csr_graph.h
\ No newline at end of file
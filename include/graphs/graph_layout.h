@@ -0,0 +1 @@
+../../src/graphs/graph_layout.h
\ No newline at end of file
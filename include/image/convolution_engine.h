@@ -0,0 +1 @@
+../../src/image/convolution_engine.h
\ No newline at end of file
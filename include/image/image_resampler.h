@@ -0,0 +1 @@
+../../src/image/image_resampler.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/image/rank_filter.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/messenger/loopback_transport.h
\ No newline at end of file
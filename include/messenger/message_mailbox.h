@@ -0,0 +1 @@
+../../src/messenger/message_mailbox.h
\ No newline at end of file
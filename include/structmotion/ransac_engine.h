@@ -0,0 +1 @@
+../../src/structmotion/ransac_engine.h
\ No newline at end of file
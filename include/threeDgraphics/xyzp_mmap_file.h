@@ -0,0 +1 @@
+../../src/threeDgraphics/xyzp_mmap_file.h
\ No newline at end of file
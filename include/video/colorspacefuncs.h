@@ -0,0 +1 @@
+../../src/video/colorspacefuncs.h
\ No newline at end of file
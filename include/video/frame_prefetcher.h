@@ -0,0 +1 @@
+../../src/video/frame_prefetcher.h
\ No newline at end of file
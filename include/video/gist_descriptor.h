@@ -0,0 +1 @@
+../../src/video/gist_descriptor.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/video/image_pair_scheduler.h
\ No newline at end of file
@@ -1,7 +1,7 @@
 // ==========================================================================
 // LatLong to UTM conversion methods
 // ==========================================================================
-// Last modified on 8/28/09; 2/5/10; 5/9/11; 4/4/14
+// Last modified on 8/28/09; 2/5/10; 5/9/11; 4/4/14; 10/18/26
 // ==========================================================================
 
 // Lat Long - UTM, UTM - Lat Long conversions
@@ -20,6 +20,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "astro_geo/Ellipsoid.h"
 #include "astro_geo/latlong2utmfuncs.h"
 #include "math/threevector.h"
@@ -632,4 +635,440 @@ namespace latlongfunc
       }
 
 
+// ==========================================================================
+// Batched conversion methods
+// ==========================================================================
+
+// The following methods convert spans of n_points coordinates stored
+// within contiguous arrays.  Ellipsoid dependent series coefficients
+// are computed once per batch rather than once per point.  Each point
+// requires a single sine/cosine pair evaluation, for multiple angle
+// sines are generated via recurrences and tangents via ratios.  The
+// inner loops still call libm's scalar sin(), cos() and atan2() and
+// branch upon UTM zone selection.  So they are not auto-vectorized.
+// Speedups come from the hoisted constants, fewer transcendental
+// calls per point and threading.  Batches are divided into contiguous
+// chunks which are processed by OpenMP threads.  Results agree with
+// those from the scalar methods to within floating point roundoff.
+
+// Batches are divided into chunks of at least min_batch_chunk_size
+// points so that short spans such as tile corners are not swamped by
+// thread startup costs:
+
+   static const unsigned int min_batch_chunk_size=4096;
+
+   struct UTM_series_constants
+   {
+      double a,eccSquared,eccPrimeSquared,k0;
+      double M1,M2,M4,M6;
+      double mu_denom,e1_2,e1_4,e1_6;
+   };
+
+// --------------------------------------------------------------------------
+// Method batch_n_threads returns the number of OpenMP threads which
+// should process a batch containing n_points.
+
+   int batch_n_threads(unsigned int n_points,int n_threads)
+      {
+#ifdef _OPENMP
+         if (n_threads <= 0) n_threads=omp_get_max_threads();
+#else
+         n_threads=1;
+#endif
+         int max_n_threads=n_points/min_batch_chunk_size;
+         if (max_n_threads < 1) max_n_threads=1;
+         if (n_threads > max_n_threads) n_threads=max_n_threads;
+         return n_threads;
+      }
+
+// --------------------------------------------------------------------------
+// Method compute_UTM_series_constants fills the meridional arc and
+// footpoint latitude coefficients which appear within LLtoUTM() and
+// UTMtoLL() for the specified reference ellipsoid.
+
+   void compute_UTM_series_constants(
+      int ReferenceEllipsoid,UTM_series_constants& K)
+      {
+         K.a=ellipsoid[ReferenceEllipsoid].get_EquatorialRadius();
+         double e2=ellipsoid[ReferenceEllipsoid].get_eccentricitySquared();
+         double e4=e2*e2;
+         double e6=e4*e2;
+         K.eccSquared=e2;
+         K.eccPrimeSquared=e2/(1-e2);
+         K.k0=0.9996;
+
+         K.M1=K.a*(1-e2/4-3*e4/64-5*e6/256);
+         K.M2=K.a*(3*e2/8+3*e4/32+45*e6/1024);
+         K.M4=K.a*(15*e4/256+45*e6/1024);
+         K.M6=K.a*(35*e6/3072);
+
+         K.mu_denom=K.M1;
+         double e1=(1-sqrt(1-e2))/(1+sqrt(1-e2));
+         double e1_sqr=e1*e1;
+         K.e1_2=3*e1/2-27*e1*e1_sqr/32;
+         K.e1_4=21*e1_sqr/16-55*e1_sqr*e1_sqr/32;
+         K.e1_6=151*e1*e1_sqr/96;
+      }
+
+// --------------------------------------------------------------------------
+// Method UTM_zone_number reproduces LLtoUTM()'s zone selection
+// including its Norway and Svalbard exceptions.  Input LongTemp must
+// already be normalized.
+
+   int UTM_zone_number(double Lat,double LongTemp)
+      {
+         int ZoneNumber = int((LongTemp + 180)/6) + 1;
+
+         if( Lat >= 56.0 && Lat < 64.0 && LongTemp >= 3.0 && LongTemp < 12.0 )
+            ZoneNumber = 32;
+
+         if( Lat >= 72.0 && Lat < 84.0 )
+         {
+            if(      LongTemp >= 0.0  && LongTemp <  9.0 ) ZoneNumber = 31;
+            else if( LongTemp >= 9.0  && LongTemp < 21.0 ) ZoneNumber = 33;
+            else if( LongTemp >= 21.0 && LongTemp < 33.0 ) ZoneNumber = 35;
+            else if( LongTemp >= 33.0 && LongTemp < 42.0 ) ZoneNumber = 37;
+         }
+         return ZoneNumber;
+      }
+
+// --------------------------------------------------------------------------
+// Method UTM_series evaluates USGS Bulletin 1532's transverse Mercator
+// series for a single point whose longitude relative to its zone's
+// central meridian equals dLongRad.  The returned northing does not
+// include the southern hemisphere's 1E7 meter offset.  Series terms
+// are nested in Horner form.
+
+   inline void UTM_series(
+      const UTM_series_constants& K,double LatRad,double dLongRad,
+      double& northing,double& easting)
+      {
+         double s=sin(LatRad);
+         double c=cos(LatRad);
+         double t=s/c;
+         double T=t*t;
+         double C=K.eccPrimeSquared*c*c;
+         double N=K.a/sqrt(1-K.eccSquared*s*s);
+         double A=c*dLongRad;
+         double A2=A*A;
+
+// sin(2 phi), sin(4 phi) and sin(6 phi) follow from double and triple
+// angle recurrences:
+
+         double sin2=2*s*c;
+         double cos2=c*c-s*s;
+         double sin4=2*sin2*cos2;
+         double cos4=cos2*cos2-sin2*sin2;
+         double sin6=sin4*cos2+cos4*sin2;
+         double M=K.M1*LatRad-K.M2*sin2+K.M4*sin4-K.M6*sin6;
+
+         double ep2=K.eccPrimeSquared;
+         easting=K.k0*N*A*(
+            1+A2*((1-T+C)/6
+                  +A2*(5-18*T+T*T+72*C-58*ep2)/120))+500000.0;
+         northing=K.k0*(
+            M+N*t*A2*(0.5+A2*((5-T+9*C+4*C*C)/24
+                              +A2*(61-58*T+T*T+600*C-330*ep2)/720)));
+      }
+
+// --------------------------------------------------------------------------
+// Method UTM_inverse_series evaluates UTMtoLL()'s footpoint latitude
+// series for a single point whose northing and easting offsets
+// (without false easting or southern hemisphere offset) equal x and
+// y.  Latitude and longitude relative to the zone's central meridian
+// are returned in radians.
+
+   inline void UTM_inverse_series(
+      const UTM_series_constants& K,double x,double y,
+      double& LatRad,double& dLongRad)
+      {
+         double mu=y/(K.k0*K.mu_denom);
+         double s_mu=sin(mu);
+         double c_mu=cos(mu);
+         double sin2=2*s_mu*c_mu;
+         double cos2=c_mu*c_mu-s_mu*s_mu;
+         double sin4=2*sin2*cos2;
+         double cos4=cos2*cos2-sin2*sin2;
+         double sin6=sin4*cos2+cos4*sin2;
+         double phi1=mu+K.e1_2*sin2+K.e1_4*sin4+K.e1_6*sin6;
+
+         double s=sin(phi1);
+         double c=cos(phi1);
+         double t=s/c;
+         double T1=t*t;
+         double C1=K.eccPrimeSquared*c*c;
+         double w=1-K.eccSquared*s*s;
+         double sqrt_w=sqrt(w);
+         double N1=K.a/sqrt_w;
+         double R1=K.a*(1-K.eccSquared)/(w*sqrt_w);
+         double D=x/(N1*K.k0);
+         double D2=D*D;
+
+         double ep2=K.eccPrimeSquared;
+         LatRad=phi1-(N1*t/R1)*D2*(
+            0.5-D2*((5+3*T1+10*C1-4*C1*C1-9*ep2)/24
+                    -D2*(61+90*T1+298*C1+45*T1*T1-252*ep2-3*C1*C1)/720));
+         dLongRad=D*(
+            1-D2*((1+2*T1+C1)/6
+                  -D2*(5-2*C1+28*T1-3*C1*C1+8*ep2+24*T1*T1)/120))/c;
+      }
+
+// --------------------------------------------------------------------------
+// Method batch_LLtoUTM converts n_points lat/long pairs to UTM
+// coordinates.  Each point is assigned the same zone number,
+// hemisphere flag, northing and easting as LLtoUTM() returns.
+
+   void batch_LLtoUTM(
+      const double* Lat,const double* Long,unsigned int n_points,
+      int* ZoneNumber,bool* northern_hemisphere_flag,
+      double* UTMNorthing,double* UTMEasting,
+      int ReferenceEllipsoid,int n_threads)
+      {
+         UTM_series_constants K;
+         compute_UTM_series_constants(ReferenceEllipsoid,K);
+         n_threads=batch_n_threads(n_points,n_threads);
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+         for (int i=0; i<int(n_points); i++)
+         {
+            double LongTemp = 
+               (Long[i]+180)-int((Long[i]+180)/360)*360-180;
+            int zone=UTM_zone_number(Lat[i],LongTemp);
+            double LongOriginRad=((zone - 1)*6 - 180 + 3)*DEG2RAD;
+
+            UTM_series(K,Lat[i]*DEG2RAD,LongTemp*DEG2RAD-LongOriginRad,
+                       UTMNorthing[i],UTMEasting[i]);
+            UTMNorthing[i] += (Lat[i] < 0) ? 10000000.0 : 0.0;
+            ZoneNumber[i]=zone;
+            northern_hemisphere_flag[i]=(Lat[i] >= 0);
+         }
+      }
+
+// --------------------------------------------------------------------------
+// Method batch_LL_to_northing_easting converts n_points long/lat
+// pairs to eastings and northings within the specified UTM zone.
+// Outputs match those from LL_to_northing_easting().  Since the
+// central meridian is common to all points, no per-point zone logic
+// is performed.
+
+   void batch_LL_to_northing_easting(
+      const double* longitude,const double* latitude,unsigned int n_points,
+      const bool specified_northern_hemisphere_flag,
+      const int specified_ZoneNumber,double* easting,double* northing,
+      int ReferenceEllipsoid,int n_threads)
+      {
+         UTM_series_constants K;
+         compute_UTM_series_constants(ReferenceEllipsoid,K);
+         n_threads=batch_n_threads(n_points,n_threads);
+
+         double LongOriginRad=((specified_ZoneNumber - 1)*6 - 180 + 3)*
+            DEG2RAD;
+         double southern_offset=
+            specified_northern_hemisphere_flag ? 0.0 : 10000000.0;
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+         for (int i=0; i<int(n_points); i++)
+         {
+            double LongTemp = 
+               (longitude[i]+180)-int((longitude[i]+180)/360)*360-180;
+            UTM_series(K,latitude[i]*DEG2RAD,LongTemp*DEG2RAD-LongOriginRad,
+                       northing[i],easting[i]);
+            northing[i] += (latitude[i] < 0) ? southern_offset : 0.0;
+         }
+      }
+
+// --------------------------------------------------------------------------
+// Method batch_UTMtoLL converts n_points UTM northing/easting pairs
+// lying within a single zone and hemisphere to lat/long.  Outputs
+// match those from UTMtoLL().
+
+   void batch_UTMtoLL(
+      int ZoneNumber,bool northern_hemisphere_flag,
+      const double* UTMNorthing,const double* UTMEasting,
+      unsigned int n_points,double* Lat,double* Long,
+      int ReferenceEllipsoid,int n_threads)
+      {
+         UTM_series_constants K;
+         compute_UTM_series_constants(ReferenceEllipsoid,K);
+         n_threads=batch_n_threads(n_points,n_threads);
+
+         double LongOrigin = (ZoneNumber - 1)*6 - 180 + 3;
+         double southern_offset=northern_hemisphere_flag ? 0.0 : 10000000.0;
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+         for (int i=0; i<int(n_points); i++)
+         {
+            double LatRad,dLongRad;
+            UTM_inverse_series(
+               K,UTMEasting[i]-500000.0,UTMNorthing[i]-southern_offset,
+               LatRad,dLongRad);
+            Lat[i]=LatRad*RAD2DEG;
+            Long[i]=LongOrigin+dLongRad*RAD2DEG;
+         }
+      }
+
+// --------------------------------------------------------------------------
+// Method batch_LL_to_ECEF converts n_points geodetic lat/long/altitude
+// triples to earth-centered, earth-fixed XYZ coordinates.  The Y=0
+// plane passes through Greenwich as for
+// Ellipsoid_model::ConvertLongLatAltToXYZ().
+
+   void batch_LL_to_ECEF(
+      const double* Lat,const double* Long,const double* Alt,
+      unsigned int n_points,double* X,double* Y,double* Z,
+      int ReferenceEllipsoid,int n_threads)
+      {
+         double a=ellipsoid[ReferenceEllipsoid].get_EquatorialRadius();
+         double e2=ellipsoid[ReferenceEllipsoid].get_eccentricitySquared();
+         n_threads=batch_n_threads(n_points,n_threads);
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+         for (int i=0; i<int(n_points); i++)
+         {
+            double s_lat=sin(Lat[i]*DEG2RAD);
+            double c_lat=cos(Lat[i]*DEG2RAD);
+            double s_long=sin(Long[i]*DEG2RAD);
+            double c_long=cos(Long[i]*DEG2RAD);
+            double N=a/sqrt(1-e2*s_lat*s_lat);
+            double r=(N+Alt[i])*c_lat;
+            X[i]=r*c_long;
+            Y[i]=r*s_long;
+            Z[i]=(N*(1-e2)+Alt[i])*s_lat;
+         }
+      }
+
+// --------------------------------------------------------------------------
+// Method batch_ECEF_to_LL inverts batch_LL_to_ECEF() via Heikkinen's
+// closed form solution (Zhu, IEEE Trans. Aerosp. Electron. Syst. 30,
+// 1994).  Unlike Newton or Bowring iteration, the closed form
+// requires the same number of operations for every point.  It is
+// accurate to well below a millimeter for points ranging from the
+// earth's surface out to geosynchronous altitudes.
+
+   void batch_ECEF_to_LL(
+      const double* X,const double* Y,const double* Z,unsigned int n_points,
+      double* Lat,double* Long,double* Alt,
+      int ReferenceEllipsoid,int n_threads)
+      {
+         double a=ellipsoid[ReferenceEllipsoid].get_EquatorialRadius();
+         double e2=ellipsoid[ReferenceEllipsoid].get_eccentricitySquared();
+         double b=a*sqrt(1-e2);
+         double a2=a*a;
+         double b2=b*b;
+         double e4=e2*e2;
+         double ep2=e2/(1-e2);
+         n_threads=batch_n_threads(n_points,n_threads);
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+         for (int i=0; i<int(n_points); i++)
+         {
+            double z=Z[i];
+            double z2=z*z;
+            double p2=X[i]*X[i]+Y[i]*Y[i];
+            double p=sqrt(p2);
+
+            double F=54*b2*z2;
+            double G=p2+(1-e2)*z2-e2*(a2-b2);
+            double c=e4*F*p2/(G*G*G);
+            double s=cbrt(1+c+sqrt(c*c+2*c));
+            double k=s+1+1/s;
+            double P=F/(3*k*k*G*G);
+            double Q=sqrt(1+2*e4*P);
+            double r0_sqr=0.5*a2*(1+1/Q)-P*(1-e2)*z2/(Q*(1+Q))-0.5*P*p2;
+            double r0=-P*e2*p/(1+Q)+sqrt(r0_sqr > 0 ? r0_sqr : 0);
+            double dp=p-e2*r0;
+            double U=sqrt(dp*dp+z2);
+            double V=sqrt(dp*dp+(1-e2)*z2);
+            double z0=b2*z/(a*V);
+
+            Lat[i]=atan2(z+ep2*z0,p)*RAD2DEG;
+            Long[i]=atan2(Y[i],X[i])*RAD2DEG;
+            Alt[i]=U*(1-b2/(a*V));
+         }
+      }
+
+// --------------------------------------------------------------------------
+// Method compute_ENU_basis returns the ECEF coordinates of the
+// specified origin along with the east, north and up direction
+// vectors at that origin.  R's rows hold east_hat, north_hat and
+// up_hat.
+
+   void compute_ENU_basis(
+      double origin_Lat,double origin_Long,double origin_Alt,
+      int ReferenceEllipsoid,double origin[3],double R[3][3])
+      {
+         batch_LL_to_ECEF(&origin_Lat,&origin_Long,&origin_Alt,1,
+                          &origin[0],&origin[1],&origin[2],
+                          ReferenceEllipsoid,1);
+
+         double s_lat=sin(origin_Lat*DEG2RAD);
+         double c_lat=cos(origin_Lat*DEG2RAD);
+         double s_long=sin(origin_Long*DEG2RAD);
+         double c_long=cos(origin_Long*DEG2RAD);
+
+         R[0][0]=-s_long;
+         R[0][1]=c_long;
+         R[0][2]=0;
+         R[1][0]=-s_lat*c_long;
+         R[1][1]=-s_lat*s_long;
+         R[1][2]=c_lat;
+         R[2][0]=c_lat*c_long;
+         R[2][1]=c_lat*s_long;
+         R[2][2]=s_lat;
+      }
+
+// --------------------------------------------------------------------------
+// Method batch_ECEF_to_ENU converts n_points ECEF positions into
+// local east, north and up coordinates relative to a tangent plane
+// whose origin lies at the specified geodetic lat/long/altitude.
+
+   void batch_ECEF_to_ENU(
+      double origin_Lat,double origin_Long,double origin_Alt,
+      const double* X,const double* Y,const double* Z,unsigned int n_points,
+      double* East,double* North,double* Up,
+      int ReferenceEllipsoid,int n_threads)
+      {
+         double origin[3],R[3][3];
+         compute_ENU_basis(origin_Lat,origin_Long,origin_Alt,
+                           ReferenceEllipsoid,origin,R);
+         n_threads=batch_n_threads(n_points,n_threads);
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+         for (int i=0; i<int(n_points); i++)
+         {
+            double dx=X[i]-origin[0];
+            double dy=Y[i]-origin[1];
+            double dz=Z[i]-origin[2];
+            East[i]=R[0][0]*dx+R[0][1]*dy;
+            North[i]=R[1][0]*dx+R[1][1]*dy+R[1][2]*dz;
+            Up[i]=R[2][0]*dx+R[2][1]*dy+R[2][2]*dz;
+         }
+      }
+
+// --------------------------------------------------------------------------
+// Method batch_ENU_to_ECEF inverts batch_ECEF_to_ENU().
+
+   void batch_ENU_to_ECEF(
+      double origin_Lat,double origin_Long,double origin_Alt,
+      const double* East,const double* North,const double* Up,
+      unsigned int n_points,double* X,double* Y,double* Z,
+      int ReferenceEllipsoid,int n_threads)
+      {
+         double origin[3],R[3][3];
+         compute_ENU_basis(origin_Lat,origin_Long,origin_Alt,
+                           ReferenceEllipsoid,origin,R);
+         n_threads=batch_n_threads(n_points,n_threads);
+
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+         for (int i=0; i<int(n_points); i++)
+         {
+            double e=East[i];
+            double n=North[i];
+            double u=Up[i];
+            X[i]=origin[0]+R[0][0]*e+R[1][0]*n+R[2][0]*u;
+            Y[i]=origin[1]+R[0][1]*e+R[1][1]*n+R[2][1]*u;
+            Z[i]=origin[2]+R[1][2]*n+R[2][2]*u;
+         }
+      }
+
 } // latlong namespace
@@ -4,7 +4,7 @@
 // ==========================================================================
 // Header file for LatLong-UTM conversion methods
 // ==========================================================================
-// Last modified on 2/5/10; 3/30/10; 5/9/11
+// Last modified on 2/5/10; 3/30/10; 5/9/11; 10/18/26
 // ==========================================================================
 
 #ifndef LATLONGCONV
@@ -62,6 +62,45 @@ namespace latlongfunc
    geopoint compute_geopoint(double latitude,double longitude,
                              double altitude=0);
 
+// Batched conversion methods operate upon spans of n_points
+// coordinates.  If n_threads <= 0, all available OpenMP threads may be
+// used:
+
+   void batch_LLtoUTM(
+      const double* Lat,const double* Long,unsigned int n_points,
+      int* ZoneNumber,bool* northern_hemisphere_flag,
+      double* UTMNorthing,double* UTMEasting,
+      int ReferenceEllipsoid=23,int n_threads=-1);
+   void batch_LL_to_northing_easting(
+      const double* longitude,const double* latitude,unsigned int n_points,
+      const bool specified_northern_hemisphere_flag,
+      const int specified_ZoneNumber,double* easting,double* northing,
+      int ReferenceEllipsoid=23,int n_threads=-1);
+   void batch_UTMtoLL(
+      int ZoneNumber,bool northern_hemisphere_flag,
+      const double* UTMNorthing,const double* UTMEasting,
+      unsigned int n_points,double* Lat,double* Long,
+      int ReferenceEllipsoid=23,int n_threads=-1);
+
+   void batch_LL_to_ECEF(
+      const double* Lat,const double* Long,const double* Alt,
+      unsigned int n_points,double* X,double* Y,double* Z,
+      int ReferenceEllipsoid=23,int n_threads=-1);
+   void batch_ECEF_to_LL(
+      const double* X,const double* Y,const double* Z,unsigned int n_points,
+      double* Lat,double* Long,double* Alt,
+      int ReferenceEllipsoid=23,int n_threads=-1);
+   void batch_ECEF_to_ENU(
+      double origin_Lat,double origin_Long,double origin_Alt,
+      const double* X,const double* Y,const double* Z,unsigned int n_points,
+      double* East,double* North,double* Up,
+      int ReferenceEllipsoid=23,int n_threads=-1);
+   void batch_ENU_to_ECEF(
+      double origin_Lat,double origin_Long,double origin_Alt,
+      const double* East,const double* North,const double* Up,
+      unsigned int n_points,double* X,double* Y,double* Z,
+      int ReferenceEllipsoid=23,int n_threads=-1);
+
 // ==========================================================================
 // Inlined methods:
 // ==========================================================================
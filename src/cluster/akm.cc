@@ -1,13 +1,17 @@
 // =========================================================================
 // Approximate K-Means (AKM) class member function definitions
 // =========================================================================
-// Last modified on 8/30/13; 9/8/13; 4/4/14; 11/28/15
+// Last modified on 8/30/13; 9/8/13; 4/4/14; 11/28/15; 10/18/26
 // =========================================================================
 
+#include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <limits>
 #include <set>
 #include <string>
 #include <string.h>
+#include <unistd.h>
 #include "cluster/akm.h"
 #include "datastructures/descriptor.h"
 #include "general/filefuncs.h"
@@ -15,8 +19,13 @@
 #include "math/mathfuncs.h"
 #include "general/outputfuncs.h"
 #include "general/stringfuncs.h"
+#include "general/sysfuncs.h"
 #include "time/timefuncs.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using std::cin;
 using std::cout;
 using std::endl;
@@ -68,6 +77,9 @@ void akm::initialize_member_objects()
    cluster_index_nn_ptr=NULL;
    forward_nn_ptr=NULL;
    backward_nn_ptr=NULL;
+
+   n_threads=0;
+   minibatch_file_counter=0;
 }		 
 
 // ---------------------------------------------------------------------
@@ -213,8 +225,11 @@ void akm::reset_params(int n,int d,int k,int num_iters)
          delete dists_matrix_ptr;
       }
       
-      indices_matrix_ptr=new flann::Matrix<int>(new int[N*D],N,D);
-      dists_matrix_ptr=new flann::Matrix<float>(new float[N*D],N,D);
+// K-means refinement searches for at most the 2 closest cluster
+// centers to each descriptor:
+
+      indices_matrix_ptr=new flann::Matrix<int>(new int[N*2],N,2);
+      dists_matrix_ptr=new flann::Matrix<float>(new float[N*2],N,2);
       if (n_iters > 0)
       {
          if (cluster_centers_matrix_ptr != NULL)
@@ -386,10 +401,37 @@ void akm::iteratively_refine_clusters()
 }
 
 // ---------------------------------------------------------------------
-void akm::iteratively_refine_FLANN_clusters() 
+// Member function iteratively_refine_FLANN_clusters() performs
+// n_iters rounds of Lloyd K-means on the descriptors within
+// *SIFT_descriptors_matrix_ptr.  Following Hamerly, each descriptor
+// carries an upper bound on its distance to its assigned center and a
+// lower bound on its distance to all other centers.  After centers
+// move, upper bounds grow by the assigned center's drift while lower
+// bounds shrink by the largest drift.  Only descriptors whose bounds
+// then overlap are searched again within the FLANN index.  Since FLANN
+// returns approximate neighbors, the bounds are approximate as well.
+
+// Elkan's K x K center separation table is NOT maintained, for it is
+// impractical for vocabularies containing O(1E6) words.
+
+void akm::iteratively_refine_FLANN_clusters()
 {
    cout << "Iteratively refining FLANN clusters" << endl;
-   for (unsigned int iter=0; iter<n_iters; iter++)
+
+   unsigned int first_iter=0;
+   if (checkpoint_filename.size() > 0)
+   {
+      import_cluster_centers_checkpoint(checkpoint_filename,first_iter);
+   }
+
+   int n_cores=get_n_threads();
+   cluster_assignment.assign(N,-1);
+   upper_bound.assign(N,0);
+   lower_bound.assign(N,0);
+   vector<float> center_drift(K,0);
+   vector<char> search_flag(N,0);
+
+   for (unsigned int iter=first_iter; iter<n_iters; iter++)
    {
       cout << "========================================================="
            << endl;
@@ -397,146 +439,86 @@ void akm::iteratively_refine_FLANN_clusters()
       cout << "========================================================="
            << endl;
 
-/*
-// Create index automatically tuned to offer best performance by
-// choosing optimal index type (randomized kd-trees, hierarchical kmeans,
-// linear) and parameters for provided dataset:
-
-      float target_precision=0.9;
-//   float target_precision=0.99;
-      float build_weight=0.01;
-      float memory_weight=0;
-      float sample_fraction=0.1;
-
-      flann::Index<flann::L2<float> > index(
-         *cluster_centers_matrix_ptr, flann::AutotunedIndexParams(
-            target_precision,build_weight,memory_weight,sample_fraction));
-*/
-
-// Construct a randomized kd-tree index using 8 kd-trees
+      build_cluster_index();
 
-      delete cluster_index_nn_ptr;
-      cluster_index_nn_ptr=new flann::Index<flann::L2<float> >
-         (*cluster_centers_matrix_ptr, flann::KDTreeIndexParams(8));
+// Every descriptor is searched during the first iteration.
+// Afterwards, upper bounds for descriptors whose bounds overlap are
+// first tightened by computing their exact distances to their
+// assigned centers.  Only descriptors whose bounds still overlap are
+// searched again:
 
-      cout << "Building cluster index" << endl;
-      cluster_index_nn_ptr->buildIndex();                
-      cout << "Finished building cluster index" << endl;
-
-// Find (approximate) closest cluster centers for all N SIFT
-// descriptors:
-
-      cout << "N = " << N << endl;
-      outputfunc::print_elapsed_time();
-
-/*
-      flann::SearchParams search_params;
-      search_params.checks=128;
-      search_params.cores=4;
-      search_params.use_heap=flann::FLANN_False;
-      cluster_index_nn_ptr->knnSearch(
-         *SIFT_descriptors_matrix_ptr, *indices_matrix_ptr, *dists_matrix_ptr,
-         1, search_params);
-*/
-
-      cluster_index_nn_ptr->knnSearch(
-         *SIFT_descriptors_matrix_ptr, *indices_matrix_ptr, *dists_matrix_ptr,
-         1, flann::SearchParams(64));
-
-
-      cout << "Finished performing knnSearch for N SIFT features" << endl;
-
-// Count number of features assigned to each cluster.  Also update
-// cost function which equals integral of squared feature distances to
-// cluster centers:
-
-      memset(new_cluster_centers_matrix_ptr->ptr(),0,K*D*sizeof(float));
-      memset(n_features_in_cluster,0,K*sizeof(int));
-
-      cost_function=0;
-      for (unsigned int n=0; n<N; n++)
+      vector<int> feature_IDs;
+      if (iter==first_iter)
       {
-         int curr_cluster_center_ID=(*indices_matrix_ptr)[n][0];
-         if (n%100==0)
+         feature_IDs.reserve(N);
+         for (unsigned int n=0; n<N; n++)
          {
-//            cout << "n = " << n 
-//                 << " curr_cluster_center_ID = " << curr_cluster_center_ID
-//                 << endl;
+            feature_IDs.push_back(n);
          }
-         n_features_in_cluster[curr_cluster_center_ID] += 1;
-      
-         for (unsigned int d=0; d<D; d++)
-         {
-            (*new_cluster_centers_matrix_ptr)[curr_cluster_center_ID][d] += 
-               (*SIFT_descriptors_matrix_ptr)[n][d];
-
-            float curr_delta= 
-               (*SIFT_descriptors_matrix_ptr)[n][d]- 
-               (*cluster_centers_matrix_ptr)[curr_cluster_center_ID][d];
-            cost_function += sqr(curr_delta/256.0);
-         } // loop over index d
-      } // loop over index n labeling SIFT descriptors
-
-      cost_function /= N;
-      cout << "cost_function = " << cost_function << endl;
-
-
-// Recompute cluster centers as centroids of SIFT descriptors which
-// share common cluster index:
-
-      for (unsigned int c=0; c<K; c++)
+      }
+      else
       {
 
-// Make sure number of features in current cluster at least equals 2!
-
-         if (n_features_in_cluster[c] <= 1) continue;
-         
-         for (unsigned int d=0; d<D; d++)
+#pragma omp parallel for schedule(static) num_threads(n_cores)
+         for (int n=0; n<int(N); n++)
          {
-            (*cluster_centers_matrix_ptr)[c][d]=
-               (*new_cluster_centers_matrix_ptr)[c][d]/
-               n_features_in_cluster[c];
-            if ( (c < 4 || c > K-4) && (d < 4 || d > 124) )
+            search_flag[n]=0;
+            if (upper_bound[n] <= lower_bound[n]) continue;
+
+            const float* curr_descriptor=(*SIFT_descriptors_matrix_ptr)[n];
+            const float* curr_center=
+               (*cluster_centers_matrix_ptr)[cluster_assignment[n]];
+            float sqrd_distance=0;
+            for (unsigned int d=0; d<D; d++)
             {
-//               cout << "c = " << c
-//                    << " d = " << d 
-//                    << " cluster_centers[c][d] = " 
-//                    << (*cluster_centers_matrix_ptr)[c][d] << endl;
+               float curr_delta=curr_descriptor[d]-curr_center[d];
+               sqrd_distance += curr_delta*curr_delta;
             }
-         } // loop over index d 
-         if (c < 4 || c > K-4)
+            upper_bound[n]=sqrt(sqrd_distance);
+            if (upper_bound[n] > lower_bound[n]) search_flag[n]=1;
+         } // loop over index n labeling SIFT descriptors
+
+         for (unsigned int n=0; n<N; n++)
          {
-            cout << "cluster = " << c << " # features in cluster = "
-                 << n_features_in_cluster[c] << endl;
-//            cout << endl;
+            if (search_flag[n]) feature_IDs.push_back(n);
          }
+      }
 
-      } // loop over index c labeling cluster centers
+      cout << "Searching for closest cluster centers to "
+           << feature_IDs.size() << " of N = " << N
+           << " SIFT features" << endl;
+      outputfunc::print_elapsed_time();
 
-// Check that integral of all clustered features equals total number
-// of features N:
+      search_closest_cluster_centers(feature_IDs,2);
+      cout << "Finished performing knnSearch for SIFT features" << endl;
 
-      int n_features_in_cluster_integral=0;
-      vector<double> n_features_per_cluster;
+// Recompute cluster centers as centroids of SIFT descriptors which
+// share common cluster index.  Then loosen all bounds by the centers'
+// drifts:
+
+      update_cluster_centroids(center_drift);
+      cout << "cost_function = " << cost_function << endl;
+
+      float max_drift=0;
       for (unsigned int c=0; c<K; c++)
       {
-//         cout << "c = " << c
-//              << " n_features_in_cluster = "
-//              << n_features_in_cluster[c] << endl;
-         n_features_in_cluster_integral += n_features_in_cluster[c];
-         n_features_per_cluster.push_back(n_features_in_cluster[c]);
+         max_drift=basic_math::max(max_drift,center_drift[c]);
       }
-      mu_n_features_per_cluster=mathfunc::mean(n_features_per_cluster);
-      sigma_n_features_per_cluster=mathfunc::std_dev(n_features_per_cluster);
-
-      cout << "Total number of features N = " << N << endl;
-      cout << "n_features_in_cluster_integral = " 
-           << n_features_in_cluster_integral << endl;
-      cout << "n_features_per_cluster = "
-           << mu_n_features_per_cluster << " +/- "
-           << sigma_n_features_per_cluster << endl;
-      outputfunc::print_elapsed_time();
 
+#pragma omp parallel for schedule(static) num_threads(n_cores)
+      for (int n=0; n<int(N); n++)
+      {
+         if (cluster_assignment[n] < 0) continue;
+         upper_bound[n] += center_drift[cluster_assignment[n]];
+         lower_bound[n] -= max_drift;
+      }
+
+      print_cluster_statistics(N);
+
+      if (checkpoint_filename.size() > 0)
+      {
+         export_cluster_centers_checkpoint(checkpoint_filename,iter+1);
+      }
    } // loop over iter index
 }
 
@@ -624,6 +606,643 @@ void akm::iteratively_refine_FASTANN_clusters()
    } // loop over iter index
 }
 
+// =========================================================================
+// Mini-batch K-means and checkpoint member functions
+// =========================================================================
+
+// Member function minibatch_refine_FLANN_clusters() implements
+// Sculley's web-scale mini-batch K-means.  Rather than holding every
+// SIFT descriptor in memory, each round streams batch_size
+// descriptors from randomly ordered per-image HDF5 files.  Batch
+// descriptors are assigned to their approximately closest centers via
+// the FLANN index.  Each center then moves towards its newly assigned
+// descriptors with a per-center learning rate equal to the inverse of
+// the total number of descriptors it has absorbed.  If
+// inverse_sqrt_covar_ptr is non-null, raw descriptors are whitened as
+// they are loaded.
+
+// This method assumes reset_minibatch_params() has been called.  If a checkpoint filename has been set, centers and
+// per-center counts are saved every checkpoint_interval batches, and
+// refinement resumes from them upon the next call.
+
+void akm::minibatch_refine_FLANN_clusters(
+   const vector<string>& hdf5_filenames,unsigned int batch_size,
+   unsigned int n_batches,const flann::Matrix<float>* inverse_sqrt_covar_ptr,
+   unsigned int checkpoint_interval)
+{
+   string banner="Mini-batch refining FLANN clusters";
+   outputfunc::write_banner(banner);
+
+   if (hdf5_filenames.size()==0 || cluster_centers_matrix_ptr==NULL ||
+       batch_size==0)
+   {
+      cout << "Error in akm::minibatch_refine_FLANN_clusters()!" << endl;
+      cout << "hdf5_filenames.size() = " << hdf5_filenames.size()
+           << " batch_size = " << batch_size << endl;
+      return;
+   }
+
+   int n_cores=get_n_threads();
+   minibatch_file_order.clear();
+   minibatch_file_counter=0;
+
+   unsigned int first_batch=0;
+   bool resumed_flag=false;
+   if (checkpoint_filename.size() > 0)
+   {
+      resumed_flag=import_cluster_centers_checkpoint(
+         checkpoint_filename,first_batch);
+   }
+
+// Seed cluster centers with K randomly chosen descriptors from the
+// first streamed batch:
+
+   if (!resumed_flag)
+   {
+      unsigned int n_seeds=basic_math::max(K,batch_size);
+      float* seed_array=new float[n_seeds*D];
+      n_seeds=load_minibatch_descriptors(
+         hdf5_filenames,n_seeds,inverse_sqrt_covar_ptr,seed_array);
+      if (n_seeds < K)
+      {
+         cout << "Error in akm::minibatch_refine_FLANN_clusters()!" << endl;
+         cout << "Only " << n_seeds << " descriptors available to seed K = "
+              << K << " cluster centers" << endl;
+         delete [] seed_array;
+         return;
+      }
+
+      vector<int> cluster_center_IDs=mathfunc::random_sequence(n_seeds,K);
+      for (unsigned int c=0; c<K; c++)
+      {
+         memcpy((*cluster_centers_matrix_ptr)[c],
+                seed_array+cluster_center_IDs[c]*D,D*sizeof(float));
+      }
+      memset(n_features_in_cluster,0,K*sizeof(int));
+      delete [] seed_array;
+   }
+
+   float* batch_array=new float[batch_size*D];
+   int* index_array=new int[batch_size];
+   float* dist_array=new float[batch_size];
+   vector<unsigned int> cluster_start(K+1),cluster_fill(K);
+   vector<int> sorted_feature_IDs(batch_size);
+
+   flann::SearchParams search_params(64);
+   search_params.cores=n_cores;
+
+   unsigned int n_completed_batches=first_batch;
+   for (unsigned int b=first_batch; b<n_batches; b++)
+   {
+      unsigned int n_batch_features=load_minibatch_descriptors(
+         hdf5_filenames,batch_size,inverse_sqrt_covar_ptr,batch_array);
+      if (n_batch_features==0) break;
+
+      flann::Matrix<float> batch(batch_array,n_batch_features,D);
+      flann::Matrix<int> indices(index_array,n_batch_features,1);
+      flann::Matrix<float> dists(dist_array,n_batch_features,1);
+
+      build_cluster_index();
+      cluster_index_nn_ptr->knnSearch(batch,indices,dists,1,search_params);
+
+// Group batch descriptors by their assigned centers.  Gradient steps
+// for different centers may then proceed independently:
+
+      cost_function=0;
+      cluster_start.assign(K+1,0);
+      for (unsigned int n=0; n<n_batch_features; n++)
+      {
+         if (index_array[n] < 0) continue;
+         cluster_start[index_array[n]+1]++;
+         cost_function += dist_array[n]/sqr(256.0);
+      }
+      cost_function /= n_batch_features;
+
+      for (unsigned int c=0; c<K; c++)
+      {
+         cluster_start[c+1] += cluster_start[c];
+         cluster_fill[c]=cluster_start[c];
+      }
+      for (unsigned int n=0; n<n_batch_features; n++)
+      {
+         if (index_array[n] < 0) continue;
+         sorted_feature_IDs[cluster_fill[index_array[n]]++]=n;
+      }
+
+#pragma omp parallel for schedule(dynamic,64) num_threads(n_cores)
+      for (int c=0; c<int(K); c++)
+      {
+         float* curr_center=(*cluster_centers_matrix_ptr)[c];
+         for (unsigned int i=cluster_start[c]; i<cluster_start[c+1]; i++)
+         {
+            const float* curr_descriptor=batch[sorted_feature_IDs[i]];
+            n_features_in_cluster[c]++;
+            float eta=1.0/n_features_in_cluster[c];
+            for (unsigned int d=0; d<D; d++)
+            {
+               curr_center[d] += eta*(curr_descriptor[d]-curr_center[d]);
+            }
+         } // loop over index i labeling descriptors assigned to center c
+      } // loop over index c labeling cluster centers
+
+      n_completed_batches=b+1;
+      cout << "batch = " << b << " n_features = " << n_batch_features
+           << " cost_function = " << cost_function << endl;
+
+      if (checkpoint_filename.size() > 0 && checkpoint_interval > 0 &&
+          n_completed_batches%checkpoint_interval==0)
+      {
+         export_cluster_centers_checkpoint(
+            checkpoint_filename,n_completed_batches);
+         outputfunc::print_elapsed_time();
+      }
+   } // loop over index b labeling mini-batches
+
+   if (checkpoint_filename.size() > 0)
+   {
+      export_cluster_centers_checkpoint(
+         checkpoint_filename,n_completed_batches);
+   }
+
+   delete [] batch_array;
+   delete [] index_array;
+   delete [] dist_array;
+
+   unsigned int n_clustered_features=0;
+   for (unsigned int c=0; c<K; c++)
+   {
+      n_clustered_features += n_features_in_cluster[c];
+   }
+   print_cluster_statistics(n_clustered_features);
+}
+
+// ---------------------------------------------------------------------
+// Member function reset_minibatch_params() allocates only the K x D
+// cluster centers and per-center counts needed by mini-batch K-means.
+// Streamed batches hold their own assignment workspaces.  So the N x
+// 2 index and distance matrices and the new cluster centers matrix
+// used by Lloyd iterations are released rather than allocated.
+
+void akm::reset_minibatch_params(int d,int k)
+{
+   if (!FLANN_flag)
+   {
+      cout << "Error in akm::reset_minibatch_params()!" << endl;
+      cout << "Mini-batch K-means requires FLANN" << endl;
+      exit(-1);
+   }
+
+   this->N=0;
+   this->D=d;
+   this->K=k;
+   this->n_iters=0;
+
+   if (indices_matrix_ptr != NULL)
+   {
+      delete [] indices_matrix_ptr->ptr();
+      delete indices_matrix_ptr;
+      indices_matrix_ptr=NULL;
+   }
+
+   if (dists_matrix_ptr != NULL)
+   {
+      delete [] dists_matrix_ptr->ptr();
+      delete dists_matrix_ptr;
+      dists_matrix_ptr=NULL;
+   }
+
+   if (new_cluster_centers_matrix_ptr != NULL)
+   {
+      delete [] new_cluster_centers_matrix_ptr->ptr();
+      delete new_cluster_centers_matrix_ptr;
+      new_cluster_centers_matrix_ptr=NULL;
+   }
+
+   if (cluster_centers_matrix_ptr != NULL)
+   {
+      delete [] cluster_centers_matrix_ptr->ptr();
+      delete cluster_centers_matrix_ptr;
+   }
+   cluster_centers_matrix_ptr=new flann::Matrix<float>(new float[K*D],K,D);
+
+   delete [] n_features_in_cluster;
+   n_features_in_cluster=new int[K];
+
+   delete [] image_word_count;
+   image_word_count=new int[K];
+}
+
+// ---------------------------------------------------------------------
+// Member function export_cluster_centers_checkpoint() writes the
+// current cluster centers, their feature counts and the number of
+// completed K-means rounds to an HDF5 file.  The checkpoint is first
+// written to a temporary file which is then renamed.  So an
+// interrupted export never clobbers the previous checkpoint.
+
+void akm::export_cluster_centers_checkpoint(
+   string checkpoint_filename,unsigned int n_completed_rounds)
+{
+   string tmp_filename=checkpoint_filename+".tmp";
+   filefunc::deletefile(tmp_filename);
+
+   flann::Matrix<int> cluster_counts(n_features_in_cluster,1,K);
+   int state[3]={int(n_completed_rounds),int(K),int(D)};
+   flann::Matrix<int> checkpoint_state(state,1,3);
+
+   flann::save_to_file(
+      *cluster_centers_matrix_ptr,tmp_filename.c_str(),"cluster_centers");
+   flann::save_to_file(
+      cluster_counts,tmp_filename.c_str(),"cluster_counts");
+   flann::save_to_file(
+      checkpoint_state,tmp_filename.c_str(),"checkpoint_state");
+
+   if (rename(tmp_filename.c_str(),checkpoint_filename.c_str()) != 0)
+   {
+      cout << "Error in akm::export_cluster_centers_checkpoint()!" << endl;
+      cout << "Could not rename " << tmp_filename << " as "
+           << checkpoint_filename << endl;
+      return;
+   }
+   cout << "Exported cluster centers after " << n_completed_rounds
+        << " rounds to " << checkpoint_filename << endl;
+}
+
+// ---------------------------------------------------------------------
+// Boolean member function import_cluster_centers_checkpoint() reads
+// cluster centers and feature counts written by
+// export_cluster_centers_checkpoint().  It returns false if the
+// checkpoint does not exist or if its K and D values do not match the
+// current ones.
+
+bool akm::import_cluster_centers_checkpoint(
+   string checkpoint_filename,unsigned int& n_completed_rounds)
+{
+   n_completed_rounds=0;
+   if (!filefunc::fileexist(checkpoint_filename)) return false;
+   if (cluster_centers_matrix_ptr==NULL || n_features_in_cluster==NULL)
+      return false;
+
+   flann::Matrix<int> checkpoint_state;
+   flann::load_from_file(
+      checkpoint_state,checkpoint_filename.c_str(),"checkpoint_state");
+   bool consistent_flag=(checkpoint_state.cols==3 &&
+                         checkpoint_state[0][1]==int(K) &&
+                         checkpoint_state[0][2]==int(D));
+   unsigned int n_rounds=checkpoint_state[0][0];
+   delete [] checkpoint_state.ptr();
+
+   if (!consistent_flag)
+   {
+      cout << "Error in akm::import_cluster_centers_checkpoint()!" << endl;
+      cout << "Checkpoint " << checkpoint_filename
+           << " does not match K = " << K << " D = " << D << endl;
+      return false;
+   }
+
+   flann::Matrix<float> cluster_centers_matrix;
+   flann::load_from_file(
+      cluster_centers_matrix,checkpoint_filename.c_str(),"cluster_centers");
+   for (unsigned int c=0; c<K; c++)
+   {
+      memcpy((*cluster_centers_matrix_ptr)[c],cluster_centers_matrix[c],
+             D*sizeof(float));
+   }
+   delete [] cluster_centers_matrix.ptr();
+
+   flann::Matrix<int> cluster_counts;
+   flann::load_from_file(
+      cluster_counts,checkpoint_filename.c_str(),"cluster_counts");
+   memcpy(n_features_in_cluster,cluster_counts.ptr(),K*sizeof(int));
+   delete [] cluster_counts.ptr();
+
+   n_completed_rounds=n_rounds;
+   string banner="Resuming K-means from "+checkpoint_filename+" after "+
+      stringfunc::number_to_string(n_completed_rounds)+" rounds";
+   outputfunc::write_banner(banner);
+   return true;
+}
+
+// =========================================================================
+// Private K-means helper member functions
+// =========================================================================
+
+int akm::get_n_threads() const
+{
+   int curr_n_threads=n_threads;
+#ifdef _OPENMP
+   if (curr_n_threads <= 0) curr_n_threads=omp_get_max_threads();
+#else
+   curr_n_threads=1;
+#endif
+   return curr_n_threads;
+}
+
+// ---------------------------------------------------------------------
+// Member function build_cluster_index() constructs a randomized
+// kd-tree index using 8 kd-trees for the current cluster centers.
+
+void akm::build_cluster_index()
+{
+   delete cluster_index_nn_ptr;
+   cluster_index_nn_ptr=new flann::Index<flann::L2<float> >
+      (*cluster_centers_matrix_ptr, flann::KDTreeIndexParams(8));
+
+   cout << "Building cluster index" << endl;
+   cluster_index_nn_ptr->buildIndex();
+   cout << "Finished building cluster index" << endl;
+}
+
+// ---------------------------------------------------------------------
+// Member function search_closest_cluster_centers() finds the
+// n_nearest (approximately) closest cluster centers for SIFT
+// descriptors labeled by feature_IDs.  It resets their cluster
+// assignments along with their upper and lower distance bounds.
+// Searches run in parallel across FLANN's cores.
+
+void akm::search_closest_cluster_centers(
+   const vector<int>& feature_IDs,unsigned int n_nearest)
+{
+   unsigned int n_queries=feature_IDs.size();
+   if (n_queries==0) return;
+   n_nearest=basic_math::min(n_nearest,K);
+   int n_cores=get_n_threads();
+
+// Gather queried descriptors into a contiguous matrix unless all N
+// descriptors are queried:
+
+   float* query_array=NULL;
+   flann::Matrix<float> queries=*SIFT_descriptors_matrix_ptr;
+   if (n_queries < N)
+   {
+      query_array=new float[n_queries*D];
+      queries=flann::Matrix<float>(query_array,n_queries,D);
+
+#pragma omp parallel for schedule(static) num_threads(n_cores)
+      for (int q=0; q<int(n_queries); q++)
+      {
+         memcpy(queries[q],(*SIFT_descriptors_matrix_ptr)[feature_IDs[q]],
+                D*sizeof(float));
+      }
+   }
+
+// The N x 2 indices and distances matrices serve as workspaces for
+// the n_queries x n_nearest search results:
+
+   flann::Matrix<int> indices(indices_matrix_ptr->ptr(),n_queries,n_nearest);
+   flann::Matrix<float> dists(dists_matrix_ptr->ptr(),n_queries,n_nearest);
+
+   flann::SearchParams search_params(64);
+   search_params.cores=n_cores;
+   cluster_index_nn_ptr->knnSearch(
+      queries,indices,dists,n_nearest,search_params);
+
+// FLANN's L2 distances are squared:
+
+#pragma omp parallel for schedule(static) num_threads(n_cores)
+   for (int q=0; q<int(n_queries); q++)
+   {
+      int n=feature_IDs[q];
+      if (indices[q][0] < 0) continue;
+      cluster_assignment[n]=indices[q][0];
+      upper_bound[n]=sqrt(dists[q][0]);
+      lower_bound[n]=std::numeric_limits<float>::max();
+      if (n_nearest > 1 && indices[q][1] >= 0)
+      {
+         lower_bound[n]=sqrt(dists[q][1]);
+      }
+   } // loop over index q labeling queried descriptors
+
+   delete [] query_array;
+}
+
+// ---------------------------------------------------------------------
+// Member function update_cluster_centroids() resets each cluster
+// center with at least 2 assigned SIFT descriptors to their centroid.
+// Descriptor IDs are first counting sorted by cluster assignment so
+// that centroids can be summed in parallel.  Distances moved by
+// centers are returned within center_drift.  This method also updates
+// the cost function which equals the integral of squared feature
+// distances to the previous cluster centers.
+
+void akm::update_cluster_centroids(vector<float>& center_drift)
+{
+   int n_cores=get_n_threads();
+
+   memset(n_features_in_cluster,0,K*sizeof(int));
+   for (unsigned int n=0; n<N; n++)
+   {
+      if (cluster_assignment[n] >= 0)
+         n_features_in_cluster[cluster_assignment[n]]++;
+   }
+
+   vector<unsigned int> cluster_start(K+1,0);
+   for (unsigned int c=0; c<K; c++)
+   {
+      cluster_start[c+1]=cluster_start[c]+n_features_in_cluster[c];
+   }
+   vector<unsigned int> cluster_fill(cluster_start.begin(),
+                                     cluster_start.end()-1);
+   vector<int> sorted_feature_IDs(cluster_start[K]);
+   for (unsigned int n=0; n<N; n++)
+   {
+      if (cluster_assignment[n] < 0) continue;
+      sorted_feature_IDs[cluster_fill[cluster_assignment[n]]++]=n;
+   }
+
+   double cost=0;
+
+#pragma omp parallel num_threads(n_cores) reduction(+:cost)
+   {
+      vector<double> centroid(D);
+
+#pragma omp for schedule(dynamic,64)
+      for (int c=0; c<int(K); c++)
+      {
+         center_drift[c]=0;
+         float* curr_center=(*cluster_centers_matrix_ptr)[c];
+         centroid.assign(D,0);
+         for (unsigned int i=cluster_start[c]; i<cluster_start[c+1]; i++)
+         {
+            const float* curr_descriptor=
+               (*SIFT_descriptors_matrix_ptr)[sorted_feature_IDs[i]];
+            for (unsigned int d=0; d<D; d++)
+            {
+               centroid[d] += curr_descriptor[d];
+               float curr_delta=curr_descriptor[d]-curr_center[d];
+               cost += sqr(curr_delta/256.0);
+            }
+         } // loop over index i labeling descriptors assigned to center c
+
+// Make sure number of features in current cluster at least equals 2!
+
+         if (n_features_in_cluster[c] <= 1) continue;
+
+         double sqrd_drift=0;
+         for (unsigned int d=0; d<D; d++)
+         {
+            float new_value=centroid[d]/n_features_in_cluster[c];
+            sqrd_drift += sqr(new_value-curr_center[d]);
+            curr_center[d]=new_value;
+         }
+         center_drift[c]=sqrt(sqrd_drift);
+      } // loop over index c labeling cluster centers
+   } // end of omp parallel region
+
+   cost_function=cost/N;
+
+   for (unsigned int c=0; c<K; c++)
+   {
+      if (c < 4 || c > K-4)
+      {
+         cout << "cluster = " << c << " # features in cluster = "
+              << n_features_in_cluster[c] << endl;
+      }
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function print_cluster_statistics() checks that the integral
+// of all clustered features equals n_clustered_features and resets
+// the mean and standard deviation of features per cluster.
+
+void akm::print_cluster_statistics(unsigned int n_clustered_features)
+{
+   int n_features_in_cluster_integral=0;
+   vector<double> n_features_per_cluster;
+   n_features_per_cluster.reserve(K);
+   for (unsigned int c=0; c<K; c++)
+   {
+      n_features_in_cluster_integral += n_features_in_cluster[c];
+      n_features_per_cluster.push_back(n_features_in_cluster[c]);
+   }
+   mu_n_features_per_cluster=mathfunc::mean(n_features_per_cluster);
+   sigma_n_features_per_cluster=mathfunc::std_dev(n_features_per_cluster);
+
+   cout << "Total number of features N = " << n_clustered_features << endl;
+   cout << "n_features_in_cluster_integral = "
+        << n_features_in_cluster_integral << endl;
+   cout << "n_features_per_cluster = "
+        << mu_n_features_per_cluster << " +/- "
+        << sigma_n_features_per_cluster << endl;
+   outputfunc::print_elapsed_time();
+}
+
+// ---------------------------------------------------------------------
+// Member function load_minibatch_descriptors() fills batch_array with
+// up to batch_size SIFT descriptors read from per-image HDF5 files.
+// Files are visited in a shuffled order which is regenerated once
+// every file has been read.  If inverse_sqrt_covar_ptr is non-null,
+// loaded descriptors are whitened.  This method returns the number of
+// descriptors actually loaded.
+
+unsigned int akm::load_minibatch_descriptors(
+   const vector<string>& hdf5_filenames,unsigned int batch_size,
+   const flann::Matrix<float>* inverse_sqrt_covar_ptr,float* batch_array)
+{
+   unsigned int n_loaded=0,n_failures=0;
+   while (n_loaded < batch_size && n_failures < hdf5_filenames.size())
+   {
+      if (minibatch_file_counter >= minibatch_file_order.size())
+      {
+         minibatch_file_order=mathfunc::random_sequence(
+            hdf5_filenames.size());
+         minibatch_file_counter=0;
+      }
+      string hdf5_filename=hdf5_filenames[
+         minibatch_file_order[minibatch_file_counter++]];
+
+      flann::Matrix<float> descriptors;
+      if (!load_hdf5_descriptors(hdf5_filename,descriptors))
+      {
+         n_failures++;
+         continue;
+      }
+      n_failures=0;
+
+      unsigned int n_rows=basic_math::min(
+         (unsigned int) descriptors.rows,batch_size-n_loaded);
+      for (unsigned int r=0; r<n_rows; r++)
+      {
+         memcpy(batch_array+(n_loaded+r)*D,descriptors[r],D*sizeof(float));
+      }
+      n_loaded += n_rows;
+      delete [] descriptors.ptr();
+   } // n_loaded < batch_size while loop
+
+   if (inverse_sqrt_covar_ptr==NULL) return n_loaded;
+
+   int n_cores=get_n_threads();
+
+#pragma omp parallel num_threads(n_cores)
+   {
+      vector<float> whitened_row(D);
+
+#pragma omp for schedule(static)
+      for (int f=0; f<int(n_loaded); f++)
+      {
+         float* curr_row=batch_array+f*D;
+         for (unsigned int i=0; i<D; i++)
+         {
+            whitened_row[i]=0;
+            for (unsigned int j=0; j<D; j++)
+            {
+               whitened_row[i] += (*inverse_sqrt_covar_ptr)[i][j]*curr_row[j];
+            }
+         }
+         memcpy(curr_row,&whitened_row[0],D*sizeof(float));
+      } // loop over index f labeling loaded descriptors
+   } // end of omp parallel region
+
+   return n_loaded;
+}
+
+// ---------------------------------------------------------------------
+// Boolean member function load_hdf5_descriptors() imports the
+// "sift_features" matrix from a per-image HDF5 file.  Gzipped and
+// lzop compressed files are decompressed into a temporary copy so
+// that the originals are left untouched.
+
+bool akm::load_hdf5_descriptors(
+   string hdf5_filename,flann::Matrix<float>& descriptors)
+{
+   string suffix=stringfunc::suffix(hdf5_filename);
+   bool compressed_flag=(suffix=="gz" || suffix=="lzo");
+   string uncompressed_filename=hdf5_filename;
+   if (compressed_flag)
+   {
+      uncompressed_filename="/tmp/akm_minibatch_"+
+         stringfunc::number_to_string(getpid())+".hdf5";
+      string unix_cmd="gunzip -c ";
+      if (suffix=="lzo") unix_cmd="lzop --uncompress --stdout ";
+      unix_cmd += hdf5_filename+" > "+uncompressed_filename;
+      sysfunc::unix_command(unix_cmd);
+   }
+
+   bool loaded_flag=false;
+   if (filefunc::fileexist(uncompressed_filename))
+   {
+      try
+      {
+         flann::load_from_file(
+            descriptors,uncompressed_filename.c_str(),"sift_features");
+         loaded_flag=(descriptors.cols==D);
+         if (!loaded_flag) delete [] descriptors.ptr();
+      }
+      catch (std::exception& e)
+      {
+         cout << "Error in akm::load_hdf5_descriptors()!" << endl;
+         cout << e.what() << endl;
+      }
+   }
+
+   if (compressed_flag) filefunc::deletefile(uncompressed_filename);
+   if (!loaded_flag)
+   {
+      cout << "Could not load SIFT features from " << hdf5_filename << endl;
+   }
+   return loaded_flag;
+}
+
 // =========================================================================
 // Approximate SIFT feature matching member functions
 // =========================================================================
@@ -1162,6 +1781,7 @@ void akm::find_only_forward_SIFT_matches(double max_distance_ratio)
 // flann::SearchParams(128));
 
    initial_SIFT_matches.clear();
+   initial_SIFT_match_ratios.clear();
    for (unsigned int f=0; f<n_queries; f++)
    {
       float nearest_neighbor_dist=(*dists_ptr)[f][0];
@@ -1169,14 +1789,14 @@ void akm::find_only_forward_SIFT_matches(double max_distance_ratio)
 //      cout << "nearest_neighbor_dist = " << nearest_neighbor_dist
 //           << " next_to_nearest_neighbor_dist = "
 //           << next_to_nearest_neighbor_dist << endl;
-//      float ratio=nearest_neighbor_dist/next_to_nearest_neighbor_dist;
+      float ratio=nearest_neighbor_dist/next_to_nearest_neighbor_dist;
 //      cout << "ratio = " << ratio << endl;
-      if (nearest_neighbor_dist/next_to_nearest_neighbor_dist > 
-      max_distance_ratio) continue;
+      if (ratio > max_distance_ratio) continue;
 
       int nearest_neighbor_index=(*indices_ptr)[f][0];
       pair<int,int> P(f,nearest_neighbor_index);
       initial_SIFT_matches.push_back(P);
+      initial_SIFT_match_ratios.push_back(ratio);
    }
 }
 
@@ -1234,16 +1854,18 @@ void akm::find_only_backward_SIFT_matches(double max_distance_ratio)
       *indices_ptr,*dists_ptr,nn,fsp);
 
    initial_SIFT_matches.clear();
+   initial_SIFT_match_ratios.clear();
    for (unsigned int f=0; f<n_queries; f++)
    {
       float nearest_neighbor_dist=(*dists_ptr)[f][0];
       float next_to_nearest_neighbor_dist=(*dists_ptr)[f][1];
-      if (nearest_neighbor_dist/next_to_nearest_neighbor_dist > 
-      max_distance_ratio) continue;
+      float ratio=nearest_neighbor_dist/next_to_nearest_neighbor_dist;
+      if (ratio > max_distance_ratio) continue;
 
       int nearest_neighbor_index=(*indices_ptr)[f][0];
       pair<int,int> P(f,nearest_neighbor_index);
       initial_SIFT_matches.push_back(P);
+      initial_SIFT_match_ratios.push_back(ratio);
    }
 //   cout << "At end of find_only_backward_SIFT_matches()" << endl;
 }
@@ -1,13 +1,14 @@
 // ==========================================================================
 // Header file for Approximate K-Means (AKM) class
 // ==========================================================================
-// Last modified on 6/19/13; 7/8/13; 8/30/13; 4/4/14
+// Last modified on 6/19/13; 7/8/13; 8/30/13; 4/4/14; 10/18/26
 // ==========================================================================
 
 #ifndef AKM_H
 #define AKM_H
 
 #include <map>
+#include <string>
 #include <vector>
 #include <fastann/fastann.hpp>
 #include <flann/flann.hpp>
@@ -43,10 +44,14 @@ class akm
    double get_mu_n_features_per_cluster() const;
    double get_sigma_n_features_per_cluster() const;
    int get_K() const;
+   const int* get_image_word_count() const;
+   void set_n_threads(int n);
+   void set_checkpoint_filename(std::string filename);
 
    std::vector<std::pair<int,int> >* get_initial_SIFT_matches_ptr();
    const std::vector<std::pair<int,int> >* get_initial_SIFT_matches_ptr() 
       const;
+   const std::vector<float>* get_initial_SIFT_match_ratios_ptr() const;
 
 // Approximate K-means member functions:
   
@@ -61,6 +66,19 @@ class akm
    void iteratively_refine_FLANN_clusters();
    void iteratively_refine_FASTANN_clusters();
 
+// Mini-batch K-means and checkpoint member functions:
+
+   void reset_minibatch_params(int d,int k);
+   void minibatch_refine_FLANN_clusters(
+      const std::vector<std::string>& hdf5_filenames,
+      unsigned int batch_size,unsigned int n_batches,
+      const flann::Matrix<float>* inverse_sqrt_covar_ptr=NULL,
+      unsigned int checkpoint_interval=25);
+   bool import_cluster_centers_checkpoint(
+      std::string checkpoint_filename,unsigned int& n_completed_rounds);
+   void export_cluster_centers_checkpoint(
+      std::string checkpoint_filename,unsigned int n_completed_rounds);
+
 // Approximate SIFT feature matching member functions:
 
    bool load_SIFT_descriptors(
@@ -164,6 +182,20 @@ class akm
    unsigned int n_iters;
    double cost_function;
    double mu_n_features_per_cluster,sigma_n_features_per_cluster;
+   int n_threads;
+   std::string checkpoint_filename;
+
+// Hamerly-style bounds on each descriptor's distance to its assigned
+// cluster center and to its second closest center:
+
+   std::vector<int> cluster_assignment;
+   std::vector<float> upper_bound,lower_bound;
+
+// Shuffled order in which per-image HDF5 files are streamed into
+// mini-batches:
+
+   std::vector<int> minibatch_file_order;
+   unsigned int minibatch_file_counter;
 
    int *n_features_in_cluster,*image_word_count;
    int *multi_image_word_occurrence;
@@ -198,12 +230,25 @@ class akm
 
    
    std::vector<std::pair<int,int> > initial_SIFT_matches;
+   std::vector<float> initial_SIFT_match_ratios;
    typedef std::map<int,int> FEATURE_MATCHES_MAP;
    FEATURE_MATCHES_MAP *forward_matches_map_ptr,*backward_matches_map_ptr;
 
    void allocate_member_objects();
    void initialize_member_objects();
    void docopy(const akm& a);
+
+   int get_n_threads() const;
+   void build_cluster_index();
+   void search_closest_cluster_centers(
+      const std::vector<int>& feature_IDs,unsigned int n_nearest);
+   void update_cluster_centroids(std::vector<float>& center_drift);
+   void print_cluster_statistics(unsigned int n_clustered_features);
+   unsigned int load_minibatch_descriptors(
+      const std::vector<std::string>& hdf5_filenames,unsigned int batch_size,
+      const flann::Matrix<float>* inverse_sqrt_covar_ptr,float* batch_array);
+   bool load_hdf5_descriptors(
+      std::string hdf5_filename,flann::Matrix<float>& descriptors);
 };
 
 // ==========================================================================
@@ -259,6 +304,30 @@ inline int akm::get_K() const
    return K;
 }
 
+// Member function get_image_word_count returns the K-bin word
+// histogram filled by the most recent call to compute_image_words():
+
+inline const int* akm::get_image_word_count() const
+{
+   return image_word_count;
+}
+
+// If n_threads <= 0, the OpenMP default number of threads is used:
+
+inline void akm::set_n_threads(int n)
+{
+   n_threads=n;
+}
+
+// Once a checkpoint filename is set, K-means refinement resumes from
+// any cluster centers previously saved to it and periodically
+// overwrites it with the current centers:
+
+inline void akm::set_checkpoint_filename(std::string filename)
+{
+   checkpoint_filename=filename;
+}
+
 inline std::vector<std::pair<int,int> >* akm::get_initial_SIFT_matches_ptr()
 {
    return &(initial_SIFT_matches);
@@ -270,4 +339,12 @@ inline const std::vector<std::pair<int,int> >*
    return &(initial_SIFT_matches);
 }
 
+// Lowe distance ratios for entries within initial_SIFT_matches:
+
+inline const std::vector<float>* akm::get_initial_SIFT_match_ratios_ptr() 
+   const
+{
+   return &(initial_SIFT_match_ratios);
+}
+
 #endif  // akm.h
@@ -0,0 +1,580 @@
+// ==========================================================================
+// INVERTED_INDEX class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include "general/filefuncs.h"
+#include "cluster/inverted_index.h"
+
+using std::cout;
+using std::endl;
+using std::ifstream;
+using std::ios;
+using std::ofstream;
+using std::ostream;
+using std::pair;
+using std::string;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void inverted_index::allocate_member_objects()
+{
+   postings.assign(n_words,vector<unsigned char>());
+   last_posting_doc_IDs.assign(n_words,-1);
+   document_frequencies.assign(n_words,0);
+}
+
+void inverted_index::initialize_member_objects()
+{
+   n_documents=0;
+   last_doc_ID=-1;
+   total_word_count=0;
+   BM25_k1=1.2;
+   BM25_b=0.75;
+   document_norms_valid_flag=false;
+}
+
+inverted_index::inverted_index(int n_words)
+{
+   this->n_words=(n_words > 0) ? n_words : 0;
+   allocate_member_objects();
+   initialize_member_objects();
+}
+
+inverted_index::~inverted_index()
+{
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const inverted_index& I)
+{
+   outstream << endl;
+   outstream << "n_words = " << I.n_words
+             << " n_documents = " << I.n_documents
+             << " last_doc_ID = " << I.last_doc_ID << endl;
+   outstream << "total_word_count = " << I.total_word_count
+             << " n_posting_bytes = " << I.get_n_posting_bytes() << endl;
+   return outstream;
+}
+
+// ---------------------------------------------------------------------
+unsigned long inverted_index::get_n_posting_bytes() const
+{
+   unsigned long n_bytes=0;
+   for (unsigned int w=0; w<n_words; w++)
+   {
+      n_bytes += postings[w].size();
+   }
+   return n_bytes;
+}
+
+// ==========================================================================
+// Index construction member functions
+// ==========================================================================
+
+void inverted_index::clear()
+{
+   allocate_member_objects();
+   initialize_member_objects();
+   document_lengths.clear();
+   document_basenames.clear();
+   document_norms.clear();
+}
+
+// ---------------------------------------------------------------------
+// Member function remove_documents discards every document whose ID
+// is greater than or equal to doc_ID_start.  Since doc IDs increase
+// along each posting list, every posting list is simply cut off at
+// its first doc ID >= doc_ID_start.  Documents may subsequently be
+// re-added starting from doc_ID_start.
+
+void inverted_index::remove_documents(int doc_ID_start)
+{
+   if (doc_ID_start > last_doc_ID) return;
+   if (doc_ID_start < 0) doc_ID_start=0;
+
+   for (unsigned int w=0; w<n_words; w++)
+   {
+      vector<unsigned char>& curr_postings=postings[w];
+      if (last_posting_doc_IDs[w] < doc_ID_start) continue;
+
+      const unsigned char* start_ptr=&curr_postings[0];
+      const unsigned char* byte_ptr=start_ptr;
+      const unsigned char* stop_ptr=start_ptr+curr_postings.size();
+      int doc_ID=-1;
+      int prev_doc_ID=-1;
+      unsigned int n_kept=0;
+      while (byte_ptr < stop_ptr)
+      {
+         const unsigned char* posting_ptr=byte_ptr;
+         doc_ID += decode_varint(byte_ptr);
+         decode_varint(byte_ptr);
+         if (doc_ID >= doc_ID_start)
+         {
+            byte_ptr=posting_ptr;
+            break;
+         }
+         prev_doc_ID=doc_ID;
+         n_kept++;
+      }
+
+      curr_postings.resize(byte_ptr-start_ptr);
+      last_posting_doc_IDs[w]=prev_doc_ID;
+      document_frequencies[w]=n_kept;
+   } // loop over index w labeling words
+
+   for (int d=doc_ID_start; d<int(document_lengths.size()); d++)
+   {
+      if (document_lengths[d]==0 && document_basenames[d].size()==0)
+         continue;
+      n_documents--;
+      total_word_count -= document_lengths[d];
+   }
+   document_lengths.resize(doc_ID_start);
+   document_basenames.resize(doc_ID_start);
+
+   last_doc_ID=-1;
+   for (int d=doc_ID_start-1; d>=0; d--)
+   {
+      if (document_lengths[d] > 0 || document_basenames[d].size() > 0)
+      {
+         last_doc_ID=d;
+         break;
+      }
+   }
+   document_norms_valid_flag=false;
+}
+
+// ---------------------------------------------------------------------
+// Member function add_document appends an image whose dense word
+// count histogram (of length n_words) is passed in via word_counts.
+// Since posting lists hold doc ID deltas, doc_ID must exceed every
+// previously added doc ID.  Otherwise this boolean method returns
+// false and leaves the index unchanged.
+
+bool inverted_index::add_document(
+   int doc_ID,string basename,const int* word_counts)
+{
+   vector<pair<int,int> > sparse_word_counts;
+   for (unsigned int w=0; w<n_words; w++)
+   {
+      if (word_counts[w] > 0)
+         sparse_word_counts.push_back(pair<int,int>(w,word_counts[w]));
+   }
+   return add_document(doc_ID,basename,sparse_word_counts);
+}
+
+// ---------------------------------------------------------------------
+// This overloaded version of add_document takes in (word ID, count)
+// pairs.  Words with non-positive counts are ignored.
+
+bool inverted_index::add_document(
+   int doc_ID,string basename,const vector<pair<int,int> >& word_counts)
+{
+   if (doc_ID <= last_doc_ID)
+   {
+      cout << "Error in inverted_index::add_document()" << endl;
+      cout << "doc_ID = " << doc_ID << " does not exceed last_doc_ID = "
+           << last_doc_ID << endl;
+      return false;
+   }
+
+   unsigned int document_length=0;
+   for (unsigned int i=0; i<word_counts.size(); i++)
+   {
+      int w=word_counts[i].first;
+      int count=word_counts[i].second;
+      if (count <= 0) continue;
+      if (w < 0 || w >= int(n_words))
+      {
+         cout << "Error in inverted_index::add_document()" << endl;
+         cout << "word_ID = " << w << " lies outside [0," << n_words
+              << ")" << endl;
+         continue;
+      }
+
+      encode_varint(doc_ID-last_posting_doc_IDs[w],postings[w]);
+      encode_varint(count,postings[w]);
+      last_posting_doc_IDs[w]=doc_ID;
+      document_frequencies[w]++;
+      document_length += count;
+   } // loop over index i labeling words within current document
+
+   document_lengths.resize(doc_ID+1,0);
+   document_basenames.resize(doc_ID+1);
+   document_lengths[doc_ID]=document_length;
+   document_basenames[doc_ID]=basename;
+
+   last_doc_ID=doc_ID;
+   n_documents++;
+   total_word_count += document_length;
+   document_norms_valid_flag=false;
+   return true;
+}
+
+// ---------------------------------------------------------------------
+// Member function decode_posting_list expands the compressed posting
+// list for input word into increasing doc IDs and their word counts.
+
+void inverted_index::decode_posting_list(
+   int word_ID,vector<int>& doc_IDs,vector<int>& counts) const
+{
+   doc_IDs.clear();
+   counts.clear();
+
+   const vector<unsigned char>& curr_postings=postings[word_ID];
+   if (curr_postings.size()==0) return;
+
+   doc_IDs.reserve(document_frequencies[word_ID]);
+   counts.reserve(document_frequencies[word_ID]);
+
+   const unsigned char* byte_ptr=&curr_postings[0];
+   const unsigned char* stop_ptr=byte_ptr+curr_postings.size();
+   int doc_ID=-1;
+   while (byte_ptr < stop_ptr)
+   {
+      doc_ID += decode_varint(byte_ptr);
+      doc_IDs.push_back(doc_ID);
+      counts.push_back(decode_varint(byte_ptr));
+   }
+}
+
+// ==========================================================================
+// Index input/output member functions
+// ==========================================================================
+
+// Binary values are written in host byte order.
+
+namespace
+{
+   template <class T> void write_value(ofstream& outstream,T value)
+   {
+      outstream.write(reinterpret_cast<const char*>(&value),sizeof(T));
+   }
+
+   template <class T> bool read_value(ifstream& instream,T& value)
+   {
+      instream.read(reinterpret_cast<char*>(&value),sizeof(T));
+      return instream.good();
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function export_index writes lexicon.bin, postings.bin and
+// documents.bin into index_subdir.
+
+bool inverted_index::export_index(string index_subdir) const
+{
+   filefunc::dircreate(index_subdir);
+
+   string postings_filename=index_subdir+"postings.bin";
+   ofstream postings_stream(postings_filename.c_str(),ios::binary);
+   string lexicon_filename=index_subdir+"lexicon.bin";
+   ofstream lexicon_stream(lexicon_filename.c_str(),ios::binary);
+   if (!postings_stream.good() || !lexicon_stream.good())
+   {
+      cout << "Error in inverted_index::export_index()" << endl;
+      cout << "Could not open index files within " << index_subdir << endl;
+      return false;
+   }
+
+   write_value(lexicon_stream,magic_number);
+   write_value(lexicon_stream,format_version);
+   write_value(lexicon_stream,n_words);
+   write_value(lexicon_stream,n_documents);
+   write_value(lexicon_stream,(unsigned long long)(total_word_count));
+
+   unsigned long long offset=0;
+   for (unsigned int w=0; w<n_words; w++)
+   {
+      unsigned int n_bytes=postings[w].size();
+      write_value(lexicon_stream,offset);
+      write_value(lexicon_stream,n_bytes);
+      write_value(lexicon_stream,document_frequencies[w]);
+      if (n_bytes > 0)
+      {
+         postings_stream.write(
+            reinterpret_cast<const char*>(&postings[w][0]),n_bytes);
+      }
+      offset += n_bytes;
+   }
+
+   string documents_filename=index_subdir+"documents.bin";
+   ofstream documents_stream(documents_filename.c_str(),ios::binary);
+   for (unsigned int d=0; d<document_lengths.size(); d++)
+   {
+      if (document_basenames[d].size()==0 && document_lengths[d]==0)
+         continue;
+      write_value(documents_stream,int(d));
+      write_value(documents_stream,document_lengths[d]);
+      write_value(documents_stream,(unsigned int)(
+         document_basenames[d].size()));
+      documents_stream.write(
+         document_basenames[d].c_str(),document_basenames[d].size());
+   }
+
+   return lexicon_stream.good() && postings_stream.good() &&
+      documents_stream.good();
+}
+
+// ---------------------------------------------------------------------
+// Member function import_index reads an index previously written by
+// export_index.  Further documents with doc IDs exceeding those
+// already present may subsequently be appended.
+
+bool inverted_index::import_index(string index_subdir)
+{
+   string lexicon_filename=index_subdir+"lexicon.bin";
+   string postings_filename=index_subdir+"postings.bin";
+   string documents_filename=index_subdir+"documents.bin";
+   ifstream lexicon_stream(lexicon_filename.c_str(),ios::binary);
+   ifstream postings_stream(postings_filename.c_str(),ios::binary);
+   ifstream documents_stream(documents_filename.c_str(),ios::binary);
+   if (!lexicon_stream.good() || !postings_stream.good() ||
+       !documents_stream.good())
+   {
+      cout << "Error in inverted_index::import_index()" << endl;
+      cout << "Could not open index files within " << index_subdir << endl;
+      return false;
+   }
+
+   unsigned int curr_magic_number,curr_version,curr_n_words,
+      curr_n_documents;
+   unsigned long long curr_total_word_count;
+   read_value(lexicon_stream,curr_magic_number);
+   read_value(lexicon_stream,curr_version);
+   if (curr_magic_number != magic_number || curr_version != format_version)
+   {
+      cout << "Error in inverted_index::import_index()" << endl;
+      cout << lexicon_filename << " is not a version " << format_version
+           << " inverted index lexicon" << endl;
+      return false;
+   }
+   read_value(lexicon_stream,curr_n_words);
+   read_value(lexicon_stream,curr_n_documents);
+   read_value(lexicon_stream,curr_total_word_count);
+
+   n_words=curr_n_words;
+   clear();
+   n_documents=curr_n_documents;
+   total_word_count=curr_total_word_count;
+
+   for (unsigned int w=0; w<n_words; w++)
+   {
+      unsigned long long offset;
+      unsigned int n_bytes;
+      read_value(lexicon_stream,offset);
+      read_value(lexicon_stream,n_bytes);
+      if (!read_value(lexicon_stream,document_frequencies[w]))
+      {
+         cout << "Error in inverted_index::import_index()" << endl;
+         cout << "Truncated lexicon file " << lexicon_filename << endl;
+         clear();
+         return false;
+      }
+
+      postings[w].resize(n_bytes);
+      if (n_bytes > 0)
+      {
+         postings_stream.seekg(offset);
+         postings_stream.read(
+            reinterpret_cast<char*>(&postings[w][0]),n_bytes);
+      }
+   } // loop over index w labeling words
+
+// Recover the last doc ID within each posting list so that further
+// documents can be appended:
+
+   vector<int> doc_IDs,counts;
+   for (unsigned int w=0; w<n_words; w++)
+   {
+      decode_posting_list(w,doc_IDs,counts);
+      if (doc_IDs.size() > 0) last_posting_doc_IDs[w]=doc_IDs.back();
+   }
+
+   int doc_ID;
+   unsigned int document_length,basename_length;
+   while (read_value(documents_stream,doc_ID))
+   {
+      read_value(documents_stream,document_length);
+      read_value(documents_stream,basename_length);
+      string basename(basename_length,' ');
+      if (basename_length > 0)
+         documents_stream.read(&basename[0],basename_length);
+
+      document_lengths.resize(doc_ID+1,0);
+      document_basenames.resize(doc_ID+1);
+      document_lengths[doc_ID]=document_length;
+      document_basenames[doc_ID]=basename;
+      last_doc_ID=std::max(last_doc_ID,doc_ID);
+   }
+
+   return true;
+}
+
+// ==========================================================================
+// Query member functions
+// ==========================================================================
+
+// Member function inverse_document_frequency returns log(N/n_w) for
+// TF-IDF scoring as in akm::compute_inverse_document_frequencies().
+// For BM25 scoring, it returns the non-negative Robertson-Sparck
+// Jones weight log(1+(N-n_w+0.5)/(n_w+0.5)).
+
+double inverted_index::inverse_document_frequency(
+   int word_ID,scoring_type scoring) const
+{
+   double n_w=document_frequencies[word_ID];
+   if (n_w==0) return 0;
+   if (scoring==BM25)
+   {
+      return log(1+(n_documents-n_w+0.5)/(n_w+0.5));
+   }
+   return log(n_documents/n_w);
+}
+
+// ---------------------------------------------------------------------
+// Private member function compute_document_norms calculates the L2
+// norm of every document's TF-IDF vector.  Since IDFs change whenever
+// documents are added, norms are recomputed lazily before the first
+// TF-IDF query following any addition.
+
+void inverted_index::compute_document_norms()
+{
+   document_norms.assign(document_lengths.size(),0);
+   vector<int> doc_IDs,counts;
+   for (unsigned int w=0; w<n_words; w++)
+   {
+      double idf=inverse_document_frequency(w,TFIDF);
+      if (idf <= 0) continue;
+      decode_posting_list(w,doc_IDs,counts);
+      for (unsigned int p=0; p<doc_IDs.size(); p++)
+      {
+         double tfidf=idf*counts[p]/document_lengths[doc_IDs[p]];
+         document_norms[doc_IDs[p]] += tfidf*tfidf;
+      }
+   } // loop over index w labeling words
+
+   for (unsigned int d=0; d<document_norms.size(); d++)
+   {
+      document_norms[d]=sqrt(document_norms[d]);
+   }
+   document_norms_valid_flag=true;
+}
+
+// ---------------------------------------------------------------------
+// Member function query scores every document sharing at least one
+// word with the input query.  Only posting lists for the query's
+// words are decoded.  The IDs and scores of the k highest scoring
+// documents are returned in decreasing score order.
+
+// For TFIDF scoring, the score equals the cosine between the query's
+// and document's TF-IDF vectors.  For BM25 scoring, each shared word
+// contributes idf*tf*(k1+1)/(tf+k1*(1-b+b*dl/avgdl)) weighted by its
+// count within the query.
+
+void inverted_index::query(
+   const vector<pair<int,int> >& query_word_counts,unsigned int k,
+   scoring_type scoring,vector<int>& doc_IDs,vector<double>& scores)
+{
+   doc_IDs.clear();
+   scores.clear();
+   if (n_documents==0 || k==0) return;
+
+   if (scoring==TFIDF && !document_norms_valid_flag)
+      compute_document_norms();
+   score_accumulator.assign(document_lengths.size(),0);
+
+   double query_length=0;
+   for (unsigned int i=0; i<query_word_counts.size(); i++)
+   {
+      query_length += std::max(0,query_word_counts[i].second);
+   }
+   if (query_length==0) return;
+
+   double avg_document_length=double(total_word_count)/n_documents;
+   double query_norm=0;
+   vector<int> posting_doc_IDs,posting_counts;
+   for (unsigned int i=0; i<query_word_counts.size(); i++)
+   {
+      int w=query_word_counts[i].first;
+      int query_count=query_word_counts[i].second;
+      if (w < 0 || w >= int(n_words) || query_count <= 0) continue;
+
+      double idf=inverse_document_frequency(w,scoring);
+      if (idf <= 0) continue;
+      decode_posting_list(w,posting_doc_IDs,posting_counts);
+
+      if (scoring==TFIDF)
+      {
+         double query_tfidf=idf*query_count/query_length;
+         query_norm += query_tfidf*query_tfidf;
+         for (unsigned int p=0; p<posting_doc_IDs.size(); p++)
+         {
+            int d=posting_doc_IDs[p];
+            score_accumulator[d] += query_tfidf*
+               idf*posting_counts[p]/document_lengths[d];
+         }
+      }
+      else
+      {
+         for (unsigned int p=0; p<posting_doc_IDs.size(); p++)
+         {
+            int d=posting_doc_IDs[p];
+            double tf=posting_counts[p];
+            double denom=tf+BM25_k1*(
+               1-BM25_b+BM25_b*document_lengths[d]/avg_document_length);
+            score_accumulator[d] += query_count*idf*tf*(BM25_k1+1)/denom;
+         }
+      }
+   } // loop over index i labeling query words
+
+   vector<pair<double,int> > candidates;
+   for (unsigned int d=0; d<score_accumulator.size(); d++)
+   {
+      double curr_score=score_accumulator[d];
+      if (curr_score <= 0) continue;
+      if (scoring==TFIDF)
+      {
+         curr_score /= sqrt(query_norm)*document_norms[d];
+      }
+      candidates.push_back(pair<double,int>(-curr_score,d));
+   }
+
+   unsigned int n_results=std::min((unsigned int)(candidates.size()),k);
+   std::partial_sort(
+      candidates.begin(),candidates.begin()+n_results,candidates.end());
+   for (unsigned int r=0; r<n_results; r++)
+   {
+      doc_IDs.push_back(candidates[r].second);
+      scores.push_back(-candidates[r].first);
+   }
+}
+
+// ---------------------------------------------------------------------
+// This overloaded version of query takes in a dense word count
+// histogram of length n_words such as akm::get_image_word_count().
+
+void inverted_index::query(
+   const int* query_word_counts,unsigned int k,scoring_type scoring,
+   vector<int>& doc_IDs,vector<double>& scores)
+{
+   vector<pair<int,int> > sparse_word_counts;
+   for (unsigned int w=0; w<n_words; w++)
+   {
+      if (query_word_counts[w] > 0)
+         sparse_word_counts.push_back(
+            pair<int,int>(w,query_word_counts[w]));
+   }
+   query(sparse_word_counts,k,scoring,doc_IDs,scores);
+}
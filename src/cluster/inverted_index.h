@@ -0,0 +1,200 @@
+// ==========================================================================
+// Header file for INVERTED_INDEX class which holds visual word
+// posting lists for an image retrieval corpus.  For each vocabulary
+// word, the IDs of all images containing that word are stored in
+// increasing order along with the word's count within each image.
+// Doc IDs are delta encoded, and both deltas and counts are packed
+// as variable-length (LEB128) byte sequences.  So a typical posting
+// costs 2-3 bytes rather than a line within a text file.
+
+// Documents may be appended one at a time in increasing doc ID
+// order.  The index is exported to and imported from the following
+// binary files within an index subdirectory:
+
+//	lexicon.bin: 	magic, version, n_words, n_documents,
+//			total_word_count; then for each word its
+//			posting list byte offset, byte length and
+//			document frequency
+//	postings.bin:	concatenated compressed posting lists
+//	documents.bin:	for each document its ID, total word count
+//			and image basename
+
+// Top-k queries accumulate term-at-a-time scores within a dense
+// per-document array using either cosine-normalized TF-IDF or Okapi
+// BM25 weights.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef INVERTED_INDEX_H
+#define INVERTED_INDEX_H
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+class inverted_index
+{
+
+  public:
+
+   enum scoring_type
+   {
+      TFIDF=0, BM25=1
+   };
+
+   inverted_index(int n_words=0);
+   ~inverted_index();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const inverted_index& I);
+
+// Set and get member functions:
+
+   void set_BM25_params(double k1,double b);
+   unsigned int get_n_words() const;
+   unsigned int get_n_documents() const;
+   int get_last_doc_ID() const;
+   unsigned int get_document_frequency(int word_ID) const;
+   unsigned int get_document_length(int doc_ID) const;
+   std::string get_document_basename(int doc_ID) const;
+   unsigned long get_n_posting_bytes() const;
+
+// Index construction member functions:
+
+   void clear();
+   void remove_documents(int doc_ID_start);
+   bool add_document(
+      int doc_ID,std::string basename,const int* word_counts);
+   bool add_document(
+      int doc_ID,std::string basename,
+      const std::vector<std::pair<int,int> >& word_counts);
+   void decode_posting_list(
+      int word_ID,std::vector<int>& doc_IDs,std::vector<int>& counts) const;
+
+// Index input/output member functions:
+
+   bool export_index(std::string index_subdir) const;
+   bool import_index(std::string index_subdir);
+
+// Query member functions:
+
+   double inverse_document_frequency(
+      int word_ID,scoring_type scoring) const;
+   void query(
+      const std::vector<std::pair<int,int> >& query_word_counts,
+      unsigned int k,scoring_type scoring,
+      std::vector<int>& doc_IDs,std::vector<double>& scores);
+   void query(
+      const int* query_word_counts,unsigned int k,scoring_type scoring,
+      std::vector<int>& doc_IDs,std::vector<double>& scores);
+
+  private:
+
+   static const unsigned int magic_number=0x49564658;	// "IVFX"
+   static const unsigned int format_version=1;
+
+   unsigned int n_words,n_documents;
+   int last_doc_ID;
+   unsigned long total_word_count;
+   double BM25_k1,BM25_b;
+   bool document_norms_valid_flag;
+
+// Per-word members:
+
+   std::vector<std::vector<unsigned char> > postings;
+   std::vector<int> last_posting_doc_IDs;
+   std::vector<unsigned int> document_frequencies;
+
+// Per-document members indexed by doc ID.  Doc IDs which were never
+// added have zero length:
+
+   std::vector<unsigned int> document_lengths;
+   std::vector<std::string> document_basenames;
+   std::vector<double> document_norms;
+   std::vector<double> score_accumulator;
+
+   void allocate_member_objects();
+   void initialize_member_objects();
+
+   static void encode_varint(
+      unsigned int value,std::vector<unsigned char>& bytes);
+   static unsigned int decode_varint(const unsigned char*& byte_ptr);
+
+   void compute_document_norms();
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+inline void inverted_index::set_BM25_params(double k1,double b)
+{
+   BM25_k1=k1;
+   BM25_b=b;
+}
+
+inline unsigned int inverted_index::get_n_words() const
+{
+   return n_words;
+}
+
+inline unsigned int inverted_index::get_n_documents() const
+{
+   return n_documents;
+}
+
+inline int inverted_index::get_last_doc_ID() const
+{
+   return last_doc_ID;
+}
+
+inline unsigned int inverted_index::get_document_frequency(int word_ID) const
+{
+   return document_frequencies[word_ID];
+}
+
+inline unsigned int inverted_index::get_document_length(int doc_ID) const
+{
+   if (doc_ID < 0 || doc_ID >= int(document_lengths.size())) return 0;
+   return document_lengths[doc_ID];
+}
+
+inline std::string inverted_index::get_document_basename(int doc_ID) const
+{
+   if (doc_ID < 0 || doc_ID >= int(document_basenames.size())) return "";
+   return document_basenames[doc_ID];
+}
+
+// ---------------------------------------------------------------------
+// Method encode_varint appends value to bytes seven bits at a time.
+// The high bit of each byte indicates whether more bytes follow.
+
+inline void inverted_index::encode_varint(
+   unsigned int value,std::vector<unsigned char>& bytes)
+{
+   while (value >= 0x80)
+   {
+      bytes.push_back(static_cast<unsigned char>(value | 0x80));
+      value >>= 7;
+   }
+   bytes.push_back(static_cast<unsigned char>(value));
+}
+
+inline unsigned int inverted_index::decode_varint(
+   const unsigned char*& byte_ptr)
+{
+   unsigned int value=0;
+   unsigned int shift=0;
+   while (*byte_ptr & 0x80)
+   {
+      value |= (unsigned int)(*byte_ptr & 0x7f) << shift;
+      shift += 7;
+      byte_ptr++;
+   }
+   value |= (unsigned int)(*byte_ptr) << shift;
+   byte_ptr++;
+   return value;
+}
+
+#endif  // inverted_index.h
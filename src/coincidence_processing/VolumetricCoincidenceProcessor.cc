@@ -7,7 +7,7 @@
 // ==========================================================================
 // VolumetricCoincidenceProcessor class member functions
 // ==========================================================================
-// Last updated on 9/1/12; 1/17/13; 1/22/13; 4/5/14
+// Last updated on 9/1/12; 1/17/13; 1/22/13; 4/5/14; 10/18/26
 // ==========================================================================
 
 #include <algorithm>
@@ -22,6 +22,7 @@
 #include "general/stringfuncs.h"
 #include "general/sysfuncs.h"
 #include "coincidence_processing/VolumetricCoincidenceProcessor.h"
+#include "coincidence_processing/voxel_brick_grid.h"
 #include "coincidence_processing/voxel_coords.h"
 
 using std::cin;
@@ -355,6 +356,82 @@ void VolumetricCoincidenceProcessor::accumulate_points(
    }
 }
 
+// ---------------------------------------------------------------------
+// These overloaded versions of accumulate_points bin an entire batch
+// of (x,y,z) points at once.  Each thread accumulates counts within
+// its own voxel_brick_grid.  The thread-local grids are merged and
+// then transferred into *voxels_map_ptr in sorted key order.  So the
+// map is touched just once per occupied voxel rather than once per
+// point.  Points are assigned to voxels via xyz_to_key_mnp().  So
+// every point lands within the same voxel as it would via the
+// single-point accumulate_points() methods.  If input STL vector
+// n_counts is empty, each point contributes a single count.
+
+void VolumetricCoincidenceProcessor::accumulate_points(
+   const vector<threevector>& XYZ_points)
+{
+   vector<int> n_counts;
+   accumulate_points(XYZ_points,n_counts);
+}
+
+void VolumetricCoincidenceProcessor::accumulate_points(
+   const vector<threevector>& XYZ_points,const vector<int>& n_counts)
+{
+   bool unit_counts_flag=n_counts.empty();
+   int n_points=XYZ_points.size();
+   voxel_brick_grid merged_grid(mdim,ndim,pdim);
+
+#pragma omp parallel
+   {
+      voxel_brick_grid thread_grid(mdim,ndim,pdim);
+
+#pragma omp for schedule(static)
+      for (int i=0; i<n_points; i++)
+      {
+         const threevector& curr_point=XYZ_points[i];
+         if (!xyz_inside_volume(curr_point)) continue;
+
+         unsigned int m,n,p;
+         xyz_to_key_mnp(
+            curr_point.get(0),curr_point.get(1),curr_point.get(2),m,n,p);
+         thread_grid.increment_voxel_counts(
+            m,n,p,unit_counts_flag ? 1 : n_counts[i]);
+      } // loop over index i labeling input points
+
+#pragma omp critical
+      merged_grid.merge(thread_grid);
+   } // end of omp parallel region
+
+   merged_grid.transfer_to_voxel_map(voxels_map_ptr);
+}
+
+void VolumetricCoincidenceProcessor::accumulate_points(
+   const vector<double>& X,const vector<double>& Y,const vector<double>& Z)
+{
+   int n_points=X.size();
+   voxel_brick_grid merged_grid(mdim,ndim,pdim);
+
+#pragma omp parallel
+   {
+      voxel_brick_grid thread_grid(mdim,ndim,pdim);
+
+#pragma omp for schedule(static)
+      for (int i=0; i<n_points; i++)
+      {
+         if (!xyz_inside_volume(X[i],Y[i],Z[i])) continue;
+
+         unsigned int m,n,p;
+         xyz_to_key_mnp(X[i],Y[i],Z[i],m,n,p);
+         thread_grid.increment_voxel_counts(m,n,p);
+      } // loop over index i labeling input points
+
+#pragma omp critical
+      merged_grid.merge(thread_grid);
+   } // end of omp parallel region
+
+   merged_grid.transfer_to_voxel_map(voxels_map_ptr);
+}
+
 // ---------------------------------------------------------------------
 // Method generate_counts_histogram scans through all of the entries
 // within *voxels_map_ptr and forms a counts frequency
@@ -1,7 +1,7 @@
 // ==========================================================================
 // header for VolumetricCoincidenceProcessor class
 // ==========================================================================
-// Last updated on 9/1/12; 1/17/13; 1/22/13; 4/5/14
+// Last updated on 9/1/12; 1/17/13; 1/22/13; 4/5/14; 10/18/26
 // ==========================================================================
 
 #ifndef VolumetricCoincidenceProcessor_H
@@ -87,6 +87,13 @@ class VolumetricCoincidenceProcessor
       double x,double y,double z,double p);
    void accumulate_points(const threevector& curr_point);
    void accumulate_points(const threevector& curr_point,int n_counts);
+   void accumulate_points(const std::vector<threevector>& XYZ_points);
+   void accumulate_points(
+      const std::vector<threevector>& XYZ_points,
+      const std::vector<int>& n_counts);
+   void accumulate_points(
+      const std::vector<double>& X,const std::vector<double>& Y,
+      const std::vector<double>& Z);
    void generate_counts_histogram();
    void generate_p_vs_z_profiles();
    void generate_p_distribution();
@@ -119,6 +126,8 @@ class VolumetricCoincidenceProcessor
    unsigned int key_to_n(long key) const;
    unsigned int key_to_p(long key) const;
    voxel_coords key_to_mnp(long key) const;
+   void xyz_to_key_mnp(double x,double y,double z,
+                       unsigned int& m,unsigned int& n,unsigned int& p) const;
    long xyz_to_key(double x,double y,double z) const;
    long xyz_to_key(const threevector& V) const;
    threevector key_to_xyz(long key) const;
@@ -457,12 +466,24 @@ inline voxel_coords VolumetricCoincidenceProcessor::key_to_mnp(long key) const
 // volume.  It returns a unique integer which labels the voxel to
 // which this point belongs.
 
+// Member function xyz_to_key_mnp returns the voxel coordinates from
+// which xyz_to_key() forms its key.  Unlike xyz_to_mnp(), it does not
+// clamp its outputs to the lattice.
+
+inline void VolumetricCoincidenceProcessor::xyz_to_key_mnp(
+   double x,double y,double z,
+   unsigned int& m,unsigned int& n,unsigned int& p) const
+{
+   m=basic_math::round((x-xlo)/dx);
+   n=basic_math::round((y-ylo)/dy);
+   p=basic_math::round((z-zlo)/dz);
+}
+
 inline long VolumetricCoincidenceProcessor::xyz_to_key(
    double x,double y,double z) const
 {
-   unsigned int m=basic_math::round((x-xlo)/dx);
-   unsigned int n=basic_math::round((y-ylo)/dy);
-   unsigned int p=basic_math::round((z-zlo)/dz);
+   unsigned int m,n,p;
+   xyz_to_key_mnp(x,y,z,m,n,p);
 //   std::cout << "m = " << m << " n = " << n << " p = " << p << std::endl;
 //   std::cout << "mdim = " << mdim << " ndim = " << ndim << " pdim = " << pdim
 //             << std::endl;
@@ -472,9 +493,8 @@ inline long VolumetricCoincidenceProcessor::xyz_to_key(
 inline long VolumetricCoincidenceProcessor::xyz_to_key(const threevector& V)
    const
 {
-   unsigned int m=basic_math::round((V.get(0)-xlo)/dx);
-   unsigned int n=basic_math::round((V.get(1)-ylo)/dy);
-   unsigned int p=basic_math::round((V.get(2)-zlo)/dz);
+   unsigned int m,n,p;
+   xyz_to_key_mnp(V.get(0),V.get(1),V.get(2),m,n,p);
    return mnp_to_key(m,n,p);
 
 // On 5/7/04, we discovered that replacing rounding with truncation
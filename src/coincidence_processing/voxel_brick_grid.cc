@@ -0,0 +1,164 @@
+// ==========================================================================
+// VOXEL_BRICK_GRID class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <algorithm>
+#include <iostream>
+#include "coincidence_processing/voxel_brick_grid.h"
+
+using std::cout;
+using std::endl;
+using std::pair;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void voxel_brick_grid::allocate_member_objects()
+{
+   bricks_ptr=new vector<voxel_brick>;
+   brick_index_hashtable_ptr=new Flat_hashtable<int>(1024);
+}
+
+void voxel_brick_grid::initialize_member_objects()
+{
+   m_bricks=mdim/brick_edge+1;
+   n_bricks=ndim/brick_edge+1;
+   last_brick_key=-1;
+   last_brick_index=0;
+}
+
+voxel_brick_grid::voxel_brick_grid(
+   unsigned int mdim,unsigned int ndim,unsigned int pdim)
+{
+   this->mdim=mdim;
+   this->ndim=ndim;
+   this->pdim=pdim;
+   allocate_member_objects();
+   initialize_member_objects();
+}
+
+voxel_brick_grid::~voxel_brick_grid()
+{
+   delete bricks_ptr;
+   delete brick_index_hashtable_ptr;
+}
+
+// ---------------------------------------------------------------------
+void voxel_brick_grid::clear()
+{
+   bricks_ptr->clear();
+   brick_index_hashtable_ptr->purge_all_entries();
+   last_brick_key=-1;
+   last_brick_index=0;
+}
+
+// ---------------------------------------------------------------------
+unsigned int voxel_brick_grid::count_occupied_voxels() const
+{
+   unsigned int n_occupied=0;
+   for (unsigned int b=0; b<bricks_ptr->size(); b++)
+   {
+      const voxel_brick& curr_brick=(*bricks_ptr)[b];
+      for (unsigned int w=0; w<brick_volume/64; w++)
+      {
+         n_occupied += __builtin_popcountl(curr_brick.occupied[w]);
+      }
+   }
+   return n_occupied;
+}
+
+// ==========================================================================
+// Counts accumulation member functions
+// ==========================================================================
+
+// Member function merge adds every occupied voxel within other_grid
+// into this grid.  It is intended for combining thread-local grids.
+// The two grids must have identical dimensions.
+
+void voxel_brick_grid::merge(const voxel_brick_grid& other_grid)
+{
+   for (unsigned int b=0; b<other_grid.bricks_ptr->size(); b++)
+   {
+      const voxel_brick& other_brick=(*other_grid.bricks_ptr)[b];
+      voxel_brick& curr_brick=get_brick(other_brick.brick_key);
+      for (unsigned int w=0; w<brick_volume/64; w++)
+      {
+         curr_brick.occupied[w] |= other_brick.occupied[w];
+      }
+      for (unsigned int i=0; i<brick_volume; i++)
+      {
+         curr_brick.counts[i] += other_brick.counts[i];
+      }
+   } // loop over index b labeling other grid's bricks
+}
+
+// ---------------------------------------------------------------------
+// Member function transfer_to_voxel_map converts every occupied voxel
+// into a VolumetricCoincidenceProcessor key.  Key/count pairs are
+// sorted and then added to *voxels_map_ptr.  New voxels are created
+// with zero probability just as in
+// VolumetricCoincidenceProcessor::increment_voxel_counts().  When the
+// map is initially empty, each sorted key is inserted at the end of
+// the tree in amortized constant time.
+
+void voxel_brick_grid::transfer_to_voxel_map(VOXEL_MAP* voxels_map_ptr) const
+{
+   vector<pair<long,int> > key_counts;
+   key_counts.reserve(count_occupied_voxels());
+
+   for (unsigned int b=0; b<bricks_ptr->size(); b++)
+   {
+      const voxel_brick& curr_brick=(*bricks_ptr)[b];
+      unsigned int brick_m=curr_brick.brick_key%long(m_bricks);
+      long brick_np=curr_brick.brick_key/long(m_bricks);
+      unsigned int brick_n=brick_np%n_bricks;
+      unsigned int brick_p=brick_np/n_bricks;
+
+      for (unsigned int i=0; i<brick_volume; i++)
+      {
+         if (!((curr_brick.occupied[i >> 6] >> (i & 63)) & 1UL)) continue;
+
+         unsigned int m=(brick_m << brick_bits)+(i & (brick_edge-1));
+         unsigned int n=(brick_n << brick_bits)+
+            ((i >> brick_bits) & (brick_edge-1));
+         unsigned int p=(brick_p << brick_bits)+(i >> (2*brick_bits));
+         long key=long(mdim)*long(ndim)*long(p)+long(mdim)*long(n)+long(m);
+         key_counts.push_back(pair<long,int>(key,curr_brick.counts[i]));
+      } // loop over index i labeling voxels within current brick
+   } // loop over index b labeling bricks
+
+   std::sort(key_counts.begin(),key_counts.end());
+
+   if (voxels_map_ptr->empty())
+   {
+      for (unsigned int k=0; k<key_counts.size(); k++)
+      {
+         voxels_map_ptr->insert(
+            voxels_map_ptr->end(),VOXEL_MAP::value_type(
+               key_counts[k].first,Voxel_type(key_counts[k].second,0)));
+      }
+   }
+   else
+   {
+      for (unsigned int k=0; k<key_counts.size(); k++)
+      {
+         VOXEL_MAP::iterator voxel_iter=
+            voxels_map_ptr->lower_bound(key_counts[k].first);
+         if (voxel_iter != voxels_map_ptr->end() &&
+             voxel_iter->first==key_counts[k].first)
+         {
+            voxel_iter->second.first += key_counts[k].second;
+         }
+         else
+         {
+            voxels_map_ptr->insert(
+               voxel_iter,VOXEL_MAP::value_type(
+                  key_counts[k].first,Voxel_type(key_counts[k].second,0)));
+         }
+      } // loop over index k labeling sorted voxel keys
+   }
+}
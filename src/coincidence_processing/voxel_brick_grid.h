@@ -0,0 +1,160 @@
+// ==========================================================================
+// Header file for VOXEL_BRICK_GRID class which accumulates voxel
+// counts within a blocked sparse lattice.  The (m,n,p) lattice is
+// partitioned into 8x8x8 dense bricks.  Only bricks containing at
+// least one occupied voxel are allocated.  They are located via a
+// Flat_hashtable which maps 64-bit brick keys onto brick indices.
+// Incrementing a voxel therefore costs one hash probe plus an array
+// write rather than a red-black tree descent and node allocation.
+
+// Independent grids may be filled by separate threads and then merged
+// together.  Accumulated counts are finally transferred into a
+// VOXEL_MAP in sorted key order.  Voxel keys are formed exactly as by
+// VolumetricCoincidenceProcessor::mnp_to_key().  Since
+// VolumetricCoincidenceProcessor::xyz_to_key() does not clamp its
+// voxel coordinates, grids accept indices up to and including mdim,
+// ndim and pdim.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef VOXEL_BRICK_GRID_H
+#define VOXEL_BRICK_GRID_H
+
+#include <vector>
+#include "coincidence_processing/VolumetricCoincidenceProcessor.h"
+#include "datastructures/Flat_hashtable.h"
+
+class voxel_brick_grid
+{
+
+  public:
+
+   static const unsigned int brick_bits=3;
+   static const unsigned int brick_edge=1 << brick_bits;		// 8
+   static const unsigned int brick_volume=
+      brick_edge*brick_edge*brick_edge;				// 512
+
+   voxel_brick_grid(unsigned int mdim,unsigned int ndim,unsigned int pdim);
+   ~voxel_brick_grid();
+
+// Set and get member functions:
+
+   unsigned int get_n_bricks() const;
+   unsigned int count_occupied_voxels() const;
+
+// Counts accumulation member functions:
+
+   void increment_voxel_counts(
+      unsigned int m,unsigned int n,unsigned int p,int delta_counts=1);
+   void merge(const voxel_brick_grid& other_grid);
+   void transfer_to_voxel_map(VOXEL_MAP* voxels_map_ptr) const;
+   void clear();
+
+  private:
+
+   struct voxel_brick
+   {
+         long brick_key;
+         unsigned long occupied[brick_volume/64];
+         int counts[brick_volume];
+   };
+
+   unsigned int mdim,ndim,pdim;
+   unsigned int m_bricks,n_bricks;
+   long last_brick_key;
+   unsigned int last_brick_index;
+   std::vector<voxel_brick>* bricks_ptr;
+   Flat_hashtable<int>* brick_index_hashtable_ptr;
+
+   void allocate_member_objects();
+   void initialize_member_objects();
+
+   voxel_brick& get_brick(long brick_key);
+   long mnp_to_brick_key(
+      unsigned int m,unsigned int n,unsigned int p) const;
+   unsigned int mnp_to_local_index(
+      unsigned int m,unsigned int n,unsigned int p) const;
+
+// Disallow copying since each grid owns and deletes its brick storage
+// and hashtable:
+
+   voxel_brick_grid(const voxel_brick_grid& g);
+   voxel_brick_grid& operator= (const voxel_brick_grid& g);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+inline unsigned int voxel_brick_grid::get_n_bricks() const
+{
+   return bricks_ptr->size();
+}
+
+// Brick keys are formed in 64-bit arithmetic just like
+// VolumetricCoincidenceProcessor voxel keys.  So large lattices do
+// not overflow them.
+
+inline long voxel_brick_grid::mnp_to_brick_key(
+   unsigned int m,unsigned int n,unsigned int p) const
+{
+   return long(m >> brick_bits)+long(m_bricks)*(
+      long(n >> brick_bits)+long(n_bricks)*long(p >> brick_bits));
+}
+
+inline unsigned int voxel_brick_grid::mnp_to_local_index(
+   unsigned int m,unsigned int n,unsigned int p) const
+{
+   const unsigned int brick_mask=brick_edge-1;
+   return (m & brick_mask)+brick_edge*(
+      (n & brick_mask)+brick_edge*(p & brick_mask));
+}
+
+// ---------------------------------------------------------------------
+// Member function get_brick returns the brick labeled by brick_key.
+// If no such brick exists, an empty one is appended.  Since
+// successive ladar returns usually fall into the same brick, the most
+// recently used brick is checked before the hashtable is probed.
+
+inline voxel_brick_grid::voxel_brick& voxel_brick_grid::get_brick(
+   long brick_key)
+{
+   if (brick_key==last_brick_key) return (*bricks_ptr)[last_brick_index];
+
+   last_brick_key=brick_key;
+   Flat_hashnode<int>* node_ptr=
+      brick_index_hashtable_ptr->retrieve_key(brick_key);
+   if (node_ptr != NULL)
+   {
+      last_brick_index=node_ptr->get_data();
+      return (*bricks_ptr)[last_brick_index];
+   }
+
+   last_brick_index=bricks_ptr->size();
+   brick_index_hashtable_ptr->insert_key(brick_key,last_brick_index);
+   bricks_ptr->push_back(voxel_brick());
+   voxel_brick& curr_brick=bricks_ptr->back();
+   curr_brick.brick_key=brick_key;
+   for (unsigned int w=0; w<brick_volume/64; w++)
+   {
+      curr_brick.occupied[w]=0;
+   }
+   for (unsigned int i=0; i<brick_volume; i++)
+   {
+      curr_brick.counts[i]=0;
+   }
+   return curr_brick;
+}
+
+// ---------------------------------------------------------------------
+inline void voxel_brick_grid::increment_voxel_counts(
+   unsigned int m,unsigned int n,unsigned int p,int delta_counts)
+{
+   voxel_brick& curr_brick=get_brick(mnp_to_brick_key(m,n,p));
+   unsigned int i=mnp_to_local_index(m,n,p);
+   curr_brick.occupied[i >> 6] |= 1UL << (i & 63);
+   curr_brick.counts[i] += delta_counts;
+}
+
+#endif  // voxel_brick_grid.h
@@ -0,0 +1,358 @@
+// ==========================================================================
+// Templatized Flat_hashtable class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <iostream>
+#include <utility>
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor methods:
+// ---------------------------------------------------------------------
+
+// Member function allocate_member_objects sets the table's capacity
+// to the smallest power of two which can hold n_keys entries without
+// exceeding the maximum load factor.
+
+template <class T> void Flat_hashtable<T>::allocate_member_objects(
+   unsigned int n_keys)
+{
+   unsigned int min_capacity=
+      n_keys*max_load_denominator/max_load_numerator+1;
+   capacity=8;
+   while (capacity < min_capacity) capacity *= 2;
+   mask=capacity-1;
+   nodes.assign(capacity,Flat_hashnode<T>());
+}
+
+// Input parameter c indicates the expected number of keys.  Unlike
+// Hashtable, the table grows automatically if more keys are inserted.
+
+template <class T> Flat_hashtable<T>::Flat_hashtable(int c)
+{
+   allocate_member_objects(c > 0 ? c : 0);
+   initialize_member_objects();
+}
+
+// Copy constructor:
+
+template <class T> Flat_hashtable<T>::Flat_hashtable(const Flat_hashtable<T>& h)
+{
+   allocate_member_objects(0);
+   initialize_member_objects();
+   docopy(h);
+}
+
+// ---------------------------------------------------------------------
+// Member function purge_all_entries marks every slot as empty.  But
+// it does not release the table's memory.
+
+template <class T> void Flat_hashtable<T>::purge_all_entries()
+{
+   for (unsigned int i=0; i<capacity; i++)
+   {
+      nodes[i]=Flat_hashnode<T>();
+   }
+   nkeys_in_table=0;
+}
+
+template <class T> Flat_hashtable<T>::~Flat_hashtable()
+{
+}
+
+// ---------------------------------------------------------------------
+template <class T> void Flat_hashtable<T>::docopy(const Flat_hashtable<T>& h)
+{
+   nkeys_in_table=h.nkeys_in_table;
+   capacity=h.capacity;
+   mask=h.mask;
+   nodes=h.nodes;
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+template <class T> std::ostream& operator<<
+(std::ostream& outstream,const Flat_hashtable<T>& h)
+{
+   outstream << std::endl;
+   outstream << "Number of keys in hash table = "
+             << h.nkeys_in_table << std::endl;
+   for (unsigned int n=0; n<h.capacity; n++)
+   {
+      if (h.occupied_slot(n))
+      {
+         outstream << "Slot " << n << " : key = " << h.nodes[n].ID
+                   << " data = " << h.nodes[n].data << std::endl;
+      }
+   }
+   return outstream;
+}
+
+// ---------------------------------------------------------------------
+// Member function convert_hashtable_to_vector copies the data within
+// every occupied slot into an output STL vector.
+
+template <class T> std::vector<T>*
+Flat_hashtable<T>::convert_hashtable_to_vector() const
+{
+   std::vector<T>* V_ptr=new std::vector<T>;
+   V_ptr->reserve(size());
+   for (unsigned int i=0; i<capacity; i++)
+   {
+      if (occupied_slot(i)) V_ptr->push_back(nodes[i].data);
+   }
+   return V_ptr;
+}
+
+// ---------------------------------------------------------------------
+// Member function display_dereferenced_contents prints out the data
+// within every occupied slot to output filestream hashstream.
+
+template <class T> void Flat_hashtable<T>::display_dereferenced_contents(
+   std::ostream& hashstream) const
+{
+   for (unsigned int i=0; i<capacity; i++)
+   {
+      if (occupied_slot(i)) hashstream << nodes[i].data << std::endl;
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function print_probe_distance_histogram is the analog of
+// Hashtable::print_collision_table().  It reports how many keys lie
+// zero, one, two, etc slots away from their home locations.
+
+template <class T> void Flat_hashtable<T>::print_probe_distance_histogram()
+   const
+{
+   std::vector<int> histogram;
+   for (unsigned int n=0; n<capacity; n++)
+   {
+      int dist=nodes[n].probe_distance;
+      if (dist < 0) continue;
+      if (dist >= int(histogram.size())) histogram.resize(dist+1,0);
+      histogram[dist]++;
+   }
+
+   std::cout << "Flat_hashtable capacity = " << capacity
+             << " nkeys = " << nkeys_in_table << std::endl;
+   for (unsigned int d=0; d<histogram.size(); d++)
+   {
+      std::cout << "Probe distance " << d << " : "
+                << histogram[d] << " keys" << std::endl;
+   }
+}
+
+// ==========================================================================
+// Key insertion, retrieval and deletion member functions
+// ==========================================================================
+
+// Member function reserve enlarges the table so that it can hold at
+// least n_keys entries without further rehashing.
+
+template <class T> void Flat_hashtable<T>::reserve(unsigned int n_keys)
+{
+   unsigned int min_capacity=
+      n_keys*max_load_denominator/max_load_numerator+1;
+   unsigned int new_capacity=capacity;
+   while (new_capacity < min_capacity) new_capacity *= 2;
+   if (new_capacity > capacity) rehash(new_capacity);
+}
+
+// ---------------------------------------------------------------------
+// Private member function rehash moves every entry into a freshly
+// allocated table containing new_capacity slots.
+
+template <class T> void Flat_hashtable<T>::rehash(unsigned int new_capacity)
+{
+   std::vector<Flat_hashnode<T> > old_nodes;
+   old_nodes.swap(nodes);
+
+   capacity=new_capacity;
+   mask=capacity-1;
+   nodes.assign(capacity,Flat_hashnode<T>());
+   nkeys_in_table=0;
+
+   for (unsigned int i=0; i<old_nodes.size(); i++)
+   {
+      if (!old_nodes[i].empty())
+      {
+         insert_new_key(old_nodes[i].ID,old_nodes[i].data);
+      }
+   }
+}
+
+// ---------------------------------------------------------------------
+// Private member function insert_new_key assumes that input key does
+// not already reside within the table.  Following the Robin Hood
+// rule, the incoming entry displaces any occupant which lies closer
+// to its own home slot.  The displaced occupant then continues
+// probing in its place.  This method returns a pointer to the slot
+// which ends up holding the input key.
+
+template <class T> Flat_hashnode<T>* Flat_hashtable<T>::insert_new_key(
+   long key,const T& data)
+{
+   if ((nkeys_in_table+1)*max_load_denominator >
+       capacity*max_load_numerator)
+   {
+      rehash(2*capacity);
+   }
+
+   Flat_hashnode<T> curr_node;
+   curr_node.ID=key;
+   curr_node.probe_distance=0;
+   curr_node.data=data;
+
+   Flat_hashnode<T>* inserted_node_ptr=NULL;
+   unsigned int location=compute_location(key);
+   while (true)
+   {
+      Flat_hashnode<T>& slot=nodes[location];
+      if (slot.empty())
+      {
+         slot=curr_node;
+         if (inserted_node_ptr==NULL) inserted_node_ptr=&slot;
+         break;
+      }
+      if (slot.probe_distance < curr_node.probe_distance)
+      {
+         std::swap(slot,curr_node);
+         if (inserted_node_ptr==NULL) inserted_node_ptr=&slot;
+      }
+      location=(location+1) & mask;
+      curr_node.probe_distance++;
+   }
+   nkeys_in_table++;
+   return inserted_node_ptr;
+}
+
+// ---------------------------------------------------------------------
+// Member function insert_key adds the input key/data pair to the
+// table.  If the key already exists, its data is overwritten.  The
+// overloaded version which takes in a location is provided for
+// compatibility with Hashtable.  Its location argument is ignored.
+
+template <class T> Flat_hashnode<T>* Flat_hashtable<T>::insert_key(
+   long key,T data)
+{
+   return update_key(key,data);
+}
+
+template <class T> Flat_hashnode<T>* Flat_hashtable<T>::insert_key(
+   long key,int location,T data)
+{
+   return update_key(key,data);
+}
+
+// ---------------------------------------------------------------------
+// Member function update_key resets the data associated with input
+// key if it exists within the table.  Otherwise, it inserts a new
+// entry.
+
+template <class T> Flat_hashnode<T>* Flat_hashtable<T>::update_key(
+   long key,T data)
+{
+   Flat_hashnode<T>* currnode_ptr=retrieve_key(key);
+   if (currnode_ptr != NULL)
+   {
+      currnode_ptr->data=data;
+      return currnode_ptr;
+   }
+   return insert_new_key(key,data);
+}
+
+// ---------------------------------------------------------------------
+// Member function delete_key removes input key from the table.
+// Subsequent entries within the same probe run are shifted back by
+// one slot so that no tombstones are needed.
+
+template <class T> void Flat_hashtable<T>::delete_key(long key)
+{
+   int location=find_slot(key);
+   if (location < 0) return;
+
+   unsigned int curr_location=location;
+   unsigned int next_location=(curr_location+1) & mask;
+   while (nodes[next_location].probe_distance > 0)
+   {
+      nodes[curr_location]=nodes[next_location];
+      nodes[curr_location].probe_distance--;
+      curr_location=next_location;
+      next_location=(next_location+1) & mask;
+   }
+   nodes[curr_location]=Flat_hashnode<T>();
+   nkeys_in_table--;
+}
+
+// ==========================================================================
+// Data manipulation member functions
+// ==========================================================================
+
+template <class T> int Flat_hashtable<T>::explicitly_count_entries() const
+{
+   int n_entries=0;
+   for (unsigned int i=0; i<capacity; i++)
+   {
+      if (occupied_slot(i)) n_entries++;
+   }
+   return n_entries;
+}
+
+// ---------------------------------------------------------------------
+// Member functions max_data_value and min_data_value are intended to
+// be used for primitive data types such as integers, floats and
+// doubles where operator> is well-defined.
+
+template <class T> T Flat_hashtable<T>::max_data_value() const
+{
+   bool first_value=true;
+   T max_value=T();
+   for (unsigned int i=0; i<capacity; i++)
+   {
+      if (!occupied_slot(i)) continue;
+      const T& curr_value=nodes[i].data;
+      if (first_value || curr_value > max_value)
+      {
+         first_value=false;
+         max_value=curr_value;
+      }
+   }
+   return max_value;
+}
+
+template <class T> T Flat_hashtable<T>::min_data_value() const
+{
+   bool first_value=true;
+   T min_value=T();
+   for (unsigned int i=0; i<capacity; i++)
+   {
+      if (!occupied_slot(i)) continue;
+      const T& curr_value=nodes[i].data;
+      if (first_value || curr_value < min_value)
+      {
+         first_value=false;
+         min_value=curr_value;
+      }
+   }
+   return min_value;
+}
+
+// ---------------------------------------------------------------------
+template <class T> void Flat_hashtable<T>::shift_data_values(T alpha)
+{
+   for (unsigned int i=0; i<capacity; i++)
+   {
+      if (occupied_slot(i)) nodes[i].data=nodes[i].data+alpha;
+   }
+}
+
+template <class T> void Flat_hashtable<T>::rescale_data_values(T alpha)
+{
+   for (unsigned int i=0; i<capacity; i++)
+   {
+      if (occupied_slot(i)) nodes[i].data=alpha*nodes[i].data;
+   }
+}
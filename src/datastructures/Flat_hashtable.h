@@ -0,0 +1,333 @@
+// ==========================================================================
+// Header file for templatized Flat_hashtable class.  Flat_hashtable
+// offers the same key insertion, retrieval, increment and deletion
+// interface as Hashtable.  But rather than storing an array of
+// pointers to linked lists of dynamically allocated Mynodes, it holds
+// all of its entries within a single contiguous array.  Collisions are
+// resolved via Robin Hood open addressing with backward shift
+// deletion.  So lookups touch just a few adjacent cache lines, and no
+// memory is allocated per key.
+
+// Since entries may be moved whenever keys are inserted or deleted,
+// node pointers returned by this class remain valid only until the
+// next insertion or deletion.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef T_FLAT_HASHTABLE_H
+#define T_FLAT_HASHTABLE_H
+
+#include <iostream>
+#include <vector>
+
+// ==========================================================================
+// Flat_hashnode holds a single key along with its data and its probe
+// distance from its home slot.  Its get and set member functions
+// mirror those of Mynode.
+// ==========================================================================
+
+template <class T>
+class Flat_hashnode
+{
+
+  public:
+
+   Flat_hashnode();
+
+   void set_ID(long id);
+   void set_data(T const & d);
+   long get_ID() const;
+   T& get_data();
+   const T& get_data() const;
+   T* get_data_ptr();
+
+   bool empty() const;
+
+  private:
+
+   template <class T1> friend class Flat_hashtable;
+
+   long ID;
+   int probe_distance;	// -1 indicates empty slot
+   T data;
+};
+
+// ==========================================================================
+// Flat_hashtable class
+// ==========================================================================
+
+template <class T>
+class Flat_hashtable
+{
+
+  public:
+
+// Initialization, constructor and destructor functions:
+
+   Flat_hashtable(int c);
+   Flat_hashtable(const Flat_hashtable<T>& h);
+   void purge_all_entries();
+   virtual ~Flat_hashtable();
+   Flat_hashtable<T>& operator= (const Flat_hashtable<T>& h);
+
+   template <class T1>
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const Flat_hashtable<T1>& h);
+
+   std::vector<T>* convert_hashtable_to_vector() const;
+   void display_dereferenced_contents(std::ostream& hashstream) const;
+   void print_probe_distance_histogram() const;
+
+// Set and get member functions:
+
+   unsigned int size() const;
+   unsigned int get_table_capacity() const;
+   bool occupied_slot(unsigned int n) const;
+   Flat_hashnode<T>* get_node_ptr(unsigned int n);
+   const Flat_hashnode<T>* get_node_ptr(unsigned int n) const;
+   void reserve(unsigned int n_keys);
+
+// Key insertion, retrieval and deletion member functions:
+
+   Flat_hashnode<T>* insert_key(long key,T data);
+   Flat_hashnode<T>* insert_key(long key,int location,T data);
+   Flat_hashnode<T>* update_key(long key,T data);
+   Flat_hashnode<T>* retrieve_key(long key);
+   const Flat_hashnode<T>* retrieve_key(long key) const;
+   Flat_hashnode<T>* retrieve_key(long key,int& location);
+   const Flat_hashnode<T>* retrieve_key(long key,int& location) const;
+   Flat_hashnode<T>* increment_key(long key);
+   void delete_key(long key);
+
+// Data manipulation member functions:
+
+   int explicitly_count_entries() const;
+   T max_data_value() const;
+   T min_data_value() const;
+   void shift_data_values(T alpha);
+   void rescale_data_values(T alpha);
+
+  private:
+
+// Table is resized whenever more than 7/8ths of its slots are full:
+
+   static const unsigned int max_load_numerator=7;
+   static const unsigned int max_load_denominator=8;
+
+   unsigned int nkeys_in_table;
+   unsigned int capacity;  // Always a power of two
+   unsigned int mask;      // capacity-1
+   std::vector<Flat_hashnode<T> > nodes;
+
+   void allocate_member_objects(unsigned int n_keys);
+   void initialize_member_objects();
+   void docopy(const Flat_hashtable<T>& h);
+
+   unsigned int compute_location(long key) const;
+   int find_slot(long key) const;
+   Flat_hashnode<T>* insert_new_key(long key,const T& data);
+   void rehash(unsigned int new_capacity);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+template <class T> inline Flat_hashnode<T>::Flat_hashnode()
+{
+   ID=0;
+   probe_distance=-1;
+}
+
+template <class T> inline void Flat_hashnode<T>::set_ID(long id)
+{
+   ID=id;
+}
+
+template <class T> inline void Flat_hashnode<T>::set_data(T const & d)
+{
+   data=d;
+}
+
+template <class T> inline long Flat_hashnode<T>::get_ID() const
+{
+   return ID;
+}
+
+template <class T> inline T& Flat_hashnode<T>::get_data()
+{
+   return data;
+}
+
+template <class T> inline const T& Flat_hashnode<T>::get_data() const
+{
+   return data;
+}
+
+template <class T> inline T* Flat_hashnode<T>::get_data_ptr()
+{
+   return &data;
+}
+
+template <class T> inline bool Flat_hashnode<T>::empty() const
+{
+   return probe_distance < 0;
+}
+
+// ---------------------------------------------------------------------
+template <class T> inline void Flat_hashtable<T>::initialize_member_objects()
+{
+   nkeys_in_table=0;
+}
+
+// ---------------------------------------------------------------------
+// Overload = operator:
+
+template <class T> inline Flat_hashtable<T>& Flat_hashtable<T>::operator=
+(const Flat_hashtable<T>& h)
+{
+   if (this==&h) return *this;
+   docopy(h);
+   return *this;
+}
+
+// ---------------------------------------------------------------------
+template <class T> inline unsigned int Flat_hashtable<T>::size() const
+{
+   return nkeys_in_table;
+}
+
+template <class T> inline unsigned int Flat_hashtable<T>::get_table_capacity()
+   const
+{
+   return capacity;
+}
+
+// ---------------------------------------------------------------------
+// Member functions occupied_slot and get_node_ptr allow callers to
+// loop over every entry within the table:
+
+//   for (unsigned int n=0; n<h.get_table_capacity(); n++)
+//   {
+//      if (!h.occupied_slot(n)) continue;
+//      Flat_hashnode<T>* node_ptr=h.get_node_ptr(n);
+//   }
+
+template <class T> inline bool Flat_hashtable<T>::occupied_slot(
+   unsigned int n) const
+{
+   return !nodes[n].empty();
+}
+
+template <class T> inline Flat_hashnode<T>* Flat_hashtable<T>::get_node_ptr(
+   unsigned int n)
+{
+   return &nodes[n];
+}
+
+template <class T> inline const Flat_hashnode<T>*
+Flat_hashtable<T>::get_node_ptr(unsigned int n) const
+{
+   return &nodes[n];
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_location scrambles the bits of input key
+// via the 64-bit finalizer from MurmurHash3.  Consecutive voxel and
+// pixel keys are thereby spread uniformly across the table.  Keys are
+// 64-bit so that packed lattice coordinates for large grids do not
+// overflow.
+
+template <class T> inline unsigned int Flat_hashtable<T>::compute_location(
+   long key) const
+{
+   unsigned long long h=static_cast<unsigned long long>(key);
+   h ^= h >> 33;
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= h >> 33;
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= h >> 33;
+   return static_cast<unsigned int>(h) & mask;
+}
+
+// ---------------------------------------------------------------------
+// Member function find_slot returns the index of the slot holding
+// input key or -1 if the key does not reside within the table.  Robin
+// Hood ordering guarantees that the search may stop as soon as a slot
+// is reached whose occupant lies closer to its own home slot than the
+// key would.
+
+template <class T> inline int Flat_hashtable<T>::find_slot(long key) const
+{
+   unsigned int location=compute_location(key);
+   for (int dist=0; ; dist++)
+   {
+      const Flat_hashnode<T>& curr_node=nodes[location];
+      if (curr_node.probe_distance < dist) return -1;
+      if (curr_node.ID==key) return location;
+      location=(location+1) & mask;
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function retrieve_key returns a pointer to the node
+// containing key as its independent variable if it exists within the
+// hash table.  Otherwise, this method returns a NULL pointer.  Output
+// location is set to the key's slot index or to -1.
+
+template <class T> inline Flat_hashnode<T>* Flat_hashtable<T>::retrieve_key(
+   long key)
+{
+   int location;
+   return retrieve_key(key,location);
+}
+
+template <class T> inline const Flat_hashnode<T>*
+Flat_hashtable<T>::retrieve_key(long key) const
+{
+   int location;
+   return retrieve_key(key,location);
+}
+
+template <class T> inline Flat_hashnode<T>* Flat_hashtable<T>::retrieve_key(
+   long key,int& location)
+{
+   location=find_slot(key);
+   if (location < 0) return NULL;
+   return &nodes[location];
+}
+
+template <class T> inline const Flat_hashnode<T>*
+Flat_hashtable<T>::retrieve_key(long key,int& location) const
+{
+   location=find_slot(key);
+   if (location < 0) return NULL;
+   return &nodes[location];
+}
+
+// ---------------------------------------------------------------------
+// Member function increment_key assumes that the hashtable's data
+// corresponds to primitive integers, floats or doubles.  If the input
+// key corresponds to an existing node, this method increments its
+// datum value by one.  Otherwise, it creates the node with a unit
+// valued datum.
+
+template <class T> inline Flat_hashnode<T>* Flat_hashtable<T>::increment_key(
+   long key)
+{
+   Flat_hashnode<T>* currnode_ptr=retrieve_key(key);
+   if (currnode_ptr==NULL)
+   {
+      currnode_ptr=insert_new_key(key,1);
+   }
+   else
+   {
+      currnode_ptr->data=currnode_ptr->data+1;
+   }
+   return currnode_ptr;
+}
+
+#include "Flat_hashtable.cc"
+
+#endif  // T_datastructures/Flat_hashtable.h
@@ -0,0 +1,185 @@
+// =========================================================================
+// PACKED_DESCRIPTOR class member function definitions
+// =========================================================================
+// Last modified on 10/18/26
+// =========================================================================
+
+#include <iostream>
+#include "datastructures/descriptor.h"
+#include "datastructures/packed_descriptor.h"
+
+using std::cout;
+using std::endl;
+using std::flush;
+using std::ostream;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor methods:
+
+void packed_descriptor::allocate_member_objects()
+{
+   unsigned int bits_per_block=bits_per_word*words_per_block;
+   unsigned int n_blocks=(n_bits+bits_per_block-1)/bits_per_block;
+   if (n_blocks==0) n_blocks=1;
+   n_words=n_blocks*words_per_block;
+   words_ptr=new vector<unsigned long>(n_words,0);
+}
+
+void packed_descriptor::initialize_member_objects()
+{
+   ID=-1;
+}
+
+// ---------------------------------------------------------------------
+packed_descriptor::packed_descriptor(int n_bits)
+{
+   this->n_bits=n_bits;
+   allocate_member_objects();
+   initialize_member_objects();
+}
+
+// This overloaded constructor takes in a descriptor whose entries are
+// assumed to equal either 0 or 1.  Any nonzero entry is packed as a
+// set bit.
+
+packed_descriptor::packed_descriptor(descriptor* D_ptr)
+{
+   n_bits=D_ptr->get_mdim();
+   allocate_member_objects();
+   initialize_member_objects();
+   pack(D_ptr);
+}
+
+// This overloaded constructor takes in a raw byte array such as a
+// single row of an OpenCV CV_8U binary descriptor matrix.  Bit i is
+// taken from bit i%8 of byte i/8.
+
+packed_descriptor::packed_descriptor(int n_bits,const unsigned char* bytes)
+{
+   this->n_bits=n_bits;
+   allocate_member_objects();
+   initialize_member_objects();
+   pack(bytes);
+}
+
+// ---------------------------------------------------------------------
+// Copy constructor:
+
+packed_descriptor::packed_descriptor(const packed_descriptor& p)
+{
+   n_bits=p.n_bits;
+   allocate_member_objects();
+   initialize_member_objects();
+   docopy(p);
+}
+
+packed_descriptor::~packed_descriptor()
+{
+   delete words_ptr;
+}
+
+// ---------------------------------------------------------------------
+void packed_descriptor::docopy(const packed_descriptor& p)
+{
+   ID=p.ID;
+   n_bits=p.n_bits;
+   n_words=p.n_words;
+   *words_ptr=*(p.words_ptr);
+}
+
+// Overload = operator:
+
+packed_descriptor& packed_descriptor::operator= (const packed_descriptor& p)
+{
+   if (this==&p) return *this;
+   docopy(p);
+   return *this;
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const packed_descriptor& p)
+{
+   outstream << "ID = " << p.get_ID()
+             << " n_bits = " << p.get_n_bits() << endl;
+   for (unsigned int i=0; i<p.get_n_bits(); i++)
+   {
+      outstream << p.get_bit(i);
+   }
+   outstream << endl;
+   return outstream;
+}
+
+// ==========================================================================
+
+void packed_descriptor::clear_bits()
+{
+   for (unsigned int w=0; w<n_words; w++)
+   {
+      (*words_ptr)[w]=0;
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function pack() sets bit d whenever entry d of the input
+// descriptor is nonzero.  Padding bits beyond n_bits always remain
+// zero so that they never contribute to Hamming distances.
+
+void packed_descriptor::pack(descriptor* D_ptr)
+{
+   clear_bits();
+   unsigned int d_dims=D_ptr->get_mdim();
+   if (d_dims > n_bits) d_dims=n_bits;
+   for (unsigned int d=0; d<d_dims; d++)
+   {
+      if (D_ptr->get(d) != 0)
+      {
+         (*words_ptr)[d/bits_per_word] |= 1UL << (d%bits_per_word);
+      }
+   }
+}
+
+void packed_descriptor::pack(const unsigned char* bytes)
+{
+   clear_bits();
+   unsigned int n_bytes=(n_bits+7)/8;
+   for (unsigned int b=0; b<n_bytes; b++)
+   {
+      (*words_ptr)[b/8] |= static_cast<unsigned long>(bytes[b]) << (8*(b%8));
+   }
+
+// Zero out any trailing bits within the final byte:
+
+   unsigned int n_tail_bits=n_bits%bits_per_word;
+   if (n_tail_bits > 0)
+   {
+      (*words_ptr)[n_bits/bits_per_word] &= (1UL << n_tail_bits)-1;
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function unpack() instantiates and returns a dynamically
+// allocated descriptor whose entries equal 0 or 1.
+
+descriptor* packed_descriptor::unpack() const
+{
+   descriptor* D_ptr=new descriptor(n_bits);
+   for (unsigned int d=0; d<n_bits; d++)
+   {
+      D_ptr->put(d,get_bit(d));
+   }
+   return D_ptr;
+}
+
+// ---------------------------------------------------------------------
+unsigned int packed_descriptor::n_set_bits() const
+{
+   unsigned int n_set=0;
+   for (unsigned int w=0; w<n_words; w++)
+   {
+      n_set += __builtin_popcountl((*words_ptr)[w]);
+   }
+   return n_set;
+}
@@ -0,0 +1,111 @@
+// ==========================================================================
+// Header file for PACKED_DESCRIPTOR class which holds binary
+// quantized feature descriptors (e.g. binarized SIFT or FREAK) as
+// contiguous 64-bit words.  Words are padded out to whole 256-bit
+// blocks so that POPCNT Hamming distance loops may be unrolled
+// without any tail handling.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef PACKED_DESCRIPTOR_H
+#define PACKED_DESCRIPTOR_H
+
+#include <iostream>
+#include <vector>
+
+class descriptor;
+
+class packed_descriptor
+{
+
+  public:
+
+   static const unsigned int bits_per_word=64;
+   static const unsigned int words_per_block=4;	// 256-bit blocks
+
+   packed_descriptor(int n_bits);
+   packed_descriptor(descriptor* D_ptr);
+   packed_descriptor(int n_bits,const unsigned char* bytes);
+   packed_descriptor(const packed_descriptor& p);
+   ~packed_descriptor();
+
+   packed_descriptor& operator= (const packed_descriptor& p);
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const packed_descriptor& p);
+
+// Set and get member functions:
+
+   void set_ID(int ID);
+   int get_ID() const;
+   unsigned int get_n_bits() const;
+   unsigned int get_n_words() const;
+   const unsigned long* get_words_ptr() const;
+   bool get_bit(int i) const;
+   void put_bit(int i,bool value);
+
+   void clear_bits();
+   void pack(descriptor* D_ptr);
+   void pack(const unsigned char* bytes);
+   descriptor* unpack() const;
+   unsigned int n_set_bits() const;
+
+  private:
+
+   int ID;
+   unsigned int n_bits,n_words;
+   std::vector<unsigned long>* words_ptr;
+
+   void allocate_member_objects();
+   void initialize_member_objects();
+   void docopy(const packed_descriptor& p);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+inline void packed_descriptor::set_ID(int ID)
+{
+   this->ID=ID;
+}
+
+inline int packed_descriptor::get_ID() const
+{
+   return ID;
+}
+
+inline unsigned int packed_descriptor::get_n_bits() const
+{
+   return n_bits;
+}
+
+inline unsigned int packed_descriptor::get_n_words() const
+{
+   return n_words;
+}
+
+inline const unsigned long* packed_descriptor::get_words_ptr() const
+{
+   return &(words_ptr->front());
+}
+
+inline bool packed_descriptor::get_bit(int i) const
+{
+   return ((*words_ptr)[i/bits_per_word] >> (i%bits_per_word)) & 1UL;
+}
+
+inline void packed_descriptor::put_bit(int i,bool value)
+{
+   unsigned long mask=1UL << (i%bits_per_word);
+   if (value)
+   {
+      (*words_ptr)[i/bits_per_word] |= mask;
+   }
+   else
+   {
+      (*words_ptr)[i/bits_per_word] &= ~mask;
+   }
+}
+
+#endif  // packed_descriptor.h
@@ -1,7 +1,7 @@
 // =========================================================================
 // vector_union_find class member function definitions
 // =========================================================================
-// Last modified on 7/25/12; 7/28/12; 7/31/12
+// Last modified on 7/25/12; 7/28/12; 7/31/12; 10/18/26
 // =========================================================================
 
 #include <iostream>
@@ -176,6 +176,19 @@ void vector_union_find::MakeSet(int node_ID)
    CreateNode(node_ID,node_ID);
 }
 
+// --------------------------------------------------------------------------
+// Member function AppendSet() adds a new singleton set to the end of
+// the nodes vector and returns its ID.  Since no data pointer is
+// registered, it is cheap enough to call once per provisional label
+// within connected component labeling.
+
+int vector_union_find::AppendSet()
+{
+   int node_ID=nodes_vector_ptr->size();
+   nodes_vector_ptr->push_back(NODE(node_ID,0,NULL));
+   return node_ID;
+}
+
 // --------------------------------------------------------------------------
 void vector_union_find::CreateNode(int node_ID,int parent_node_ID)
 {
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for vector_union_find class
 // ==========================================================================
-// Last modified on 7/25/12; 7/28/12; 4/3/14
+// Last modified on 7/25/12; 7/28/12; 4/3/14; 10/18/26
 // ==========================================================================
 
 #ifndef VECTOR_UNIONFIND_H
@@ -55,6 +55,7 @@ class vector_union_find
 
    void initializeNodes(int n);
    void MakeSet(int node_ID);
+   int AppendSet();
    void CreateNode(int node_ID,int parent_node_ID);
    int Find(int node_ID);
    int Link(int node1_ID,int node2_ID);
@@ -1,6 +1,7 @@
 // As of November 2005, this namespace is deprecated and should no
 // longer be used!  The following "Computational Geometry in C" code
-// is definitely buggy and yields wrong results!
+// is definitely buggy and yields wrong results!  Use class
+// delaunay_triangulator instead.
 
 // ==========================================================================
 // 3D convex hull algorithm converted from "Computational Geometry in C"
@@ -0,0 +1,955 @@
+// ==========================================================================
+// Delaunay_Triangulator class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include "delaunay/delaunay_triangulator.h"
+#include "math/mathfuncs.h"
+
+using std::cout;
+using std::deque;
+using std::endl;
+using std::ostream;
+using std::pair;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+
+void delaunay_triangulator::initialize_member_objects()
+{
+   n_sites=0;
+   n_duplicate_sites=0;
+   n_failed_constrained_edges=0;
+   n_insertions=0;
+   last_triangle=0;
+   walk_counter=0;
+}
+
+delaunay_triangulator::delaunay_triangulator()
+{
+   initialize_member_objects();
+}
+
+delaunay_triangulator::delaunay_triangulator(const vector<threevector>& sites)
+{
+   initialize_member_objects();
+   set_sites(sites);
+}
+
+delaunay_triangulator::~delaunay_triangulator()
+{
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const delaunay_triangulator& T)
+{
+   outstream << endl;
+   outstream << "n_sites = " << T.n_sites
+             << " n_duplicate_sites = " << T.n_duplicate_sites << endl;
+   outstream << "n_constrained_edges = " << T.constrained_edges.size()
+             << endl;
+   outstream << "n_triangles = " << T.get_n_triangles() << endl;
+   return outstream;
+}
+
+// =========================================================================
+// Set and get member functions
+// =========================================================================
+
+// Only the XY coordinates of input sites are triangulated.  Their Z
+// values are ignored.
+
+void delaunay_triangulator::set_sites(const vector<threevector>& sites)
+{
+   n_sites=sites.size();
+   xy.resize(2*n_sites);
+   for (unsigned int i=0; i<n_sites; i++)
+   {
+      xy[2*i+0]=sites[i].get(0);
+      xy[2*i+1]=sites[i].get(1);
+   }
+   triangle_vertices.clear();
+   halfedge_twins.clear();
+   constrained_halfedges.clear();
+}
+
+// ---------------------------------------------------------------------
+// Constrained edges joining sites i and j must be added before
+// triangulate() is called.  They should not cross one another.
+
+void delaunay_triangulator::add_constrained_edge(int i,int j)
+{
+   constrained_edges.push_back(pair<int,int>(i,j));
+}
+
+void delaunay_triangulator::clear_constrained_edges()
+{
+   constrained_edges.clear();
+}
+
+// =========================================================================
+// Triangulation member functions
+// =========================================================================
+
+// Member function triangulate() inserts every site into the
+// triangulation and then recovers all constrained edges.  It returns
+// false if fewer than 3 non-collinear sites exist or if any
+// constrained edge could not be recovered.  In the latter case, the
+// triangulation remains valid but omits the failed constraints.
+
+bool delaunay_triangulator::triangulate()
+{
+   triangle_vertices.clear();
+   halfedge_twins.clear();
+   constrained_halfedges.clear();
+   n_duplicate_sites=0;
+   n_failed_constrained_edges=0;
+   duplicate_of.assign(n_sites,-1);
+
+   if (n_sites < 3) return false;
+
+   compute_insertion_order();
+
+   int a,b,c;
+   if (!initialize_mesh(a,b,c))
+   {
+      cout << "Error in delaunay_triangulator::triangulate()!" << endl;
+      cout << "All " << n_sites << " sites are collinear" << endl;
+      return false;
+   }
+
+   for (unsigned int i=0; i<n_sites; i++)
+   {
+      int p=insertion_order[i];
+      if (p==a || p==b || p==c) continue;
+      insert_site(p);
+   }
+
+// Constrained edge endpoints which duplicate other sites are replaced
+// by the sites actually inserted into the mesh:
+
+   for (unsigned int i=0; i<constrained_edges.size(); i++)
+   {
+      int i_site=get_surviving_site(constrained_edges[i].first);
+      int j_site=get_surviving_site(constrained_edges[i].second);
+      if (i_site==j_site && i_site >= 0 && i_site < int(n_sites)) continue;
+      if (!insert_constrained_edge(i_site,j_site))
+      {
+         n_failed_constrained_edges++;
+         cout << "Error in delaunay_triangulator::triangulate()!" << endl;
+         cout << "Could not recover constrained edge between sites "
+              << constrained_edges[i].first << " and "
+              << constrained_edges[i].second << endl;
+      }
+   }
+
+   compact_mesh();
+   return n_failed_constrained_edges==0;
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_triangles() returns the site indices of
+// every triangle's counterclockwise ordered vertices.
+
+vector<Triple<int,int,int> > delaunay_triangulator::compute_triangles() const
+{
+   vector<Triple<int,int,int> > triangles;
+   triangles.reserve(get_n_triangles());
+   for (unsigned int t=0; t<get_n_triangles(); t++)
+   {
+      triangles.push_back(Triple<int,int,int>(
+         triangle_vertices[3*t],triangle_vertices[3*t+1],
+         triangle_vertices[3*t+2]));
+   }
+   return triangles;
+}
+
+// =========================================================================
+// Insertion order member functions
+// =========================================================================
+
+// Member function compute_insertion_order() randomly permutes all
+// sites and then partitions them into rounds whose sizes double.
+// Sites within each round are sorted by their Hilbert curve indices
+// computed on a 2**16 x 2**16 grid spanning the sites' bounding box.
+
+void delaunay_triangulator::compute_insertion_order()
+{
+   insertion_order=mathfunc::random_sequence(n_sites);
+
+   double min_x=xy[0],max_x=xy[0],min_y=xy[1],max_y=xy[1];
+   for (unsigned int i=1; i<n_sites; i++)
+   {
+      min_x=basic_math::min(min_x,xy[2*i]);
+      max_x=basic_math::max(max_x,xy[2*i]);
+      min_y=basic_math::min(min_y,xy[2*i+1]);
+      max_y=basic_math::max(max_y,xy[2*i+1]);
+   }
+
+   const unsigned int n_cells=65536;
+   double scale=basic_math::max(max_x-min_x,max_y-min_y);
+   scale=(scale > 0) ? (n_cells-1)/scale : 0;
+
+   vector<pair<unsigned long long,int> > keyed_sites;
+   unsigned int round_stop=n_sites;
+   while (round_stop > 0)
+   {
+      unsigned int round_start=(round_stop > 64) ? round_stop/2 : 0;
+
+      keyed_sites.clear();
+      for (unsigned int i=round_start; i<round_stop; i++)
+      {
+         int p=insertion_order[i];
+         unsigned int x=(xy[2*p]-min_x)*scale;
+         unsigned int y=(xy[2*p+1]-min_y)*scale;
+         keyed_sites.push_back(pair<unsigned long long,int>(
+            hilbert_index(x,y,n_cells),p));
+      }
+      std::sort(keyed_sites.begin(),keyed_sites.end());
+      for (unsigned int i=round_start; i<round_stop; i++)
+      {
+         insertion_order[i]=keyed_sites[i-round_start].second;
+      }
+      round_stop=round_start;
+   } // round_stop > 0 while loop
+}
+
+// ---------------------------------------------------------------------
+// Member function hilbert_index() returns the distance along the
+// Hilbert curve filling an n_cells x n_cells grid to cell (x,y).
+// n_cells must equal a power of 2.
+
+unsigned long long delaunay_triangulator::hilbert_index(
+   unsigned int x,unsigned int y,unsigned int n_cells)
+{
+   unsigned long long d=0;
+   for (unsigned int s=n_cells/2; s>0; s /= 2)
+   {
+      unsigned int rx=(x & s) > 0;
+      unsigned int ry=(y & s) > 0;
+      d += (unsigned long long) s*s*((3*rx)^ry);
+      if (ry==0)
+      {
+         if (rx==1)
+         {
+            x=s-1-x;
+            y=s-1-y;
+         }
+         std::swap(x,y);
+      }
+   }
+   return d;
+}
+
+// =========================================================================
+// Bowyer-Watson insertion member functions
+// =========================================================================
+
+// Member function initialize_mesh() forms a counterclockwise triangle
+// from the first 3 non-collinear sites in insertion order.  Each of
+// its edges is joined to the vertex at infinity by a ghost triangle.
+
+bool delaunay_triangulator::initialize_mesh(int& a,int& b,int& c)
+{
+   a=insertion_order[0];
+   b=c=-1;
+   for (unsigned int i=1; i<n_sites && b < 0; i++)
+   {
+      int q=insertion_order[i];
+      if (xy[2*q] != xy[2*a] || xy[2*q+1] != xy[2*a+1]) b=q;
+   }
+   if (b < 0) return false;
+
+   double orientation=0;
+   for (unsigned int i=1; i<n_sites && c < 0; i++)
+   {
+      int q=insertion_order[i];
+      orientation=orient2d(site(a),site(b),site(q));
+      if (orientation != 0) c=q;
+   }
+   if (c < 0) return false;
+   if (orientation < 0) std::swap(b,c);
+
+   const int g=ghost_vertex;
+   int vertices[12]={a,b,c, b,a,g, c,b,g, a,c,g};
+   mesh_vertices.assign(vertices,vertices+12);
+   mesh_twins.assign(12,-1);
+   mesh_constrained.assign(12,false);
+   link_twins(0,3);
+   link_twins(1,6);
+   link_twins(2,9);
+   link_twins(4,11);
+   link_twins(7,5);
+   link_twins(10,8);
+
+   vertex_halfedge.assign(n_sites,-1);
+   vertex_halfedge[a]=0;
+   vertex_halfedge[b]=1;
+   vertex_halfedge[c]=2;
+
+   cavity_stamp.assign(4,0);
+   n_insertions=0;
+   last_triangle=0;
+   return true;
+}
+
+void delaunay_triangulator::link_twins(int e,int f)
+{
+   mesh_twins[e]=f;
+   if (f >= 0) mesh_twins[f]=e;
+}
+
+// ---------------------------------------------------------------------
+// Member function locate_site() walks from the most recently created
+// triangle towards site p.  It returns either a real triangle
+// containing p or a ghost triangle whose hull edge p lies beyond.  If
+// p coincides with an existing vertex v, duplicate_of[p] is set to v
+// and -1 is returned.
+
+int delaunay_triangulator::locate_site(int p)
+{
+   int t=last_triangle;
+   while (true)
+   {
+      if (ghost_triangle(t)) return t;
+
+// Start edge tests at a varying edge so that the walk cannot cycle:
+
+      unsigned int r=(walk_counter++)%3;
+      bool moved_flag=false;
+      for (unsigned int i=0; i<3 && !moved_flag; i++)
+      {
+         int e=3*t+(r+i)%3;
+         int u=mesh_vertices[e];
+         int v=mesh_vertices[next_halfedge(e)];
+         if (orient2d(site(u),site(v),site(p)) < 0)
+         {
+            t=mesh_twins[e]/3;
+            moved_flag=true;
+         }
+      }
+      if (moved_flag) continue;
+
+      for (unsigned int i=0; i<3; i++)
+      {
+         int v=mesh_vertices[3*t+i];
+         if (xy[2*v]==xy[2*p] && xy[2*v+1]==xy[2*p+1])
+         {
+            duplicate_of[p]=v;
+            return -1;
+         }
+      }
+      return t;
+   }
+}
+
+// ---------------------------------------------------------------------
+// Boolean member function in_conflict() returns true if site p lies
+// strictly inside the circumcircle of triangle t.  The circumcircle of
+// a ghost triangle is taken to be the open half-plane beyond its hull
+// edge together with the edge's open segment.
+
+bool delaunay_triangulator::in_conflict(int t,int p) const
+{
+   const int* v=&mesh_vertices[3*t];
+   if (v[0] != ghost_vertex && v[1] != ghost_vertex && v[2] != ghost_vertex)
+   {
+      return incircle(site(v[0]),site(v[1]),site(v[2]),site(p)) > 0;
+   }
+
+   int k=(v[0]==ghost_vertex) ? 0 : ((v[1]==ghost_vertex) ? 1 : 2);
+   const double* u_site=site(v[(k+1)%3]);
+   const double* v_site=site(v[(k+2)%3]);
+   const double* p_site=site(p);
+
+   double orientation=orient2d(u_site,v_site,p_site);
+   if (orientation > 0) return true;
+   if (orientation < 0) return false;
+
+   double dot_u=(p_site[0]-u_site[0])*(v_site[0]-u_site[0])+
+      (p_site[1]-u_site[1])*(v_site[1]-u_site[1]);
+   double dot_v=(p_site[0]-v_site[0])*(u_site[0]-v_site[0])+
+      (p_site[1]-v_site[1])*(u_site[1]-v_site[1]);
+   return dot_u > 0 && dot_v > 0;
+}
+
+// ---------------------------------------------------------------------
+// Member function insert_site() gathers all triangles in conflict with
+// site p into a cavity.  Each edge on the cavity's boundary is then
+// joined to p.  Slots of cavity triangles are reused for the new
+// triangles, and the 2 extra ones are appended.
+
+bool delaunay_triangulator::insert_site(int p)
+{
+   int t_start=locate_site(p);
+   if (t_start < 0)
+   {
+      n_duplicate_sites++;
+      return false;
+   }
+
+   n_insertions++;
+   cavity_triangles.clear();
+   cavity_stack.clear();
+   cavity_stamp[t_start]=n_insertions;
+   cavity_stack.push_back(t_start);
+   while (cavity_stack.size() > 0)
+   {
+      int t=cavity_stack.back();
+      cavity_stack.pop_back();
+      cavity_triangles.push_back(t);
+      for (unsigned int i=0; i<3; i++)
+      {
+         int t_neighbor=mesh_twins[3*t+i]/3;
+         if (cavity_stamp[t_neighbor]==n_insertions) continue;
+         if (!in_conflict(t_neighbor,p)) continue;
+         cavity_stamp[t_neighbor]=n_insertions;
+         cavity_stack.push_back(t_neighbor);
+      }
+   } // cavity_stack while loop
+
+// Record cavity boundary edges before their slots are overwritten:
+
+   boundary_start.clear();
+   boundary_stop.clear();
+   boundary_twin.clear();
+   for (unsigned int c=0; c<cavity_triangles.size(); c++)
+   {
+      int t=cavity_triangles[c];
+      for (unsigned int i=0; i<3; i++)
+      {
+         int e=3*t+i;
+         int f=mesh_twins[e];
+         if (cavity_stamp[f/3]==n_insertions) continue;
+         boundary_start.push_back(mesh_vertices[e]);
+         boundary_stop.push_back(mesh_vertices[next_halfedge(e)]);
+         boundary_twin.push_back(f);
+      }
+   }
+
+   unsigned int n_new_triangles=boundary_start.size();
+   while (cavity_triangles.size() < n_new_triangles)
+   {
+      cavity_triangles.push_back(mesh_vertices.size()/3);
+      mesh_vertices.resize(mesh_vertices.size()+3);
+      mesh_twins.resize(mesh_twins.size()+3);
+      mesh_constrained.resize(mesh_constrained.size()+3,false);
+      cavity_stamp.push_back(0);
+   }
+
+// New triangle i contains boundary edge u->v along with edges v->p
+// and p->u:
+
+   for (unsigned int i=0; i<n_new_triangles; i++)
+   {
+      int e=3*cavity_triangles[i];
+      mesh_vertices[e]=boundary_start[i];
+      mesh_vertices[e+1]=boundary_stop[i];
+      mesh_vertices[e+2]=p;
+      mesh_constrained[e]=mesh_constrained[boundary_twin[i]];
+      mesh_constrained[e+1]=mesh_constrained[e+2]=false;
+      link_twins(e,boundary_twin[i]);
+      cavity_stamp[cavity_triangles[i]]=0;
+   }
+
+   for (unsigned int i=0; i<n_new_triangles; i++)
+   {
+      int e=3*cavity_triangles[i];
+      for (unsigned int j=0; j<n_new_triangles; j++)
+      {
+         if (boundary_start[j] != boundary_stop[i]) continue;
+         link_twins(e+1,3*cavity_triangles[j]+2);
+         break;
+      }
+      if (boundary_start[i] != ghost_vertex)
+         vertex_halfedge[boundary_start[i]]=e;
+      if (boundary_start[i] != ghost_vertex &&
+          boundary_stop[i] != ghost_vertex) last_triangle=cavity_triangles[i];
+   }
+   vertex_halfedge[p]=3*cavity_triangles[0]+2;
+   return true;
+}
+
+// =========================================================================
+// Constrained edge member functions
+// =========================================================================
+
+// Member function find_halfedge() rotates about vertex u and returns
+// the halfedge running from u to v or -1 if none exists.
+
+int delaunay_triangulator::find_halfedge(int u,int v) const
+{
+   int e_start=vertex_halfedge[u];
+   if (e_start < 0) return -1;
+
+   int e=e_start;
+   do
+   {
+      if (mesh_vertices[next_halfedge(e)]==v) return e;
+      e=mesh_twins[prev_halfedge(e)];
+   }
+   while (e != e_start);
+   return -1;
+}
+
+// ---------------------------------------------------------------------
+// Member function flip_edge() replaces the diagonal shared by
+// counterclockwise triangles (a,b,c) and (b,a,d) with the diagonal
+// joining c and d.  It returns the new halfedge running from d to c.
+
+int delaunay_triangulator::flip_edge(int e)
+{
+   int f=mesh_twins[e];
+   int t=e/3,t_twin=f/3;
+   int e1=next_halfedge(e),e2=prev_halfedge(e);
+   int f1=next_halfedge(f),f2=prev_halfedge(f);
+
+   int a=mesh_vertices[e],b=mesh_vertices[e1];
+   int c=mesh_vertices[e2],d=mesh_vertices[f2];
+   int twin_e1=mesh_twins[e1],twin_e2=mesh_twins[e2];
+   int twin_f1=mesh_twins[f1],twin_f2=mesh_twins[f2];
+   bool constrained_e1=mesh_constrained[e1],constrained_e2=mesh_constrained[e2];
+   bool constrained_f1=mesh_constrained[f1],constrained_f2=mesh_constrained[f2];
+
+// Triangle t becomes (c,a,d) while triangle t_twin becomes (d,b,c):
+
+   int g=3*t,h=3*t_twin;
+   mesh_vertices[g]=c;
+   mesh_vertices[g+1]=a;
+   mesh_vertices[g+2]=d;
+   mesh_vertices[h]=d;
+   mesh_vertices[h+1]=b;
+   mesh_vertices[h+2]=c;
+
+   link_twins(g,twin_e2);
+   link_twins(g+1,twin_f1);
+   link_twins(g+2,h+2);
+   link_twins(h,twin_f2);
+   link_twins(h+1,twin_e1);
+
+   mesh_constrained[g]=constrained_e2;
+   mesh_constrained[g+1]=constrained_f1;
+   mesh_constrained[g+2]=mesh_constrained[h+2]=false;
+   mesh_constrained[h]=constrained_f2;
+   mesh_constrained[h+1]=constrained_e1;
+
+   vertex_halfedge[a]=g+1;
+   vertex_halfedge[b]=h+1;
+   vertex_halfedge[c]=g;
+   vertex_halfedge[d]=h;
+   return g+2;
+}
+
+// ---------------------------------------------------------------------
+// Boolean member function crosses_segment() returns true if the open
+// segments joining sites a,b and sites u,v properly intersect.
+
+bool delaunay_triangulator::crosses_segment(int a,int b,int u,int v) const
+{
+   if (u==a || u==b || v==a || v==b) return false;
+   double ou=orient2d(site(a),site(b),site(u));
+   double ov=orient2d(site(a),site(b),site(v));
+   if (!((ou > 0 && ov < 0) || (ou < 0 && ov > 0))) return false;
+   double oa=orient2d(site(u),site(v),site(a));
+   double ob=orient2d(site(u),site(v),site(b));
+   return (oa > 0 && ob < 0) || (oa < 0 && ob > 0);
+}
+
+// ---------------------------------------------------------------------
+// Member function insert_constrained_edge() first collects all edges
+// which cross the segment joining sites a and b.  Crossing edges whose
+// adjacent triangles form strictly convex quadrilaterals are then
+// flipped until none remain.  If the segment passes through some other
+// vertex, it is split there.
+
+bool delaunay_triangulator::insert_constrained_edge(int a,int b)
+{
+   if (a < 0 || b < 0 || a >= int(n_sites) || b >= int(n_sites) || a==b)
+      return false;
+   if (vertex_halfedge[a] < 0 || vertex_halfedge[b] < 0) return false;
+
+   int e=find_halfedge(a,b);
+   if (e >= 0)
+   {
+      mesh_constrained[e]=mesh_constrained[mesh_twins[e]]=true;
+      return true;
+   }
+
+// Rotate about a to find the real triangle (a,x,y) whose interior the
+// segment from a towards b enters.  A neighbor x lying on the segment
+// may only be reached through a ghost triangle when a and x are joined
+// by a hull edge.  So the collinearity test is applied to every real
+// neighbor, while the crossing test requires a real triangle:
+
+   const double* a_site=site(a);
+   const double* b_site=site(b);
+   int e_start=vertex_halfedge[a];
+   int h=-1;
+   e=e_start;
+   do
+   {
+      int x=mesh_vertices[next_halfedge(e)];
+      int y=mesh_vertices[prev_halfedge(e)];
+      if (x != ghost_vertex)
+      {
+         double ox=orient2d(a_site,b_site,site(x));
+         if (ox==0 && (site(x)[0]-a_site[0])*(b_site[0]-a_site[0])+
+             (site(x)[1]-a_site[1])*(b_site[1]-a_site[1]) > 0)
+         {
+            return insert_constrained_edge(a,x) &&
+               insert_constrained_edge(x,b);
+         }
+         if (y != ghost_vertex && ox < 0 &&
+             orient2d(a_site,b_site,site(y)) > 0)
+         {
+            h=next_halfedge(e);
+            break;
+         }
+      }
+      e=mesh_twins[prev_halfedge(e)];
+   }
+   while (e != e_start);
+   if (h < 0) return false;
+
+// March across triangles intersected by the segment:
+
+   deque<pair<int,int> > crossing_edges;
+   int b_stop=b;
+   while (true)
+   {
+      if (mesh_constrained[h]) return false;
+      int x=mesh_vertices[h];
+      crossing_edges.push_back(pair<int,int>(x,mesh_vertices[next_halfedge(h)]));
+
+      int h_twin=mesh_twins[h];
+      int z=mesh_vertices[prev_halfedge(h_twin)];
+      if (z==b || z==ghost_vertex) break;
+
+      double oz=orient2d(a_site,b_site,site(z));
+      if (oz==0)
+      {
+         b_stop=z;
+         break;
+      }
+
+      double ox=orient2d(a_site,b_site,site(x));
+      h=((oz > 0)==(ox > 0)) ? prev_halfedge(h_twin) : next_halfedge(h_twin);
+   } // while loop over crossing edges
+
+// Flip crossing edges until none remain:
+
+   vector<pair<int,int> > new_edges;
+   unsigned int n_attempts=0;
+   unsigned int max_attempts=100*(crossing_edges.size()+1)*
+      (crossing_edges.size()+1);
+   while (crossing_edges.size() > 0)
+   {
+      if (n_attempts++ > max_attempts) return false;
+
+      pair<int,int> curr_edge=crossing_edges.front();
+      crossing_edges.pop_front();
+      int u=curr_edge.first,v=curr_edge.second;
+      e=find_halfedge(u,v);
+      if (e < 0) return false;
+
+      int c=mesh_vertices[prev_halfedge(e)];
+      int d=mesh_vertices[prev_halfedge(mesh_twins[e])];
+      double oc=orient2d(site(c),site(d),site(u));
+      double od=orient2d(site(c),site(d),site(v));
+      if (!((oc > 0 && od < 0) || (oc < 0 && od > 0)))
+      {
+         crossing_edges.push_back(curr_edge);
+         continue;
+      }
+
+      flip_edge(e);
+      if (crosses_segment(a,b_stop,c,d))
+      {
+         crossing_edges.push_back(pair<int,int>(c,d));
+      }
+      else
+      {
+         new_edges.push_back(pair<int,int>(c,d));
+      }
+   } // crossing_edges while loop
+
+   e=find_halfedge(a,b_stop);
+   if (e < 0) return false;
+   mesh_constrained[e]=mesh_constrained[mesh_twins[e]]=true;
+
+   restore_delaunay_edges(a,b_stop,new_edges);
+
+   if (b_stop != b) return insert_constrained_edge(b_stop,b);
+   return true;
+}
+
+// ---------------------------------------------------------------------
+// Member function restore_delaunay_edges() repeatedly flips newly
+// created unconstrained edges which fail the incircle test.
+
+void delaunay_triangulator::restore_delaunay_edges(
+   int a,int b,vector<pair<int,int> >& new_edges)
+{
+   bool swapped_flag=true;
+   while (swapped_flag)
+   {
+      swapped_flag=false;
+      for (unsigned int i=0; i<new_edges.size(); i++)
+      {
+         int u=new_edges[i].first,v=new_edges[i].second;
+         if ((u==a && v==b) || (u==b && v==a)) continue;
+
+         int e=find_halfedge(u,v);
+         if (e < 0 || mesh_constrained[e]) continue;
+         int f=mesh_twins[e];
+         if (ghost_triangle(e/3) || ghost_triangle(f/3)) continue;
+
+         int c=mesh_vertices[prev_halfedge(e)];
+         int d=mesh_vertices[prev_halfedge(f)];
+         if (incircle(site(u),site(v),site(c),site(d)) <= 0) continue;
+
+         flip_edge(e);
+         new_edges[i]=pair<int,int>(c,d);
+         swapped_flag=true;
+      } // loop over index i labeling new edges
+   } // swapped_flag while loop
+}
+
+// ---------------------------------------------------------------------
+// Member function compact_mesh() copies all real triangles into the
+// output half-edge arrays and releases the working mesh.
+
+void delaunay_triangulator::compact_mesh()
+{
+   unsigned int n_mesh_triangles=mesh_vertices.size()/3;
+   vector<int> new_index(n_mesh_triangles,-1);
+   unsigned int n_triangles=0;
+   for (unsigned int t=0; t<n_mesh_triangles; t++)
+   {
+      if (!ghost_triangle(t)) new_index[t]=n_triangles++;
+   }
+
+   triangle_vertices.resize(3*n_triangles);
+   halfedge_twins.resize(3*n_triangles);
+   constrained_halfedges.resize(3*n_triangles);
+   for (unsigned int t=0; t<n_mesh_triangles; t++)
+   {
+      if (new_index[t] < 0) continue;
+      for (unsigned int i=0; i<3; i++)
+      {
+         int e=3*t+i;
+         int new_e=3*new_index[t]+i;
+         int f=mesh_twins[e];
+         triangle_vertices[new_e]=mesh_vertices[e];
+         halfedge_twins[new_e]=(new_index[f/3] < 0) ? -1 :
+            3*new_index[f/3]+f%3;
+         constrained_halfedges[new_e]=mesh_constrained[e];
+      }
+   }
+
+   vector<int>().swap(mesh_vertices);
+   vector<int>().swap(mesh_twins);
+   vector<bool>().swap(mesh_constrained);
+   vector<int>().swap(cavity_stamp);
+}
+
+// =========================================================================
+// Robust geometric predicates
+// =========================================================================
+
+// Following Shewchuk's "Adaptive Precision Floating-Point Arithmetic
+// and Fast Robust Geometric Predicates", floating-point expansions
+// represent numbers exactly as sums of non-overlapping doubles sorted
+// by increasing magnitude.  The sign of an expansion equals that of its
+// largest component.
+
+namespace
+{
+   const double epsilon=1.1102230246251565e-16;	// 2**-53
+   const double ccwerrboundA=(3.0+16.0*epsilon)*epsilon;
+   const double iccerrboundA=(10.0+96.0*epsilon)*epsilon;
+
+   typedef vector<double> expansion;
+
+   inline void two_sum(double a,double b,double& x,double& y)
+   {
+      x=a+b;
+      double b_virtual=x-a;
+      double a_virtual=x-b_virtual;
+      y=(a-a_virtual)+(b-b_virtual);
+   }
+
+   inline void two_product(double a,double b,double& x,double& y)
+   {
+      x=a*b;
+      y=std::fma(a,b,-x);
+   }
+
+   expansion grow_expansion(const expansion& e,double b)
+   {
+      expansion h;
+      double q=b;
+      for (unsigned int i=0; i<e.size(); i++)
+      {
+         double sum,error;
+         two_sum(q,e[i],sum,error);
+         q=sum;
+         if (error != 0) h.push_back(error);
+      }
+      if (q != 0 || h.size()==0) h.push_back(q);
+      return h;
+   }
+
+   expansion expansion_sum(const expansion& e,const expansion& f)
+   {
+      expansion h=e;
+      for (unsigned int i=0; i<f.size(); i++)
+      {
+         h=grow_expansion(h,f[i]);
+      }
+      return h;
+   }
+
+   expansion scale_expansion(const expansion& e,double b)
+   {
+      expansion h;
+      for (unsigned int i=0; i<e.size(); i++)
+      {
+         double product,error;
+         two_product(e[i],b,product,error);
+         h=grow_expansion(h,error);
+         h=grow_expansion(h,product);
+      }
+      return h;
+   }
+
+   expansion expansion_product(const expansion& e,const expansion& f)
+   {
+      expansion h(1,0.0);
+      for (unsigned int i=0; i<f.size(); i++)
+      {
+         h=expansion_sum(h,scale_expansion(e,f[i]));
+      }
+      return h;
+   }
+
+   expansion difference(double a,double b)
+   {
+      double x,y;
+      two_sum(a,-b,x,y);
+      expansion h;
+      if (y != 0) h.push_back(y);
+      h.push_back(x);
+      return h;
+   }
+
+   expansion negate(const expansion& e)
+   {
+      expansion h(e);
+      for (unsigned int i=0; i<h.size(); i++)
+      {
+         h[i]=-h[i];
+      }
+      return h;
+   }
+}
+
+// ---------------------------------------------------------------------
+double delaunay_triangulator::orient2d(
+   const double* a,const double* b,const double* c)
+{
+   double detleft=(a[0]-c[0])*(b[1]-c[1]);
+   double detright=(a[1]-c[1])*(b[0]-c[0]);
+   double det=detleft-detright;
+
+   double detsum;
+   if (detleft > 0)
+   {
+      if (detright <= 0) return det;
+      detsum=detleft+detright;
+   }
+   else if (detleft < 0)
+   {
+      if (detright >= 0) return det;
+      detsum=-detleft-detright;
+   }
+   else
+   {
+      return det;
+   }
+
+   double errbound=ccwerrboundA*detsum;
+   if (det >= errbound || -det >= errbound) return det;
+   return orient2d_exact(a,b,c);
+}
+
+// ---------------------------------------------------------------------
+double delaunay_triangulator::incircle(
+   const double* a,const double* b,const double* c,const double* d)
+{
+   double adx=a[0]-d[0],ady=a[1]-d[1];
+   double bdx=b[0]-d[0],bdy=b[1]-d[1];
+   double cdx=c[0]-d[0],cdy=c[1]-d[1];
+
+   double bdxcdy=bdx*cdy,cdxbdy=cdx*bdy;
+   double alift=adx*adx+ady*ady;
+   double cdxady=cdx*ady,adxcdy=adx*cdy;
+   double blift=bdx*bdx+bdy*bdy;
+   double adxbdy=adx*bdy,bdxady=bdx*ady;
+   double clift=cdx*cdx+cdy*cdy;
+
+   double det=alift*(bdxcdy-cdxbdy)+blift*(cdxady-adxcdy)+
+      clift*(adxbdy-bdxady);
+   double permanent=(fabs(bdxcdy)+fabs(cdxbdy))*alift+
+      (fabs(cdxady)+fabs(adxcdy))*blift+
+      (fabs(adxbdy)+fabs(bdxady))*clift;
+   double errbound=iccerrboundA*permanent;
+   if (det > errbound || -det > errbound) return det;
+   return incircle_exact(a,b,c,d);
+}
+
+// ---------------------------------------------------------------------
+double delaunay_triangulator::orient2d_exact(
+   const double* a,const double* b,const double* c)
+{
+   expansion acx=difference(a[0],c[0]),acy=difference(a[1],c[1]);
+   expansion bcx=difference(b[0],c[0]),bcy=difference(b[1],c[1]);
+   expansion det=expansion_sum(
+      expansion_product(acx,bcy),negate(expansion_product(acy,bcx)));
+   return det.back();
+}
+
+// ---------------------------------------------------------------------
+double delaunay_triangulator::incircle_exact(
+   const double* a,const double* b,const double* c,const double* d)
+{
+   expansion adx=difference(a[0],d[0]),ady=difference(a[1],d[1]);
+   expansion bdx=difference(b[0],d[0]),bdy=difference(b[1],d[1]);
+   expansion cdx=difference(c[0],d[0]),cdy=difference(c[1],d[1]);
+
+   expansion alift=expansion_sum(
+      expansion_product(adx,adx),expansion_product(ady,ady));
+   expansion blift=expansion_sum(
+      expansion_product(bdx,bdx),expansion_product(bdy,bdy));
+   expansion clift=expansion_sum(
+      expansion_product(cdx,cdx),expansion_product(cdy,cdy));
+
+   expansion bc=expansion_sum(
+      expansion_product(bdx,cdy),negate(expansion_product(cdx,bdy)));
+   expansion ca=expansion_sum(
+      expansion_product(cdx,ady),negate(expansion_product(adx,cdy)));
+   expansion ab=expansion_sum(
+      expansion_product(adx,bdy),negate(expansion_product(bdx,ady)));
+
+   expansion det=expansion_sum(
+      expansion_sum(expansion_product(alift,bc),expansion_product(blift,ca)),
+      expansion_product(clift,ab));
+   return det.back();
+}
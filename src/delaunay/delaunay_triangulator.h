@@ -0,0 +1,221 @@
+// ==========================================================================
+// Header file for DELAUNAY_TRIANGULATOR class which computes 2D
+// Delaunay triangulations of the XY coordinates of input sites.
+// Sites are inserted in biased randomized insertion order (BRIO) with
+// each round sorted along a Hilbert curve.  So consecutive sites lie
+// close together, and walking point location from the most recently
+// created triangle takes O(1) expected steps.  Each site is inserted
+// via the Bowyer-Watson algorithm: triangles whose circumcircles
+// contain the site are removed, and the resulting star-shaped cavity
+// is retriangulated about the site.  Ghost triangles which join every
+// convex hull edge to a vertex at infinity eliminate any need for a
+// bounding super triangle.
+
+// Orientation and incircle predicates are evaluated in floating point
+// with Shewchuk's error bounds.  Only when the sign of a result is
+// uncertain is it recomputed exactly via floating-point expansions.
+
+// Constrained edges are recovered after all sites have been inserted
+// by flipping the edges which they cross (Sloan 1993).  Delaunay
+// optimality is then restored for unconstrained edges.
+
+// Triangulations are returned as flat half-edge arrays.  Triangle t
+// consists of halfedges 3t, 3t+1 and 3t+2 which run counterclockwise.
+// Halfedge e starts at vertex triangle_vertices[e] and ends at the
+// start of halfedge next_halfedge(e).  Its oppositely directed twin is
+// halfedge_twins[e] or -1 if e lies on the convex hull.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef DELAUNAY_TRIANGULATOR_H
+#define DELAUNAY_TRIANGULATOR_H
+
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "datastructures/Triple.h"
+#include "math/threevector.h"
+
+class delaunay_triangulator
+{
+
+  public:
+
+   delaunay_triangulator();
+   delaunay_triangulator(const std::vector<threevector>& sites);
+   ~delaunay_triangulator();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const delaunay_triangulator& T);
+
+// Set and get member functions:
+
+   void set_sites(const std::vector<threevector>& sites);
+   void add_constrained_edge(int i,int j);
+   void clear_constrained_edges();
+
+   unsigned int get_n_sites() const;
+   unsigned int get_n_triangles() const;
+   unsigned int get_n_duplicate_sites() const;
+   unsigned int get_n_failed_constrained_edges() const;
+   int get_surviving_site(int i) const;
+   const std::vector<int>& get_triangle_vertices() const;
+   const std::vector<int>& get_halfedge_twins() const;
+   const std::vector<bool>& get_constrained_halfedges() const;
+
+   static int next_halfedge(int e);
+   static int prev_halfedge(int e);
+
+// Triangulation member functions:
+
+   bool triangulate();
+   std::vector<Triple<int,int,int> > compute_triangles() const;
+
+// Robust geometric predicates.  orient2d() is positive if a, b and c
+// run counterclockwise.  incircle() is positive if d lies inside the
+// circle through counterclockwise points a, b and c:
+
+   static double orient2d(const double* a,const double* b,const double* c);
+   static double incircle(
+      const double* a,const double* b,const double* c,const double* d);
+
+  private:
+
+   static const int ghost_vertex=-1;
+
+   unsigned int n_sites,n_duplicate_sites,n_failed_constrained_edges;
+   std::vector<double> xy;
+   std::vector<int> duplicate_of;
+   std::vector<int> insertion_order;
+   std::vector<std::pair<int,int> > constrained_edges;
+
+// Working mesh including ghost triangles:
+
+   std::vector<int> mesh_vertices,mesh_twins;
+   std::vector<bool> mesh_constrained;
+   std::vector<int> vertex_halfedge;
+   std::vector<int> cavity_stamp,cavity_triangles,cavity_stack;
+   std::vector<int> boundary_start,boundary_stop,boundary_twin;
+   int n_insertions,last_triangle;
+   unsigned int walk_counter;
+
+// Output triangulation without ghost triangles:
+
+   std::vector<int> triangle_vertices,halfedge_twins;
+   std::vector<bool> constrained_halfedges;
+
+   void initialize_member_objects();
+
+   const double* site(int v) const;
+   bool ghost_triangle(int t) const;
+
+   void compute_insertion_order();
+   static unsigned long long hilbert_index(
+      unsigned int x,unsigned int y,unsigned int n_cells);
+
+   bool initialize_mesh(int& a,int& b,int& c);
+   void link_twins(int e,int f);
+   int locate_site(int p);
+   bool in_conflict(int t,int p) const;
+   bool insert_site(int p);
+
+   int find_halfedge(int u,int v) const;
+   int flip_edge(int e);
+   bool crosses_segment(int a,int b,int u,int v) const;
+   bool insert_constrained_edge(int a,int b);
+   void restore_delaunay_edges(
+      int a,int b,std::vector<std::pair<int,int> >& new_edges);
+   void compact_mesh();
+
+   static double orient2d_exact(
+      const double* a,const double* b,const double* c);
+   static double incircle_exact(
+      const double* a,const double* b,const double* c,const double* d);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+// Set and get member functions:
+
+inline unsigned int delaunay_triangulator::get_n_sites() const
+{
+   return n_sites;
+}
+
+inline unsigned int delaunay_triangulator::get_n_triangles() const
+{
+   return triangle_vertices.size()/3;
+}
+
+// Sites whose XY coordinates coincide with those of an earlier site
+// are not inserted into the triangulation:
+
+inline unsigned int delaunay_triangulator::get_n_duplicate_sites() const
+{
+   return n_duplicate_sites;
+}
+
+// Constrained edges which could not be recovered are left out of the
+// triangulation:
+
+inline unsigned int delaunay_triangulator::get_n_failed_constrained_edges()
+   const
+{
+   return n_failed_constrained_edges;
+}
+
+// Member function get_surviving_site() returns the inserted site which
+// coincides with site i.  Unless i is a duplicate, it returns i:
+
+inline int delaunay_triangulator::get_surviving_site(int i) const
+{
+   if (i < 0 || i >= int(duplicate_of.size()) || duplicate_of[i] < 0)
+      return i;
+   return duplicate_of[i];
+}
+
+inline const std::vector<int>& delaunay_triangulator::get_triangle_vertices()
+   const
+{
+   return triangle_vertices;
+}
+
+inline const std::vector<int>& delaunay_triangulator::get_halfedge_twins()
+   const
+{
+   return halfedge_twins;
+}
+
+inline const std::vector<bool>&
+   delaunay_triangulator::get_constrained_halfedges() const
+{
+   return constrained_halfedges;
+}
+
+inline int delaunay_triangulator::next_halfedge(int e)
+{
+   return (e%3==2) ? e-2 : e+1;
+}
+
+inline int delaunay_triangulator::prev_halfedge(int e)
+{
+   return (e%3==0) ? e+2 : e-1;
+}
+
+// Private inlined methods:
+
+inline const double* delaunay_triangulator::site(int v) const
+{
+   return &xy[2*v];
+}
+
+inline bool delaunay_triangulator::ghost_triangle(int t) const
+{
+   return mesh_vertices[3*t]==ghost_vertex ||
+      mesh_vertices[3*t+1]==ghost_vertex ||
+      mesh_vertices[3*t+2]==ghost_vertex;
+}
+
+#endif  // delaunay_triangulator.h
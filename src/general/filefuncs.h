@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for some useful file manipulation functions
 // ==========================================================================
-// Last updated on 12/27/13; 11/2/15; 3/3/16; 3/6/16
+// Last updated on 12/27/13; 11/2/15; 3/3/16; 3/6/16; 10/18/26
 // ==========================================================================
 
 #ifndef FILEFUNCS_H
@@ -18,6 +18,9 @@
 namespace filefunc
 {
 
+// Shared buffer filled by ReadInfile().  It is not reentrant.  Large
+// numeric files should instead be parsed via numeric_text_reader:
+
    extern std::vector<std::string> text_line;
 
 // File opening/closing methods:
@@ -0,0 +1,540 @@
+// ==========================================================================
+// NUMERIC_TEXT_READER class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "general/numeric_text_reader.h"
+#include "math/constants.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::ostream;
+using std::size_t;
+using std::string;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void numeric_text_reader::initialize_member_objects()
+{
+   strip_comments_flag=true;
+   n_threads=0;
+   min_chunk_size=4*1048576;
+   missing_value=NEGATIVEINFINITY;
+   fd=-1;
+   n_bytes=0;
+   mapped_ptr=NULL;
+   text_ptr=NULL;
+   row_offsets.assign(1,0);
+}
+
+numeric_text_reader::numeric_text_reader()
+{
+   initialize_member_objects();
+}
+
+// This overloaded constructor immediately parses the input file with
+// default settings:
+
+numeric_text_reader::numeric_text_reader(string filename)
+{
+   initialize_member_objects();
+   read(filename);
+}
+
+numeric_text_reader::~numeric_text_reader()
+{
+   close();
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const numeric_text_reader& R)
+{
+   outstream << endl;
+   outstream << "filename = " << R.get_filename()
+             << " n_bytes = " << R.get_n_bytes()
+             << " n_rows = " << R.get_n_rows()
+             << " n_values = " << R.get_values().size()
+             << endl;
+   return outstream;
+}
+
+// ---------------------------------------------------------------------
+// Member function get_n_threads() returns the number of OpenMP
+// threads used to parse chunks.  Non-positive n_threads defaults to
+// all available cores.
+
+int numeric_text_reader::get_n_threads() const
+{
+   int curr_n_threads=n_threads;
+#ifdef _OPENMP
+   if (curr_n_threads <= 0) curr_n_threads=omp_get_max_threads();
+#else
+   curr_n_threads=1;
+#endif
+   return curr_n_threads;
+}
+
+// ==========================================================================
+// File parsing member functions
+// ==========================================================================
+
+// Member function read() maps the input file and parses all of its
+// rows.  Any previously read file is first closed.  Chunk boundaries
+// are advanced to the character following the next newline so that
+// no line straddles two chunks.
+
+bool numeric_text_reader::read(string filename)
+{
+   close();
+   this->filename=filename;
+   if (!map_file()) return false;
+
+   int n_cores=get_n_threads();
+   size_t n_chunks=1;
+   if (n_cores > 1 && n_bytes >= 2*min_chunk_size)
+   {
+      n_chunks=n_bytes/min_chunk_size;
+      if (n_chunks > size_t(4*n_cores)) n_chunks=4*n_cores;
+   }
+
+   vector<size_t> boundaries(n_chunks+1,n_bytes);
+   boundaries[0]=0;
+   for (size_t k=1; k<n_chunks; k++)
+   {
+      size_t b=k*(n_bytes/n_chunks);
+      if (b < boundaries[k-1]) b=boundaries[k-1];
+      const void* newline_ptr=memchr(text_ptr+b,'\n',n_bytes-b);
+      boundaries[k]=(newline_ptr==NULL) ? n_bytes :
+         static_cast<const char*>(newline_ptr)-text_ptr+1;
+   }
+
+   vector<Chunk> chunks(n_chunks);
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(n_cores)
+   for (int k=0; k<int(n_chunks); k++)
+   {
+      parse_chunk(boundaries[k],boundaries[k+1],chunks[k]);
+   }
+
+// Concatenate chunk results in file order:
+
+   size_t n_rows=0;
+   size_t n_values=0;
+   for (size_t k=0; k<n_chunks; k++)
+   {
+      n_rows += chunks[k].line_begin.size();
+      n_values += chunks[k].values.size();
+   }
+
+   line_begin.reserve(n_rows);
+   line_length.reserve(n_rows);
+   row_offsets.reserve(n_rows+1);
+   values.reserve(n_values);
+
+   for (size_t k=0; k<n_chunks; k++)
+   {
+      Chunk& chunk=chunks[k];
+      line_begin.insert(
+         line_begin.end(),chunk.line_begin.begin(),chunk.line_begin.end());
+      line_length.insert(
+         line_length.end(),chunk.line_length.begin(),
+         chunk.line_length.end());
+      values.insert(values.end(),chunk.values.begin(),chunk.values.end());
+      for (size_t r=0; r<chunk.n_row_values.size(); r++)
+      {
+         row_offsets.push_back(row_offsets.back()+chunk.n_row_values[r]);
+      }
+
+      Chunk empty_chunk;
+      std::swap(chunk,empty_chunk);
+   }
+   return true;
+}
+
+// ---------------------------------------------------------------------
+// Member function close() unmaps the current file and clears all
+// parsed rows.
+
+void numeric_text_reader::close()
+{
+   if (mapped_ptr != NULL) munmap(mapped_ptr,n_bytes);
+   if (fd >= 0) ::close(fd);
+   fd=-1;
+   mapped_ptr=NULL;
+   text_ptr=NULL;
+   n_bytes=0;
+
+   line_begin.clear();
+   line_length.clear();
+   row_offsets.assign(1,0);
+   values.clear();
+}
+
+// ---------------------------------------------------------------------
+// Private member function map_file() maps the entire input file
+// read-only into this process' address space.  Pages are requested
+// sequentially since every chunk is scanned front to back.
+
+bool numeric_text_reader::map_file()
+{
+   fd=open(filename.c_str(),O_RDONLY);
+   if (fd < 0)
+   {
+      cerr << "Cannot open " << filename
+           << " inside numeric_text_reader::map_file()" << endl;
+      return false;
+   }
+
+   struct stat file_stats;
+   if (fstat(fd,&file_stats) != 0)
+   {
+      cerr << "Cannot stat " << filename
+           << " inside numeric_text_reader::map_file()" << endl;
+      return false;
+   }
+   n_bytes=file_stats.st_size;
+
+// An empty file is legitimate but cannot be mapped:
+
+   if (n_bytes==0) return true;
+
+   mapped_ptr=mmap(NULL,n_bytes,PROT_READ,MAP_PRIVATE,fd,0);
+   if (mapped_ptr==MAP_FAILED)
+   {
+      mapped_ptr=NULL;
+      n_bytes=0;
+      cerr << "Cannot mmap " << filename
+           << " inside numeric_text_reader::map_file()" << endl;
+      return false;
+   }
+   madvise(mapped_ptr,n_bytes,MADV_SEQUENTIAL);
+   text_ptr=static_cast<const char*>(mapped_ptr);
+   return true;
+}
+
+// ---------------------------------------------------------------------
+// Private member function parse_chunk() splits bytes [start,stop) into
+// lines.  Comments and blank lines are discarded just as by
+// filefunc::ReadInfile().  Numbers within every surviving line are
+// appended to the chunk's values.
+
+void numeric_text_reader::parse_chunk(
+   size_t start,size_t stop,Chunk& chunk) const
+{
+   size_t p=start;
+   while (p < stop)
+   {
+      const char* line_ptr=text_ptr+p;
+      const void* newline_ptr=memchr(line_ptr,'\n',stop-p);
+      size_t eol=(newline_ptr==NULL) ? stop :
+         static_cast<const char*>(newline_ptr)-text_ptr;
+
+      size_t length=eol-p;
+      if (strip_comments_flag)
+      {
+         const void* pound_ptr=memchr(line_ptr,'#',length);
+         if (pound_ptr != NULL)
+         {
+            length=static_cast<const char*>(pound_ptr)-line_ptr;
+         }
+      }
+
+      if (length > 0)
+      {
+         chunk.line_begin.push_back(p);
+         chunk.line_length.push_back(length);
+         chunk.n_row_values.push_back(
+            parse_row(line_ptr,line_ptr+length,chunk.values));
+      }
+      p=eol+1;
+   } // while loop over lines within chunk
+}
+
+// ---------------------------------------------------------------------
+// Private member function parse_row() appends the numbers within
+// [begin,end) to STL vector values and returns their number.  If a
+// column projection is set, only tokens belonging to requested columns
+// are converted and scanning stops after the last requested column.
+
+unsigned int numeric_text_reader::parse_row(
+   const char* begin,const char* end,vector<double>& values) const
+{
+   if (columns.size()==0)
+   {
+      return append_numbers(begin,end,values);
+   }
+
+   unsigned int max_column=0;
+   for (unsigned int c=0; c<columns.size(); c++)
+   {
+      if (columns[c] > max_column) max_column=columns[c];
+   }
+
+   size_t offset=values.size();
+   values.resize(offset+columns.size(),missing_value);
+   unsigned int column=0;
+   const char* p=begin;
+   while (p < end && column <= max_column)
+   {
+      while (p < end && separator_char(*p)) p++;
+      const char* token_begin=p;
+      while (p < end && !separator_char(*p)) p++;
+      if (p==token_begin || !numeric_token(token_begin,p)) continue;
+
+      for (unsigned int c=0; c<columns.size(); c++)
+      {
+         if (columns[c]==column)
+         {
+            convert_token(token_begin,p,values[offset+c]);
+         }
+      }
+      column++;
+   }
+   return columns.size();
+}
+
+// ==========================================================================
+// Token parsing member functions
+// ==========================================================================
+
+// Static member function parse_numbers() is a reentrant equivalent of
+// stringfunc::string_to_numbers() which operates upon character
+// ranges.  It returns the number of values placed into output STL
+// vector values.
+
+unsigned int numeric_text_reader::parse_numbers(
+   const char* begin,const char* end,vector<double>& values)
+{
+   values.clear();
+   return append_numbers(begin,end,values);
+}
+
+// ---------------------------------------------------------------------
+// Private static member function append_numbers() appends the numbers
+// within [begin,end) to STL vector values and returns their number.
+
+unsigned int numeric_text_reader::append_numbers(
+   const char* begin,const char* end,vector<double>& values)
+{
+   size_t n_initial_values=values.size();
+   const char* p=begin;
+   while (p < end)
+   {
+      while (p < end && separator_char(*p)) p++;
+      const char* token_begin=p;
+      while (p < end && !separator_char(*p)) p++;
+      double value;
+      if (p > token_begin && convert_token(token_begin,p,value))
+      {
+         values.push_back(value);
+      }
+   }
+   return values.size()-n_initial_values;
+}
+
+// ---------------------------------------------------------------------
+// Private static member function numeric_token() mirrors
+// stringfunc::is_number(): a token must contain a digit and no letters
+// other than exponent markers e and E.  Various punctuation marks are
+// also disallowed.
+
+bool numeric_text_reader::numeric_token(const char* begin,const char* end)
+{
+   bool digit_flag=false;
+   for (const char* p=begin; p<end; p++)
+   {
+      char c=*p;
+      if (c >= '0' && c <= '9')
+      {
+         digit_flag=true;
+      }
+      else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+      {
+         if (c != 'e' && c != 'E') return false;
+      }
+      else
+      {
+         switch (c)
+         {
+            case '~': case '!': case '@': case '#': case '$': case '%':
+            case '^': case '&': case '*': case '(': case ')': case '_':
+            case '|': case '=': case '<': case '>': case '?': case '/':
+            case '\'': case ';': case '[': case ']': case '{': case '}':
+               return false;
+            default:
+               break;
+         }
+      }
+   }
+   return digit_flag;
+}
+
+// ---------------------------------------------------------------------
+// Private static member function convert_token() sets value to the
+// longest numeric prefix of a token just as atof() would.  Tokens
+// with no numeric prefix yield zero.  It returns true if the token
+// satisfies numeric_token().  Tokens which are entirely consumed by
+// parse_number() contain digits and no other letters than exponent
+// markers.  So they need not be rescanned.
+
+bool numeric_text_reader::convert_token(
+   const char* begin,const char* end,double& value)
+{
+   if (parse_number(begin,end,value)==end) return true;
+   return numeric_token(begin,end);
+}
+
+// ---------------------------------------------------------------------
+// Static member function parse_number() converts the longest prefix of
+// [begin,end) which forms a decimal floating point number:
+
+//	[+-] digits [. digits] [(e|E) [+-] digits]
+
+// It returns a pointer just past the converted characters, or begin
+// if no number is present.  Following Clinger, mantissas with at most
+// 15 significant digits and decimal exponents within [-22,22] are
+// converted exactly by a single multiplication or division by an
+// exactly representable power of ten.  All other numbers are passed
+// to strtod() so that results are always correctly rounded.
+
+const char* numeric_text_reader::parse_number(
+   const char* begin,const char* end,double& value)
+{
+   static const double powers_of_ten[23]=
+      {
+         1E0,1E1,1E2,1E3,1E4,1E5,1E6,1E7,1E8,1E9,1E10,1E11,
+         1E12,1E13,1E14,1E15,1E16,1E17,1E18,1E19,1E20,1E21,1E22
+      };
+
+   value=0;
+   const char* p=begin;
+   bool negative_flag=false;
+   if (p < end && (*p=='+' || *p=='-'))
+   {
+      negative_flag=(*p=='-');
+      p++;
+   }
+
+   unsigned long long mantissa=0;
+   int n_significant_digits=0;
+   int n_mantissa_digits=0;
+   int decimal_exponent=0;
+
+   while (p < end && *p >= '0' && *p <= '9')
+   {
+      if (mantissa > 0 || *p != '0')
+      {
+         if (n_significant_digits < 19)
+         {
+            mantissa=10*mantissa+(*p-'0');
+         }
+         else
+         {
+            decimal_exponent++;
+         }
+         n_significant_digits++;
+      }
+      n_mantissa_digits++;
+      p++;
+   }
+
+   if (p < end && *p=='.')
+   {
+      p++;
+      while (p < end && *p >= '0' && *p <= '9')
+      {
+         if (mantissa > 0 || *p != '0')
+         {
+            if (n_significant_digits < 19)
+            {
+               mantissa=10*mantissa+(*p-'0');
+               decimal_exponent--;
+            }
+            n_significant_digits++;
+         }
+         else
+         {
+            decimal_exponent--;
+         }
+         n_mantissa_digits++;
+         p++;
+      }
+   }
+   if (n_mantissa_digits==0) return begin;
+
+   if (p < end && (*p=='e' || *p=='E'))
+   {
+      const char* q=p+1;
+      bool negative_exponent_flag=false;
+      if (q < end && (*q=='+' || *q=='-'))
+      {
+         negative_exponent_flag=(*q=='-');
+         q++;
+      }
+      if (q < end && *q >= '0' && *q <= '9')
+      {
+         int exponent=0;
+         while (q < end && *q >= '0' && *q <= '9')
+         {
+            if (exponent < 100000) exponent=10*exponent+(*q-'0');
+            q++;
+         }
+         decimal_exponent += negative_exponent_flag ? -exponent : exponent;
+         p=q;
+      }
+   }
+
+   if (mantissa==0)
+   {
+      value=negative_flag ? -0.0 : 0.0;
+   }
+   else if (n_significant_digits <= 15 && decimal_exponent >= -22 &&
+            decimal_exponent <= 22)
+   {
+      value=double(mantissa);
+      if (decimal_exponent < 0)
+      {
+         value /= powers_of_ten[-decimal_exponent];
+      }
+      else
+      {
+         value *= powers_of_ten[decimal_exponent];
+      }
+      if (negative_flag) value=-value;
+   }
+   else
+   {
+      char buffer[64];
+      size_t length=p-begin;
+      if (length < sizeof(buffer))
+      {
+         memcpy(buffer,begin,length);
+         buffer[length]='\0';
+         value=strtod(buffer,NULL);
+      }
+      else
+      {
+         string token(begin,length);
+         value=strtod(token.c_str(),NULL);
+      }
+   }
+   return p;
+}
@@ -0,0 +1,241 @@
+// ==========================================================================
+// Header file for NUMERIC_TEXT_READER class which parses numbers
+// from ascii text files without the global filefunc::text_line
+// buffer.  Input files are memory mapped and never copied into
+// per-line strings.  Large files are divided into chunks whose
+// boundaries fall just after newlines.  Chunks are parsed in parallel
+// by OpenMP threads and their results are concatenated in file order.
+
+// Rows correspond exactly to the lines which filefunc::ReadInfile()
+// places into filefunc::text_line: blank lines are skipped and, if
+// strip_comments_flag==true, text following '#' is removed and lines
+// which become empty are skipped.  Numbers within each row equal those
+// which stringfunc::string_to_numbers() returns for the line.  But
+// tokens are converted in place via a from_chars-style parser rather
+// than being split into substrings and passed to atof().
+
+// If a column projection is set, only the requested numeric columns
+// are converted.  Each row then holds exactly one value per requested
+// column, and columns missing from a line are assigned missing_value.
+
+// Every reader owns all of its state.  So distinct readers may parse
+// distinct files concurrently.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef NUMERIC_TEXT_READER_H
+#define NUMERIC_TEXT_READER_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class numeric_text_reader
+{
+
+  public:
+
+   numeric_text_reader();
+   numeric_text_reader(std::string filename);
+   ~numeric_text_reader();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const numeric_text_reader& R);
+
+// Set and get member functions:
+
+   void set_strip_comments_flag(bool flag);
+   void set_n_threads(int n);
+   void set_min_chunk_size(std::size_t n_bytes);
+   void set_columns(const std::vector<unsigned int>& columns);
+   void clear_columns();
+   void set_missing_value(double z);
+
+   const std::string& get_filename() const;
+   std::size_t get_n_bytes() const;
+   unsigned int get_n_rows() const;
+   unsigned int get_n_values(unsigned int r) const;
+   const double* get_row(unsigned int r) const;
+   double get_value(unsigned int r,unsigned int c) const;
+   std::vector<double> get_row_values(unsigned int r) const;
+   const std::vector<double>& get_values() const;
+
+// Rows' text remains accessible until close() is called:
+
+   const char* get_line_ptr(unsigned int r) const;
+   unsigned int get_line_length(unsigned int r) const;
+   std::string get_line(unsigned int r) const;
+
+// File parsing member functions:
+
+   bool read(std::string filename);
+   void close();
+
+// Token parsing member functions:
+
+   static const char* parse_number(
+      const char* begin,const char* end,double& value);
+   static unsigned int parse_numbers(
+      const char* begin,const char* end,std::vector<double>& values);
+
+  private:
+
+   bool strip_comments_flag;
+   int n_threads;
+   std::size_t min_chunk_size;
+   double missing_value;
+   std::vector<unsigned int> columns;
+
+   std::string filename;
+   int fd;
+   std::size_t n_bytes;
+   void* mapped_ptr;
+   const char* text_ptr;
+
+// Row r's text starts at text_ptr+line_begin[r].  Its values occupy
+// entries row_offsets[r] through row_offsets[r+1]-1 of values:
+
+   std::vector<std::size_t> line_begin;
+   std::vector<unsigned int> line_length;
+   std::vector<std::size_t> row_offsets;
+   std::vector<double> values;
+
+   struct Chunk
+   {
+      std::vector<std::size_t> line_begin;
+      std::vector<unsigned int> line_length,n_row_values;
+      std::vector<double> values;
+   };
+
+   void initialize_member_objects();
+
+   int get_n_threads() const;
+   bool map_file();
+   void parse_chunk(std::size_t start,std::size_t stop,Chunk& chunk) const;
+   unsigned int parse_row(
+      const char* begin,const char* end,std::vector<double>& values) const;
+   static unsigned int append_numbers(
+      const char* begin,const char* end,std::vector<double>& values);
+
+   static bool separator_char(char c);
+   static bool numeric_token(const char* begin,const char* end);
+   static bool convert_token(
+      const char* begin,const char* end,double& value);
+
+// Disallow copying since mapped memory is owned by this object:
+
+   numeric_text_reader(const numeric_text_reader& R);
+   numeric_text_reader& operator= (const numeric_text_reader& R);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+// Set and get member functions:
+
+inline void numeric_text_reader::set_strip_comments_flag(bool flag)
+{
+   strip_comments_flag=flag;
+}
+
+inline void numeric_text_reader::set_n_threads(int n)
+{
+   n_threads=n;
+}
+
+// Files smaller than twice min_chunk_size are parsed by a single
+// thread:
+
+inline void numeric_text_reader::set_min_chunk_size(std::size_t n_bytes)
+{
+   min_chunk_size=n_bytes;
+}
+
+inline void numeric_text_reader::set_columns(
+   const std::vector<unsigned int>& columns)
+{
+   this->columns=columns;
+}
+
+inline void numeric_text_reader::clear_columns()
+{
+   columns.clear();
+}
+
+inline void numeric_text_reader::set_missing_value(double z)
+{
+   missing_value=z;
+}
+
+inline const std::string& numeric_text_reader::get_filename() const
+{
+   return filename;
+}
+
+inline std::size_t numeric_text_reader::get_n_bytes() const
+{
+   return n_bytes;
+}
+
+inline unsigned int numeric_text_reader::get_n_rows() const
+{
+   return line_begin.size();
+}
+
+inline unsigned int numeric_text_reader::get_n_values(unsigned int r) const
+{
+   return row_offsets[r+1]-row_offsets[r];
+}
+
+inline const double* numeric_text_reader::get_row(unsigned int r) const
+{
+   return values.empty() ? NULL : &values[row_offsets[r]];
+}
+
+inline double numeric_text_reader::get_value(
+   unsigned int r,unsigned int c) const
+{
+   return values[row_offsets[r]+c];
+}
+
+inline std::vector<double> numeric_text_reader::get_row_values(
+   unsigned int r) const
+{
+   return std::vector<double>(
+      values.begin()+row_offsets[r],values.begin()+row_offsets[r+1]);
+}
+
+inline const std::vector<double>& numeric_text_reader::get_values() const
+{
+   return values;
+}
+
+inline const char* numeric_text_reader::get_line_ptr(unsigned int r) const
+{
+   return text_ptr+line_begin[r];
+}
+
+inline unsigned int numeric_text_reader::get_line_length(unsigned int r)
+   const
+{
+   return line_length[r];
+}
+
+inline std::string numeric_text_reader::get_line(unsigned int r) const
+{
+   return std::string(text_ptr+line_begin[r],line_length[r]);
+}
+
+// Private inlined methods:
+
+// Separators match stringfunc::string_to_numbers()'s whitespace plus
+// carriage returns from DOS files:
+
+inline bool numeric_text_reader::separator_char(char c)
+{
+   return c==' ' || c=='\t' || c=='\n' || c=='\r';
+}
+
+#endif  // numeric_text_reader.h
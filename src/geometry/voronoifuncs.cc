@@ -1,13 +1,14 @@
 // ==========================================================================
 // VORONOIFUNCS stand-alone methods
 // ==========================================================================
-// Last modified on 8/6/06; 12/4/10; 2/17/11
+// Last modified on 8/6/06; 12/4/10; 2/17/11; 10/18/26
 // ==========================================================================
 
 #include <osgUtil/DelaunayTriangulator>
 #include "math/basic_math.h"
 #include "geometry/convexhull.h"
 #include "delaunay/delaunay.h"
+#include "delaunay/delaunay_triangulator.h"
 #include "image/drawfuncs.h"
 #include "datastructures/Linkedlist.h"
 #include "datastructures/Mynode.h"
@@ -74,25 +75,40 @@ namespace voronoifunc
       }
 */
 
-/*
    vector<polygon> generate_Delaunay_triangles(
       const vector<threevector>& site,int*& delaunay_triangle_vertex)
       {
 //         cout << "inside voronoifunc::generate_Delaunay_triangles()" << endl;
-         
-         delaunay::read_delaunay_vertices(site);
-         int number_of_delaunay_triangles=
-            delaunay::compute_delaunay_triangulation();
-//         cout << "number_of_delaunay_triangles = "
-//              << number_of_delaunay_triangles << endl;
-         
-         delaunay_triangle_vertex=delaunay::delaunay_triangle_vertices(
-            number_of_delaunay_triangles);
-         delaunay::delete_circular_lists();
+
+         int number_of_delaunay_triangles;
+         delaunay_triangle_vertex=compute_delaunay_triangle_vertices(
+            site,number_of_delaunay_triangles);
          return generate_Delaunay_triangles(
                number_of_delaunay_triangles,delaunay_triangle_vertex,site);
       }
-*/
+
+// ---------------------------------------------------------------------
+// Method compute_delaunay_triangle_vertices triangulates the XY
+// coordinates of all sites via a delaunay_triangulator.  It returns a
+// dynamically allocated integer array containing 3 site indices for
+// each Delaunay triangle.
+
+   int* compute_delaunay_triangle_vertices(
+      const vector<threevector>& site,int& number_of_delaunay_triangles)
+      {
+         delaunay_triangulator triangulator(site);
+         triangulator.triangulate();
+         number_of_delaunay_triangles=triangulator.get_n_triangles();
+
+         const vector<int>& triangle_vertices=
+            triangulator.get_triangle_vertices();
+         int* delaunay_triangle_vertex=new int[triangle_vertices.size()];
+         for (unsigned int i=0; i<triangle_vertices.size(); i++)
+         {
+            delaunay_triangle_vertex[i]=triangle_vertices[i];
+         }
+         return delaunay_triangle_vertex;
+      }
 
 // ---------------------------------------------------------------------
 // This overloaded version of generate_Delaunay_triangle_list takes in
@@ -487,16 +503,12 @@ namespace voronoifunc
 // Next compute Delauney triangulation of surface defined by all
 // lattice sites:
 
-         delaunay::read_delaunay_vertices(site_copy);
-         int number_of_delaunay_triangles=
-            delaunay::compute_delaunay_triangulation();
+         int number_of_delaunay_triangles;
+         int* delaunay_triangle_vertex=compute_delaunay_triangle_vertices(
+            site_copy,number_of_delaunay_triangles);
 //         cout << "Number of Delaunay triangles = " 
 //              << number_of_delaunay_triangles << endl;
 
-         int* delaunay_triangle_vertex=delaunay::delaunay_triangle_vertices(
-            number_of_delaunay_triangles);
-         delaunay::delete_circular_lists();
-
 // Compute positions of finite Voronoi vertices which are given by the
 // centers of circles that circumscribe each Delaunay triangle:
 
@@ -1,7 +1,7 @@
 // =========================================================================
 // Header file for stand-alone Voronoi region functions.
 // =========================================================================
-// Last modified on 8/5/06; 8/6/06; 2/17/11; 1/23/14
+// Last modified on 8/5/06; 8/6/06; 2/17/11; 1/23/14; 10/18/26
 // =========================================================================
 
 #ifndef VORONOIFUNCS_H
@@ -29,7 +29,8 @@ namespace voronoifunc
       const std::vector<threevector>& site,int*& delaunay_triangle_vertex);
    std::vector<polygon> generate_Delaunay_triangles(
       const std::vector<threevector>& site,int*& delaunay_triangle_vertex);
-
+   int* compute_delaunay_triangle_vertices(
+      const std::vector<threevector>& site,int& number_of_delaunay_triangles);
 
    Linkedlist<polygon>* generate_Delaunay_triangle_list(
       int number_of_delaunay_triangles,int* delaunay_triangle_vertex,
@@ -0,0 +1,445 @@
+// ==========================================================================
+// CSR_GRAPH class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include "graphs/csr_graph.h"
+#include "graphs/graph.h"
+#include "graphs/graph_edge.h"
+#include "graphs/node.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using std::cout;
+using std::endl;
+using std::greater;
+using std::map;
+using std::ostream;
+using std::pair;
+using std::priority_queue;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+// The constructor copies the connectivity of *graph_ptr.  Edges whose
+// endpoints do not both belong to the graph as well as self loops are
+// ignored.  As within graph::get_neighbor_node_IDs(), edges are
+// traversed in both directions regardless of their directed flags.
+
+csr_graph::csr_graph(const graph* graph_ptr)
+{
+   n_nodes=graph_ptr->get_n_nodes();
+   node_IDs.reserve(n_nodes);
+   for (unsigned int p=0; p<n_nodes; p++)
+   {
+      int curr_node_ID=graph_ptr->get_ordered_node_ptr(p)->get_ID();
+      node_IDs.push_back(curr_node_ID);
+      node_indices_map[curr_node_ID]=p;
+   }
+
+   vector<int> edge_node1_indices,edge_node2_indices;
+   vector<double> edge_weights;
+   for (unsigned int e=0; e<graph_ptr->get_n_graph_edges(); e++)
+   {
+      const graph_edge* curr_edge_ptr=
+         graph_ptr->get_ordered_graph_edge_ptr(e);
+      if (curr_edge_ptr==NULL) continue;
+      int p=get_node_index(curr_edge_ptr->get_node1_ptr()->get_ID());
+      int q=get_node_index(curr_edge_ptr->get_node2_ptr()->get_ID());
+      if (p < 0 || q < 0 || p==q) continue;
+
+      edge_IDs.push_back(curr_edge_ptr->get_ID());
+      edge_node1_indices.push_back(p);
+      edge_node2_indices.push_back(q);
+      edge_weights.push_back(curr_edge_ptr->get_weight());
+   } // loop over index e labeling graph edges
+   n_edges=edge_IDs.size();
+
+// Count node degrees and convert them into row offsets:
+
+   row_offsets.assign(n_nodes+1,0);
+   for (unsigned int e=0; e<n_edges; e++)
+   {
+      row_offsets[edge_node1_indices[e]+1]++;
+      row_offsets[edge_node2_indices[e]+1]++;
+   }
+   for (unsigned int p=0; p<n_nodes; p++)
+   {
+      row_offsets[p+1] += row_offsets[p];
+   }
+
+   unsigned int n_arcs=row_offsets[n_nodes];
+   neighbor_indices.resize(n_arcs);
+   arc_edge_indices.resize(n_arcs);
+   arc_weights.resize(n_arcs);
+
+   vector<unsigned int> next_arc(row_offsets.begin(),row_offsets.end()-1);
+   for (unsigned int e=0; e<n_edges; e++)
+   {
+      int p=edge_node1_indices[e];
+      int q=edge_node2_indices[e];
+
+      unsigned int a=next_arc[p]++;
+      neighbor_indices[a]=q;
+      arc_edge_indices[a]=e;
+      arc_weights[a]=edge_weights[e];
+
+      a=next_arc[q]++;
+      neighbor_indices[a]=p;
+      arc_edge_indices[a]=e;
+      arc_weights[a]=edge_weights[e];
+   } // loop over index e labeling retained edges
+}
+
+csr_graph::~csr_graph()
+{
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const csr_graph& g)
+{
+   outstream << endl;
+   outstream << "n_nodes = " << g.n_nodes
+             << " n_edges = " << g.n_edges
+             << " n_arcs = " << g.get_n_arcs() << endl;
+   return outstream;
+}
+
+// =========================================================================
+// Path finding member functions
+// =========================================================================
+
+// Member function compute_Dijkstra_distances returns the minimal
+// summed edge weight from the input source node to every other node.
+// Unreachable nodes are assigned infinite distances and predecessor
+// indices equal to -1.  Edge weights are assumed to be non-negative.
+
+// Rather than decreasing keys, improved distances are simply pushed
+// onto the binary heap again.  Stale heap entries are skipped when
+// they are popped.
+
+void csr_graph::compute_Dijkstra_distances(
+   int source_index,vector<double>& distances,
+   vector<int>& predecessor_indices) const
+{
+   const double infinity=std::numeric_limits<double>::infinity();
+   distances.assign(n_nodes,infinity);
+   predecessor_indices.assign(n_nodes,-1);
+   if (source_index < 0 || source_index >= int(n_nodes)) return;
+
+   typedef pair<double,int> DISTANCE_INDEX_PAIR;
+   priority_queue<DISTANCE_INDEX_PAIR,vector<DISTANCE_INDEX_PAIR>,
+      greater<DISTANCE_INDEX_PAIR> > heap;
+
+   distances[source_index]=0;
+   heap.push(DISTANCE_INDEX_PAIR(0,source_index));
+   while (!heap.empty())
+   {
+      double curr_distance=heap.top().first;
+      int p=heap.top().second;
+      heap.pop();
+      if (curr_distance > distances[p]) continue;
+
+      for (unsigned int a=row_offsets[p]; a<row_offsets[p+1]; a++)
+      {
+         int q=neighbor_indices[a];
+         double new_distance=curr_distance+arc_weights[a];
+         if (new_distance < distances[q])
+         {
+            distances[q]=new_distance;
+            predecessor_indices[q]=p;
+            heap.push(DISTANCE_INDEX_PAIR(new_distance,q));
+         }
+      } // loop over index a labeling arcs leaving node p
+   } // while heap is not empty
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_BFS_hops returns the minimal number of
+// edges separating the input source node from every other node.
+// Unreachable nodes are assigned -1 hops.
+
+void csr_graph::compute_BFS_hops(int source_index,vector<int>& hops) const
+{
+   hops.assign(n_nodes,-1);
+   if (source_index < 0 || source_index >= int(n_nodes)) return;
+
+   vector<int> node_queue;
+   node_queue.reserve(n_nodes);
+   node_queue.push_back(source_index);
+   hops[source_index]=0;
+   for (unsigned int head=0; head<node_queue.size(); head++)
+   {
+      int p=node_queue[head];
+      for (unsigned int a=row_offsets[p]; a<row_offsets[p+1]; a++)
+      {
+         int q=neighbor_indices[a];
+         if (hops[q] >= 0) continue;
+         hops[q]=hops[p]+1;
+         node_queue.push_back(q);
+      }
+   } // loop over head index within node_queue
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_multi_source_BFS_hops fills hops[s] with
+// the BFS hop counts from node source_indices[s].  Up to 64 sources
+// are processed together.  Each node carries 64-bit masks indicating
+// which of the current batch's sources have already reached it and
+// which form part of the current frontier.  So a single sweep over
+// the arc arrays advances 64 breadth-first searches by one level.
+
+void csr_graph::compute_multi_source_BFS_hops(
+   const vector<int>& source_indices,vector<vector<int> >& hops) const
+{
+   typedef unsigned long long BITMASK;
+   const unsigned int batch_size=64;
+
+   hops.assign(source_indices.size(),vector<int>(n_nodes,-1));
+   vector<BITMASK> seen(n_nodes),frontier(n_nodes),next_frontier(n_nodes);
+
+   for (unsigned int s_start=0; s_start<source_indices.size();
+        s_start += batch_size)
+   {
+      unsigned int s_stop=std::min(
+         s_start+batch_size,(unsigned int)(source_indices.size()));
+      std::fill(seen.begin(),seen.end(),0);
+      std::fill(frontier.begin(),frontier.end(),0);
+
+      bool frontier_nonempty_flag=false;
+      for (unsigned int s=s_start; s<s_stop; s++)
+      {
+         int p=source_indices[s];
+         if (p < 0 || p >= int(n_nodes)) continue;
+         BITMASK source_bit=BITMASK(1) << (s-s_start);
+         seen[p] |= source_bit;
+         frontier[p] |= source_bit;
+         hops[s][p]=0;
+         frontier_nonempty_flag=true;
+      }
+
+      int level=0;
+      while (frontier_nonempty_flag)
+      {
+         level++;
+         std::fill(next_frontier.begin(),next_frontier.end(),0);
+         for (unsigned int p=0; p<n_nodes; p++)
+         {
+            BITMASK curr_frontier=frontier[p];
+            if (curr_frontier==0) continue;
+            for (unsigned int a=row_offsets[p]; a<row_offsets[p+1]; a++)
+            {
+               next_frontier[neighbor_indices[a]] |= curr_frontier;
+            }
+         } // loop over index p labeling frontier nodes
+
+         frontier_nonempty_flag=false;
+         for (unsigned int q=0; q<n_nodes; q++)
+         {
+            BITMASK newly_reached=next_frontier[q] & ~seen[q];
+            frontier[q]=newly_reached;
+            if (newly_reached==0) continue;
+
+            seen[q] |= newly_reached;
+            frontier_nonempty_flag=true;
+            while (newly_reached != 0)
+            {
+               int b=__builtin_ctzll(newly_reached);
+               hops[s_start+b][q]=level;
+               newly_reached &= newly_reached-1;
+            }
+         } // loop over index q labeling nodes
+      } // while frontier is nonempty
+   } // loop over s_start labeling source batches
+}
+
+// =========================================================================
+// Centrality member functions
+// =========================================================================
+
+// Member function compute_betweenness_centralities implements
+// U. Brandes' "A faster algorithm for betweenness centrality"
+// (J. Math. Sociology 25, 2001).  For each source node, shortest
+// paths are counted during a single BFS (or Dijkstra search if
+// weighted_flag==true).  Pair dependencies are then accumulated in
+// order of decreasing distance from the source.  Sources are divided
+// among n_threads OpenMP threads (or the OpenMP default if n_threads
+// <= 0), each of which sums into its own centrality arrays.
+
+// Since the graph is undirected, every shortest path is counted from
+// both of its endpoints.  So output centralities are halved.  Weighted
+// searches assume strictly positive edge weights.
+
+void csr_graph::compute_betweenness_centralities(
+   bool weighted_flag,int n_threads,vector<double>& node_centralities,
+   vector<double>& edge_centralities) const
+{
+   node_centralities.assign(n_nodes,0);
+   edge_centralities.assign(n_edges,0);
+
+#ifdef _OPENMP
+   if (n_threads <= 0) n_threads=omp_get_max_threads();
+#else
+   n_threads=1;
+#endif
+
+#pragma omp parallel num_threads(n_threads)
+   {
+      vector<int> stack_indices;
+      vector<double> sigma(n_nodes,0),delta(n_nodes,0);
+      vector<double> distances(
+         n_nodes,std::numeric_limits<double>::infinity());
+      vector<double> thread_node_centralities(n_nodes,0);
+      vector<double> thread_edge_centralities(n_edges,0);
+      stack_indices.reserve(n_nodes);
+
+#pragma omp for schedule(dynamic,16)
+      for (int s=0; s<int(n_nodes); s++)
+      {
+         accumulate_source_betweenness(
+            s,weighted_flag,stack_indices,sigma,distances,delta,
+            thread_node_centralities,thread_edge_centralities);
+      }
+
+#pragma omp critical
+      {
+         for (unsigned int p=0; p<n_nodes; p++)
+         {
+            node_centralities[p] += thread_node_centralities[p];
+         }
+         for (unsigned int e=0; e<n_edges; e++)
+         {
+            edge_centralities[e] += thread_edge_centralities[e];
+         }
+      }
+   } // omp parallel region
+
+   for (unsigned int p=0; p<n_nodes; p++)
+   {
+      node_centralities[p] *= 0.5;
+   }
+   for (unsigned int e=0; e<n_edges; e++)
+   {
+      edge_centralities[e] *= 0.5;
+   }
+}
+
+// ---------------------------------------------------------------------
+// Private member function accumulate_source_betweenness adds the
+// dependencies of input source_index upon every other node and edge
+// into node_centralities and edge_centralities.  Working arrays sigma,
+// distances and delta must hold n_nodes entries.  Upon entry,
+// distances must be infinite and sigma and delta must be zero.  They
+// are reset upon exit for just the nodes reached from the source.
+
+// Rather than storing explicit predecessor lists, node v is recognized
+// as a shortest path predecessor of w when distances[v] + weight(v,w)
+// exactly equals distances[w].  Since the final distances are computed
+// by exactly the same floating point sums, this test reproduces the
+// predecessor relation found during the forward search.
+
+void csr_graph::accumulate_source_betweenness(
+   int source_index,bool weighted_flag,vector<int>& stack_indices,
+   vector<double>& sigma,vector<double>& distances,vector<double>& delta,
+   vector<double>& node_centralities,vector<double>& edge_centralities)
+   const
+{
+   stack_indices.clear();
+   sigma[source_index]=1;
+   distances[source_index]=0;
+
+   if (weighted_flag)
+   {
+      typedef pair<double,int> DISTANCE_INDEX_PAIR;
+      priority_queue<DISTANCE_INDEX_PAIR,vector<DISTANCE_INDEX_PAIR>,
+         greater<DISTANCE_INDEX_PAIR> > heap;
+      heap.push(DISTANCE_INDEX_PAIR(0,source_index));
+      while (!heap.empty())
+      {
+         double curr_distance=heap.top().first;
+         int v=heap.top().second;
+         heap.pop();
+         if (curr_distance > distances[v]) continue;
+
+         stack_indices.push_back(v);
+         for (unsigned int a=row_offsets[v]; a<row_offsets[v+1]; a++)
+         {
+            int w=neighbor_indices[a];
+            double new_distance=curr_distance+arc_weights[a];
+            if (new_distance < distances[w])
+            {
+               distances[w]=new_distance;
+               sigma[w]=sigma[v];
+               heap.push(DISTANCE_INDEX_PAIR(new_distance,w));
+            }
+            else if (new_distance==distances[w])
+            {
+               sigma[w] += sigma[v];
+            }
+         } // loop over index a labeling arcs leaving node v
+      } // while heap is not empty
+   }
+   else
+   {
+      stack_indices.push_back(source_index);
+      for (unsigned int head=0; head<stack_indices.size(); head++)
+      {
+         int v=stack_indices[head];
+         double next_distance=distances[v]+1;
+         for (unsigned int a=row_offsets[v]; a<row_offsets[v+1]; a++)
+         {
+            int w=neighbor_indices[a];
+            if (distances[w]==std::numeric_limits<double>::infinity())
+            {
+               distances[w]=next_distance;
+               stack_indices.push_back(w);
+            }
+            if (distances[w]==next_distance)
+            {
+               sigma[w] += sigma[v];
+            }
+         } // loop over index a labeling arcs leaving node v
+      } // loop over head index within BFS queue
+   }
+
+// Accumulate dependencies in order of decreasing distance from the
+// source:
+
+   for (int i=int(stack_indices.size())-1; i >= 0; i--)
+   {
+      int w=stack_indices[i];
+      double coeff=(1+delta[w])/sigma[w];
+      for (unsigned int a=row_offsets[w]; a<row_offsets[w+1]; a++)
+      {
+         int v=neighbor_indices[a];
+         double arc_weight=weighted_flag ? arc_weights[a] : 1;
+         if (distances[v]+arc_weight != distances[w]) continue;
+
+         double c=sigma[v]*coeff;
+         edge_centralities[arc_edge_indices[a]] += c;
+         delta[v] += c;
+      } // loop over index a labeling arcs entering node w
+      if (w != source_index) node_centralities[w] += delta[w];
+   } // loop over index i labeling nodes in order of decreasing distance
+
+// Reset working arrays for nodes reached from the source:
+
+   for (unsigned int i=0; i<stack_indices.size(); i++)
+   {
+      int w=stack_indices[i];
+      sigma[w]=delta[w]=0;
+      distances[w]=std::numeric_limits<double>::infinity();
+   }
+}
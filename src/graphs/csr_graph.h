@@ -0,0 +1,152 @@
+// ==========================================================================
+// Header file for CSR_GRAPH class which holds an immutable
+// compressed-sparse-row snapshot of a graph's connectivity.  Nodes are
+// relabeled by their graph order index p = 0, 1, ... n_nodes-1.  Arcs
+// leaving node p occupy entries [row_offsets[p],row_offsets[p+1]) of
+// contiguous neighbor, weight and edge index arrays.  Every undirected
+// graph_edge contributes one arc in each direction.
+
+// Path and centrality queries then traverse flat integer arrays
+// rather than repeatedly looking up node and edge pointers within STL
+// maps:
+
+//	Dijkstra shortest paths via a binary heap in O((V+E) log V)
+//	Multi-source BFS hop counts for up to 64 sources per graph sweep
+//	Brandes node and edge betweenness centralities parallelized
+//		over source nodes
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+class graph;
+
+class csr_graph
+{
+
+  public:
+
+   csr_graph(const graph* graph_ptr);
+   ~csr_graph();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const csr_graph& g);
+
+// Set and get member functions:
+
+   unsigned int get_n_nodes() const;
+   unsigned int get_n_arcs() const;
+   unsigned int get_n_edges() const;
+   int get_node_ID(int p) const;
+   int get_node_index(int node_ID) const;
+   int get_edge_ID(int e) const;
+   unsigned int get_degree(int p) const;
+   unsigned int get_row_offset(int p) const;
+   int get_neighbor_index(int a) const;
+   double get_arc_weight(int a) const;
+
+// Path finding member functions:
+
+   void compute_Dijkstra_distances(
+      int source_index,std::vector<double>& distances,
+      std::vector<int>& predecessor_indices) const;
+   void compute_BFS_hops(int source_index,std::vector<int>& hops) const;
+   void compute_multi_source_BFS_hops(
+      const std::vector<int>& source_indices,
+      std::vector<std::vector<int> >& hops) const;
+
+// Centrality member functions:
+
+   void compute_betweenness_centralities(
+      bool weighted_flag,int n_threads,
+      std::vector<double>& node_centralities,
+      std::vector<double>& edge_centralities) const;
+
+  private:
+
+   unsigned int n_nodes,n_edges;
+   std::vector<int> node_IDs,edge_IDs;
+   std::map<int,int> node_indices_map;
+//   independent int var = node ID
+//   dependent int var = node order index p
+
+   std::vector<unsigned int> row_offsets;
+   std::vector<int> neighbor_indices,arc_edge_indices;
+   std::vector<double> arc_weights;
+
+   void accumulate_source_betweenness(
+      int source_index,bool weighted_flag,
+      std::vector<int>& stack_indices,std::vector<double>& sigma,
+      std::vector<double>& distances,std::vector<double>& delta,
+      std::vector<double>& node_centralities,
+      std::vector<double>& edge_centralities) const;
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+inline unsigned int csr_graph::get_n_nodes() const
+{
+   return n_nodes;
+}
+
+inline unsigned int csr_graph::get_n_arcs() const
+{
+   return neighbor_indices.size();
+}
+
+inline unsigned int csr_graph::get_n_edges() const
+{
+   return n_edges;
+}
+
+inline int csr_graph::get_node_ID(int p) const
+{
+   return node_IDs[p];
+}
+
+// Member function get_node_index returns -1 if input node_ID does not
+// belong to the graph:
+
+inline int csr_graph::get_node_index(int node_ID) const
+{
+   std::map<int,int>::const_iterator iter=node_indices_map.find(node_ID);
+   if (iter==node_indices_map.end()) return -1;
+   return iter->second;
+}
+
+inline int csr_graph::get_edge_ID(int e) const
+{
+   return edge_IDs[e];
+}
+
+inline unsigned int csr_graph::get_degree(int p) const
+{
+   return row_offsets[p+1]-row_offsets[p];
+}
+
+// Arcs leaving node p are labeled by indices a within
+// [get_row_offset(p),get_row_offset(p+1)):
+
+inline unsigned int csr_graph::get_row_offset(int p) const
+{
+   return row_offsets[p];
+}
+
+inline int csr_graph::get_neighbor_index(int a) const
+{
+   return neighbor_indices[a];
+}
+
+inline double csr_graph::get_arc_weight(int a) const
+{
+   return arc_weights[a];
+}
+
+#endif  // csr_graph.h
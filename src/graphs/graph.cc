@@ -1,7 +1,7 @@
 // =========================================================================
 // Graph class member function definitions
 // =========================================================================
-// Last modified on 6/20/13; 4/5/14; 8/20/16; 8/22/16
+// Last modified on 6/20/13; 4/5/14; 8/20/16; 8/22/16; 10/18/26
 // =========================================================================
 
 #include <algorithm>
@@ -10,9 +10,11 @@
 #include <vector>
 
 #include "general/filefuncs.h"
+#include "graphs/csr_graph.h"
 #include "math/genmatrix.h"
 #include "graphs/graph.h"
 #include "graphs/graph_edge.h"
+#include "graphs/graph_layout.h"
 #include "graphs/graphdbfuncs.h"
 #include "graphs/graphfuncs.h"
 #include "graphs/node.h"
@@ -1456,13 +1458,27 @@ void graph::export_edgelist(
 // parsed graph layout information.
 
 void graph::read_nodes_layout(string layout_filename)
+{
+   vector<int> unplaced_node_IDs;
+   read_nodes_layout(layout_filename,unplaced_node_IDs);
+}
+
+// ---------------------------------------------------------------------
+// This overloaded version of read_nodes_layout() also returns the IDs
+// of all nodes which received no coordinates from the layout file
+// (e.g. images appended to the graph after its layout was generated).
+
+void graph::read_nodes_layout(
+   string layout_filename,vector<int>& unplaced_node_IDs)
 {
    cout << "inside graph::read_nodes_layout()" << endl;
+   unplaced_node_IDs.clear();
    if (!filefunc::fileexist(layout_filename)) return;
 
    string banner="Importing node layout information from "+layout_filename;
    outputfunc::write_banner(banner);
 
+   std::set<int> placed_node_IDs;
    filefunc::ReadInfile(layout_filename);
    for (unsigned int i=0; i<filefunc::text_line.size(); i++)
    {
@@ -1476,6 +1492,7 @@ void graph::read_nodes_layout(string layout_filename)
       if(node_ptr != NULL)
       {
          node_ptr->set_posn(twovector(Uposn,Vposn));
+         placed_node_IDs.insert(node_ID);
       }
       else
       {
@@ -1487,6 +1504,13 @@ void graph::read_nodes_layout(string layout_filename)
          cout << " get_n_nodes() = " << get_n_nodes() << endl;
       }
    }
+
+   for (unsigned int p=0; p<get_n_nodes(); p++)
+   {
+      int node_ID=get_ordered_node_ptr(p)->get_ID();
+      if (placed_node_IDs.find(node_ID)==placed_node_IDs.end())
+         unplaced_node_IDs.push_back(node_ID);
+   }
 }
 
 // ---------------------------------------------------------------------
@@ -2653,6 +2677,34 @@ void graph::sink_heavy_degree_nodes(
    } // loop over index parent_ID labeling clusters
 } 
 
+// ---------------------------------------------------------------------
+// Member function compute_Barnes_Hut_layout() repositions every node
+// via Fruchterman-Reingold spring forces.  Repulsions among all nodes
+// are approximated via a Barnes-Hut quadtree and accumulated over
+// n_threads threads.  See class graph_layout.
+
+void graph::compute_Barnes_Hut_layout(unsigned int n_iters,int n_threads)
+{
+   graph_layout layout(this);
+   layout.set_n_threads(n_threads);
+   layout.compute_layout(n_iters);
+   layout.export_node_posns();
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_incremental_layout() positions just the
+// nodes whose IDs are passed in (e.g. images appended since the last
+// layout).  All other nodes remain fixed.
+
+void graph::compute_incremental_layout(
+   const vector<int>& new_node_IDs,unsigned int n_iters,int n_threads)
+{
+   graph_layout layout(this);
+   layout.set_n_threads(n_threads);
+   layout.compute_incremental_layout(new_node_IDs,n_iters);
+   layout.export_node_posns();
+}
+
 // =========================================================================
 // Graph parent/child member functions
 // =========================================================================
@@ -3046,41 +3098,42 @@ void graph::hierarchical_grandparents_clustering(
 
 // Member function compute_Dijkstra_edge_weights() implements
 // Dijkstra's algorithm for finding paths between nodes within a
-// connected graph.
+// connected graph.  Shortest distances are computed on a
+// compressed-sparse-row snapshot of the graph using a binary heap.
+// They are then copied back into every node's distance from start,
+// visited status and path predecessor.  Nodes which cannot be reached
+// from *initial_node_ptr remain unvisited with infinite distance.
 
 void graph::compute_Dijkstra_edge_weights(node* initial_node_ptr)
 {
    cout << "inside graph::compute_Dijkstra_edge_weights()" << endl;
 
-// Initialize greedy search:
+   csr_graph csr(this);
+   vector<double> distances;
+   vector<int> predecessor_indices;
+   csr.compute_Dijkstra_distances(
+      csr.get_node_index(initial_node_ptr->get_ID()),distances,
+      predecessor_indices);
 
-   node* current_node_ptr=NULL;
    for (unsigned int n=0; n<get_n_nodes(); n++)
    {
       node* curr_node_ptr=get_ordered_node_ptr(n);
-      if (curr_node_ptr->get_ID()==initial_node_ptr->get_ID())
+      if (distances[n] < POSITIVEINFINITY)
       {
-         curr_node_ptr->set_distance_from_start(0);
-         curr_node_ptr->set_visited_status(node::current);
-         current_node_ptr=curr_node_ptr;
+         curr_node_ptr->set_distance_from_start(distances[n]);
+         curr_node_ptr->set_visited_status(node::visited);
       }
       else
       {
          curr_node_ptr->set_distance_from_start(POSITIVEINFINITY);
          curr_node_ptr->set_visited_status(node::unvisited);
       }
-   } // loop over index n labeling nodes
 
-   unsigned int n_visited_nodes=0;
-   while (n_visited_nodes < get_n_nodes() && current_node_ptr != NULL)
-   {
-      if (n_visited_nodes%1000==0) cout << n_visited_nodes/1000 << " "
-                                        << flush;
-      compute_neighbor_node_distances_from_start(current_node_ptr);
-      n_visited_nodes++;
-      current_node_ptr=next_node_to_visit();
-   } // while loop over unvisited nodes
-   cout << endl;
+      node* predecessor_node_ptr=NULL;
+      if (predecessor_indices[n] >= 0)
+         predecessor_node_ptr=get_ordered_node_ptr(predecessor_indices[n]);
+      curr_node_ptr->set_path_predecessor_ptr(predecessor_node_ptr);
+   } // loop over index n labeling nodes
 
    cout << "at end of graph::compute_Dijkstra_edge_weights()" << endl;
 }
@@ -3167,54 +3220,40 @@ node* graph::next_node_to_visit()
 
 // ---------------------------------------------------------------------
 // Member function node_separation_degree() takes in the ID for some
-// starting node within a connected graph.  It first forms a new
-// adjacency matrix whose binary entries equal 1 to indicate edge
-// connectivity between neighboring nodes or 0 otherwise.  It then
-// instantiates a temporary graph based upon the binary adjacency
-// matrix.  After running Dijkstra's algorithm, it returns an STL
-// vector containing integer step distances for each node in the graph
-// from the input initial node.
+// starting node.  It returns an STL vector containing integer step
+// distances from the input initial node for each node in the graph
+// (ordered as via get_ordered_node_ptr).  Nodes which cannot be
+// reached from the initial node are assigned -1 steps.
 
 vector<int> graph::node_separation_degree(int initial_node_ID)
 {
-//   cout << "inside graph::node_separation()" << endl;
-//   cout << "initial_node_ID = " << initial_node_ID << endl;
-
-// Form new adjacency matrix *A_ptr whose binary entries either equal
-// 1 to indicate edge connectivity or 0 otherwise:
-
-   genmatrix* A_ptr=new genmatrix(get_n_nodes(),get_n_nodes());
-   A_ptr->clear_values();
-
-   for (unsigned int r=0; r<get_n_nodes(); r++)
-   {
-      for (unsigned int c=0; c<get_n_nodes(); c++)
-      {
-         if (adjacency_matrix_ptr->get(r,c) > 0)
-         {
-            A_ptr->put(r,c,1);
-         }
-      }
-   }
-//   cout << "*A_ptr = " << *A_ptr << endl;
-  
-   graph g;
-   graph* graph_ptr=g.generate_graph_from_specified_adjacency_matrix(
-      A_ptr);
+   csr_graph csr(this);
+   vector<int> separation_degree_from_start;
+   csr.compute_BFS_hops(
+      csr.get_node_index(initial_node_ID),separation_degree_from_start);
+   return separation_degree_from_start;
+}
 
-   node* start_node_ptr=graph_ptr->get_node_ptr(initial_node_ID);
-   graph_ptr->compute_Dijkstra_edge_weights(start_node_ptr);
+// ---------------------------------------------------------------------
+// This overloaded version of node_separation_degree() returns step
+// distances from each of the input initial nodes.  Breadth-first
+// searches from up to 64 initial nodes are advanced together within a
+// single sweep over the graph's edges.
 
-   vector<int> separation_degree_from_start;
-   for (unsigned int n=0; n<graph_ptr->get_n_nodes(); n++)
+vector<vector<int> > graph::node_separation_degree(
+   const vector<int>& initial_node_IDs)
+{
+   csr_graph csr(this);
+   vector<int> source_indices;
+   for (unsigned int i=0; i<initial_node_IDs.size(); i++)
    {
-      node* curr_node_ptr=graph_ptr->get_ordered_node_ptr(n);
-      separation_degree_from_start.push_back(
-         curr_node_ptr->get_distance_from_start());
+      source_indices.push_back(csr.get_node_index(initial_node_IDs[i]));
    }
 
-   delete graph_ptr;
-   return separation_degree_from_start;
+   vector<vector<int> > separation_degrees_from_start;
+   csr.compute_multi_source_BFS_hops(
+      source_indices,separation_degrees_from_start);
+   return separation_degrees_from_start;
 }
 
 // ---------------------------------------------------------------------
@@ -3264,20 +3303,26 @@ genmatrix* graph::girvan_newman_dendogram()
          curr_adjacency_matrix_ptr);
       graph_ptr->compute_node_centralities();
 
+      vector<int> initial_node_IDs;
+      for (unsigned int c=0; c<dendogram_ptr->get_ndim(); c++)
+      {
+         initial_node_IDs.push_back(get_ordered_node_ptr(c)->get_ID());
+      }
+      vector<vector<int> > separation_degrees_from_start=
+         graph_ptr->node_separation_degree(initial_node_IDs);
+
       int subgroup_ID=0;
       for (unsigned int c=0; c<dendogram_ptr->get_ndim(); c++)
       {
 //         cout << "c = " << c 
 //              << " subgroup_ID = " << subgroup_ID << endl;
-         node* curr_node_ptr=get_ordered_node_ptr(c);
-         vector<int> separation_degree_from_start=
-            graph_ptr->node_separation_degree(curr_node_ptr->get_ID());
+         const vector<int>& separation_degree_from_start=
+            separation_degrees_from_start[c];
 //         cout << "separation_degree_from_start = " << endl;
 //         templatefunc::printVector(separation_degree_from_start);
          for (unsigned int i=0; i<separation_degree_from_start.size(); i++)
          {
-            double curr_separation_degree=separation_degree_from_start[i];
-            if (curr_separation_degree > 0.5*POSITIVEINFINITY) continue;
+            if (separation_degree_from_start[i] < 0) continue;
             if (dendogram_ptr->get(r,i) < 0)
             {
                dendogram_ptr->put(r,i,subgroup_ID);
@@ -3453,52 +3498,42 @@ graph_edge* graph::edge_with_minimal_centrality()
 }
 
 // ---------------------------------------------------------------------
-// Member function compute_node_centralities() exports the current
-// graph's adjacency matrix as an edge list.  It then calls the Markov
-// Cluster Library (see http://micans.org/mcl ) which computes the
-// graph nodes' centralities (ignoring edge weights).  
+// Member function compute_node_centralities() computes the graph
+// nodes' betweenness centralities (ignoring edge weights).  It
+// formerly exported an edge list and ran the Markov Cluster Library's
+// mcx ctty (see http://micans.org/mcl ) whose output was then parsed.
+// The same unweighted betweenness is now calculated in-process.
 
 void graph::compute_node_centralities()
 {
    cout << "inside graph::compute_node_centralities()" << endl;
+   bool weighted_flag=false;
+   compute_betweenness_centralities(weighted_flag);
+}
 
-   string tmp_edgelist_filename="./tmp_edgelist.dat";
-   double edgeweight_threshold=0;
-   export_edgelist(tmp_edgelist_filename,edgeweight_threshold);
-
-// Calculate parents graph nodes' centrality using MCL algorithm:
-
-   string tmp_centrality_filename=".//tmp_centrality.dat";
-   string unix_cmd="mcx ctty -abc "+tmp_edgelist_filename
-      +" > "+tmp_centrality_filename;
-//   cout << "unix_cmd = " << unix_cmd << endl;
-   sysfunc::unix_command(unix_cmd);
+// ---------------------------------------------------------------------
+// Member function compute_betweenness_centralities() runs Brandes'
+// algorithm upon a compressed-sparse-row snapshot of the current
+// graph.  Sources are distributed across n_threads threads (all
+// available cores if n_threads <= 0).  If weighted_flag==true, path
+// lengths equal summed edge weights rather than numbers of edges.
+// Resulting betweenness values are assigned to every node and edge.
 
-// Sort centrality results based upon parent graph node IDs:
+void graph::compute_betweenness_centralities(bool weighted_flag,int n_threads)
+{
+   csr_graph csr(this);
+   vector<double> node_centralities,edge_centralities;
+   csr.compute_betweenness_centralities(
+      weighted_flag,n_threads,node_centralities,edge_centralities);
 
-   filefunc::ReadInfile(tmp_centrality_filename);
-   vector<int> node_ID;
-   vector<double> centrality;
-   for (unsigned int n=0; n<filefunc::text_line.size(); n++)
+   for (unsigned int n=0; n<csr.get_n_nodes(); n++)
    {
-      vector<double> substrings=stringfunc::string_to_numbers(
-         filefunc::text_line[n]);
-      node_ID.push_back(substrings[0]);
-      centrality.push_back(substrings[1]);
-      node* node_ptr=get_node_ptr(node_ID.back());
-      node_ptr->set_centrality(centrality.back());
-   } // loop over index n labeling lines in centrality file
-
-   unix_cmd="rm "+tmp_edgelist_filename;
-   sysfunc::unix_command(unix_cmd);
-   unix_cmd="rm "+tmp_centrality_filename;
-   sysfunc::unix_command(unix_cmd);
-   
-   templatefunc::Quicksort(node_ID,centrality);
-   for (unsigned int n=0; n<node_ID.size(); n++)
+      get_ordered_node_ptr(n)->set_centrality(node_centralities[n]);
+   }
+   for (unsigned int e=0; e<csr.get_n_edges(); e++)
    {
-      cout << "node ID = " << node_ID[n]
-           << " centrality = " << centrality[n] << endl;
+      get_graph_edge_ptr(csr.get_edge_ID(e))->set_centrality(
+         edge_centralities[e]);
    }
 }
 
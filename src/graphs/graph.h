@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for graph class
 // ==========================================================================
-// Last modified on 7/22/13; 4/3/14; 4/5/14; 8/20/16
+// Last modified on 7/22/13; 4/3/14; 4/5/14; 8/20/16; 10/18/26
 // ==========================================================================
 
 #ifndef GRAPH_H
@@ -138,6 +138,8 @@ class graph
       genmatrix* adjacency_matrix_ptr,std::string edgelist_filename,
       double edgeweight_threshold);
    void read_nodes_layout(std::string layout_filename);
+   void read_nodes_layout(
+      std::string layout_filename,std::vector<int>& unplaced_node_IDs);
    void read_cluster_info(std::string cluster_filename);
    void read_cluster_info(std::string cluster_filename,int min_parent_ID);
    void export_cluster_info(std::string output_cluster_filename);
@@ -178,6 +180,10 @@ class graph
       double median_separation_distance,double min_separation_frac);
    void redistribute_nodes_in_angle();
    void sink_heavy_degree_nodes(double median_radius,double median_degree);
+   void compute_Barnes_Hut_layout(unsigned int n_iters=300,int n_threads=0);
+   void compute_incremental_layout(
+      const std::vector<int>& new_node_IDs,unsigned int n_iters=50,
+      int n_threads=0);
 
 // Graph parent/child member functions:
 
@@ -206,6 +212,8 @@ class graph
    node* next_node_to_visit();
 
    std::vector<int> node_separation_degree(int initial_node_ID);
+   std::vector<std::vector<int> > node_separation_degree(
+      const std::vector<int>& initial_node_IDs);
    genmatrix* girvan_newman_dendogram();
    std::vector<int> compute_Astar_path(int start_node_ID,int stop_node_ID);
 
@@ -214,6 +222,8 @@ class graph
    void read_node_centrality_info(std::string centrality_filename);   
    graph_edge* edge_with_minimal_centrality();
    void compute_node_centralities();
+   void compute_betweenness_centralities(
+      bool weighted_flag=false,int n_threads=0);
 
 // SQL output member functions:
 
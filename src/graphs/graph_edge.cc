@@ -1,7 +1,7 @@
 // =========================================================================
 // Graph_Edge class member function definitions
 // =========================================================================
-// Last modified on 2/14/10; 5/29/10; 2/16/11
+// Last modified on 2/14/10; 5/29/10; 2/16/11; 10/18/26
 // =========================================================================
 
 #include <iostream>
@@ -24,6 +24,7 @@ void graph_edge::initialize_member_objects()
 {
    directed_flag=false;
    weight=relative_size=1;
+   centrality=-1;
 
 // Assign default grey coloring to graph edge:
 
@@ -121,12 +122,15 @@ const node* graph_edge::get_node2_ptr() const
    return node2_ptr;
 }
 
-// Member function get_centrality() implements a poor-man's
-// edge-centrality which we simply set equal to the summed
-// centralities of *node1_ptr and *node2_ptr.  
+// Member function get_centrality() returns the edge betweenness
+// centrality assigned via set_centrality().  If no such value has
+// been set, it implements a poor-man's edge-centrality which we
+// simply set equal to the summed centralities of *node1_ptr and
+// *node2_ptr.
 
 double graph_edge::get_centrality() const
 {
+   if (centrality >= 0) return centrality;
    return node1_ptr->get_centrality() + node2_ptr->get_centrality();
 }
 
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for graph_edge class
 // ==========================================================================
-// Last modified on 5/29/10; 2/16/11; 7/28/11
+// Last modified on 5/29/10; 2/16/11; 7/28/11; 10/18/26
 // ==========================================================================
 
 #ifndef GRAPH_EDGE_H
@@ -44,6 +44,7 @@ class graph_edge
    node* get_node2_ptr();
    const node* get_node2_ptr() const;
 
+   void set_centrality(double c);
    double get_centrality() const;
 
   private: 
@@ -124,5 +125,10 @@ inline colorfunc::RGB graph_edge::get_edge_RGB() const
    return edge_RGB;
 }
 
+inline void graph_edge::set_centrality(double c)
+{
+   centrality=c;
+}
+
 
 #endif  // graph_edge.h
@@ -1,7 +1,7 @@
 // =========================================================================
 // Graph_Hierarchy class member function definitions
 // =========================================================================
-// Last modified on 12/30/12; 5/26/13; 7/22/13; 4/5/14
+// Last modified on 12/30/12; 5/26/13; 7/22/13; 4/5/14; 10/18/26
 // =========================================================================
 
 #include <algorithm>
@@ -887,7 +887,28 @@ void graph_hierarchy::build_hierarchy(
       base_graph_layout_filename=modified_base_graph_layout_filename;
    }
    
-   child_graph_ptr->read_nodes_layout(base_graph_layout_filename);
+// If no layout has yet been generated for the level-0 graph, compute
+// one via Barnes-Hut force-directed iterations.  Otherwise, just lay
+// out nodes which were added since the layout file was written:
+
+   if (filefunc::fileexist(base_graph_layout_filename))
+   {
+      vector<int> unplaced_node_IDs;
+      child_graph_ptr->read_nodes_layout(
+         base_graph_layout_filename,unplaced_node_IDs);
+      if (unplaced_node_IDs.size() > 0)
+      {
+         cout << "Incrementally laying out " << unplaced_node_IDs.size()
+              << " new nodes" << endl;
+         child_graph_ptr->compute_incremental_layout(unplaced_node_IDs);
+      }
+   }
+   else
+   {
+      cout << "Computing Barnes-Hut layout for "
+           << child_graph_ptr->get_n_nodes() << " nodes" << endl;
+      child_graph_ptr->compute_Barnes_Hut_layout();
+   }
 
 // Loop over parent graphs starts here:
 
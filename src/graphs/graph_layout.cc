@@ -0,0 +1,614 @@
+// ==========================================================================
+// GRAPH_LAYOUT class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "graphs/csr_graph.h"
+#include "graphs/graph.h"
+#include "graphs/graph_layout.h"
+#include "graphs/node.h"
+#include "math/constants.h"
+#include "numrec/nrfuncs.h"
+#include "math/twovector.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using std::cout;
+using std::endl;
+using std::ostream;
+using std::vector;
+
+// Quadtree cells are split until they hold a single body or reach the
+// following depth (which only occurs for nearly coincident nodes):
+
+namespace
+{
+   const int max_quadtree_depth=32;
+}
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void graph_layout::allocate_member_objects()
+{
+   csr_graph_ptr=new csr_graph(graph_ptr);
+}
+
+void graph_layout::initialize_member_objects()
+{
+   n_threads=0;
+   theta=0.6;
+   natural_length=-1;
+}
+
+graph_layout::graph_layout(graph* graph_ptr)
+{
+   this->graph_ptr=graph_ptr;
+   allocate_member_objects();
+   initialize_member_objects();
+   import_node_posns();
+}
+
+graph_layout::~graph_layout()
+{
+   delete csr_graph_ptr;
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const graph_layout& L)
+{
+   outstream << endl;
+   outstream << "n_nodes = " << L.U.size()
+             << " natural_length = " << L.natural_length
+             << " theta = " << L.theta << endl;
+   return outstream;
+}
+
+// ---------------------------------------------------------------------
+// Private member function import_node_posns copies node positions and
+// relative sizes from *graph_ptr into flat arrays.  Relative sizes
+// act as masses within repulsive force calculations.
+
+void graph_layout::import_node_posns()
+{
+   unsigned int n_nodes=csr_graph_ptr->get_n_nodes();
+   U.resize(n_nodes);
+   V.resize(n_nodes);
+   masses.resize(n_nodes);
+   movable_flags.assign(n_nodes,true);
+   for (unsigned int p=0; p<n_nodes; p++)
+   {
+      const node* curr_node_ptr=graph_ptr->get_ordered_node_ptr(p);
+      U[p]=curr_node_ptr->get_Uposn();
+      V[p]=curr_node_ptr->get_Vposn();
+      masses[p]=curr_node_ptr->get_relative_size();
+      if (masses[p] <= 0) masses[p]=1;
+   }
+
+   double weight_sum=0;
+   for (unsigned int a=0; a<csr_graph_ptr->get_n_arcs(); a++)
+   {
+      weight_sum += csr_graph_ptr->get_arc_weight(a);
+   }
+   mean_edge_weight=1;
+   if (weight_sum > 0) mean_edge_weight=weight_sum/
+                          csr_graph_ptr->get_n_arcs();
+}
+
+// ---------------------------------------------------------------------
+// Member function export_node_posns writes laid out positions back
+// into *graph_ptr's nodes.
+
+void graph_layout::export_node_posns()
+{
+   for (unsigned int p=0; p<U.size(); p++)
+   {
+      node* curr_node_ptr=graph_ptr->get_ordered_node_ptr(p);
+      curr_node_ptr->set_posn(twovector(U[p],V[p]));
+   }
+}
+
+// ---------------------------------------------------------------------
+// Private member function estimate_natural_length sets the ideal
+// edge length (if it has not already been specified) equal to the
+// median length of edges joining fixed nodes.  If no such edges
+// exist, the fixed nodes' bounding box area is divided evenly among
+// them.  If the fixed nodes occupy no area, the natural length is set
+// to unity.
+
+void graph_layout::estimate_natural_length()
+{
+   if (natural_length > 0) return;
+
+   vector<double> edge_lengths;
+   double Umin=POSITIVEINFINITY,Umax=NEGATIVEINFINITY;
+   double Vmin=POSITIVEINFINITY,Vmax=NEGATIVEINFINITY;
+   unsigned int n_fixed_nodes=0;
+   for (unsigned int p=0; p<U.size(); p++)
+   {
+      if (movable_flags[p]) continue;
+      n_fixed_nodes++;
+      Umin=std::min(Umin,U[p]);
+      Umax=std::max(Umax,U[p]);
+      Vmin=std::min(Vmin,V[p]);
+      Vmax=std::max(Vmax,V[p]);
+
+      for (unsigned int a=csr_graph_ptr->get_row_offset(p);
+           a<csr_graph_ptr->get_row_offset(p+1); a++)
+      {
+         int q=csr_graph_ptr->get_neighbor_index(a);
+         if (int(p) > q || movable_flags[q]) continue;
+         edge_lengths.push_back(sqrt(
+            (U[q]-U[p])*(U[q]-U[p])+(V[q]-V[p])*(V[q]-V[p])));
+      }
+   } // loop over index p labeling nodes
+
+   if (edge_lengths.size() > 0)
+   {
+      std::nth_element(
+         edge_lengths.begin(),edge_lengths.begin()+edge_lengths.size()/2,
+         edge_lengths.end());
+      natural_length=edge_lengths[edge_lengths.size()/2];
+   }
+   if (natural_length <= 0 && n_fixed_nodes > 1)
+   {
+      natural_length=sqrt((Umax-Umin)*(Vmax-Vmin)/n_fixed_nodes);
+   }
+   if (natural_length <= 0) natural_length=1;
+}
+
+// ---------------------------------------------------------------------
+// Private member function place_new_node assigns node p an initial
+// position at the centroid of its already placed neighbors jittered
+// by a fraction of the natural length.
+
+void graph_layout::place_new_node(int p,const vector<bool>& placed_flags)
+{
+   double U_sum=0,V_sum=0;
+   int n_placed_neighbors=0;
+   for (unsigned int a=csr_graph_ptr->get_row_offset(p);
+        a<csr_graph_ptr->get_row_offset(p+1); a++)
+   {
+      int q=csr_graph_ptr->get_neighbor_index(a);
+      if (!placed_flags[q]) continue;
+      U_sum += U[q];
+      V_sum += V[q];
+      n_placed_neighbors++;
+   }
+
+   double jitter=0.1*natural_length;
+   U[p]=U_sum/n_placed_neighbors+jitter*(2*nrfunc::ran1()-1);
+   V[p]=V_sum/n_placed_neighbors+jitter*(2*nrfunc::ran1()-1);
+}
+
+// ==========================================================================
+// Quadtree member functions
+// ==========================================================================
+
+// Member function build_quadtree recursively partitions the input
+// bodies (node indices) into a quadtree whose root cell is the
+// smallest square enclosing all bodies.
+
+void graph_layout::build_quadtree(const vector<int>& bodies,quadtree& tree)
+   const
+{
+   tree.body_indices=bodies;
+   tree.cells.clear();
+   if (bodies.size()==0) return;
+
+   double Umin=U[bodies[0]],Umax=Umin,Vmin=V[bodies[0]],Vmax=Vmin;
+   for (unsigned int i=1; i<bodies.size(); i++)
+   {
+      Umin=std::min(Umin,U[bodies[i]]);
+      Umax=std::max(Umax,U[bodies[i]]);
+      Vmin=std::min(Vmin,V[bodies[i]]);
+      Vmax=std::max(Vmax,V[bodies[i]]);
+   }
+   double size=std::max(Umax-Umin,Vmax-Vmin);
+   if (size <= 0) size=natural_length;
+
+   tree.cells.reserve(2*bodies.size());
+   build_quadtree_cell(tree,0,bodies.size(),Umin,Vmin,size,0);
+}
+
+// ---------------------------------------------------------------------
+// Private member function build_quadtree_cell appends a cell for
+// tree.body_indices[first_body, first_body+n_bodies) lying within the
+// square whose lower left corner is (Umin,Vmin).  Bodies are
+// reordered in place so that each child cell's bodies are contiguous.
+// This method returns the new cell's index.
+
+int graph_layout::build_quadtree_cell(
+   quadtree& tree,int first_body,int n_bodies,
+   double Umin,double Vmin,double size,int depth) const
+{
+   quadtree_cell cell;
+   cell.mass=cell.COM_U=cell.COM_V=0;
+   cell.size=size;
+   cell.first_body=first_body;
+   cell.n_bodies=n_bodies;
+   for (int c=0; c<4; c++)
+   {
+      cell.child_indices[c]=-1;
+   }
+
+   vector<int>::iterator begin_iter=tree.body_indices.begin()+first_body;
+   vector<int>::iterator end_iter=begin_iter+n_bodies;
+   for (vector<int>::iterator iter=begin_iter; iter != end_iter; ++iter)
+   {
+      cell.mass += masses[*iter];
+      cell.COM_U += masses[*iter]*U[*iter];
+      cell.COM_V += masses[*iter]*V[*iter];
+   }
+   cell.COM_U /= cell.mass;
+   cell.COM_V /= cell.mass;
+
+   int cell_index=tree.cells.size();
+   tree.cells.push_back(cell);
+   if (n_bodies <= 1 || depth >= max_quadtree_depth) return cell_index;
+
+// Partition bodies into lower left, lower right, upper left and upper
+// right quadrants:
+
+   double half_size=0.5*size;
+   double Umid=Umin+half_size;
+   double Vmid=Vmin+half_size;
+
+   struct U_less_than
+   {
+         const vector<double>* U_ptr;
+         double Umid;
+         bool operator() (int p) const
+         {
+            return (*U_ptr)[p] < Umid;
+         }
+   } left_of_Umid;
+   left_of_Umid.U_ptr=&U;
+   left_of_Umid.Umid=Umid;
+
+   struct V_less_than
+   {
+         const vector<double>* V_ptr;
+         double Vmid;
+         bool operator() (int p) const
+         {
+            return (*V_ptr)[p] < Vmid;
+         }
+   } below_Vmid;
+   below_Vmid.V_ptr=&V;
+   below_Vmid.Vmid=Vmid;
+
+   vector<int>::iterator Usplit_iter=std::partition(
+      begin_iter,end_iter,left_of_Umid);
+   vector<int>::iterator quadrant_iters[5];
+   quadrant_iters[0]=begin_iter;
+   quadrant_iters[1]=std::partition(begin_iter,Usplit_iter,below_Vmid);
+   quadrant_iters[2]=Usplit_iter;
+   quadrant_iters[3]=std::partition(Usplit_iter,end_iter,below_Vmid);
+   quadrant_iters[4]=end_iter;
+
+// Quadrant order within quadrant_iters is (left,lower), (left,upper),
+// (right,lower), (right,upper):
+
+   const double quadrant_Umin[4]={Umin,Umin,Umid,Umid};
+   const double quadrant_Vmin[4]={Vmin,Vmid,Vmin,Vmid};
+   for (int c=0; c<4; c++)
+   {
+      int n_quadrant_bodies=quadrant_iters[c+1]-quadrant_iters[c];
+      if (n_quadrant_bodies==0) continue;
+      int child_index=build_quadtree_cell(
+         tree,quadrant_iters[c]-tree.body_indices.begin(),
+         n_quadrant_bodies,quadrant_Umin[c],quadrant_Vmin[c],half_size,
+         depth+1);
+      tree.cells[cell_index].child_indices[c]=child_index;
+   }
+   return cell_index;
+}
+
+// ==========================================================================
+// Force member functions
+// ==========================================================================
+
+// Member function accumulate_repulsive_force adds the repulsion upon
+// node p from every body within the input quadtree.  A body of mass m
+// at distance d repels with Fruchterman-Reingold magnitude k**2 m / d.
+// Cells which appear smaller than theta radians from node p are
+// treated as single bodies located at their centers of mass.
+
+void graph_layout::accumulate_repulsive_force(
+   const quadtree& tree,int p,double& force_U,double& force_V) const
+{
+   if (tree.cells.size()==0) return;
+
+   const double k_sqr=natural_length*natural_length;
+   const double theta_sqr=theta*theta;
+   const double min_dist_sqr=1E-6*k_sqr;
+
+   int cell_stack[4*max_quadtree_depth+4];
+   int n_stack=0;
+   cell_stack[n_stack++]=0;
+   while (n_stack > 0)
+   {
+      const quadtree_cell& cell=tree.cells[cell_stack[--n_stack]];
+      double dU=U[p]-cell.COM_U;
+      double dV=V[p]-cell.COM_V;
+      double dist_sqr=dU*dU+dV*dV;
+
+      bool leaf_flag=(cell.child_indices[0] < 0 && cell.child_indices[1] < 0
+                      && cell.child_indices[2] < 0 &&
+                      cell.child_indices[3] < 0);
+      if (!leaf_flag && cell.size*cell.size < theta_sqr*dist_sqr)
+      {
+         double coeff=k_sqr*cell.mass/dist_sqr;
+         force_U += coeff*dU;
+         force_V += coeff*dV;
+      }
+      else if (leaf_flag)
+      {
+         for (int b=cell.first_body; b<cell.first_body+cell.n_bodies; b++)
+         {
+            int q=tree.body_indices[b];
+            if (q==p) continue;
+            dU=U[p]-U[q];
+            dV=V[p]-V[q];
+            dist_sqr=dU*dU+dV*dV;
+
+// Separate coincident nodes along a direction which depends upon
+// their indices:
+
+            if (dist_sqr < min_dist_sqr)
+            {
+               dU=1E-3*natural_length*cos(double(p-q));
+               dV=1E-3*natural_length*sin(double(p-q));
+               dist_sqr=dU*dU+dV*dV;
+            }
+            double coeff=k_sqr*masses[q]/dist_sqr;
+            force_U += coeff*dU;
+            force_V += coeff*dV;
+         }
+      }
+      else
+      {
+         for (int c=0; c<4; c++)
+         {
+            if (cell.child_indices[c] >= 0)
+               cell_stack[n_stack++]=cell.child_indices[c];
+         }
+      }
+   } // while cell_stack is nonempty
+}
+
+// ---------------------------------------------------------------------
+// Member function accumulate_attractive_force adds the spring forces
+// pulling node p towards its neighbors.  An edge of length d attracts
+// with Fruchterman-Reingold magnitude d**2 / k scaled by the edge's
+// weight relative to the mean edge weight.
+
+void graph_layout::accumulate_attractive_force(
+   int p,double& force_U,double& force_V) const
+{
+   for (unsigned int a=csr_graph_ptr->get_row_offset(p);
+        a<csr_graph_ptr->get_row_offset(p+1); a++)
+   {
+      int q=csr_graph_ptr->get_neighbor_index(a);
+      double dU=U[q]-U[p];
+      double dV=V[q]-V[p];
+      double dist=sqrt(dU*dU+dV*dV);
+      double coeff=csr_graph_ptr->get_arc_weight(a)/mean_edge_weight*
+         dist/natural_length;
+      force_U += coeff*dU;
+      force_V += coeff*dV;
+   }
+}
+
+// ---------------------------------------------------------------------
+// Private member function iterate_layout moves every node within
+// movable_nodes along its net force.  Displacements are limited to
+// the current temperature.  Fixed nodes repel via fixed_tree, while
+// movable nodes repel one another via a quadtree rebuilt for each
+// iteration.  All displacements are computed from the same node
+// positions before any are applied.
+
+void graph_layout::iterate_layout(
+   const vector<int>& movable_nodes,const quadtree& fixed_tree,
+   double temperature)
+{
+   quadtree movable_tree;
+   build_quadtree(movable_nodes,movable_tree);
+
+   int n_movable=movable_nodes.size();
+   vector<double> dU(n_movable),dV(n_movable);
+
+#pragma omp parallel for schedule(dynamic,256) num_threads(n_threads)
+   for (int i=0; i<n_movable; i++)
+   {
+      int p=movable_nodes[i];
+      double force_U=0,force_V=0;
+      accumulate_repulsive_force(fixed_tree,p,force_U,force_V);
+      accumulate_repulsive_force(movable_tree,p,force_U,force_V);
+      accumulate_attractive_force(p,force_U,force_V);
+
+      double force=sqrt(force_U*force_U+force_V*force_V);
+      double scale=(force > temperature) ? temperature/force : 1;
+      dU[i]=scale*force_U;
+      dV[i]=scale*force_V;
+   } // loop over index i labeling movable nodes
+
+   for (int i=0; i<n_movable; i++)
+   {
+      U[movable_nodes[i]] += dU[i];
+      V[movable_nodes[i]] += dV[i];
+   }
+}
+
+// ==========================================================================
+// Layout member functions
+// ==========================================================================
+
+// Member function compute_layout moves every node over n_iters
+// iterations whose temperature cools linearly.  If all nodes
+// initially coincide, they are first scattered randomly across a
+// square whose area equals n_nodes natural lengths squared.
+
+void graph_layout::compute_layout(unsigned int n_iters)
+{
+   unsigned int n_nodes=U.size();
+   if (n_nodes==0) return;
+
+#ifdef _OPENMP
+   if (n_threads <= 0) n_threads=omp_get_max_threads();
+#else
+   n_threads=1;
+#endif
+
+   movable_flags.assign(n_nodes,false);
+   estimate_natural_length();
+   movable_flags.assign(n_nodes,true);
+
+   double Umin=*std::min_element(U.begin(),U.end());
+   double Umax=*std::max_element(U.begin(),U.end());
+   double Vmin=*std::min_element(V.begin(),V.end());
+   double Vmax=*std::max_element(V.begin(),V.end());
+   double width=sqrt(double(n_nodes))*natural_length;
+   if (Umax-Umin <= 0 && Vmax-Vmin <= 0)
+   {
+      for (unsigned int p=0; p<n_nodes; p++)
+      {
+         U[p]=width*nrfunc::ran1();
+         V[p]=width*nrfunc::ran1();
+      }
+   }
+
+   vector<int> movable_nodes(n_nodes);
+   for (unsigned int p=0; p<n_nodes; p++)
+   {
+      movable_nodes[p]=p;
+   }
+
+   quadtree fixed_tree;
+   double initial_temperature=0.1*width;
+   for (unsigned int iter=0; iter<n_iters; iter++)
+   {
+      double temperature=initial_temperature*(n_iters-iter)/n_iters;
+      iterate_layout(movable_nodes,fixed_tree,temperature);
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_incremental_layout lays out just the input
+// new nodes while all other nodes retain their current positions.
+// New nodes are first placed near their already positioned neighbors
+// in breadth-first order.  New nodes with no path to an existing node
+// are scattered about the graph's center.  Iterations then start at a
+// temperature of one natural length and cool linearly.
+
+void graph_layout::compute_incremental_layout(
+   const vector<int>& new_node_IDs,unsigned int n_iters)
+{
+   unsigned int n_nodes=U.size();
+
+#ifdef _OPENMP
+   if (n_threads <= 0) n_threads=omp_get_max_threads();
+#else
+   n_threads=1;
+#endif
+
+   movable_flags.assign(n_nodes,false);
+   vector<int> movable_nodes;
+   for (unsigned int i=0; i<new_node_IDs.size(); i++)
+   {
+      int p=csr_graph_ptr->get_node_index(new_node_IDs[i]);
+      if (p < 0 || movable_flags[p]) continue;
+      movable_flags[p]=true;
+      movable_nodes.push_back(p);
+   }
+   if (movable_nodes.size()==0) return;
+
+   estimate_natural_length();
+
+   vector<int> fixed_nodes;
+   double U_sum=0,V_sum=0;
+   for (unsigned int p=0; p<n_nodes; p++)
+   {
+      if (movable_flags[p]) continue;
+      fixed_nodes.push_back(p);
+      U_sum += U[p];
+      V_sum += V[p];
+   }
+   double U_center=0,V_center=0;
+   if (fixed_nodes.size() > 0)
+   {
+      U_center=U_sum/fixed_nodes.size();
+      V_center=V_sum/fixed_nodes.size();
+   }
+
+// Place new nodes adjacent to already placed nodes:
+
+   vector<bool> placed_flags(n_nodes);
+   for (unsigned int p=0; p<n_nodes; p++)
+   {
+      placed_flags[p]=!movable_flags[p];
+   }
+
+   vector<int> unplaced_nodes(movable_nodes);
+   bool progress_flag=true;
+   while (progress_flag && unplaced_nodes.size() > 0)
+   {
+      progress_flag=false;
+      vector<int> newly_placed_nodes,still_unplaced_nodes;
+      for (unsigned int i=0; i<unplaced_nodes.size(); i++)
+      {
+         int p=unplaced_nodes[i];
+         bool placed_neighbor_flag=false;
+         for (unsigned int a=csr_graph_ptr->get_row_offset(p);
+              a<csr_graph_ptr->get_row_offset(p+1) && !placed_neighbor_flag;
+              a++)
+         {
+            placed_neighbor_flag=
+               placed_flags[csr_graph_ptr->get_neighbor_index(a)];
+         }
+         if (placed_neighbor_flag)
+         {
+            place_new_node(p,placed_flags);
+            newly_placed_nodes.push_back(p);
+         }
+         else
+         {
+            still_unplaced_nodes.push_back(p);
+         }
+      } // loop over index i labeling unplaced nodes
+
+      for (unsigned int i=0; i<newly_placed_nodes.size(); i++)
+      {
+         placed_flags[newly_placed_nodes[i]]=true;
+      }
+      progress_flag=(newly_placed_nodes.size() > 0);
+      unplaced_nodes=still_unplaced_nodes;
+   } // while loop
+
+   double scatter_radius=sqrt(double(n_nodes))*natural_length;
+   for (unsigned int i=0; i<unplaced_nodes.size(); i++)
+   {
+      int p=unplaced_nodes[i];
+      U[p]=U_center+scatter_radius*(2*nrfunc::ran1()-1);
+      V[p]=V_center+scatter_radius*(2*nrfunc::ran1()-1);
+   }
+
+   quadtree fixed_tree;
+   build_quadtree(fixed_nodes,fixed_tree);
+
+   for (unsigned int iter=0; iter<n_iters; iter++)
+   {
+      double temperature=natural_length*(n_iters-iter)/n_iters;
+      iterate_layout(movable_nodes,fixed_tree,temperature);
+   }
+}
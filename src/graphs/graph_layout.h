@@ -0,0 +1,130 @@
+// ==========================================================================
+// Header file for GRAPH_LAYOUT class which computes force-directed
+// (Fruchterman-Reingold) node positions for large graphs.  Attractive
+// spring forces act along edges, while every pair of nodes repels.
+// Rather than summing repulsions over all node pairs, distant groups
+// of nodes are replaced by their centers of mass within a Barnes-Hut
+// quadtree.  So each iteration costs O(n log n) rather than O(n**2).
+// Forces upon different nodes are accumulated in parallel.
+
+// In incremental mode, only newly inserted nodes move.  Previously
+// laid out nodes are held fixed, and their quadtree is built just
+// once.  So appending a few images to a large graph requires far less
+// work than regenerating its entire layout.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef GRAPH_LAYOUT_H
+#define GRAPH_LAYOUT_H
+
+#include <iostream>
+#include <vector>
+
+class csr_graph;
+class graph;
+
+class graph_layout
+{
+
+  public:
+
+   graph_layout(graph* graph_ptr);
+   ~graph_layout();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const graph_layout& L);
+
+// Set and get member functions:
+
+   void set_n_threads(int n);
+   void set_theta(double t);
+   void set_natural_length(double k);
+   double get_natural_length() const;
+
+// Layout member functions:
+
+   void compute_layout(unsigned int n_iters);
+   void compute_incremental_layout(
+      const std::vector<int>& new_node_IDs,unsigned int n_iters);
+   void export_node_posns();
+
+  private:
+
+   struct quadtree_cell
+   {
+         double mass,COM_U,COM_V,size;
+         int child_indices[4];
+         int first_body,n_bodies;
+   };
+
+   struct quadtree
+   {
+         std::vector<int> body_indices;
+         std::vector<quadtree_cell> cells;
+   };
+
+   int n_threads;
+   double theta,natural_length,mean_edge_weight;
+   graph* graph_ptr;
+   csr_graph* csr_graph_ptr;
+
+// Per-node members indexed by graph order:
+
+   std::vector<double> U,V,masses;
+   std::vector<bool> movable_flags;
+
+   void allocate_member_objects();
+   void initialize_member_objects();
+
+   void import_node_posns();
+   void estimate_natural_length();
+   void place_new_node(int p,const std::vector<bool>& placed_flags);
+
+   void build_quadtree(const std::vector<int>& bodies,quadtree& tree) const;
+   int build_quadtree_cell(
+      quadtree& tree,int first_body,int n_bodies,
+      double Umin,double Vmin,double size,int depth) const;
+   void accumulate_repulsive_force(
+      const quadtree& tree,int p,double& force_U,double& force_V) const;
+   void accumulate_attractive_force(
+      int p,double& force_U,double& force_V) const;
+   void iterate_layout(
+      const std::vector<int>& movable_nodes,const quadtree& fixed_tree,
+      double temperature);
+
+// Disallow copying since graph_layout owns and deletes *csr_graph_ptr:
+
+   graph_layout(const graph_layout& L);
+   graph_layout& operator= (const graph_layout& L);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+// If n <= 0, all available OpenMP threads are used:
+
+inline void graph_layout::set_n_threads(int n)
+{
+   n_threads=n;
+}
+
+// Quadtree cells whose size divided by their distance from a node is
+// less than theta are treated as single bodies:
+
+inline void graph_layout::set_theta(double t)
+{
+   theta=t;
+}
+
+inline void graph_layout::set_natural_length(double k)
+{
+   natural_length=k;
+}
+
+inline double graph_layout::get_natural_length() const
+{
+   return natural_length;
+}
+
+#endif  // graph_layout.h
@@ -1,9 +1,11 @@
 // =========================================================================
 // Vptree class member function definitions
 // =========================================================================
-// Last modified on 3/20/12; 4/29/13; 5/31/13; 4/5/14
+// Last modified on 3/20/12; 4/29/13; 5/31/13; 4/5/14; 10/18/26
 // =========================================================================
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <string>
@@ -13,9 +15,14 @@
 #include "general/stringfuncs.h"
 #include "graphs/vptree.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using std::cout;
 using std::endl;
 using std::flush;
+using std::greater;
 using std::map;
 using std::ostream;
 using std::priority_queue;
@@ -33,6 +40,7 @@ void vptree::allocate_member_objects()
 void vptree::initialize_member_objects()
 {
    hamming_distance_flag=KL_distance_flag=sqrd_Euclidean_distance_flag=false;
+   packed_flag=false;
    search_queue_ptr=NULL;
    store_logarithm_values();
 }		 
@@ -79,17 +87,87 @@ vptree::vptree()
 
 vptree::vptree(const vptree& v)
 {
+   allocate_member_objects();
+   initialize_member_objects();
    docopy(v);
 }
 
 vptree::~vptree()
 {
    delete BinaryTree_ptr;
+   delete search_queue_ptr;
+   delete_owned_packed_elements();
+}
+
+void vptree::delete_owned_packed_elements()
+{
+   for (unsigned int i=0; i<owned_packed_element_ptrs.size(); i++)
+   {
+      delete owned_packed_element_ptrs[i];
+   }
+   owned_packed_element_ptrs.clear();
+   packed_source_map.clear();
 }
 
 // ---------------------------------------------------------------------
+// Member function docopy copies v's search parameters along with its
+// flattened node array.  Since BinaryTree::docopy() does not copy
+// nodes, *BinaryTree_ptr is then rebuilt from the flattened nodes so
+// that BinaryTree traversals as well as batched queries may be
+// performed on copied vptrees.  Packed descriptors owned by v are
+// duplicated, and flattened nodes are redirected to the duplicates.
+// So this vptree never refers to storage which v may later delete.
+
 void vptree::docopy(const vptree& v)
 {
+   hamming_distance_flag=v.hamming_distance_flag;
+   KL_distance_flag=v.KL_distance_flag;
+   sqrd_Euclidean_distance_flag=v.sqrd_Euclidean_distance_flag;
+   packed_flag=v.packed_flag;
+   best_node_ID=v.best_node_ID;
+   tau=v.tau;
+
+   delete_owned_packed_elements();
+   map<packed_descriptor*,packed_descriptor*> packed_copy_map;
+   owned_packed_element_ptrs.reserve(v.owned_packed_element_ptrs.size());
+   for (unsigned int i=0; i<v.owned_packed_element_ptrs.size(); i++)
+   {
+      packed_descriptor* orig_ptr=v.owned_packed_element_ptrs[i];
+      packed_descriptor* copy_ptr=new packed_descriptor(*orig_ptr);
+      owned_packed_element_ptrs.push_back(copy_ptr);
+      packed_copy_map[orig_ptr]=copy_ptr;
+   }
+
+   for (map<packed_descriptor*,descriptor*>::const_iterator iter=
+           v.packed_source_map.begin(); iter != v.packed_source_map.end();
+        iter++)
+   {
+      map<packed_descriptor*,packed_descriptor*>::iterator copy_iter=
+         packed_copy_map.find(iter->first);
+      if (copy_iter != packed_copy_map.end())
+      {
+         packed_source_map[copy_iter->second]=iter->second;
+      }
+   }
+
+   flat_nodes=v.flat_nodes;
+   for (unsigned int n=0; n<flat_nodes.size(); n++)
+   {
+      map<packed_descriptor*,packed_descriptor*>::iterator copy_iter=
+         packed_copy_map.find(flat_nodes[n].packed_element_ptr);
+      if (copy_iter != packed_copy_map.end())
+      {
+         flat_nodes[n].packed_element_ptr=copy_iter->second;
+      }
+   }
+
+   delete BinaryTree_ptr;
+   BinaryTree_ptr=new BTree();
+   if (flat_nodes.size() > 0)
+   {
+      unflatten_subtree(0);
+      BinaryTree_ptr->compute_all_gxgy_coords();
+   }
 }
 
 // Overload = operator:
@@ -116,14 +194,35 @@ ostream& operator<< (ostream& outstream,const vptree& v)
 
 // Member function construct_tree() is a high-level, user-friendly
 // method which generates a vantage point tree from an input set of
-// metric space elements.
+// metric space elements.  If hamming_distance_flag==true, the input
+// descriptors are assumed to contain only 0 or 1 entries.  They are
+// then packed into 64-bit words once up front so that every
+// subsequent node separation is computed via POPCNT rather than
+// element-by-element comparison.
 
 void vptree::construct_tree(const vector<descriptor*>& metric_space_elements)
 {
+   if (hamming_distance_flag)
+   {
+      delete_owned_packed_elements();
+      owned_packed_element_ptrs.reserve(metric_space_elements.size());
+      for (unsigned int i=0; i<metric_space_elements.size(); i++)
+      {
+         packed_descriptor* packed_ptr=
+            new packed_descriptor(metric_space_elements[i]);
+         packed_ptr->set_ID(i);
+         owned_packed_element_ptrs.push_back(packed_ptr);
+         packed_source_map[packed_ptr]=metric_space_elements[i];
+      }
+      construct_tree(owned_packed_element_ptrs);
+      return;
+   }
+
    int prev_used_ID=-1;
    build_vp_tree(0,metric_space_elements,prev_used_ID);
    compute_all_extremal_subspace_distances();
    BinaryTree_ptr->compute_all_gxgy_coords();
+   flatten_tree();
 }
 
 // --------------------------------------------------------------------------
@@ -143,6 +242,22 @@ void vptree::construct_tree(const vector<descriptor_pair>& feature_pairs)
    construct_tree(metric_space_elements);
 }
 
+// --------------------------------------------------------------------------
+// This overloaded version of construct_tree() takes in packed binary
+// descriptors such as FREAK rows or binarized SIFT vectors.  Node
+// separations are measured via Hamming distance.
+
+void vptree::construct_tree(const vector<packed_descriptor*>& packed_elements)
+{
+   hamming_distance_flag=true;
+   packed_flag=true;
+   int prev_used_ID=-1;
+   build_vp_tree(0,packed_elements,prev_used_ID);
+   compute_all_extremal_subspace_distances();
+   BinaryTree_ptr->compute_all_gxgy_coords();
+   flatten_tree();
+}
+
 // --------------------------------------------------------------------------
 vptree::BTreeNode* vptree::build_vp_tree(
    int curr_level,const vector<descriptor*>& metric_space_elements,
@@ -180,6 +295,7 @@ vptree::BTreeNode* vptree::build_vp_tree(
 
    node_payload* node_payload_ptr=new node_payload;
    node_payload_ptr->metric_space_element_ptr=vp_ptr;
+   node_payload_ptr->packed_element_ptr=NULL;
    node_payload_ptr->mu=mu;
    BinaryTreeNode_ptr->set_data(*node_payload_ptr);
 
@@ -266,6 +382,93 @@ vptree::BTreeNode* vptree::build_vp_tree(
    return BinaryTreeNode_ptr;
 }
    
+// --------------------------------------------------------------------------
+// This overloaded version of build_vp_tree() recursively partitions
+// packed binary descriptors.  If a packed element was generated from
+// an input descriptor, the latter is also stored within the node's
+// payload so that descriptor-valued queries can return it.
+
+vptree::BTreeNode* vptree::build_vp_tree(
+   int curr_level,const vector<packed_descriptor*>& packed_elements,
+   int& prev_used_ID)
+{
+   if (packed_elements.size()==0) return NULL;
+
+   BTreeNode* BinaryTreeNode_ptr;
+   if (BinaryTree_ptr->size()==0)
+   {
+      BinaryTreeNode_ptr=BinaryTree_ptr->generate_root_node();
+      prev_used_ID=BinaryTreeNode_ptr->get_ID();
+   }
+   else
+   {
+      BinaryTreeNode_ptr=new BTreeNode;
+      BinaryTreeNode_ptr->set_ID(prev_used_ID+1);
+      BinaryTreeNode_ptr->set_level(curr_level);
+      prev_used_ID++;
+   }
+
+   packed_descriptor* vp_ptr=select_random_vp(packed_elements);
+   double mu=median_separation_distance(vp_ptr,packed_elements);
+
+   node_payload curr_payload;
+   curr_payload.packed_element_ptr=vp_ptr;
+   curr_payload.metric_space_element_ptr=NULL;
+   map<packed_descriptor*,descriptor*>::iterator source_iter=
+      packed_source_map.find(vp_ptr);
+   if (source_iter != packed_source_map.end())
+   {
+      curr_payload.metric_space_element_ptr=source_iter->second;
+   }
+   curr_payload.mu=mu;
+   BinaryTreeNode_ptr->set_data(curr_payload);
+
+   vector<packed_descriptor*> left_packed_elements;
+   vector<packed_descriptor*> right_packed_elements;
+   for (unsigned int i=0; i<packed_elements.size(); i++)
+   {
+      packed_descriptor* curr_element_ptr=packed_elements[i];
+      if (curr_element_ptr==vp_ptr) continue;
+         
+      double curr_distance=hamming_distance_between_elements(
+         curr_element_ptr,vp_ptr);
+      if (curr_distance < mu)
+      {
+         left_packed_elements.push_back(curr_element_ptr);
+      }
+      else
+      {
+         right_packed_elements.push_back(curr_element_ptr);
+      }
+   } // loop over index i labeling packed elements
+
+   if (left_packed_elements.size() > 0)
+   {
+      BTreeNode* left_child_node_ptr=build_vp_tree(
+         curr_level+1,left_packed_elements,prev_used_ID);
+      if (left_child_node_ptr != NULL)
+      {
+         BinaryTreeNode_ptr->set_LeftChild_ptr(left_child_node_ptr);
+         BinaryTree_ptr->addExistingNodeToTree(
+            BinaryTreeNode_ptr,left_child_node_ptr);
+      }
+   }
+      
+   if (right_packed_elements.size() > 0)
+   {
+      BTreeNode* right_child_node_ptr=build_vp_tree(
+         curr_level+1,right_packed_elements,prev_used_ID);
+      if (right_child_node_ptr != NULL)
+      {
+         BinaryTreeNode_ptr->set_RightChild_ptr(right_child_node_ptr);
+         BinaryTree_ptr->addExistingNodeToTree(
+            BinaryTreeNode_ptr,right_child_node_ptr);
+      }
+   }
+
+   return BinaryTreeNode_ptr;
+}
+
 // --------------------------------------------------------------------------
 // Method select_vp() 
 
@@ -433,6 +636,50 @@ double vptree::hamming_distance_between_elements(
 //   cout << "hamming_dist = " << hamming_dist << endl;
 }
 
+double vptree::hamming_distance_between_elements(
+   packed_descriptor* element1_ptr,packed_descriptor* element2_ptr)
+{
+   return binaryfunc::hamming_distance(element1_ptr,element2_ptr);
+}
+
+// --------------------------------------------------------------------------
+// Method distance_between_payloads() measures the separation between
+// the metric space elements held by two VP-tree nodes.  Packed
+// elements are compared via POPCNT Hamming distance whenever both
+// nodes hold them.
+
+double vptree::distance_between_payloads(
+   const node_payload& payload1,const node_payload& payload2)
+{
+   if (payload1.packed_element_ptr != NULL && 
+       payload2.packed_element_ptr != NULL)
+   {
+      return hamming_distance_between_elements(
+         payload1.packed_element_ptr,payload2.packed_element_ptr);
+   }
+   return distance_between_elements(
+      payload1.metric_space_element_ptr,payload2.metric_space_element_ptr);
+}
+
+// --------------------------------------------------------------------------
+// Private method query_distance() returns the separation between a
+// query and the element held by a VP-tree node.  If a packed version
+// of the query is supplied, it takes precedence over the unpacked
+// descriptor.
+
+double vptree::query_distance(
+   descriptor* query_element_ptr,packed_descriptor* packed_query_ptr,
+   const node_payload& payload)
+{
+   if (packed_query_ptr != NULL && payload.packed_element_ptr != NULL)
+   {
+      return hamming_distance_between_elements(
+         packed_query_ptr,payload.packed_element_ptr);
+   }
+   return distance_between_elements(
+      query_element_ptr,payload.metric_space_element_ptr);
+}
+
 // --------------------------------------------------------------------------
 // Method KL_distance_between_elements() returns the symmetrized
 // Kullback-Leibler divergence between two input descriptors.  The
@@ -481,13 +728,11 @@ void vptree::compute_extremal_left_subspace_distances(
       std::vector<BTreeNode*> DescendantNode_ptrs;
       LeftChild_ptr->GetDescendantsAndSelf(DescendantNode_ptrs);
 
-      descriptor* element_ptr=BinaryTreeNode_ptr->get_data().
-         metric_space_element_ptr;
+      const node_payload& element_payload=BinaryTreeNode_ptr->get_data();
       for (unsigned int d=0; d<DescendantNode_ptrs.size(); d++)
       {
-         double curr_dist=distance_between_elements(
-            element_ptr,DescendantNode_ptrs[d]->get_data().
-            metric_space_element_ptr);
+         double curr_dist=distance_between_payloads(
+            element_payload,DescendantNode_ptrs[d]->get_data());
          min_dist=basic_math::min(min_dist,curr_dist);
          max_dist=basic_math::max(max_dist,curr_dist);
       } // loop over index d labeling descendant nodes
@@ -511,13 +756,11 @@ void vptree::compute_extremal_right_subspace_distances(
       std::vector<BTreeNode*> DescendantNode_ptrs;
       RightChild_ptr->GetDescendantsAndSelf(DescendantNode_ptrs);
 
-      descriptor* element_ptr=BinaryTreeNode_ptr->get_data().
-         metric_space_element_ptr;
+      const node_payload& element_payload=BinaryTreeNode_ptr->get_data();
       for (unsigned int d=0; d<DescendantNode_ptrs.size(); d++)
       {
-         double curr_dist=distance_between_elements(
-            element_ptr,DescendantNode_ptrs[d]->get_data().
-            metric_space_element_ptr);
+         double curr_dist=distance_between_payloads(
+            element_payload,DescendantNode_ptrs[d]->get_data());
          min_dist=basic_math::min(min_dist,curr_dist);
          max_dist=basic_math::max(max_dist,curr_dist);
       } // loop over index d labeling descendant nodes
@@ -582,6 +825,22 @@ double vptree::median_separation_distance(
    return mu;
 }
 
+double vptree::median_separation_distance(
+   packed_descriptor* p_ptr,const vector<packed_descriptor*>& packed_elements)
+{
+   vector<double> distances;
+   distances.reserve(packed_elements.size());
+   for (unsigned int i=0; i<packed_elements.size(); i++)
+   {
+      double separation_distance=hamming_distance_between_elements(
+         p_ptr,packed_elements[i]);
+      if (separation_distance > 0) distances.push_back(separation_distance);
+   }
+   double mu=0;
+   if (distances.size() > 0) mu=mathfunc::median_value(distances);
+   return mu;
+}
+
 // --------------------------------------------------------------------------
 // Member function compute_distances_to_nodes() takes in a metric
 // space query element along with a set of VPtree node IDs.  It
@@ -661,11 +920,14 @@ void vptree::print_vp_tree()
          cout << "Right Child ID = " << RightChild_ptr->get_ID() << endl;
       }
 
-      cout << "X= " 
-           << curr_node_data.metric_space_element_ptr->get(0) 
-           << " , Y = " 
-           << curr_node_data.metric_space_element_ptr->get(1)
-           << endl;
+      if (curr_node_data.metric_space_element_ptr != NULL)
+      {
+         cout << "X= " 
+              << curr_node_data.metric_space_element_ptr->get(0) 
+              << " , Y = " 
+              << curr_node_data.metric_space_element_ptr->get(1)
+              << endl;
+      }
       cout << "mu = " << curr_node_data.mu << endl;
       cout << "left_min_dist = " << curr_node_data.left_min_dist
            << " left_max_dist = " << curr_node_data.left_max_dist
@@ -701,11 +963,14 @@ vector<string> vptree::extract_vp_node_info(BTreeNode* node_ptr)
       cout << "Right Child ID = " << RightChild_ptr->get_ID() << endl;
    }
 
-   curr_line="X= "+stringfunc::number_to_string(
-      curr_node_data.metric_space_element_ptr->get(0) )+
-      " , Y = "+stringfunc::number_to_string(
-         curr_node_data.metric_space_element_ptr->get(1));
-   text_lines.push_back(curr_line);
+   if (curr_node_data.metric_space_element_ptr != NULL)
+   {
+      curr_line="X= "+stringfunc::number_to_string(
+         curr_node_data.metric_space_element_ptr->get(0) )+
+         " , Y = "+stringfunc::number_to_string(
+            curr_node_data.metric_space_element_ptr->get(1));
+      text_lines.push_back(curr_line);
+   }
          
    curr_line="mu = "+stringfunc::number_to_string(curr_node_data.mu);
    text_lines.push_back(curr_line);
@@ -726,8 +991,17 @@ descriptor* vptree::find_closest_node(descriptor* query_element_ptr)
 //   cout << "inside vptree::find_closest_node()" << endl;
    tau=POSITIVEINFINITY;
    best_node_ID=-1;
-   search_vp_tree(
-      BinaryTree_ptr->get_root_ptr(),query_element_ptr);
+   if (packed_flag)
+   {
+      packed_descriptor packed_query(query_element_ptr);
+      search_vp_subtree(
+         BinaryTree_ptr->get_root_ptr(),query_element_ptr,&packed_query);
+   }
+   else
+   {
+      search_vp_subtree(
+         BinaryTree_ptr->get_root_ptr(),query_element_ptr,NULL);
+   }
    BTreeNode* BTreeNode_ptr=BinaryTree_ptr->get_node_ptr(best_node_ID);
 
 //   cout << "best_node_ID = " << best_node_ID << endl;
@@ -736,6 +1010,22 @@ descriptor* vptree::find_closest_node(descriptor* query_element_ptr)
    return BTreeNode_ptr->get_data().metric_space_element_ptr;
 }
 
+// --------------------------------------------------------------------------
+// This overloaded version of find_closest_node() takes in a packed
+// binary query and returns the packed element within the VP tree
+// which lies closest to it in Hamming distance.
+
+packed_descriptor* vptree::find_closest_node(
+   packed_descriptor* query_element_ptr)
+{
+   tau=POSITIVEINFINITY;
+   best_node_ID=-1;
+   search_vp_subtree(
+      BinaryTree_ptr->get_root_ptr(),NULL,query_element_ptr);
+   BTreeNode* BTreeNode_ptr=BinaryTree_ptr->get_node_ptr(best_node_ID);
+   return BTreeNode_ptr->get_data().packed_element_ptr;
+}
+
 // --------------------------------------------------------------------------
 // Member function search_vp_tree() should initially be called with
 // query descriptor *query_element_ptr and the root node of the vantage
@@ -748,12 +1038,32 @@ descriptor* vptree::find_closest_node(descriptor* query_element_ptr)
 
 void vptree::search_vp_tree( 
    BTreeNode* BinaryTreeNode_ptr,descriptor* query_element_ptr)
+{
+   search_vp_subtree(BinaryTreeNode_ptr,query_element_ptr,NULL);
+}
+
+void vptree::search_vp_tree( 
+   BTreeNode* BinaryTreeNode_ptr,packed_descriptor* query_element_ptr)
+{
+   search_vp_subtree(BinaryTreeNode_ptr,NULL,query_element_ptr);
+}
+
+// --------------------------------------------------------------------------
+// Private member function search_vp_subtree() performs the recursive
+// work for both search_vp_tree() overloads.  Exactly one of
+// query_element_ptr and packed_query_ptr generally needs to be
+// non-NULL.  If both are supplied, the packed query is used wherever
+// nodes hold packed elements.
+
+void vptree::search_vp_subtree( 
+   BTreeNode* BinaryTreeNode_ptr,descriptor* query_element_ptr,
+   packed_descriptor* packed_query_ptr)
 {
    if (BinaryTreeNode_ptr==NULL) return;
 
-   double x=distance_between_elements(
-      query_element_ptr,BinaryTreeNode_ptr->get_data().
-      metric_space_element_ptr);
+   const node_payload& curr_payload=BinaryTreeNode_ptr->get_data();
+   double x=query_distance(
+      query_element_ptr,packed_query_ptr,curr_payload);
    if (x < tau)
    {
       tau=x;
@@ -762,36 +1072,39 @@ void vptree::search_vp_tree(
 //           << " tau = " << tau << endl;
    }
    double middle=0.5*(
-      BinaryTreeNode_ptr->get_data().left_max_dist+
-      BinaryTreeNode_ptr->get_data().right_min_dist);
+      curr_payload.left_max_dist+curr_payload.right_min_dist);
    if (x < middle)
    {
-      if (x > BinaryTreeNode_ptr->get_data().left_min_dist-tau &&
-      x < BinaryTreeNode_ptr->get_data().left_max_dist+tau)
+      if (x > curr_payload.left_min_dist-tau &&
+      x < curr_payload.left_max_dist+tau)
       {
-         search_vp_tree(
-            BinaryTreeNode_ptr->get_LeftChild_ptr(),query_element_ptr);
+         search_vp_subtree(
+            BinaryTreeNode_ptr->get_LeftChild_ptr(),query_element_ptr,
+            packed_query_ptr);
       }
-      if (x > BinaryTreeNode_ptr->get_data().right_min_dist-tau &&
-      x < BinaryTreeNode_ptr->get_data().right_max_dist+tau)
+      if (x > curr_payload.right_min_dist-tau &&
+      x < curr_payload.right_max_dist+tau)
       {
-         search_vp_tree(
-            BinaryTreeNode_ptr->get_RightChild_ptr(),query_element_ptr);
+         search_vp_subtree(
+            BinaryTreeNode_ptr->get_RightChild_ptr(),query_element_ptr,
+            packed_query_ptr);
       }
    }
    else
    {
-      if (x > BinaryTreeNode_ptr->get_data().right_min_dist-tau &&
-      x < BinaryTreeNode_ptr->get_data().right_max_dist+tau)
+      if (x > curr_payload.right_min_dist-tau &&
+      x < curr_payload.right_max_dist+tau)
       {
-         search_vp_tree(
-            BinaryTreeNode_ptr->get_RightChild_ptr(),query_element_ptr);
+         search_vp_subtree(
+            BinaryTreeNode_ptr->get_RightChild_ptr(),query_element_ptr,
+            packed_query_ptr);
       }
-      if (x > BinaryTreeNode_ptr->get_data().left_min_dist-tau &&
-      x < BinaryTreeNode_ptr->get_data().left_max_dist+tau)
+      if (x > curr_payload.left_min_dist-tau &&
+      x < curr_payload.left_max_dist+tau)
       {
-         search_vp_tree(
-            BinaryTreeNode_ptr->get_LeftChild_ptr(),query_element_ptr);
+         search_vp_subtree(
+            BinaryTreeNode_ptr->get_LeftChild_ptr(),query_element_ptr,
+            packed_query_ptr);
       }
          
    } // x < middle conditional
@@ -822,6 +1135,64 @@ void vptree::incrementally_find_nearest_nodes(
    query_to_neighbor_distances.clear();
    metric_space_element_ptrs.clear();
 
+   packed_descriptor* packed_query_ptr=NULL;
+   if (packed_flag) packed_query_ptr=new packed_descriptor(query_element_ptr);
+
+   incrementally_rank_nodes(
+      k,query_element_ptr,packed_query_ptr,nearest_neighbor_node_IDs);
+
+   for (unsigned int n=0; n<nearest_neighbor_node_IDs.size(); n++)
+   {
+      const node_payload& curr_payload=BinaryTree_ptr->get_node_ptr(
+         nearest_neighbor_node_IDs[n])->get_data();
+      query_to_neighbor_distances.push_back(query_distance(
+         query_element_ptr,packed_query_ptr,curr_payload));
+      metric_space_element_ptrs.push_back(
+         curr_payload.metric_space_element_ptr);
+   }
+   delete packed_query_ptr;
+}
+
+// --------------------------------------------------------------------------
+// This overloaded version of incrementally_find_nearest_nodes() takes
+// in a packed binary query.  Packed elements ordered by Hamming
+// distance to the query are returned within packed_element_ptrs.
+
+void vptree::incrementally_find_nearest_nodes(
+   int k,packed_descriptor* query_element_ptr,
+   vector<int>& nearest_neighbor_node_IDs,
+   vector<double>& query_to_neighbor_distances,
+   vector<packed_descriptor*>& packed_element_ptrs)
+{
+   nearest_neighbor_node_IDs.clear();
+   query_to_neighbor_distances.clear();
+   packed_element_ptrs.clear();
+
+   incrementally_rank_nodes(
+      k,NULL,query_element_ptr,nearest_neighbor_node_IDs);
+
+   for (unsigned int n=0; n<nearest_neighbor_node_IDs.size(); n++)
+   {
+      const node_payload& curr_payload=BinaryTree_ptr->get_node_ptr(
+         nearest_neighbor_node_IDs[n])->get_data();
+      query_to_neighbor_distances.push_back(query_distance(
+         NULL,query_element_ptr,curr_payload));
+      packed_element_ptrs.push_back(curr_payload.packed_element_ptr);
+   }
+}
+
+// --------------------------------------------------------------------------
+// Private member function incrementally_rank_nodes() performs Samet's
+// priority queue traversal for both incrementally_find_nearest_nodes()
+// overloads.  Node IDs ordered by proximity to the query are returned
+// within nearest_neighbor_node_IDs.
+
+void vptree::incrementally_rank_nodes(
+   int k,descriptor* query_element_ptr,packed_descriptor* packed_query_ptr,
+   vector<int>& nearest_neighbor_node_IDs)
+{
+   nearest_neighbor_node_IDs.clear();
+
    delete search_queue_ptr;
    search_queue_ptr=
       new priority_queue<threevector,vector<threevector>,samet_comparison>;
@@ -891,13 +1262,7 @@ void vptree::incrementally_find_nearest_nodes(
       if (curr_node_type==0)
       {
          nearest_neighbor_node_IDs.push_back(curr_node_ID);
-         if (int(nearest_neighbor_node_IDs.size())==k)
-         {
-            compute_distances_to_nodes(
-               query_element_ptr,nearest_neighbor_node_IDs,
-               query_to_neighbor_distances,metric_space_element_ptrs);
-            return;
-         }
+         if (int(nearest_neighbor_node_IDs.size())==k) return;
       }
       else
       {
@@ -906,11 +1271,9 @@ void vptree::incrementally_find_nearest_nodes(
 // to the priority queue:
 
          BTreeNode* BTreeNode_ptr=BinaryTree_ptr->get_node_ptr(curr_node_ID);
-         descriptor* pivot_element_ptr=
-            BTreeNode_ptr->get_data().metric_space_element_ptr;
          double mu=BTreeNode_ptr->get_data().mu;
-         double query_pivot_distance=distance_between_elements(
-            query_element_ptr,pivot_element_ptr);
+         double query_pivot_distance=query_distance(
+            query_element_ptr,packed_query_ptr,BTreeNode_ptr->get_data());
 //         curr_node_type=0;
 //         curr_e=threevector(query_pivot_distance,curr_node_type,curr_node_ID);
 //         search_queue_ptr->push(curr_e);   
@@ -978,8 +1341,327 @@ void vptree::incrementally_find_nearest_nodes(
 
       } // curr_node_type conditional
    } // while loop
+}
 
-   compute_distances_to_nodes(
-      query_element_ptr,nearest_neighbor_node_IDs,query_to_neighbor_distances,
-      metric_space_element_ptrs);
+// ==========================================================================
+// Flattened vantage point tree methods
+// ==========================================================================
+
+// Private member function flatten_tree() copies every node within
+// *BinaryTree_ptr into STL vector member flat_nodes.  A node's left
+// subtree immediately follows it in depth-first order, so the
+// vantage points visited along a typical search path tend to share
+// cache lines.
+
+void vptree::flatten_tree()
+{
+   flat_nodes.clear();
+   flat_nodes.reserve(BinaryTree_ptr->size());
+   flatten_subtree(BinaryTree_ptr->get_root_ptr());
+}
+
+// --------------------------------------------------------------------------
+// Private member function flatten_subtree() recursively appends the
+// subtree rooted at *BinaryTreeNode_ptr to flat_nodes.  It returns the
+// flattened index of the subtree's root.
+
+int vptree::flatten_subtree(BTreeNode* BinaryTreeNode_ptr)
+{
+   if (BinaryTreeNode_ptr==NULL) return -1;
+
+   const node_payload& curr_payload=BinaryTreeNode_ptr->get_data();
+   flat_vp_node curr_flat_node;
+   curr_flat_node.node_ID=BinaryTreeNode_ptr->get_ID();
+   curr_flat_node.left_index=curr_flat_node.right_index=-1;
+   curr_flat_node.mu=curr_payload.mu;
+   curr_flat_node.left_min_dist=curr_payload.left_min_dist;
+   curr_flat_node.left_max_dist=curr_payload.left_max_dist;
+   curr_flat_node.right_min_dist=curr_payload.right_min_dist;
+   curr_flat_node.right_max_dist=curr_payload.right_max_dist;
+   curr_flat_node.metric_space_element_ptr=
+      curr_payload.metric_space_element_ptr;
+   curr_flat_node.packed_element_ptr=curr_payload.packed_element_ptr;
+
+   int curr_index=flat_nodes.size();
+   flat_nodes.push_back(curr_flat_node);
+
+   int left_index=flatten_subtree(BinaryTreeNode_ptr->get_LeftChild_ptr());
+   int right_index=flatten_subtree(BinaryTreeNode_ptr->get_RightChild_ptr());
+   flat_nodes[curr_index].left_index=left_index;
+   flat_nodes[curr_index].right_index=right_index;
+   return curr_index;
+}
+
+// --------------------------------------------------------------------------
+// Private member function unflatten_subtree() performs the inverse of
+// flatten_subtree().  It recursively regenerates the BinaryTree nodes
+// for the flattened subtree rooted at flat_nodes[flat_index] with
+// their original IDs.  The subtree's root node is returned.
+
+vptree::BTreeNode* vptree::unflatten_subtree(int flat_index)
+{
+   if (flat_index < 0) return NULL;
+
+   const flat_vp_node& curr_flat_node=flat_nodes[flat_index];
+   node_payload curr_payload;
+   curr_payload.metric_space_element_ptr=
+      curr_flat_node.metric_space_element_ptr;
+   curr_payload.packed_element_ptr=curr_flat_node.packed_element_ptr;
+   curr_payload.mu=curr_flat_node.mu;
+   curr_payload.left_min_dist=curr_flat_node.left_min_dist;
+   curr_payload.left_max_dist=curr_flat_node.left_max_dist;
+   curr_payload.right_min_dist=curr_flat_node.right_min_dist;
+   curr_payload.right_max_dist=curr_flat_node.right_max_dist;
+
+   BTreeNode* BinaryTreeNode_ptr;
+   if (BinaryTree_ptr->size()==0)
+   {
+      BinaryTreeNode_ptr=BinaryTree_ptr->generate_root_node();
+   }
+   else
+   {
+      BinaryTreeNode_ptr=new BTreeNode;
+      BinaryTreeNode_ptr->set_ID(curr_flat_node.node_ID);
+   }
+   BinaryTreeNode_ptr->set_data(curr_payload);
+
+   BTreeNode* left_child_node_ptr=unflatten_subtree(
+      curr_flat_node.left_index);
+   if (left_child_node_ptr != NULL)
+   {
+      BinaryTreeNode_ptr->set_LeftChild_ptr(left_child_node_ptr);
+      BinaryTree_ptr->addExistingNodeToTree(
+         BinaryTreeNode_ptr,left_child_node_ptr);
+   }
+
+   BTreeNode* right_child_node_ptr=unflatten_subtree(
+      curr_flat_node.right_index);
+   if (right_child_node_ptr != NULL)
+   {
+      BinaryTreeNode_ptr->set_RightChild_ptr(right_child_node_ptr);
+      BinaryTree_ptr->addExistingNodeToTree(
+         BinaryTreeNode_ptr,right_child_node_ptr);
+   }
+   return BinaryTreeNode_ptr;
+}
+
+// --------------------------------------------------------------------------
+// This overloaded version of private method query_distance() returns
+// the separation between a query and the element held by a flattened
+// node.
+
+double vptree::query_distance(
+   descriptor* query_element_ptr,packed_descriptor* packed_query_ptr,
+   const flat_vp_node& curr_flat_node)
+{
+   if (packed_query_ptr != NULL && curr_flat_node.packed_element_ptr != NULL)
+   {
+      return hamming_distance_between_elements(
+         packed_query_ptr,curr_flat_node.packed_element_ptr);
+   }
+   return distance_between_elements(
+      query_element_ptr,curr_flat_node.metric_space_element_ptr);
+}
+
+// --------------------------------------------------------------------------
+// Private member function flat_knn_search() performs a best-first
+// traversal of flat_nodes.  Pending subtrees are held within min-heap
+// probe_queue keyed by a triangle inequality lower bound on the
+// distance between the query and any element inside them.  The k
+// closest elements found so far are held within max-heap
+// nearest_neighbors.  The search terminates once the nearest pending
+// subtree cannot improve upon the current kth neighbor.  If
+// max_node_visits > 0, it also terminates after that many query
+// distances have been computed.  In the latter case, the returned
+// neighbors are approximate.
+
+// Both heaps are passed in by the caller so that their storage can be
+// reused across queries.  Since this method only reads member
+// variables, it may be called concurrently from multiple threads.  On
+// return, nearest_neighbors holds (distance, flat index) pairs sorted
+// in ascending distance order.
+
+void vptree::flat_knn_search(
+   int k,descriptor* query_element_ptr,packed_descriptor* packed_query_ptr,
+   int max_node_visits,vector<distance_index_pair>& nearest_neighbors,
+   vector<distance_index_pair>& probe_queue)
+{
+   nearest_neighbors.clear();
+   probe_queue.clear();
+   if (flat_nodes.size()==0 || k <= 0) return;
+
+   greater<distance_index_pair> min_heap_comparison;
+   probe_queue.push_back(distance_index_pair(0,0));
+
+   int n_node_visits=0;
+   while (probe_queue.size() > 0)
+   {
+      std::pop_heap(
+         probe_queue.begin(),probe_queue.end(),min_heap_comparison);
+      distance_index_pair curr_probe=probe_queue.back();
+      probe_queue.pop_back();
+
+      double tau=POSITIVEINFINITY;
+      if (int(nearest_neighbors.size())==k) 
+         tau=nearest_neighbors.front().first;
+      if (curr_probe.first >= tau) break;
+      if (max_node_visits > 0 && n_node_visits >= max_node_visits) break;
+
+      const flat_vp_node& curr_flat_node=flat_nodes[curr_probe.second];
+      double x=query_distance(
+         query_element_ptr,packed_query_ptr,curr_flat_node);
+      n_node_visits++;
+
+      if (x < tau)
+      {
+         if (int(nearest_neighbors.size())==k)
+         {
+            std::pop_heap(nearest_neighbors.begin(),nearest_neighbors.end());
+            nearest_neighbors.pop_back();
+         }
+         nearest_neighbors.push_back(
+            distance_index_pair(x,curr_probe.second));
+         std::push_heap(nearest_neighbors.begin(),nearest_neighbors.end());
+         if (int(nearest_neighbors.size())==k)
+            tau=nearest_neighbors.front().first;
+      }
+
+// Every element e within a child subspace satisfies d(vp,e) in
+// [min_dist,max_dist].  So d(query,e) >= max(min_dist-x,x-max_dist,0):
+
+      if (curr_flat_node.left_index >= 0)
+      {
+         double lower_bound=basic_math::max(
+            curr_flat_node.left_min_dist-x,x-curr_flat_node.left_max_dist,
+            curr_probe.first);
+         if (lower_bound < tau)
+         {
+            probe_queue.push_back(distance_index_pair(
+               lower_bound,curr_flat_node.left_index));
+            std::push_heap(
+               probe_queue.begin(),probe_queue.end(),min_heap_comparison);
+         }
+      }
+      if (curr_flat_node.right_index >= 0)
+      {
+         double lower_bound=basic_math::max(
+            curr_flat_node.right_min_dist-x,x-curr_flat_node.right_max_dist,
+            curr_probe.first);
+         if (lower_bound < tau)
+         {
+            probe_queue.push_back(distance_index_pair(
+               lower_bound,curr_flat_node.right_index));
+            std::push_heap(
+               probe_queue.begin(),probe_queue.end(),min_heap_comparison);
+         }
+      }
+   } // while loop
+
+   std::sort_heap(nearest_neighbors.begin(),nearest_neighbors.end());
+}
+
+// --------------------------------------------------------------------------
+// Member function batch_knn() returns the k nearest neighbors within
+// the VP tree for every query descriptor in query_element_ptrs.
+// Queries are distributed across n_threads OpenMP threads (n_threads
+// <= 0 selects the OpenMP default).  Each thread reuses its own pair
+// of search heaps.  Neighbor node IDs, distances and metric space
+// elements for query q are returned in ascending distance order
+// within the qth entries of the output STL vectors.  If
+// max_node_visits > 0, each query computes at most that many
+// distances and its neighbors are approximate.
+
+void vptree::batch_knn(
+   const vector<descriptor*>& query_element_ptrs,int k,int n_threads,
+   vector<vector<int> >& nearest_neighbor_node_IDs,
+   vector<vector<double> >& query_to_neighbor_distances,
+   vector<vector<descriptor*> >& metric_space_element_ptrs,
+   int max_node_visits)
+{
+   int n_queries=query_element_ptrs.size();
+   nearest_neighbor_node_IDs.assign(n_queries,vector<int>());
+   query_to_neighbor_distances.assign(n_queries,vector<double>());
+   metric_space_element_ptrs.assign(n_queries,vector<descriptor*>());
+#ifdef _OPENMP
+   if (n_threads <= 0) n_threads=omp_get_max_threads();
+#else
+   n_threads=1;
+#endif
+
+#pragma omp parallel num_threads(n_threads)
+   {
+      vector<distance_index_pair> nearest_neighbors,probe_queue;
+
+#pragma omp for schedule(dynamic,16)
+      for (int q=0; q<n_queries; q++)
+      {
+         descriptor* query_element_ptr=query_element_ptrs[q];
+         packed_descriptor* packed_query_ptr=NULL;
+         if (packed_flag) 
+            packed_query_ptr=new packed_descriptor(query_element_ptr);
+
+         flat_knn_search(
+            k,query_element_ptr,packed_query_ptr,max_node_visits,
+            nearest_neighbors,probe_queue);
+         delete packed_query_ptr;
+
+         for (unsigned int n=0; n<nearest_neighbors.size(); n++)
+         {
+            const flat_vp_node& curr_flat_node=
+               flat_nodes[nearest_neighbors[n].second];
+            nearest_neighbor_node_IDs[q].push_back(curr_flat_node.node_ID);
+            query_to_neighbor_distances[q].push_back(
+               nearest_neighbors[n].first);
+            metric_space_element_ptrs[q].push_back(
+               curr_flat_node.metric_space_element_ptr);
+         }
+      } // loop over index q labeling queries
+   } // omp parallel region
+}
+
+// --------------------------------------------------------------------------
+// This overloaded version of batch_knn() takes in packed binary
+// queries.  Packed elements ordered by Hamming distance to each query
+// are returned within packed_element_ptrs.
+
+void vptree::batch_knn(
+   const vector<packed_descriptor*>& query_element_ptrs,int k,int n_threads,
+   vector<vector<int> >& nearest_neighbor_node_IDs,
+   vector<vector<double> >& query_to_neighbor_distances,
+   vector<vector<packed_descriptor*> >& packed_element_ptrs,
+   int max_node_visits)
+{
+   int n_queries=query_element_ptrs.size();
+   nearest_neighbor_node_IDs.assign(n_queries,vector<int>());
+   query_to_neighbor_distances.assign(n_queries,vector<double>());
+   packed_element_ptrs.assign(n_queries,vector<packed_descriptor*>());
+#ifdef _OPENMP
+   if (n_threads <= 0) n_threads=omp_get_max_threads();
+#else
+   n_threads=1;
+#endif
+
+#pragma omp parallel num_threads(n_threads)
+   {
+      vector<distance_index_pair> nearest_neighbors,probe_queue;
+
+#pragma omp for schedule(dynamic,16)
+      for (int q=0; q<n_queries; q++)
+      {
+         flat_knn_search(
+            k,NULL,query_element_ptrs[q],max_node_visits,
+            nearest_neighbors,probe_queue);
+
+         for (unsigned int n=0; n<nearest_neighbors.size(); n++)
+         {
+            const flat_vp_node& curr_flat_node=
+               flat_nodes[nearest_neighbors[n].second];
+            nearest_neighbor_node_IDs[q].push_back(curr_flat_node.node_ID);
+            query_to_neighbor_distances[q].push_back(
+               nearest_neighbors[n].first);
+            packed_element_ptrs[q].push_back(
+               curr_flat_node.packed_element_ptr);
+         }
+      } // loop over index q labeling queries
+   } // omp parallel region
 }
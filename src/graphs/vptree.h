@@ -5,20 +5,23 @@
 // also "What is a good nearest neighbors algorithm for finding similar
 // patches in images" by N. Jumar, L. Zhang and S. Nayar.
 // ==========================================================================
-// Last modified on 3/20/12; 9/1/12; 4/29/13; 5/31/13
+// Last modified on 3/20/12; 9/1/12; 4/29/13; 5/31/13; 10/18/26
 // ==========================================================================
 
 #ifndef VPTREE_H
 #define VPTREE_H
 
+#include <map>
 #include <queue>
 #include <vector>
 #include "datastructures/BinaryTree.h"
 #include "datastructures/descriptor.h"
+#include "datastructures/packed_descriptor.h"
 #include "numrec/nrfuncs.h"
 #include "graphs/samet_comparison.h"
 
 class descriptor;
+class packed_descriptor;
 
 class vptree
 {
@@ -28,6 +31,7 @@ class vptree
    struct node_payload
    {
          descriptor* metric_space_element_ptr;
+         packed_descriptor* packed_element_ptr;
          double mu;
          double left_min_dist,left_max_dist,right_min_dist,right_max_dist;
    };
@@ -51,20 +55,28 @@ class vptree
    void set_KL_distance_flag(bool flag);
    void set_sqrd_Euclidean_distance_flag(bool flag);
    double get_tau() const;
+   bool get_packed_flag() const;
 
 // Vantage point tree construction methods:
 
    void construct_tree(const std::vector<descriptor*>& metric_space_elements);
    void construct_tree(const std::vector<descriptor_pair>& feature_pairs);
+   void construct_tree(
+      const std::vector<packed_descriptor*>& packed_elements);
 
    BTreeNode* build_vp_tree(
       int curr_level,const std::vector<descriptor*>& metric_space_elements,
       int& prev_used_ID);
+   BTreeNode* build_vp_tree(
+      int curr_level,const std::vector<packed_descriptor*>& packed_elements,
+      int& prev_used_ID);
    descriptor* select_vp(const std::vector<descriptor*>& metric_space_elements);
    std::vector<descriptor*> randomly_select_metric_space_elements(
       const std::vector<descriptor*>& metric_space_elements);
    descriptor* select_random_vp(
       const std::vector<descriptor*>& metric_space_elements);
+   packed_descriptor* select_random_vp(
+      const std::vector<packed_descriptor*>& packed_elements);
    descriptor* select_centroid_vp(
       const std::vector<descriptor*>& metric_space_elements);
 
@@ -78,6 +90,10 @@ class vptree
       descriptor* element1_ptr,descriptor* element2_ptr);
    double hamming_distance_between_elements(
       descriptor* element1_ptr,descriptor* element2_ptr);
+   double hamming_distance_between_elements(
+      packed_descriptor* element1_ptr,packed_descriptor* element2_ptr);
+   double distance_between_payloads(
+      const node_payload& payload1,const node_payload& payload2);
    double KL_distance_between_elements(
       descriptor* element1_ptr,descriptor* element2_ptr);
    void compute_extremal_left_subspace_distances(
@@ -90,6 +106,9 @@ class vptree
    double median_separation_distance(
       descriptor* p_ptr,const std::vector<descriptor*>& metric_space_elements,
       std::vector<double>& distances);
+   double median_separation_distance(
+      packed_descriptor* p_ptr,
+      const std::vector<packed_descriptor*>& packed_elements);
    void compute_distances_to_nodes(
       descriptor* query_element_ptr,
       const std::vector<int>& nearest_neighbor_node_IDs,
@@ -104,17 +123,60 @@ class vptree
 // Vantage point tree search methods:
 
    descriptor* find_closest_node(descriptor* query_element_ptr);
+   packed_descriptor* find_closest_node(packed_descriptor* query_element_ptr);
    void search_vp_tree(
       BTreeNode* BinaryTreeNode_ptr,descriptor* query_element_ptr);
+   void search_vp_tree(
+      BTreeNode* BinaryTreeNode_ptr,packed_descriptor* query_element_ptr);
    void incrementally_find_nearest_nodes(
       int k,descriptor* query_element_ptr,
       std::vector<int>& nearest_neighbor_node_IDs,
       std::vector<double>& query_to_neighbor_distances,
       std::vector<descriptor*>& metric_space_element_ptrs);
+   void incrementally_find_nearest_nodes(
+      int k,packed_descriptor* query_element_ptr,
+      std::vector<int>& nearest_neighbor_node_IDs,
+      std::vector<double>& query_to_neighbor_distances,
+      std::vector<packed_descriptor*>& packed_element_ptrs);
+
+// Batched k nearest neighbor search methods:
+
+   void batch_knn(
+      const std::vector<descriptor*>& query_element_ptrs,int k,int n_threads,
+      std::vector<std::vector<int> >& nearest_neighbor_node_IDs,
+      std::vector<std::vector<double> >& query_to_neighbor_distances,
+      std::vector<std::vector<descriptor*> >& metric_space_element_ptrs,
+      int max_node_visits=-1);
+   void batch_knn(
+      const std::vector<packed_descriptor*>& query_element_ptrs,int k,
+      int n_threads,
+      std::vector<std::vector<int> >& nearest_neighbor_node_IDs,
+      std::vector<std::vector<double> >& query_to_neighbor_distances,
+      std::vector<std::vector<packed_descriptor*> >& packed_element_ptrs,
+      int max_node_visits=-1);
 
   private: 
 
+// Once a VP tree has been constructed, its nodes are also copied in
+// depth-first order into contiguous STL vector flat_nodes.  Child
+// links are stored as vector indices (-1 for missing children) so
+// that batched queries never chase BinaryTreeNode pointers or perform
+// node ID map lookups:
+
+   struct flat_vp_node
+   {
+         int node_ID;
+         int left_index,right_index;
+         double mu;
+         double left_min_dist,left_max_dist,right_min_dist,right_max_dist;
+         descriptor* metric_space_element_ptr;
+         packed_descriptor* packed_element_ptr;
+   };
+
+   typedef std::pair<double,int> distance_index_pair;
+
    bool hamming_distance_flag,KL_distance_flag,sqrd_Euclidean_distance_flag;
+   bool packed_flag;
    int best_node_ID;
    double tau;
    std::vector<double> log_values;
@@ -122,10 +184,42 @@ class vptree
    std::priority_queue<threevector,std::vector<threevector>,samet_comparison>* 
       search_queue_ptr;
 
+// Packed copies of descriptors which this vptree owns when it is
+// constructed from descriptors with hamming_distance_flag==true:
+
+   std::vector<packed_descriptor*> owned_packed_element_ptrs;
+   std::map<packed_descriptor*,descriptor*> packed_source_map;
+
+   std::vector<flat_vp_node> flat_nodes;
+
    void allocate_member_objects();
    void initialize_member_objects();
    void docopy(const vptree& v);
    void store_logarithm_values();
+   void delete_owned_packed_elements();
+
+   double query_distance(
+      descriptor* query_element_ptr,packed_descriptor* packed_query_ptr,
+      const node_payload& payload);
+   void search_vp_subtree(
+      BTreeNode* BinaryTreeNode_ptr,descriptor* query_element_ptr,
+      packed_descriptor* packed_query_ptr);
+   void incrementally_rank_nodes(
+      int k,descriptor* query_element_ptr,
+      packed_descriptor* packed_query_ptr,
+      std::vector<int>& nearest_neighbor_node_IDs);
+
+   void flatten_tree();
+   int flatten_subtree(BTreeNode* BinaryTreeNode_ptr);
+   BTreeNode* unflatten_subtree(int flat_index);
+   double query_distance(
+      descriptor* query_element_ptr,packed_descriptor* packed_query_ptr,
+      const flat_vp_node& curr_flat_node);
+   void flat_knn_search(
+      int k,descriptor* query_element_ptr,
+      packed_descriptor* packed_query_ptr,int max_node_visits,
+      std::vector<distance_index_pair>& nearest_neighbors,
+      std::vector<distance_index_pair>& probe_queue);
 };
 
 // ==========================================================================
@@ -152,6 +246,15 @@ inline double vptree::get_tau() const
    return tau;
 }
 
+// Boolean packed_flag is true if this vptree's nodes hold packed
+// binary descriptors whose separations are measured via POPCNT
+// Hamming distances.
+
+inline bool vptree::get_packed_flag() const
+{
+   return packed_flag;
+}
+
 // --------------------------------------------------------------------------
 // Method select_random_vp() 
 
@@ -162,6 +265,12 @@ inline descriptor* vptree::select_random_vp(
       metric_space_elements.size()*nrfunc::ran1()];
 }
 
+inline packed_descriptor* vptree::select_random_vp(
+   const std::vector<packed_descriptor*>& packed_elements)
+{
+   return packed_elements[packed_elements.size()*nrfunc::ran1()];
+}
+
 // --------------------------------------------------------------------------
 inline double vptree::sqrd_Euclidean_distance_between_elements(
    descriptor* element1_ptr,descriptor* element2_ptr)
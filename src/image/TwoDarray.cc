@@ -1,7 +1,7 @@
 // ==========================================================================
 // TwoDarray class member function definitions
 // ==========================================================================
-// Last modified on 11/14/11; 1/28/12; 1/23/14; 3/28/14; 4/5/14
+// Last modified on 11/14/11; 1/28/12; 1/23/14; 3/28/14; 4/5/14; 10/18/26
 // =========================================================================
 
 #include <algorithm>
@@ -901,6 +901,538 @@ template <class A> void TwoDarray<A>::convert_pixel_to_posn_polygon_vertices(
    }
 }
 
+// ==========================================================================
+// Scanline polygon rasterization methods
+// ==========================================================================
+
+// Member function compute_polygon_spans() classifies every pixel
+// within the working region relative to input polygon poly exactly as
+// pixel_relative_to_poly() does.  But rather than calling
+// point_inside_polygon() and point_dist_to_polygon() for each pixel
+// in a bounding box, it walks an edge table down the image rows.
+// Pixel centers lying within an even-odd crossing interval are
+// candidate interior pixels.  Pixels whose centers lie within
+// sqrt(deltax**2+deltay**2) of some polygon edge form the perimeter
+// band.  Strictly interior pixels are returned within inside_spans,
+// while perimeter band pixels are returned within perimeter_spans.
+// All remaining pixels lie outside the polygon.
+
+template <class A> void TwoDarray<A>::compute_polygon_spans(
+   const polygon& poly,std::vector<pixel_span>& inside_spans,
+   std::vector<pixel_span>& perimeter_spans) const
+{
+   inside_spans.clear();
+   perimeter_spans.clear();
+
+   double band_radius=sqrt(sqr(deltax)+sqr(deltay));
+   int min_py,max_py;
+   if (!polygon_pixel_row_range(1,&poly,band_radius,min_py,max_py)) return;
+
+   std::vector<px_intervals> interior_intervals,perimeter_intervals;
+   scan_convert_polygon(
+      poly,min_py,max_py,interior_intervals,perimeter_intervals);
+
+   px_intervals inside_intervals;
+   pixel_span curr_span;
+   for (int py=min_py; py<=max_py; py++)
+   {
+      int r=py-min_py;
+      curr_span.py=py;
+
+      subtract_px_intervals(
+         interior_intervals[r],perimeter_intervals[r],inside_intervals);
+      for (unsigned int i=0; i<inside_intervals.size(); i++)
+      {
+         curr_span.min_px=inside_intervals[i].first;
+         curr_span.max_px=inside_intervals[i].second-1;
+         inside_spans.push_back(curr_span);
+      }
+
+      const px_intervals& curr_perimeter_intervals=perimeter_intervals[r];
+      for (unsigned int i=0; i<curr_perimeter_intervals.size(); i++)
+      {
+         curr_span.min_px=curr_perimeter_intervals[i].first;
+         curr_span.max_px=curr_perimeter_intervals[i].second-1;
+         perimeter_spans.push_back(curr_span);
+      }
+   } // loop over py
+}
+
+// ---------------------------------------------------------------------
+// This overloaded version of compute_polygon_spans() returns the
+// pixels lying inside all (poly_intersection=true) or inside at least
+// one (poly_intersection=false) of the npolys polygons within input
+// array p_2D.  By default, "inside" carries the same strict meaning
+// as in pixel_inside_n_polys().  If include_perimeter_flag==true,
+// each polygon's perimeter band is also regarded as inside.  Every
+// polygon is rasterized once, and the per-polygon pixel intervals
+// are then combined row by row via a single sweep over their
+// endpoints.
+
+template <class A> void TwoDarray<A>::compute_polygon_spans(
+   bool poly_intersection,int npolys,const polygon p_2D[],
+   std::vector<pixel_span>& spans,bool include_perimeter_flag) const
+{
+   spans.clear();
+   if (npolys <= 0) return;
+
+   double band_radius=sqrt(sqr(deltax)+sqr(deltay));
+   int min_py,max_py;
+   if (!polygon_pixel_row_range(
+      npolys,p_2D,band_radius,min_py,max_py)) return;
+
+   unsigned int n_rows=max_py-min_py+1;
+   std::vector<px_intervals> row_events(n_rows);
+   std::vector<px_intervals> interior_intervals,perimeter_intervals;
+   px_intervals coverage_intervals;
+
+   for (int n=0; n<npolys; n++)
+   {
+      scan_convert_polygon(
+         p_2D[n],min_py,max_py,interior_intervals,perimeter_intervals);
+      for (unsigned int r=0; r<n_rows; r++)
+      {
+         if (include_perimeter_flag)
+         {
+            coverage_intervals=interior_intervals[r];
+            coverage_intervals.insert(
+               coverage_intervals.end(),perimeter_intervals[r].begin(),
+               perimeter_intervals[r].end());
+            merge_px_intervals(coverage_intervals);
+         }
+         else
+         {
+            subtract_px_intervals(
+               interior_intervals[r],perimeter_intervals[r],
+               coverage_intervals);
+         }
+
+// Entering and leaving events are sorted by pixel location.  At equal
+// locations, leaving events (-1) precede entering events (+1):
+
+         for (unsigned int i=0; i<coverage_intervals.size(); i++)
+         {
+            row_events[r].push_back(
+               std::pair<int,int>(coverage_intervals[i].first,1));
+            row_events[r].push_back(
+               std::pair<int,int>(coverage_intervals[i].second,-1));
+         }
+      } // loop over index r labeling rows
+   } // loop over index n labeling polygons
+
+   int required_count=(poly_intersection ? npolys : 1);
+   pixel_span curr_span;
+   for (unsigned int r=0; r<n_rows; r++)
+   {
+      px_intervals& curr_events=row_events[r];
+      std::sort(curr_events.begin(),curr_events.end());
+
+      curr_span.py=min_py+r;
+      int count=0;
+      int px_start=0;
+      for (unsigned int e=0; e<curr_events.size(); e++)
+      {
+         bool covered=(count >= required_count);
+         count += curr_events[e].second;
+         if (!covered && count >= required_count)
+         {
+            px_start=curr_events[e].first;
+         }
+         else if (covered && count < required_count &&
+                  curr_events[e].first > px_start)
+         {
+            curr_span.min_px=px_start;
+            curr_span.max_px=curr_events[e].first-1;
+            spans.push_back(curr_span);
+         }
+      } // loop over index e labeling events
+   } // loop over index r labeling rows
+}
+
+// ---------------------------------------------------------------------
+// Member function fill_polygon_spans() sets every pixel within input
+// spans equal to value and returns the number of pixels filled.
+
+template <class A> unsigned int TwoDarray<A>::fill_polygon_spans(
+   const std::vector<pixel_span>& spans,A value)
+{
+   unsigned int n_filled_pixels=0;
+   for (unsigned int s=0; s<spans.size(); s++)
+   {
+      unsigned int py=spans[s].py;
+      for (unsigned int px=spans[s].min_px; px<=spans[s].max_px; px++)
+      {
+         this->put(px,py,value);
+      }
+      n_filled_pixels += spans[s].max_px-spans[s].min_px+1;
+   }
+   return n_filled_pixels;
+}
+
+// ---------------------------------------------------------------------
+// Member function fill_polygon_mask() sets every pixel lying inside
+// the intersection or union of the npolys polygons within input array
+// p_2D equal to value.  Pixels outside the polygons are left
+// untouched.  The number of filled pixels is returned.
+
+template <class A> unsigned int TwoDarray<A>::fill_polygon_mask(
+   bool poly_intersection,int npolys,const polygon p_2D[],A value,
+   bool include_perimeter_flag)
+{
+   std::vector<pixel_span> spans;
+   compute_polygon_spans(
+      poly_intersection,npolys,p_2D,spans,include_perimeter_flag);
+   return fill_polygon_spans(spans,value);
+}
+
+// ---------------------------------------------------------------------
+// Private member function polygon_pixel_row_range() returns the
+// range of working region rows which may intersect any of the npolys
+// input polygons once their bounding boxes are padded by margin.  If
+// no row does, this boolean method returns false.
+
+template <class A> bool TwoDarray<A>::polygon_pixel_row_range(
+   int npolys,const polygon p_2D[],double margin,
+   int& min_py,int& max_py) const
+{
+   if (deltay==0 || this->ndim==0 || this->mdim==0) return false;
+
+   double min_y=POSITIVEINFINITY;
+   double max_y=NEGATIVEINFINITY;
+   for (int n=0; n<npolys; n++)
+   {
+      for (unsigned int i=0; i<p_2D[n].get_nvertices(); i++)
+      {
+         double y=p_2D[n].get_vertex(i).get(1);
+         min_y=basic_math::min(min_y,y);
+         max_y=basic_math::max(max_y,y);
+      }
+   }
+   if (min_y > max_y) return false;
+
+   double v_start=(yhi-(max_y+margin))/deltay;
+   double v_stop=(yhi-(min_y-margin))/deltay;
+   if (v_start > v_stop) templatefunc::swap(v_start,v_stop);
+   if (v_stop < 0 || v_start > this->ndim-1) return false;
+
+   min_py=basic_math::max(0,int(floor(v_start))-1);
+   max_py=basic_math::min(int(this->ndim)-1,int(ceil(v_stop))+1);
+   return true;
+}
+
+// ---------------------------------------------------------------------
+// Private member function x_interval_to_px_interval() returns the
+// half-open range [px_start,px_stop) of working region pixels whose
+// centers satisfy x_start <= x < x_stop (closed_flag=false) or
+// x_start <= x <= x_stop (closed_flag=true).  Candidate endpoints are
+// computed arithmetically and then refined against the exact pixel
+// center coordinates so that results agree with per-pixel tests.
+
+template <class A> void TwoDarray<A>::x_interval_to_px_interval(
+   double x_start,double x_stop,bool closed_flag,
+   int& px_start,int& px_stop) const
+{
+   px_start=px_stop=0;
+   if (deltax==0) return;
+
+   double u_start=(x_start-xlo)/deltax;
+   double u_stop=(x_stop-xlo)/deltax;
+   if (u_start > u_stop) templatefunc::swap(u_start,u_stop);
+   if (u_stop < -1 || u_start > this->mdim) return;
+
+   int p_start=basic_math::max(0,int(floor(u_start))-1);
+   int p_stop=basic_math::min(int(this->mdim)-1,int(ceil(u_stop))+1);
+   while (p_start <= p_stop)
+   {
+      double x=fast_px_to_x(p_start);
+      if (x >= x_start && (x < x_stop || (closed_flag && x==x_stop))) break;
+      p_start++;
+   }
+   while (p_stop >= p_start)
+   {
+      double x=fast_px_to_x(p_stop);
+      if (x >= x_start && (x < x_stop || (closed_flag && x==x_stop))) break;
+      p_stop--;
+   }
+   if (p_start > p_stop) return;
+
+   px_start=p_start;
+   px_stop=p_stop+1;
+}
+
+// ---------------------------------------------------------------------
+// Private member function perimeter_band_x_interval() intersects
+// horizontal line Y=y with the set of points lying within band_radius
+// of line segment (ax,ay)-(bx,by).  Since this capsule is convex, the
+// intersection is a single interval [x_start,x_stop] formed from the
+// two endpoint disks and the rectangle swept along the segment.  This
+// boolean method returns false if the intersection is empty.
+
+template <class A> bool TwoDarray<A>::perimeter_band_x_interval(
+   double ax,double ay,double bx,double by,double band_radius,double y,
+   double& x_start,double& x_stop) const
+{
+   double r_sqrd=sqr(band_radius);
+   bool nonempty_flag=false;
+   x_start=POSITIVEINFINITY;
+   x_stop=NEGATIVEINFINITY;
+
+// Endpoint disks:
+
+   double endpoint_x[2]={ax,bx};
+   double endpoint_y[2]={ay,by};
+   for (unsigned int e=0; e<2; e++)
+   {
+      double dy_sqrd=sqr(y-endpoint_y[e]);
+      if (dy_sqrd > r_sqrd) continue;
+      double half_width=sqrt(r_sqrd-dy_sqrd);
+      x_start=basic_math::min(x_start,endpoint_x[e]-half_width);
+      x_stop=basic_math::max(x_stop,endpoint_x[e]+half_width);
+      nonempty_flag=true;
+   }
+
+// Rectangle swept along segment.  Along line Y=y, longitudinal
+// coordinate t = (x-ax)*ux + (y-ay)*uy must lie within [0,length]
+// while transverse coordinate s = (x-ax)*uy - (y-ay)*ux must lie
+// within [-band_radius,band_radius]:
+
+   double length=sqrt(sqr(bx-ax)+sqr(by-ay));
+   if (length > 0)
+   {
+      double ux=(bx-ax)/length;
+      double uy=(by-ay)/length;
+      double t_offset=(y-ay)*uy;
+      double s_offset=-(y-ay)*ux;
+
+      double lo=NEGATIVEINFINITY;
+      double hi=POSITIVEINFINITY;
+      if (ux != 0)
+      {
+         double x0=ax-t_offset/ux;
+         double x1=ax+(length-t_offset)/ux;
+         lo=basic_math::max(lo,basic_math::min(x0,x1));
+         hi=basic_math::min(hi,basic_math::max(x0,x1));
+      }
+      else if (t_offset < 0 || t_offset > length)
+      {
+         hi=lo;
+      }
+
+      if (uy != 0)
+      {
+         double x0=ax+(-band_radius-s_offset)/uy;
+         double x1=ax+(band_radius-s_offset)/uy;
+         lo=basic_math::max(lo,basic_math::min(x0,x1));
+         hi=basic_math::min(hi,basic_math::max(x0,x1));
+      }
+      else if (fabs(s_offset) > band_radius)
+      {
+         hi=lo;
+      }
+
+      if (lo < hi)
+      {
+         x_start=basic_math::min(x_start,lo);
+         x_stop=basic_math::max(x_stop,hi);
+         nonempty_flag=true;
+      }
+   }
+   return nonempty_flag;
+}
+
+// ---------------------------------------------------------------------
+// Private member function scan_convert_polygon() fills STL vectors
+// interior_intervals and perimeter_intervals with sorted, disjoint
+// pixel intervals for each row min_py <= py <= max_py.  Interior
+// intervals hold pixels whose centers pass the even-odd crossing test
+// of polygon::point_inside_polygon().  Edges enter an active edge
+// list at their first candidate row and leave it after their last.
+// Perimeter intervals hold pixels whose centers lie within
+// sqrt(deltax**2+deltay**2) of some polygon edge.
+
+template <class A> void TwoDarray<A>::scan_convert_polygon(
+   const polygon& poly,int min_py,int max_py,
+   std::vector<px_intervals>& interior_intervals,
+   std::vector<px_intervals>& perimeter_intervals) const
+{
+   unsigned int n_rows=max_py-min_py+1;
+   interior_intervals.assign(n_rows,px_intervals());
+   perimeter_intervals.assign(n_rows,px_intervals());
+
+   unsigned int nvertices=poly.get_nvertices();
+   if (nvertices==0) return;
+
+   struct polygon_edge
+   {
+         double x_i,y_i,x_j,y_j;
+         int start_py,stop_py;
+         bool operator< (const polygon_edge& e) const
+         {
+            return start_py < e.start_py;
+         }
+   };
+
+   double band_radius=sqrt(sqr(deltax)+sqr(deltay));
+   std::vector<polygon_edge> edges;
+   edges.reserve(nvertices);
+   int px_start,px_stop;
+
+   for (unsigned int i=0, j=nvertices-1; i<nvertices; j=i++)
+   {
+      polygon_edge curr_edge;
+      curr_edge.x_i=poly.get_vertex(i).get(0);
+      curr_edge.y_i=poly.get_vertex(i).get(1);
+      curr_edge.x_j=poly.get_vertex(j).get(0);
+      curr_edge.y_j=poly.get_vertex(j).get(1);
+
+// Rasterize current edge's perimeter band row by row:
+
+      double y_low=basic_math::min(curr_edge.y_i,curr_edge.y_j);
+      double y_high=basic_math::max(curr_edge.y_i,curr_edge.y_j);
+      double v_start=(yhi-(y_high+band_radius))/deltay;
+      double v_stop=(yhi-(y_low-band_radius))/deltay;
+      if (v_start > v_stop) templatefunc::swap(v_start,v_stop);
+      int band_start_py=basic_math::max(min_py,int(floor(v_start))-1);
+      int band_stop_py=basic_math::min(max_py,int(ceil(v_stop))+1);
+      for (int py=band_start_py; py<=band_stop_py; py++)
+      {
+         double x_start,x_stop;
+         if (!perimeter_band_x_interval(
+            curr_edge.x_i,curr_edge.y_i,curr_edge.x_j,curr_edge.y_j,
+            band_radius,fast_py_to_y(py),x_start,x_stop)) continue;
+         x_interval_to_px_interval(x_start,x_stop,true,px_start,px_stop);
+         if (px_start < px_stop)
+         {
+            perimeter_intervals[py-min_py].push_back(
+               std::pair<int,int>(px_start,px_stop));
+         }
+      }
+
+// Horizontal edges never generate crossings:
+
+      if (curr_edge.y_i==curr_edge.y_j) continue;
+      v_start=(yhi-y_high)/deltay;
+      v_stop=(yhi-y_low)/deltay;
+      if (v_start > v_stop) templatefunc::swap(v_start,v_stop);
+      curr_edge.start_py=basic_math::max(min_py,int(floor(v_start))-1);
+      curr_edge.stop_py=basic_math::min(max_py,int(ceil(v_stop))+1);
+      if (curr_edge.start_py > curr_edge.stop_py) continue;
+      edges.push_back(curr_edge);
+   } // loop over indices i,j labeling polygon edges
+
+   std::sort(edges.begin(),edges.end());
+
+   std::vector<const polygon_edge*> active_edges;
+   std::vector<double> crossings;
+   unsigned int next_edge=0;
+   for (int py=min_py; py<=max_py; py++)
+   {
+      while (next_edge < edges.size() && edges[next_edge].start_py <= py)
+      {
+         active_edges.push_back(&edges[next_edge++]);
+      }
+
+      double y=fast_py_to_y(py);
+      crossings.clear();
+      for (int a=int(active_edges.size())-1; a>=0; a--)
+      {
+         const polygon_edge* edge_ptr=active_edges[a];
+         if (edge_ptr->stop_py < py)
+         {
+            active_edges[a]=active_edges.back();
+            active_edges.pop_back();
+            continue;
+         }
+         if ((edge_ptr->y_i > y) != (edge_ptr->y_j > y))
+         {
+            crossings.push_back(
+               (edge_ptr->x_j-edge_ptr->x_i)*(y-edge_ptr->y_i)/
+               (edge_ptr->y_j-edge_ptr->y_i)+edge_ptr->x_i);
+         }
+      }
+      std::sort(crossings.begin(),crossings.end());
+
+// A pixel center at x lies inside the polygon when an odd number of
+// crossings exceed x.  So interior intervals run from even-indexed
+// crossings (inclusive) to odd-indexed crossings (exclusive):
+
+      px_intervals& curr_interior_intervals=interior_intervals[py-min_py];
+      for (unsigned int c=0; c+1<crossings.size(); c += 2)
+      {
+         x_interval_to_px_interval(
+            crossings[c],crossings[c+1],false,px_start,px_stop);
+         if (px_start < px_stop)
+         {
+            curr_interior_intervals.push_back(
+               std::pair<int,int>(px_start,px_stop));
+         }
+      }
+      merge_px_intervals(curr_interior_intervals);
+      merge_px_intervals(perimeter_intervals[py-min_py]);
+   } // loop over py
+}
+
+// ---------------------------------------------------------------------
+// Private static member function merge_px_intervals() sorts input
+// half-open pixel intervals and coalesces those which overlap or
+// abut.
+
+template <class A> void TwoDarray<A>::merge_px_intervals(
+   px_intervals& intervals)
+{
+   if (intervals.size() < 2) return;
+   std::sort(intervals.begin(),intervals.end());
+
+   unsigned int n_merged=0;
+   for (unsigned int i=1; i<intervals.size(); i++)
+   {
+      if (intervals[i].first <= intervals[n_merged].second)
+      {
+         intervals[n_merged].second=basic_math::max(
+            intervals[n_merged].second,intervals[i].second);
+      }
+      else
+      {
+         intervals[++n_merged]=intervals[i];
+      }
+   }
+   intervals.resize(n_merged+1);
+}
+
+// ---------------------------------------------------------------------
+// Private static member function subtract_px_intervals() returns
+// within difference those pixels in sorted, disjoint input intervals
+// which do not belong to sorted, disjoint removed_intervals.
+
+template <class A> void TwoDarray<A>::subtract_px_intervals(
+   const px_intervals& intervals,const px_intervals& removed_intervals,
+   px_intervals& difference)
+{
+   difference.clear();
+   unsigned int r=0;
+   for (unsigned int i=0; i<intervals.size(); i++)
+   {
+      int start=intervals[i].first;
+      int stop=intervals[i].second;
+      while (r < removed_intervals.size() &&
+             removed_intervals[r].second <= start) r++;
+
+      unsigned int q=r;
+      while (start < stop && q < removed_intervals.size() &&
+             removed_intervals[q].first < stop)
+      {
+         if (removed_intervals[q].first > start)
+         {
+            difference.push_back(
+               std::pair<int,int>(start,removed_intervals[q].first));
+         }
+         start=basic_math::max(start,removed_intervals[q].second);
+         q++;
+      }
+      if (start < stop) difference.push_back(std::pair<int,int>(start,stop));
+   } // loop over index i labeling intervals
+}
+
 // ==========================================================================
 // TwoDarray copying methods
 // ==========================================================================
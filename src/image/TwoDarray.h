@@ -6,17 +6,27 @@
 // ==========================================================================
 // Header file for templatized twoDarray class 
 // ==========================================================================
-// Last modified on 9/30/09; 11/14/11; 3/28/14; 4/2/14; 4/5/14
+// Last modified on 9/30/09; 11/14/11; 3/28/14; 4/2/14; 4/5/14; 10/18/26
 // ==========================================================================
 
 #ifndef T_TWODARRAY_H
 #define T_TWODARRAY_H
 
+#include <utility>
+#include <vector>
 #include "math/Genarray.h"
 #include "math/threevector.h"
 class polygon;
 class rotation;
 
+// Horizontal run of pixels min_px <= px <= max_px within row py
+// generated by scanline polygon rasterization:
+
+struct pixel_span
+{
+      unsigned int py,min_px,max_px;
+};
+
 template <class A>
 class TwoDarray:public Genarray<A>
 {
@@ -139,6 +149,20 @@ class TwoDarray:public Genarray<A>
       polygon p_2D[]) const;
    void convert_pixel_to_posn_polygon_vertices(polygon* poly_ptr) const;
 
+// Scanline polygon rasterization methods:
+
+   void compute_polygon_spans(
+      const polygon& poly,std::vector<pixel_span>& inside_spans,
+      std::vector<pixel_span>& perimeter_spans) const;
+   void compute_polygon_spans(
+      bool poly_intersection,int npolys,const polygon p_2D[],
+      std::vector<pixel_span>& spans,bool include_perimeter_flag=false) const;
+   unsigned int fill_polygon_spans(
+      const std::vector<pixel_span>& spans,A value);
+   unsigned int fill_polygon_mask(
+      bool poly_intersection,int npolys,const polygon p_2D[],A value,
+      bool include_perimeter_flag=false);
+
 // Copying methods:
 
    void copy(TwoDarray<A>* zTwoDarray_copy_ptr) const;
@@ -251,6 +275,28 @@ class TwoDarray:public Genarray<A>
    double ylo,yhi,deltay;
 
    void docopy(const TwoDarray<A>& m);
+
+// Half-open [px_start,px_stop) pixel intervals within a single row:
+
+   typedef std::vector<std::pair<int,int> > px_intervals;
+
+   bool polygon_pixel_row_range(
+      int npolys,const polygon p_2D[],double margin,
+      int& min_py,int& max_py) const;
+   void x_interval_to_px_interval(
+      double x_start,double x_stop,bool closed_flag,
+      int& px_start,int& px_stop) const;
+   bool perimeter_band_x_interval(
+      double ax,double ay,double bx,double by,double band_radius,double y,
+      double& x_start,double& x_stop) const;
+   void scan_convert_polygon(
+      const polygon& poly,int min_py,int max_py,
+      std::vector<px_intervals>& interior_intervals,
+      std::vector<px_intervals>& perimeter_intervals) const;
+   static void merge_px_intervals(px_intervals& intervals);
+   static void subtract_px_intervals(
+      const px_intervals& intervals,const px_intervals& removed_intervals,
+      px_intervals& difference);
 };
 
 typedef TwoDarray<double> twoDarray;
@@ -0,0 +1,764 @@
+// ==========================================================================
+// CONVOLUTION_ENGINE class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <algorithm>
+#include <cmath>
+#include "math/basic_math.h"
+#include "image/convolution_engine.h"
+#include "math/genmatrix.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using std::cout;
+using std::endl;
+using std::ostream;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void convolution_engine::initialize_member_objects()
+{
+   method=no_method;
+   n_threads=0;
+   min_fft_kernel_area=256;
+   null_flag=false;
+   null_value=0;
+   fft_xdim=fft_ydim=0;
+   fft_forward=fft_backward=NULL;
+}
+
+convolution_engine::convolution_engine(Border_mode border_mode)
+{
+   initialize_member_objects();
+   this->border_mode=border_mode;
+}
+
+// ---------------------------------------------------------------------
+convolution_engine::~convolution_engine()
+{
+   destroy_fft_plans();
+}
+
+// ---------------------------------------------------------------------
+// FFTW's planner is not reentrant.  So plans are created and destroyed
+// within the same named critical section as gist_descriptor's.
+
+void convolution_engine::destroy_fft_plans()
+{
+   if (fft_forward==NULL) return;
+#pragma omp critical(fftw_planner)
+   {
+      fftwnd_destroy_plan(fft_forward);
+      fftwnd_destroy_plan(fft_backward);
+   }
+   fft_forward=fft_backward=NULL;
+   fft_xdim=fft_ydim=0;
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const convolution_engine& C)
+{
+   outstream << endl;
+   outstream << "border_mode = " << C.get_border_mode()
+             << " method = " << C.get_method()
+             << endl;
+   return outstream;
+}
+
+// ==========================================================================
+// Filtering member functions
+// ==========================================================================
+
+// Member function convolve() applies the 2D kernel within *kernel_ptr
+// to *ztwoDarray_ptr via the cheapest technique which handles the
+// kernel's structure.  Input and output arrays may coincide.
+
+void convolution_engine::convolve(
+   const genmatrix* kernel_ptr,twoDarray const *ztwoDarray_ptr,
+   twoDarray *ztwoDarray_filtered_ptr)
+{
+   vector<double> x_kernel,y_kernel;
+   if (factor_separable_kernel(kernel_ptr,x_kernel,y_kernel))
+   {
+      bool box_flag=true;
+      for (unsigned int i=1; i<x_kernel.size(); i++)
+      {
+         if (x_kernel[i] != x_kernel[0]) box_flag=false;
+      }
+      for (unsigned int j=1; j<y_kernel.size(); j++)
+      {
+         if (y_kernel[j] != y_kernel[0]) box_flag=false;
+      }
+      method=(box_flag ? box_method : separable_method);
+      separable_passes(
+         x_kernel,y_kernel,box_flag,ztwoDarray_ptr,ztwoDarray_filtered_ptr);
+      return;
+   }
+
+   unsigned int kernel_area=kernel_ptr->get_mdim()*kernel_ptr->get_ndim();
+   if (!null_flag && kernel_area >= min_fft_kernel_area)
+   {
+      method=fft_method;
+      fft_convolve(kernel_ptr,ztwoDarray_ptr,ztwoDarray_filtered_ptr);
+   }
+   else
+   {
+      method=direct_method;
+      direct_convolve(kernel_ptr,ztwoDarray_ptr,ztwoDarray_filtered_ptr);
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function separable_convolve() applies the rank-one kernel
+// K(i,j) = x_kernel[i] * y_kernel[j].
+
+void convolution_engine::separable_convolve(
+   const vector<double>& x_kernel,const vector<double>& y_kernel,
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr)
+{
+   method=separable_method;
+   separable_passes(
+      x_kernel,y_kernel,false,ztwoDarray_ptr,ztwoDarray_filtered_ptr);
+}
+
+// ---------------------------------------------------------------------
+// Member functions row_convolve() and column_convolve() apply 1D
+// kernels along the px and py directions.  For interior_only border
+// mode, row_convolve() [column_convolve()] leaves untouched only
+// those pixels lying within x_kernel.size()/2 [y_kernel.size()/2] of
+// the left and right [top and bottom] image borders.
+
+void convolution_engine::row_convolve(
+   const vector<double>& x_kernel,
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr)
+{
+   method=separable_method;
+   if (x_kernel.size()==0) return;
+
+   int n_bands=(ztwoDarray_ptr->get_ndim()+band_size-1)/band_size;
+   int curr_n_threads=get_n_threads();
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(curr_n_threads)
+   for (int b=0; b<n_bands; b++)
+   {
+      unsigned int py_start=b*band_size;
+      unsigned int py_stop=basic_math::min(
+         py_start+band_size,ztwoDarray_ptr->get_ndim());
+      filter_rows(x_kernel,false,py_start,py_stop,
+                  ztwoDarray_ptr,ztwoDarray_filtered_ptr);
+   }
+}
+
+void convolution_engine::column_convolve(
+   const vector<double>& y_kernel,
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr)
+{
+   method=separable_method;
+   if (y_kernel.size()==0) return;
+
+   int n_bands=(ztwoDarray_ptr->get_mdim()+band_size-1)/band_size;
+   int curr_n_threads=get_n_threads();
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(curr_n_threads)
+   for (int b=0; b<n_bands; b++)
+   {
+      unsigned int px_start=b*band_size;
+      unsigned int px_stop=basic_math::min(
+         px_start+band_size,ztwoDarray_ptr->get_mdim());
+      filter_columns(y_kernel,false,px_start,px_stop,
+                     ztwoDarray_ptr,ztwoDarray_filtered_ptr);
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function box_filter() sums intensities within an nx_size x
+// ny_size window about each pixel via running sums whose cost does
+// not depend upon window size.  If normalize_flag==true, sums are
+// divided by the window's area.
+
+void convolution_engine::box_filter(
+   unsigned int nx_size,unsigned int ny_size,
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr,
+   bool normalize_flag)
+{
+   double x_weight=1,y_weight=1;
+   if (normalize_flag)
+   {
+      x_weight=1.0/nx_size;
+      y_weight=1.0/ny_size;
+   }
+   vector<double> x_kernel(nx_size,x_weight);
+   vector<double> y_kernel(ny_size,y_weight);
+
+   method=box_method;
+   separable_passes(
+      x_kernel,y_kernel,true,ztwoDarray_ptr,ztwoDarray_filtered_ptr);
+}
+
+// ---------------------------------------------------------------------
+// Boolean member function factor_separable_kernel() returns true if
+// the kernel within *kernel_ptr equals the outer product of
+// x_kernel and y_kernel to within round-off.  The factors are
+// anchored upon the kernel's largest magnitude entry.
+
+bool convolution_engine::factor_separable_kernel(
+   const genmatrix* kernel_ptr,vector<double>& x_kernel,
+   vector<double>& y_kernel)
+{
+   unsigned int kx=kernel_ptr->get_mdim();
+   unsigned int ky=kernel_ptr->get_ndim();
+   x_kernel.assign(kx,0);
+   y_kernel.assign(ky,1);
+   if (kx==0 || ky==0) return false;
+
+   unsigned int i_max=0,j_max=0;
+   double max_magnitude=0;
+   for (unsigned int i=0; i<kx; i++)
+   {
+      for (unsigned int j=0; j<ky; j++)
+      {
+         double curr_magnitude=fabs(kernel_ptr->get(i,j));
+         if (curr_magnitude > max_magnitude)
+         {
+            max_magnitude=curr_magnitude;
+            i_max=i;
+            j_max=j;
+         }
+      }
+   }
+   if (max_magnitude==0) return true;
+
+   double K_max=kernel_ptr->get(i_max,j_max);
+   for (unsigned int i=0; i<kx; i++)
+   {
+      x_kernel[i]=kernel_ptr->get(i,j_max);
+   }
+   for (unsigned int j=0; j<ky; j++)
+   {
+      y_kernel[j]=kernel_ptr->get(i_max,j)/K_max;
+   }
+
+   const double TINY=1.0E-12;
+   for (unsigned int i=0; i<kx; i++)
+   {
+      for (unsigned int j=0; j<ky; j++)
+      {
+         double residual=kernel_ptr->get(i,j)-x_kernel[i]*y_kernel[j];
+         if (fabs(residual) > TINY*max_magnitude) return false;
+      }
+   }
+   return true;
+}
+
+// ==========================================================================
+// Private helper member functions
+// ==========================================================================
+
+int convolution_engine::get_n_threads() const
+{
+   int curr_n_threads=n_threads;
+#ifdef _OPENMP
+   if (curr_n_threads <= 0) curr_n_threads=omp_get_max_threads();
+#else
+   curr_n_threads=1;
+#endif
+   return curr_n_threads;
+}
+
+// ---------------------------------------------------------------------
+// Member function border_index() maps sample position q onto a pixel
+// index within [0,n) according to the current border mode.  It
+// returns -1 for samples which are treated as zero.
+
+int convolution_engine::border_index(int q,int n) const
+{
+   if (q >= 0 && q < n) return q;
+   if (n <= 0) return -1;
+
+   switch (border_mode)
+   {
+      case replicate_border:
+         return (q < 0 ? 0 : n-1);
+      case reflect_border:
+         if (n==1) return 0;
+         while (q < 0 || q >= n)
+         {
+            if (q < 0) q=-q;
+            if (q >= n) q=2*(n-1)-q;
+         }
+         return q;
+      case wrap_border:
+         q %= n;
+         if (q < 0) q += n;
+         return q;
+      default:
+         return -1;
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function interior_range() returns the range of output pixel
+// indices [p_start,p_stop) which are computed along a direction
+// containing n_pixels.  For interior_only border mode, pixels within
+// kernel_size/2 of either border are excluded.
+
+void convolution_engine::interior_range(
+   unsigned int n_pixels,unsigned int kernel_size,
+   unsigned int& p_start,unsigned int& p_stop) const
+{
+   p_start=0;
+   p_stop=n_pixels;
+   if (border_mode != interior_only) return;
+
+   unsigned int w=kernel_size/2;
+   p_start=w;
+   p_stop=(n_pixels > 2*w ? n_pixels-w : w);
+}
+
+// ---------------------------------------------------------------------
+// Member function filter_rows() applies x_kernel along px to image
+// rows py_start <= py < py_stop.  Rows within the band are gathered
+// together so that reads and writes sweep contiguous memory.
+
+void convolution_engine::filter_rows(
+   const vector<double>& x_kernel,bool box_flag,
+   unsigned int py_start,unsigned int py_stop,
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr) const
+{
+   unsigned int mdim=ztwoDarray_ptr->get_mdim();
+   unsigned int kx=x_kernel.size();
+   unsigned int cx=kx/2;
+   unsigned int n_padded=mdim+kx-1;
+   unsigned int n_rows=py_stop-py_start;
+
+   unsigned int px_start,px_stop;
+   interior_range(mdim,kx,px_start,px_stop);
+   if (px_start >= px_stop) return;
+
+   vector<int> x_index(n_padded);
+   for (unsigned int t=0; t<n_padded; t++)
+   {
+      x_index[t]=border_index(int(t)-int(cx),mdim);
+   }
+
+   vector<vector<double> > lines(n_rows,vector<double>(n_padded,0));
+   vector<vector<bool> > lines_valid(n_rows,vector<bool>(n_padded,true));
+   for (unsigned int t=0; t<n_padded; t++)
+   {
+      int px=x_index[t];
+      for (unsigned int r=0; r<n_rows; r++)
+      {
+         if (px < 0)
+         {
+            lines_valid[r][t]=(border_mode != interior_only);
+            continue;
+         }
+         double z=ztwoDarray_ptr->get(px,py_start+r);
+         lines[r][t]=z;
+         if (null_flag && z <= null_value) lines_valid[r][t]=false;
+      }
+   }
+
+   vector<vector<double> > filtered_lines(n_rows);
+   for (unsigned int r=0; r<n_rows; r++)
+   {
+      filter_line(x_kernel,box_flag,lines[r],lines_valid[r],
+                  px_start,px_stop,filtered_lines[r]);
+   }
+
+   for (unsigned int px=px_start; px<px_stop; px++)
+   {
+      for (unsigned int r=0; r<n_rows; r++)
+      {
+         ztwoDarray_filtered_ptr->put(
+            px,py_start+r,filtered_lines[r][px-px_start]);
+      }
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function filter_columns() applies y_kernel along py to image
+// columns px_start <= px < px_stop.
+
+void convolution_engine::filter_columns(
+   const vector<double>& y_kernel,bool box_flag,
+   unsigned int px_start,unsigned int px_stop,
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr) const
+{
+   unsigned int ndim=ztwoDarray_ptr->get_ndim();
+   unsigned int ky=y_kernel.size();
+   unsigned int cy=ky/2;
+   unsigned int n_padded=ndim+ky-1;
+
+   unsigned int py_start,py_stop;
+   interior_range(ndim,ky,py_start,py_stop);
+   if (py_start >= py_stop) return;
+
+   vector<double> line(n_padded),filtered_line;
+   vector<bool> line_valid(n_padded);
+   for (unsigned int px=px_start; px<px_stop; px++)
+   {
+      for (unsigned int t=0; t<n_padded; t++)
+      {
+         int py=border_index(int(t)-int(cy),ndim);
+         if (py < 0)
+         {
+            line[t]=0;
+            line_valid[t]=(border_mode != interior_only);
+            continue;
+         }
+         double z=ztwoDarray_ptr->get(px,py);
+         line[t]=z;
+         line_valid[t]=!(null_flag && z <= null_value);
+      }
+
+      filter_line(y_kernel,box_flag,line,line_valid,
+                  py_start,py_stop,filtered_line);
+      for (unsigned int py=py_start; py<py_stop; py++)
+      {
+         ztwoDarray_filtered_ptr->put(px,py,filtered_line[py-py_start]);
+      }
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function filter_line() correlates kernel with a padded line
+// whose t-th sample corresponds to pixel t-kernel.size()/2.  Results
+// for pixels p_start <= p < p_stop are returned within filtered_line.
+// Invalid samples are skipped, and outputs whose windows contain no
+// valid samples are set to null_value.  If box_flag==true, the kernel
+// is constant and windows are summed via running sums.
+
+void convolution_engine::filter_line(
+   const vector<double>& kernel,bool box_flag,
+   const vector<double>& line,const vector<bool>& line_valid,
+   unsigned int p_start,unsigned int p_stop,
+   vector<double>& filtered_line) const
+{
+   unsigned int k=kernel.size();
+   filtered_line.resize(p_stop-p_start);
+
+   if (box_flag)
+   {
+      double sum=0;
+      unsigned int n_valid=0;
+      for (unsigned int i=0; i<k; i++)
+      {
+         if (!line_valid[p_start+i]) continue;
+         sum += line[p_start+i];
+         n_valid++;
+      }
+
+      for (unsigned int p=p_start; p<p_stop; p++)
+      {
+         if (p > p_start)
+         {
+            unsigned int t_out=p-1;
+            unsigned int t_in=p+k-1;
+            if (line_valid[t_out])
+            {
+               sum -= line[t_out];
+               n_valid--;
+            }
+            if (line_valid[t_in])
+            {
+               sum += line[t_in];
+               n_valid++;
+            }
+         }
+         filtered_line[p-p_start]=(n_valid > 0 ? kernel[0]*sum : null_value);
+      }
+      return;
+   }
+
+   for (unsigned int p=p_start; p<p_stop; p++)
+   {
+      double sum=0;
+      unsigned int n_valid=0;
+      for (unsigned int i=0; i<k; i++)
+      {
+         if (!line_valid[p+i]) continue;
+         sum += kernel[i]*line[p+i];
+         n_valid++;
+      }
+      filtered_line[p-p_start]=(n_valid > 0 ? sum : null_value);
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function separable_passes() first filters image rows into a
+// temporary array and then filters its columns into the output.
+// Row windows lacking valid samples carry null_value into the column
+// pass where they are skipped.
+
+void convolution_engine::separable_passes(
+   const vector<double>& x_kernel,const vector<double>& y_kernel,
+   bool box_flag,twoDarray const *ztwoDarray_ptr,
+   twoDarray *ztwoDarray_filtered_ptr) const
+{
+   if (x_kernel.size()==0 || y_kernel.size()==0) return;
+
+   unsigned int mdim=ztwoDarray_ptr->get_mdim();
+   unsigned int ndim=ztwoDarray_ptr->get_ndim();
+   twoDarray rows_twoDarray(mdim,ndim);
+
+   int curr_n_threads=get_n_threads();
+   int n_row_bands=(ndim+band_size-1)/band_size;
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(curr_n_threads)
+   for (int b=0; b<n_row_bands; b++)
+   {
+      unsigned int py_start=b*band_size;
+      unsigned int py_stop=basic_math::min(py_start+band_size,ndim);
+      filter_rows(x_kernel,box_flag,py_start,py_stop,
+                  ztwoDarray_ptr,&rows_twoDarray);
+   }
+
+// Only columns computed by the row pass are filtered by the column
+// pass:
+
+   unsigned int px_start,px_stop;
+   interior_range(mdim,x_kernel.size(),px_start,px_stop);
+   if (px_start >= px_stop) return;
+   int n_column_bands=(px_stop-px_start+band_size-1)/band_size;
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(curr_n_threads)
+   for (int b=0; b<n_column_bands; b++)
+   {
+      unsigned int band_start=px_start+b*band_size;
+      unsigned int band_stop=basic_math::min(band_start+band_size,px_stop);
+      filter_columns(y_kernel,box_flag,band_start,band_stop,
+                     &rows_twoDarray,ztwoDarray_filtered_ptr);
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function direct_convolve() sums kernel-weighted samples
+// within every window.  Bands of image rows are processed in
+// parallel.
+
+void convolution_engine::direct_convolve(
+   const genmatrix* kernel_ptr,twoDarray const *ztwoDarray_ptr,
+   twoDarray *ztwoDarray_filtered_ptr) const
+{
+   unsigned int mdim=ztwoDarray_ptr->get_mdim();
+   unsigned int ndim=ztwoDarray_ptr->get_ndim();
+   unsigned int kx=kernel_ptr->get_mdim();
+   unsigned int ky=kernel_ptr->get_ndim();
+   if (kx==0 || ky==0) return;
+   unsigned int cx=kx/2;
+   unsigned int cy=ky/2;
+
+   unsigned int px_start,px_stop,py_start,py_stop;
+   interior_range(mdim,kx,px_start,px_stop);
+   interior_range(ndim,ky,py_start,py_stop);
+   if (px_start >= px_stop || py_start >= py_stop) return;
+
+   vector<int> x_index(mdim+kx-1),y_index(ndim+ky-1);
+   for (unsigned int t=0; t<x_index.size(); t++)
+   {
+      x_index[t]=border_index(int(t)-int(cx),mdim);
+   }
+   for (unsigned int t=0; t<y_index.size(); t++)
+   {
+      y_index[t]=border_index(int(t)-int(cy),ndim);
+   }
+
+   vector<double> kernel(kx*ky);
+   for (unsigned int i=0; i<kx; i++)
+   {
+      for (unsigned int j=0; j<ky; j++)
+      {
+         kernel[i*ky+j]=kernel_ptr->get(i,j);
+      }
+   }
+
+// Write into a temporary array if input and output coincide:
+
+   twoDarray* output_twoDarray_ptr=ztwoDarray_filtered_ptr;
+   if (ztwoDarray_ptr==ztwoDarray_filtered_ptr)
+   {
+      output_twoDarray_ptr=new twoDarray(*ztwoDarray_ptr);
+   }
+
+   int n_bands=(py_stop-py_start+band_size-1)/band_size;
+   int curr_n_threads=get_n_threads();
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(curr_n_threads)
+   for (int b=0; b<n_bands; b++)
+   {
+      unsigned int band_start=py_start+b*band_size;
+      unsigned int band_stop=basic_math::min(band_start+band_size,py_stop);
+      for (unsigned int px=px_start; px<px_stop; px++)
+      {
+         for (unsigned int py=band_start; py<band_stop; py++)
+         {
+            double sum=0;
+            unsigned int n_valid=0;
+            for (unsigned int i=0; i<kx; i++)
+            {
+               int qx=x_index[px+i];
+               if (qx < 0)
+               {
+                  if (border_mode != interior_only) n_valid += ky;
+                  continue;
+               }
+               for (unsigned int j=0; j<ky; j++)
+               {
+                  int qy=y_index[py+j];
+                  if (qy < 0)
+                  {
+                     if (border_mode != interior_only) n_valid++;
+                     continue;
+                  }
+                  double z=ztwoDarray_ptr->get(qx,qy);
+                  if (null_flag && z <= null_value) continue;
+                  sum += kernel[i*ky+j]*z;
+                  n_valid++;
+               } // loop over index j
+            } // loop over index i
+            output_twoDarray_ptr->put(
+               px,py,(n_valid > 0 ? sum : null_value));
+         } // loop over index py
+      } // loop over index px
+   } // loop over index b
+
+   if (output_twoDarray_ptr != ztwoDarray_filtered_ptr)
+   {
+      for (unsigned int px=px_start; px<px_stop; px++)
+      {
+         for (unsigned int py=py_start; py<py_stop; py++)
+         {
+            ztwoDarray_filtered_ptr->put(
+               px,py,output_twoDarray_ptr->get(px,py));
+         }
+      }
+      delete output_twoDarray_ptr;
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function fft_convolve() multiplies the Fourier transforms of
+// the border-padded image and the kernel.  Padded sample (t,s) equals
+// the border-mode sample at (t-cx,s-cy).  Kernel entry K(i,j) is
+// placed at ((-i) mod X, (-j) mod Y) so that circular convolution
+// output (px,py) holds the correlation of K with padded samples
+// starting at (px,py).  Transform dimensions X >= mdim+kx-1 and Y >=
+// ndim+ky-1 are chosen independently, so wrap-around never reaches
+// computed outputs.  Plans are estimated rather than measured, and
+// they persist until the transform dimensions change.
+
+void convolution_engine::fft_convolve(
+   const genmatrix* kernel_ptr,twoDarray const *ztwoDarray_ptr,
+   twoDarray *ztwoDarray_filtered_ptr)
+{
+   unsigned int mdim=ztwoDarray_ptr->get_mdim();
+   unsigned int ndim=ztwoDarray_ptr->get_ndim();
+   unsigned int kx=kernel_ptr->get_mdim();
+   unsigned int ky=kernel_ptr->get_ndim();
+   int cx=kx/2;
+   int cy=ky/2;
+
+   unsigned int px_start,px_stop,py_start,py_stop;
+   interior_range(mdim,kx,px_start,px_stop);
+   interior_range(ndim,ky,py_start,py_stop);
+   if (px_start >= px_stop || py_start >= py_stop) return;
+
+// Find smallest transform sizes whose prime factors are 2, 3 or 5:
+
+   unsigned int transform_dims[2];
+   unsigned int n_mins[2]={mdim+kx-1,ndim+ky-1};
+   for (unsigned int d=0; d<2; d++)
+   {
+      unsigned int N=n_mins[d];
+      while (true)
+      {
+         unsigned int n=N;
+         while (n%2==0) n /= 2;
+         while (n%3==0) n /= 3;
+         while (n%5==0) n /= 5;
+         if (n==1) break;
+         N++;
+      }
+      transform_dims[d]=N;
+   }
+   unsigned int X=transform_dims[0];
+   unsigned int Y=transform_dims[1];
+
+   if (X != fft_xdim || Y != fft_ydim)
+   {
+      destroy_fft_plans();
+#pragma omp critical(fftw_planner)
+      {
+         fft_forward=fftw2d_create_plan(
+            X,Y,FFTW_FORWARD,FFTW_ESTIMATE | FFTW_IN_PLACE | FFTW_THREADSAFE);
+         fft_backward=fftw2d_create_plan(
+            X,Y,FFTW_BACKWARD,FFTW_ESTIMATE | FFTW_IN_PLACE | FFTW_THREADSAFE);
+      }
+      fft_xdim=X;
+      fft_ydim=Y;
+   }
+
+// Arrays are stored in row-major order with index t*Y+s:
+
+   vector<fftw_complex> kernel_tilde(X*Y);
+   for (unsigned int k=0; k<X*Y; k++)
+   {
+      kernel_tilde[k].re=kernel_tilde[k].im=0;
+   }
+   for (unsigned int i=0; i<kx; i++)
+   {
+      unsigned int t=(X-i)%X;
+      for (unsigned int j=0; j<ky; j++)
+      {
+         unsigned int s=(Y-j)%Y;
+         kernel_tilde[t*Y+s].re=kernel_ptr->get(i,j);
+      }
+   }
+   fftwnd_one(fft_forward,&kernel_tilde[0],NULL);
+
+   vector<fftw_complex> data(X*Y);
+   for (unsigned int t=0; t<X; t++)
+   {
+      int px=(t < mdim+kx-1 ? border_index(int(t)-cx,mdim) : -1);
+      for (unsigned int s=0; s<Y; s++)
+      {
+         int py=(s < ndim+ky-1 ? border_index(int(s)-cy,ndim) : -1);
+         double z=0;
+         if (px >= 0 && py >= 0) z=ztwoDarray_ptr->get(px,py);
+         data[t*Y+s].re=z;
+         data[t*Y+s].im=0;
+      }
+   }
+   fftwnd_one(fft_forward,&data[0],NULL);
+
+// FFTW's inverse transform is unnormalized.  So the tilde product is
+// divided by the number of transform samples:
+
+   double normalization=1.0/(double(X)*double(Y));
+   for (unsigned int k=0; k<X*Y; k++)
+   {
+      double re=data[k].re*kernel_tilde[k].re-data[k].im*kernel_tilde[k].im;
+      double im=data[k].re*kernel_tilde[k].im+data[k].im*kernel_tilde[k].re;
+      data[k].re=re*normalization;
+      data[k].im=im*normalization;
+   }
+   fftwnd_one(fft_backward,&data[0],NULL);
+
+   for (unsigned int px=px_start; px<px_stop; px++)
+   {
+      for (unsigned int py=py_start; py<py_stop; py++)
+      {
+         ztwoDarray_filtered_ptr->put(px,py,data[px*Y+py].re);
+      }
+   }
+}
@@ -0,0 +1,206 @@
+// ==========================================================================
+// Header file for CONVOLUTION_ENGINE class which filters twoDarray
+// images with 2D kernels.  Following the convention of
+// imagefunc::brute_twoD_convolve(), kernels are not flipped:
+
+//   out(px,py) = sum_ij K(i,j) * in(px-cx+i, py-cy+j)
+
+// where (cx,cy) = (kx/2,ky/2) denotes the center of a kx x ky kernel
+// whose first index runs along px.
+
+// Rank-one kernels such as gaussians are factored into horizontal and
+// vertical 1D passes which cost kx+ky rather than kx*ky operations
+// per pixel.  Constant rank-one kernels reduce further to running-sum
+// box filters whose cost is independent of kernel size.  Large
+// non-separable kernels are applied in the frequency domain via FFTW
+// plans which each engine creates once per transform size.  Smaller
+// ones are summed directly.  Spatial passes are parallelized over
+// bands of image rows or columns via OpenMP.
+
+// Border modes specify how samples lying outside the image are
+// obtained.  For interior_only, pixels whose kernel windows extend
+// beyond the image are left untouched within the output array.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef CONVOLUTION_ENGINE_H
+#define CONVOLUTION_ENGINE_H
+
+#include <fftw.h>
+#include <iostream>
+#include <vector>
+#include "image/TwoDarray.h"
+
+class genmatrix;
+
+class convolution_engine
+{
+
+  public:
+
+   enum Border_mode
+   {
+      interior_only, zero_border, replicate_border, reflect_border,
+      wrap_border
+   };
+
+   enum Method
+   {
+      no_method, direct_method, separable_method, box_method, fft_method
+   };
+
+   convolution_engine(Border_mode border_mode=interior_only);
+   ~convolution_engine();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const convolution_engine& C);
+
+// Set and get member functions:
+
+   void set_border_mode(Border_mode mode);
+   void set_n_threads(int n);
+   void set_min_fft_kernel_area(unsigned int area);
+   void set_null_value(double z);
+   void clear_null_value();
+
+   Border_mode get_border_mode() const;
+   Method get_method() const;
+
+// Filtering member functions:
+
+   void convolve(
+      const genmatrix* kernel_ptr,twoDarray const *ztwoDarray_ptr,
+      twoDarray *ztwoDarray_filtered_ptr);
+   void separable_convolve(
+      const std::vector<double>& x_kernel,const std::vector<double>& y_kernel,
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr);
+   void row_convolve(
+      const std::vector<double>& x_kernel,
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr);
+   void column_convolve(
+      const std::vector<double>& y_kernel,
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr);
+   void box_filter(
+      unsigned int nx_size,unsigned int ny_size,
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr,
+      bool normalize_flag=true);
+
+   static bool factor_separable_kernel(
+      const genmatrix* kernel_ptr,std::vector<double>& x_kernel,
+      std::vector<double>& y_kernel);
+
+  private:
+
+   static const unsigned int band_size=32;
+
+   Border_mode border_mode;
+   Method method;
+   int n_threads;
+   unsigned int min_fft_kernel_area;
+   bool null_flag;
+   double null_value;
+
+// Frequency domain members.  Plans are reused by successive
+// fft_convolve() calls whose transforms share the same dimensions:
+
+   unsigned int fft_xdim,fft_ydim;
+   fftwnd_plan fft_forward,fft_backward;
+
+   void initialize_member_objects();
+   void destroy_fft_plans();
+
+   int get_n_threads() const;
+   int border_index(int q,int n) const;
+   void interior_range(
+      unsigned int n_pixels,unsigned int kernel_size,
+      unsigned int& p_start,unsigned int& p_stop) const;
+
+   void filter_rows(
+      const std::vector<double>& x_kernel,bool box_flag,
+      unsigned int py_start,unsigned int py_stop,
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr)
+      const;
+   void filter_columns(
+      const std::vector<double>& y_kernel,bool box_flag,
+      unsigned int px_start,unsigned int px_stop,
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr)
+      const;
+   void filter_line(
+      const std::vector<double>& kernel,bool box_flag,
+      const std::vector<double>& line,const std::vector<bool>& line_valid,
+      unsigned int p_start,unsigned int p_stop,
+      std::vector<double>& filtered_line) const;
+   void separable_passes(
+      const std::vector<double>& x_kernel,const std::vector<double>& y_kernel,
+      bool box_flag,twoDarray const *ztwoDarray_ptr,
+      twoDarray *ztwoDarray_filtered_ptr) const;
+   void direct_convolve(
+      const genmatrix* kernel_ptr,twoDarray const *ztwoDarray_ptr,
+      twoDarray *ztwoDarray_filtered_ptr) const;
+   void fft_convolve(
+      const genmatrix* kernel_ptr,twoDarray const *ztwoDarray_ptr,
+      twoDarray *ztwoDarray_filtered_ptr);
+
+// Disallow copying since engines own FFTW plans:
+
+   convolution_engine(const convolution_engine& C);
+   convolution_engine& operator= (const convolution_engine& C);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+// Set and get member functions:
+
+inline void convolution_engine::set_border_mode(Border_mode mode)
+{
+   border_mode=mode;
+}
+
+// If n_threads <= 0, the OpenMP default number of threads is used:
+
+inline void convolution_engine::set_n_threads(int n)
+{
+   n_threads=n;
+}
+
+// Non-separable kernels with at least min_fft_kernel_area entries are
+// applied in the frequency domain:
+
+inline void convolution_engine::set_min_fft_kernel_area(unsigned int area)
+{
+   min_fft_kernel_area=area;
+}
+
+// Once a null value is set, samples whose values do not exceed it
+// contribute nothing to kernel sums.  Windows containing only null
+// samples yield null_value.  Null-aware filtering proceeds via direct
+// sums or 1D passes only:
+
+inline void convolution_engine::set_null_value(double z)
+{
+   null_flag=true;
+   null_value=z;
+}
+
+inline void convolution_engine::clear_null_value()
+{
+   null_flag=false;
+}
+
+inline convolution_engine::Border_mode convolution_engine::get_border_mode()
+   const
+{
+   return border_mode;
+}
+
+// Member function get_method() returns the technique chosen by the
+// most recent filtering call:
+
+inline convolution_engine::Method convolution_engine::get_method() const
+{
+   return method;
+}
+
+#endif  // convolution_engine.h
@@ -1,7 +1,7 @@
 // ==========================================================================
 // GRAPHICSFUNCS stand-alone methods
 // ==========================================================================
-// Last modified on 5/12/15; 6/16/16; 6/17/16; 6/20/16
+// Last modified on 5/12/15; 6/16/16; 6/17/16; 6/20/16; 10/18/26
 // ==========================================================================
 
 #include <algorithm>
@@ -22,6 +22,7 @@
 #include "general/outputfuncs.h"
 #include "geometry/polygon.h"
 #include "math/prob_distribution.h"
+#include "image/recursivefuncs.h"
 #include "datastructures/Stack.h"
 #include "image/TwoDarray.h"
 
@@ -890,7 +891,8 @@ namespace graphicsfunc
 
 // Method mask_boundaryFill returns a dynamically generated twoDarray
 // containing just the filled region with all other pixel values set
-// equal to znull.
+// equal to znull.  As of Oct 2026, the region is colored by
+// recursivefunc::seed_fill() rather than by deprecated basicfill().
 
    twoDarray* mask_boundaryFill(
       double zfill,double znull,const threevector& origin,
@@ -912,7 +914,8 @@ namespace graphicsfunc
       {
          unsigned int px,py;
          ztwoDarray_ptr->point_to_pixel(origin,px,py);
-         npixels_filled=basicfill(px,py,zfill,zmask_twoDarray_ptr);
+         npixels_filled=recursivefunc::seed_fill(
+            px,py,zfill,zmask_twoDarray_ptr);
          imagefunc::particular_cutoff_threshold(
             zfill,zmask_twoDarray_ptr,znull);
       }
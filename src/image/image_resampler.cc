@@ -0,0 +1,391 @@
+// ==========================================================================
+// IMAGE_RESAMPLER class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <cmath>
+#include "image/image_resampler.h"
+#include "math/basic_math.h"
+#include "math/constants.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using std::cout;
+using std::endl;
+using std::ostream;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void image_resampler::initialize_member_objects()
+{
+   n_lanczos_lobes=3;
+   n_threads=0;
+   clamp_flag=false;
+   min_clamp_z=0;
+   max_clamp_z=1;
+}
+
+// ---------------------------------------------------------------------
+image_resampler::image_resampler(Filter filter)
+{
+   initialize_member_objects();
+   this->filter=filter;
+}
+
+// ---------------------------------------------------------------------
+image_resampler::~image_resampler()
+{
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const image_resampler& R)
+{
+   outstream << endl;
+   outstream << "filter = " << R.get_filter()
+             << " n_lanczos_lobes = " << R.get_n_lanczos_lobes()
+             << endl;
+   return outstream;
+}
+
+// ---------------------------------------------------------------------
+// Member function get_n_threads() returns the number of OpenMP
+// threads used for resampling passes.  Non-positive n_threads
+// defaults to all available cores.
+
+int image_resampler::get_n_threads() const
+{
+   int curr_n_threads=n_threads;
+#ifdef _OPENMP
+   if (curr_n_threads <= 0) curr_n_threads=omp_get_max_threads();
+#else
+   curr_n_threads=1;
+#endif
+   return curr_n_threads;
+}
+
+// ==========================================================================
+// Resampling member functions
+// ==========================================================================
+
+// Member function resize() rescales the entire input image to the
+// dimensions of *ztwoDarray_resized_ptr.  Aspect ratios are not
+// preserved.
+
+void image_resampler::resize(
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_resized_ptr)
+{
+   resample_window(
+      0,ztwoDarray_ptr->get_mdim(),0,ztwoDarray_ptr->get_ndim(),
+      ztwoDarray_ptr,ztwoDarray_resized_ptr);
+}
+
+// ---------------------------------------------------------------------
+// Member function resize_and_crop() rescales the input image so that
+// it just covers the dimensions of *ztwoDarray_resized_ptr.  Excess
+// rows or columns are then cropped symmetrically.  The result matches
+// ImageMagick's "convert -resize WxH^" followed by a centered crop.
+// But only the retained window is ever resampled.
+
+void image_resampler::resize_and_crop(
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_resized_ptr)
+{
+   double x_lo,x_hi,y_lo,y_hi;
+   crop_window(
+      ztwoDarray_ptr->get_mdim(),ztwoDarray_ptr->get_ndim(),
+      ztwoDarray_resized_ptr->get_mdim(),ztwoDarray_resized_ptr->get_ndim(),
+      x_lo,x_hi,y_lo,y_hi);
+   resample_window(
+      x_lo,x_hi,y_lo,y_hi,ztwoDarray_ptr,ztwoDarray_resized_ptr);
+}
+
+// ---------------------------------------------------------------------
+// Member function resample_window() maps the continuous input window
+// [x_lo,x_hi] x [y_lo,y_hi] onto every pixel of
+// *ztwoDarray_resized_ptr.  Pixel (px,py) covers [px,px+1] x [py,py+1]
+// within both input and output coordinates.  Rows intersecting the
+// window are first resampled horizontally into an intermediate array.
+// Its columns are then resampled vertically.
+
+void image_resampler::resample_window(
+   double x_lo,double x_hi,double y_lo,double y_hi,
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_resized_ptr)
+{
+   unsigned int mdim=ztwoDarray_ptr->get_mdim();
+   unsigned int ndim=ztwoDarray_ptr->get_ndim();
+   unsigned int output_mdim=ztwoDarray_resized_ptr->get_mdim();
+   unsigned int output_ndim=ztwoDarray_resized_ptr->get_ndim();
+
+   if (mdim==0 || ndim==0 || output_mdim==0 || output_ndim==0 ||
+       x_hi <= x_lo || y_hi <= y_lo)
+   {
+      cout << "Error in image_resampler::resample_window()!" << endl;
+      cout << "mdim = " << mdim << " ndim = " << ndim
+           << " output_mdim = " << output_mdim
+           << " output_ndim = " << output_ndim << endl;
+      cout << "x_lo = " << x_lo << " x_hi = " << x_hi
+           << " y_lo = " << y_lo << " y_hi = " << y_hi << endl;
+      return;
+   }
+
+   Contributions Cx,Cy;
+   compute_contributions(mdim,x_lo,x_hi,output_mdim,Cx);
+   compute_contributions(ndim,y_lo,y_hi,output_ndim,Cy);
+
+   int py_min=ndim-1;
+   int py_max=0;
+   for (unsigned int k=0; k<Cy.indices.size(); k++)
+   {
+      py_min=basic_math::min(py_min,Cy.indices[k]);
+      py_max=basic_math::max(py_max,Cy.indices[k]);
+   }
+   int n_rows=py_max-py_min+1;
+
+   twoDarray* xtwoDarray_ptr=new twoDarray(output_mdim,n_rows);
+   int n_cores=get_n_threads();
+
+#pragma omp parallel for schedule(static) num_threads(n_cores)
+   for (int r=0; r<n_rows; r++)
+   {
+      int py=py_min+r;
+      for (unsigned int px=0; px<output_mdim; px++)
+      {
+         double sum=0;
+         for (int k=Cx.offsets[px]; k<Cx.offsets[px+1]; k++)
+         {
+            sum += Cx.weights[k]*ztwoDarray_ptr->get(Cx.indices[k],py);
+         }
+         xtwoDarray_ptr->put(px,r,sum);
+      }
+   } // loop over index r labeling intermediate rows
+
+#pragma omp parallel for schedule(static) num_threads(n_cores)
+   for (int py=0; py<int(output_ndim); py++)
+   {
+      for (unsigned int px=0; px<output_mdim; px++)
+      {
+         double sum=0;
+         for (int k=Cy.offsets[py]; k<Cy.offsets[py+1]; k++)
+         {
+            sum += Cy.weights[k]*xtwoDarray_ptr->get(
+               px,Cy.indices[k]-py_min);
+         }
+         ztwoDarray_resized_ptr->put(px,py,clamp(sum));
+      }
+   } // loop over index py labeling output rows
+
+   delete xtwoDarray_ptr;
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_contributions() fills the 1D resampling
+// weights which map n_input samples onto n_output samples covering
+// input interval [lo,hi].  When shrinking, filters are stretched by
+// the scale factor so that they integrate over every output sample's
+// footprint.  Indices lying outside [0,n_input) are clamped onto the
+// border.  Weights for each output sample are normalized to unit sum.
+
+void image_resampler::compute_contributions(
+   unsigned int n_input,double lo,double hi,unsigned int n_output,
+   Contributions& C) const
+{
+   double scale=(hi-lo)/n_output;
+   double filter_scale=basic_math::max(scale,1.0);
+   double support=filter_support()*filter_scale;
+
+   C.offsets.clear();
+   C.indices.clear();
+   C.weights.clear();
+   C.offsets.reserve(n_output+1);
+   C.offsets.push_back(0);
+
+   for (unsigned int i=0; i<n_output; i++)
+   {
+      double center=lo+(i+0.5)*scale;
+      int j_start=floor(center-support);
+      int j_stop=ceil(center+support);
+      int k_start=C.indices.size();
+
+      double weight_sum=0;
+      for (int j=j_start; j<=j_stop; j++)
+      {
+         double w;
+         if (filter==area_filter)
+         {
+            double left=basic_math::max(double(j),center-support);
+            double right=basic_math::min(double(j+1),center+support);
+            w=right-left;
+            if (w <= 0) continue;
+         }
+         else
+         {
+            w=filter_value((j+0.5-center)/filter_scale);
+            if (w==0) continue;
+         }
+         int j_clamped=basic_math::max(0,basic_math::min(int(n_input)-1,j));
+         C.indices.push_back(j_clamped);
+         C.weights.push_back(w);
+         weight_sum += w;
+      } // loop over index j labeling input samples
+
+// Degenerate windows fall back to their nearest input sample:
+
+      if (fabs(weight_sum) < 1E-12)
+      {
+         C.indices.resize(k_start);
+         C.weights.resize(k_start);
+         int j=basic_math::max(
+            0,basic_math::min(int(n_input)-1,int(floor(center))));
+         C.indices.push_back(j);
+         C.weights.push_back(1);
+      }
+      else
+      {
+         for (unsigned int k=k_start; k<C.weights.size(); k++)
+         {
+            C.weights[k] /= weight_sum;
+         }
+      }
+      C.offsets.push_back(C.indices.size());
+   } // loop over index i labeling output samples
+}
+
+// ---------------------------------------------------------------------
+// Member function filter_support() returns the half-width of the
+// current filter in units of output samples.
+
+double image_resampler::filter_support() const
+{
+   if (filter==area_filter)
+   {
+      return 0.5;
+   }
+   else if (filter==bilinear_filter)
+   {
+      return 1.0;
+   }
+   else
+   {
+      return n_lanczos_lobes;
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function filter_value() evaluates bilinear and Lanczos
+// filters.  The Lanczos kernel sinc(x) sinc(x/a) is windowed by its
+// a-th zero crossing.
+
+double image_resampler::filter_value(double x) const
+{
+   x=fabs(x);
+   if (filter==bilinear_filter)
+   {
+      return (x < 1) ? 1-x : 0;
+   }
+
+   double a=n_lanczos_lobes;
+   if (x >= a) return 0;
+   if (x < 1E-8) return 1;
+   double pi_x=PI*x;
+   return a*sin(pi_x)*sin(pi_x/a)/(pi_x*pi_x);
+}
+
+// ---------------------------------------------------------------------
+// Static member function crop_window() returns the centered window
+// within an input_width x input_height image which has the same
+// aspect ratio as the output image.  Resampling this window fills
+// the output with no letterboxing.
+
+void image_resampler::crop_window(
+   unsigned int input_width,unsigned int input_height,
+   unsigned int output_width,unsigned int output_height,
+   double& x_lo,double& x_hi,double& y_lo,double& y_hi)
+{
+   double scale=basic_math::max(
+      double(output_width)/input_width,double(output_height)/input_height);
+   double window_width=output_width/scale;
+   double window_height=output_height/scale;
+
+   x_lo=0.5*(input_width-window_width);
+   x_hi=x_lo+window_width;
+   y_lo=0.5*(input_height-window_height);
+   y_hi=y_lo+window_height;
+}
+
+// ---------------------------------------------------------------------
+// Static member function crop() copies the subimage whose upper left
+// corner lies at (px_start,py_start) and whose dimensions equal those
+// of *ztwoDarray_cropped_ptr.
+
+void image_resampler::crop(
+   unsigned int px_start,unsigned int py_start,
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_cropped_ptr)
+{
+   unsigned int output_mdim=ztwoDarray_cropped_ptr->get_mdim();
+   unsigned int output_ndim=ztwoDarray_cropped_ptr->get_ndim();
+   if (px_start+output_mdim > ztwoDarray_ptr->get_mdim() ||
+       py_start+output_ndim > ztwoDarray_ptr->get_ndim())
+   {
+      cout << "Error in image_resampler::crop()!" << endl;
+      cout << "px_start = " << px_start << " py_start = " << py_start
+           << " output_mdim = " << output_mdim
+           << " output_ndim = " << output_ndim << endl;
+      return;
+   }
+
+   for (unsigned int py=0; py<output_ndim; py++)
+   {
+      for (unsigned int px=0; px<output_mdim; px++)
+      {
+         ztwoDarray_cropped_ptr->put(
+            px,py,ztwoDarray_ptr->get(px_start+px,py_start+py));
+      }
+   }
+}
+
+// ==========================================================================
+// Colorspace member functions
+// ==========================================================================
+
+// Static member function RGB_to_luminance() forms the ITU-R BT.601
+// luma of input RGB channels.
+
+void image_resampler::RGB_to_luminance(
+   twoDarray const *RtwoDarray_ptr,twoDarray const *GtwoDarray_ptr,
+   twoDarray const *BtwoDarray_ptr,twoDarray *LtwoDarray_ptr)
+{
+   for (unsigned int py=0; py<LtwoDarray_ptr->get_ndim(); py++)
+   {
+      for (unsigned int px=0; px<LtwoDarray_ptr->get_mdim(); px++)
+      {
+         LtwoDarray_ptr->put(
+            px,py,0.299*RtwoDarray_ptr->get(px,py)+
+            0.587*GtwoDarray_ptr->get(px,py)+
+            0.114*BtwoDarray_ptr->get(px,py));
+      }
+   }
+}
+
+// ---------------------------------------------------------------------
+// Static member function rescale_intensities() maps z -> scale*z +
+// offset for every pixel.
+
+void image_resampler::rescale_intensities(
+   double scale,double offset,twoDarray *ztwoDarray_ptr)
+{
+   for (unsigned int py=0; py<ztwoDarray_ptr->get_ndim(); py++)
+   {
+      for (unsigned int px=0; px<ztwoDarray_ptr->get_mdim(); px++)
+      {
+         ztwoDarray_ptr->put(
+            px,py,scale*ztwoDarray_ptr->get(px,py)+offset);
+      }
+   }
+}
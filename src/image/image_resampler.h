@@ -0,0 +1,164 @@
+// ==========================================================================
+// Header file for IMAGE_RESAMPLER class which resizes, crops and
+// converts decoded image channels held within twoDarrays.  It
+// replaces round trips through ImageMagick's CONVERT utility and
+// temporary image files.
+
+// Output pixel centers are mapped back onto a rectangular window
+// within the input image.  Each output sample is a weighted sum of the
+// input samples lying beneath a filter centered upon its preimage.
+// When shrinking, filters are stretched by the scale factor so that
+// every input pixel contributes.  Area filtering weights input pixels
+// by their overlap with the output pixel's footprint.  Bilinear
+// (triangle) and Lanczos windowed sinc filters are also supported.
+// Since all filters are separable, rows are resampled first and
+// columns second.  Samples falling outside the input image replicate
+// its border pixels.  Both passes are parallelized via OpenMP.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef IMAGE_RESAMPLER_H
+#define IMAGE_RESAMPLER_H
+
+#include <iostream>
+#include <vector>
+#include "image/TwoDarray.h"
+
+class image_resampler
+{
+
+  public:
+
+   enum Filter
+   {
+      area_filter, bilinear_filter, lanczos_filter
+   };
+
+   image_resampler(Filter filter=area_filter);
+   ~image_resampler();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const image_resampler& R);
+
+// Set and get member functions:
+
+   void set_filter(Filter filter);
+   void set_n_lanczos_lobes(unsigned int n);
+   void set_n_threads(int n);
+   void set_clamp_interval(double min_z,double max_z);
+   void clear_clamp_interval();
+
+   Filter get_filter() const;
+   unsigned int get_n_lanczos_lobes() const;
+
+// Resampling member functions:
+
+   void resize(
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_resized_ptr);
+   void resize_and_crop(
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_resized_ptr);
+   void resample_window(
+      double x_lo,double x_hi,double y_lo,double y_hi,
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_resized_ptr);
+
+   static void crop_window(
+      unsigned int input_width,unsigned int input_height,
+      unsigned int output_width,unsigned int output_height,
+      double& x_lo,double& x_hi,double& y_lo,double& y_hi);
+   static void crop(
+      unsigned int px_start,unsigned int py_start,
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_cropped_ptr);
+
+// Colorspace member functions:
+
+   static void RGB_to_luminance(
+      twoDarray const *RtwoDarray_ptr,twoDarray const *GtwoDarray_ptr,
+      twoDarray const *BtwoDarray_ptr,twoDarray *LtwoDarray_ptr);
+   static void rescale_intensities(
+      double scale,double offset,twoDarray *ztwoDarray_ptr);
+
+  private:
+
+   Filter filter;
+   unsigned int n_lanczos_lobes;
+   int n_threads;
+   bool clamp_flag;
+   double min_clamp_z,max_clamp_z;
+
+// Contributions to output sample i are held within entries offsets[i]
+// through offsets[i+1]-1 of indices and weights:
+
+   struct Contributions
+   {
+      std::vector<int> offsets,indices;
+      std::vector<double> weights;
+   };
+
+   void initialize_member_objects();
+
+   int get_n_threads() const;
+   double filter_support() const;
+   double filter_value(double x) const;
+   void compute_contributions(
+      unsigned int n_input,double lo,double hi,unsigned int n_output,
+      Contributions& C) const;
+   double clamp(double z) const;
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+// Set and get member functions:
+
+inline void image_resampler::set_filter(Filter filter)
+{
+   this->filter=filter;
+}
+
+inline void image_resampler::set_n_lanczos_lobes(unsigned int n)
+{
+   n_lanczos_lobes=n;
+}
+
+inline void image_resampler::set_n_threads(int n)
+{
+   n_threads=n;
+}
+
+// Lanczos filters have negative lobes and may overshoot the input's
+// intensity range.  Output samples are then clamped to [min_z,max_z]:
+
+inline void image_resampler::set_clamp_interval(double min_z,double max_z)
+{
+   clamp_flag=true;
+   min_clamp_z=min_z;
+   max_clamp_z=max_z;
+}
+
+inline void image_resampler::clear_clamp_interval()
+{
+   clamp_flag=false;
+}
+
+inline image_resampler::Filter image_resampler::get_filter() const
+{
+   return filter;
+}
+
+inline unsigned int image_resampler::get_n_lanczos_lobes() const
+{
+   return n_lanczos_lobes;
+}
+
+// Private inlined methods:
+
+inline double image_resampler::clamp(double z) const
+{
+   if (!clamp_flag) return z;
+   if (z < min_clamp_z) return min_clamp_z;
+   if (z > max_clamp_z) return max_clamp_z;
+   return z;
+}
+
+#endif  // image_resampler.h
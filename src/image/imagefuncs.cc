@@ -1,15 +1,17 @@
 // ==========================================================================
 // IMAGEFUNCS stand-alone methods
 // ==========================================================================
-// Last modified on 3/31/16; 4/8/16; 6/1/16; 8/2/16
+// Last modified on 3/31/16; 4/8/16; 6/1/16; 8/2/16; 10/18/26
 // ==========================================================================
 
 #include <algorithm>	
 #include <iostream>
+#include <limits>
 #include <unistd.h>	// Needed for sleep command
 #include "math/adv_mathfuncs.h"
 #include "color/colorfuncs.h"
 #include "image/compositefuncs.h"
+#include "image/convolution_engine.h"
 #include "geometry/convexhull.h"
 #include "datastructures/dataarray.h"
 #include "delaunay/delaunay.h"
@@ -30,6 +32,7 @@
 #include "plot/plotfuncs.h"
 #include "geometry/polygon.h"
 #include "math/prob_distribution.h"
+#include "image/rank_filter.h"
 #include "general/stringfuncs.h"
 #include "general/sysfuncs.h"
 #include "video/texture_rectangle.h"
@@ -730,83 +733,70 @@ namespace imagefunc
       twoDarray const *ztwoDarray_ptr,twoDarray const *zbinary_twoDarray_ptr,
       const polygon& p_3D,double black_pixel_penalty,double& area_integral)
       {
-         unsigned int min_px,min_py,max_px,max_py;
          polygon p_2D=p_3D.xy_projection();
-         ztwoDarray_ptr->locate_extremal_xy_pixels(
-            p_2D,min_px,min_py,max_px,max_py);
+         vector<pixel_span> inside_spans,perimeter_spans;
+         ztwoDarray_ptr->compute_polygon_spans(
+            p_2D,inside_spans,perimeter_spans);
 
-// Integrate intensity_values of pixels enclosed within p_2D:
+// Integrate intensity_values of pixels enclosed within p_2D.
+// Interior pixels contribute their full area while perimeter pixels
+// contribute half their area:
 
-         bool pixel_inside_poly,pixel_outside_poly,pixel_on_perimeter;
+         double pixel_area=ztwoDarray_ptr->get_deltax()*
+            ztwoDarray_ptr->get_deltay();
          area_integral=0;
          double intensity_surface_integral=0;
-         threevector currpoint;
-         for (unsigned int px=basic_math::max(Unsigned_Zero,min_px-1); 
-              px<basic_math::min(max_px+1,ztwoDarray_ptr->
-              get_mdim()); px++)
+         for (unsigned int pass=0; pass<2; pass++)
          {
-            for (unsigned int py=basic_math::max(Unsigned_Zero,min_py-1); 
-                 py<basic_math::min(max_py+1,ztwoDarray_ptr->get_ndim()); py++)
+            const vector<pixel_span>& spans=
+               (pass==0 ? inside_spans : perimeter_spans);
+            double dA=(pass==0 ? pixel_area : 0.5*pixel_area);
+            for (unsigned int s=0; s<spans.size(); s++)
             {
-               ztwoDarray_ptr->pixel_relative_to_poly(
-                  px,py,currpoint,p_2D,pixel_inside_poly,pixel_outside_poly,
-                  pixel_on_perimeter);
-
-               double dA=0;
-               if (pixel_outside_poly)
-               {
-                  dA=0;
-               }
-               else if (pixel_inside_poly)
-               {
-                  dA=ztwoDarray_ptr->get_deltax()*
-                     ztwoDarray_ptr->get_deltay();
-               }
-               else if (pixel_on_perimeter)
+               unsigned int py=spans[s].py;
+               for (unsigned int px=spans[s].min_px; px<=spans[s].max_px; 
+                    px++)
                {
-                  dA=0.5*ztwoDarray_ptr->get_deltax()*
-                     ztwoDarray_ptr->get_deltay();
-               }
-         
-               area_integral += dA;
-               if (black_pixel_penalty==0)
-               {
-                  intensity_surface_integral += ztwoDarray_ptr->get(px,py)*dA;
-               }
-               else
-               {
-                  if (zbinary_twoDarray_ptr->get(px,py) > 0)
+                  area_integral += dA;
+                  if (black_pixel_penalty==0)
                   {
-                     intensity_surface_integral += ztwoDarray_ptr->
-                        get(px,py)*dA;
+                     intensity_surface_integral += 
+                        ztwoDarray_ptr->get(px,py)*dA;
                   }
                   else
                   {
-                     intensity_surface_integral -= black_pixel_penalty*dA;
+                     if (zbinary_twoDarray_ptr->get(px,py) > 0)
+                     {
+                        intensity_surface_integral += ztwoDarray_ptr->
+                           get(px,py)*dA;
+                     }
+                     else
+                     {
+                        intensity_surface_integral -= black_pixel_penalty*dA;
+                     }
                   }
-               }
-            }	   // py loop
-         }	// px loop
+               } // loop over px
+            } // loop over index s labeling spans
+         } // loop over pass
          return intensity_surface_integral;
       }
 
 // ---------------------------------------------------------------------
 // Method surface_integral_inside_n_polgyons takes in an array of
 // polygons p_3D and projects each member down onto the x-y plane.
-// The vertices of a bounding box surrounding all of the polygons' 2D
-// projections p_2D are next determined.  This method then scans
-// through each pixel within the bounding box.  If the pixel lies
-// inside either the intersection of of the polygons in p_2D, the
-// contribution of that pixel is added to the integrated flux of
-// zarray through the common intersection of all the polygons.
+// The intersection or union of the polygons' 2D projections p_2D is
+// then rasterized into pixel spans.  The contribution of each spanned
+// pixel is added to the integrated flux of zarray through the
+// intersection or union of all the polygons.  If poly_intersection
+// and poly_union both equal true, the union is integrated since it
+// contains the intersection.
 
    double surface_integral_inside_n_polygons(
       bool poly_intersection,bool poly_union,unsigned int npolys,
       double zminimum,twoDarray const *ztwoDarray_ptr,const polygon p_3D[],
       double black_pixel_penalty,double& area_integral)
       {
-         bool pixel_inside_all_polys,pixel_inside_at_least_one_poly;
-         double intensity_surface_integral,dA;
+         double intensity_surface_integral;
 
          polygon p_2D[npolys];
 
@@ -817,41 +807,24 @@ namespace imagefunc
             p_2D[n]=p_3D[n].xy_projection();
          }
 
-// Next locate extremal bounding box points which enclose either
-// intersection or union of all polygons inside p_2D array:
-
-         unsigned int min_px,min_py,max_px,max_py;
-         ztwoDarray_ptr->locate_extremal_xy_pixels(
-            poly_intersection,poly_union,npolys,
-            p_2D,min_px,min_py,max_px,max_py);
-
-// Scan through each pixel in bounding box.  If a given pixel lies
-// inside all [at least one] of the polygons within the p_2D array,
-// include its contribution to the total flux surface integral if
-// poly_intersection [poly_union] flag equals true:
+// Rasterize either intersection or union of all polygons inside p_2D
+// array into pixel spans.  Include each spanned pixel's contribution
+// to the total flux surface integral:
 
+         vector<pixel_span> spans;
+         if (poly_intersection || poly_union)
+         {
+            ztwoDarray_ptr->compute_polygon_spans(
+               !poly_union,npolys,p_2D,spans);
+         }
 
          area_integral=intensity_surface_integral=0;
-         threevector currpoint;
-
-         for (unsigned int px=min_px-1; px<max_px+1; px++)
+         double dA=ztwoDarray_ptr->get_deltax()*ztwoDarray_ptr->get_deltay();
+         for (unsigned int s=0; s<spans.size(); s++)
          {
-            for (unsigned int py=min_py-1; py<max_py+1; py++)
+            unsigned int py=spans[s].py;
+            for (unsigned int px=spans[s].min_px; px<=spans[s].max_px; px++)
             {
-               ztwoDarray_ptr->pixel_inside_n_polys(
-                  px,py,currpoint,npolys,p_2D,
-                  pixel_inside_all_polys,pixel_inside_at_least_one_poly);
-               if ((poly_intersection &&  pixel_inside_all_polys) ||
-                   (poly_union && pixel_inside_at_least_one_poly))
-               {
-                  dA=ztwoDarray_ptr->get_deltax()*ztwoDarray_ptr->
-                     get_deltay();
-               }
-               else 
-               {
-                  dA=0;
-               }
-
                area_integral += dA;
                if (black_pixel_penalty==0)
                {
@@ -869,8 +842,8 @@ namespace imagefunc
                      intensity_surface_integral -= black_pixel_penalty*dA;
                   }
                }
-            }	   // py loop
-         }	// px loop
+            } // loop over px
+         } // loop over index s labeling spans
          return intensity_surface_integral;
       }
 
@@ -903,31 +876,34 @@ namespace imagefunc
 // Next locate extremal bounding box points which enclose either
 // intersection or union of all polygons inside p_2D array:
 
-         unsigned int min_px,min_py,max_px,max_py;
-         ztwoDarray_ptr->locate_extremal_xy_pixels(
-            poly_intersection,poly_union,npolys,
-            p_2D,min_px,min_py,max_px,max_py);
+// Rasterize union of all polygons inside p_2D array into pixel spans.
+// Include each spanned pixel's contribution to the total moment
+// integral:
 
-// Scan through each pixel in bounding box.  If a given pixel lies
-// inside all [at least one] of the polygons within the p_2D array,
-// include its contribution to the total flux surface integral if
-// poly_intersection [poly_union] flag equals true:
+         vector<pixel_span> spans;
+         ztwoDarray_ptr->compute_polygon_spans(false,npolys,p_2D,spans);
 
          double intensity_surface_integral=0;
          area_integral=0;
+         double dA=ztwoDarray_ptr->get_deltax()*ztwoDarray_ptr->get_deltay();
          threevector currpoint;
-         for (unsigned int px=min_px-1; px<max_px+1; px++)
+         for (unsigned int s=0; s<spans.size(); s++)
          {
-            for (unsigned int py=min_py-1; py<max_py+1; py++)
+            unsigned int py=spans[s].py;
+            for (unsigned int px=spans[s].min_px; px<=spans[s].max_px; px++)
             {
-               if (ztwoDarray_ptr->pixel_inside_at_least_one_of_n_polys(
-                  px,py,currpoint,npolys,p_2D))
+               ztwoDarray_ptr->pixel_to_point(px,py,currpoint);
+               area_integral += dA;
+               double bperp=l.point_to_line_distance(currpoint);
+               if (black_pixel_penalty==0)
                {
-                  double dA=ztwoDarray_ptr->get_deltax()*ztwoDarray_ptr->
-                     get_deltay();
-                  area_integral += dA;
-                  double bperp=l.point_to_line_distance(currpoint);
-                  if (black_pixel_penalty==0)
+                  intensity_surface_integral += 
+                     ztwoDarray_ptr->get(px,py)*
+                     mathfunc::real_power(bperp,moment_order)*dA;
+               }
+               else
+               {
+                  if (ztwoDarray_ptr->get(px,py) > zminimum)
                   {
                      intensity_surface_integral += 
                         ztwoDarray_ptr->get(px,py)*
@@ -935,22 +911,13 @@ namespace imagefunc
                   }
                   else
                   {
-                     if (ztwoDarray_ptr->get(px,py) > zminimum)
-                     {
-                        intensity_surface_integral += 
-                           ztwoDarray_ptr->get(px,py)*
-                           mathfunc::real_power(bperp,moment_order)*dA;
-                     }
-                     else
-                     {
-                        intensity_surface_integral -= 
-                           black_pixel_penalty*
-                           mathfunc::real_power(bperp,moment_order)*dA;
-                     }
+                     intensity_surface_integral -= 
+                        black_pixel_penalty*
+                        mathfunc::real_power(bperp,moment_order)*dA;
                   }
                }
-            }	   // py loop
-         }	// px loop
+            } // loop over px
+         } // loop over index s labeling spans
 
          return intensity_surface_integral;
       }
@@ -1125,9 +1092,9 @@ namespace imagefunc
 
 // ---------------------------------------------------------------------
 // This overloaded version of method
-// intensity_distribution_inside_polygon is generally much slower than
-// the newer one above.  It scans through the pixels located within
-// the input 2D xy projection p_2D of input polygon p_3D.  It computes
+// intensity_distribution_inside_polygon requires no precomputed mask.
+// It scans through the pixel spans located within the input 2D xy
+// projection p_2D of input polygon p_3D.  It computes
 // a probability distribution for those pixels' intensities between
 // some zmin intensity value and maxz.  If no pixels inside or on the
 // perimeter of the projected polygon p_2D exist, this boolean method
@@ -1140,68 +1107,47 @@ namespace imagefunc
          const int n_output_bins=30;  // Number of bins in probability dist
    
          polygon p_2D=p_3D.xy_projection();
-         unsigned int min_px,min_py,max_px,max_py;
-         ztwoDarray_ptr->locate_extremal_xy_pixels(
-            p_2D,min_px,min_py,max_px,max_py);
+         vector<pixel_span> inside_spans,perimeter_spans;
+         ztwoDarray_ptr->compute_polygon_spans(
+            p_2D,inside_spans,perimeter_spans);
 
-         bool pixel_inside_poly,pixel_outside_poly,pixel_on_perimeter;
-         int npixels_inside_poly=0;
-         double intensity[
-            (max_px-min_px+1)*(max_py-min_py+1)];
-         threevector currpoint;
-         for (unsigned int px=basic_math::max(Unsigned_Zero,min_px-1); 
-              px<basic_math::min(ztwoDarray_ptr->get_mdim(),
-                                 max_px+1); px++)
+         vector<double> intensity;
+         for (unsigned int s=0; s<inside_spans.size(); s++)
          {
-            for (unsigned int py=basic_math::max(Unsigned_Zero,min_py-1); 
-                 py<basic_math::min(ztwoDarray_ptr->get_ndim(),
-                                    max_py+1); py++)
+            unsigned int py=inside_spans[s].py;
+            for (unsigned int px=inside_spans[s].min_px; 
+                 px<=inside_spans[s].max_px; px++)
             {
-               ztwoDarray_ptr->pixel_relative_to_poly(
-                  px,py,currpoint,p_2D,pixel_inside_poly,pixel_outside_poly,
-                  pixel_on_perimeter);
-               if (pixel_inside_poly && ztwoDarray_ptr->get(px,py) > zmin)
-               {
-                  intensity[npixels_inside_poly]=ztwoDarray_ptr->get(px,py);
-                  npixels_inside_poly++;
-               }
-            }	   // py loop
-         }	// px loop
+               if (ztwoDarray_ptr->get(px,py) > zmin)
+                  intensity.push_back(ztwoDarray_ptr->get(px,py));
+            } // loop over px
+         } // loop over index s labeling spans
 
-// If npixels_inside_poly still equals 0, then 2D projection p_2D of
-// the input 3D polygon p_3D is so thin that all interior pixels are
-// classified as lying on the perimeter.  In this case, we redo the
-// intensity computation taking into account pixels lying on the
-// perimeter of p_2D:
+// If intensity is still empty, then 2D projection p_2D of the input
+// 3D polygon p_3D is so thin that all interior pixels are classified
+// as lying on the perimeter.  In this case, we redo the intensity
+// computation taking into account pixels lying on the perimeter of
+// p_2D:
 
-         if (npixels_inside_poly==0)
+         if (intensity.size()==0)
          {
-            for (unsigned int px=basic_math::max(Unsigned_Zero,min_px-1); 
-                 px<basic_math::min(ztwoDarray_ptr->get_mdim(),
-                                    max_px+1); px++)
+            for (unsigned int s=0; s<perimeter_spans.size(); s++)
             {
-               for (unsigned int py=basic_math::max(Unsigned_Zero,min_py-1); 
-                    py<basic_math::min(ztwoDarray_ptr->get_ndim(),
-                                       max_py+1); py++)
+               unsigned int py=perimeter_spans[s].py;
+               for (unsigned int px=perimeter_spans[s].min_px; 
+                    px<=perimeter_spans[s].max_px; px++)
                {
-                  ztwoDarray_ptr->pixel_relative_to_poly(
-                     px,py,currpoint,p_2D,pixel_inside_poly,
-                     pixel_outside_poly,pixel_on_perimeter);
-
-                  if (pixel_on_perimeter && ztwoDarray_ptr->get(px,py) > zmin)
-                  {
-                     intensity[npixels_inside_poly]=
-                        ztwoDarray_ptr->get(px,py);
-                     npixels_inside_poly++;
-                  }
-               } // py loop
-            }	// px loop
+                  if (ztwoDarray_ptr->get(px,py) > zmin)
+                     intensity.push_back(ztwoDarray_ptr->get(px,py));
+               } // loop over px
+            } // loop over index s labeling spans
          }
 
+         int npixels_inside_poly=intensity.size();
          bool distribution_calculated_successfully=false;
          if (npixels_inside_poly > 0)
          {
-            prob.fill_existing_distribution(npixels_inside_poly,intensity,
+            prob.fill_existing_distribution(npixels_inside_poly,&intensity[0],
                                             n_output_bins);
 //            prob.cumulativefilenamestr=imagedir+"poly_intensity"
 //               +stringfunc::number_to_string(imagenumber)+".meta";
@@ -1232,13 +1178,10 @@ namespace imagefunc
 // ---------------------------------------------------------------------
 // Method intensity_distribution_inside_n_polys takes in an array of
 // polygons p_2D which are assumed to be projected within the xy
-// plane.  The vertices of a bounding box surrounding all of the
-// projected polygons are next determined.  This method then scans
-// through each pixel within the bounding box.  If the pixel lies
-// inside either the intersection or union of the polygons in p_2D,
-// the contribution of that pixel is added to the intensity
-// probability distribution, provided the pixel's intensity exceeds
-// some specified zmin intensity value.
+// plane.  The union of the projected polygons is rasterized into
+// pixel spans.  The contribution of each spanned pixel is added to
+// the intensity probability distribution, provided the pixel's
+// intensity exceeds some specified zmin intensity value.
 
    void intensity_distribution_inside_n_polys(
       bool poly_intersection,bool poly_union,
@@ -1247,42 +1190,28 @@ namespace imagefunc
       {
          const int n_output_bins=30;	// Number of bins in probability dist
    
-// Next locate extremal bounding box points which enclose either
-// intersection or union of all polygons inside p_2D array:
-
-         unsigned int min_px,min_py,max_px,max_py;
-         ztwoDarray_ptr->locate_extremal_xy_pixels(
-            poly_intersection,poly_union,npolys,
-            p_2D,min_px,min_py,max_px,max_py);
+// Rasterize union of all polygons inside p_2D array into pixel spans.
+// Include each spanned pixel's contribution to the intensity
+// distribution:
 
-// Scan through each pixel in bounding box.  If a given pixel lies
-// inside all [at least one] of the polygons within the p_2D array,
-// include its contribution to the intensity distribution if
-// poly_intersection [poly_union] flag equals true:
+         vector<pixel_span> spans;
+         ztwoDarray_ptr->compute_polygon_spans(false,npolys,p_2D,spans);
 
          int npixels_inside_poly=0;
-         threevector currpoint;
          double intensity[
             ztwoDarray_ptr->get_mdim()*ztwoDarray_ptr->get_ndim()];
-         for (unsigned int px=basic_math::max(Unsigned_Zero,min_px-1); 
-              px<basic_math::min(ztwoDarray_ptr->get_mdim(),
-                                 max_px+1); px++)
+         for (unsigned int s=0; s<spans.size(); s++)
          {
-            for (unsigned int py=basic_math::max(Unsigned_Zero,min_py-1); 
-                 py<basic_math::min(ztwoDarray_ptr->get_ndim(),
-                                    max_py+1); py++)
+            unsigned int py=spans[s].py;
+            for (unsigned int px=spans[s].min_px; px<=spans[s].max_px; px++)
             {
                if (ztwoDarray_ptr->get(px,py) > zmin)
                {
-                  if (ztwoDarray_ptr->pixel_inside_at_least_one_of_n_polys(
-                     px,py,currpoint,npolys,p_2D))
-                  {
-                     intensity[npixels_inside_poly++]=ztwoDarray_ptr->
-                        get(px,py);
-                  }
+                  intensity[npixels_inside_poly++]=ztwoDarray_ptr->
+                     get(px,py);
                }
-            }	   // py loop
-         }	// px loop
+            } // loop over px
+         } // loop over index s labeling spans
 
          prob.fill_existing_distribution(
             npixels_inside_poly,intensity,n_output_bins);
@@ -1328,14 +1257,18 @@ namespace imagefunc
             poly_intersection,poly_union,npolys,
             p_2D,min_px,min_py,max_px,max_py);
 
-// Scan through each pixel in image.  If a given pixel lies outside
-// all of the polygons within the p_2D array, include its contribution
-// to the intensity distribution:
+// Rasterize the union of all polygons within the p_2D array into a
+// binary mask.  Then scan through each pixel in the bounding box.  If
+// a given pixel lies outside all of the polygons, include its
+// contribution to the intensity distribution:
+
+         twoDarray* zmask_twoDarray_ptr=new twoDarray(ztwoDarray_ptr);
+         zmask_twoDarray_ptr->clear_values();
+         zmask_twoDarray_ptr->fill_polygon_mask(
+            poly_intersection,npolys,p_2D,1);
 
-         bool pixel_inside_all_polys,pixel_inside_at_least_one_poly;
          int npixels_outside_polys=0;
          double intensity[(max_px-min_px+1)*(max_py-min_py+1)];
-         threevector currpoint;
          for (unsigned int px=basic_math::max(Unsigned_Zero,min_px-1); 
               px<basic_math::min(ztwoDarray_ptr->get_mdim(),
                                  max_px+1); px++)
@@ -1344,17 +1277,15 @@ namespace imagefunc
                  py<basic_math::min(ztwoDarray_ptr->get_ndim(),
                                     max_py+1); py++)
             {
-               ztwoDarray_ptr->pixel_inside_n_polys(
-                  px,py,currpoint,npolys,p_2D,
-                  pixel_inside_all_polys,pixel_inside_at_least_one_poly);
-               if (!pixel_inside_at_least_one_poly && ztwoDarray_ptr->
-                   get(px,py) > zmin)
+               if (zmask_twoDarray_ptr->get(px,py)==0 && 
+                   ztwoDarray_ptr->get(px,py) > zmin)
                {
                   intensity[npixels_outside_polys]=ztwoDarray_ptr->get(px,py);
                   npixels_outside_polys++;
                }
             }	   // py loop
          }	// px loop
+         delete zmask_twoDarray_ptr;
 
          prob.fill_existing_distribution(
             npixels_outside_polys,intensity,n_output_bins);
@@ -1590,32 +1521,26 @@ namespace imagefunc
    void threshold_intensities_inside_poly(
       polygon& poly,double hot_threshold,twoDarray* ztwoDarray_ptr)
       {
-         bool inside_poly,outside_poly,on_perimeter;
-         unsigned int min_px,min_py,max_px,max_py;
 //         int n_cold_pixels=0;
 //         int n_nonzero_pixels=0;
-         threevector currpoint;
-
-         ztwoDarray_ptr->locate_extremal_xy_pixels(
-            poly,min_px,min_py,max_px,max_py);
-         for (unsigned int i=min_px; i<max_px; i++)
-         {
-            for (unsigned int j=min_py; j<max_py; j++)
+         vector<pixel_span> inside_spans,perimeter_spans;
+         ztwoDarray_ptr->compute_polygon_spans(
+            poly,inside_spans,perimeter_spans);
+         for (unsigned int s=0; s<inside_spans.size(); s++)
+         {
+            unsigned int j=inside_spans[s].py;
+            for (unsigned int i=inside_spans[s].min_px; 
+                 i<=inside_spans[s].max_px; i++)
             {
-               ztwoDarray_ptr->pixel_relative_to_poly(
-                  i,j,currpoint,poly,inside_poly,outside_poly,on_perimeter);
-               if (inside_poly)
-               {
-                  double currz=ztwoDarray_ptr->get(i,j);
+               double currz=ztwoDarray_ptr->get(i,j);
 //            if (currz > 0) n_nonzero_pixels++;
-                  if (currz < hot_threshold)
-                  {
+               if (currz < hot_threshold)
+               {
 //               if (currz > 0) n_cold_pixels++;
-                     ztwoDarray_ptr->put(i,j,0);
-                  }
+                  ztwoDarray_ptr->put(i,j,0);
                }
             } // loop over index i
-         }  // loop over index j
+         }  // loop over index s labeling spans
 
 //   cout << "At end of myimage::threshold_zarray_inside_poly()" << endl;
 //   cout << "ztwoDarray_ptr->get_mdim() = " << ztwoDarray_ptr->get_mdim() 
@@ -2380,50 +2305,40 @@ namespace imagefunc
    int count_pixels_above_zmin_inside_poly(
       double zmin,polygon& poly,twoDarray const *ztwoDarray_ptr) 
       {
-         unsigned int min_px,min_py,max_px,max_py;
-         ztwoDarray_ptr->locate_extremal_xy_pixels(
-            poly,min_px,min_py,max_px,max_py);
+         vector<pixel_span> inside_spans,perimeter_spans;
+         ztwoDarray_ptr->compute_polygon_spans(
+            poly,inside_spans,perimeter_spans);
 
-         bool inside_poly,outside_poly,on_perimeter;
          int npixels_above_zmin=0;
-         threevector currpoint;
-         for (unsigned int i=min_px; i<max_px; i++)
+         for (unsigned int s=0; s<inside_spans.size(); s++)
          {
-            for (unsigned int j=min_py; j<max_py; j++)
+            unsigned int j=inside_spans[s].py;
+            for (unsigned int i=inside_spans[s].min_px; 
+                 i<=inside_spans[s].max_px; i++)
             {
-               ztwoDarray_ptr->pixel_relative_to_poly(
-                  i,j,currpoint,poly,inside_poly,outside_poly,on_perimeter);
-               if (inside_poly)
-               {
-                  if (ztwoDarray_ptr->get(i,j) > zmin) npixels_above_zmin++;
-               }
+               if (ztwoDarray_ptr->get(i,j) > zmin) npixels_above_zmin++;
             } // loop over index i
-         }  // loop over index j
+         }  // loop over index s labeling spans
          return npixels_above_zmin;
       }
 
    int count_pixels_below_zmax_inside_poly(
       double zmax,polygon& poly,twoDarray const *ztwoDarray_ptr) 
       {
-         unsigned int min_px,min_py,max_px,max_py;
-         ztwoDarray_ptr->locate_extremal_xy_pixels(
-            poly,min_px,min_py,max_px,max_py);
+         vector<pixel_span> inside_spans,perimeter_spans;
+         ztwoDarray_ptr->compute_polygon_spans(
+            poly,inside_spans,perimeter_spans);
 
-         bool inside_poly,outside_poly,on_perimeter;
          int npixels_below_zmax=0;
-         threevector currpoint;
-         for (unsigned int i=min_px; i<max_px; i++)
+         for (unsigned int s=0; s<inside_spans.size(); s++)
          {
-            for (unsigned int j=min_py; j<max_py; j++)
+            unsigned int j=inside_spans[s].py;
+            for (unsigned int i=inside_spans[s].min_px; 
+                 i<=inside_spans[s].max_px; i++)
             {
-               ztwoDarray_ptr->pixel_relative_to_poly(
-                  i,j,currpoint,poly,inside_poly,outside_poly,on_perimeter);
-               if (inside_poly)
-               {
-                  if (ztwoDarray_ptr->get(i,j) < zmax) npixels_below_zmax++;
-               }
+               if (ztwoDarray_ptr->get(i,j) < zmax) npixels_below_zmax++;
             } // loop over index i
-         }  // loop over index j
+         }  // loop over index s labeling spans
          return npixels_below_zmax;
       }
 
@@ -3584,7 +3499,11 @@ namespace imagefunc
 // Method median_filter takes in an image within *ztwoDarray_ptr along
 // with(odd!) integers nx_size and ny_size.  It returns within output
 // twoDarray *ztwoDarray_filtered_ptr the median values computed
-// within a moving nx_size x ny_size square window.
+// within a moving nx_size x ny_size square window.  Intensities
+// which are not less [greater] than irrelevant_intensity are ignored
+// if ignore_z_greater_than_irrelevant_intensity==true [false].
+// Windows slide via constant-time column histograms within
+// rank_filter rather than sorting every window.
 
    void median_filter(unsigned int nsize,twoDarray *ztwoDarray_ptr)
       {
@@ -3615,40 +3534,19 @@ namespace imagefunc
       double irrelevant_intensity,
       bool ignore_z_greater_than_irrelevant_intensity)
       {
-         ztwoDarray_ptr->copy(ztwoDarray_filtered_ptr);
-   
-         if (is_even(nx_size)) nx_size++;
-         if (is_even(ny_size)) ny_size++;
-         unsigned int npixels=nx_size*ny_size;
-         double intensity[npixels];
-
-         unsigned int wx=(nx_size-1)/2;
-         unsigned int wy=(ny_size-1)/2;
-         for (unsigned int py=wy; py<ztwoDarray_ptr->get_ndim()-wy; py++)
+         rank_filter curr_rank_filter(nx_size,ny_size);
+         if (ignore_z_greater_than_irrelevant_intensity)
          {
-            for (unsigned int px=wx; px<ztwoDarray_ptr->get_mdim()-wx; px++)
-            {
-               int n=0;
-               for (unsigned int j=0; j<ny_size; j++)
-               {
-                  for (unsigned int i=0; i<nx_size; i++)
-                  {
-
-                     double curr_intensity=
-                        ztwoDarray_ptr->get(px-wx+i,py-wy+j);
-                     if ((ignore_z_greater_than_irrelevant_intensity &&
-                          curr_intensity < irrelevant_intensity) ||
-                         (!ignore_z_greater_than_irrelevant_intensity &&
-                          curr_intensity > irrelevant_intensity))
-                     {
-                        intensity[n++]=curr_intensity;
-                     }
-                  } // loop over index i 
-               } // loop over index j 
-               Quicksort(intensity,n);
-               ztwoDarray_filtered_ptr->put(px,py,intensity[npixels/2]);
-            } // loop over index px
-         } // loop over index py
+            curr_rank_filter.set_valid_interval(
+               -std::numeric_limits<double>::infinity(),irrelevant_intensity);
+         }
+         else
+         {
+            curr_rank_filter.set_valid_interval(
+               irrelevant_intensity,std::numeric_limits<double>::infinity());
+         }
+         curr_rank_filter.median_filter(
+            ztwoDarray_ptr,ztwoDarray_filtered_ptr);
       }
 
 // ---------------------------------------------------------------------
@@ -3693,18 +3591,14 @@ namespace imagefunc
       }
 
 // ---------------------------------------------------------------------
-// Method fast_percentile_filter() first computes the minimum and maximum 
-// intensity values within input *ztwoDarray_ptr.  It creates a set of
-// intensity bins which range evenly from min_intensity to
-// max_intensity.  Looping over (most) pixels (px,py) within
-// *ztwoDarray_ptr, this method extracts a wx x wy patch of
-// intensities around (px,py).  If px == wx this method generates a
-// new histogram from the patch intensities.  The intensity histogram
-// is then converted into a cumulative probability distribution from
-// which the requested percentile intensity is recovered.  For px >
-// wx, the previous patch's left-most pixel intensities are removed
-// from the histogram, while the current patch's right-most pixel
-// intensities are added to the histogram.  
+// Method fast_percentile_filter() quantizes the intensities within
+// input *ztwoDarray_ptr into n_intensity_bins evenly spaced bins
+// ranging from the minimum to the maximum intensity value.  Looping
+// over (most) pixels (px,py) within *ztwoDarray_ptr, this method
+// returns the bin intensity whose rank within the wx x wy patch
+// around (px,py) corresponds to cumulative fraction cum_frac.  Patch
+// histograms are assembled from per-column histograms by rank_filter
+// so that the cost per pixel does not grow with patch size.
 
 // This approximate approach to image median filtering is
 // significantly faster than the brute-force approach which performs
@@ -3728,118 +3622,16 @@ namespace imagefunc
 	
          double min_intensity, max_intensity;
          ztwoDarray_ptr->minmax_values(min_intensity, max_intensity);
-//	 cout << "min_intensity = " << min_intensity
-//	      << "max_intensity = " << max_intensity << endl;
          if (nearly_equal(min_intensity,max_intensity))
          {
             ztwoDarray_filtered_ptr->initialize_values(min_intensity);
             return;
          }
 
-         double d_intensity = (max_intensity - min_intensity)/(
-            n_intensity_bins - 1);
-
-// Establish intensity bins ranging from min_intensity to max_intensity:
-
-         vector<double> X;
-         X.reserve(n_intensity_bins);
-         for (unsigned int k=0; k<n_intensity_bins; k++)
-         {
-            X.push_back(min_intensity + k*d_intensity);
-         }
-
-         vector<double> Xhistogram, Pcum;
-         Xhistogram.reserve(n_intensity_bins);
-         Pcum.reserve(n_intensity_bins);
-
-         for (unsigned int k=0; k<n_intensity_bins; k++)
-         {
-            Pcum.push_back(0);
-         }
-
-
-         ztwoDarray_ptr->copy(ztwoDarray_filtered_ptr);
-   
-         if (is_even(nx_size)) nx_size++;
-         if (is_even(ny_size)) ny_size++;
-         int n_patch_pixels=nx_size*ny_size;
-
-         unsigned int wx=(nx_size-1)/2;
-         unsigned int wy=(ny_size-1)/2;
-         for (unsigned int py=wy; py<ztwoDarray_ptr->get_ndim()-wy; py++)
-         {
-            for (unsigned int px=wx; px<ztwoDarray_ptr->get_mdim()-wx; px++)
-            {
-
-               if (px==wx)
-               {
-
-// Clear X histogram and then fill it with pixel intensities
-// surrounding (px,py):
-
-                  Xhistogram.clear();
-                  for (unsigned int k=0; k<n_intensity_bins; k++)
-                  {
-                     Xhistogram.push_back(0);
-                  }
-
-                  for (unsigned int i=0; i<nx_size; i++)
-                  {
-                     for (unsigned int j=0; j<ny_size; j++)
-                     {
-                        double curr_intensity=
-                           ztwoDarray_ptr->get(px-wx+i,py-wy+j);
-
-                        int k=basic_math::round( 
-                           (curr_intensity-min_intensity)/d_intensity);
-                        Xhistogram[k] = Xhistogram[k]+1;
-
-                     } // loop over index j
-                  }  // loop over index i
-               }
-               else
-               {
-                  int i=-1;
-                  for (unsigned int j=0; j<ny_size; j++)
-                  {
-                     double curr_intensity=
-                        ztwoDarray_ptr->get(px-wx+i,py-wy+j);
-                     
-                     int k=basic_math::round( 
-                        (curr_intensity-min_intensity)/d_intensity);
-                     Xhistogram[k] = Xhistogram[k]-1;
-                  } // loop over index j
-
-                  i=nx_size-1;
-                  for (unsigned int j=0; j<ny_size; j++)
-                  {
-                     double curr_intensity=
-                        ztwoDarray_ptr->get(px-wx+i,py-wy+j);
-                     
-                     int k=basic_math::round( 
-                        (curr_intensity-min_intensity)/d_intensity);
-                     Xhistogram[k] = Xhistogram[k]+1;
-                  } // loop over index j
-               }
-               
-// Renormalize X histogram entries so that they become probability
-// density values.  Then compute cumulative probability distribution:
-
-               double pcum_prev = 0;
-               for (unsigned int k=0; k<n_intensity_bins; k++)
-               {
-                  double curr_p = Xhistogram[k] / n_patch_pixels;
-                  Pcum[k] = pcum_prev + curr_p;
-                  pcum_prev += curr_p;
-               }
-
-               double percentile_p = mathfunc::find_x_corresponding_to_pcum(
-                  X, Pcum, cum_frac);
-
-               ztwoDarray_filtered_ptr->put(px,py,percentile_p);
-
-            } // loop over index px
-         } // loop over index py
+         rank_filter curr_rank_filter(nx_size,ny_size);
+         curr_rank_filter.set_n_intensity_bins(n_intensity_bins);
+         curr_rank_filter.percentile_filter(
+            cum_frac,ztwoDarray_ptr,ztwoDarray_filtered_ptr);
       }
 
 // ---------------------------------------------------------------------
@@ -3890,11 +3682,12 @@ namespace imagefunc
 
 // ---------------------------------------------------------------------
 // Method average_filter() takes in twoDarray *ztwoDarray_ptr and
-// brute-force computes the average intensity within an nx_size x
-// ny_size window about each pixel.  It returns the averaged results
-// within output twoDarray *ztwoDarray_filtered_ptr.  Only intensities
-// less than the input irrelevant_intensity value are used in the
-// averaging computation.
+// computes the average intensity within an nx_size x ny_size window
+// about each pixel.  It returns the averaged results within output
+// twoDarray *ztwoDarray_filtered_ptr.  Only intensities less than the
+// input irrelevant_intensity value are used in the averaging
+// computation.  Window sums of relevant intensities and their counts
+// are formed via running-sum box filters.
 
    void average_filter(
       unsigned int nx_size,unsigned int ny_size,
@@ -3903,36 +3696,38 @@ namespace imagefunc
       {
          if (is_even(nx_size)) nx_size++;
          if (is_even(ny_size)) ny_size++;
-         int npixels=nx_size*ny_size;
-         vector<double> intensity;
-         intensity.reserve(npixels);
+
+         unsigned int mdim=ztwoDarray_ptr->get_mdim();
+         unsigned int ndim=ztwoDarray_ptr->get_ndim();
+         twoDarray intensity_twoDarray(mdim,ndim);
+         twoDarray count_twoDarray(mdim,ndim);
+         for (unsigned int px=0; px<mdim; px++)
+         {
+            for (unsigned int py=0; py<ndim; py++)
+            {
+               double curr_intensity=ztwoDarray_ptr->get(px,py);
+               bool relevant_flag=(curr_intensity < irrelevant_intensity);
+               intensity_twoDarray.put(
+                  px,py,relevant_flag ? curr_intensity : 0);
+               count_twoDarray.put(px,py,relevant_flag ? 1 : 0);
+            } // loop over index py
+         } // loop over index px
+
+         convolution_engine engine(convolution_engine::interior_only);
+         engine.box_filter(
+            nx_size,ny_size,&intensity_twoDarray,&intensity_twoDarray,false);
+         engine.box_filter(
+            nx_size,ny_size,&count_twoDarray,&count_twoDarray,false);
 
          unsigned int wx=(nx_size-1)/2;
          unsigned int wy=(ny_size-1)/2;
-         for (unsigned int px=wx; px<ztwoDarray_ptr->get_mdim()-wx; px++)
+         for (unsigned int px=wx; px+wx<mdim; px++)
          {
-            for (unsigned int py=wy; py<ztwoDarray_ptr->get_ndim()-wy; py++)
+            for (unsigned int py=wy; py+wy<ndim; py++)
             {
-               for (unsigned int i=0; i<nx_size; i++)
-               {
-                  for (unsigned int j=0; j<ny_size; j++)
-                  {
-                     double curr_intensity=
-                        ztwoDarray_ptr->get(px-wx+i,py-wy+j);
-                     if (curr_intensity < irrelevant_intensity)
-                     {
-                        intensity.push_back(curr_intensity);
-                     }
-                  }
-               } 
-               double intensity_sum=0;
-               for (unsigned int n=0; n<intensity.size(); n++)
-               {
-                  intensity_sum += intensity[n];
-               }
                ztwoDarray_filtered_ptr->put(
-                  px,py,intensity_sum/intensity.size());
-               intensity.clear();
+                  px,py,intensity_twoDarray.get(px,py)/
+                  count_twoDarray.get(px,py));
             } // loop over index py
          } // loop over index px
       }
@@ -4085,6 +3880,11 @@ namespace imagefunc
          } // loop over index px
       }
    
+// This overloaded version of median_fill() computes median values of
+// all non-null pixels for every window at once via rank_filter.  Only
+// null valued pixels within *ztwoDarray_filtered_ptr are then
+// overwritten.
+
    void median_fill(
       unsigned int nsize,twoDarray const *ztwoDarray_ptr,
       twoDarray *ztwoDarray_filtered_ptr,double null_value)
@@ -4092,9 +3892,12 @@ namespace imagefunc
 //         cout << "inside imagefunc::median_fill() #2" << endl;
 //         cout << "null_value = " << null_value << endl;
 
-         if (is_even(nsize)) nsize++;
-         double intensity[nsize*nsize];
+         rank_filter curr_rank_filter(nsize,nsize);
+         curr_rank_filter.set_ignored_value(null_value);
+         twoDarray* zmedian_twoDarray_ptr=new twoDarray(ztwoDarray_ptr);
+         curr_rank_filter.median_filter(ztwoDarray_ptr,zmedian_twoDarray_ptr);
 
+         if (is_even(nsize)) nsize++;
          unsigned int w=(nsize-1)/2;
          for (unsigned int px=w; px<ztwoDarray_ptr->get_mdim()-w; px++)
          {
@@ -4103,35 +3906,12 @@ namespace imagefunc
                double central_z=ztwoDarray_ptr->get(px,py);
                if (nearly_equal(central_z,null_value))
                {
-                  unsigned int n=0;
-                  for (unsigned int i=0; i<nsize; i++)
-                  {
-                     for (unsigned int j=0; j<nsize; j++)
-                     {
-                        double currz=ztwoDarray_ptr->get(px-w+i,py-w+j);
-                        if (!nearly_equal(currz,null_value)) 
-                        {
-                           intensity[n++]=currz;
-                        }
-                     }
-                  } 
-
-                  double median_value;
-                  if (n==0)
-                  {
-                     median_value=null_value;
-                  }
-                  else
-                  {
-                     Quicksort(intensity,n);
-                     median_value=intensity[n/2];
-                  }
-
-                  ztwoDarray_filtered_ptr->put(px,py,median_value);
-
+                  ztwoDarray_filtered_ptr->put(
+                     px,py,zmedian_twoDarray_ptr->get(px,py));
                } // cental_z==null_value conditional
             } // loop over index py
          } // loop over index px
+         delete zmedian_twoDarray_ptr;
       }
 
 // ---------------------------------------------------------------------   
@@ -4218,33 +3998,23 @@ namespace imagefunc
 // Method brute_twoD_convolve takes in an image within *ztwoDarray_ptr
 // along with an nsize x nsize filter.  It returns within output
 // twoDarray *ztwoDarray_filtered_ptr the convolved values computed by
-// sliding the filter across the input image.
+// sliding the filter across the input image.  Pixels lying within
+// nsize/2 of the image's borders retain their input values.  The
+// sliding sums are delegated to a convolution_engine which factors
+// separable filters and transforms large ones into the frequency
+// domain.
 
    void brute_twoD_convolve(
       genmatrix* filter_ptr,twoDarray const *ztwoDarray_ptr,
       twoDarray *ztwoDarray_filtered_ptr)
       {
-         ztwoDarray_ptr->copy(ztwoDarray_filtered_ptr);
-
-         unsigned int nsize=filter_ptr->get_mdim();
-         unsigned int w=nsize/2;
-         for (unsigned int px=w; px<ztwoDarray_ptr->get_mdim()-w; px++)
+         if (ztwoDarray_ptr != ztwoDarray_filtered_ptr)
          {
-            for (unsigned int py=w; py<ztwoDarray_ptr->get_ndim()-w; py++)
-            {
-               double intensity=0;
-               for (unsigned int i=0; i<nsize; i++)
-               {
-                  for (unsigned int j=0; j<nsize; j++)
-                  {
-                     intensity += filter_ptr->get(i,j)*ztwoDarray_ptr->
-                        get(px-w+i,py-w+j);
-                  }
-               } 
-//               ztwoDarray_filtered_ptr->put(px,py,fabs(intensity));
-               ztwoDarray_filtered_ptr->put(px,py,intensity);
-            } // loop over index py
-         } // loop over index px
+            ztwoDarray_ptr->copy(ztwoDarray_filtered_ptr);
+         }
+
+         convolution_engine engine(convolution_engine::interior_only);
+         engine.convolve(filter_ptr,ztwoDarray_ptr,ztwoDarray_filtered_ptr);
       }
 
 // This overloaded version of brute_twoD_convolve performs a brute
@@ -4288,102 +4058,56 @@ namespace imagefunc
       twoDarray *ztwoDarray_filtered_ptr,double dx,double null_value)
       {
          ztwoDarray_filtered_ptr->clear_values();
-         unsigned int w=nsize/2;
-         for (unsigned int px=w; px<ztwoDarray_ptr->get_mdim()-w; px++)
-         {
-            for (unsigned int py=0; py<ztwoDarray_ptr->get_ndim(); py++)
-            {
-               unsigned int n_nulls=0;
-               double intensity=0;
-               for (unsigned int i=0; i<nsize; i++)
-               {
-                  double currz=ztwoDarray_ptr->get(px-w+i,py);
-                  if (currz <= null_value) 
-                  {
-                     n_nulls++;
-                  }
-                  else
-                  {
-                     intensity += filter[i]*currz;
-                  }
-               } 
-               intensity *= dx;
-               if (n_nulls==nsize)
-               {
-                  cout << " null_value = "
-                       << null_value << endl;
-                  intensity=null_value;
-                  cout << "intensity = null!!" << endl;
-                  outputfunc::enter_continue_char();
-               }
-               
-               if (nearly_equal(intensity,0)) intensity=0;
-               ztwoDarray_filtered_ptr->put(px,py,intensity);
-
-/*
-               if (intensity < 1E-5)
-               {
-                  cout << "nsize = " << nsize << endl;
-                  cout << "px = " << px << " py = " << py
-                       << " dx = " << dx 
-                       << " intensity = " << intensity << endl;
 
-                  for (unsigned int i=0; i<nsize; i++)
-                  {
-                     double currz=ztwoDarray_ptr->get(px-w+i,py);
-                     cout << "i = " << i 
-                          << " filter[i] = " << filter[i]
-                          << " px-w+i = " << px-w+i << " py = " << py
-                          << " currz = " << currz
-                          << endl;
-                  }
-               }
-*/
+         vector<double> x_kernel(nsize);
+         for (unsigned int i=0; i<nsize; i++)
+         {
+            x_kernel[i]=dx*filter[i];
+         }
 
-            } // loop over index py
-         } // loop over index px
+         convolution_engine engine(convolution_engine::interior_only);
+         engine.set_null_value(null_value);
+         engine.row_convolve(x_kernel,ztwoDarray_ptr,ztwoDarray_filtered_ptr);
+         snap_nearly_zero_values(ztwoDarray_filtered_ptr);
       }
 
+// Vertical derivative values are negated so that they increase
+// towards decreasing py:
+
    void vert_derivative_filter(
       unsigned int nsize,const double filter[],twoDarray const *ztwoDarray_ptr,
       twoDarray *ztwoDarray_filtered_ptr,double dy,double null_value)
       {
          ztwoDarray_filtered_ptr->clear_values();
 
-         unsigned int w=nsize/2;
-         for (unsigned int px=0; px<ztwoDarray_ptr->get_mdim(); px++)
+         vector<double> y_kernel(nsize);
+         for (unsigned int j=0; j<nsize; j++)
          {
-            for (unsigned int py=w; py<ztwoDarray_ptr->get_ndim()-w; py++)
-            {
-               unsigned int n_nulls=0;
-               double intensity=0;
-               for (unsigned int j=0; j<nsize; j++)
-               {
-                  double currz=ztwoDarray_ptr->get(px,py-w+j);
-                  if (currz <= null_value) 
-                  {
-                     n_nulls++;
-                  }
-                  else
-                  {
-                     intensity += filter[j]*currz;
-                  }
-               } 
-               intensity *= dy;
-               if (n_nulls==nsize) intensity=-null_value;
+            y_kernel[j]=-dy*filter[j];
+         }
 
-               if (nearly_equal(intensity,0)) intensity=0;
+         convolution_engine engine(convolution_engine::interior_only);
+         engine.set_null_value(null_value);
+         engine.column_convolve(
+            y_kernel,ztwoDarray_ptr,ztwoDarray_filtered_ptr);
+         snap_nearly_zero_values(ztwoDarray_filtered_ptr);
+      }
 
-//               if (nearly_equal(intensity,0))
-//               {
-//                  cout << "px = " << px << " py = " << py 
-//                       << " vert_deriv = " << intensity << endl;
-//               }
-               
+// Method snap_nearly_zero_values() resets derivative values which
+// nearly equal zero to exactly zero.
 
-               ztwoDarray_filtered_ptr->put(px,py,-intensity);
-            } // loop over index py
-         } // loop over index px
+   void snap_nearly_zero_values(twoDarray* ztwoDarray_ptr)
+      {
+         for (unsigned int px=0; px<ztwoDarray_ptr->get_mdim(); px++)
+         {
+            for (unsigned int py=0; py<ztwoDarray_ptr->get_ndim(); py++)
+            {
+               if (nearly_equal(ztwoDarray_ptr->get(px,py),0))
+               {
+                  ztwoDarray_ptr->put(px,py,0);
+               }
+            }
+         }
       }
 
 // These next overloaded versions of horiz_derivative_filter and
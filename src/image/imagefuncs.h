@@ -1,7 +1,7 @@
 // =========================================================================
 // Header file for stand-alone image functions.
 // =========================================================================
-// Last modified on 3/24/16; 3/26/16; 4/9/16; 8/2/16
+// Last modified on 3/24/16; 3/26/16; 4/9/16; 8/2/16; 10/18/26
 // =========================================================================
 
 #ifndef IMAGEFUNCS_H
@@ -425,6 +425,7 @@ namespace imagefunc
       unsigned int nsize,const double filter[],twoDarray const *ztwoDarray_ptr,
       twoDarray *ztwoDarray_filtered_ptr,double dy=1.0,
       double null_value=NEGATIVEINFINITY);
+   void snap_nearly_zero_values(twoDarray* ztwoDarray_ptr);
 
    double horiz_derivative_filter(
       unsigned int px,unsigned int py,unsigned int nsize,const double filter[],
@@ -1,9 +1,13 @@
 // ==========================================================================
 // RECURSIVEFUNCS stand-alone methods
 // ==========================================================================
-// Last modified on 8/3/06; 8/5/06; 10/28/07; 2/25/14; 4/5/14
+// Last modified on 8/3/06; 8/5/06; 10/28/07; 2/25/14; 4/5/14; 10/18/26
 // ==========================================================================
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <utility>
 #include "math/basic_math.h"
 #include "image/binaryimagefuncs.h"
 #include "math/constant_vectors.h"
@@ -19,12 +23,14 @@
 #include "image/recursivefuncs.h"
 #include "math/threevector.h"
 #include "image/TwoDarray.h"
+#include "datastructures/vector_union_find.h"
 
 using std::cin;
 using std::cout;
 using std::endl;
 using std::ofstream;
 using std::ostream;
+using std::pair;
 using std::string;
 using std::vector;
 
@@ -354,12 +360,17 @@ namespace recursivefunc
 // Method binary_fill scans through the twoDarray
 // *zbinary_twoDarray_ptr after it has been filled with binary
 // thresholded data.  The scan is limited to the bounding box defined
-// by pixel limits pxlo < px < pxhi and pylo < py < pyhi.  In
-// conjunction with method check_nearest_neighbors,
-// binary_fill recursively searches for islands of zempty_value valued
-// pixels which are completely surrounded by oceans of zfill_value
-// valued pixels.  It sets the values of all such island pixels equal
-// to zfill_value.
+// by pixel limits pxlo < px < pxhi and pylo < py < pyhi.  It searches
+// for islands of zempty_value valued pixels which are completely
+// surrounded by oceans of zfill_value valued pixels.  It sets the
+// values of all such island pixels equal to zfill_value.
+
+// This method formerly followed each island with depth-capped
+// recursion and repeated its scan up to 4 times.  As of Oct 2026, it
+// instead labels 8-connected islands via union-find in a single
+// pass.  A depth max_recursion_levels walk could cover islands
+// containing up to max_recursion_levels+1 pixels.  So larger islands
+// are still left unfilled.
 
    void binary_fill(
       int max_recursion_levels,
@@ -370,56 +381,10 @@ namespace recursivefunc
 //	cout << "inside recursivefunc::binary_fill()" << endl;
 //	cout << "pxlo = " << pxlo << " pxhi = " << pxhi
 //	     << " pylo = " << pylo << " pyhi = " << pyhi << endl;
-//	cout << "zempty_value = " << zempty_value << " zfill_value = " << zfill_value
-//	     << endl;
 
-         const int max_iterations=4;
-         const int n_neighbors=8;
-
-         bool bit_changed;
-         int loop=0;
-         int* neighbor_order=NULL;
-
-         int row[n_neighbors];
-         int column[n_neighbors];
-
-         do
-         {
-            bit_changed=false;
-            loop++;
-
-// Note added on 6/6/02: Recall that the results of recursive
-// filling/emptying DO depend upon the order and direction in which
-// the recursion takes place.  So to maintain consistency with
-// 2000-2002 results, we do NOT swap the order of the following loops
-// over the vertical and horizontal pixel indices...
-      
-            int counter=0;
-            for (unsigned int j=pylo+1; j<pyhi-1; j++)
-            {
-               for (unsigned int i=pxlo+1; i<pxhi-1; i++)
-               {
-                  double zbinary_orig=zbinary_twoDarray_ptr->get(i,j);
-                  if (zbinary_orig==zempty_value) 
-                  {
-                     int curr_recursive_level=0;
-                     bool deadend=false;
-                     pseudo_random_sequence(counter++,&neighbor_order);
-		     
-                     check_nearest_neighbors(
-                        i,j,max_recursion_levels,
-                        pxlo,pxhi,pylo,pyhi,zempty_value,zfill_value,
-                        row,column,curr_recursive_level,deadend,
-                        neighbor_order,zbinary_twoDarray_ptr);
-                  }
-                  if (zbinary_twoDarray_ptr->get(i,j) != zbinary_orig)
-                  {
-                     bit_changed=true;
-                  }
-               }  // loop over index i
-            }	// loop over index j
-         }
-         while(bit_changed && loop < max_iterations);
+         fill_enclosed_islands(
+            max_recursion_levels+1,8,pxlo,pxhi,pylo,pyhi,
+            zempty_value,zfill_value,zbinary_twoDarray_ptr);
       }
 
 // ---------------------------------------------------------------------
@@ -776,21 +741,18 @@ namespace recursivefunc
 // Boundary filling methods
 // =====================================================================
 
-// In Nov 2004, we discovered the hard way that the following simple
-// recursive approach to contour filling can fail for large regions
-// due to memory limitations.  This problem is widely recognized in
-// the computer graphics literature.  So the following method is NOT
-// robust!
-
-// The following approach to filling polygons is used frequently in
-// paint programs.  The idea is to select a point inside the region to
-// be filled, set its color to the desired color and then apply the
-// same procedure recursively to all its neighbors.  Of course, one
-// must take care to not exceed the boundaries of the area to be
-// filled, nor to recolor pixels which have already been colored.
+// In Nov 2004, we discovered the hard way that simple recursive
+// contour filling can fail for large regions due to stack
+// limitations.  This problem is widely recognized in the computer
+// graphics literature.  As of Oct 2026, both boundaryFill() methods
+// therefore delegate to explicit stack method scanline_fill().  They
+// color the 4-connected region around seed pixel (px,py) whose
+// values equal neither zfill nor zboundary.
 
-//  The following method was adapted from
-//  http://occs.cs.oberlin.edu/faculty/jdonalds/357/lecture05.html
+// The first method's recursion limit arguments are retained for
+// backwards compatibility.  Since the entire region is now filled in
+// a single call, recursion_limit_exceeded is always returned false
+// and (new_px,new_py) is set equal to (px,py).
 
    void boundaryFill(
       bool& recursion_limit_exceeded,int& npixels_filled,int& n_recursion,
@@ -798,154 +760,459 @@ namespace recursivefunc
       int& max_empty_neighbors,int& new_px,int& new_py,
       twoDarray* ztwoDarray_ptr)
       {
-         const int recursion_limit=5000;
-//         const int recursion_limit=25000;
-//         const int recursion_limit=50000;
-         n_recursion++;
+         recursion_limit_exceeded=false;
+         new_px=px;
+         new_py=py;
+         if (px < 0 || py < 0) return;
+         npixels_filled += scanline_fill(
+            px,py,zfill,zboundary,ztwoDarray_ptr);
+      }
+
+   void boundaryFill(
+      int& npixels_filled,const unsigned int px,const unsigned int py,
+      const double zfill,const double zboundary,
+      twoDarray* ztwoDarray_ptr)
+      {
+         if (px >= ztwoDarray_ptr->get_mdim() ||
+             py >= ztwoDarray_ptr->get_ndim())
+         {
+            cout << "Error in recursivefunc::boundaryFill()" << endl;
+            cout << "px = " << px << " py = " << py << endl;
+            return;
+         }
+         npixels_filled += scanline_fill(
+            px,py,zfill,zboundary,ztwoDarray_ptr);
+      }
+   
+// =====================================================================
+// Iterative filling and connected component labeling methods
+// =====================================================================
+
+// Method scanline_fill colors every pixel connected to seed (px,py)
+// whose value equals neither zfill nor zboundary.  Rather than
+// recursing pixel by pixel, it fills entire runs of fillable pixels
+// along the contiguous py direction.  It then pushes one seed for
+// each fillable run within the neighboring px lines onto an explicit
+// stack.  So arbitrarily large regions are filled in a single call
+// without risk of overflowing the program stack.  Connectivity is
+// defined by n_neighbors = 4 or 8.  The number of filled pixels is
+// returned.
+
+   int scanline_fill(
+      unsigned int px,unsigned int py,double zfill,double zboundary,
+      twoDarray* ztwoDarray_ptr,int n_neighbors)
+      {
+         return scanline_fill(
+            px,py,zfill,zboundary,false,n_neighbors,ztwoDarray_ptr);
+      }
 
-         if (n_recursion < recursion_limit && !recursion_limit_exceeded)
+// Method seed_fill recolors every pixel connected to seed (px,py)
+// whose value nearly equals the seed's initial value.  It is the
+// explicit stack counterpart of graphicsfunc::basicfill().
+
+   int seed_fill(
+      unsigned int px,unsigned int py,double zfill,
+      twoDarray* ztwoDarray_ptr,int n_neighbors)
+      {
+         if (!ztwoDarray_ptr->pixel_inside_working_region(px,py)) return 0;
+         double zseed=ztwoDarray_ptr->get(px,py);
+         if (nearly_equal(zseed,zfill)) return 0;
+         return scanline_fill(
+            px,py,zfill,zseed,true,n_neighbors,ztwoDarray_ptr);
+      }
+
+// If seed_value_flag==true, pixels nearly equal to zreference are
+// fillable.  Otherwise, pixels equal to neither zfill nor zreference
+// are fillable.  In both cases, filled pixels are no longer fillable.
+
+   int scanline_fill(
+      unsigned int px,unsigned int py,double zfill,double zreference,
+      bool seed_value_flag,int n_neighbors,twoDarray* ztwoDarray_ptr)
+      {
+         if (!ztwoDarray_ptr->pixel_inside_working_region(px,py)) return 0;
+
+         const unsigned int mdim=ztwoDarray_ptr->get_mdim();
+         const unsigned int ndim=ztwoDarray_ptr->get_ndim();
+         const bool diagonal_flag=(n_neighbors==8);
+
+         int npixels_filled=0;
+         vector<pair<unsigned int,unsigned int> > seed_stack;
+         seed_stack.push_back(pair<unsigned int,unsigned int>(px,py));
+
+         while (!seed_stack.empty())
          {
-            if (ztwoDarray_ptr->pixel_inside_working_region(px,py))
+            unsigned int qx=seed_stack.back().first;
+            unsigned int qy=seed_stack.back().second;
+            seed_stack.pop_back();
+            if (!fillable_pixel(
+               ztwoDarray_ptr->get(qx,qy),zfill,zreference,seed_value_flag))
+               continue;
+
+// Extend run through seed pixel in both py directions:
+
+            unsigned int qy_lo=qy;
+            while (qy_lo > 0 && fillable_pixel(
+               ztwoDarray_ptr->get(qx,qy_lo-1),zfill,zreference,
+               seed_value_flag)) qy_lo--;
+            unsigned int qy_hi=qy;
+            while (qy_hi+1 < ndim && fillable_pixel(
+               ztwoDarray_ptr->get(qx,qy_hi+1),zfill,zreference,
+               seed_value_flag)) qy_hi++;
+
+            for (unsigned int j=qy_lo; j<=qy_hi; j++)
             {
-               double curr_z=ztwoDarray_ptr->get(px,py);
-               if (!nearly_equal(curr_z,zfill) && 
-                   !nearly_equal(curr_z,zboundary))
+               ztwoDarray_ptr->put(qx,j,zfill);
+            }
+            npixels_filled += qy_hi-qy_lo+1;
+
+// Push one seed per fillable run within run's shadow on the
+// neighboring px lines.  Diagonal connectivity widens the shadow by
+// one pixel on each side:
+
+            unsigned int jlo=qy_lo;
+            unsigned int jhi=qy_hi;
+            if (diagonal_flag)
+            {
+               if (jlo > 0) jlo--;
+               if (jhi+1 < ndim) jhi++;
+            }
+
+            for (int dx=-1; dx<=1; dx += 2)
+            {
+               if ((dx < 0 && qx==0) || (dx > 0 && qx+1 >= mdim)) continue;
+               unsigned int nx=qx+dx;
+               bool inside_run=false;
+               for (unsigned int j=jlo; j<=jhi; j++)
                {
+                  if (fillable_pixel(
+                     ztwoDarray_ptr->get(nx,j),zfill,zreference,
+                     seed_value_flag))
+                  {
+                     if (!inside_run)
+                     {
+                        seed_stack.push_back(
+                           pair<unsigned int,unsigned int>(nx,j));
+                     }
+                     inside_run=true;
+                  }
+                  else
+                  {
+                     inside_run=false;
+                  }
+               } // loop over index j
+            } // loop over dx
+         } // seed_stack not empty while loop
 
-//               cout << "nfilled = " << npixels_filled 
-//                    << " px = " << px << " py = " << py 
-//                    << " mdim = " << ztwoDarray_ptr->get_mdim()
-//                    << " ndim = " << ztwoDarray_ptr->get_ndim() << endl;
-//               cout << "curr_z = " << curr_z << " zfill = " << zfill
-//                    << " zboundary = " << zboundary << endl;
-
-                  ztwoDarray_ptr->put(px,py,zfill);
-                  npixels_filled++;
-
-                  boundaryFill(
-                     recursion_limit_exceeded,npixels_filled,n_recursion,
-                     px+1,py,zfill,zboundary,max_empty_neighbors,
-                     new_px,new_py,ztwoDarray_ptr);
-                  boundaryFill(
-                     recursion_limit_exceeded,npixels_filled,n_recursion,
-                     px,py+1,zfill,zboundary,max_empty_neighbors,
-                     new_px,new_py,ztwoDarray_ptr);
-                  boundaryFill(
-                     recursion_limit_exceeded,npixels_filled,n_recursion,
-                     px-1,py,zfill,zboundary,max_empty_neighbors,
-                     new_px,new_py,ztwoDarray_ptr);
-                  boundaryFill(
-                     recursion_limit_exceeded,npixels_filled,n_recursion,
-                     px,py-1,zfill,zboundary,max_empty_neighbors,
-                     new_px,new_py,ztwoDarray_ptr);
-               } // curr_z != zfill && curr_z != z_boundary conditional
-            } // pixel inside working region conditional
+         return npixels_filled;
+      }
+
+// ---------------------------------------------------------------------
+// Method label_connected_components performs two-pass union-find
+// labeling of all pixels within the bounding box pxlo <= px < pxhi
+// and pylo <= py < pyhi whose values equal zforeground.
+// Connectivity is defined by n_neighbors = 4 or 8.
+
+// The bounding box is divided into bands of px lines which are
+// labeled by separate threads.  Each band resolves its own
+// provisional label equivalences within a private vector_union_find.
+// Labels on either side of band boundaries are subsequently merged
+// within a global vector_union_find.  Final component labels are
+// numbered in order of their first pixel when the box is scanned
+// with py varying fastest.  So they do not depend upon the number of
+// threads.
+
+// Upon return, labels[(px-pxlo)*(pyhi-pylo)+(py-pylo)] holds the
+// component label of pixel (px,py) or -1 for background pixels, and
+// n_component_pixels[c] holds component c's pixel count.  The number
+// of connected components is returned.
+
+   int label_connected_components(
+      int n_neighbors,unsigned int pxlo,unsigned int pxhi,
+      unsigned int pylo,unsigned int pyhi,double zforeground,
+      const twoDarray* ztwoDarray_ptr,vector<int>& labels,
+      vector<int>& n_component_pixels,int n_threads)
+      {
+         pxhi=basic_math::min(pxhi,ztwoDarray_ptr->get_mdim());
+         pyhi=basic_math::min(pyhi,ztwoDarray_ptr->get_ndim());
+
+         labels.clear();
+         n_component_pixels.clear();
+         if (pxhi <= pxlo || pyhi <= pylo) return 0;
+
+         const bool diagonal_flag=(n_neighbors==8);
+         const unsigned int n_lines=pxhi-pxlo;
+         const unsigned int line_length=pyhi-pylo;
+         labels.resize(n_lines*line_length,-1);
+
+// Bands should contain enough px lines to amortize their boundary
+// merging:
+
+         const unsigned int min_lines_per_band=32;
+#ifdef _OPENMP
+         if (n_threads <= 0) n_threads=omp_get_max_threads();
+#else
+         n_threads=1;
+#endif
+         unsigned int n_bands=basic_math::min(
+            basic_math::max(n_threads,1),
+            int(basic_math::max(1U,n_lines/min_lines_per_band)));
+
+         vector<unsigned int> band_start(n_bands+1);
+         for (unsigned int b=0; b<=n_bands; b++)
+         {
+            band_start[b]=(b*n_lines)/n_bands;
          }
-         else
+         vector<vector<int> > band_component_pixels(n_bands);
+
+// First pass: assign provisional labels within each band and record
+// their equivalences.  Then replace provisional labels with compact
+// band-local labels:
+
+#pragma omp parallel for schedule(static,1) num_threads(n_bands)
+         for (int b=0; b<int(n_bands); b++)
          {
-            recursion_limit_exceeded=true;
-            double z_east=NEGATIVEINFINITY;
-            double z_south=NEGATIVEINFINITY;
-            double z_west=NEGATIVEINFINITY;
-            double z_north=NEGATIVEINFINITY;
-            if (ztwoDarray_ptr->pixel_inside_working_region(px+1,py))
+            vector_union_find band_union_find;
+            for (unsigned int l=band_start[b]; l<band_start[b+1]; l++)
             {
-               z_east=ztwoDarray_ptr->get(px+1,py);
+               unsigned int px=pxlo+l;
+               int* curr_labels=&labels[l*line_length];
+               int* prev_labels=(l > band_start[b]) ? 
+                  &labels[(l-1)*line_length] : NULL;
+
+               for (unsigned int j=0; j<line_length; j++)
+               {
+                  if (ztwoDarray_ptr->get(px,pylo+j) != zforeground) continue;
+
+                  int curr_label=-1;
+                  int neighbor_labels[4];
+                  unsigned int n_labeled_neighbors=0;
+                  if (j > 0 && curr_labels[j-1] >= 0)
+                  {
+                     neighbor_labels[n_labeled_neighbors++]=curr_labels[j-1];
+                  }
+                  if (prev_labels != NULL)
+                  {
+                     if (prev_labels[j] >= 0)
+                     {
+                        neighbor_labels[n_labeled_neighbors++]=prev_labels[j];
+                     }
+                     if (diagonal_flag)
+                     {
+                        if (j > 0 && prev_labels[j-1] >= 0)
+                        {
+                           neighbor_labels[n_labeled_neighbors++]=
+                              prev_labels[j-1];
+                        }
+                        if (j+1 < line_length && prev_labels[j+1] >= 0)
+                        {
+                           neighbor_labels[n_labeled_neighbors++]=
+                              prev_labels[j+1];
+                        }
+                     }
+                  }
+
+                  for (unsigned int k=0; k<n_labeled_neighbors; k++)
+                  {
+                     if (curr_label < 0)
+                     {
+                        curr_label=neighbor_labels[k];
+                     }
+                     else if (neighbor_labels[k] != curr_label)
+                     {
+                        band_union_find.Link(curr_label,neighbor_labels[k]);
+                     }
+                  }
+                  if (curr_label < 0) curr_label=band_union_find.AppendSet();
+                  curr_labels[j]=curr_label;
+               } // loop over index j
+            } // loop over index l labeling px lines within band b
+
+// Provisional labels are created in scan order.  So numbering roots
+// as they are first encountered preserves first pixel ordering:
+
+            unsigned int n_provisional=band_union_find.get_n_nodes();
+            vector<int> compact_label(n_provisional,-1);
+            vector<int>& component_pixels=band_component_pixels[b];
+            for (unsigned int p=0; p<n_provisional; p++)
+            {
+               int root=band_union_find.Find(p);
+               if (compact_label[root] < 0)
+               {
+                  compact_label[root]=component_pixels.size();
+                  component_pixels.push_back(0);
+               }
+               compact_label[p]=compact_label[root];
             }
-            if (ztwoDarray_ptr->pixel_inside_working_region(px,py+1))
+
+            for (unsigned int i=band_start[b]*line_length; 
+                 i<band_start[b+1]*line_length; i++)
             {
-               z_south=ztwoDarray_ptr->get(px,py+1);
+               if (labels[i] < 0) continue;
+               labels[i]=compact_label[labels[i]];
+               component_pixels[labels[i]]++;
             }
-            if (ztwoDarray_ptr->pixel_inside_working_region(px-1,py))
+         } // loop over index b labeling bands
+
+// Merge step: link band-local labels which touch across band
+// boundaries within a global union-find structure:
+
+         vector<int> band_offset(n_bands+1,0);
+         for (unsigned int b=0; b<n_bands; b++)
+         {
+            band_offset[b+1]=band_offset[b]+band_component_pixels[b].size();
+         }
+
+         vector_union_find global_union_find;
+         for (int n=0; n<band_offset[n_bands]; n++)
+         {
+            global_union_find.AppendSet();
+         }
+
+         for (unsigned int b=1; b<n_bands; b++)
+         {
+            const int* curr_labels=&labels[band_start[b]*line_length];
+            const int* prev_labels=&labels[(band_start[b]-1)*line_length];
+            for (unsigned int j=0; j<line_length; j++)
             {
-               z_west=ztwoDarray_ptr->get(px-1,py);
+               if (curr_labels[j] < 0) continue;
+               int curr_label=band_offset[b]+curr_labels[j];
+               int jlo=j;
+               int jhi=j;
+               if (diagonal_flag)
+               {
+                  jlo=basic_math::max(0,int(j)-1);
+                  jhi=basic_math::min(int(line_length)-1,int(j)+1);
+               }
+               for (int k=jlo; k<=jhi; k++)
+               {
+                  if (prev_labels[k] < 0) continue;
+                  global_union_find.Link(
+                     curr_label,band_offset[b-1]+prev_labels[k]);
+               }
+            } // loop over index j
+         } // loop over index b labeling band boundaries
+
+// Global nodes are also ordered by first pixel.  So final labels are
+// again assigned to roots as they are first encountered:
+
+         vector<int> final_label(band_offset[n_bands],-1);
+         for (int n=0; n<band_offset[n_bands]; n++)
+         {
+            int root=global_union_find.Find(n);
+            if (final_label[root] < 0)
+            {
+               final_label[root]=n_component_pixels.size();
+               n_component_pixels.push_back(0);
             }
-            if (ztwoDarray_ptr->pixel_inside_working_region(px,py-1))
+            final_label[n]=final_label[root];
+         }
+
+         for (unsigned int b=0; b<n_bands; b++)
+         {
+            for (unsigned int c=0; c<band_component_pixels[b].size(); c++)
             {
-               z_north=ztwoDarray_ptr->get(px,py-1);
+               n_component_pixels[final_label[band_offset[b]+c]] += 
+                  band_component_pixels[b][c];
             }
+         }
 
-            int n_empty_neighbors=0;
-            if (!nearly_equal(z_east,zfill) && 
-                !nearly_equal(z_east,zboundary)) n_empty_neighbors++;
-            if (!nearly_equal(z_south,zfill) && 
-                !nearly_equal(z_south,zboundary)) n_empty_neighbors++;
-            if (!nearly_equal(z_west,zfill) && 
-                !nearly_equal(z_west,zboundary)) n_empty_neighbors++;
-            if (!nearly_equal(z_north,zfill) && 
-                !nearly_equal(z_north,zboundary)) n_empty_neighbors++;
-            if (n_empty_neighbors >= max_empty_neighbors)
+// Second pass: replace band-local labels with final labels:
+
+#pragma omp parallel for schedule(static,1) num_threads(n_bands)
+         for (int b=0; b<int(n_bands); b++)
+         {
+            for (unsigned int i=band_start[b]*line_length; 
+                 i<band_start[b+1]*line_length; i++)
             {
-               max_empty_neighbors=n_empty_neighbors;
-               new_px=px;
-               new_py=py;
+               if (labels[i] < 0) continue;
+               labels[i]=final_label[band_offset[b]+labels[i]];
             }
-         } // n_recursion < recursion_limit 
-         n_recursion--;
+         } // loop over index b labeling bands
+
+         return n_component_pixels.size();
       }
 
-   void boundaryFill(
-      int& npixels_filled,const unsigned int px,const unsigned int py,
-      const double zfill,const double zboundary,
-      twoDarray* ztwoDarray_ptr)
+// ---------------------------------------------------------------------
+// Method fill_enclosed_islands sets equal to zfill_value all pixels
+// within connected components of zempty_value valued pixels which
+// lie strictly inside the bounding box pxlo <= px < pxhi and pylo <=
+// py < pyhi.  Components touching the box's border lines are left
+// untouched.  If max_island_size >= 0, only components containing at
+// most max_island_size pixels are filled.
+
+   void fill_enclosed_islands(
+      int max_island_size,int n_neighbors,
+      unsigned int pxlo,unsigned int pxhi,unsigned int pylo,unsigned int pyhi,
+      double zempty_value,double zfill_value,
+      twoDarray* zbinary_twoDarray_ptr,int n_threads)
       {
-         if (px < 0 || px >= ztwoDarray_ptr->get_mdim() ||
-             py < 0 || py >= ztwoDarray_ptr->get_ndim())
+         pxhi=basic_math::min(pxhi,zbinary_twoDarray_ptr->get_mdim());
+         pyhi=basic_math::min(pyhi,zbinary_twoDarray_ptr->get_ndim());
+         if (pxhi < pxlo+3 || pyhi < pylo+3) return;
+
+         vector<int> labels,n_component_pixels;
+         int n_components=label_connected_components(
+            n_neighbors,pxlo,pxhi,pylo,pyhi,zempty_value,
+            zbinary_twoDarray_ptr,labels,n_component_pixels,n_threads);
+         if (n_components==0) return;
+
+         vector<bool> fill_component(n_components,true);
+         for (int c=0; c<n_components; c++)
          {
-            cout << "Error in recursivefunc::boundaryFill()" << endl;
-            cout << "px = " << px << " py = " << py << endl;
+            if (max_island_size >= 0 && 
+                n_component_pixels[c] > max_island_size)
+               fill_component[c]=false;
          }
-         
-         if (ztwoDarray_ptr->pixel_inside_working_region(px,py))
+
+         const unsigned int n_lines=pxhi-pxlo;
+         const unsigned int line_length=pyhi-pylo;
+         for (unsigned int j=0; j<line_length; j++)
+         {
+            int first_label=labels[j];
+            int last_label=labels[(n_lines-1)*line_length+j];
+            if (first_label >= 0) fill_component[first_label]=false;
+            if (last_label >= 0) fill_component[last_label]=false;
+         }
+         for (unsigned int l=0; l<n_lines; l++)
+         {
+            int first_label=labels[l*line_length];
+            int last_label=labels[l*line_length+line_length-1];
+            if (first_label >= 0) fill_component[first_label]=false;
+            if (last_label >= 0) fill_component[last_label]=false;
+         }
+
+         for (unsigned int l=1; l<n_lines-1; l++)
          {
-            double curr_z=ztwoDarray_ptr->get(px,py);
-            if (!nearly_equal(curr_z,zfill) && 
-                !nearly_equal(curr_z,zboundary))
+            const int* curr_labels=&labels[l*line_length];
+            for (unsigned int j=1; j<line_length-1; j++)
             {
-//               cout << "nfilled = " << npixels_filled 
-//                    << " px = " << px << " py = " << py 
-//                    << " mdim = " << ztwoDarray_ptr->get_mdim()
-//                    << " ndim = " << ztwoDarray_ptr->get_ndim() << endl;
-//               cout << "curr_z = " << curr_z << " zfill = " << zfill
-//                    << " zboundary = " << zboundary << endl;
-
-//               cout << "prior to put(px,py) px = " << px 
-//                    << " py = " << py <<  " zfill = " << zfill << endl;
-               ztwoDarray_ptr->put(px,py,zfill);
-               npixels_filled++;
-               boundaryFill(npixels_filled,px+1,py,zfill,zboundary,
-                            ztwoDarray_ptr);
-               boundaryFill(npixels_filled,px,py+1,zfill,zboundary,
-                            ztwoDarray_ptr);
-               boundaryFill(npixels_filled,px-1,py,zfill,zboundary,
-                            ztwoDarray_ptr);
-               boundaryFill(npixels_filled,px,py-1,zfill,zboundary,
-                            ztwoDarray_ptr);
+               if (curr_labels[j] >= 0 && fill_component[curr_labels[j]])
+               {
+                  zbinary_twoDarray_ptr->put(pxlo+l,pylo+j,zfill_value);
+               }
             }
-         } // pixel inside working region conditional
+         } // loop over index l
       }
-   
+
 // =====================================================================
 // Pixel cluster detection methods
 // =====================================================================
 
-// Method binary_cluster recursively searches for pixel "lumps".  It
-// takes in twoDarray *ztwoDarray_ptr and creates a binary thresholded
-// version *zbinary_twoDarray_ptr of its contents.  It then scans
-// through zbinary_twoDarray_ptr within the bounding box defined by
-// pxlo < px < pxhi and pylo < py < pyhi.  It looks for zempty_value
-// valued pixels.  When it finds one such pixel, it recursively calls
-// method find_colored_neighbors.  After the recursion is complete,
-// linkedlist *lumplist_ptr[nlumps] contains nodes whose independent
-// variables correspond to the pixel locations of the colored pixels
+// Method binary_cluster searches for pixel "lumps".  It takes in
+// twoDarray *ztwoDarray_ptr and creates a binary thresholded version
+// *zbinary_twoDarray_ptr of its contents.  It then labels the
+// 8-connected components of zempty_value valued pixels within the
+// bounding box defined by pxlo < px < pxhi and pylo < py < pyhi.  By
+// the end of this method, array lumplist_ptr[] contains nlumps
+// linkedlist pointers which point to individual lump pixel
+// information.  Each linkedlist contains nodes whose independent
+// variables correspond to the pixel locations of the lump's pixels
 // and whose dependent variables contain corresponding pixel intensity
-// information.  Within *zbinary_twoDarray_ptr, the initial seed pixel
-// along with all of its neighboring friends are destructively set
-// equal to zfill_value.  After the first lump is completely found,
-// the method continues to scan over the remaining
-// *zbinary_twoDarray_ptr pixels inside the bounding box.  By the end
-// of this method, array lumplist_ptr[] contains nlumps linkedlist
-// pointers which point to individual lump pixel information.
+// information.
+
+// As of Oct 2026, lumps are extracted via union-find labeling rather
+// than depth-capped recursion.  So large lumps are no longer
+// fragmented, and max_recursion_levels and zfill_value are ignored.
 
    void binary_cluster(
       int max_recursion_levels,unsigned int pxlo,unsigned int pxhi,
@@ -954,36 +1221,24 @@ namespace recursivefunc
       const twoDarray* ztwoDarray_ptr,unsigned int& nlumps,
       linkedlist* lumplist_ptr[])
       {
+         nlumps=0;
+         if (pxhi <= pxlo+2 || pyhi <= pylo+2) return;
+
 // First binary threshold input ztwoDarray:
 
          twoDarray* zbinary_twoDarray_ptr=new twoDarray(ztwoDarray_ptr);
          binaryimagefunc::binary_threshold(
             1,ztwoDarray_ptr,zbinary_twoDarray_ptr);
 
-         nlumps=0;
-         int* neighbor_order=NULL;
-         int counter=0;
-         for (unsigned int i=pxlo+1; i<pxhi-1; i++)
-         {
-            for (unsigned int j=pylo+1; j<pyhi-1; j++)
-            {
-               if (zbinary_twoDarray_ptr->get(i,j)==zempty_value)
-               {
-                  int curr_recursive_level=0;
-                  bool deadend=false;
-                  pseudo_random_sequence(counter++,&neighbor_order);
-                  lumplist_ptr[nlumps]=new linkedlist;
-                  find_colored_neighbors(
-                     i,j,max_recursion_levels,
-                     pxlo,pxhi,pylo,pyhi,zempty_value,zfill_value,
-                     curr_recursive_level,deadend,
-                     neighbor_order,zbinary_twoDarray_ptr,
-                     lumplist_ptr[nlumps],ztwoDarray_ptr);
-                  nlumps++;
-               }
-            }  // loop over index j
-         }  // loop over index i
+         vector<int> labels,n_component_pixels;
+         nlumps=label_connected_components(
+            8,pxlo+1,pxhi-1,pylo+1,pyhi-1,zempty_value,
+            zbinary_twoDarray_ptr,labels,n_component_pixels);
          delete zbinary_twoDarray_ptr;
+
+         fill_cluster_lumplists(
+            pxlo+1,pxhi-1,pylo+1,pyhi-1,labels,ztwoDarray_ptr,
+            nlumps,lumplist_ptr);
       }
 
 // ---------------------------------------------------------------------
@@ -994,36 +1249,62 @@ namespace recursivefunc
       const twoDarray* ztwoDarray_ptr,unsigned int& nlumps,
       vector<linkedlist*>& lumplist_ptr)
       {
+         nlumps=0;
+         if (pxhi <= pxlo+2 || pyhi <= pylo+2) return;
+
 // First binary threshold input ztwoDarray:
 
          twoDarray* zbinary_twoDarray_ptr=new twoDarray(ztwoDarray_ptr);
          binaryimagefunc::binary_threshold(
             1,ztwoDarray_ptr,zbinary_twoDarray_ptr);
 
-         nlumps=0;
-         int* neighbor_order=NULL;
+         vector<int> labels,n_component_pixels;
+         nlumps=label_connected_components(
+            8,pxlo+1,pxhi-1,pylo+1,pyhi-1,zempty_value,
+            zbinary_twoDarray_ptr,labels,n_component_pixels);
+         delete zbinary_twoDarray_ptr;
+         if (nlumps==0) return;
+
+         if (lumplist_ptr.size() < nlumps) lumplist_ptr.resize(nlumps,NULL);
+         fill_cluster_lumplists(
+            pxlo+1,pxhi-1,pylo+1,pyhi-1,labels,ztwoDarray_ptr,
+            nlumps,&lumplist_ptr[0]);
+      }
+
+// ---------------------------------------------------------------------
+// Method fill_cluster_lumplists instantiates one linkedlist per
+// connected component within labels.  Its nodes hold the pixel
+// locations and *ztwoDarray_ptr intensities of the component's pixels
+// in scan order.
+
+   void fill_cluster_lumplists(
+      unsigned int pxlo,unsigned int pxhi,unsigned int pylo,unsigned int pyhi,
+      const vector<int>& labels,const twoDarray* ztwoDarray_ptr,
+      unsigned int nlumps,linkedlist* lumplist_ptr[])
+      {
+         const unsigned int n_indep_vars=2;
+         double var[n_indep_vars];
+
+         for (unsigned int l=0; l<nlumps; l++)
+         {
+            lumplist_ptr[l]=new linkedlist;
+         }
+
+         pxhi=basic_math::min(pxhi,ztwoDarray_ptr->get_mdim());
+         pyhi=basic_math::min(pyhi,ztwoDarray_ptr->get_ndim());
          int counter=0;
-         for (unsigned int i=pxlo+1; i<pxhi-1; i++)
+         for (unsigned int i=pxlo; i<pxhi; i++)
          {
-            for (unsigned int j=pylo+1; j<pyhi-1; j++)
+            for (unsigned int j=pylo; j<pyhi; j++)
             {
-               if (zbinary_twoDarray_ptr->get(i,j)==zempty_value)
-               {
-                  int curr_recursive_level=0;
-                  bool deadend=false;
-                  pseudo_random_sequence(counter++,&neighbor_order);
-                  lumplist_ptr[nlumps]=new linkedlist;
-                  find_colored_neighbors(
-                     i,j,max_recursion_levels,
-                     pxlo,pxhi,pylo,pyhi,zempty_value,zfill_value,
-                     curr_recursive_level,deadend,
-                     neighbor_order,zbinary_twoDarray_ptr,
-                     lumplist_ptr[nlumps],ztwoDarray_ptr);
-                  nlumps++;
-               }
-            }  // loop over index j
-         }  // loop over index i
-         delete zbinary_twoDarray_ptr;
+               int curr_label=labels[counter++];
+               if (curr_label < 0) continue;
+               var[0]=i;
+               var[1]=j;
+               lumplist_ptr[curr_label]->append_node(
+                  datapoint(n_indep_vars,var,ztwoDarray_ptr->get(i,j)));
+            }
+         }
       }
 
 // ---------------------------------------------------------------------
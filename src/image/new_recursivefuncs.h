@@ -1,7 +1,7 @@
 // =========================================================================
 // Header file for stand-alone image recursive image processing functions.
 // =========================================================================
-// Last modified on 8/13/04; 8/3/06; 8/5/06; 10/28/07; 4/5/14
+// Last modified on 8/13/04; 8/3/06; 8/5/06; 10/28/07; 4/5/14; 10/18/26
 // =========================================================================
 
 #ifndef RECURSIVEFUNCS_H
@@ -9,6 +9,7 @@
 
 #include <vector>
 #include "datastructures/datapoint.h"
+#include "math/basic_math.h"
 class polygon;
 class threevector;
 template <class T> class Linkedlist;
@@ -122,6 +123,30 @@ namespace recursivefunc
       int& npixels_filled,const unsigned int px,const unsigned int py,
       const double zfill,const double zboundary,twoDarray* ztwoDarray_ptr);
 
+// Iterative filling and connected component labeling methods:
+
+   int scanline_fill(
+      unsigned int px,unsigned int py,double zfill,double zboundary,
+      twoDarray* ztwoDarray_ptr,int n_neighbors=4);
+   int seed_fill(
+      unsigned int px,unsigned int py,double zfill,
+      twoDarray* ztwoDarray_ptr,int n_neighbors=4);
+   int scanline_fill(
+      unsigned int px,unsigned int py,double zfill,double zreference,
+      bool seed_value_flag,int n_neighbors,twoDarray* ztwoDarray_ptr);
+   bool fillable_pixel(
+      double z,double zfill,double zreference,bool seed_value_flag);
+   int label_connected_components(
+      int n_neighbors,unsigned int pxlo,unsigned int pxhi,
+      unsigned int pylo,unsigned int pyhi,double zforeground,
+      const twoDarray* ztwoDarray_ptr,std::vector<int>& labels,
+      std::vector<int>& n_component_pixels,int n_threads=-1);
+   void fill_enclosed_islands(
+      int max_island_size,int n_neighbors,
+      unsigned int pxlo,unsigned int pxhi,unsigned int pylo,unsigned int pyhi,
+      double zempty_value,double zfill_value,
+      twoDarray* zbinary_twoDarray_ptr,int n_threads=-1);
+
 // Pixel cluster detection methods:
 
    void binary_cluster(
@@ -136,6 +161,10 @@ namespace recursivefunc
       double zempty_value,double zfill_value,
       const twoDarray* ztwoDarray_ptr,unsigned int& nlumps,
       std::vector<linkedlist*>& lumplist_ptr);
+   void fill_cluster_lumplists(
+      unsigned int pxlo,unsigned int pxhi,unsigned int pylo,unsigned int pyhi,
+      const std::vector<int>& labels,const twoDarray* ztwoDarray_ptr,
+      unsigned int nlumps,linkedlist* lumplist_ptr[]);
    void find_colored_neighbors(
       int i,int j,int max_recursion_levels,
       unsigned int pxlo,unsigned int pxhi,
@@ -224,6 +253,24 @@ namespace recursivefunc
          return some_neighboring_pixel_empty;
       }
 
+// ---------------------------------------------------------------------
+// Method fillable_pixel returns true if a pixel with value z should be
+// colored by scanline_fill().  Filled pixels nearly equal zfill and
+// are never fillable.
+
+   inline bool fillable_pixel(
+      double z,double zfill,double zreference,bool seed_value_flag)
+      {
+         if (seed_value_flag)
+         {
+            return nearly_equal(z,zreference);
+         }
+         else
+         {
+            return !nearly_equal(z,zfill) && !nearly_equal(z,zreference);
+         }
+      }
+
 } // recursivefunc namespace
 
 #endif // recursivefuncs.h
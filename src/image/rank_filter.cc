@@ -0,0 +1,448 @@
+// ==========================================================================
+// RANK_FILTER class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <algorithm>
+#include <limits>
+#include "image/rank_filter.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using std::cout;
+using std::endl;
+using std::ostream;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void rank_filter::initialize_member_objects()
+{
+   n_intensity_bins=0;
+   tile_width=128;
+   n_threads=0;
+   ignore_value_flag=false;
+   exact_flag=true;
+   histogram_flag=false;
+   ignored_value=0;
+   min_valid_z=-std::numeric_limits<double>::infinity();
+   max_valid_z=std::numeric_limits<double>::infinity();
+   mdim=ndim=0;
+   n_levels=fine_size=n_coarse_levels=0;
+}
+
+// ---------------------------------------------------------------------
+// Even window sizes are incremented so that windows remain centered
+// upon their pixels.
+
+rank_filter::rank_filter(unsigned int nx_size,unsigned int ny_size)
+{
+   initialize_member_objects();
+
+   if (is_even(nx_size)) nx_size++;
+   if (is_even(ny_size)) ny_size++;
+   this->nx_size=nx_size;
+   this->ny_size=ny_size;
+   wx=(nx_size-1)/2;
+   wy=(ny_size-1)/2;
+}
+
+// ---------------------------------------------------------------------
+rank_filter::~rank_filter()
+{
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const rank_filter& R)
+{
+   outstream << endl;
+   outstream << "nx_size = " << R.get_nx_size()
+             << " ny_size = " << R.get_ny_size()
+             << " n_levels = " << R.get_n_levels()
+             << " exact_flag = " << R.get_exact_flag()
+             << endl;
+   return outstream;
+}
+
+// ==========================================================================
+// Filtering member functions
+// ==========================================================================
+
+void rank_filter::median_filter(
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr)
+{
+   percentile_filter(0.5,ztwoDarray_ptr,ztwoDarray_filtered_ptr);
+}
+
+// ---------------------------------------------------------------------
+// Member function percentile_filter() returns within
+// *ztwoDarray_filtered_ptr the intensity whose rank equals
+// cum_frac*n among the n valid intensities within the nx_size x
+// ny_size window surrounding each pixel.  Pixels lying within wx [wy]
+// of the left and right [top and bottom] image borders as well as
+// pixels whose windows contain no valid intensities retain their
+// input values.
+
+// Note: Prior to Oct 2026, imagefunc::median_filter() sorted the n
+// valid window intensities and returned entry npixels/2 where
+// npixels=nx_size*ny_size.  For cum_frac=0.5, the rank n/2 used here
+// agrees with that entry only if every window intensity is valid.
+// Otherwise the old filter read beyond the sorted valid values, while
+// this filter returns the median of the valid values.
+
+void rank_filter::percentile_filter(
+   double cum_frac,twoDarray const *ztwoDarray_ptr,
+   twoDarray *ztwoDarray_filtered_ptr)
+{
+   ztwoDarray_ptr->copy(ztwoDarray_filtered_ptr);
+
+   mdim=ztwoDarray_ptr->get_mdim();
+   ndim=ztwoDarray_ptr->get_ndim();
+   if (mdim < nx_size || ndim < ny_size) return;
+
+   cum_frac=basic_math::max(0.0,basic_math::min(1.0,cum_frac));
+   quantize_intensities(ztwoDarray_ptr);
+
+// Column histogram counts are held as unsigned shorts:
+
+   if (ny_size > 65535) histogram_flag=false;
+   if (histogram_flag && n_levels==0) return;
+
+// Split working columns wx <= px < mdim-wx into vertical tiles:
+
+   unsigned int n_working_columns=mdim-2*wx;
+   unsigned int curr_tile_width=
+      basic_math::max((unsigned int) 1,tile_width);
+   int n_tiles=(n_working_columns+curr_tile_width-1)/curr_tile_width;
+
+   int curr_n_threads=n_threads;
+#ifdef _OPENMP
+   if (curr_n_threads <= 0) curr_n_threads=omp_get_max_threads();
+#else
+   curr_n_threads=1;
+#endif
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(curr_n_threads)
+   for (int t=0; t<n_tiles; t++)
+   {
+      unsigned int px_start=wx+t*curr_tile_width;
+      unsigned int px_stop=basic_math::min(
+         px_start+curr_tile_width,mdim-wx);
+      if (histogram_flag)
+      {
+         filter_tile_via_histograms(
+            px_start,px_stop,cum_frac,ztwoDarray_filtered_ptr);
+      }
+      else
+      {
+         filter_tile_via_selection(
+            px_start,px_stop,cum_frac,ztwoDarray_ptr,
+            ztwoDarray_filtered_ptr);
+      }
+   } // loop over index t labeling tiles
+}
+
+// ---------------------------------------------------------------------
+// Private member function quantize_intensities() maps every valid
+// input intensity onto an integer level.  Without a specified bin
+// count, levels enumerate the sorted distinct valid intensities.  If
+// there are more than max_exact_levels of these, histogram_flag is
+// set to false and filtering proceeds via exact selection instead.
+
+void rank_filter::quantize_intensities(twoDarray const *ztwoDarray_ptr)
+{
+   levels.assign(mdim*ndim,-1);
+   level_values.clear();
+   n_levels=0;
+
+   vector<double> valid_values;
+   valid_values.reserve(mdim*ndim);
+   for (unsigned int py=0; py<ndim; py++)
+   {
+      for (unsigned int px=0; px<mdim; px++)
+      {
+         double z=ztwoDarray_ptr->get(px,py);
+         if (valid_intensity(z)) valid_values.push_back(z);
+      }
+   }
+
+   histogram_flag=true;
+   exact_flag=true;
+   if (valid_values.size()==0) return;
+
+   if (n_intensity_bins==0)
+   {
+      std::sort(valid_values.begin(),valid_values.end());
+      valid_values.erase(
+         std::unique(valid_values.begin(),valid_values.end()),
+         valid_values.end());
+      if (valid_values.size() > max_exact_levels)
+      {
+         histogram_flag=false;
+         levels.clear();
+         return;
+      }
+
+      level_values.swap(valid_values);
+      n_levels=level_values.size();
+      for (unsigned int py=0; py<ndim; py++)
+      {
+         for (unsigned int px=0; px<mdim; px++)
+         {
+            double z=ztwoDarray_ptr->get(px,py);
+            if (!valid_intensity(z)) continue;
+            levels[px+mdim*py]=std::lower_bound(
+               level_values.begin(),level_values.end(),z)-
+               level_values.begin();
+         }
+      }
+   }
+   else
+   {
+
+// Evenly spaced bins run from the minimum to the maximum valid
+// intensity:
+
+      exact_flag=false;
+      double min_z=*std::min_element(valid_values.begin(),valid_values.end());
+      double max_z=*std::max_element(valid_values.begin(),valid_values.end());
+      n_levels=basic_math::min(n_intensity_bins,max_exact_levels);
+      if (n_levels < 2 || nearly_equal(min_z,max_z)) n_levels=1;
+      double dz=(n_levels > 1 ? (max_z-min_z)/(n_levels-1) : 1);
+
+      for (unsigned int l=0; l<n_levels; l++)
+      {
+         level_values.push_back(min_z+l*dz);
+      }
+      for (unsigned int py=0; py<ndim; py++)
+      {
+         for (unsigned int px=0; px<mdim; px++)
+         {
+            double z=ztwoDarray_ptr->get(px,py);
+            if (!valid_intensity(z)) continue;
+            int l=basic_math::round((z-min_z)/dz);
+            levels[px+mdim*py]=basic_math::max(
+               0,basic_math::min(int(n_levels)-1,l));
+         }
+      }
+   }
+
+// Choose fine segment size as the smallest power of two whose square
+// covers all levels:
+
+   fine_size=1;
+   while (fine_size*fine_size < n_levels)
+   {
+      fine_size *= 2;
+   }
+   n_coarse_levels=(n_levels+fine_size-1)/fine_size;
+}
+
+// ---------------------------------------------------------------------
+// Private member function filter_tile_via_histograms() processes
+// working columns px_start <= px < px_stop.  Column histograms are
+// maintained for all columns px_start-wx <= x < px_stop+wx which
+// contribute to the tile's windows.  Fine segments of the window
+// histogram record the column px at which they were last brought up
+// to date.  When a segment is needed, it is advanced by the columns
+// entering and leaving since then, or rebuilt from scratch if that
+// would be cheaper.
+
+void rank_filter::filter_tile_via_histograms(
+   unsigned int px_start,unsigned int px_stop,double cum_frac,
+   twoDarray *ztwoDarray_filtered_ptr) const
+{
+   const int stale_posn=-1;
+   unsigned int n_columns=px_stop-px_start+2*wx;
+   unsigned int n_padded_levels=n_coarse_levels*fine_size;
+   unsigned int x_offset=px_start-wx;
+
+   vector<unsigned short> column_fine(n_columns*n_padded_levels,0);
+   vector<unsigned short> column_coarse(n_columns*n_coarse_levels,0);
+   vector<unsigned int> column_count(n_columns,0);
+   vector<unsigned int> window_fine(n_padded_levels);
+   vector<unsigned int> window_coarse(n_coarse_levels);
+   vector<int> segment_posn(n_coarse_levels);
+
+   for (unsigned int py=wy; py<ndim-wy; py++)
+   {
+
+// Step column histograms down to rows py-wy <= y <= py+wy:
+
+      for (unsigned int j=0; j<n_columns; j++)
+      {
+         unsigned int x=x_offset+j;
+         unsigned short* fine_ptr=&column_fine[j*n_padded_levels];
+         unsigned short* coarse_ptr=&column_coarse[j*n_coarse_levels];
+         if (py==wy)
+         {
+            for (unsigned int y=0; y<ny_size; y++)
+            {
+               int l=levels[x+mdim*y];
+               if (l < 0) continue;
+               fine_ptr[l]++;
+               coarse_ptr[l/fine_size]++;
+               column_count[j]++;
+            }
+         }
+         else
+         {
+            int l=levels[x+mdim*(py-wy-1)];
+            if (l >= 0)
+            {
+               fine_ptr[l]--;
+               coarse_ptr[l/fine_size]--;
+               column_count[j]--;
+            }
+            l=levels[x+mdim*(py+wy)];
+            if (l >= 0)
+            {
+               fine_ptr[l]++;
+               coarse_ptr[l/fine_size]++;
+               column_count[j]++;
+            }
+         }
+      } // loop over index j labeling columns
+
+// Initialize window's coarse histogram at start of row.  All fine
+// segments are initially stale:
+
+      std::fill(window_coarse.begin(),window_coarse.end(),0);
+      std::fill(segment_posn.begin(),segment_posn.end(),stale_posn);
+      unsigned int window_count=0;
+      for (unsigned int j=0; j<nx_size; j++)
+      {
+         const unsigned short* coarse_ptr=&column_coarse[j*n_coarse_levels];
+         for (unsigned int c=0; c<n_coarse_levels; c++)
+         {
+            window_coarse[c] += coarse_ptr[c];
+         }
+         window_count += column_count[j];
+      }
+
+      for (unsigned int px=px_start; px<px_stop; px++)
+      {
+
+// Window centered on px covers local columns j_first <= j <= j_first
+// + nx_size - 1:
+
+         unsigned int j_first=px-px_start;
+         if (px > px_start)
+         {
+            const unsigned short* leaving_ptr=
+               &column_coarse[(j_first-1)*n_coarse_levels];
+            const unsigned short* entering_ptr=
+               &column_coarse[(j_first+nx_size-1)*n_coarse_levels];
+            for (unsigned int c=0; c<n_coarse_levels; c++)
+            {
+               window_coarse[c] += entering_ptr[c]-leaving_ptr[c];
+            }
+            window_count += column_count[j_first+nx_size-1]-
+               column_count[j_first-1];
+         }
+         if (window_count==0) continue;
+
+         unsigned int rank=basic_math::min(
+            window_count-1,(unsigned int) (cum_frac*window_count));
+
+// Locate coarse level containing requested rank:
+
+         unsigned int c=0;
+         unsigned int n_below=0;
+         while (n_below+window_coarse[c] <= rank)
+         {
+            n_below += window_coarse[c];
+            c++;
+         }
+
+// Bring fine segment c up to date:
+
+         unsigned int* segment_ptr=&window_fine[c*fine_size];
+         int prev_posn=segment_posn[c];
+         if (prev_posn==stale_posn || px-prev_posn >= nx_size)
+         {
+            std::fill(segment_ptr,segment_ptr+fine_size,0);
+            for (unsigned int j=j_first; j<j_first+nx_size; j++)
+            {
+               const unsigned short* fine_ptr=
+                  &column_fine[j*n_padded_levels+c*fine_size];
+               for (unsigned int f=0; f<fine_size; f++)
+               {
+                  segment_ptr[f] += fine_ptr[f];
+               }
+            }
+         }
+         else
+         {
+            for (unsigned int q=prev_posn+1; q<=px; q++)
+            {
+               unsigned int j_leaving=q-px_start-1;
+               const unsigned short* leaving_ptr=
+                  &column_fine[j_leaving*n_padded_levels+c*fine_size];
+               const unsigned short* entering_ptr=
+                  &column_fine[(j_leaving+nx_size)*n_padded_levels+
+                               c*fine_size];
+               for (unsigned int f=0; f<fine_size; f++)
+               {
+                  segment_ptr[f] += entering_ptr[f]-leaving_ptr[f];
+               }
+            }
+         }
+         segment_posn[c]=px;
+
+// Locate fine level containing requested rank:
+
+         unsigned int f=0;
+         while (n_below+segment_ptr[f] <= rank)
+         {
+            n_below += segment_ptr[f];
+            f++;
+         }
+         ztwoDarray_filtered_ptr->put(px,py,level_values[c*fine_size+f]);
+      } // loop over px
+   } // loop over py
+}
+
+// ---------------------------------------------------------------------
+// Private member function filter_tile_via_selection() is the exact
+// fallback for images containing too many distinct intensities.  It
+// gathers each window's valid intensities and selects the requested
+// rank via std::nth_element rather than a full sort.
+
+void rank_filter::filter_tile_via_selection(
+   unsigned int px_start,unsigned int px_stop,double cum_frac,
+   twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr) const
+{
+   vector<double> intensity;
+   intensity.reserve(nx_size*ny_size);
+
+   for (unsigned int py=wy; py<ndim-wy; py++)
+   {
+      for (unsigned int px=px_start; px<px_stop; px++)
+      {
+         intensity.clear();
+         for (unsigned int y=py-wy; y<=py+wy; y++)
+         {
+            for (unsigned int x=px-wx; x<=px+wx; x++)
+            {
+               double z=ztwoDarray_ptr->get(x,y);
+               if (valid_intensity(z)) intensity.push_back(z);
+            }
+         }
+         unsigned int n=intensity.size();
+         if (n==0) continue;
+
+         unsigned int rank=basic_math::min(n-1,(unsigned int) (cum_frac*n));
+         std::nth_element(
+            intensity.begin(),intensity.begin()+rank,intensity.end());
+         ztwoDarray_filtered_ptr->put(px,py,intensity[rank]);
+      } // loop over px
+   } // loop over py
+}
@@ -0,0 +1,172 @@
+// ==========================================================================
+// Header file for RANK_FILTER class which computes moving-window
+// median and percentile images in constant time per pixel.  Pixel
+// intensities are first mapped onto integer levels.  Following
+// Perreault and Hebert's "Median filtering in constant time", every
+// image column then maintains a histogram of its ny_size intensity
+// levels which is updated by one removal and one insertion as the
+// window steps down a row.  The window histogram is formed from
+// nx_size column histograms and slides across a row by adding one
+// column and subtracting another.  Histograms are split into coarse
+// and fine levels.  Coarse counts are always kept current, while a
+// fine segment is brought up to date only when the requested rank
+// falls inside it.
+
+// If no bin count is specified, levels correspond to the distinct
+// valid intensities within the input image.  Results then equal those
+// from sorting each window.  Images with more distinct values than
+// max_exact_levels fall back to exact per-window selection.  If
+// n_intensity_bins > 0, intensities are quantized into evenly spaced
+// bins and results are approximate.
+
+// Images are divided into vertical tiles which are filtered in
+// parallel by OpenMP threads.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef RANK_FILTER_H
+#define RANK_FILTER_H
+
+#include <iostream>
+#include <vector>
+#include "image/TwoDarray.h"
+#include "math/basic_math.h"
+
+class rank_filter
+{
+
+  public:
+
+   static const unsigned int max_exact_levels=65536;
+
+   rank_filter(unsigned int nx_size,unsigned int ny_size);
+   ~rank_filter();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const rank_filter& R);
+
+// Set and get member functions:
+
+   void set_n_intensity_bins(unsigned int n);
+   void set_ignored_value(double z);
+   void set_valid_interval(double min_z,double max_z);
+   void set_tile_width(unsigned int w);
+   void set_n_threads(int n);
+
+   unsigned int get_nx_size() const;
+   unsigned int get_ny_size() const;
+   unsigned int get_n_levels() const;
+   bool get_exact_flag() const;
+
+// Filtering member functions:
+
+   void median_filter(
+      twoDarray const *ztwoDarray_ptr,twoDarray *ztwoDarray_filtered_ptr);
+   void percentile_filter(
+      double cum_frac,twoDarray const *ztwoDarray_ptr,
+      twoDarray *ztwoDarray_filtered_ptr);
+
+  private:
+
+   unsigned int nx_size,ny_size,wx,wy;
+   unsigned int n_intensity_bins,tile_width;
+   int n_threads;
+   bool ignore_value_flag,exact_flag,histogram_flag;
+   double ignored_value,min_valid_z,max_valid_z;
+
+// Integer levels for all pixels are held within STL vector levels
+// with px varying fastest.  Invalid pixels are assigned level -1.
+// Level l represents intensity level_values[l]:
+
+   unsigned int mdim,ndim;
+   unsigned int n_levels,fine_size,n_coarse_levels;
+   std::vector<int> levels;
+   std::vector<double> level_values;
+
+   void initialize_member_objects();
+
+   bool valid_intensity(double z) const;
+   void quantize_intensities(twoDarray const *ztwoDarray_ptr);
+   void filter_tile_via_histograms(
+      unsigned int px_start,unsigned int px_stop,double cum_frac,
+      twoDarray *ztwoDarray_filtered_ptr) const;
+   void filter_tile_via_selection(
+      unsigned int px_start,unsigned int px_stop,double cum_frac,
+      twoDarray const *ztwoDarray_ptr,
+      twoDarray *ztwoDarray_filtered_ptr) const;
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+// Set and get member functions:
+
+// Setting n_intensity_bins > 0 trades exactness for bounded histogram
+// sizes:
+
+inline void rank_filter::set_n_intensity_bins(unsigned int n)
+{
+   n_intensity_bins=n;
+}
+
+// Pixels whose intensities nearly equal an ignored value (e.g. a null
+// value) do not contribute to any window:
+
+inline void rank_filter::set_ignored_value(double z)
+{
+   ignore_value_flag=true;
+   ignored_value=z;
+}
+
+// Only intensities satisfying min_z < z < max_z contribute to
+// windows:
+
+inline void rank_filter::set_valid_interval(double min_z,double max_z)
+{
+   min_valid_z=min_z;
+   max_valid_z=max_z;
+}
+
+inline void rank_filter::set_tile_width(unsigned int w)
+{
+   tile_width=w;
+}
+
+// If n_threads <= 0, the OpenMP default number of threads is used:
+
+inline void rank_filter::set_n_threads(int n)
+{
+   n_threads=n;
+}
+
+inline unsigned int rank_filter::get_nx_size() const
+{
+   return nx_size;
+}
+
+inline unsigned int rank_filter::get_ny_size() const
+{
+   return ny_size;
+}
+
+inline unsigned int rank_filter::get_n_levels() const
+{
+   return n_levels;
+}
+
+// Boolean member function get_exact_flag() indicates whether the most
+// recently filtered image equals its brute-force sorted analog:
+
+inline bool rank_filter::get_exact_flag() const
+{
+   return exact_flag;
+}
+
+inline bool rank_filter::valid_intensity(double z) const
+{
+   if (ignore_value_flag && nearly_equal(z,ignored_value)) return false;
+   return (z > min_valid_z && z < max_valid_z);
+}
+
+#endif  // rank_filter.h
@@ -1,9 +1,14 @@
 // ==========================================================================
 // GROUNDFUNCS stand-alone methods
 // ==========================================================================
-// Last modified on 11/1/07; 11/5/07; 11/11/07; 12/4/10
+// Last modified on 11/1/07; 11/5/07; 11/11/07; 12/4/10; 10/18/26
 // ==========================================================================
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <functional>
+#include <queue>
 #include "image/binaryimagefuncs.h"
 #include "image/drawfuncs.h"
 #include "ladar/featurefuncs.h"
@@ -468,68 +473,16 @@ namespace groundfunc
 // low.  In this fashion, "relatively low" classification oozes
 // throughout the entire image.
    
-         int nchanges,iter=0;
-
-// Initialize entries within delta_s array:
-
-         vector<double> delta_s=graphicsfunc::compute_delta_s_values(
-            ztwoDarray_ptr->get_deltax(),ztwoDarray_ptr->get_deltay());
+// As of Oct 2026, ground classification is grown via a tiled priority
+// flood which visits each pixel once rather than via repeated
+// local_ground_ooze() sweeps:
 
-         vector<pair<int,int> >* pixel_posns_ptr=
-            new vector<pair<int,int> >;
-         vector<pair<int,int> >*  new_pixel_posns_ptr=
-            new vector<pair<int,int> >;
+         tiled_priority_flood_ground(
+            ztwoDarray_ptr,groundmask_twoDarray_ptr,
+            max_gradient_magnitude_lo);
 
          const unsigned int mdim=ztwoDarray_ptr->get_mdim();
          const unsigned int ndim=ztwoDarray_ptr->get_ndim();
-         for (unsigned int px=0; px<mdim; px++)
-         {
-            for (unsigned int py=0; py<ndim; py++)
-            {
-               pixel_posns_ptr->push_back(pair<int,int>(px,py));
-            }
-         }
-
-         do
-         {
-            nchanges=0;
-            new_pixel_posns_ptr->clear();
-
-            for (unsigned int pixel_counter=0; pixel_counter<
-                    pixel_posns_ptr->size(); pixel_counter++)
-            {
-               unsigned int px=pixel_posns_ptr->at(pixel_counter).first;
-               unsigned int py=pixel_posns_ptr->at(pixel_counter).second;
-               local_ground_ooze(
-                  px,py,ztwoDarray_ptr,groundmask_twoDarray_ptr,
-                  max_gradient_magnitude_lo,delta_s,nchanges,
-                  new_pixel_posns_ptr);
-            } // loop over pixel counter index
-            if (iter%1000==0)
-            {
-               cout << "iter = " << iter << " nchanges = " << nchanges 
-                    << " new_pixel_posns.size() = " 
-                    << new_pixel_posns_ptr->size()
-                    << endl;
-            }
-
-            pixel_posns_ptr->clear();
-            for (unsigned int pixel_counter=0; pixel_counter<
-                    new_pixel_posns_ptr->size(); pixel_counter++)
-            {
-               pixel_posns_ptr->push_back(
-                  new_pixel_posns_ptr->at(pixel_counter));
-            }
-            iter++;
-         }
-
-// FAKE FAKE:  for alg testing only...Fri Oct 26 at 9:30 pm...
-
-//         while (nchanges > 0 && iter < 5000);
-         while (nchanges > 0);
-
-         delete pixel_posns_ptr;
-         delete new_pixel_posns_ptr;
 
 // At this point, we assume that all remaining null-valued entries
 // within *groundmask_twoDarray_ptr which do NOT correspond to
@@ -656,6 +609,277 @@ namespace groundfunc
          } // z(px,py)==null conditional
       }
    
+// ---------------------------------------------------------------------
+// Method ooze_delta_s_index returns the entry within delta_s which
+// local_ground_ooze() divides by when testing neighbor (px+i,py+j) of
+// pixel (px,py).  local_ground_ooze() indexes delta_s via a loop
+// counter which skips neighbors lying outside the image.  So along
+// image borders, the index is shifted relative to the 3x3 layout
+// returned by graphicsfunc::compute_delta_s_values().  We reproduce
+// that convention so that flooding yields identical ground masks.
+
+   int ooze_delta_s_index(
+      unsigned int px,unsigned int py,int i,int j,
+      unsigned int mdim,unsigned int ndim)
+      {
+         int ilo=(px==0) ? 0 : -1;
+         int jlo=(py==0) ? 0 : -1;
+         int jhi=(py==ndim-1) ? 0 : 1;
+         return (i-ilo)*(jhi-jlo+1)+(j-jlo);
+      }
+
+// ---------------------------------------------------------------------
+// Method priority_flood_ground grows ground classification outward
+// from all pixels within *groundmask_twoDarray_ptr which equal 0.
+// Like local_ground_ooze(), it classifies a null-valued mask pixel
+// with non-null height as ground if the height derivative between it
+// and some 8-connected ground neighbor is smaller in magnitude than
+// max_gradient_magnitude_lo.  But rather than repeatedly sweeping the
+// image until no changes occur, ground pixels are popped from a
+// priority queue in order of increasing height.  So every pixel is
+// visited at most once.  Since the classification test depends only
+// upon heights, the final mask is the same as the one which
+// find_low_local_pixels() formerly generated by iterating
+// local_ground_ooze().
+
+// If data_bbox_ptr != NULL, only pixels lying inside the
+// parallelogram may be classified as ground.
+
+   void priority_flood_ground(
+      twoDarray const *ztwoDarray_ptr,twoDarray* groundmask_twoDarray_ptr,
+      double max_gradient_magnitude_lo,parallelogram const *data_bbox_ptr)
+      {
+         unsigned int tile_size=basic_math::max(
+            ztwoDarray_ptr->get_mdim(),ztwoDarray_ptr->get_ndim());
+         tiled_priority_flood_ground(
+            ztwoDarray_ptr,groundmask_twoDarray_ptr,
+            max_gradient_magnitude_lo,tile_size,1,data_bbox_ptr);
+      }
+
+// ---------------------------------------------------------------------
+// Method tiled_priority_flood_ground divides the height image into
+// tile_size x tile_size tiles which are flooded in parallel.  Each
+// tile works upon a private copy of its ground mask which is padded
+// by a one pixel halo.  Tiles only classify their own pixels.
+// Ground pixels which are newly found along a tile's borders are
+// exported after every round.  They are then copied into the halos of
+// adjacent tiles and seed those tiles' priority queues for the next
+// round.  Rounds continue until no tile has any new seeds.  So the
+// final mask is independent of tile_size and the number of threads.
+
+   struct ground_flood_tile
+   {
+      unsigned int px_lo,px_hi,py_lo,py_hi;	// Tile's own pixels
+      unsigned int hx_lo,hx_hi,hy_lo,hy_hi;	// Own pixels plus halo
+      vector<double> mask;
+      vector<unsigned int> seeds;
+      vector<pair<unsigned int,unsigned int> > exports;
+   };
+
+   void tiled_priority_flood_ground(
+      twoDarray const *ztwoDarray_ptr,twoDarray* groundmask_twoDarray_ptr,
+      double max_gradient_magnitude_lo,unsigned int tile_size,int n_threads,
+      parallelogram const *data_bbox_ptr)
+      {
+         const unsigned int mdim=ztwoDarray_ptr->get_mdim();
+         const unsigned int ndim=ztwoDarray_ptr->get_ndim();
+         if (mdim==0 || ndim==0) return;
+         tile_size=basic_math::max(tile_size,1U);
+
+#ifdef _OPENMP
+         if (n_threads <= 0) n_threads=omp_get_max_threads();
+#else
+         n_threads=1;
+#endif
+
+         vector<double> delta_s=graphicsfunc::compute_delta_s_values(
+            ztwoDarray_ptr->get_deltax(),ztwoDarray_ptr->get_deltay());
+
+         const unsigned int n_xtiles=(mdim+tile_size-1)/tile_size;
+         const unsigned int n_ytiles=(ndim+tile_size-1)/tile_size;
+         const int n_tiles=n_xtiles*n_ytiles;
+         vector<ground_flood_tile> tiles(n_tiles);
+
+// Copy each tile's mask plus halo and seed its queue with every
+// ground pixel:
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(n_threads)
+         for (int t=0; t<n_tiles; t++)
+         {
+            ground_flood_tile& tile=tiles[t];
+            tile.px_lo=(t/n_ytiles)*tile_size;
+            tile.px_hi=basic_math::min(tile.px_lo+tile_size,mdim);
+            tile.py_lo=(t%n_ytiles)*tile_size;
+            tile.py_hi=basic_math::min(tile.py_lo+tile_size,ndim);
+            tile.hx_lo=(tile.px_lo > 0) ? tile.px_lo-1 : 0;
+            tile.hx_hi=basic_math::min(tile.px_hi+1,mdim);
+            tile.hy_lo=(tile.py_lo > 0) ? tile.py_lo-1 : 0;
+            tile.hy_hi=basic_math::min(tile.py_hi+1,ndim);
+
+            unsigned int halo_ndim=tile.hy_hi-tile.hy_lo;
+            tile.mask.resize((tile.hx_hi-tile.hx_lo)*halo_ndim);
+            for (unsigned int px=tile.hx_lo; px<tile.hx_hi; px++)
+            {
+               for (unsigned int py=tile.hy_lo; py<tile.hy_hi; py++)
+               {
+                  unsigned int l=(px-tile.hx_lo)*halo_ndim+py-tile.hy_lo;
+                  tile.mask[l]=groundmask_twoDarray_ptr->get(px,py);
+                  if (tile.mask[l]==0) tile.seeds.push_back(l);
+               }
+            }
+         } // loop over index t labeling tiles
+
+         int round=0;
+         bool seeds_remaining=true;
+         while (seeds_remaining)
+         {
+
+// Flood each tile starting from its current seeds:
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(n_threads)
+            for (int t=0; t<n_tiles; t++)
+            {
+               ground_flood_tile& tile=tiles[t];
+               if (tile.seeds.empty()) continue;
+               unsigned int halo_ndim=tile.hy_hi-tile.hy_lo;
+
+               std::priority_queue<
+                  pair<double,unsigned int>,
+                  vector<pair<double,unsigned int> >,
+                  std::greater<pair<double,unsigned int> > > ground_queue;
+               for (unsigned int s=0; s<tile.seeds.size(); s++)
+               {
+                  unsigned int l=tile.seeds[s];
+                  unsigned int px=tile.hx_lo+l/halo_ndim;
+                  unsigned int py=tile.hy_lo+l%halo_ndim;
+                  ground_queue.push(pair<double,unsigned int>(
+                     ztwoDarray_ptr->get(px,py),l));
+               }
+               tile.seeds.clear();
+
+               threevector currpoint;
+               while (!ground_queue.empty())
+               {
+                  double zground=ground_queue.top().first;
+                  unsigned int l=ground_queue.top().second;
+                  ground_queue.pop();
+                  unsigned int qx=tile.hx_lo+l/halo_ndim;
+                  unsigned int qy=tile.hy_lo+l%halo_ndim;
+
+                  for (int i=-1; i<=1; i++)
+                  {
+                     if ((i < 0 && qx==0) || (i > 0 && qx+1 >= mdim)) continue;
+                     unsigned int px=qx+i;
+                     if (px < tile.px_lo || px >= tile.px_hi) continue;
+                     for (int j=-1; j<=1; j++)
+                     {
+                        if (i==0 && j==0) continue;
+                        if ((j < 0 && qy==0) || (j > 0 && qy+1 >= ndim)) 
+                           continue;
+                        unsigned int py=qy+j;
+                        if (py < tile.py_lo || py >= tile.py_hi) continue;
+
+                        unsigned int lnew=
+                           (px-tile.hx_lo)*halo_ndim+py-tile.hy_lo;
+                        if (tile.mask[lnew] != xyzpfunc::null_value) continue;
+                        double curr_z=ztwoDarray_ptr->get(px,py);
+                        if (curr_z <= xyzpfunc::null_value) continue;
+
+                        double abs_z_deriv=fabs(zground-curr_z)/
+                           delta_s[ooze_delta_s_index(
+                              px,py,-i,-j,mdim,ndim)];
+                        if (!(abs_z_deriv < max_gradient_magnitude_lo)) 
+                           continue;
+
+                        if (data_bbox_ptr != NULL)
+                        {
+                           ztwoDarray_ptr->pixel_to_point(px,py,currpoint);
+                           if (!data_bbox_ptr->point_inside(currpoint)) 
+                              continue;
+                        }
+
+                        tile.mask[lnew]=0;
+                        ground_queue.push(
+                           pair<double,unsigned int>(curr_z,lnew));
+                        if (px==tile.px_lo || px==tile.px_hi-1 ||
+                            py==tile.py_lo || py==tile.py_hi-1)
+                        {
+                           tile.exports.push_back(
+                              pair<unsigned int,unsigned int>(px,py));
+                        }
+                     } // loop over index j
+                  } // loop over index i
+               } // ground_queue not empty while loop
+            } // loop over index t labeling tiles
+
+// Exchange halos: border pixels exported by adjacent tiles become
+// seeds for the next round:
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(n_threads)
+            for (int t=0; t<n_tiles; t++)
+            {
+               ground_flood_tile& tile=tiles[t];
+               unsigned int halo_ndim=tile.hy_hi-tile.hy_lo;
+               int tx=t/n_ytiles;
+               int ty=t%n_ytiles;
+               for (int u=basic_math::max(tx-1,0); 
+                    u<=basic_math::min(tx+1,int(n_xtiles)-1); u++)
+               {
+                  for (int v=basic_math::max(ty-1,0); 
+                       v<=basic_math::min(ty+1,int(n_ytiles)-1); v++)
+                  {
+                     if (u==tx && v==ty) continue;
+                     const vector<pair<unsigned int,unsigned int> >& 
+                        exports=tiles[u*n_ytiles+v].exports;
+                     for (unsigned int e=0; e<exports.size(); e++)
+                     {
+                        unsigned int px=exports[e].first;
+                        unsigned int py=exports[e].second;
+                        if (px < tile.hx_lo || px >= tile.hx_hi ||
+                            py < tile.hy_lo || py >= tile.hy_hi) continue;
+                        unsigned int l=
+                           (px-tile.hx_lo)*halo_ndim+py-tile.hy_lo;
+                        if (tile.mask[l]==0) continue;
+                        tile.mask[l]=0;
+                        tile.seeds.push_back(l);
+                     }
+                  } // loop over index v
+               } // loop over index u
+            } // loop over index t labeling tiles
+
+            seeds_remaining=false;
+            for (int t=0; t<n_tiles; t++)
+            {
+               tiles[t].exports.clear();
+               if (!tiles[t].seeds.empty()) seeds_remaining=true;
+            }
+            round++;
+         } // seeds_remaining while loop
+
+         if (n_tiles > 1)
+         {
+            cout << "Number of halo exchange rounds = " << round << endl;
+         }
+
+// Copy tiles' own pixels back into *groundmask_twoDarray_ptr:
+
+#pragma omp parallel for schedule(dynamic,1) num_threads(n_threads)
+         for (int t=0; t<n_tiles; t++)
+         {
+            const ground_flood_tile& tile=tiles[t];
+            unsigned int halo_ndim=tile.hy_hi-tile.hy_lo;
+            for (unsigned int px=tile.px_lo; px<tile.px_hi; px++)
+            {
+               for (unsigned int py=tile.py_lo; py<tile.py_hi; py++)
+               {
+                  groundmask_twoDarray_ptr->put(
+                     px,py,tile.mask[
+                        (px-tile.hx_lo)*halo_ndim+py-tile.hy_lo]);
+               }
+            }
+         } // loop over index t labeling tiles
+      }
+
 // ---------------------------------------------------------------------
    twoDarray* find_low_local_pixels(
       const vector<threevector>& groundpoint_XYZ,
@@ -666,8 +890,6 @@ namespace groundfunc
 
          const unsigned int mdim=ztwoDarray_ptr->get_mdim();
          const unsigned int ndim=ztwoDarray_ptr->get_ndim();
-         const double dx=ztwoDarray_ptr->get_deltax();
-         const double dy=ztwoDarray_ptr->get_deltay();
    
 // First mark manually selected groundpoints within binary mask
 // *zhilo_twoDarray_ptr:
@@ -681,93 +903,18 @@ namespace groundfunc
             zhilo_twoDarray_ptr->put(px,py,0);
          }
 
-// Next initialize entries within delta_s array:
-
-         vector<double> delta_s=graphicsfunc::compute_delta_s_values(dx,dy);
-
 // Scan over every unclassified pixel within the height image.  If it
 // is adjacent to some pixel which has been classified as relatively
 // low, form crude height derivative between that neighbor and the
 // current unclassified pixel.  If the derivative's magnitude is
 // sufficiently small, declare current pixel to also be relatively
 // low.  In this fashion, "relatively low" classification oozes
-// throughout the entire image.
-   
-         int nchanges,iter=0;
-         int max_iters=300;
-         threevector currpoint;
-         do
-         {
-            nchanges=0;
-            for (unsigned int px=0; px<mdim; px++)
-            {
-               if (px%100==0) cout << px << " " << flush;
-               for (unsigned int py=0; py<ndim; py++)
-               {
-                  int n_eff=ndim*px+py;
-                  double curr_z=ztwoDarray_ptr->get(n_eff);
-                  bool pixel_lies_inside_bbox_flag=true;
-
-                  if (data_bbox_ptr != NULL)
-                  {
-                     ztwoDarray_ptr->pixel_to_point(px,py,currpoint);
-                     if (!data_bbox_ptr->point_inside(currpoint))
-                     {
-                        pixel_lies_inside_bbox_flag=false;
-                     }
-                  }
-
-                  if (pixel_lies_inside_bbox_flag &&
-                      curr_z > xyzpfunc::null_value &&
-                      zhilo_twoDarray_ptr->get(n_eff)==xyzpfunc::null_value)
-                  {
-                     int counter=0;
+// throughout the entire image.  As of Oct 2026, oozing is performed
+// by a tiled priority flood rather than by at most 300 full sweeps:
 
-                     int ilo=-1;
-                     int ihi=1;
-                     if (px==0) ilo=0;
-                     if (px==mdim-1) ihi=0;
-
-                     for (int i=ilo; i<=ihi; i++)
-//                     for (int i=-1; i<=1; i++)
-                     {
-
-                        int jlo=-1;
-                        int jhi=1;
-                        if (py==0) jlo=0;
-                        if (py==ndim-1) jhi=0;
-                        
-                        for (int j=jlo; j<=jhi; j++)
-                        {
-                           int n2_eff=ndim*(px+i)+(py+j);
-                           if (zhilo_twoDarray_ptr->get(n2_eff)==0)
-                           {
-                              double abs_z_deriv=
-                                 fabs(ztwoDarray_ptr->get(n2_eff)-curr_z)/
-                                 delta_s[counter];
-                              if (abs_z_deriv < max_gradient_magnitude_lo)
-                              {
-                                 zhilo_twoDarray_ptr->put(n_eff,0);
-                                 nchanges++;
-                                 break;
-                              }
-                           }
-                           counter++;
-                        } // loop over j index
-                     } // loop over i index
-                     
-                  } // pixel_lies_inside_bbox && z(px,py)==null conditional
-               } // loop over py index
-            } // loop over px index
-            outputfunc::newline();
-//            if (iter%10==0)
-            {
-               cout << "iter = " << iter << " nchanges = " << nchanges 
-                    << endl;
-            }
-            iter++;
-         }
-         while (nchanges > 0 && iter < max_iters);
+         tiled_priority_flood_ground(
+            ztwoDarray_ptr,zhilo_twoDarray_ptr,max_gradient_magnitude_lo,
+            512,-1,data_bbox_ptr);
 
 // At this point, we assume that all remaining null-valued entries
 // within the z_hilo matrix which do NOT correspond to null-valued
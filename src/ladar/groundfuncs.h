@@ -1,7 +1,7 @@
 // =========================================================================
 // Header file for ground extraction functions.
 // =========================================================================
-// Last modified on 11/1/07; 11/10/07; 11/11/07
+// Last modified on 11/1/07; 11/10/07; 11/11/07; 10/18/26
 // =========================================================================
 
 #ifndef GROUNDFUNCS_H
@@ -57,6 +57,17 @@ namespace groundfunc
       double max_gradient_magnitude_lo,
       const std::vector<double>& delta_s,int& nchanges,
       std::vector<std::pair<int,int> >* new_pixel_posns_ptr);
+   int ooze_delta_s_index(
+      unsigned int px,unsigned int py,int i,int j,
+      unsigned int mdim,unsigned int ndim);
+   void priority_flood_ground(
+      twoDarray const *ztwoDarray_ptr,twoDarray* groundmask_twoDarray_ptr,
+      double max_gradient_magnitude_lo,
+      parallelogram const *data_bbox_ptr=NULL);
+   void tiled_priority_flood_ground(
+      twoDarray const *ztwoDarray_ptr,twoDarray* groundmask_twoDarray_ptr,
+      double max_gradient_magnitude_lo,unsigned int tile_size=512,
+      int n_threads=-1,parallelogram const *data_bbox_ptr=NULL);
    twoDarray* find_low_local_pixels(
       const std::vector<threevector>& groundpoint_XYZ,
       twoDarray const *ztwoDarray_ptr,double max_gradient_magnitude_lo,
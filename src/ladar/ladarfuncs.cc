@@ -1,7 +1,7 @@
 // ==========================================================================
 // LADARFUNCS stand-alone methods
 // ==========================================================================
-// Last modified on 4/16/07; 12/4/10; 2/5/11; 4/5/14
+// Last modified on 4/16/07; 12/4/10; 2/5/11; 4/5/14; 10/18/26
 // ==========================================================================
 
 #include <map>
@@ -93,14 +93,18 @@ namespace ladarfunc
 // Group 94 code then uses a particular ellipsoid earth model to
 // convert these (lat,long,alt) coordinates to (x,y,z).
 
+   threevector HAFB_offset()
+      {
+         return threevector(359122.405813,4702838.576077,50);	 // meters
+      }
+
    void shift_HAFB_to_Greenwich_origin(vector<threevector>& XYZ)
       {
-         const threevector HAFB_offset(
-            359122.405813,4702838.576077,50);	 // meters
+         const threevector offset(HAFB_offset());
          
          for (unsigned int n=0; n<XYZ.size(); n++)
          {
-            XYZ[n] += HAFB_offset;
+            XYZ[n] += offset;
          }
       }
 
@@ -1,7 +1,7 @@
 // =========================================================================
 // Header file for stand-alone ALIRT data manipulation functions.
 // =========================================================================
-// Last modified on 4/16/07; 10/26/07; 2/5/11
+// Last modified on 4/16/07; 10/26/07; 2/5/11; 10/18/26
 // =========================================================================
 
 #ifndef LADARFUNCS_H
@@ -34,6 +34,7 @@ namespace ladarfunc
 
    std::string public_flight_path_filename(
       std::string& public_xyz_filenamestr);
+   threevector HAFB_offset();
    void shift_HAFB_to_Greenwich_origin(std::vector<threevector>& XYZ);
    void rotate_xy_coords(
       double theta,const threevector& origin,std::vector<threevector>& XYZ);
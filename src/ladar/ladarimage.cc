@@ -5,7 +5,7 @@
 // ==========================================================================
 // LADARIMAGE base class member function definitions
 // ==========================================================================
-// Last modified on 8/3/06; 3/17/09; 5/20/09; 12/4/10; 4/5/14
+// Last modified on 8/3/06; 3/17/09; 5/20/09; 12/4/10; 4/5/14; 10/18/26
 // ==========================================================================
 
 #include "math/basic_math.h"
@@ -14,6 +14,7 @@
 #include "image/connectfuncs.h"
 #include "math/constants.h"
 #include "datastructures/datapoint.h"
+#include "math/fourvector.h"
 #include "image/drawfuncs.h"
 #include "threeDgraphics/draw3Dfuncs.h"
 #include "general/filefuncs.h"
@@ -395,6 +396,19 @@ void ladarimage::parse_and_store_input_data(
    bool renormalize_just_xy_values,bool renormalize_xyz_data,
    bool remove_snowflakes,bool rotate_xy_values,double theta)
 {
+
+// Only snowflake removal and xy rotation require every point to be
+// resident.  Otherwise bin the memory mapped file chunk by chunk.
+// Note that ladarfunc::compute_xyzp_distributions() is currently a
+// no-op, so nothing is lost by skipping it:
+
+   if (!remove_snowflakes && !rotate_xy_values)
+   {
+      stream_and_store_input_data(
+         deltax,deltay,renormalize_just_xy_values,renormalize_xyz_data);
+      return;
+   }
+
    set_npoints(xyzpfunc::npoints_inside_xyzp_file(
                   xyz_datadir+xyz_filenamestr));
    vector<threevector> XYZ;
@@ -459,6 +473,62 @@ void ladarimage::parse_and_store_input_data(
    p2Darray_ptr=new twoDarray(*p2Darray_orig_ptr);
 }
 
+// ---------------------------------------------------------------------
+// Member function stream_and_store_input_data is a low-memory
+// alternative to parse_and_store_input_data which it services when
+// neither snowflake removal nor xy rotation is requested.  It memory
+// maps the input xyzp file and bins its records chunk by chunk
+// directly into the z and p twoDarrays.  No intermediate XYZ and P
+// vectors are formed, so multi-GB ladar tiles never become fully
+// resident.  Renormalization flags carry the same meanings as in
+// parse_and_store_input_data.  Rather than shifting every point, the
+// HAFB and origin translations are folded into a single offset which
+// is added to each record as it is binned.
+
+void ladarimage::stream_and_store_input_data(
+   double deltax,double deltay,
+   bool renormalize_just_xy_values,bool renormalize_xyz_data)
+{
+   xyzp_mmap_file xyzp_file(xyz_datadir+xyz_filenamestr);
+   if (!xyzp_file.get_opened_flag()) exit(-1);
+   set_npoints(xyzp_file.get_n_records());
+
+   compute_xyzp_origin_and_extents(xyzp_file);
+
+   threevector offset(0,0,0);
+   if (renormalize_xyz_data)
+   {
+      offset=ladarfunc::HAFB_offset();
+      image_origin += offset;
+   }
+
+   if (renormalize_just_xy_values)
+   {
+      offset -= threevector(image_origin.get(0),image_origin.get(1));
+   }
+   else if (renormalize_xyz_data)
+   {
+      offset -= image_origin;
+   }
+
+   initialize_image_parameters(
+      z2Darray_orig_ptr,p2Darray_orig_ptr,deltax,deltay,0,0);
+
+   z2Darray_orig_ptr->initialize_values(xyzpfunc::null_value);
+   p2Darray_orig_ptr->initialize_values(xyzpfunc::null_value);
+   for (xyzp_chunk_iterator iter=xyzp_file.get_xyzp_chunk_iterator();
+        !iter.done(); iter.next())
+   {
+      xyzpfunc::fill_image_with_z_and_p_values(
+         iter.current(),offset,z2Darray_orig_ptr,p2Darray_orig_ptr,false);
+   }
+
+   delete z2Darray_ptr;
+   delete p2Darray_ptr;
+   z2Darray_ptr=new twoDarray(*z2Darray_orig_ptr);
+   p2Darray_ptr=new twoDarray(*p2Darray_orig_ptr);
+}
+
 // ---------------------------------------------------------------------
 void ladarimage::store_input_data(
    double xmin,double ymin,double xmax,double ymax,
@@ -539,6 +609,50 @@ void ladarimage::compute_xyzp_origin_and_extents(
    outputfunc::newline();
 }
 
+// ---------------------------------------------------------------------
+// This overloaded version of compute_xyzp_origin_and_extents streams
+// through a memory mapped xyzp file one chunk at a time.
+
+void ladarimage::compute_xyzp_origin_and_extents(
+   const xyzp_mmap_file& xyzp_file)
+{
+   fourvector min_value(POSITIVEINFINITY,POSITIVEINFINITY,
+                        POSITIVEINFINITY,POSITIVEINFINITY);
+   fourvector max_value(NEGATIVEINFINITY,NEGATIVEINFINITY,
+                        NEGATIVEINFINITY,NEGATIVEINFINITY);
+   fourvector chunk_min,chunk_max;
+   for (xyzp_chunk_iterator iter=xyzp_file.get_xyzp_chunk_iterator();
+        !iter.done(); iter.next())
+   {
+      xyzpfunc::compute_xyzp_extrema(iter.current(),chunk_min,chunk_max);
+      for (unsigned int i=0; i<4; i++)
+      {
+         min_value.put(i,basic_math::min(min_value.get(i),chunk_min.get(i)));
+         max_value.put(i,basic_math::max(max_value.get(i),chunk_max.get(i)));
+      }
+   }
+
+   image_origin=threevector(
+      min_value.get(0),min_value.get(1),min_value.get(2));
+   pmin=min_value.get(3);
+   pmax=max_value.get(3);
+
+   xextent=max_value.get(0)-min_value.get(0);
+   yextent=max_value.get(1)-min_value.get(1);
+   zextent=max_value.get(2)-min_value.get(2);
+   pextent=pmax-pmin;
+
+   cout.precision(10);
+   cout << "x min = " << min_value.get(0) << " x extent = " << xextent 
+        << " meters" << endl;
+   cout << "y min = " << min_value.get(1) << " y extent = " << yextent 
+        << " meters" << endl;
+   cout << "z min = " << min_value.get(2) << " z extent = " << zextent 
+        << " meters" << endl;
+   cout << "p extent = " << pextent << endl;
+   outputfunc::newline();
+}
+
 // ---------------------------------------------------------------------
 // Member function convert_from_absolute_to_relative_xyz converts
 // ABSOLUTE xyz data (measured relative to some origin which should be
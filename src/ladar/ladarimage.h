@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for LADARIMAGE base class
 // ==========================================================================
-// Last modified on 7/25/06; 8/3/06; 3/17/09; 4/5/14
+// Last modified on 7/25/06; 8/3/06; 3/17/09; 4/5/14; 10/18/26
 // ==========================================================================
 
 #ifndef LADARIMAGE_H
@@ -12,6 +12,7 @@
 #include "image/myimage.h"
 #include "math/mypolynomial.h"
 #include "math/threevector.h"
+#include "threeDgraphics/xyzp_mmap_file.h"
 
 class parallelogram;
 template <class T> class Hashtable;
@@ -90,8 +91,12 @@ class ladarimage:public myimage
       double xmin,double ymin,double xmax,double ymax,
       double deltax,double deltay,
       osg::Vec3Array* vertices_ptr,const osg::FloatArray* probs_ptr=NULL);
+   void stream_and_store_input_data(
+      double deltax,double deltay,
+      bool renormalize_just_xy_values=false,bool renormalize_xyz_data=true);
    void compute_xyzp_origin_and_extents(
       const std::vector<threevector>& XYZ,const std::vector<double>& p);
+   void compute_xyzp_origin_and_extents(const xyzp_mmap_file& xyzp_file);
    void convert_from_absolute_to_relative_xyz(
       const threevector& absolute_origin,std::vector<threevector>& XYZ);
 
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for stand-alone machinelearning methods
 // ==========================================================================
-// Last updated on 12/13/16; 12/14/16; 1/17/17; 1/24/17
+// Last updated on 12/13/16; 12/14/16; 1/17/17; 1/24/17; 10/18/26
 // ==========================================================================
 
 #ifndef MACHINELEARNING_H
@@ -289,6 +289,22 @@ namespace machinelearning_func
       }
    }
 
+// This overloaded version of leaky_ReLU() acts elementwise upon
+// every entry within minibatch matrix Z:
+
+   void leaky_ReLU(const genmatrix& Z, genmatrix& A)
+   {
+      const double small_slope = get_leaky_ReLU_small_slope();      
+      const double* Z_e_ptr = Z.get_e_ptr();
+      double* A_e_ptr = A.get_e_ptr();
+      unsigned int n_entries = Z.get_mdim() * Z.get_ndim();
+      for(unsigned int i = 0; i < n_entries; i++)
+      {
+         double Zi = Z_e_ptr[i];
+         A_e_ptr[i] = (Zi > 0) ? Zi : small_slope * Zi;
+      }
+   }
+
 // --------------------------------------------------------------------------
    void softmax(const genvector& Z, genvector& A)
    {
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Stand-alone machinelearning methods
 // ==========================================================================
-// Last updated on 12/13/16; 12/14/16; 1/17/17; 1/24/17
+// Last updated on 12/13/16; 12/14/16; 1/17/17; 1/24/17; 10/18/26
 // ==========================================================================
 
 #include <vector>
@@ -44,6 +44,7 @@ namespace machinelearning_func
    double get_leaky_ReLU_small_slope();
    void leaky_ReLU(genvector& X);
    void leaky_ReLU(const genvector& Z, genvector& A);
+   void leaky_ReLU(const genmatrix& Z, genmatrix& A);
 
    void softmax(const genvector& Z, genvector& A);
    void softmax(const genmatrix& Z, genmatrix& A);
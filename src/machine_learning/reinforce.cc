@@ -1,7 +1,7 @@
 // ==========================================================================
 // reinforce class member function definitions
 // ==========================================================================
-// Last modified on 1/17/17; 1/18/17; 1/23/17; 1/24/17
+// Last modified on 1/17/17; 1/18/17; 1/23/17; 1/24/17; 10/18/26
 // ==========================================================================
 
 #include <string>
@@ -561,6 +561,40 @@ reinforce::~reinforce()
    delete curr_pi_sample;
    delete next_pi_sample;
    delete prev_afterstate_ptr;
+
+   delete_minibatch_variables();
+}
+
+// ---------------------------------------------------------------------
+// Member function allocate_minibatch_variables() (re)instantiates
+// the matrices used to propagate n_samples replay memory samples
+// through the network all at once.  Nothing is reallocated if the
+// minibatch size has not changed since the previous call.
+
+void reinforce::allocate_minibatch_variables(int n_samples)
+{
+   if(A_batch.size() > 0 && int(A_batch[0]->get_mdim()) == n_samples) return;
+
+   delete_minibatch_variables();
+   for(int l = 0; l < n_layers; l++)
+   {
+      Z_batch.push_back(new genmatrix(n_samples, layer_dims[l]));
+      A_batch.push_back(new genmatrix(n_samples, layer_dims[l]));
+      Delta_batch.push_back(new genmatrix(n_samples, layer_dims[l]));
+   }
+}
+
+void reinforce::delete_minibatch_variables()
+{
+   for(unsigned int l = 0; l < A_batch.size(); l++)
+   {
+      delete Z_batch[l];
+      delete A_batch[l];
+      delete Delta_batch[l];
+   }
+   Z_batch.clear();
+   A_batch.clear();
+   Delta_batch.clear();
 }
 
 // ---------------------------------------------------------------------
@@ -2371,6 +2405,57 @@ void reinforce::Q_forward_propagate(
    }
 }
 
+// ---------------------------------------------------------------------
+// Member function Q_forward_propagate_minibatch() performs a
+// feedforward pass for every state stored within the rows of
+// *A_batch[0].  Each layer's weighted inputs for the entire minibatch
+// are computed via a single matrix-matrix product rather than Nd
+// separate matrix-vector products.
+
+void reinforce::Q_forward_propagate_minibatch(bool use_old_weights_flag)
+{
+   int n_samples = A_batch[0]->get_mdim();
+
+   for(int l = 0; l < n_layers-1; l++)
+   {
+      genmatrix* curr_weights = weights[l];
+      genvector* curr_biases = (include_biases ? biases[l+1] : NULL);
+      if(use_old_weights_flag)
+      {
+         curr_weights = old_weights[l];
+         if(include_biases) curr_biases = old_biases[l+1];
+      }
+
+// Z = A * W^T since each row of A holds one sample's activations:
+
+      Z_batch[l+1]->matrix_mult_transpose(*A_batch[l], *curr_weights);
+
+      if(include_biases)
+      {
+         int n_nodes = layer_dims[l+1];
+         const double* b_e_ptr = curr_biases->get_e_ptr();
+         double* Z_e_ptr = Z_batch[l+1]->get_e_ptr();
+         for(int r = 0; r < n_samples; r++)
+         {
+            double* Z_row_ptr = Z_e_ptr + r * n_nodes;
+            for(int j = 0; j < n_nodes; j++)
+            {
+               Z_row_ptr[j] += b_e_ptr[j];
+            }
+         }
+      }
+
+      if(l == n_layers - 2)
+      {
+         *A_batch[l+1] = *Z_batch[l+1];
+      }
+      else
+      {
+         machinelearning_func::leaky_ReLU(*Z_batch[l+1], *A_batch[l+1]);
+      }
+   } // loop over index l labeling network layers
+}
+
 // ---------------------------------------------------------------------
 // Member function compute_argmax_Q() returns a = argmax_a' Q(s,a').
 
@@ -2689,13 +2774,12 @@ double reinforce::update_Q_network(bool verbose_flag)
 
    vector<int> d_samples = mathfunc::random_sequence(
       replay_memory_capacity, Nd);
-   double total_loss = 0;
-   for(unsigned int j = 0; j < d_samples.size(); j++)
-   {
-      int curr_d = d_samples[j];
-      double curr_loss = Q_backward_propagate(curr_d, Nd, verbose_flag);
-      if(curr_loss >= 0) total_loss += curr_loss;
-   } // loop over index j labeling replay memory samples
+
+// As of Oct 2026, the entire replay minibatch is forward and
+// backward propagated at once.  Q_backward_propagate() remains
+// available for propagating individual samples:
+
+   double total_loss = Q_backward_propagate_minibatch(d_samples, verbose_flag);
 //   cout << "total_loss = " << total_loss << endl;
 
    if(solver_type == RMSPROP)
@@ -2866,6 +2950,173 @@ double reinforce::update_Q_network(bool verbose_flag)
    return total_loss;
 }
 
+// ---------------------------------------------------------------------
+// Member function Q_backward_propagate_minibatch() is the minibatch
+// counterpart to Q_backward_propagate().  Rather than looping over
+// the input replay memory samples one at a time, it stacks their
+// states into the rows of a single matrix.  Targets, forward passes
+// and backpropagated errors are then computed with one matrix-matrix
+// product per layer.  Gradients averaged over all samples are
+// accumulated into nabla_biases and nabla_weights.  This method
+// returns the same loss as summing Q_backward_propagate() over all
+// samples:  each sample's squared error is weighted by 1/Nd, and the
+// L2 regularization term enters once for a full minibatch of Nd
+// samples.
+
+double reinforce::Q_backward_propagate_minibatch(
+   const vector<int>& d_samples, bool verbose_flag)
+{
+   int n_samples = d_samples.size();
+   if(n_samples == 0) return 0;
+   allocate_minibatch_variables(n_samples);
+   double inverse_Nd = 1.0 / Nd;
+   int Din = layer_dims.front();
+   int output_layer = n_layers - 1;
+   int Dout = layer_dims[output_layer];
+
+// Calculate targets for all transition samples by forward
+// propagating their next states through the old network:
+
+   double* S_e_ptr = A_batch[0]->get_e_ptr();
+   for(int r = 0; r < n_samples; r++)
+   {
+      const double* next_s_ptr = s_next->get_e_ptr() + d_samples[r] * Din;
+      for(int i = 0; i < Din; i++)
+      {
+         S_e_ptr[r * Din + i] = next_s_ptr[i];
+      }
+   }
+   bool use_old_weights_flag = true;
+   Q_forward_propagate_minibatch(use_old_weights_flag);
+
+   vector<int> curr_actions(n_samples);
+   vector<double> target_values(n_samples);
+   for(int r = 0; r < n_samples; r++)
+   {
+      int d = d_samples[r];
+      curr_actions[r] = int(a_curr->get(d));
+      double curr_r = r_curr->get(d);
+      bool terminal_state_flag = (terminal_state->get(d) > 0);
+      if(terminal_state_flag)
+      {
+         target_values[r] = curr_r;
+      }
+      else
+      {
+         double Qmax = A_batch[output_layer]->get(r, 0);
+         for(int j = 0; j < Dout; j++)
+         {
+            Qmax = basic_math::max(Qmax, A_batch[output_layer]->get(r, j));
+         }
+         target_values[r] = curr_r + gamma * Qmax;
+      }
+   } // loop over index r labeling minibatch samples
+
+// Forward propagate current states through the current network in
+// order to repopulate linear z inputs and nonlinear a outputs for
+// each node:
+
+   for(int r = 0; r < n_samples; r++)
+   {
+      const double* curr_s_ptr = s_curr->get_e_ptr() + d_samples[r] * Din;
+      for(int i = 0; i < Din; i++)
+      {
+         S_e_ptr[r * Din + i] = curr_s_ptr[i];
+      }
+   }
+   Q_forward_propagate_minibatch();
+
+// Eqn BP1:
+
+   double sqrd_error_loss = 0;
+   int n_valid_samples = 0;
+   Delta_batch[output_layer]->clear_values();
+   for(int r = 0; r < n_samples; r++)
+   {
+      int curr_a = curr_actions[r];
+      if(curr_a < 0 || curr_a >= Dout) continue;
+      double curr_activation = 
+         A_batch[output_layer]->get(r, curr_a) - target_values[r];
+      Delta_batch[output_layer]->put(r, curr_a, curr_activation);
+      sqrd_error_loss += 0.5 * sqr(curr_activation);
+      n_valid_samples++;
+
+      if(verbose_flag)
+      {
+         cout << "inside Q_backward_propagate_minibatch()" << endl;
+         cout << "  curr_r = " << r_curr->get(d_samples[r])
+              << " target_value = " << target_values[r] << endl;
+      }
+   }
+
+   const double TINY = 1E-8;
+   for(int curr_layer = n_layers-1; curr_layer >= 1; curr_layer--)
+   {
+      int prev_layer = curr_layer - 1;
+
+// Eqn BP3:  Sum errors over minibatch samples
+
+      if(include_biases)
+      {
+         int n_nodes = layer_dims[curr_layer];
+         const double* Delta_e_ptr = Delta_batch[curr_layer]->get_e_ptr();
+         for(int r = 0; r < n_samples; r++)
+         {
+            for(int j = 0; j < n_nodes; j++)
+            {
+               nabla_biases[curr_layer]->put(
+                  j, nabla_biases[curr_layer]->get(j) + 
+                  inverse_Nd * Delta_e_ptr[r * n_nodes + j]);
+            }
+         }
+      }
+
+// Eqn BP4:  Sum of outer products over samples = Delta^T * A
+
+      delta_nabla_weights[prev_layer]->matrix_transpose_mult(
+         *Delta_batch[curr_layer], *A_batch[prev_layer]);
+      nabla_weights[prev_layer]->matrix_increment(
+         inverse_Nd, *delta_nabla_weights[prev_layer]);
+
+// Add L2 regularization contribution once per sample:
+
+      if(lambda > TINY)
+      {
+         nabla_weights[prev_layer]->matrix_increment(
+            n_samples * inverse_Nd * 2 * lambda / n_weights, 
+            *weights[prev_layer]);
+      }
+
+      if(prev_layer == 0) break;
+
+// Eqn BP2A:  Delta_prev = Delta_curr * W since rows hold samples
+
+      Delta_batch[prev_layer]->matrix_mult(
+         *Delta_batch[curr_layer], *weights[prev_layer]);
+
+// Eqn BP2B (Leaky ReLU):
+
+      const double small_slope = 
+         machinelearning_func::get_leaky_ReLU_small_slope();
+      const double* Z_e_ptr = Z_batch[prev_layer]->get_e_ptr();
+      double* Delta_e_ptr = Delta_batch[prev_layer]->get_e_ptr();
+      int n_entries = n_samples * layer_dims[prev_layer];
+      for(int i = 0; i < n_entries; i++)
+      {
+         if(Z_e_ptr[i] < 0) Delta_e_ptr[i] *= small_slope;
+      }
+   } // loop over curr_layer index
+
+   n_backprops += n_samples;
+
+// Q_backward_propagate() adds L2_loss_contribution() to each sample's
+// loss before weighting it by 1/Nd:
+
+   double total_loss = inverse_Nd * sqrd_error_loss +
+      n_valid_samples * inverse_Nd * L2_loss_contribution();
+   return total_loss;
+}
+
 // ---------------------------------------------------------------------
 // Member function L2_loss_contribution() adds the L2 regularization
 // term's contribution to the loss function.
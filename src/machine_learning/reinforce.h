@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for reinforce class 
 // ==========================================================================
-// Last modified on 1/13/17; 1/18/17; 1/23/17; 1/24/17
+// Last modified on 1/13/17; 1/18/17; 1/23/17; 1/24/17; 10/18/26
 // ==========================================================================
 
 #ifndef REINFORCE_H
@@ -194,6 +194,9 @@ class reinforce
    double L2_loss_contribution();
    double compute_curr_Q_loss(int curr_a, double target_value);
    double Q_backward_propagate(int d, int Nd, bool verbose_flag = false);
+   void Q_forward_propagate_minibatch(bool use_old_weights_flag = false);
+   double Q_backward_propagate_minibatch(
+      const std::vector<int>& d_samples, bool verbose_flag = false);
    void numerically_check_Q_derivs(int curr_a, double target_value);
 
    void set_Q_value(std::string state_action_str, double Qvalue);
@@ -300,6 +303,11 @@ class reinforce
 // Node errors:
 
    std::vector<genvector*> Delta_Prime; // n_actions x 1 
+
+// Minibatch node weighted inputs, activation outputs and errors.  Row
+// r within each matrix holds values for the rth replay memory sample:
+
+   std::vector<genmatrix*> Z_batch, A_batch, Delta_batch; // Nd x n_nodes
    
 // Episode datastructures:
 
@@ -400,6 +408,8 @@ class reinforce
    void instantiate_training_variables();
    void initialize_weights_and_biases();
    void delete_weights_and_biases();
+   void allocate_minibatch_variables(int n_samples);
+   void delete_minibatch_variables();
 };
 
 // ==========================================================================
@@ -16,7 +16,7 @@
 //	clean_L1 ./tdp_files/02142010_081452_1064nm_161747-165163.xform.tdp 
 
 // ==========================================================================
-// Last updated on 11/29/11; 12/4/11; 12/8/11
+// Last updated on 11/29/11; 12/4/11; 12/8/11; 10/18/26
 // ==========================================================================
 
 #include <algorithm>
@@ -1018,13 +1018,7 @@ int main(int argc, char *argv[])
    banner="Accumulating pure noise points within *noise_vcp_ptr";
    outputfunc::write_big_banner(banner);
 
-   for (int i=0; i<n_noise_points; i++)
-   {
-      outputfunc::update_progress_fraction(i,1000000,n_noise_points);
-      noise_vcp_ptr->accumulate_points(
-         X_noise_ptr->at(i),Y_noise_ptr->at(i),Z_noise_ptr->at(i));
-   }
-   cout << endl;
+   noise_vcp_ptr->accumulate_points(*X_noise_ptr,*Y_noise_ptr,*Z_noise_ptr);
    cout << "After accumulating points, noise_vcp_ptr->size() = "
         << noise_vcp_ptr->size() << endl;
    
@@ -1148,15 +1142,8 @@ int main(int argc, char *argv[])
    cout << "n_refined_cropped_points = " << n_refined_cropped_points
         << endl;
 
-   for (int i=0; i<n_refined_cropped_points; i++)
-   {
-      outputfunc::update_progress_fraction(i,1000000,n_refined_cropped_points);
-      vcp_ptr->accumulate_points(
-         X_refined_cropped_ptr->at(i),
-         Y_refined_cropped_ptr->at(i),
-         Z_refined_cropped_ptr->at(i));
-   }
-   cout << endl;
+   vcp_ptr->accumulate_points(
+      *X_refined_cropped_ptr,*Y_refined_cropped_ptr,*Z_refined_cropped_ptr);
    cout << "After accumulating points, vcp_ptr->size() = "
         << vcp_ptr->size() << endl;
    cout << "Z_refined_cropped_ptr->size() = "
@@ -10,7 +10,7 @@
 //				flip_cloud			
 
 // ==========================================================================
-// Last updated on 12/12/11
+// Last updated on 12/12/11; 10/18/26
 // ==========================================================================
 
 #include <algorithm>
@@ -153,13 +153,7 @@ int main(int argc, char *argv[])
    VolumetricCoincidenceProcessor* vcp_ptr=new VolumetricCoincidenceProcessor;
    vcp_ptr->initialize_coord_system(XYZ_min,XYZ_max,voxel_binsize);
 
-   for (unsigned int i=0; i<Xcropped_ptr->size(); i++)
-   {
-      double curr_x=Xcropped_ptr->at(i);
-      double curr_y=Ycropped_ptr->at(i);
-      double curr_z=Zflipped_ptr->at(i);
-      vcp_ptr->accumulate_points(curr_x,curr_y,curr_z);
-   }
+   vcp_ptr->accumulate_points(*Xcropped_ptr,*Ycropped_ptr,*Zflipped_ptr);
    cout << "Aggregated number of points = " << vcp_ptr->size() << endl;
 
    delete Zflipped_ptr;
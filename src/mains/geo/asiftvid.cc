@@ -21,7 +21,7 @@
 */
 
 // =======================================================================
-// Last updated on 7/10/13; 7/11/13; 7/23/13; 8/25/13
+// Last updated on 7/10/13; 7/11/13; 7/23/13; 8/25/13; 10/18/26
 // =======================================================================
 
 #include <iostream>
@@ -258,40 +258,38 @@ int main( int argc, char** argv )
 
 // Match SIFT & ASIFT features across image pairs:
 
-   for (int i=0; i<n_images; i++)
+   if (serial_matching_flag)
    {
-      int j_start=i+1;
-      int j_stop=n_images;
-
-      if (serial_matching_flag)
+      for (int i=0; i<n_images; i++)
       {
+         int j_start=i+1;
+         int j_stop=n_images;
          SIFT.match_image_pair_features(
             i,j_start,j_stop,
             sqrd_max_ratio,worst_frac_to_reject,max_scalar_product,
             max_n_good_RANSAC_iters,min_n_features,minimal_number_of_inliers,
             bundler_IO_subdir,map_unionfind_ptr,ntiepoints_stream);
-      }
-      else
-      {
+      } // loop over index i labeling input images
+   }
+   else
+   {
 
 // As of 7/6/13, FLANN index construction is NOT thread-safe.
 // So FLANN will generally return *different* candidate image tiepoint
 // pairs each time we run program ASIFTVID in parallel threading mode...
 
-         bool export_fundamental_matrices_flag=true;
-         SIFT.set_num_threads(6);
-         SIFT.parallel_match_image_pair_features(
-            export_fundamental_matrices_flag,
-            i,j_start,j_stop,
-            sqrd_max_ratio,worst_frac_to_reject,max_scalar_product,
-            max_n_good_RANSAC_iters,min_n_features,minimal_number_of_inliers,
-            bundler_IO_subdir,map_unionfind_ptr,ntiepoints_stream);
-      }
-
-   } // loop over index i labeling input images
-
-   if (!serial_matching_flag)
-      SIFT.reorder_parallelized_tiepoints_file(bundler_IO_subdir);
+// As of 10/18/26, all image pairs are streamed into a single
+// work-stealing pool sized from the hardware.  Tiepoints are exported
+// in serial (i,j) order, so the ntiepoints file no longer needs to be
+// reordered:
+
+      bool export_fundamental_matrices_flag=true;
+      SIFT.scheduled_match_image_pair_features(
+         export_fundamental_matrices_flag,0,n_images,
+         sqrd_max_ratio,worst_frac_to_reject,max_scalar_product,
+         max_n_good_RANSAC_iters,min_n_features,minimal_number_of_inliers,
+         bundler_IO_subdir,map_unionfind_ptr,ntiepoints_stream);
+   }
 
    SIFT.rename_feature_IDs(map_unionfind_ptr);
 
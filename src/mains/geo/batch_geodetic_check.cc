@@ -0,0 +1,230 @@
+// ========================================================================
+// Program BATCH_GEODETIC_CHECK validates latlongfunc's batched
+// coordinate transforms against their scalar counterparts on
+// n_points random geodetic positions.  It compares
+
+//   1.  batch_LLtoUTM() with LLtoUTM(), including zone numbers and
+//       hemisphere flags,
+//   2.  batch_LL_to_northing_easting() with LL_to_northing_easting()
+//       for a specified zone within both hemispheres,
+//   3.  batch_UTMtoLL() with UTMtoLL(),
+
+// and checks that LL -> ECEF -> LL and ECEF -> ENU -> ECEF round
+// trips return their inputs.  Batch and scalar timings are reported.
+
+//			batch_geodetic_check
+//			batch_geodetic_check 2000000
+
+// ========================================================================
+// Last updated on 10/18/26
+// ========================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "astro_geo/latlong2utmfuncs.h"
+#include "math/basic_math.h"
+#include "numrec/nrfuncs.h"
+#include "general/stringfuncs.h"
+#include "time/timefuncs.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+// ==========================================================================
+int main(int argc, char *argv[])
+// ==========================================================================
+{
+   int n_points=2000000;
+   if (argc > 1) n_points=stringfunc::string_to_number(argv[1]);
+   nrfunc::init_default_seed(-1);
+
+// Longitudes deliberately extend beyond [-180,180] so that
+// normalization is exercised.  The first few points lie within the
+// Norway and Svalbard zone exceptions and along the antimeridian:
+
+   vector<double> latitude(n_points),longitude(n_points),altitude(n_points);
+   for (int i=0; i<n_points; i++)
+   {
+      latitude[i]=-80+160*nrfunc::ran1();
+      longitude[i]=-200+400*nrfunc::ran1();
+      altitude[i]=-500+20000*nrfunc::ran1();
+   }
+   latitude[0]=60;
+   longitude[0]=5;
+   latitude[1]=75;
+   longitude[1]=30;
+   latitude[2]=0;
+   longitude[2]=180;
+   latitude[3]=0;
+   longitude[3]=-180;
+
+   const double max_UTM_difference=1E-6;		// meters
+   const double max_LL_difference=1E-10;		// degrees
+   const double max_roundtrip_difference=1E-6;		// meters
+   int n_failures=0;
+
+// LLtoUTM:
+
+   vector<int> zone_number(n_points);
+   bool* northern_hemisphere_flag=new bool[n_points];
+   vector<double> northing(n_points),easting(n_points);
+
+   timefunc::initialize_timeofday_clock();
+   latlongfunc::batch_LLtoUTM(
+      &latitude[0],&longitude[0],n_points,&zone_number[0],
+      northern_hemisphere_flag,&northing[0],&easting[0]);
+   double batch_secs=timefunc::elapsed_timeofday_time();
+
+   timefunc::initialize_timeofday_clock();
+   int n_zone_mismatches=0;
+   double max_difference=0;
+   for (int i=0; i<n_points; i++)
+   {
+      int curr_zone;
+      bool curr_northern_flag;
+      double curr_northing,curr_easting;
+      latlongfunc::LLtoUTM(
+         latitude[i],longitude[i],curr_zone,curr_northern_flag,
+         curr_northing,curr_easting);
+      if (curr_zone != zone_number[i] ||
+          curr_northern_flag != northern_hemisphere_flag[i])
+         n_zone_mismatches++;
+      max_difference=basic_math::max(
+         max_difference,fabs(curr_northing-northing[i]));
+      max_difference=basic_math::max(
+         max_difference,fabs(curr_easting-easting[i]));
+   }
+   double scalar_secs=timefunc::elapsed_timeofday_time();
+   delete [] northern_hemisphere_flag;
+
+   cout << "LLtoUTM: n_zone_mismatches = " << n_zone_mismatches
+        << " max difference = " << max_difference << " m" << endl;
+   cout << "   batch secs = " << batch_secs
+        << " scalar secs = " << scalar_secs << endl;
+   if (n_zone_mismatches > 0 || max_difference > max_UTM_difference)
+      n_failures++;
+
+// LL_to_northing_easting within specified zone 18.  Only points
+// within 30 degrees of the zone's central meridian are compared:
+
+   const int specified_zone=18;
+   const double central_longitude=-75;
+   for (int h=0; h<2; h++)
+   {
+      bool specified_northern_flag=(h==0);
+      latlongfunc::batch_LL_to_northing_easting(
+         &longitude[0],&latitude[0],n_points,specified_northern_flag,
+         specified_zone,&easting[0],&northing[0]);
+
+      max_difference=0;
+      for (int i=0; i<n_points; i++)
+      {
+         if (fabs(longitude[i]-central_longitude) > 30) continue;
+         double curr_easting,curr_northing;
+         latlongfunc::LL_to_northing_easting(
+            longitude[i],latitude[i],specified_northern_flag,
+            specified_zone,curr_easting,curr_northing);
+         max_difference=basic_math::max(
+            max_difference,fabs(curr_northing-northing[i]));
+         max_difference=basic_math::max(
+            max_difference,fabs(curr_easting-easting[i]));
+      }
+      cout << "LL_to_northing_easting: northern_flag = "
+           << specified_northern_flag
+           << " max difference = " << max_difference << " m" << endl;
+      if (max_difference > max_UTM_difference) n_failures++;
+   }
+
+// UTMtoLL.  Southern hemisphere eastings and northings within zone 18
+// from the last pass above are inverted.  Only points within 9
+// degrees of the central meridian are compared:
+
+   vector<double> batch_latitude(n_points),batch_longitude(n_points);
+   timefunc::initialize_timeofday_clock();
+   latlongfunc::batch_UTMtoLL(
+      specified_zone,false,&northing[0],&easting[0],n_points,
+      &batch_latitude[0],&batch_longitude[0]);
+   batch_secs=timefunc::elapsed_timeofday_time();
+
+   timefunc::initialize_timeofday_clock();
+   max_difference=0;
+   for (int i=0; i<n_points; i++)
+   {
+      double curr_latitude,curr_longitude;
+      latlongfunc::UTMtoLL(
+         specified_zone,false,northing[i],easting[i],
+         curr_latitude,curr_longitude);
+      if (fabs(longitude[i]-central_longitude) > 9 || latitude[i] > 0)
+         continue;
+      max_difference=basic_math::max(
+         max_difference,fabs(curr_latitude-batch_latitude[i]));
+      max_difference=basic_math::max(
+         max_difference,fabs(curr_longitude-batch_longitude[i]));
+   }
+   scalar_secs=timefunc::elapsed_timeofday_time();
+
+   cout << "UTMtoLL: max difference = " << max_difference << " degs"
+        << endl;
+   cout << "   batch secs = " << batch_secs
+        << " scalar secs = " << scalar_secs << endl;
+   if (max_difference > max_LL_difference) n_failures++;
+
+// LL -> ECEF -> LL round trip:
+
+   vector<double> X(n_points),Y(n_points),Z(n_points);
+   vector<double> batch_altitude(n_points);
+   latlongfunc::batch_LL_to_ECEF(
+      &latitude[0],&longitude[0],&altitude[0],n_points,&X[0],&Y[0],&Z[0]);
+   latlongfunc::batch_ECEF_to_LL(
+      &X[0],&Y[0],&Z[0],n_points,
+      &batch_latitude[0],&batch_longitude[0],&batch_altitude[0]);
+
+   double max_dlat=0,max_dlong=0,max_dalt=0;
+   for (int i=0; i<n_points; i++)
+   {
+      double dlong=fmod(batch_longitude[i]-longitude[i]+540.0,360.0)-180;
+      max_dlat=basic_math::max(
+         max_dlat,fabs(batch_latitude[i]-latitude[i]));
+      max_dlong=basic_math::max(max_dlong,fabs(dlong));
+      max_dalt=basic_math::max(
+         max_dalt,fabs(batch_altitude[i]-altitude[i]));
+   }
+   cout << "ECEF round trip: max dlat = " << max_dlat
+        << " max dlong = " << max_dlong
+        << " max dalt = " << max_dalt << endl;
+   if (max_dlat > max_LL_difference || max_dlong > max_LL_difference ||
+       max_dalt > max_roundtrip_difference) n_failures++;
+
+// ECEF -> ENU -> ECEF round trip about a Boston origin:
+
+   vector<double> East(n_points),North(n_points),Up(n_points);
+   vector<double> X2(n_points),Y2(n_points),Z2(n_points);
+   latlongfunc::batch_ECEF_to_ENU(
+      42.3,-71.1,10,&X[0],&Y[0],&Z[0],n_points,
+      &East[0],&North[0],&Up[0]);
+   latlongfunc::batch_ENU_to_ECEF(
+      42.3,-71.1,10,&East[0],&North[0],&Up[0],n_points,
+      &X2[0],&Y2[0],&Z2[0]);
+
+   max_difference=0;
+   for (int i=0; i<n_points; i++)
+   {
+      max_difference=basic_math::max(max_difference,fabs(X2[i]-X[i]));
+      max_difference=basic_math::max(max_difference,fabs(Y2[i]-Y[i]));
+      max_difference=basic_math::max(max_difference,fabs(Z2[i]-Z[i]));
+   }
+   cout << "ENU round trip: max difference = " << max_difference << " m"
+        << endl;
+   if (max_difference > max_roundtrip_difference) n_failures++;
+
+   if (n_failures > 0)
+   {
+      cout << "Error in BATCH_GEODETIC_CHECK!" << endl;
+      cout << "n_failures = " << n_failures << endl;
+      return -1;
+   }
+   cout << "All batched transforms agree with scalar versions" << endl;
+   return 0;
+}
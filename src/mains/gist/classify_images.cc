@@ -12,7 +12,7 @@
 //			     ./classify_images
 
 // ==========================================================================
-// Last updated on 4/7/13; 4/8/13; 4/14/13; 10/2/13
+// Last updated on 4/7/13; 4/8/13; 4/14/13; 10/2/13; 10/18/26
 // ==========================================================================
 
 #include  <iostream>
@@ -24,6 +24,7 @@
 
 #include "general/filefuncs.h"
 #include "video/descriptorfuncs.h"
+#include "video/gist_descriptor.h"
 #include "general/outputfuncs.h"
 #include "video/RGB_analyzer.h"
 #include "general/stringfuncs.h"
@@ -51,6 +52,7 @@ int main(int argc, char* argv[])
    string lookup_map_name=RGB_analyzer_ptr->get_lookup_filename();
    cout << "lookup_map_name = " << lookup_map_name << endl;
    texture_rectangle* texture_rectangle_ptr=new texture_rectangle();
+   gist_descriptor* gist_descriptor_ptr=new gist_descriptor();
 
 
    string mains_gist_subdir=
@@ -153,7 +155,8 @@ int main(int argc, char* argv[])
       if (!filefunc::fileexist(gist_filename)) 
       {
          bool gist_calculated_flag=descriptorfunc::compute_gist_descriptor(
-            image_filenames[i],gist_filename);
+            image_filenames[i],gist_filename,texture_rectangle_ptr,
+            gist_descriptor_ptr);
          if (!gist_calculated_flag) continue;
       }
 
@@ -224,6 +227,7 @@ int main(int argc, char* argv[])
 
    delete RGB_analyzer_ptr;
    delete texture_rectangle_ptr;
+   delete gist_descriptor_ptr;
 
    cout << "n_rejections = " << n_rejections << endl;
    cout << "n_acceptances = " << n_acceptances << endl;
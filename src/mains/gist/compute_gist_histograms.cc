@@ -1,15 +1,15 @@
 // ==========================================================================
 // Program COMPUTE_GIST_HISTOGRAMS imports images from a series of
 // input subdirectories. Each input image is first rescaled and
-// cropped down to 256x256 pixels in size.  The LEAR C program is then
-// called to compute a 3*512 dimensional descriptor for the subsampled
-// image. All GIST descriptor vectors are written to output text
-// files.
+// cropped down to 256x256 pixels in size.  A 3*512 dimensional GIST
+// descriptor is then computed in memory for the subsampled image.
+// All GIST descriptor vectors are written to output text files.
+// Images are processed in parallel by n_threads OpenMP threads.
 
 //			  ./compute_gist_histograms
 
 // ==========================================================================
-// Last updated on 10/21/13; 10/22/13; 10/25/13
+// Last updated on 10/21/13; 10/22/13; 10/25/13; 10/18/26
 // ==========================================================================
 
 #include  <iostream>
@@ -23,8 +23,14 @@
 #include "general/outputfuncs.h"
 #include "general/sysfuncs.h"
 #include "time/timefuncs.h"
+#include "video/gist_descriptor.h"
+#include "video/texture_rectangle.h"
 #include "video/videofuncs.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using std::cin;
 using std::cout;
 using std::endl;
@@ -37,6 +43,20 @@ int main(int argc, char* argv[])
 
    timefunc::initialize_timeofday_clock();
 
+// Non-positive n_threads defaults to all available cores:
+
+   int n_threads=0;
+#ifdef _OPENMP
+   if (n_threads <= 0) n_threads=omp_get_max_threads();
+#else
+   n_threads=1;
+#endif
+   cout << "n_threads = " << n_threads << endl;
+
+// Gabor filter bank is shared by all threads:
+
+   gist_descriptor* gist_descriptor_ptr=new gist_descriptor();
+
    vector<string> input_image_subdirs;
 
 /*
@@ -95,16 +115,11 @@ int main(int argc, char* argv[])
 
       int imagenumber_start=0;
       int imagenumber_stop=n_images-1;
+
+      vector<string> input_filenames,gist_filenames;
       for (int imagenumber=imagenumber_start; imagenumber<=imagenumber_stop; 
            imagenumber++)
       {
-         if (imagenumber%10==0) 
-         {
-            outputfunc::print_elapsed_time();
-            cout << "Processing image " << imagenumber+1 << " of " 
-                 << n_images << endl;
-         }
-
          string input_filename=image_filenames[imagenumber];
          string image_basename=filefunc::getbasename(input_filename);
 
@@ -133,12 +148,47 @@ int main(int argc, char* argv[])
          }
          else
          {
-            descriptorfunc::compute_gist_descriptor(
-               input_filename,gist_filename);
+            input_filenames.push_back(input_filename);
+            gist_filenames.push_back(gist_filename);
          }
 
       } // loop over imagenumber index labeling input images
 
+// Each thread decodes images into its own texture rectangle.  Since
+// gist files have distinct names, no two threads write the same
+// file:
+
+      int n_gist_images=input_filenames.size();
+      int n_processed=0;
+
+#pragma omp parallel num_threads(n_threads)
+      {
+         texture_rectangle* texture_rectangle_ptr=new texture_rectangle();
+
+#pragma omp for schedule(dynamic,1)
+         for (int i=0; i<n_gist_images; i++)
+         {
+            descriptorfunc::compute_gist_descriptor(
+               input_filenames[i],gist_filenames[i],
+               texture_rectangle_ptr,gist_descriptor_ptr);
+
+#pragma omp critical(compute_gist_progress)
+            {
+               n_processed++;
+               if (n_processed%10==0) 
+               {
+                  outputfunc::print_elapsed_time();
+                  cout << "Processed image " << n_processed << " of " 
+                       << n_gist_images << endl;
+               }
+            }
+         } // loop over index i labeling images lacking gist files
+
+         delete texture_rectangle_ptr;
+      } // omp parallel region
+
    } // loop over input_image_subdir_index
+
+   delete gist_descriptor_ptr;
 }
 
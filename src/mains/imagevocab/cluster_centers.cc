@@ -6,11 +6,12 @@
 // multiplication by the inverse square root of their covariance
 // matrix.  CLUSTER_CENTERS next performs multiple rounds of
 // approximate K-means clustering on the SIFT descriptors via the
-// FLANN library. Finally, cell center descriptors for clusters
-// containing some minimal number of SIFT descriptors are exported to
-// a binary file in HDF5 format.
+// FLANN library.  Alternatively, it streams SIFT descriptors from
+// per-image HDF5 files into checkpointed mini-batch K-means.  Finally,
+// cell center descriptors for clusters containing some minimal number
+// of SIFT descriptors are exported to a binary file in HDF5 format.
 // ==========================================================================
-// Last updated on 4/11/12; 4/20/12; 4/30/12
+// Last updated on 4/11/12; 4/20/12; 4/30/12; 10/18/26
 // ==========================================================================
 
 #include <iostream>
@@ -83,6 +84,70 @@ int main(int argc, char *argv[])
       }
    }
 
+// As of Oct 2026, vocabularies containing O(1E6) words can be built
+// via mini-batch K-means.  Rather than importing a subsampled set of
+// raw SIFT descriptors into memory, mini-batches are streamed directly
+// from the per-image HDF5 files within raw_hdf5_subdir.  Cluster
+// centers are periodically checkpointed so that interrupted runs
+// resume where they left off.  Delete the checkpoint file in order to
+// start afresh:
+
+   int minibatch_flag=0;
+   cout << "Enter 1 to stream SIFT descriptors into mini-batch K-means" 
+        << endl;
+   cout << "Enter 0 to cluster sampled descriptors from "
+        << "all_raw_sift_descriptors.binary:" << endl;
+   cin >> minibatch_flag;
+   if (minibatch_flag==1)
+   {
+      vector<string> allowed_suffixes;
+      allowed_suffixes.push_back("hdf5");
+      allowed_suffixes.push_back("gz");
+      allowed_suffixes.push_back("lzo");
+      vector<string> hdf5_filenames=
+         filefunc::files_in_subdir_matching_specified_suffixes(
+            allowed_suffixes,raw_hdf5_subdir);
+      cout << "Number of per-image SIFT HDF5 files = "
+           << hdf5_filenames.size() << endl;
+
+      int K=1000000;
+      unsigned int batch_size=500000;
+      unsigned int n_batches=2000;
+      unsigned int checkpoint_interval=25;
+      cout << "Desired number clusters K = " << K << endl;
+      cout << "Mini-batch size = " << batch_size << endl;
+      cout << "Number of mini-batches = " << n_batches << endl;
+
+      timefunc::initialize_timeofday_clock();
+
+      bool FLANN_flag=true;
+      akm* akm_ptr=new akm(FLANN_flag);
+      akm_ptr->reset_minibatch_params(D,K);
+      akm_ptr->set_checkpoint_filename(
+         sift_keys_subdir+"whitened_cluster_centers_checkpoint.hdf5");
+      akm_ptr->minibatch_refine_FLANN_clusters(
+         hdf5_filenames,batch_size,n_batches,&inverse_covar_sqrt,
+         checkpoint_interval);
+
+      int min_features_per_cluster=5;
+      string output_file_prefix="whitened_";
+      int n_exported_clusters=akm_ptr->export_cluster_centers(
+         min_features_per_cluster,output_file_prefix,sift_keys_subdir);
+
+      double cluster_elapsed_mins=timefunc::elapsed_timeofday_time()/60.0;
+      cout << "Actual number of exported (large) clusters = "
+           << n_exported_clusters << endl;
+      cout << "Number features per cluster = "
+           << akm_ptr->get_mu_n_features_per_cluster() << " +/- " 
+           << akm_ptr->get_sigma_n_features_per_cluster() << endl;
+      cout << "Number of minutes needed to form " << n_exported_clusters 
+           << " cells  = " << cluster_elapsed_mins << endl;
+
+      delete akm_ptr;
+      delete [] inverse_covar_sqrt.ptr();
+      return 0;
+   }
+
 // Import subsampled set of SIFT descriptors into unsigned char* array 
 // from byte file all_sift_descriptors.binary generated by program
 // ACCUM_FEATURES:
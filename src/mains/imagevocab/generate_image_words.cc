@@ -4,9 +4,13 @@
 // all images which have SIFT key files, it imports SIFT feature
 // descriptors for each image.  GENERATE_IMAGE_WORDS maps image SIFT
 // features to word Voronoi clusters.  It exports a text file for each
-// image containing its SIFT word content.
+// image containing its SIFT word content.  Each image's word histogram
+// is also appended to a compressed inverted index which is exported
+// to images/keys/inverted_index/.  Image retrieval queries can then
+// decode just the posting lists for their words rather than rereading
+// every per-image text file.
 // ==========================================================================
-// Last updated on 4/25/12; 4/26/12; 4/30/12
+// Last updated on 4/25/12; 4/26/12; 4/30/12; 10/18/26
 // ==========================================================================
 
 #include <iostream>
@@ -16,6 +20,7 @@
 #include <flann/io/hdf5.h>
 
 #include "cluster/akm.h"
+#include "cluster/inverted_index.h"
 #include "general/filefuncs.h"
 #include "math/mathfuncs.h"
 #include "general/outputfuncs.h"
@@ -112,6 +117,42 @@ int main(int argc, char *argv[])
    cin >> i_start;
    int i_stop=n_images;
 
+// Resume any inverted index exported by a previous run.  Since posting
+// lists must be appended in increasing doc ID order, documents at or
+// beyond i_start are removed from the imported index.  Documents
+// preceding i_start are retained.  If the existing index cannot be
+// read or was built for a different vocabulary, we exit rather than
+// overwrite it:
+
+   string inverted_index_subdir=sift_keys_subdir+"inverted_index/";
+   inverted_index image_word_index(K);
+   if (i_start > 0 && 
+       filefunc::fileexist(inverted_index_subdir+"lexicon.bin"))
+   {
+      if (!image_word_index.import_index(inverted_index_subdir) ||
+          int(image_word_index.get_n_words()) != K)
+      {
+         cout << "Error in GENERATE_IMAGE_WORDS!" << endl;
+         cout << "Cannot resume inverted index within "
+              << inverted_index_subdir << " for K = " << K << endl;
+         cout << "Move it aside or restart with i_start = 0" << endl;
+         exit(-1);
+      }
+      if (image_word_index.get_last_doc_ID() >= i_start)
+      {
+         cout << "Removing inverted index documents from " << i_start
+              << " through " << image_word_index.get_last_doc_ID() << endl;
+         image_word_index.remove_documents(i_start);
+      }
+   }
+   else if (i_start > 0)
+   {
+      cout << "Warning: no inverted index found within "
+           << inverted_index_subdir << endl;
+      cout << "Exported index will only hold images " << i_start
+           << " onwards" << endl;
+   }
+
    for (int index=i_start; index<i_stop; index++)
    {
       string compressed_sift_hdf5_filename=compressed_sift_hdf5_filenames[
@@ -221,9 +262,16 @@ HDF5-DIAG: Error detected in HDF5 (1.8.4) thread 140033712548032:
       akm_ptr->reset_params(N,D,K);
       akm_ptr->set_SIFT_descriptors_matrix_ptr(&SIFT_descriptors);
       akm_ptr->compute_image_words(index,image_basename,image_words_subdir);
+      image_word_index.add_document(
+         index,image_basename,akm_ptr->get_image_word_count());
 
    } // loop over index labeling individual images
 
    string banner="Wrote image words to "+image_words_subdir;
    outputfunc::write_big_banner(banner);
+
+   image_word_index.export_index(inverted_index_subdir);
+   cout << image_word_index << endl;
+   banner="Wrote inverted index to "+inverted_index_subdir;
+   outputfunc::write_big_banner(banner);
 }
@@ -0,0 +1,132 @@
+// ==========================================================================
+// Program QUERY_IMAGE_WORDS imports the compressed inverted index
+// exported by program GENERATE_IMAGE_WORDS to
+// images/keys/inverted_index/.  For each query image's .words file
+// within images/keys/image_words/, it retrieves the k most similar
+// images in the index by decoding only the posting lists for the
+// query's words.  Ranked image IDs, basenames and scores are written
+// to images/keys/inverted_index/matches/.
+
+//				./query_image_words
+
+// ==========================================================================
+// Last updated on 10/18/26
+// ==========================================================================
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cluster/inverted_index.h"
+#include "general/filefuncs.h"
+#include "general/outputfuncs.h"
+#include "passes/PassesGroup.h"
+#include "general/stringfuncs.h"
+#include "general/sysfuncs.h"
+#include "time/timefuncs.h"
+
+using std::cin;
+using std::cout;
+using std::endl;
+using std::ofstream;
+using std::pair;
+using std::string;
+using std::vector;
+
+// ==========================================================================
+int main(int argc, char *argv[])
+// ==========================================================================
+{
+   std::set_new_handler(sysfunc::out_of_memory);
+
+// Use an ArgumentParser object to manage the program arguments:
+
+   osg::ArgumentParser arguments(&argc,argv);
+   PassesGroup passes_group(&arguments);
+
+   string image_list_filename=passes_group.get_image_list_filename();
+   string bundler_IO_subdir=filefunc::getdirname(image_list_filename);
+   string sift_keys_subdir=bundler_IO_subdir+"images/keys/";
+   cout << "sift_keys_subdir = " << sift_keys_subdir << endl;
+   string image_words_subdir=sift_keys_subdir+"image_words/";
+   cout << "image_words_subdir = " << image_words_subdir << endl;
+   string inverted_index_subdir=sift_keys_subdir+"inverted_index/";
+   cout << "inverted_index_subdir = " << inverted_index_subdir << endl;
+   string matches_subdir=inverted_index_subdir+"matches/";
+   filefunc::dircreate(matches_subdir);
+
+   inverted_index image_word_index;
+   if (!image_word_index.import_index(inverted_index_subdir))
+   {
+      cout << "Error in QUERY_IMAGE_WORDS!" << endl;
+      cout << "Could not import inverted index" << endl;
+      exit(-1);
+   }
+   cout << image_word_index << endl;
+
+   unsigned int k=10;
+   cout << "Enter number of matching images to retrieve per query:" << endl;
+   cin >> k;
+
+   int BM25_flag=0;
+   cout << "Enter 0 for TF-IDF cosine scoring or 1 for BM25 scoring:"
+        << endl;
+   cin >> BM25_flag;
+   inverted_index::scoring_type scoring=(BM25_flag==1) ?
+      inverted_index::BM25 : inverted_index::TFIDF;
+
+   string substring=".words";
+   vector<string> image_words_filenames=
+      filefunc::files_in_subdir_matching_substring(
+         image_words_subdir,substring);
+   int n_queries=image_words_filenames.size();
+
+   timefunc::initialize_timeofday_clock();
+   vector<int> doc_IDs;
+   vector<double> scores;
+   for (int q=0; q<n_queries; q++)
+   {
+      string image_words_filename=image_words_filenames[q];
+      if (q%100==0)
+      {
+         cout << "Processing query " << q << " of " << n_queries << endl;
+      }
+
+// Non-comment lines within .words files hold word IDs and counts:
+
+      filefunc::ReadInfile(image_words_filename);
+      vector<pair<int,int> > query_word_counts;
+      for (unsigned int l=0; l<filefunc::text_line.size(); l++)
+      {
+         vector<double> column_values=stringfunc::string_to_numbers(
+            filefunc::text_line[l]);
+         if (column_values.size() < 2) continue;
+         query_word_counts.push_back(pair<int,int>(
+            int(column_values[0]),int(column_values[1])));
+      }
+
+      image_word_index.query(query_word_counts,k,scoring,doc_IDs,scores);
+
+      string query_basename=filefunc::getprefix(
+         filefunc::getbasename(image_words_filename));
+      string matches_filename=matches_subdir+query_basename+".matches";
+      ofstream outstream;
+      filefunc::openfile(matches_filename,outstream);
+      outstream << "# Query image words file = "
+                << image_words_filename << endl;
+      outstream << "# Rank   Image_ID   Score   Image_basename" << endl
+                << endl;
+      for (unsigned int r=0; r<doc_IDs.size(); r++)
+      {
+         outstream << r << "  " << doc_IDs[r] << "  " << scores[r] << "  "
+                   << image_word_index.get_document_basename(doc_IDs[r])
+                   << endl;
+      }
+      filefunc::closefile(matches_filename,outstream);
+   } // loop over index q labeling query images
+
+   outputfunc::print_elapsed_time();
+   string banner="Wrote image matches to "+matches_subdir;
+   outputfunc::write_big_banner(banner);
+}
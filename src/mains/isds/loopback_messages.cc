@@ -0,0 +1,140 @@
+// ========================================================================
+// Program LOOPBACK_MESSAGES exercises Messenger's in-process loopback
+// transport without any ActiveMQ broker.  Several producer threads
+// each own a sending Messenger which publishes numbered text messages
+// on a common topic.  A single receiving Messenger concurrently
+// drains its mailbox.  LOOPBACK_MESSAGES checks that every message
+// from every producer arrives exactly once and in the order in which
+// it was sent.  Messages dropped by a full mailbox are reported.
+
+//			loopback_messages
+//			loopback_messages 8 100000
+
+// ========================================================================
+// Last updated on 10/18/26
+// ========================================================================
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "messenger/Messenger.h"
+#include "general/stringfuncs.h"
+#include "time/timefuncs.h"
+
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+// ==========================================================================
+// Method send_messages publishes n_messages text messages carrying
+// their producer and sequence numbers as properties:
+
+void send_messages(
+   string broker_URL,string topic_name,int producer_ID,int n_messages,
+   std::atomic<int>* n_finished_producers_ptr)
+{
+   string message_sender_ID="PRODUCER_"+
+      stringfunc::number_to_string(producer_ID);
+   Messenger m(broker_URL,topic_name,message_sender_ID);
+
+   typedef std::pair<string,string> property;
+   vector<property> properties(2);
+   for (int n=0; n<n_messages; n++)
+   {
+      properties[0]=property(
+         "producer",stringfunc::number_to_string(producer_ID));
+      properties[1]=property("sequence",stringfunc::number_to_string(n));
+      m.sendTextMessage("LOOPBACK_TEST",properties);
+   }
+   (*n_finished_producers_ptr)++;
+}
+
+// ==========================================================================
+int main(int argc, char *argv[])
+// ==========================================================================
+{
+   cout << "=====================================================" << endl;
+   cout << "Starting loopback messages test:" << endl;
+   cout << "=====================================================" << endl;
+
+   int n_producers=4;
+   int n_messages=20000;
+   if (argc > 1) n_producers=stringfunc::string_to_number(argv[1]);
+   if (argc > 2) n_messages=stringfunc::string_to_number(argv[2]);
+
+   string broker_URL="loopback://local";
+   string topic_name="loopback_test";
+   string message_receiver_ID="LOOPBACK_RECEIVER";
+   Messenger receiver(broker_URL,topic_name,message_receiver_ID);
+
+   timefunc::initialize_timeofday_clock();
+   std::atomic<int> n_finished_producers(0);
+   vector<std::thread> producer_threads;
+   for (int p=0; p<n_producers; p++)
+   {
+      producer_threads.push_back(std::thread(
+         send_messages,broker_URL,topic_name,p,n_messages,
+         &n_finished_producers));
+   }
+
+// Drain the receiver's mailbox while producers are still sending:
+
+   vector<int> next_sequence_numbers(n_producers,0);
+   int n_received=0,n_out_of_order=0,n_unknown=0;
+   while (true)
+   {
+      bool producers_finished_flag=(n_finished_producers==n_producers);
+      receiver.copy_messages_and_purge_mailbox();
+      if (receiver.get_n_curr_messages() > 0)
+      {
+         for (unsigned int i=0; i<receiver.get_n_curr_messages(); i++)
+         {
+            message* curr_message_ptr=receiver.get_message_ptr(i);
+            int producer_ID=stringfunc::string_to_number(
+               curr_message_ptr->get_property_value("producer"));
+            int sequence_number=stringfunc::string_to_number(
+               curr_message_ptr->get_property_value("sequence"));
+            if (producer_ID < 0 || producer_ID >= n_producers)
+            {
+               n_unknown++;
+               continue;
+            }
+            if (sequence_number < next_sequence_numbers[producer_ID])
+               n_out_of_order++;
+            next_sequence_numbers[producer_ID]=sequence_number+1;
+            n_received++;
+         } // loop over index i labeling received messages
+      }
+      else if (producers_finished_flag)
+      {
+         break;
+      }
+   } // infinite while loop
+
+   for (unsigned int t=0; t<producer_threads.size(); t++)
+   {
+      producer_threads[t].join();
+   }
+
+   double elapsed_secs=timefunc::elapsed_timeofday_time();
+   int n_sent=n_producers*n_messages;
+   int n_dropped=receiver.get_n_dropped_messages();
+   cout << "n_sent = " << n_sent
+        << " n_received = " << n_received
+        << " n_dropped = " << n_dropped << endl;
+   cout << "n_out_of_order = " << n_out_of_order
+        << " n_unknown = " << n_unknown << endl;
+   cout << "Messages per second = " << n_received/elapsed_secs << endl;
+
+   if (n_received+n_dropped != n_sent || n_out_of_order > 0 ||
+       n_unknown > 0)
+   {
+      cout << "Error in LOOPBACK_MESSAGES!" << endl;
+      return -1;
+   }
+   cout << "All messages accounted for" << endl;
+   return 0;
+}
@@ -0,0 +1,329 @@
+// ========================================================================
+// Program DELAUNAY_CHECK validates class delaunay_triangulator on
+// random and degenerate inputs.  It triangulates
+
+//   1.  n_random_sites uniformly distributed random sites,
+//   2.  a 100 x 100 integer grid whose diagonal sites are duplicated,
+//   3.  random sites plus two long constrained edges,
+//   4.  the grid with constrained edges running through collinear
+//       grid vertices and duplicated endpoints,
+//   5.  a square whose constrained side passes through a collinear
+//       hull vertex.
+
+// For each triangulation, DELAUNAY_CHECK verifies that every
+// triangle runs counterclockwise, that halfedge twins are mutually
+// consistent, that the triangle count satisfies Euler's relation
+// n_triangles = 2*n_vertices - 2 - n_hull_edges, and that no
+// unconstrained interior edge fails the incircle test.  It also
+// checks that every requested constrained edge is present as a chain
+// of constrained halfedges.
+
+//			delaunay_check
+//			delaunay_check 2000000
+
+// ========================================================================
+// Last updated on 10/18/26
+// ========================================================================
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "delaunay/delaunay_triangulator.h"
+#include "numrec/nrfuncs.h"
+#include "general/stringfuncs.h"
+#include "math/threevector.h"
+#include "time/timefuncs.h"
+
+using std::cout;
+using std::endl;
+using std::pair;
+using std::string;
+using std::vector;
+
+// ==========================================================================
+// Method check_triangulation returns the number of topological,
+// orientation, Euler and Delaunay violations within triangulation T
+// of the specified sites:
+
+int check_triangulation(
+   string label,const vector<threevector>& sites,
+   const delaunay_triangulator& T)
+{
+   const vector<int>& vertices=T.get_triangle_vertices();
+   const vector<int>& twins=T.get_halfedge_twins();
+   const vector<bool>& constrained=T.get_constrained_halfedges();
+   int n_triangles=T.get_n_triangles();
+
+   int n_hull_edges=0,n_bad_twins=0,n_bad_orientations=0;
+   int n_non_Delaunay=0,n_constrained=0;
+   for (int e=0; e<3*n_triangles; e++)
+   {
+      if (constrained[e]) n_constrained++;
+      int f=twins[e];
+      if (f < 0)
+      {
+         n_hull_edges++;
+         continue;
+      }
+      if (twins[f] != e ||
+          vertices[f] != vertices[delaunay_triangulator::next_halfedge(e)] ||
+          vertices[delaunay_triangulator::next_halfedge(f)] != vertices[e])
+      {
+         n_bad_twins++;
+      }
+      if (constrained[e]) continue;
+
+// Vertex opposite halfedge f must not lie inside the circumcircle of
+// halfedge e's triangle:
+
+      int t=e/3;
+      int d=vertices[delaunay_triangulator::prev_halfedge(f)];
+      double a_xy[2]={sites[vertices[3*t]].get(0),
+                      sites[vertices[3*t]].get(1)};
+      double b_xy[2]={sites[vertices[3*t+1]].get(0),
+                      sites[vertices[3*t+1]].get(1)};
+      double c_xy[2]={sites[vertices[3*t+2]].get(0),
+                      sites[vertices[3*t+2]].get(1)};
+      double d_xy[2]={sites[d].get(0),sites[d].get(1)};
+      if (delaunay_triangulator::incircle(a_xy,b_xy,c_xy,d_xy) > 0)
+         n_non_Delaunay++;
+   } // loop over index e labeling halfedges
+
+   for (int t=0; t<n_triangles; t++)
+   {
+      double a_xy[2]={sites[vertices[3*t]].get(0),
+                      sites[vertices[3*t]].get(1)};
+      double b_xy[2]={sites[vertices[3*t+1]].get(0),
+                      sites[vertices[3*t+1]].get(1)};
+      double c_xy[2]={sites[vertices[3*t+2]].get(0),
+                      sites[vertices[3*t+2]].get(1)};
+      if (delaunay_triangulator::orient2d(a_xy,b_xy,c_xy) <= 0)
+         n_bad_orientations++;
+   }
+
+   int n_vertices=sites.size()-T.get_n_duplicate_sites();
+   int n_Euler_violations=
+      (n_triangles==2*n_vertices-2-n_hull_edges) ? 0 : 1;
+
+   cout << label << ": n_vertices = " << n_vertices
+        << " n_duplicates = " << T.get_n_duplicate_sites()
+        << " n_triangles = " << n_triangles
+        << " n_hull_edges = " << n_hull_edges
+        << " n_constrained_halfedges = " << n_constrained << endl;
+   cout << "   n_bad_twins = " << n_bad_twins
+        << " n_bad_orientations = " << n_bad_orientations
+        << " n_Euler_violations = " << n_Euler_violations
+        << " n_non_Delaunay = " << n_non_Delaunay << endl;
+
+   return n_bad_twins+n_bad_orientations+n_Euler_violations+n_non_Delaunay;
+}
+
+// ==========================================================================
+// Method check_constrained_edges returns the number of requested
+// constrained edges which are missing from triangulation T.  Since
+// constrained edges are split at collinear vertices, each one is
+// followed from its start site along constrained halfedges which
+// advance towards its stop site.  Hull halfedges lack twins, so they
+// are traversed in either direction.
+
+int check_constrained_edges(
+   const vector<threevector>& sites,const delaunay_triangulator& T,
+   const vector<pair<int,int> >& edges)
+{
+   const vector<int>& vertices=T.get_triangle_vertices();
+   const vector<bool>& constrained=T.get_constrained_halfedges();
+
+   vector<int> constrained_halfedges;
+   for (unsigned int e=0; e<constrained.size(); e++)
+   {
+      if (constrained[e]) constrained_halfedges.push_back(e);
+   }
+
+   int n_missing=0;
+   for (unsigned int i=0; i<edges.size(); i++)
+   {
+      int start=T.get_surviving_site(edges[i].first);
+      int stop=T.get_surviving_site(edges[i].second);
+      double start_xy[2]={sites[start].get(0),sites[start].get(1)};
+      double stop_xy[2]={sites[stop].get(0),sites[stop].get(1)};
+
+      int curr=start;
+      while (curr != stop)
+      {
+         int next=-1;
+         for (unsigned int k=0; k<constrained_halfedges.size() && next < 0;
+              k++)
+         {
+            int e=constrained_halfedges[k];
+            int u=vertices[e];
+            int w=vertices[delaunay_triangulator::next_halfedge(e)];
+            if (w==curr) std::swap(u,w);
+            if (u != curr) continue;
+            double w_xy[2]={sites[w].get(0),sites[w].get(1)};
+            if (delaunay_triangulator::orient2d(start_xy,stop_xy,w_xy) != 0)
+               continue;
+            threevector step=sites[w]-sites[curr];
+            threevector dir=sites[stop]-sites[start];
+            if (step.get(0)*dir.get(0)+step.get(1)*dir.get(1) > 0) next=w;
+         }
+         if (next < 0) break;
+         curr=next;
+      }
+
+      if (curr != stop)
+      {
+         cout << "   Constrained edge between sites " << edges[i].first
+              << " and " << edges[i].second << " is missing" << endl;
+         n_missing++;
+      }
+   } // loop over index i labeling requested constrained edges
+
+   cout << "   n_failed_constrained_edges = "
+        << T.get_n_failed_constrained_edges()
+        << " n_missing_constrained_edges = " << n_missing << endl;
+   return n_missing;
+}
+
+// ==========================================================================
+int main(int argc, char *argv[])
+// ==========================================================================
+{
+   int n_random_sites=2000000;
+   if (argc > 1) n_random_sites=stringfunc::string_to_number(argv[1]);
+   nrfunc::init_default_seed(-1);
+
+   int n_failures=0;
+
+// Uniformly distributed random sites:
+
+   vector<threevector> random_sites;
+   random_sites.reserve(n_random_sites);
+   for (int i=0; i<n_random_sites; i++)
+   {
+      random_sites.push_back(
+         threevector(1000*nrfunc::ran1(),1000*nrfunc::ran1(),0));
+   }
+
+   timefunc::initialize_timeofday_clock();
+   {
+      delaunay_triangulator T(random_sites);
+      if (!T.triangulate()) n_failures++;
+      cout << "Triangulated " << n_random_sites << " random sites in "
+           << timefunc::elapsed_timeofday_time() << " secs" << endl;
+      n_failures += check_triangulation("Random sites",random_sites,T);
+   }
+
+// Integer grid containing collinear and cocircular sites.  Diagonal
+// sites are duplicated:
+
+   const int n_grid=100;
+   vector<threevector> grid_sites;
+   for (int i=0; i<n_grid; i++)
+   {
+      for (int j=0; j<n_grid; j++)
+      {
+         grid_sites.push_back(threevector(i,j,0));
+      }
+   }
+   for (int i=0; i<n_grid/2; i++)
+   {
+      grid_sites.push_back(threevector(i,i,0));
+   }
+
+   {
+      delaunay_triangulator T(grid_sites);
+      if (!T.triangulate()) n_failures++;
+      n_failures += check_triangulation("Grid sites",grid_sites,T);
+   }
+
+// Random sites plus two long crossing-free constrained edges:
+
+   vector<threevector> constrained_sites;
+   for (int i=0; i<2000; i++)
+   {
+      constrained_sites.push_back(
+         threevector(1000*nrfunc::ran1(),1000*nrfunc::ran1(),0));
+   }
+   int n_random=constrained_sites.size();
+   constrained_sites.push_back(threevector(1,1,0));
+   constrained_sites.push_back(threevector(999,998,0));
+   constrained_sites.push_back(threevector(1,999,0));
+   constrained_sites.push_back(threevector(600,700,0));
+
+   {
+      vector<pair<int,int> > edges;
+      edges.push_back(pair<int,int>(n_random,n_random+1));
+      edges.push_back(pair<int,int>(n_random+2,n_random+3));
+
+      delaunay_triangulator T(constrained_sites);
+      for (unsigned int i=0; i<edges.size(); i++)
+      {
+         T.add_constrained_edge(edges[i].first,edges[i].second);
+      }
+      if (!T.triangulate()) n_failures++;
+      n_failures += check_triangulation(
+         "Constrained random sites",constrained_sites,T);
+      n_failures += check_constrained_edges(constrained_sites,T,edges);
+   }
+
+// Constrained edges along the grid's diagonal and a grid row pass
+// through collinear vertices and must be split there.  Diagonal
+// endpoints (0,0) and (1,1) also appear among the duplicated sites
+// appended after the grid:
+
+   {
+      vector<pair<int,int> > edges;
+      edges.push_back(pair<int,int>(0,(n_grid-1)*n_grid+n_grid-1));
+      edges.push_back(pair<int,int>(5,(n_grid-1)*n_grid+5));
+      edges.push_back(pair<int,int>(n_grid*n_grid,n_grid*n_grid+10));
+      edges.push_back(pair<int,int>(n_grid*n_grid+1,4*n_grid+2));
+
+      delaunay_triangulator T(grid_sites);
+      for (unsigned int i=0; i<edges.size(); i++)
+      {
+         T.add_constrained_edge(edges[i].first,edges[i].second);
+      }
+      if (!T.triangulate()) n_failures++;
+      n_failures += check_triangulation(
+         "Constrained grid sites",grid_sites,T);
+      n_failures += check_constrained_edges(grid_sites,T,edges);
+   }
+
+// Square whose left side passes through hull vertex (0,5).  Constrained
+// edge (0,0) -> (0,10) must be split there even though the triangle
+// joining (0,0) to (0,5) beyond the hull is a ghost:
+
+   vector<threevector> square_sites;
+   square_sites.push_back(threevector(0,0,0));
+   square_sites.push_back(threevector(10,0,0));
+   square_sites.push_back(threevector(10,10,0));
+   square_sites.push_back(threevector(0,10,0));
+   square_sites.push_back(threevector(0,5,0));
+   square_sites.push_back(threevector(4,6,0));
+
+   for (int i=0; i<2; i++)
+   {
+      vector<pair<int,int> > edges;
+      edges.push_back(pair<int,int>((i==0) ? 0 : 3,(i==0) ? 3 : 0));
+      edges.push_back(pair<int,int>(3,1));
+
+      delaunay_triangulator T(square_sites);
+      for (unsigned int j=0; j<edges.size(); j++)
+      {
+         T.add_constrained_edge(edges[j].first,edges[j].second);
+      }
+      if (!T.triangulate()) n_failures++;
+      n_failures += check_triangulation("Square sites",square_sites,T);
+      n_failures += check_constrained_edges(square_sites,T,edges);
+   }
+
+   if (n_failures > 0)
+   {
+      cout << "Error in DELAUNAY_CHECK!" << endl;
+      cout << "n_failures = " << n_failures << endl;
+      return -1;
+   }
+   cout << "All triangulations passed" << endl;
+   return 0;
+}
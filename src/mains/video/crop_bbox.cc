@@ -11,7 +11,7 @@
 // features tracked outside the overlap region between the ladar and
 // video data.
 // ========================================================================
-// Last updated on 11/15/05
+// Last updated on 11/15/05; 10/18/26
 // ========================================================================
 
 #include <iostream>
@@ -42,6 +42,7 @@ int main(int argc, char* argv[])
    string output_filename="bbox.vid";
 
    VidFile vid_in(input_filename);
+   vid_in.enable_prefetching();
 
    cout << "Total number of input frames = " << vid_in.getNumFrames() 
         << endl;
@@ -7,7 +7,7 @@
 // distinct dot pattern which is seen in the grey scale images output
 // by RAW2VID.
 // ========================================================================
-// Last updated on 9/27/05
+// Last updated on 9/27/05; 10/18/26
 // ========================================================================
 
 #include <iostream>
@@ -31,6 +31,7 @@ int main(int argc, char* argv[])
       +"corrected_grey.vid";
 
    VidFile vid_in(input_filename);
+   vid_in.enable_prefetching();
 
    int startFrame=0;
    int endFrame=vid_in.getNumFrames()-1;
@@ -2,7 +2,7 @@
 // Program RAW2VID converts raw Group 99 video data into Group 99 .vid
 // files.
 // ========================================================================
-// Last updated on 8/24/05
+// Last updated on 8/24/05; 10/18/26
 // ========================================================================
 
 #include <iostream>
@@ -43,6 +43,7 @@ int main(int argc, char* argv[])
    raw_video.compute_output_video_image_params();
    raw_video.write_output_header();
    raw_video.advance_raw_file_counter();
+   raw_video.enable_prefetching();
 
 // Write converted video data to output .vid file:
 
@@ -1,13 +1,14 @@
 // ==========================================================================
 // Binary math functions 
 // ==========================================================================
-// Last updated on 4/28/13; 4/29/13; 5/4/13; 5/31/13; 6/7/14
+// Last updated on 4/28/13; 4/29/13; 5/4/13; 5/31/13; 6/7/14; 10/18/26
 // ==========================================================================
 
 #include <bitset>
 #include <iostream>
 #include "math/binaryfuncs.h"
 #include "datastructures/descriptor.h"
+#include "datastructures/packed_descriptor.h"
 #include "math/genvector.h"
 
 using std::bitset;
@@ -165,27 +166,16 @@ namespace binaryfunc
 // version 18.1!  Need to "#include dlib/general_hash/count_bits.h"
 
 // Method hamming_distance() computes the Hamming distance of two
-// integers (considered as binary sequences of bits).  The run time
-// of this procedure is proportional to the Hamming distance rather
-// than to the number of input bits.  It computes the bitwise
-// exclusive or of the 2 inputs.  It then returns the Hamming weight
-// of the result (= number of nonzero bits) using an algorithm of
-// Wegner (1960) that repeatedly finds and clears the lowest-order
-// nonzero bit.
+// integers (considered as binary sequences of bits).  It computes the
+// bitwise exclusive or of the 2 inputs.  It then returns the Hamming
+// weight of the result (= number of nonzero bits).  As of Oct 2026,
+// we let the compiler emit a single POPCNT instruction rather than
+// repeatedly clearing the lowest-order nonzero bit via Wegner's
+// (1960) loop.
 
    unsigned long hamming_distance(unsigned long x,unsigned long y)
    {
-      unsigned long dist=0;
-      unsigned long value=x^y;
-      
-// Count number of set bits:
-
-      while (value)
-      {
-         ++dist;
-         value &= value-1;
-      }
-      return dist;
+      return __builtin_popcountl(x^y);
    }
    
 // ---------------------------------------------------------------------
@@ -215,18 +205,64 @@ namespace binaryfunc
    }
 
 
+// ---------------------------------------------------------------------
+// This overloaded version of hamming_distance() takes in two
+// descriptors whose entries are assumed to equal either 0 or 1.  On
+// 10/18/26, we eliminated the intermediate '0'/'1' string round trip
+// which also silently truncated descriptors to their first 64 bits.
+// All d_dims components now contribute to the returned distance.
+
    unsigned long hamming_distance(descriptor* x_ptr,descriptor* y_ptr)
    {
-//      cout << "inside binaryfunc::hamming_distance()" << endl;
-//      cout << "*x_ptr = " << *x_ptr << endl;
-//      cout << "*y_ptr = " << *y_ptr << endl;
+      unsigned long dist=0;
+      unsigned int d_dims=x_ptr->get_mdim();
+      for (unsigned int d=0; d<d_dims; d++)
+      {
+         if ((x_ptr->get(d) != 0) != (y_ptr->get(d) != 0)) dist++;
+      }
+      return dist;
+   }
 
-      string x_str=descriptor_to_string(x_ptr);
-      string y_str=descriptor_to_string(y_ptr);
-      return hamming_distance(x_str,y_str);
+// ---------------------------------------------------------------------
+// Method popcount_hamming_distance() returns the number of differing
+// bits within two arrays of n_words 64-bit words.  Since our Makefiles
+// compile with -msse4, __builtin_popcountl() becomes a single POPCNT
+// instruction.  packed_descriptor pads its words to whole 4-word
+// blocks, so the loop below is unrolled by 4 with independent
+// accumulators.
+
+   unsigned long popcount_hamming_distance(
+      const unsigned long* x,const unsigned long* y,unsigned int n_words)
+   {
+      unsigned long dist0=0,dist1=0,dist2=0,dist3=0;
+      unsigned int w=0;
+      for (; w+4 <= n_words; w += 4)
+      {
+         dist0 += __builtin_popcountl(x[w]^y[w]);
+         dist1 += __builtin_popcountl(x[w+1]^y[w+1]);
+         dist2 += __builtin_popcountl(x[w+2]^y[w+2]);
+         dist3 += __builtin_popcountl(x[w+3]^y[w+3]);
+      }
+      for (; w<n_words; w++)
+      {
+         dist0 += __builtin_popcountl(x[w]^y[w]);
+      }
+      return dist0+dist1+dist2+dist3;
    }
-   
 
+// ---------------------------------------------------------------------
+// This overloaded version of hamming_distance() takes in two packed
+// binary descriptors.  If their bit lengths differ, only the words
+// common to both contribute.
+
+   unsigned long hamming_distance(
+      const packed_descriptor* x_ptr,const packed_descriptor* y_ptr)
+   {
+      unsigned int n_words=x_ptr->get_n_words();
+      if (y_ptr->get_n_words() < n_words) n_words=y_ptr->get_n_words();
+      return popcount_hamming_distance(
+         x_ptr->get_words_ptr(),y_ptr->get_words_ptr(),n_words);
+   }
 
 } // binaryfunc namespace
 
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for stand-alone binary math functions 
 // ==========================================================================
-// Last updated on 4/28/13; 4/29/13; 5/31/13
+// Last updated on 4/28/13; 4/29/13; 5/31/13; 10/18/26
 // ==========================================================================
 
 #ifndef BINARYFUNCS_H
@@ -12,6 +12,7 @@
 
 class descriptor;
 class genvector;
+class packed_descriptor;
 
 namespace binaryfunc
 {
@@ -30,6 +31,10 @@ namespace binaryfunc
       std::string& binary_str1,std::string& binary_str2);
    unsigned long hamming_distance(genvector* x_ptr,genvector* y_ptr);
    unsigned long hamming_distance(descriptor* x_ptr,descriptor* y_ptr);
+   unsigned long popcount_hamming_distance(
+      const unsigned long* x,const unsigned long* y,unsigned int n_words);
+   unsigned long hamming_distance(
+      const packed_descriptor* x_ptr,const packed_descriptor* y_ptr);
 }
 
 #endif  // binaryfunc namespace
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Genmatrix class member function definitions
 // ==========================================================================
-// Last modified on 10/20/16; 11/28/16; 12/4/16; 1/18/17
+// Last modified on 10/20/16; 11/28/16; 12/4/16; 1/18/17; 10/18/26
 // =========================================================================
 
 #include <Eigen/Dense>
@@ -2069,39 +2069,47 @@ void genmatrix::matrix_transpose(const genmatrix& A)
    }
 }
 
+// ---------------------------------------------------------------------
+// Dense matrix products are handed off to Eigen whose GEMM kernels
+// are cache-blocked and SIMD vectorized.  Eigen maps wrap genmatrix's
+// row-major storage without any copying.
+
+typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor>
+RowMajorMatrixXd;
+
 void genmatrix::matrix_mult(const genmatrix& A, const genmatrix& B)
 {
-   clear_values();
-
 //   cout << "inside genmatrix::matrix_mult()" << endl;
 //   cout << "A.mdim = " << A.mdim << " A.ndim = " << A.ndim
 //        << " B.mdim = " << B.mdim << " B.ndim = " << B.ndim 
 //        << endl;
 
-   int A_mdim = A.mdim;
-   int A_ndim = A.ndim;
-   int B_ndim = B.ndim;
+   Eigen::Map<const RowMajorMatrixXd> AE(A.get_e_ptr(), A.mdim, A.ndim);
+   Eigen::Map<const RowMajorMatrixXd> BE(B.get_e_ptr(), B.mdim, B.ndim);
+   Eigen::Map<RowMajorMatrixXd> CE(get_e_ptr(), A.mdim, B.ndim);
+   CE.noalias() = AE * BE;
+}
 
-   const double* A_e_ptr = A.get_e_ptr();
-   const double* B_e_ptr = B.get_e_ptr();
-   double* C_e_ptr = get_e_ptr();
-   
-   for (int i = 0; i < A_mdim; i++)
-   {
-      for (int k = 0; k < A_ndim; k++)
-      {
-         const double* a = A_e_ptr + i * A_ndim + k;
-         const double* b = B_e_ptr + k * B_ndim;
-         double *c = C_e_ptr + i * B_ndim;
-         double *cMax = c + B_ndim;
-         
-         while(c < cMax)
-         {
-            *c++ += (*a) * (*b++);
-         }
-         
-      } // loop over index k
-   } // loop over index i 
+// Member function matrix_transpose_mult() sets *this = A^T * B
+// without explicitly forming A^T.
+
+void genmatrix::matrix_transpose_mult(const genmatrix& A, const genmatrix& B)
+{
+   Eigen::Map<const RowMajorMatrixXd> AE(A.get_e_ptr(), A.mdim, A.ndim);
+   Eigen::Map<const RowMajorMatrixXd> BE(B.get_e_ptr(), B.mdim, B.ndim);
+   Eigen::Map<RowMajorMatrixXd> CE(get_e_ptr(), A.ndim, B.ndim);
+   CE.noalias() = AE.transpose() * BE;
+}
+
+// Member function matrix_mult_transpose() sets *this = A * B^T
+// without explicitly forming B^T.
+
+void genmatrix::matrix_mult_transpose(const genmatrix& A, const genmatrix& B)
+{
+   Eigen::Map<const RowMajorMatrixXd> AE(A.get_e_ptr(), A.mdim, A.ndim);
+   Eigen::Map<const RowMajorMatrixXd> BE(B.get_e_ptr(), B.mdim, B.ndim);
+   Eigen::Map<RowMajorMatrixXd> CE(get_e_ptr(), A.mdim, B.mdim);
+   CE.noalias() = AE * BE.transpose();
 }
 
 void genmatrix::matrix_column_mult(const genmatrix& A, const genmatrix& B,
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for genmatrix class 
 // ==========================================================================
-// Last modified on 10/20/16; 11/28/16; 12/4/16; 1/18/17
+// Last modified on 10/20/16; 11/28/16; 12/4/16; 1/18/17; 10/18/26
 // ==========================================================================
 
 #ifndef GENMATRIX_H
@@ -160,6 +160,8 @@ class genmatrix:public genarray
    void matrix_increment(double alpha, const genmatrix& B);
    void matrix_transpose(const genmatrix& A);
    void matrix_mult(const genmatrix& A, const genmatrix& B);
+   void matrix_transpose_mult(const genmatrix& A, const genmatrix& B);
+   void matrix_mult_transpose(const genmatrix& A, const genmatrix& B);
    void matrix_column_mult(const genmatrix& A, const genmatrix& B, int bcol);
    void matrix_column_mult_sum(
       const genmatrix& A, const genmatrix& B, const genvector& V, int bcol);
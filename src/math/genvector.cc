@@ -1,10 +1,11 @@
 // ==========================================================================
 // Genvector class member function definitions
 // ==========================================================================
-// Last modified on 10/19/16; 11/29/16; 12/13/16; 1/18/17
+// Last modified on 10/19/16; 11/29/16; 12/13/16; 1/18/17; 10/18/26
 // ==========================================================================
 
 #include <math.h>
+#include <Eigen/Dense>
 #include "math/basic_math.h"
 #include "datastructures/descriptor.h"
 #include "math/genvector.h"
@@ -577,31 +578,31 @@ genvector operator* (const genvector& X,const genmatrix& A)
 // input matrix A and vector X have correct dimensions to be
 // multiplied together and put into *this.
 
+// Matrix-vector products are handed off to Eigen's SIMD vectorized
+// GEMV kernels.  Eigen maps wrap row-major genmatrix storage without
+// any copying.
+
+typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor>
+RowMajorMatrixXd;
+
 void genvector::matrix_vector_mult(const genmatrix& A,const genvector& X)
 {
-   for (unsigned int i = 0; i < A.get_mdim(); i++)
-   {
-      double sum = 0;
-      for (unsigned int j = 0; j < A.get_ndim(); j++)
-      {
-         sum += A.get(i,j) * X.get(j);
-      }
-      put(i, sum);
-   }
+   Eigen::Map<const RowMajorMatrixXd> AE(
+      A.get_e_ptr(), A.get_mdim(), A.get_ndim());
+   Eigen::Map<const Eigen::VectorXd> XE(X.get_e_ptr(), A.get_ndim());
+   Eigen::Map<Eigen::VectorXd> YE(get_e_ptr(), A.get_mdim());
+   YE.noalias() = AE * XE;
 }
 
 void genvector::matrix_vector_mult_sum(
    const genmatrix& A,const genvector& X, const genvector& V)
 {
-   for (unsigned int i = 0; i < A.get_mdim(); i++)
-   {
-      double sum = V.get(i);
-      for (unsigned int j = 0; j < A.get_ndim(); j++)
-      {
-         sum += A.get(i,j) * X.get(j);
-      }
-      put(i, sum);
-   }
+   Eigen::Map<const RowMajorMatrixXd> AE(
+      A.get_e_ptr(), A.get_mdim(), A.get_ndim());
+   Eigen::Map<const Eigen::VectorXd> XE(X.get_e_ptr(), A.get_ndim());
+   Eigen::Map<const Eigen::VectorXd> VE(V.get_e_ptr(), A.get_mdim());
+   Eigen::Map<Eigen::VectorXd> YE(get_e_ptr(), A.get_mdim());
+   YE.noalias() = AE * XE + VE;
 }
 
 void genvector::vector_increment(double alpha, const genvector& B)
@@ -1,11 +1,13 @@
 // ==========================================================================
 // Messenger class member function definitions
 // ==========================================================================
-// Last modified on 2/14/12; 2/17/12; 1/23/14; 4/5/14
+// Last modified on 2/14/12; 2/17/12; 1/23/14; 4/5/14; 10/18/26
 // ==========================================================================
 
 #include <unistd.h> // for sleep() calls
 #include "messenger/Messenger.h"
+#include "messenger/loopback_transport.h"
+#include "messenger/message_mailbox.h"
 #include "general/stringfuncs.h"
 #include "time/timefuncs.h"
 
@@ -26,14 +28,22 @@ using std::vector;
 // Initialization, constructor and destructor functions:
 // ---------------------------------------------------------------------
 
+// As of 10/18/26, incoming messages are queued within a bounded
+// lock-free mailbox.  The ActiveMQ listener thread never waits upon
+// the consumer.  If the consumer falls more than mailbox_capacity
+// messages behind, further messages are dropped and counted.
+
 void Messenger::allocate_member_objects()
 {
+   const unsigned int mailbox_capacity=16384;
+   mailbox_ptr=new message_mailbox(mailbox_capacity);
 }
 
 void Messenger::initialize_member_objects()
 {
-   mailbox_locked_flag=clearing_mailbox_flag=false;
+   loopback_flag=false;
    n_sent_messages=n_received_messages=0;
+   messengerThread_ptr=NULL;
    connection_ptr = NULL;
    session_ptr = NULL;
    destination_ptr = NULL;
@@ -103,6 +113,23 @@ void Messenger::finish_construction(
    
    this->topicName = topicName;
    this->useQueue = useQueue;
+
+// Broker URLs beginning with "loopback:" bypass ActiveMQ altogether.
+// Messages are then exchanged only with other Messengers within the
+// current process which subscribe to the same topic:
+
+   if (loopback_transport::is_loopback_URL(broker_URL))
+   {
+      loopback_flag=true;
+      string ignored_producer_ID="";
+      if (msg_sender_ID=="DISALLOW_SELF_MESSAGES")
+      {
+         ignored_producer_ID=msg_sender_ID;
+      }
+      loopback_transport::subscribe(
+         topicName,mailbox_ptr,ignored_producer_ID);
+      return;
+   }
    
 /*
    if (include_sender_and_timestamp_info_flag)
@@ -119,12 +146,15 @@ Messenger::~Messenger()
 {
 //   cout << "inside Messenger destructor" << endl;
    stop_operations();
+   if (loopback_flag) loopback_transport::unsubscribe(mailbox_ptr);
+   delete mailbox_ptr;
 }
  
 // ---------------------------------------------------------------------
 void Messenger::start_operations()
 {
 //   cout << "inside Messenger::start_operations" << endl;
+   if (loopback_flag) return;
    messengerThread_ptr=new Thread(this);
    messengerThread_ptr->start();
    sleep(1.0);	// secs
@@ -148,7 +178,12 @@ void Messenger::stop_operations()
 
 unsigned int Messenger::get_n_messages_in_mailbox() const
 {
-   return mailbox.size();
+   return mailbox_ptr->get_n_messages();
+}
+
+unsigned int Messenger::get_n_dropped_messages() const
+{
+   return mailbox_ptr->get_n_dropped_messages();
 }
 
 unsigned int Messenger::get_n_curr_messages() const
@@ -181,6 +216,15 @@ void Messenger::sendBytesMessage(const char* bytes, unsigned int bytesSize)
 {
 //   cout << "inside Messenger::sendBytesMessage()" << endl;
 
+// Recall onMessage() ignores all non-text messages.  So bytes
+// messages sent via loopback transport never reach any mailbox:
+
+   if (loopback_flag)
+   {
+      n_sent_messages++;
+      return;
+   }
+
    BytesMessage* msg_ptr=generate_BytesMessage(bytes, bytesSize);
 
    if (msg_ptr==NULL)    {
@@ -352,6 +396,13 @@ void Messenger::sendTextMessage(
 //   cout << "TopicName = " << get_topicName << endl;
 //   cout << "textMsg = " << textMsg << endl;
 
+   if (loopback_flag)
+   {
+      send_loopback_TextMessage(
+         textMsg,particular_string_properties,print_msg_flag);
+      return;
+   }
+
    TextMessage* msg_ptr=generate_TextMessage(
       textMsg,particular_string_properties);
 
@@ -384,6 +435,40 @@ void Messenger::sendTextMessage(
    n_sent_messages++;
 }
 
+// ---------------------------------------------------------------------
+// Member function send_loopback_TextMessage() attaches the same
+// sender and timestamp properties as generate_TextMessage() and
+// publishes the message to all in-process subscribers.
+
+void Messenger::send_loopback_TextMessage(
+   string textMsg,const vector<Property>& particular_string_properties,
+   bool print_msg_flag)
+{
+   string msg_producer_ID="";
+   vector<Property> properties;
+   if (include_sender_and_timestamp_info_flag)
+   {
+      msg_producer_ID=msg_sender_ID;
+      properties.push_back(Property("Message_sender_ID",msg_sender_ID));
+      properties.push_back(
+         Property("Message_timestamp",timefunc::getcurrdate()));
+   }
+   properties.insert(
+      properties.end(),particular_string_properties.begin(),
+      particular_string_properties.end());
+
+   loopback_transport::publish(
+      topicName,textMsg,msg_producer_ID,properties);
+   n_sent_messages++;
+
+   if (print_msg_flag)
+   {
+      message sent_message(textMsg,msg_producer_ID,properties);
+      cout << "Contents of sent message:  " << sent_message << endl;
+      cout << "n_sent_messages = " << get_n_sent_messages() << endl;
+   }
+}
+
 // ---------------------------------------------------------------------
 TextMessage* Messenger::generate_TextMessage( 
    string textMsg,const vector<Property>& particular_string_properties)
@@ -510,6 +595,20 @@ void Messenger::changeTopic(string topic_name,bool useQueue)
 //   cout << "topic_name = " << topic_name << endl;
 //   cout << "topic_name.size() = " << topic_name.size() << endl;
 
+   if (loopback_flag)
+   {
+      string ignored_producer_ID="";
+      if (msg_sender_ID=="DISALLOW_SELF_MESSAGES")
+      {
+         ignored_producer_ID=msg_sender_ID;
+      }
+      loopback_transport::unsubscribe(topicName,mailbox_ptr);
+      topicName=topic_name;
+      loopback_transport::subscribe(
+         topicName,mailbox_ptr,ignored_producer_ID);
+      return;
+   }
+
 // Create the destination (Topic or Queue)
 
    if( useQueue ) 
@@ -549,6 +648,7 @@ bool Messenger::connected_to_broker_flag() const
 //   cout << "inside Messenger::connected_to_broker_flag()" << endl;
 //   bool flag=(connection_ptr != NULL && session_ptr != NULL);
 //   cout << "flag = " << flag << endl;
+   if (loopback_flag) return true;
    return (connection_ptr != NULL && session_ptr != NULL);
 }
 
@@ -589,13 +689,9 @@ void Messenger::onMessage( const Message* msg_ptr )
                textMessage_ptr->getStringProperty(PropertyNames[p]));
             properties.push_back(P);
          } // loop over index p labeling textMessage's properties
-         message curr_message(text,msg_producer_ID,properties);
 
 // Ignore self-messages only if msg_sender_ID != "ALLOW_SELF_MESSAGES":
 
-//         if ((msg_sender_ID != "ALLOW_SELF_MESSAGES" 
-//              && msg_producer_ID==msg_sender_ID
-
 //         cout << "msg_sender_ID = " << msg_sender_ID << endl;
 //         cout << "msg_producer_ID = " << msg_producer_ID << endl;
 
@@ -604,29 +700,14 @@ void Messenger::onMessage( const Message* msg_ptr )
          {
             cout << "Ignoring self-messsages" << endl;
          }
-         else
+         else if (!mailbox_ptr->push(text,msg_producer_ID,properties))
          {
-//            cout << "Message received from "+msg_producer_ID << endl;
-//            cout << "Text message = " << curr_message.get_text_message()
-//                 << endl;
-
-            while (clearing_mailbox_flag)
+            unsigned int n_dropped=mailbox_ptr->get_n_dropped_messages();
+            if (n_dropped%1000==1)
             {
-               usleep(100);
-               cout << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!"
-                    << endl;
-               cout << "inside Messenger::onMessage(), mailbox purging flag=true"
-                    << endl;
-               cout << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!"
-                    << endl;
+               cout << "Messenger mailbox full for topic " << topicName
+                    << ", n_dropped_messages = " << n_dropped << endl;
             }
-            mailbox_locked_flag=true;
-            mailbox.push_back( curr_message );
-//            cout << "mailbox message = "
-//                 << mailbox.back() << endl;
-//            cout << "get_n_messages_in_mailbox() = "
-//                 << get_n_messages_in_mailbox() << endl;
-            mailbox_locked_flag=false;
          }
       } // else, not a text message. ignore it.
    } catch (CMSException& e) 
@@ -642,38 +723,19 @@ void Messenger::onException( const CMSException& ex AMQCPP_UNUSED)
 }
 
 // ---------------------------------------------------------------------
-bool Messenger::copy_messages_and_purge_mailbox()
+// Member function copy_messages_and_purge_mailbox() moves up to
+// max_n_messages (or all if max_n_messages==0) queued messages into
+// member STL vector curr_messages in one batch.  Since the mailbox
+// never locks, this method always returns true.
+
+bool Messenger::copy_messages_and_purge_mailbox(unsigned int max_n_messages)
 {
 //   cout << "inside Messenger::copy_messages_and_purge_mailbox()" << endl;
 
-   curr_messages.clear();
-   for (unsigned int m=0; m<mailbox.size(); m++)
-   {
-      curr_messages.push_back(mailbox[m]);
-      n_received_messages++;
-   }
-
-   const int max_counter_value=10;
-   int counter=0;
-   while (mailbox_locked_flag && counter < max_counter_value)
-   {
-      usleep(100);
-      cout << "******************************************************" << endl;
-      cout << "In Messenger::copy_messages_and_purge_mailbox(), mailbox locked"
-           << endl;
-      cout << "counter = " << counter << endl;
-      cout << "******************************************************" << endl;
-      counter++;
-   }
-   if (mailbox_locked_flag) return false;
+   n_received_messages += mailbox_ptr->drain(curr_messages,max_n_messages);
 
-   clearing_mailbox_flag=true;
-   mailbox.clear();
-   clearing_mailbox_flag=false;
-   
 //   cout << "At end of copy_messages_and_purge_mailbox()" << endl;
 //   cout << "curr_messages.size() = " << curr_messages.size() << endl;
-//   cout << "mailbox.size() = " << mailbox.size() << endl;
    return true;
 }
 
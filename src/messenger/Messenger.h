@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for Messenger class
 // ==========================================================================
-// Last modified on 6/9/11; 2/17/12; 1/23/14; 4/5/14; 4/8/14
+// Last modified on 6/9/11; 2/17/12; 1/23/14; 4/5/14; 4/8/14; 10/18/26
 // ==========================================================================
 
 #ifndef MESSENGER_H
@@ -42,6 +42,8 @@
 
 #include "messenger/message.h"
 
+class message_mailbox;
+
 // DELL
 using namespace activemq::concurrent;
 
@@ -74,6 +76,7 @@ class Messenger : public ExceptionListener,
 // Set & get member functions:
 
     unsigned int get_n_messages_in_mailbox() const;
+    unsigned int get_n_dropped_messages() const;
     unsigned int get_n_curr_messages() const;
     unsigned int get_n_sent_messages() const;
     unsigned int get_n_received_messages() const;
@@ -121,7 +124,7 @@ class Messenger : public ExceptionListener,
 
     virtual void onException( const CMSException& ex AMQCPP_UNUSED);
 
-    bool copy_messages_and_purge_mailbox();
+    bool copy_messages_and_purge_mailbox(unsigned int max_n_messages=0);
     message* get_message_ptr(unsigned int n);
     const message* get_message_ptr(unsigned int n) const;
 
@@ -147,7 +150,7 @@ class Messenger : public ExceptionListener,
 
   private:
 
-    bool mailbox_locked_flag,clearing_mailbox_flag;
+    bool loopback_flag;
     unsigned int n_sent_messages,n_received_messages;
     Connection* connection_ptr;
     Session* session_ptr;
@@ -160,7 +163,7 @@ class Messenger : public ExceptionListener,
     std::string msg_sender_ID,cancelled_operation;
 //     std::vector<Property> general_string_properties;
 
-    std::vector<message> mailbox;
+    message_mailbox* mailbox_ptr;
     std::vector<message> curr_messages;
 
     void allocate_member_objects();
@@ -169,6 +172,10 @@ class Messenger : public ExceptionListener,
        std::string broker_URL,std::string topicName,bool useQueue);
     void print_sent_message_contents(TextMessage* textMessage_ptr);
     void print_sent_message_contents(const BytesMessage* BytesMessage_ptr);
+    void send_loopback_TextMessage(
+       std::string textMsg,
+       const std::vector<Property>& particular_string_properties,
+       bool print_msg_flag);
     void cleanup();
 };
 
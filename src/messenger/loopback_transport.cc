@@ -0,0 +1,122 @@
+// ==========================================================================
+// LOOPBACK_TRANSPORT class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <map>
+#include <mutex>
+#include "messenger/loopback_transport.h"
+#include "messenger/message_mailbox.h"
+
+using std::map;
+using std::mutex;
+using std::string;
+using std::vector;
+
+namespace
+{
+   struct subscription
+   {
+         message_mailbox* mailbox_ptr;
+         string ignored_producer_ID;
+   };
+
+// Subscriptions change rarely.  So a single mutex guards the topic
+// registry while messages themselves flow through lock-free
+// mailboxes:
+
+   mutex registry_mutex;
+   map<string,vector<subscription> > subscriptions_map;
+//   independent string var = topic name
+//   dependent var = subscribers to topic
+}
+
+// ---------------------------------------------------------------------
+void loopback_transport::subscribe(
+   string topic_name,message_mailbox* mailbox_ptr,
+   string ignored_producer_ID)
+{
+   std::lock_guard<mutex> registry_lock(registry_mutex);
+   subscription curr_subscription;
+   curr_subscription.mailbox_ptr=mailbox_ptr;
+   curr_subscription.ignored_producer_ID=ignored_producer_ID;
+   subscriptions_map[topic_name].push_back(curr_subscription);
+}
+
+// ---------------------------------------------------------------------
+void loopback_transport::unsubscribe(
+   string topic_name,message_mailbox* mailbox_ptr)
+{
+   std::lock_guard<mutex> registry_lock(registry_mutex);
+   map<string,vector<subscription> >::iterator iter=
+      subscriptions_map.find(topic_name);
+   if (iter==subscriptions_map.end()) return;
+
+   vector<subscription>& subscriptions=iter->second;
+   for (int s=int(subscriptions.size())-1; s>=0; s--)
+   {
+      if (subscriptions[s].mailbox_ptr != mailbox_ptr) continue;
+      subscriptions.erase(subscriptions.begin()+s);
+   }
+   if (subscriptions.size()==0) subscriptions_map.erase(iter);
+}
+
+// ---------------------------------------------------------------------
+// This overloaded version of unsubscribe() removes *mailbox_ptr from
+// all topics.
+
+void loopback_transport::unsubscribe(message_mailbox* mailbox_ptr)
+{
+   vector<string> topic_names;
+   {
+      std::lock_guard<mutex> registry_lock(registry_mutex);
+      for (map<string,vector<subscription> >::iterator iter=
+              subscriptions_map.begin(); iter != subscriptions_map.end();
+           iter++)
+      {
+         topic_names.push_back(iter->first);
+      }
+   }
+
+   for (unsigned int t=0; t<topic_names.size(); t++)
+   {
+      unsubscribe(topic_names[t],mailbox_ptr);
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function publish() returns the number of mailboxes which
+// accepted the input message.
+
+unsigned int loopback_transport::publish(
+   string topic_name,const string& text_message,const string& producer_ID,
+   const vector<Property>& properties)
+{
+   std::lock_guard<mutex> registry_lock(registry_mutex);
+   map<string,vector<subscription> >::iterator iter=
+      subscriptions_map.find(topic_name);
+   if (iter==subscriptions_map.end()) return 0;
+
+   unsigned int n_deliveries=0;
+   const vector<subscription>& subscriptions=iter->second;
+   for (unsigned int s=0; s<subscriptions.size(); s++)
+   {
+      const string& ignored_producer_ID=subscriptions[s].ignored_producer_ID;
+      if (ignored_producer_ID.size() > 0 && producer_ID==ignored_producer_ID)
+      {
+         continue;
+      }
+      if (subscriptions[s].mailbox_ptr->push(
+         text_message,producer_ID,properties)) n_deliveries++;
+   }
+   return n_deliveries;
+}
+
+// ---------------------------------------------------------------------
+// Broker URLs beginning with "loopback:" select in-process delivery.
+
+bool loopback_transport::is_loopback_URL(string broker_URL)
+{
+   return broker_URL.compare(0,9,"loopback:")==0;
+}
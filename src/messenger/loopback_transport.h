@@ -0,0 +1,50 @@
+// ==========================================================================
+// Header file for LOOPBACK_TRANSPORT class which delivers text
+// messages between Messengers living within the same process.  Every
+// message published on a topic is pushed into the mailbox of each
+// subscriber to that topic.  No ActiveMQ broker is involved.  So
+// message producers and consumers can be exercised from a single
+// executable.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef LOOPBACK_TRANSPORT_H
+#define LOOPBACK_TRANSPORT_H
+
+#include <string>
+#include <vector>
+#include "messenger/message.h"
+
+class message_mailbox;
+
+class loopback_transport
+{
+
+  public:
+
+   typedef message::Property Property;
+
+// Messages whose producer ID equals a subscription's non-empty
+// ignored_producer_ID are not delivered to that subscriber:
+
+   static void subscribe(
+      std::string topic_name,message_mailbox* mailbox_ptr,
+      std::string ignored_producer_ID="");
+   static void unsubscribe(
+      std::string topic_name,message_mailbox* mailbox_ptr);
+   static void unsubscribe(message_mailbox* mailbox_ptr);
+
+   static unsigned int publish(
+      std::string topic_name,const std::string& text_message,
+      const std::string& producer_ID,
+      const std::vector<Property>& properties);
+
+   static bool is_loopback_URL(std::string broker_URL);
+
+  private:
+
+   loopback_transport();
+};
+
+#endif  // loopback_transport.h
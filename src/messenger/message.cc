@@ -1,9 +1,10 @@
 // ==========================================================================
 // Message class member function definitions
 // ==========================================================================
-// Last modified on 5/30/08; 6/1/08; 6/9/08; 5/11/10
+// Last modified on 5/30/08; 6/1/08; 6/9/08; 5/11/10; 10/18/26
 // ==========================================================================
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include "messenger/message.h"
@@ -22,11 +23,17 @@ using std::vector;
 
 void message::allocate_member_objects()
 {
-   key_value_map_ptr=new std::map<std::string,std::string>;
 }		       
 
+// As of 10/18/26, *key_value_map_ptr is only allocated and filled
+// when some property value is first requested by key.  Messages
+// passing through mailboxes therefore no longer pay for STL map
+// construction upon every copy.
+
 void message::initialize_member_objects()
 {
+   key_value_map_valid_flag=false;
+   key_value_map_ptr=NULL;
 }
 
 message::message()
@@ -82,17 +89,7 @@ message::~message()
 // ---------------------------------------------------------------------
 void message::docopy(const message& m)
 {
-   text_message=m.text_message;
-   producer_ID=m.producer_ID;
-
-   properties.clear();
-   for (unsigned int p=0; p<m.get_n_properties(); p++)
-   {
-      Property P(m.get_property(p).first,m.get_property(p).second);
-      pushback_property(P);
-   }
-
-   extract_and_store_property_keys_and_values();
+   set_contents(m.text_message,m.producer_ID,m.properties);
 }
 
 // Overload = operator:
@@ -104,6 +101,33 @@ message& message::operator= (const message& m)
    return *this;
 }
 
+// ---------------------------------------------------------------------
+// Member function swap() exchanges contents with input message m
+// without copying any strings.
+
+void message::swap(message& m)
+{
+   text_message.swap(m.text_message);
+   producer_ID.swap(m.producer_ID);
+   properties.swap(m.properties);
+   std::swap(key_value_map_valid_flag,m.key_value_map_valid_flag);
+   std::swap(key_value_map_ptr,m.key_value_map_ptr);
+}
+
+// ---------------------------------------------------------------------
+// Member function set_contents() overwrites this message while
+// reusing its previously allocated string and property storage.
+
+void message::set_contents(
+   const string& text_message,const string& producer_ID,
+   const vector<Property>& props)
+{
+   this->text_message.assign(text_message);
+   this->producer_ID.assign(producer_ID);
+   properties.assign(props.begin(),props.end());
+   key_value_map_valid_flag=false;
+}
+
 // ---------------------------------------------------------------------
 // Overload << operator:
 
@@ -138,18 +162,37 @@ ostream& operator<< (ostream& outstream,const message& m)
 
 void message::extract_and_store_property_keys_and_values()
 {
+   if (key_value_map_ptr==NULL)
+   {
+      key_value_map_ptr=new std::map<std::string,std::string>;
+   }
+   
    key_value_map_ptr->clear();
    for (unsigned int n=0; n<get_n_properties(); n++)
    {
       (*key_value_map_ptr)[get_property(n).first]=get_property(n).second;
    }
+   key_value_map_valid_flag=true;
 }
 
 // ---------------------------------------------------------------------
-// Member function get_property_value
+// Member function get_property_value() searches *key_value_map_ptr if
+// it has already been filled.  Otherwise, the handful of properties
+// carried by a typical message are scanned directly.  Later
+// properties override earlier ones with the same key as within
+// extract_and_store_property_keys_and_values().
 
 string message::get_property_value(string property_key)
 {
+   if (!key_value_map_valid_flag)
+   {
+      for (int n=int(get_n_properties())-1; n>=0; n--)
+      {
+         if (properties[n].first==property_key) return properties[n].second;
+      }
+      return "";
+   }
+
    map<string,string>::iterator key_value_iter=
       key_value_map_ptr->find(property_key);
 
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for message class
 // ==========================================================================
-// Last modified on 3/6/08; 5/30/08; 6/1/08; 4/5/14
+// Last modified on 3/6/08; 5/30/08; 6/1/08; 4/5/14; 10/18/26
 // ==========================================================================
 
 #ifndef MESSAGE_H
@@ -33,12 +33,16 @@ class message
 
    virtual ~message();
    message& operator= (const message& p);
+   void swap(message& m);
    friend std::ostream& operator<< (std::ostream& outstream,const message& m);
 
 // Set and get member functions:
 
    std::string get_text_message() const;
    std::string get_producer_ID() const;
+   void set_contents(
+      const std::string& text_message,const std::string& producer_ID,
+      const std::vector<Property>& props);
 
    unsigned int get_n_properties() const;
    void pushback_property(const Property& P);
@@ -56,7 +60,11 @@ class message
    std::string text_message;
    std::string producer_ID;
    std::vector<Property> properties;
-   std::map<std::string,std::string>* key_value_map_ptr;
+
+// Key-value map is only built upon demand:
+
+   mutable bool key_value_map_valid_flag;
+   mutable std::map<std::string,std::string>* key_value_map_ptr;
 
    void allocate_member_objects();
    void initialize_member_objects();
@@ -85,6 +93,7 @@ inline unsigned int message::get_n_properties() const
 inline void message::pushback_property(const Property& P)
 {
    properties.push_back(P);
+   key_value_map_valid_flag=false;
 }
 
 inline message::Property message::get_property(int n) 
@@ -101,6 +110,11 @@ inline const message::Property message::get_property(int n)
 inline std::map<std::string,std::string>* message::get_key_value_map_ptr() 
    const
 {
+   if (!key_value_map_valid_flag) 
+   {
+      const_cast<message*>(this)->
+         extract_and_store_property_keys_and_values();
+   }
    return key_value_map_ptr;
 }
 
@@ -0,0 +1,157 @@
+// ==========================================================================
+// MESSAGE_MAILBOX class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <iostream>
+#include "messenger/message_mailbox.h"
+
+using std::cout;
+using std::endl;
+using std::memory_order_acquire;
+using std::memory_order_relaxed;
+using std::memory_order_release;
+using std::ostream;
+using std::string;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void message_mailbox::allocate_member_objects()
+{
+   slots=new mailbox_slot[capacity];
+}
+
+void message_mailbox::initialize_member_objects()
+{
+   index_mask=capacity-1;
+   for (unsigned int s=0; s<capacity; s++)
+   {
+      slots[s].sequence.store(s,memory_order_relaxed);
+   }
+   enqueue_posn.store(0,memory_order_relaxed);
+   dequeue_posn.store(0,memory_order_relaxed);
+   n_dropped_messages.store(0,memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------
+// Input capacity is rounded up to the next power of two so that slot
+// indices follow from bit masking.
+
+message_mailbox::message_mailbox(unsigned int capacity)
+{
+   this->capacity=2;
+   while (this->capacity < capacity)
+   {
+      this->capacity *= 2;
+   }
+
+   allocate_member_objects();
+   initialize_member_objects();
+}
+
+// ---------------------------------------------------------------------
+message_mailbox::~message_mailbox()
+{
+   delete [] slots;
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const message_mailbox& M)
+{
+   outstream << endl;
+   outstream << "capacity = " << M.get_capacity()
+             << " n_messages = " << M.get_n_messages()
+             << " n_dropped_messages = " << M.get_n_dropped_messages()
+             << endl;
+   return outstream;
+}
+
+// ==========================================================================
+// Producer member functions
+// ==========================================================================
+
+// Member function push() copies the input text and properties into
+// the next free slot.  If the mailbox is full, the message is counted
+// as dropped and this boolean method returns false.
+
+bool message_mailbox::push(
+   const string& text_message,const string& producer_ID,
+   const vector<Property>& properties)
+{
+   unsigned long posn=enqueue_posn.load(memory_order_relaxed);
+   mailbox_slot* slot_ptr=NULL;
+   while (true)
+   {
+      slot_ptr=&slots[posn & index_mask];
+      unsigned long sequence=slot_ptr->sequence.load(memory_order_acquire);
+      long difference=long(sequence)-long(posn);
+      if (difference==0)
+      {
+         if (enqueue_posn.compare_exchange_weak(
+            posn,posn+1,memory_order_relaxed)) break;
+      }
+      else if (difference < 0)
+      {
+         n_dropped_messages.fetch_add(1,memory_order_relaxed);
+         return false;
+      }
+      else
+      {
+         posn=enqueue_posn.load(memory_order_relaxed);
+      }
+   } // while loop
+
+   slot_ptr->curr_message.set_contents(text_message,producer_ID,properties);
+   slot_ptr->sequence.store(posn+1,memory_order_release);
+   return true;
+}
+
+// ==========================================================================
+// Consumer member functions
+// ==========================================================================
+
+// Member function drain() moves up to max_n_messages (or all if
+// max_n_messages==0) published messages into output STL vector
+// messages in their arrival order.  Entries already within messages
+// are recycled as empty slots, so repeated draining into the same
+// vector reuses string storage.  The number of drained messages is
+// returned.
+
+unsigned int message_mailbox::drain(
+   vector<message>& messages,unsigned int max_n_messages)
+{
+   unsigned long posn=dequeue_posn.load(memory_order_relaxed);
+   unsigned int n_drained=0;
+   while (max_n_messages==0 || n_drained < max_n_messages)
+   {
+      mailbox_slot& curr_slot=slots[posn & index_mask];
+      unsigned long sequence=curr_slot.sequence.load(memory_order_acquire);
+      if (sequence != posn+1) break;
+
+      if (n_drained >= messages.size()) messages.push_back(message());
+      messages[n_drained].swap(curr_slot.curr_message);
+      n_drained++;
+
+      curr_slot.sequence.store(posn+capacity,memory_order_release);
+      posn++;
+      dequeue_posn.store(posn,memory_order_relaxed);
+   } // while loop
+
+   messages.resize(n_drained);
+   return n_drained;
+}
+
+// ---------------------------------------------------------------------
+// Member function clear() discards all published messages.
+
+void message_mailbox::clear()
+{
+   vector<message> discarded_messages;
+   drain(discarded_messages);
+}
@@ -0,0 +1,106 @@
+// ==========================================================================
+// Header file for MESSAGE_MAILBOX class which holds a bounded,
+// lock-free queue of messages written by any number of producer
+// threads and read by a single consumer thread.  Message slots are
+// allocated once.  Producers overwrite slot contents in place, and
+// the consumer swaps whole batches of messages out of their slots.
+// So neither side allocates memory or waits upon the other in the
+// steady state.
+
+// Each slot carries a sequence number following D. Vyukov's bounded
+// queue.  A producer claims a slot by advancing the enqueue position
+// via compare-and-swap.  It then fills the slot and publishes it by
+// storing the next sequence number.  When all slots are occupied,
+// push() fails rather than blocks.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef MESSAGE_MAILBOX_H
+#define MESSAGE_MAILBOX_H
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "messenger/message.h"
+
+class message_mailbox
+{
+
+  public:
+
+   typedef message::Property Property;
+
+   message_mailbox(unsigned int capacity=16384);
+   ~message_mailbox();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const message_mailbox& M);
+
+// Set and get member functions:
+
+   unsigned int get_capacity() const;
+   unsigned int get_n_messages() const;
+   unsigned int get_n_dropped_messages() const;
+
+// Producer member functions (callable from any thread):
+
+   bool push(const std::string& text_message,const std::string& producer_ID,
+             const std::vector<Property>& properties);
+
+// Consumer member functions (callable from one thread at a time):
+
+   unsigned int drain(
+      std::vector<message>& messages,unsigned int max_n_messages=0);
+   void clear();
+
+  private:
+
+   struct mailbox_slot
+   {
+         std::atomic<unsigned long> sequence;
+         message curr_message;
+   };
+
+   unsigned int capacity;
+   unsigned long index_mask;
+   mailbox_slot* slots;
+   std::atomic<unsigned long> enqueue_posn,dequeue_posn;
+   std::atomic<unsigned int> n_dropped_messages;
+
+   void allocate_member_objects();
+   void initialize_member_objects();
+
+// Disallow copying since mailboxes own their slots array and hold
+// atomic queue positions:
+
+   message_mailbox(const message_mailbox& M);
+   message_mailbox& operator= (const message_mailbox& M);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+inline unsigned int message_mailbox::get_capacity() const
+{
+   return capacity;
+}
+
+// Member function get_n_messages() returns an instantaneous estimate
+// which may already be stale while producers are active:
+
+inline unsigned int message_mailbox::get_n_messages() const
+{
+   unsigned long n_enqueued=enqueue_posn.load(std::memory_order_relaxed);
+   unsigned long n_dequeued=dequeue_posn.load(std::memory_order_relaxed);
+   if (n_enqueued <= n_dequeued) return 0;
+   return n_enqueued-n_dequeued;
+}
+
+inline unsigned int message_mailbox::get_n_dropped_messages() const
+{
+   return n_dropped_messages.load(std::memory_order_relaxed);
+}
+
+#endif  // message_mailbox.h
@@ -4,7 +4,7 @@
 // ==========================================================================
 // FEATURESGROUP class member function definitions
 // ==========================================================================
-// Last modified on 6/19/14; 6/20/14; 6/21/14; 7/1/14
+// Last modified on 6/19/14; 6/20/14; 6/21/14; 7/1/14; 10/18/26
 // ==========================================================================
 
 #include <algorithm>
@@ -19,7 +19,7 @@
 #include "astro_geo/Clock.h"
 #include "datastructures/containerfuncs.h"
 #include "color/colorfuncs.h"
-#include "delaunay/Delaunay_tree.h"
+#include "delaunay/delaunay_triangulator.h"
 #include "astro_geo/Ellipsoid_model.h"
 #include "osg/osgFeatures/FeaturesGroup.h"
 #include "general/filefuncs.h"
@@ -35,6 +35,7 @@
 #include "osg/ModeController.h"
 #include "osg/osg2D/Movie.h"
 #include "numrec/nrfuncs.h"
+#include "general/numeric_text_reader.h"
 #include "general/outputfuncs.h"
 #include "geometry/parallelogram.h"
 #include "video/photogroup.h"
@@ -769,19 +770,18 @@ void FeaturesGroup::generate_features_map_for_photos(
       string features_filename=subdir+"features_2D_"+basename+".txt";
 //      cout << "p = " << p 
 //           << " features_filename = " << features_filename << endl;
-      filefunc::ReadInfile(features_filename);
+      numeric_text_reader features_reader(features_filename);
 
-      for (unsigned int i=0; i<filefunc::text_line.size(); i++)
+      for (unsigned int i=0; i<features_reader.get_n_rows(); i++)
       {
-         vector<double> columns=stringfunc::string_to_numbers(
-            filefunc::text_line[i]);
+         const double* columns=features_reader.get_row(i);
          int feature_ID=columns[1];
 //         int pass_number=columns[2]; // Pass number set by order of
 //         photos into PANORAMA rather than by photo order input for TIEPOINTS
          double U=columns[3];
          double V=columns[4];
          double feature_index=-1;
-         if (columns.size() >= 7)
+         if (features_reader.get_n_values(i) >= 7)
          {
             feature_index=columns[6];
          }
@@ -2670,8 +2670,18 @@ void FeaturesGroup::Delaunay_triangulate()
    
       triangles.clear();
 
-      Delaunay_tree DT(feature_ID,&feature_vertices);
-      triangles=DT.compute_triangles();
+      delaunay_triangulator triangulator(feature_vertices);
+      triangulator.triangulate();
+      triangles=triangulator.compute_triangles();
+
+// Convert triangle vertex indices into feature IDs:
+
+      for (unsigned int i=0; i<triangles.size(); i++)
+      {
+         triangles[i]=Triple<int,int,int>(
+            feature_ID[triangles[i].first],feature_ID[triangles[i].second],
+            feature_ID[triangles[i].third]);
+      }
 
       for (unsigned int i=0; i<triangles.size(); i++)
       {
@@ -1,7 +1,7 @@
 // ==========================================================================
 // OBSFRUSTUM class member function definitions
 // ==========================================================================
-// Last updated on 3/4/13; 3/12/13; 3/17/13; 4/5/14
+// Last updated on 3/4/13; 3/12/13; 3/17/13; 4/5/14; 10/18/26
 // ==========================================================================
 
 #include <set>
@@ -3080,37 +3080,14 @@ double OBSFRUSTUM::raytrace_occluded_ground_region(
    }
 //   cout << "ds = " << ds << endl;
 
-   cout << "Raytracing all candidate ground region points:" << endl;
-   for (unsigned int px=0; px<mdim; px++)
-   {
-      if (px%100==0) cout << px << " " << flush;
-      for (unsigned int py=0; py<ndim; py++)
-      {
+// As of Oct 2026, candidate ground region points are raytraced
+// in parallel by ray_tracer's tiled viewshed engine:
 
-// Check whether ground point lies inside OBSFRUSTUM's z-plane
-// trapezoid.  If not, don't perform expensive raytrace operation on it:
-            
-         if (nearly_equal(get_DTED_ptwoDarray_ptr()->get(px,py),
-                          interior_intensity_value))
-         {
-            int tracing_result=ray_tracer_ptr->trace_individual_ray(
-               px,py,apex,max_interior_Z,max_raytrace_range,ds,
-               DTED_ztwoDarray_ptr,reduced_DTED_ztwoDarray_ptr);
-
-            if (tracing_result==0)
-            {
-               n_total_rays++;
-               n_occluded_rays++;
-            }
-            else if (tracing_result==1)
-            {
-               n_total_rays++;
-            }
-         } // DTED_ptwoDarray(px,py)==interior_intensity_value conditional
-         
-      } // loop over py index
-   } // loop over px index
-   cout << endl;
+   cout << "Raytracing all candidate ground region points:" << endl;
+   ray_tracer_ptr->compute_viewshed(
+      apex,max_interior_Z,max_raytrace_range,ds,
+      DTED_ztwoDarray_ptr,reduced_DTED_ztwoDarray_ptr,
+      n_total_rays,n_occluded_rays);
 
 //   cout << "n_total_rays = " << n_total_rays << endl;
 //   cout << "n_occluded_rays = " << n_occluded_rays << endl;
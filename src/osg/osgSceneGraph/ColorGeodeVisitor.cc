@@ -1,7 +1,7 @@
 // ========================================================================
 // ColorGeodeVisitor class member function definitions
 // ========================================================================
-// Last updated on 2/5/11; 11/27/11; 12/2/11
+// Last updated on 2/5/11; 11/27/11; 12/2/11; 10/18/26
 // ========================================================================
 
 #include <osg/Geometry>
@@ -305,6 +305,50 @@ void ColorGeodeVisitor::color_geometry_vertices(
       unsigned int px,py;
       double longitude,latitude;
       twovector longlat;
+
+// If several ptwoDarrays have been loaded, vertices' eastings and
+// northings are converted to long,lat coordinates once every
+// counter_threshold vertices (see below).  Gather these sampled
+// vertices and convert them all within a single batch:
+
+      const int counter_threshold=10;
+      vector<double> sample_longitude,sample_latitude;
+      if (ptwoDarray_ptrs.size() > 2)
+      {
+         vector<double> sample_easting,sample_northing;
+         int sample_counter=p_counter;
+         for (unsigned int i=0; i<curr_vertices_ptr->size(); i++)
+         {
+            if (sample_counter==0)
+            {
+               sample_easting.push_back(
+                  curr_vertices_ptr->at(i).x()*LocalToWorld(0,0)
+                  +curr_vertices_ptr->at(i).y()*LocalToWorld(1,0)
+                  +curr_vertices_ptr->at(i).z()*LocalToWorld(2,0)
+                  +LocalToWorld(3,0));
+               sample_northing.push_back(
+                  curr_vertices_ptr->at(i).x()*LocalToWorld(0,1)
+                  +curr_vertices_ptr->at(i).y()*LocalToWorld(1,1)
+                  +curr_vertices_ptr->at(i).z()*LocalToWorld(2,1)
+                  +LocalToWorld(3,1));
+            }
+            sample_counter++;
+            if (sample_counter==counter_threshold) sample_counter=0;
+         }
+
+         unsigned int n_samples=sample_easting.size();
+         sample_longitude.resize(n_samples);
+         sample_latitude.resize(n_samples);
+         if (n_samples > 0)
+         {
+            latlongfunc::batch_UTMtoLL(
+               get_UTM_zone(),get_northern_hemisphere_flag(),
+               &sample_northing[0],&sample_easting[0],n_samples,
+               &sample_latitude[0],&sample_longitude[0]);
+         }
+      }
+      unsigned int sample_index=0;
+
       for (unsigned int i=0; i<curr_vertices_ptr->size(); i++)
       {
          double curr_x=curr_vertices_ptr->at(i).x()*LocalToWorld(0,0)
@@ -338,10 +382,9 @@ void ColorGeodeVisitor::color_geometry_vertices(
 // expensive.  Since vertices within a geometry are strongly
 // correlated, we can get away with performing this computation once
 // in a while and reusing the ptwoDarray ID multiple times.  Only
-// perform UTM to long,lat conversion when p_counter reaches some
-// counter threshold value.
+// look up the batch converted long,lat coordinates when p_counter
+// reaches some counter threshold value.
 
-         int counter_threshold=10;
 //         cout << "ptwoDarray_ptrs.size() = " 
 //              << ptwoDarray_ptrs.size() << endl;
          
@@ -363,9 +406,9 @@ void ColorGeodeVisitor::color_geometry_vertices(
 //            cout << "curr_x = " << curr_x << " curr_y = " << curr_y << endl;
             if (p_counter==0)
             {
-               latlongfunc::UTMtoLL(
-                  get_UTM_zone(),get_northern_hemisphere_flag(),
-                  curr_y,curr_x,latitude,longitude);
+               longitude=sample_longitude[sample_index];
+               latitude=sample_latitude[sample_index];
+               sample_index++;
                longlat=twovector(basic_math::mytruncate(longitude),
                                  basic_math::mytruncate(latitude));
 //            cout << "longitude = " << longitude 
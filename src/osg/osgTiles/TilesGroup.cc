@@ -1,13 +1,14 @@
 // ==========================================================================
 // TilesGroup class member function definitions
 // ==========================================================================
-// Last updated on 10/1/11; 10/2/11; 10/14/11
+// Last updated on 10/1/11; 10/2/11; 10/14/11; 10/18/26
 // ==========================================================================
 
 #include "osg/osgGraphicals/AnimationController.h"
 #include "image/compositefuncs.h"
 #include "geometry/geometry_funcs.h"
 #include "astro_geo/geopoint.h"
+#include "astro_geo/latlong2utmfuncs.h"
 #include "geometry/polygon.h"
 #include "image/raster_parser.h"
 #include "video/texture_rectangle.h"
@@ -307,23 +308,57 @@ TilesGroup::individual_latlong_tiles_intercepting_polygon(
 //            int n_steps=10;
             int n_steps=50;
 //            int n_steps=200;
+
+// Convert all edge subdivision points into UTM coordinates within a
+// single batch:
+
+            vector<threevector> edge_points;
+            vector<double> edge_longitude,edge_latitude;
+            for (int n=0; n<=n_steps; n++)
+            {
+               double frac=double(n)/n_steps;
+               edge_points.push_back((1-frac)*curr_corner+frac*next_corner);
+               edge_longitude.push_back(edge_points.back().get(0));
+               edge_latitude.push_back(edge_points.back().get(1));
+            }
+
+// As in geopoint::recompute_UTM_coords(), a negative specified zone
+// number means each point's own UTM zone is used:
+
+            vector<double> edge_easting(n_steps+1),edge_northing(n_steps+1);
+            if (specified_UTM_zonenumber >= 0)
+            {
+               bool specified_northern_hemisphere_flag=true;
+               latlongfunc::batch_LL_to_northing_easting(
+                  &edge_longitude[0],&edge_latitude[0],n_steps+1,
+                  specified_northern_hemisphere_flag,specified_UTM_zonenumber,
+                  &edge_easting[0],&edge_northing[0],23,1);
+            }
+            else
+            {
+               vector<int> edge_zonenumber(n_steps+1);
+               bool* edge_northern_hemisphere_flag=new bool[n_steps+1];
+               latlongfunc::batch_LLtoUTM(
+                  &edge_latitude[0],&edge_longitude[0],n_steps+1,
+                  &edge_zonenumber[0],edge_northern_hemisphere_flag,
+                  &edge_northing[0],&edge_easting[0],23,1);
+               delete [] edge_northern_hemisphere_flag;
+            }
+
             for (int n=0; n<=n_steps && 
                     !include_long_lat_coords_into_list_flag; n++)
             {
-               double frac=double(n)/n_steps;
-               threevector curr_point=(1-frac)*curr_corner+frac*next_corner;
-               geopoint curr_geopoint(
-                  curr_point.get(0),curr_point.get(1),
-                  curr_point.get(2),specified_UTM_zonenumber);
+               const threevector& curr_point=edge_points[n];
+               threevector curr_UTM_posn(
+                  edge_easting[n],edge_northing[n],curr_point.get(2));
 
 // Test whether curr_point lies within max_range of apex.  If so,
 // check whether it also lies inside the polygon defined by the input
 // vertices.  If so, include the current long-lat coordinates into the
 // list:
 
-               double sqrd_range=(curr_geopoint.get_UTM_posn()-apex).
-                  sqrd_magnitude();
-//               cout << "curr_geopoint = " << curr_geopoint
+               double sqrd_range=(curr_UTM_posn-apex).sqrd_magnitude();
+//               cout << "curr_UTM_posn = " << curr_UTM_posn
 //                    << " apex = " << apex << endl;
 
 //               double ratio=sqrt(sqrd_range/sqr(max_range));
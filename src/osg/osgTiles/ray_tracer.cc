@@ -1,7 +1,7 @@
 // ==========================================================================
 // RAY_TRACER class member function definitions
 // ==========================================================================
-// Last modified on 7/2/11; 7/3/11; 7/9/11
+// Last modified on 7/2/11; 7/3/11; 7/9/11; 10/18/26
 // ==========================================================================
 
 #include <iostream>
@@ -747,4 +747,188 @@ void ray_tracer::ground_target_line_integrals(
 
 }
 
+// ==========================================================================
+// Viewshed member functions
+// ==========================================================================
+
+// Member function compute_viewshed() raytraces every pixel within
+// *DTED_ptwoDarray_ptr which is marked with interior_intensity_value
+// back to the sensor located at apex.  Upon return, visible pixels
+// hold 1 and occluded pixels hold a small positive value exactly as
+// if trace_individual_ray(px,py,...) had been called on each of them.
+
+// Unlike that stateful method which carries prev_i_start and
+// prev_i_stop between successive calls, each ray traced here is
+// independent of all others.  So the DTED tile is broken into
+// tile_size x tile_size blocks which are distributed across OpenMP
+// worker threads.  Every pixel belongs to exactly one block, so no
+// two threads ever write to the same twoDarray entry.
+
+void ray_tracer::compute_viewshed(
+   const threevector& apex,double max_ground_Z,double max_raytrace_range,
+   double ds,twoDarray* DTED_ztwoDarray_ptr,
+   twoDarray* reduced_DTED_ztwoDarray_ptr,
+   int& n_total_rays,int& n_occluded_rays,unsigned int tile_size)
+{
+   twoDarray* ptwoDarray_ptr=get_DTED_ptwoDarray_ptr();
+   unsigned int mdim=ptwoDarray_ptr->get_mdim();
+   unsigned int ndim=ptwoDarray_ptr->get_ndim();
+   if (tile_size==0) tile_size=1;
+
+   unsigned int n_xtiles=(mdim+tile_size-1)/tile_size;
+   unsigned int n_ytiles=(ndim+tile_size-1)/tile_size;
+   int n_tiles=n_xtiles*n_ytiles;
+
+// TilesGroup is not thread-safe.  So extract its reduction scale
+// factor once before any worker threads start:
+
+   int scale_factor=TilesGroup_ptr->get_terrain_reduction_scale_factor();
+
+   int n_total=0,n_occluded=0;
+
+#pragma omp parallel for schedule(dynamic) reduction(+:n_total,n_occluded)
+   for (int t=0; t<n_tiles; t++)
+   {
+      unsigned int px_start=(t%n_xtiles)*tile_size;
+      unsigned int py_start=(t/n_xtiles)*tile_size;
+      unsigned int px_stop=basic_math::min(px_start+tile_size,mdim);
+      unsigned int py_stop=basic_math::min(py_start+tile_size,ndim);
+
+      for (unsigned int px=px_start; px<px_stop; px++)
+      {
+         for (unsigned int py=py_start; py<py_stop; py++)
+         {
+            if (!nearly_equal(ptwoDarray_ptr->get(px,py),
+                              interior_intensity_value)) continue;
+
+            int tracing_result=trace_viewshed_ray(
+               px,py,apex,max_ground_Z,max_raytrace_range,ds,scale_factor,
+               DTED_ztwoDarray_ptr,reduced_DTED_ztwoDarray_ptr);
+            if (tracing_result==0)
+            {
+               n_total++;
+               n_occluded++;
+            }
+            else if (tracing_result==1)
+            {
+               n_total++;
+            }
+         } // loop over py index
+      } // loop over px index
+   } // loop over index t labeling tiles
+
+   n_total_rays += n_total;
+   n_occluded_rays += n_occluded;
+}
+
+// ---------------------------------------------------------------------
+// Private member function trace_viewshed_ray() is a stateless
+// counterpart to the first trace_individual_ray() method.  It
+// follows the same coarse march through the reduced DTED map and
+// the same fine march through the full resolution map.  
+
+// Whenever the sensor lies above the ground point, ray heights
+// increase monotonically towards the apex.  So once the ray rises
+// above max_ground_Z, no later sample can be occluded and the march
+// terminates early.
+
+int ray_tracer::trace_viewshed_ray(
+   int px,int py,const threevector& apex,double max_ground_Z,
+   double max_raytrace_range,double ds,int scale_factor,
+   const twoDarray* DTED_ztwoDarray_ptr,
+   const twoDarray* reduced_DTED_ztwoDarray_ptr) const
+{
+   DTED_ptwoDarray_ptr->put(px,py,1);
+
+   threevector ground_point;
+   DTED_ztwoDarray_ptr->pixel_to_threevector(px,py,ground_point);
+
+   double length=(apex-ground_point).magnitude();
+   if (length > max_raytrace_range) return -1;
+
+   threevector e_hat( (apex-ground_point).unitvector() );
+   double d_length = ds/sqrt(1-sqr(e_hat.get(2)));
+   threevector d_length_e_hat(d_length*e_hat);
+   int n_steps=static_cast<int>(length/d_length);
+   bool ascending_ray_flag=(e_hat.get(2) >= 0);
+
+   const double SMALL_POSITIVE=0.001;
+   int i_min=4;
+   double min_dist_from_ground_point=3;		// meters	
+   if (i_min*d_length < min_dist_from_ground_point)
+   {
+      i_min=min_dist_from_ground_point/d_length;
+   }
+
+   threevector curr_ray_posn=ground_point+i_min*d_length_e_hat;
+   double x=curr_ray_posn.get(0);
+   double y=curr_ray_posn.get(1);
+   double z=curr_ray_posn.get(2);
+
+// Coarse march through reduced DTED map:
 
+   threevector scaled_d_length_e_hat(scale_factor*d_length_e_hat);
+
+   bool ray_occluded_flag=false;
+   for (int i=scale_factor+i_min; i<n_steps; i += scale_factor)
+   {
+      if (z > max_ground_Z)
+      {
+         if (ascending_ray_flag) return 1;
+      }
+      else if (ground_occludes_ray(x,y,z,reduced_DTED_ztwoDarray_ptr))
+      {
+         ray_occluded_flag=true;
+         break;
+      }
+
+      x += scaled_d_length_e_hat.get(0);
+      y += scaled_d_length_e_hat.get(1);
+      z += scaled_d_length_e_hat.get(2);
+   } // loop over index i labeling steps along ray
+
+   if (!ray_occluded_flag) return 1;
+
+// Fine march through full resolution DTED map:
+
+   curr_ray_posn=threevector(x,y,z);
+   int i_start=basic_math::round(
+      (curr_ray_posn-ground_point).magnitude()/d_length);
+
+   for (int i=i_start; i<n_steps; i++)
+   {
+      if (z > max_ground_Z)
+      {
+         if (ascending_ray_flag) return 1;
+      }
+      else if (ground_occludes_ray(x,y,z,DTED_ztwoDarray_ptr))
+      {
+         DTED_ptwoDarray_ptr->put(px,py,SMALL_POSITIVE);
+         return 0;
+      }
+
+      x += d_length_e_hat.get(0);
+      y += d_length_e_hat.get(1);
+      z += d_length_e_hat.get(2);
+   } // loop over index i labeling steps along ray
+
+   return 1;
+}
+
+// ---------------------------------------------------------------------
+// Private member function ground_occludes_ray() returns true if the
+// current ray sample lies below the terrain height stored in
+// *DTED_ztwoDarray_ptr.  Unlike evaluate_segment_height(), it
+// modifies no member variables and may be called concurrently.
+
+bool ray_tracer::ground_occludes_ray(
+   double curr_ray_x,double curr_ray_y,double curr_ray_z,
+   const twoDarray* DTED_ztwoDarray_ptr) const
+{
+   unsigned int px,py;
+   if (!DTED_ztwoDarray_ptr->point_to_pixel(curr_ray_x,curr_ray_y,px,py))
+   {
+      return false;
+   }
+   return (curr_ray_z < DTED_ztwoDarray_ptr->get(px,py));
+}
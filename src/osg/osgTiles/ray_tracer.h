@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for RAYTRACINGFUNCS namespace
 // ==========================================================================
-// Last modified on 7/1/11; 7/2/11; 7/9/11
+// Last modified on 7/1/11; 7/2/11; 7/9/11; 10/18/26
 // ==========================================================================
 
 #ifndef RAY_TRACER_H
@@ -64,6 +64,14 @@ class ray_tracer
    void ground_target_line_integrals(
       const threevector& apex,double max_radius,double ds);
 
+// Viewshed member functions:
+
+   void compute_viewshed(
+      const threevector& apex,double max_ground_Z,double max_raytrace_range,
+      double ds,twoDarray* DTED_ztwoDarray_ptr,
+      twoDarray* reduced_DTED_ztwoDarray_ptr,
+      int& n_total_rays,int& n_occluded_rays,unsigned int tile_size=64);
+
   private:
 
    int prev_i_start,prev_i_stop;
@@ -81,6 +89,15 @@ class ray_tracer
       int i,int i_window,double curr_ray_x,double curr_ray_y,double curr_ray_z,
       double curr_max_ground_Z);
 
+   int trace_viewshed_ray(
+      int px,int py,const threevector& apex,double max_ground_Z,
+      double max_raytrace_range,double ds,int scale_factor,
+      const twoDarray* DTED_ztwoDarray_ptr,
+      const twoDarray* reduced_DTED_ztwoDarray_ptr) const;
+   bool ground_occludes_ray(
+      double curr_ray_x,double curr_ray_y,double curr_ray_z,
+      const twoDarray* DTED_ztwoDarray_ptr) const;
+
    void allocate_member_objects();
    void initialize_member_objects();
 };
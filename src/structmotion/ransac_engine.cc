@@ -0,0 +1,784 @@
+// ==========================================================================
+// RANSAC_ENGINE class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include "structmotion/ransac_engine.h"
+#include "math/twovector.h"
+
+using std::cout;
+using std::endl;
+using std::ostream;
+using std::vector;
+
+// ==========================================================================
+// Stack-allocated linear algebra helpers
+// ==========================================================================
+
+namespace
+{
+
+// Hartley normalization translates sampled points so that their
+// centroid lies at the origin and scales them so that their average
+// distance from the origin equals sqrt(2):
+
+   bool normalize_sample(
+      const double* X,const double* Y,const int* sample_indices,
+      int n_points,double* x,double* y,
+      double& center_x,double& center_y,double& scale)
+   {
+      center_x=center_y=0;
+      for (int i=0; i<n_points; i++)
+      {
+         center_x += X[sample_indices[i]];
+         center_y += Y[sample_indices[i]];
+      }
+      center_x /= n_points;
+      center_y /= n_points;
+
+      double mean_dist=0;
+      for (int i=0; i<n_points; i++)
+      {
+         x[i]=X[sample_indices[i]]-center_x;
+         y[i]=Y[sample_indices[i]]-center_y;
+         mean_dist += sqrt(x[i]*x[i]+y[i]*y[i]);
+      }
+      mean_dist /= n_points;
+      if (mean_dist < 1E-12) return false;
+
+      scale=sqrt(2.0)/mean_dist;
+      for (int i=0; i<n_points; i++)
+      {
+         x[i] *= scale;
+         y[i] *= scale;
+      }
+      return true;
+   }
+
+// Method compute_null_space() takes in an n_rows x 9 matrix A with
+// n_rows < 9.  It performs a Householder QR decomposition of A^T and
+// returns the last 9-n_rows columns of Q which form an orthonormal
+// basis for the right null space of A.  A is overwritten.  If A is
+// numerically rank deficient, this method returns false.
+
+   bool compute_null_space(
+      double A[][9],int n_rows,double null_vectors[][9])
+   {
+      double v[8][9],beta[8];
+      double min_diag=std::numeric_limits<double>::max();
+      double max_diag=0;
+
+// Row k of A holds column k of A^T:
+
+      for (int k=0; k<n_rows; k++)
+      {
+         double norm=0;
+         for (int i=k; i<9; i++)
+         {
+            norm += A[k][i]*A[k][i];
+         }
+         norm=sqrt(norm);
+         double alpha=(A[k][k] > 0) ? -norm : norm;
+
+         double v_sqrd_norm=0;
+         for (int i=0; i<9; i++)
+         {
+            v[k][i]=(i < k) ? 0 : A[k][i];
+         }
+         v[k][k] -= alpha;
+         for (int i=k; i<9; i++)
+         {
+            v_sqrd_norm += v[k][i]*v[k][i];
+         }
+         beta[k]=(v_sqrd_norm > 0) ? 2/v_sqrd_norm : 0;
+
+         if (norm < min_diag) min_diag=norm;
+         if (norm > max_diag) max_diag=norm;
+
+         for (int j=k+1; j<n_rows; j++)
+         {
+            double dotproduct=0;
+            for (int i=k; i<9; i++)
+            {
+               dotproduct += v[k][i]*A[j][i];
+            }
+            dotproduct *= beta[k];
+            for (int i=k; i<9; i++)
+            {
+               A[j][i] -= dotproduct*v[k][i];
+            }
+         }
+      } // loop over index k labeling Householder reflections
+
+      if (max_diag <= 0 || min_diag < 1E-10*max_diag) return false;
+
+// Null vector c equals H_0 H_1 ... H_{n_rows-1} e_{n_rows+c}:
+
+      for (int c=0; c<9-n_rows; c++)
+      {
+         double* q=null_vectors[c];
+         for (int i=0; i<9; i++)
+         {
+            q[i]=0;
+         }
+         q[n_rows+c]=1;
+
+         for (int k=n_rows-1; k>=0; k--)
+         {
+            double dotproduct=0;
+            for (int i=k; i<9; i++)
+            {
+               dotproduct += v[k][i]*q[i];
+            }
+            dotproduct *= beta[k];
+            for (int i=k; i<9; i++)
+            {
+               q[i] -= dotproduct*v[k][i];
+            }
+         }
+      } // loop over index c labeling null vectors
+      return true;
+   }
+
+// Method solve_cubic() returns the number of real roots of
+// a3 t**3 + a2 t**2 + a1 t + a0 = 0.  Degenerate quadratic and linear
+// polynomials are also handled.
+
+   int solve_cubic(double a3,double a2,double a1,double a0,double roots[3])
+   {
+      double max_coeff=fabs(a3);
+      if (fabs(a2) > max_coeff) max_coeff=fabs(a2);
+      if (fabs(a1) > max_coeff) max_coeff=fabs(a1);
+      if (fabs(a0) > max_coeff) max_coeff=fabs(a0);
+      if (max_coeff <= 0) return 0;
+      const double TINY=1E-12*max_coeff;
+
+      if (fabs(a3) < TINY)
+      {
+         if (fabs(a2) < TINY)
+         {
+            if (fabs(a1) < TINY) return 0;
+            roots[0]=-a0/a1;
+            return 1;
+         }
+         double discriminant=a1*a1-4*a2*a0;
+         if (discriminant < 0) return 0;
+         double sqrt_disc=sqrt(discriminant);
+         double q=-0.5*(a1+((a1 >= 0) ? sqrt_disc : -sqrt_disc));
+         roots[0]=q/a2;
+         if (q==0) return 1;
+         roots[1]=a0/q;
+         return 2;
+      }
+
+// See section 5.6 of Numerical Recipes:
+
+      double b=a2/a3;
+      double c=a1/a3;
+      double d=a0/a3;
+      double Q=(b*b-3*c)/9;
+      double R=(2*b*b*b-9*b*c+27*d)/54;
+      double Q3=Q*Q*Q;
+
+      if (R*R < Q3)
+      {
+         double theta=acos(R/sqrt(Q3));
+         double two_sqrt_Q=-2*sqrt(Q);
+         roots[0]=two_sqrt_Q*cos(theta/3)-b/3;
+         roots[1]=two_sqrt_Q*cos((theta+2*M_PI)/3)-b/3;
+         roots[2]=two_sqrt_Q*cos((theta-2*M_PI)/3)-b/3;
+         return 3;
+      }
+
+      double A=-cbrt(fabs(R)+sqrt(R*R-Q3));
+      if (R < 0) A=-A;
+      double B=(A==0) ? 0 : Q/A;
+      roots[0]=(A+B)-b/3;
+      return 1;
+   }
+
+   double determinant_3x3(const double M[9])
+   {
+      return M[0]*(M[4]*M[8]-M[5]*M[7])
+         -M[1]*(M[3]*M[8]-M[5]*M[6])
+         +M[2]*(M[3]*M[7]-M[4]*M[6]);
+   }
+
+// Method multiply_3x3() returns C = A^T B if transpose_A_flag==true or
+// C = A B otherwise:
+
+   void multiply_3x3(
+      const double A[9],const double B[9],bool transpose_A_flag,
+      double C[9])
+   {
+      for (int i=0; i<3; i++)
+      {
+         for (int j=0; j<3; j++)
+         {
+            double sum=0;
+            for (int k=0; k<3; k++)
+            {
+               double a=transpose_A_flag ? A[3*k+i] : A[3*i+k];
+               sum += a*B[3*k+j];
+            }
+            C[3*i+j]=sum;
+         }
+      }
+   }
+
+   bool normalize_frobenius(double M[9])
+   {
+      double sqrd_norm=0;
+      for (int i=0; i<9; i++)
+      {
+         sqrd_norm += M[i]*M[i];
+      }
+      if (!(sqrd_norm > 0)) return false;
+      double inverse_norm=1/sqrt(sqrd_norm);
+      for (int i=0; i<9; i++)
+      {
+         M[i] *= inverse_norm;
+      }
+      return true;
+   }
+
+} // anonymous namespace
+
+// ==========================================================================
+// Minimal sample model member functions
+// ==========================================================================
+
+ransac_model::~ransac_model()
+{
+}
+
+// ---------------------------------------------------------------------
+unsigned int fundamental_ransac_model::get_sample_size() const
+{
+   return 7;
+}
+
+// ---------------------------------------------------------------------
+// Member function fit_minimal_sample() implements the seven-point
+// algorithm with the same Hartley normalization and (X,Y) <--> (U,V)
+// conventions as fundamental::seven_point_algorithm().  The 2D null
+// space F1, F2 of the 7x9 constraint matrix is found via QR rather
+// than SVD.  Each real root alpha of det(alpha F1 + (1-alpha) F2) = 0
+// yields one rank-2 candidate.
+
+unsigned int fundamental_ransac_model::fit_minimal_sample(
+   const double* X,const double* Y,const double* U,const double* V,
+   const int* sample_indices,model_matrix models[]) const
+{
+   double x[7],y[7],u[7],v[7];
+   double cx,cy,s_XY,cu,cv,s_UV;
+   if (!normalize_sample(X,Y,sample_indices,7,x,y,cx,cy,s_XY)) return 0;
+   if (!normalize_sample(U,V,sample_indices,7,u,v,cu,cv,s_UV)) return 0;
+
+   double A[7][9];
+   for (int i=0; i<7; i++)
+   {
+      A[i][0]=x[i]*u[i];
+      A[i][1]=x[i]*v[i];
+      A[i][2]=x[i];
+      A[i][3]=y[i]*u[i];
+      A[i][4]=y[i]*v[i];
+      A[i][5]=y[i];
+      A[i][6]=u[i];
+      A[i][7]=v[i];
+      A[i][8]=1;
+   }
+
+   double F12[2][9];
+   if (!compute_null_space(A,7,F12)) return 0;
+
+// det(F2 + alpha (F1-F2)) is a cubic polynomial in alpha whose
+// coefficients follow from its values at alpha = -1, 0, 1 and 2:
+
+   double p[4];
+   for (int a=0; a<4; a++)
+   {
+      double alpha=a-1;
+      double M[9];
+      for (int i=0; i<9; i++)
+      {
+         M[i]=F12[1][i]+alpha*(F12[0][i]-F12[1][i]);
+      }
+      p[a]=determinant_3x3(M);
+   }
+   double c0=p[1];
+   double c2=0.5*(p[2]+p[0])-c0;
+   double c1_plus_c3=0.5*(p[2]-p[0]);
+   double c3=(0.5*(p[3]-c0-4*c2)-c1_plus_c3)/3;
+   double c1=c1_plus_c3-c3;
+
+   double roots[3];
+   int n_roots=solve_cubic(c3,c2,c1,c0,roots);
+
+// Undo Hartley normalizations: F = T_XY^T Fnorm T_UV
+
+   const double T_XY[9]={s_XY,0,-s_XY*cx, 0,s_XY,-s_XY*cy, 0,0,1};
+   const double T_UV[9]={s_UV,0,-s_UV*cu, 0,s_UV,-s_UV*cv, 0,0,1};
+
+   unsigned int n_models=0;
+   for (int r=0; r<n_roots; r++)
+   {
+      double Fnorm[9],product[9];
+      for (int i=0; i<9; i++)
+      {
+         Fnorm[i]=F12[1][i]+roots[r]*(F12[0][i]-F12[1][i]);
+      }
+      multiply_3x3(Fnorm,T_UV,false,product);
+      multiply_3x3(T_XY,product,true,models[n_models]);
+      if (normalize_frobenius(models[n_models])) n_models++;
+   }
+   return n_models;
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_errors() evaluates the same Sampson error
+// as fundamental::sampson_error() over a contiguous batch of
+// tiepoints.  The loop carries no dependencies so that it vectorizes.
+
+void fundamental_ransac_model::compute_errors(
+   const model_matrix& F,
+   const double* X,const double* Y,const double* U,const double* V,
+   int first,int n_points,double* errors) const
+{
+   const double F00=F[0],F01=F[1],F02=F[2];
+   const double F10=F[3],F11=F[4],F12=F[5];
+   const double F20=F[6],F21=F[7],F22=F[8];
+   const double* x=X+first;
+   const double* y=Y+first;
+   const double* u=U+first;
+   const double* v=V+first;
+
+#pragma omp simd
+   for (int i=0; i<n_points; i++)
+   {
+      double XY_new_0=x[i]*F00+y[i]*F10+F20;
+      double XY_new_1=x[i]*F01+y[i]*F11+F21;
+      double UV_new_0=F00*u[i]+F01*v[i]+F02;
+      double UV_new_1=F10*u[i]+F11*v[i]+F12;
+      double UV_new_2=F20*u[i]+F21*v[i]+F22;
+      double residual=x[i]*UV_new_0+y[i]*UV_new_1+UV_new_2;
+      errors[i]=residual*residual/(
+         XY_new_0*XY_new_0+XY_new_1*XY_new_1+
+         UV_new_0*UV_new_0+UV_new_1*UV_new_1);
+   }
+}
+
+// ---------------------------------------------------------------------
+unsigned int homography_ransac_model::get_sample_size() const
+{
+   return 4;
+}
+
+// ---------------------------------------------------------------------
+// Member function fit_minimal_sample() implements the normalized
+// four-point direct linear transformation.
+
+unsigned int homography_ransac_model::fit_minimal_sample(
+   const double* X,const double* Y,const double* U,const double* V,
+   const int* sample_indices,model_matrix models[]) const
+{
+   double x[4],y[4],u[4],v[4];
+   double cx,cy,s_XY,cu,cv,s_UV;
+   if (!normalize_sample(X,Y,sample_indices,4,x,y,cx,cy,s_XY)) return 0;
+   if (!normalize_sample(U,V,sample_indices,4,u,v,cu,cv,s_UV)) return 0;
+
+   double A[8][9];
+   for (int i=0; i<4; i++)
+   {
+      double* row=A[2*i];
+      row[0]=-x[i];
+      row[1]=-y[i];
+      row[2]=-1;
+      row[3]=row[4]=row[5]=0;
+      row[6]=u[i]*x[i];
+      row[7]=u[i]*y[i];
+      row[8]=u[i];
+
+      row=A[2*i+1];
+      row[0]=row[1]=row[2]=0;
+      row[3]=-x[i];
+      row[4]=-y[i];
+      row[5]=-1;
+      row[6]=v[i]*x[i];
+      row[7]=v[i]*y[i];
+      row[8]=v[i];
+   }
+
+   double Hnorm[1][9];
+   if (!compute_null_space(A,8,Hnorm)) return 0;
+
+// Undo Hartley normalizations: H = T_UV^-1 Hnorm T_XY
+
+   const double T_XY[9]={s_XY,0,-s_XY*cx, 0,s_XY,-s_XY*cy, 0,0,1};
+   const double T_UV_inverse[9]={1/s_UV,0,cu, 0,1/s_UV,cv, 0,0,1};
+
+   double product[9];
+   multiply_3x3(Hnorm[0],T_XY,false,product);
+   multiply_3x3(T_UV_inverse,product,false,models[0]);
+   if (!normalize_frobenius(models[0])) return 0;
+   return 1;
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_errors() returns squared distances between
+// (U,V) and the projection of (X,Y) by H.  As within
+// sift_detector::identify_inliers_via_homography(), residuals are
+// compared against squared distance thresholds.
+
+void homography_ransac_model::compute_errors(
+   const model_matrix& H,
+   const double* X,const double* Y,const double* U,const double* V,
+   int first,int n_points,double* errors) const
+{
+   const double H00=H[0],H01=H[1],H02=H[2];
+   const double H10=H[3],H11=H[4],H12=H[5];
+   const double H20=H[6],H21=H[7],H22=H[8];
+   const double* x=X+first;
+   const double* y=Y+first;
+   const double* u=U+first;
+   const double* v=V+first;
+
+#pragma omp simd
+   for (int i=0; i<n_points; i++)
+   {
+      double w_inverse=1/(H20*x[i]+H21*y[i]+H22);
+      double du=(H00*x[i]+H01*y[i]+H02)*w_inverse-u[i];
+      double dv=(H10*x[i]+H11*y[i]+H12)*w_inverse-v[i];
+      errors[i]=du*du+dv*dv;
+   }
+}
+
+// ==========================================================================
+// RANSAC engine member functions
+// ==========================================================================
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void ransac_engine::allocate_member_objects()
+{
+}
+
+void ransac_engine::initialize_member_objects()
+{
+   PROSAC_flag=true;
+   max_n_iters=10000;
+   preverification_size=1;
+   confidence=0.99;
+   n_iters=n_rejected_hypotheses=n_inliers=0;
+   min_cost=std::numeric_limits<double>::max();
+   for (unsigned int i=0; i<9; i++)
+   {
+      best_model[i]=0;
+   }
+   generator.seed(1);
+}
+
+// ---------------------------------------------------------------------
+ransac_engine::ransac_engine(const ransac_model* model_ptr)
+{
+   allocate_member_objects();
+   initialize_member_objects();
+   this->model_ptr=model_ptr;
+}
+
+// ---------------------------------------------------------------------
+ransac_engine::~ransac_engine()
+{
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const ransac_engine& R)
+{
+   outstream << endl;
+   outstream << "n_points = " << R.get_n_points()
+             << " n_iters = " << R.n_iters
+             << " n_rejected_hypotheses = " << R.n_rejected_hypotheses
+             << endl;
+   outstream << "n_inliers = " << R.n_inliers
+             << " min_cost = " << R.min_cost << endl;
+   return outstream;
+}
+
+// ==========================================================================
+// Estimation member functions
+// ==========================================================================
+
+// Member function set_tiepoints() copies tiepoint coordinates into
+// separate contiguous arrays.  For PROSAC sampling, tiepoints should
+// be sorted so that the most reliable matches come first.
+
+void ransac_engine::set_tiepoints(
+   const vector<twovector>& XY,const vector<twovector>& UV)
+{
+   unsigned int n_points=XY.size();
+   if (UV.size() < n_points) n_points=UV.size();
+
+   X.resize(n_points);
+   Y.resize(n_points);
+   U.resize(n_points);
+   V.resize(n_points);
+   for (unsigned int i=0; i<n_points; i++)
+   {
+      X[i]=XY[i].get(0);
+      Y[i]=XY[i].get(1);
+      U[i]=UV[i].get(0);
+      V[i]=UV[i].get(1);
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function estimate() searches for the model minimizing the
+// truncated quadratic MSAC cost
+
+//	sum_i  min(e_i, max_error)**2
+
+// where e_i denotes the model's residual for tiepoint i.  As in
+// "Matching with PROSAC - progressive sample consensus" by Chum and
+// Matas (2005), the t-th hypothesis is drawn from the top n(t)
+// tiepoints where n(t) grows according to the PROSAC growth function.
+// Once n(t) reaches all tiepoints, sampling becomes uniform.
+
+// Hypotheses which fail T(d,d) preverification are discarded without
+// being scored.  Since an uncontaminated model passes the test with
+// probability w**d where w denotes the inlier fraction, the required
+// number of iterations becomes log(1-confidence) / log(1-w**(m+d))
+// for sample size m.  If no model with at least one sample's worth of
+// inliers is found, this boolean method returns false.
+
+bool ransac_engine::estimate(double max_error)
+{
+   n_iters=n_rejected_hypotheses=n_inliers=0;
+   min_cost=std::numeric_limits<double>::max();
+   inlier_indices.clear();
+
+   const unsigned int n_points=X.size();
+   const unsigned int sample_size=model_ptr->get_sample_size();
+   if (n_points < sample_size || sample_size > 16)
+   {
+      return false;
+   }
+
+   int sample_indices[16];
+   ransac_model::model_matrix models[ransac_model::max_n_models];
+
+// Initialize PROSAC growth function with T_N = 200000 as suggested by
+// Chum and Matas:
+
+   const double T_N=200000;
+   unsigned int subset_size=sample_size;
+   double T_n=T_N;
+   for (unsigned int i=0; i<sample_size; i++)
+   {
+      T_n *= double(subset_size-i)/double(n_points-i);
+   }
+   double T_n_prime=1;
+
+   bool model_found_flag=false;
+   unsigned int required_n_iters=max_n_iters;
+   while (n_iters < required_n_iters)
+   {
+      n_iters++;
+
+      bool include_last_flag=false;
+      if (PROSAC_flag)
+      {
+         while (n_iters > T_n_prime && subset_size < n_points)
+         {
+            subset_size++;
+            double T_next=T_n*subset_size/(subset_size-sample_size);
+            T_n_prime += ceil(T_next-T_n);
+            T_n=T_next;
+         }
+         include_last_flag=(n_iters <= T_n_prime);
+      }
+      else
+      {
+         subset_size=n_points;
+      }
+
+      draw_sample(subset_size,include_last_flag,sample_indices);
+      unsigned int n_models=model_ptr->fit_minimal_sample(
+         &X[0],&Y[0],&U[0],&V[0],sample_indices,models);
+
+      for (unsigned int k=0; k<n_models; k++)
+      {
+         if (!preverify_model(models[k],max_error))
+         {
+            n_rejected_hypotheses++;
+            continue;
+         }
+
+         unsigned int n_model_inliers;
+         double cost=score_model(
+            models[k],max_error,min_cost,n_model_inliers);
+         if (cost >= min_cost || n_model_inliers < sample_size) continue;
+
+         model_found_flag=true;
+         min_cost=cost;
+         n_inliers=n_model_inliers;
+         for (unsigned int i=0; i<9; i++)
+         {
+            best_model[i]=models[k][i];
+         }
+         required_n_iters=compute_required_n_iters(n_inliers);
+      } // loop over index k labeling candidate models
+   } // while loop
+
+   if (!model_found_flag) return false;
+
+   identify_inliers(max_error);
+   return true;
+}
+
+// ---------------------------------------------------------------------
+// Member function draw_sample() fills sample_indices with distinct
+// tiepoint indices lying within [0,subset_size).  If
+// include_last_flag==true, the sample contains tiepoint subset_size-1
+// along with indices drawn from [0,subset_size-1).
+
+void ransac_engine::draw_sample(
+   unsigned int subset_size,bool include_last_flag,int* sample_indices)
+{
+   const unsigned int sample_size=model_ptr->get_sample_size();
+   unsigned int n_random=sample_size;
+   if (include_last_flag)
+   {
+      n_random--;
+      sample_indices[n_random]=subset_size-1;
+      subset_size--;
+   }
+
+   std::uniform_int_distribution<int> distribution(0,subset_size-1);
+   for (unsigned int s=0; s<n_random; s++)
+   {
+      bool repeated_flag=true;
+      while (repeated_flag)
+      {
+         sample_indices[s]=distribution(generator);
+         repeated_flag=false;
+         for (unsigned int r=0; r<s; r++)
+         {
+            if (sample_indices[r]==sample_indices[s]) repeated_flag=true;
+         }
+      }
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function preverify_model() implements the T(d,d) test of
+// "Randomized RANSAC with T(d,d) test" by Matas and Chum (2002).  The
+// model is retained only if all of d randomly selected tiepoints are
+// inliers.
+
+bool ransac_engine::preverify_model(
+   const ransac_model::model_matrix& M,double max_error)
+{
+   std::uniform_int_distribution<int> distribution(0,X.size()-1);
+   for (unsigned int d=0; d<preverification_size; d++)
+   {
+      int index=distribution(generator);
+      double error;
+      model_ptr->compute_errors(
+         M,&X[0],&Y[0],&U[0],&V[0],index,1,&error);
+      if (!(error < max_error)) return false;
+   }
+   return true;
+}
+
+// ---------------------------------------------------------------------
+// Member function score_model() accumulates MSAC costs over batches of
+// tiepoints.  Once the partial cost reaches cost_to_beat, the model
+// cannot improve upon the current best and scoring terminates early.
+
+double ransac_engine::score_model(
+   const ransac_model::model_matrix& M,double max_error,
+   double cost_to_beat,unsigned int& n_model_inliers) const
+{
+   const int n_points=X.size();
+   const double sqrd_max_error=max_error*max_error;
+   double errors[batch_size];
+
+   double cost=0;
+   n_model_inliers=0;
+   for (int first=0; first<n_points; first += batch_size)
+   {
+      int n_batch_points=n_points-first;
+      if (n_batch_points > batch_size) n_batch_points=batch_size;
+
+      model_ptr->compute_errors(
+         M,&X[0],&Y[0],&U[0],&V[0],first,n_batch_points,errors);
+      for (int i=0; i<n_batch_points; i++)
+      {
+         if (errors[i] < max_error)
+         {
+            cost += errors[i]*errors[i];
+            n_model_inliers++;
+         }
+         else
+         {
+            cost += sqrd_max_error;
+         }
+      }
+      if (cost >= cost_to_beat) break;
+   } // loop over first labeling tiepoint batches
+   return cost;
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_required_n_iters() returns the number of
+// iterations needed to draw at least one uncontaminated sample which
+// passes preverification with probability confidence.
+
+unsigned int ransac_engine::compute_required_n_iters(
+   unsigned int n_model_inliers) const
+{
+   double inlier_frac=double(n_model_inliers)/double(X.size());
+   double good_sample_prob=pow(
+      inlier_frac,int(model_ptr->get_sample_size()+preverification_size));
+   if (good_sample_prob >= 1) return n_iters;
+
+   double denom=log(1-good_sample_prob);
+   if (!(denom < 0)) return max_n_iters;
+   double n_required=log(1-confidence)/denom;
+   if (n_required >= max_n_iters) return max_n_iters;
+   return static_cast<unsigned int>(ceil(n_required));
+}
+
+// ---------------------------------------------------------------------
+// Member function identify_inliers() fills member STL vector
+// inlier_indices with tiepoints whose residuals with respect to the
+// best model are less than max_error.
+
+void ransac_engine::identify_inliers(double max_error)
+{
+   const int n_points=X.size();
+   double errors[batch_size];
+
+   inlier_indices.clear();
+   inlier_indices.reserve(n_inliers);
+   for (int first=0; first<n_points; first += batch_size)
+   {
+      int n_batch_points=n_points-first;
+      if (n_batch_points > batch_size) n_batch_points=batch_size;
+
+      model_ptr->compute_errors(
+         best_model,&X[0],&Y[0],&U[0],&V[0],first,n_batch_points,errors);
+      for (int i=0; i<n_batch_points; i++)
+      {
+         if (errors[i] < max_error) inlier_indices.push_back(first+i);
+      }
+   }
+}
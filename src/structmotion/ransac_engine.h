@@ -0,0 +1,235 @@
+// ==========================================================================
+// Header file for RANSAC_ENGINE class which robustly fits a two-view
+// geometric model to putative tiepoint pairs (X,Y) <--> (U,V).  The
+// engine is independent of the particular model.  Minimal sample
+// fitting and residual computation are delegated to a ransac_model.
+// Concrete models for 7-point fundamental matrices (scored by Sampson
+// error) and 4-point homographies (scored by squared transfer error)
+// are declared below.
+
+// Rather than running a fixed number of iterations, the engine stops
+// once the probability of having missed an all-inlier sample drops
+// below 1 - confidence.  If tiepoints are passed in order of
+// decreasing quality (e.g. increasing Lowe distance ratio), PROSAC
+// progressive sampling draws early hypotheses from the best matches.
+// Each hypothesis must first pass a T(d,d) preverification test on d
+// randomly chosen tiepoints before it is scored against all of them.
+// Scoring runs over contiguous coordinate arrays in vectorizable
+// batches and bails out once a hypothesis can no longer beat the
+// current best MSAC cost.  All 3x3 and minimal sample linear algebra
+// lives on the stack.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef RANSAC_ENGINE_H
+#define RANSAC_ENGINE_H
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+class twovector;
+
+// ==========================================================================
+// Abstract minimal sample model
+// ==========================================================================
+
+class ransac_model
+{
+
+  public:
+
+   virtual ~ransac_model();
+
+// Models are returned as 3x3 matrices stored in row-major order:
+
+   static const unsigned int max_n_models=3;
+   typedef double model_matrix[9];
+
+   virtual unsigned int get_sample_size() const=0;
+
+// Member function fit_minimal_sample() returns the number of candidate
+// models (possibly zero) consistent with the sampled tiepoints:
+
+   virtual unsigned int fit_minimal_sample(
+      const double* X,const double* Y,const double* U,const double* V,
+      const int* sample_indices,model_matrix models[]) const=0;
+
+// Member function compute_errors() fills errors[0,n_points) with
+// residuals for tiepoints [first,first+n_points):
+
+   virtual void compute_errors(
+      const model_matrix& M,
+      const double* X,const double* Y,const double* U,const double* V,
+      int first,int n_points,double* errors) const=0;
+};
+
+// Fundamental matrix F satisfying (X,Y,1) F (U,V,1)^T = 0:
+
+class fundamental_ransac_model : public ransac_model
+{
+
+  public:
+
+   virtual unsigned int get_sample_size() const;
+   virtual unsigned int fit_minimal_sample(
+      const double* X,const double* Y,const double* U,const double* V,
+      const int* sample_indices,model_matrix models[]) const;
+   virtual void compute_errors(
+      const model_matrix& F,
+      const double* X,const double* Y,const double* U,const double* V,
+      int first,int n_points,double* errors) const;
+};
+
+// Homography H mapping (X,Y,1) onto (U,V,1) up to scale:
+
+class homography_ransac_model : public ransac_model
+{
+
+  public:
+
+   virtual unsigned int get_sample_size() const;
+   virtual unsigned int fit_minimal_sample(
+      const double* X,const double* Y,const double* U,const double* V,
+      const int* sample_indices,model_matrix models[]) const;
+   virtual void compute_errors(
+      const model_matrix& H,
+      const double* X,const double* Y,const double* U,const double* V,
+      int first,int n_points,double* errors) const;
+};
+
+// ==========================================================================
+// RANSAC engine
+// ==========================================================================
+
+class ransac_engine
+{
+
+  public:
+
+   ransac_engine(const ransac_model* model_ptr);
+   ~ransac_engine();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const ransac_engine& R);
+
+// Set and get member functions:
+
+   void set_confidence(double c);
+   void set_max_n_iters(unsigned int n);
+   void set_preverification_size(unsigned int d);
+   void set_PROSAC_flag(bool flag);
+   void set_seed(unsigned int seed);
+
+   unsigned int get_n_points() const;
+   unsigned int get_n_iters() const;
+   unsigned int get_n_rejected_hypotheses() const;
+   unsigned int get_n_inliers() const;
+   double get_min_cost() const;
+   const double* get_best_model() const;
+   const std::vector<int>& get_inlier_indices() const;
+
+// Estimation member functions:
+
+   void set_tiepoints(
+      const std::vector<twovector>& XY,const std::vector<twovector>& UV);
+   bool estimate(double max_error);
+
+  private:
+
+   static const int batch_size=256;
+
+   const ransac_model* model_ptr;
+   bool PROSAC_flag;
+   unsigned int max_n_iters,preverification_size;
+   unsigned int n_iters,n_rejected_hypotheses,n_inliers;
+   double confidence,min_cost;
+   ransac_model::model_matrix best_model;
+   std::vector<double> X,Y,U,V;
+   std::vector<int> inlier_indices;
+   std::mt19937 generator;
+
+   void allocate_member_objects();
+   void initialize_member_objects();
+
+   void draw_sample(
+      unsigned int subset_size,bool include_last_flag,int* sample_indices);
+   bool preverify_model(const ransac_model::model_matrix& M,double max_error);
+   double score_model(
+      const ransac_model::model_matrix& M,double max_error,
+      double cost_to_beat,unsigned int& n_model_inliers) const;
+   unsigned int compute_required_n_iters(
+      unsigned int n_model_inliers) const;
+   void identify_inliers(double max_error);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+// Probability of drawing at least one all-inlier sample before
+// terminating:
+
+inline void ransac_engine::set_confidence(double c)
+{
+   confidence=c;
+}
+
+inline void ransac_engine::set_max_n_iters(unsigned int n)
+{
+   max_n_iters=n;
+}
+
+// Setting d=0 disables T(d,d) preverification:
+
+inline void ransac_engine::set_preverification_size(unsigned int d)
+{
+   preverification_size=d;
+}
+
+inline void ransac_engine::set_PROSAC_flag(bool flag)
+{
+   PROSAC_flag=flag;
+}
+
+inline void ransac_engine::set_seed(unsigned int seed)
+{
+   generator.seed(seed);
+}
+
+inline unsigned int ransac_engine::get_n_points() const
+{
+   return X.size();
+}
+
+inline unsigned int ransac_engine::get_n_iters() const
+{
+   return n_iters;
+}
+
+inline unsigned int ransac_engine::get_n_rejected_hypotheses() const
+{
+   return n_rejected_hypotheses;
+}
+
+inline unsigned int ransac_engine::get_n_inliers() const
+{
+   return n_inliers;
+}
+
+inline double ransac_engine::get_min_cost() const
+{
+   return min_cost;
+}
+
+inline const double* ransac_engine::get_best_model() const
+{
+   return best_model;
+}
+
+inline const std::vector<int>& ransac_engine::get_inlier_indices() const
+{
+   return inlier_indices;
+}
+
+#endif  // ransac_engine.h
@@ -1,10 +1,11 @@
 // ==========================================================================
 // VOXEL_LATTICE base class member function definitions
 // ==========================================================================
-// Last modified on 2/23/06; 12/10/06; 12/4/10; 4/5/14
+// Last modified on 2/23/06; 12/10/06; 12/4/10; 4/5/14; 10/18/26
 // ==========================================================================
 
 #include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include "threeDgraphics/voxel_lattice.h"
 
@@ -85,7 +86,7 @@ void voxel_lattice::initialize(
    int n_expected_points,double min_x,double max_x,double min_y,double max_y,
    double min_z,double max_z)
 {
-   voxels_hashtable_ptr=new Hashtable<Voxel_type>(n_expected_points);
+   voxels_hashtable_ptr=new Flat_hashtable<Voxel_type>(n_expected_points);
 
    const double min_prob=0;
    const double max_prob=0;
@@ -109,14 +110,49 @@ void voxel_lattice::initialize(
 
 void voxel_lattice::initialize(vector<fourvector> const *xyzp_point_ptr)
 {
-   int n_expected_points=10*xyzp_point_ptr->size();
-   voxels_hashtable_ptr=new Hashtable<Voxel_type>(n_expected_points);
-   ordered_voxels_ptr=new vector<pair<float,int> >(n_expected_points);
+   voxels_hashtable_ptr=new Flat_hashtable<Voxel_type>(
+      xyzp_point_ptr->size());
+   ordered_voxels_ptr=new vector<pair<float,int> >;
 
    compute_extremal_values(xyzp_point_ptr);
    reset_coordinate_system();
 }
 
+// This overloaded version of initialize() takes in a memory mapped
+// XYZP file.  Extremal values are computed chunk by chunk so that
+// resident memory stays bounded for multi-GB ladar tiles.  Since
+// *voxels_hashtable_ptr grows on demand and *ordered_voxels_ptr is
+// filled via push_back(), neither is presized to the file's record
+// count.  The hashtable's initial capacity is capped at
+// max_initial_n_voxels.
+
+void voxel_lattice::initialize(const xyzp_mmap_file& xyzp_file)
+{
+   if (!xyzp_file.get_opened_flag())
+   {
+      cout << "Error in voxel_lattice::initialize()!" << endl;
+      cout << "Cannot map " << xyzp_file.get_filename() << endl;
+      exit(-1);
+   }
+
+   const size_t max_initial_n_voxels=1 << 20;
+   size_t n_initial_voxels=basic_math::min(
+      xyzp_file.get_n_records(),max_initial_n_voxels);
+   voxels_hashtable_ptr=new Flat_hashtable<Voxel_type>(n_initial_voxels);
+   ordered_voxels_ptr=new vector<pair<float,int> >;
+
+   max_value=fourvector(NEGATIVEINFINITY,NEGATIVEINFINITY,
+                        NEGATIVEINFINITY,NEGATIVEINFINITY);
+   min_value=fourvector(POSITIVEINFINITY,POSITIVEINFINITY,
+                        POSITIVEINFINITY,POSITIVEINFINITY);
+   for (xyzp_chunk_iterator iter=xyzp_file.get_xyzp_chunk_iterator();
+        !iter.done(); iter.next())
+   {
+      compute_extremal_values(iter.current());
+   }
+   reset_coordinate_system();
+}
+
 // ---------------------------------------------------------------------
 // Member function compute_extremal_values loops over every XYZP point
 // within the input STL vector and stores the min/max XYZP values
@@ -145,6 +181,36 @@ void voxel_lattice::compute_extremal_values(
    }
 }
 
+// This overloaded version of compute_extremal_values() reads float
+// records directly out of the input span.  Unlike its STL vector
+// counterpart, it does NOT reset max_value and min_value so that it
+// may be called repeatedly on successive chunks of a single file.
+
+void voxel_lattice::compute_extremal_values(const xyzp_span& xyzp_records)
+{
+   double xmin=min_value.get(0),ymin=min_value.get(1);
+   double zmin=min_value.get(2),pmin=min_value.get(3);
+   double xmax=max_value.get(0),ymax=max_value.get(1);
+   double zmax=max_value.get(2),pmax=max_value.get(3);
+
+   for (const xyzp_float_record* r=xyzp_records.begin();
+        r != xyzp_records.end(); r++)
+   {
+      xmax=basic_math::max(xmax,double(r->x));
+      ymax=basic_math::max(ymax,double(r->y));
+      zmax=basic_math::max(zmax,double(r->z));
+      pmax=basic_math::max(pmax,double(r->p));
+
+      xmin=basic_math::min(xmin,double(r->x));
+      ymin=basic_math::min(ymin,double(r->y));
+      zmin=basic_math::min(zmin,double(r->z));
+      pmin=basic_math::min(pmin,double(r->p));
+   }
+
+   max_value=fourvector(xmax,ymax,zmax,pmax);
+   min_value=fourvector(xmin,ymin,zmin,pmin);
+}
+
 // ---------------------------------------------------------------------
 void voxel_lattice::reset_coordinate_system()
 {
@@ -210,6 +276,23 @@ void voxel_lattice::fill_lattice(vector<fourvector> const *xyzp_point_ptr)
    } 
 }
 
+// This overloaded version of fill_lattice streams through a memory
+// mapped XYZP file chunk by chunk.  No intermediate fourvectors are
+// instantiated.
+
+void voxel_lattice::fill_lattice(const xyzp_mmap_file& xyzp_file)
+{
+   for (xyzp_chunk_iterator iter=xyzp_file.get_xyzp_chunk_iterator();
+        !iter.done(); iter.next())
+   {
+      xyzp_span chunk=iter.current();
+      for (const xyzp_float_record* r=chunk.begin(); r != chunk.end(); r++)
+      {
+         increment_voxel_counts(xyz_to_key(threevector(r->x,r->y,r->z)));
+      }
+   }
+}
+
 // ---------------------------------------------------------------------
 // Member function increment_voxel_counts increases the counts
 // corresponding to the voxel specified by input key within
@@ -224,7 +307,7 @@ void voxel_lattice::increment_voxel_counts(
 void voxel_lattice::increment_voxel_counts(int key,int delta_counts)
 {
    int location;
-   Mynode<Voxel_type>* currnode_ptr=
+   Flat_hashnode<Voxel_type>* currnode_ptr=
       voxels_hashtable_ptr->retrieve_key(key,location);
    if (currnode_ptr==NULL)
    {
@@ -257,7 +340,7 @@ bool voxel_lattice::shadowed_voxel(const fourvector& XYZP)
    int location;
    int key=xyzp_to_key(XYZP);
 
-   Mynode<Voxel_type>* currnode_ptr=
+   Flat_hashnode<Voxel_type>* currnode_ptr=
       voxels_hashtable_ptr->retrieve_key(key,location);
    if (currnode_ptr != NULL)
    {
@@ -274,7 +357,7 @@ bool voxel_lattice::shadowed_voxel(const fourvector& XYZP)
 // with nonzero counts located upstream in the -r_hat direction.
 
 void voxel_lattice::identify_shadowed_voxels(
-   const threevector& r_hat,Hashtable<Voxel_type>* hashtable_ptr)
+   const threevector& r_hat,Flat_hashtable<Voxel_type>* hashtable_ptr)
 {
 
 // First compute maximum possible upstream distance.  Then compute
@@ -485,25 +568,18 @@ void voxel_lattice::voxels_along_line_segment(
 // in the first position of the STL vector.)
 
 void voxel_lattice::order_voxels_by_range(
-   const threevector& r_hat,Hashtable<Voxel_type>* hashtable_ptr)
+   const threevector& r_hat,Flat_hashtable<Voxel_type>* hashtable_ptr)
 {
    pair<float,int> p;
    ordered_voxels_ptr->clear();
 
    for (unsigned int n=0; n<hashtable_ptr->get_table_capacity(); n++)
    {
-      Linkedlist<Voxel_type>* currlist_ptr=hashtable_ptr->get_list_ptr(n);
-      if (currlist_ptr->size() > 0)
-      {
-         for (Mynode<Voxel_type>* currnode_ptr=currlist_ptr->get_start_ptr();
-              currnode_ptr != NULL; currnode_ptr=currnode_ptr->get_nextptr())
-         {
-            p.second=currnode_ptr->get_ID();
-            p.first=key_to_xyz(p.second).dot(r_hat);
-            ordered_voxels_ptr->push_back(p);
-         } // loop over voxel nodes in *currlist_ptr
-      }
-   } // loop over index n labeling hashtable's linked lists
+      if (!hashtable_ptr->occupied_slot(n)) continue;
+      p.second=hashtable_ptr->get_node_ptr(n)->get_ID();
+      p.first=key_to_xyz(p.second).dot(r_hat);
+      ordered_voxels_ptr->push_back(p);
+   } // loop over index n labeling hashtable's slots
    std::sort(ordered_voxels_ptr->rbegin(),ordered_voxels_ptr->rend());
 }
 
@@ -524,12 +600,13 @@ void voxel_lattice::order_voxels_by_range(
 
 void voxel_lattice::mark_shadowed_voxels(
    vector<voxel_coords>& rel_voxel_coords,
-   Hashtable<Voxel_type>* hashtable_ptr)
+   Flat_hashtable<Voxel_type>* hashtable_ptr)
 {
    for (unsigned int n=0; n<ordered_voxels_ptr->size(); n++)
    {
       int curr_key=(*ordered_voxels_ptr)[n].second;
-      Mynode<Voxel_type>* currnode_ptr=hashtable_ptr->retrieve_key(curr_key);
+      Flat_hashnode<Voxel_type>* currnode_ptr=
+         hashtable_ptr->retrieve_key(curr_key);
       voxel_coords curr_voxel=key_to_mnp(curr_key);
 
       for (unsigned int i=0; i<rel_voxel_coords.size(); i++)
@@ -538,7 +615,8 @@ void voxel_lattice::mark_shadowed_voxels(
          if (!voxel_inside_volume(rel_voxel)) break;
          
          int rel_key=mnp_to_key(rel_voxel);
-         Mynode<Voxel_type>* relnode_ptr=hashtable_ptr->retrieve_key(rel_key);
+         Flat_hashnode<Voxel_type>* relnode_ptr=
+            hashtable_ptr->retrieve_key(rel_key);
          if (relnode_ptr != NULL)
          {
             currnode_ptr->get_data().second=shadow_sentinel_value;
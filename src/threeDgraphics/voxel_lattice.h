@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for VOXEL_LATTICE class
 // ==========================================================================
-// Last modified on 2/22/06; 12/10/06
+// Last modified on 2/22/06; 12/10/06; 10/18/26
 // ==========================================================================
 
 #ifndef VOXEL_LATTICE_H
@@ -10,9 +10,10 @@
 #include <set>
 #include <vector>
 #include "math/fourvector.h"
-#include "datastructures/Hashtable.h"
+#include "datastructures/Flat_hashtable.h"
 #include "math/threevector.h"
 #include "threeDgraphics/voxel_coords.h"
+#include "threeDgraphics/xyzp_mmap_file.h"
 
 // The following pair type stores both integer voxel counts as well as
 // fractional voxel probability information:
@@ -37,7 +38,7 @@ class voxel_lattice
 // Set & get member functions:
 
    void set_delta(const threevector& d);
-   Hashtable<Voxel_type>* get_voxels_hashtable_ptr();
+   Flat_hashtable<Voxel_type>* get_voxels_hashtable_ptr();
 
 // Lattice initialization member functions:
 
@@ -45,8 +46,10 @@ class voxel_lattice
       int n_expected_points,double min_x,double max_x,
       double min_y,double max_y,double min_z,double max_z);
    void initialize(std::vector<fourvector> const *xyzp_point_ptr);
+   void initialize(const xyzp_mmap_file& xyzp_file);
    void compute_extremal_values(
       std::vector<fourvector> const *xyzp_point_ptr);
+   void compute_extremal_values(const xyzp_span& xyzp_records);
    void reset_coordinate_system();
 
 // Discrete <--> continous coordinate conversion member functions:
@@ -79,6 +82,7 @@ class voxel_lattice
 // Occupied/empty voxel determination member functions:
 
    void fill_lattice(std::vector<fourvector> const *xyzp_point_ptr);
+   void fill_lattice(const xyzp_mmap_file& xyzp_file);
    void increment_voxel_counts(const fourvector& XYZP,int delta_counts=1);
    void increment_voxel_counts(int key,int delta_counts=1);
    bool empty_voxel(const fourvector& XYZP);
@@ -87,7 +91,7 @@ class voxel_lattice
 
    bool shadowed_voxel(const fourvector& XYZP);
    void identify_shadowed_voxels(
-      const threevector& r_hat,Hashtable<Voxel_type>* hashtable_ptr);
+      const threevector& r_hat,Flat_hashtable<Voxel_type>* hashtable_ptr);
    void relative_voxel_coords_for_line_segment(
       const threevector& start_point,const threevector& stop_point,
       std::vector<voxel_coords>& relative_voxel_coords);
@@ -95,10 +99,10 @@ class voxel_lattice
       const threevector& start_point,const threevector& stop_point,
       std::vector<int>& keys);
    void order_voxels_by_range(
-      const threevector& r_hat,Hashtable<Voxel_type>* hashtable_ptr);
+      const threevector& r_hat,Flat_hashtable<Voxel_type>* hashtable_ptr);
    void mark_shadowed_voxels(
       std::vector<voxel_coords>& rel_voxel_coords,
-      Hashtable<Voxel_type>* hashtable_ptr);
+      Flat_hashtable<Voxel_type>* hashtable_ptr);
 
   private:
 
@@ -106,7 +110,7 @@ class voxel_lattice
    double shadow_sentinel_value;
    threevector delta,VOI_offset;
    fourvector max_value,min_value;
-   Hashtable<Voxel_type>* voxels_hashtable_ptr;
+   Flat_hashtable<Voxel_type>* voxels_hashtable_ptr;
    std::vector<std::pair<float,int> >* ordered_voxels_ptr;
 
    void allocate_member_objects();
@@ -125,7 +129,7 @@ inline void voxel_lattice::set_delta(const threevector& d)
    delta=d;
 }
 
-inline Hashtable<Voxel_type>* voxel_lattice::get_voxels_hashtable_ptr()
+inline Flat_hashtable<Voxel_type>* voxel_lattice::get_voxels_hashtable_ptr()
 {
    return voxels_hashtable_ptr;
 }
@@ -0,0 +1,163 @@
+// ==========================================================================
+// XYZP_MMAP_FILE class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "general/filefuncs.h"
+#include "threeDgraphics/xyzp_mmap_file.h"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::size_t;
+using std::string;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void xyzp_mmap_file::initialize_member_objects()
+{
+   opened_flag=false;
+   fd=-1;
+   n_bytes=n_records=0;
+   mapped_ptr=NULL;
+}
+
+// Input parameter n_floats_per_record should equal 4 for xyzp files
+// and 3 for xyz files.  Gzipped inputs are uncompressed in place just
+// as within xyzpfunc::read_xyzp_float_data().
+
+xyzp_mmap_file::xyzp_mmap_file(string filename,int n_floats_per_record)
+{
+   initialize_member_objects();
+   this->filename=filename;
+   this->n_floats_per_record=n_floats_per_record;
+   filefunc::gunzip_file_if_gzipped(filename);
+   opened_flag=open_and_map();
+}
+
+xyzp_mmap_file::~xyzp_mmap_file()
+{
+   if (mapped_ptr != NULL) munmap(mapped_ptr,n_bytes);
+   if (fd >= 0) close(fd);
+}
+
+// ---------------------------------------------------------------------
+// Private member function open_and_map() maps the entire input file
+// read-only into this process' address space.  It returns false if
+// the file cannot be opened or mapped.
+
+bool xyzp_mmap_file::open_and_map()
+{
+   fd=open(filename.c_str(),O_RDONLY);
+   if (fd < 0)
+   {
+      cerr << "Cannot open " << filename
+           << " inside xyzp_mmap_file::open_and_map()" << endl;
+      return false;
+   }
+
+   struct stat file_stats;
+   if (fstat(fd,&file_stats) != 0)
+   {
+      cerr << "Cannot stat " << filename
+           << " inside xyzp_mmap_file::open_and_map()" << endl;
+      return false;
+   }
+   n_bytes=file_stats.st_size;
+   n_records=n_bytes/(n_floats_per_record*sizeof(float));
+
+// An empty file is legitimate but cannot be mapped:
+
+   if (n_bytes==0) return true;
+
+   mapped_ptr=mmap(NULL,n_bytes,PROT_READ,MAP_PRIVATE,fd,0);
+   if (mapped_ptr==MAP_FAILED)
+   {
+      mapped_ptr=NULL;
+      cerr << "Cannot mmap " << filename
+           << " inside xyzp_mmap_file::open_and_map()" << endl;
+      return false;
+   }
+   return true;
+}
+
+// ==========================================================================
+// Set and get member functions
+// ==========================================================================
+
+xyzp_span xyzp_mmap_file::get_xyzp_span() const
+{
+   if (n_floats_per_record != 4 || mapped_ptr==NULL) return xyzp_span();
+   return xyzp_span(
+      static_cast<const xyzp_float_record*>(mapped_ptr),n_records);
+}
+
+xyz_span xyzp_mmap_file::get_xyz_span() const
+{
+   if (n_floats_per_record != 3 || mapped_ptr==NULL) return xyz_span();
+   return xyz_span(
+      static_cast<const xyz_float_record*>(mapped_ptr),n_records);
+}
+
+// ---------------------------------------------------------------------
+// Chunk iterators returned by the following methods release each
+// chunk's pages once they have been consumed.
+
+xyzp_chunk_iterator xyzp_mmap_file::get_xyzp_chunk_iterator(
+   size_t chunk_size) const
+{
+   advise_sequential();
+   return xyzp_chunk_iterator(get_xyzp_span(),chunk_size,this);
+}
+
+xyz_chunk_iterator xyzp_mmap_file::get_xyz_chunk_iterator(
+   size_t chunk_size) const
+{
+   advise_sequential();
+   return xyz_chunk_iterator(get_xyz_span(),chunk_size,this);
+}
+
+// ==========================================================================
+// Kernel paging advice member functions
+// ==========================================================================
+
+// Member function advise_sequential() tells the kernel to read ahead
+// aggressively since records are generally consumed in file order.
+
+void xyzp_mmap_file::advise_sequential() const
+{
+   if (mapped_ptr==NULL) return;
+   madvise(mapped_ptr,n_bytes,MADV_SEQUENTIAL);
+}
+
+// ---------------------------------------------------------------------
+// Member function release_pages() drops all whole pages lying within
+// the specified byte range from this process' resident set.  Since
+// the mapping is read-only, any released page is simply faulted back
+// in from the file if it is touched again.
+
+void xyzp_mmap_file::release_pages(const void* begin_ptr,size_t n_range_bytes)
+   const
+{
+   if (mapped_ptr==NULL || n_range_bytes==0) return;
+
+   const size_t page_size=sysconf(_SC_PAGESIZE);
+   const char* map_begin=static_cast<const char*>(mapped_ptr);
+   size_t start=static_cast<const char*>(begin_ptr)-map_begin;
+   size_t stop=start+n_range_bytes;
+   if (stop > n_bytes) stop=n_bytes;
+
+   start=(start/page_size)*page_size;
+   if (stop < n_bytes) stop=(stop/page_size)*page_size;
+   if (stop <= start) return;
+
+   madvise(const_cast<char*>(map_begin)+start,stop-start,MADV_DONTNEED);
+}
@@ -0,0 +1,259 @@
+// ==========================================================================
+// Header file for XYZP_MMAP_FILE class which memory maps Group 94
+// binary xyzp (4 floats per point) or xyz (3 floats per point) files.
+// Float records are exposed as typed, read-only record_spans which
+// point directly into the mapped file.  No per-point copies into
+// threevectors or fourvectors are made.  Multi-GB ladar tiles may be
+// consumed in fixed-size chunks via record_chunk_iterator.  Chunks
+// which have already been consumed are released back to the kernel
+// so that resident memory stays bounded by the chunk size.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef XYZP_MMAP_FILE_H
+#define XYZP_MMAP_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Binary layouts for individual xyzp and xyz float records:
+
+struct xyzp_float_record
+{
+      float x,y,z,p;
+};
+
+struct xyz_float_record
+{
+      float x,y,z;
+};
+
+// ==========================================================================
+// Templatized record_span class holds a pointer to contiguous records
+// along with their number.  It owns none of its memory.
+// ==========================================================================
+
+template <class T> class record_span
+{
+
+  public:
+
+   record_span();
+   record_span(const T* data_ptr,std::size_t n_records);
+
+   const T* begin() const;
+   const T* end() const;
+   std::size_t size() const;
+   bool empty() const;
+   const T& operator[] (std::size_t i) const;
+   record_span<T> subspan(std::size_t offset,std::size_t count) const;
+
+  private:
+
+   const T* data_ptr;
+   std::size_t n_records;
+};
+
+typedef record_span<xyzp_float_record> xyzp_span;
+typedef record_span<xyz_float_record> xyz_span;
+
+class xyzp_mmap_file;
+
+// ==========================================================================
+// Templatized record_chunk_iterator class walks through a record_span
+// chunk_size records at a time.  If it is constructed with a pointer
+// to the mmap file which backs the span, each chunk's pages are
+// released as soon as the iterator advances past it.
+// ==========================================================================
+
+template <class T> class record_chunk_iterator
+{
+
+  public:
+
+   record_chunk_iterator(
+      const record_span<T>& span,std::size_t chunk_size=1048576,
+      const xyzp_mmap_file* mmap_file_ptr=NULL);
+
+   bool done() const;
+   std::size_t get_offset() const;
+   record_span<T> current() const;
+   void next();
+
+  private:
+
+   record_span<T> span;
+   std::size_t chunk_size,offset;
+   const xyzp_mmap_file* mmap_file_ptr;
+};
+
+typedef record_chunk_iterator<xyzp_float_record> xyzp_chunk_iterator;
+typedef record_chunk_iterator<xyz_float_record> xyz_chunk_iterator;
+
+// ==========================================================================
+// XYZP_MMAP_FILE class
+// ==========================================================================
+
+class xyzp_mmap_file
+{
+
+  public:
+
+   xyzp_mmap_file(std::string filename,int n_floats_per_record=4);
+   ~xyzp_mmap_file();
+
+// Set and get member functions:
+
+   bool get_opened_flag() const;
+   std::string get_filename() const;
+   std::size_t get_n_bytes() const;
+   std::size_t get_n_records() const;
+   int get_n_floats_per_record() const;
+
+   xyzp_span get_xyzp_span() const;
+   xyz_span get_xyz_span() const;
+   xyzp_chunk_iterator get_xyzp_chunk_iterator(
+      std::size_t chunk_size=1048576) const;
+   xyz_chunk_iterator get_xyz_chunk_iterator(
+      std::size_t chunk_size=1048576) const;
+
+// Kernel paging advice member functions:
+
+   void advise_sequential() const;
+   void release_pages(const void* begin_ptr,std::size_t n_bytes) const;
+
+  private:
+
+   bool opened_flag;
+   int fd,n_floats_per_record;
+   std::string filename;
+   std::size_t n_bytes,n_records;
+   void* mapped_ptr;
+
+   void initialize_member_objects();
+   bool open_and_map();
+
+// Disallow copying since mapped memory is owned by this object:
+
+   xyzp_mmap_file(const xyzp_mmap_file& m);
+   xyzp_mmap_file& operator= (const xyzp_mmap_file& m);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+template <class T> inline record_span<T>::record_span()
+{
+   data_ptr=NULL;
+   n_records=0;
+}
+
+template <class T> inline record_span<T>::record_span(
+   const T* data_ptr,std::size_t n_records)
+{
+   this->data_ptr=data_ptr;
+   this->n_records=n_records;
+}
+
+template <class T> inline const T* record_span<T>::begin() const
+{
+   return data_ptr;
+}
+
+template <class T> inline const T* record_span<T>::end() const
+{
+   return data_ptr+n_records;
+}
+
+template <class T> inline std::size_t record_span<T>::size() const
+{
+   return n_records;
+}
+
+template <class T> inline bool record_span<T>::empty() const
+{
+   return n_records==0;
+}
+
+template <class T> inline const T& record_span<T>::operator[] (
+   std::size_t i) const
+{
+   return data_ptr[i];
+}
+
+template <class T> inline record_span<T> record_span<T>::subspan(
+   std::size_t offset,std::size_t count) const
+{
+   if (offset > n_records) offset=n_records;
+   if (count > n_records-offset) count=n_records-offset;
+   return record_span<T>(data_ptr+offset,count);
+}
+
+// ---------------------------------------------------------------------
+template <class T> inline record_chunk_iterator<T>::record_chunk_iterator(
+   const record_span<T>& span,std::size_t chunk_size,
+   const xyzp_mmap_file* mmap_file_ptr)
+{
+   this->span=span;
+   this->chunk_size=(chunk_size > 0) ? chunk_size : 1;
+   this->mmap_file_ptr=mmap_file_ptr;
+   offset=0;
+}
+
+template <class T> inline bool record_chunk_iterator<T>::done() const
+{
+   return offset >= span.size();
+}
+
+template <class T> inline std::size_t record_chunk_iterator<T>::get_offset()
+   const
+{
+   return offset;
+}
+
+template <class T> inline record_span<T> record_chunk_iterator<T>::current()
+   const
+{
+   return span.subspan(offset,chunk_size);
+}
+
+template <class T> inline void record_chunk_iterator<T>::next()
+{
+   record_span<T> consumed=current();
+   if (mmap_file_ptr != NULL && !consumed.empty())
+   {
+      mmap_file_ptr->release_pages(
+         consumed.begin(),consumed.size()*sizeof(T));
+   }
+   offset += consumed.size();
+}
+
+// ---------------------------------------------------------------------
+inline bool xyzp_mmap_file::get_opened_flag() const
+{
+   return opened_flag;
+}
+
+inline std::string xyzp_mmap_file::get_filename() const
+{
+   return filename;
+}
+
+inline std::size_t xyzp_mmap_file::get_n_bytes() const
+{
+   return n_bytes;
+}
+
+inline std::size_t xyzp_mmap_file::get_n_records() const
+{
+   return n_records;
+}
+
+inline int xyzp_mmap_file::get_n_floats_per_record() const
+{
+   return n_floats_per_record;
+}
+
+#endif  // xyzp_mmap_file.h
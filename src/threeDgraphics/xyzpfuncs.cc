@@ -1,7 +1,7 @@
 // ==========================================================================
 // XYZPFUNCS stand-alone methods
 // ==========================================================================
-// Last modified on 11/20/11; 1/29/12; 4/2/12; 4/5/14
+// Last modified on 11/20/11; 1/29/12; 4/2/12; 4/5/14; 10/18/26
 // ==========================================================================
 
 #include <set>
@@ -15,6 +15,7 @@
 #include "general/stringfuncs.h"
 #include "image/TwoDarray.h"
 #include "threeDgraphics/xyzpfuncs.h"
+#include "threeDgraphics/xyzp_mmap_file.h"
 
 using std::cin;
 using std::cout;
@@ -114,32 +115,25 @@ namespace xyzpfunc
          binary_instream.close();  
       }
 
+// As of Oct 2026, the following methods memory map their input files
+// via xyzp_mmap_file rather than reading one float at a time through
+// an ifstream.
+
    vector<threevector>* read_xyz_float_data(string xyz_filename)
       {
-         ifstream binary_instream;
-
-         bool file_opened=false;
-         do
-         {
-            filefunc::gunzip_file_if_gzipped(xyz_filename);
-            file_opened=filefunc::open_binaryfile(
-               xyz_filename,binary_instream);
-         }
-         while (!file_opened);
-         unsigned int npoints=npoints_inside_xyz_file(xyz_filename);
+         xyzp_mmap_file xyz_file(xyz_filename,3);
+         if (!xyz_file.get_opened_flag()) exit(-1);
+         xyz_span xyz_records=xyz_file.get_xyz_span();
+         cout << "Number of points within input binary xyz file = " 
+              << xyz_records.size() << endl;
 
-         float curr_x,curr_y,curr_z;
          vector<threevector>* xyz_pnt_ptr=new vector<threevector>;
-         xyz_pnt_ptr->reserve(npoints);
-         for (unsigned int n=0; n<npoints; n++)
+         xyz_pnt_ptr->reserve(xyz_records.size());
+         for (const xyz_float_record* r=xyz_records.begin(); 
+              r != xyz_records.end(); r++)
          {
-            filefunc::readobject(binary_instream,curr_x);
-            filefunc::readobject(binary_instream,curr_y);
-            filefunc::readobject(binary_instream,curr_z);
-            xyz_pnt_ptr->push_back(threevector(curr_x,curr_y,curr_z));
-         } // loop over index n labeling input points
-
-         binary_instream.close();  
+            xyz_pnt_ptr->push_back(threevector(r->x,r->y,r->z));
+         } // loop over input records
          return xyz_pnt_ptr;
       }
 
@@ -194,10 +188,11 @@ namespace xyzpfunc
       {
 //         cout << "inside xyzpfunc::read_xyzp_float_data()" << endl;
          
-         ifstream binary_instream;
-         filefunc::open_binaryfile(xyzp_filename,binary_instream);
+         xyzp_mmap_file xyzp_file(xyzp_filename);
+         if (!xyzp_file.get_opened_flag()) exit(-1);
+         xyzp_span xyzp_records=xyzp_file.get_xyzp_span();
+         unsigned int n_points=xyzp_records.size();
 
-         unsigned int n_points=npoints_inside_xyzp_file(xyzp_filename);
          X_ptr->clear();
          Y_ptr->clear();
          Z_ptr->clear();
@@ -208,19 +203,14 @@ namespace xyzpfunc
          Z_ptr->reserve(n_points);
          P_ptr->reserve(n_points);
 
-         float curr_x,curr_y,curr_z,curr_p;
-         for (unsigned int n=0; n<n_points; n++)
+         for (const xyzp_float_record* r=xyzp_records.begin();
+              r != xyzp_records.end(); r++)
          {
-            filefunc::readobject(binary_instream,curr_x);
-            filefunc::readobject(binary_instream,curr_y);
-            filefunc::readobject(binary_instream,curr_z);
-            filefunc::readobject(binary_instream,curr_p);
-            X_ptr->push_back(curr_x);
-            Y_ptr->push_back(curr_y);
-            Z_ptr->push_back(curr_z);
-            P_ptr->push_back(curr_p);
+            X_ptr->push_back(r->x);
+            Y_ptr->push_back(r->y);
+            Z_ptr->push_back(r->z);
+            P_ptr->push_back(r->p);
          }
-         binary_instream.close();  
          return n_points;
       }
 
@@ -231,26 +221,24 @@ namespace xyzpfunc
       {
          outputfunc::write_banner("Reading xyzp float data:");
 
-         ifstream binary_instream;
-         filefunc::open_binaryfile(xyzp_filename,binary_instream);
+         xyzp_mmap_file xyzp_file(xyzp_filename);
+         if (!xyzp_file.get_opened_flag()) exit(-1);
+         xyzp_span xyzp_records=xyzp_file.get_xyzp_span();
+         XYZ.reserve(XYZ.size()+xyzp_records.size());
+         P.reserve(P.size()+xyzp_records.size());
 
          int n_null_values=0;
-         float curr_x,curr_y,curr_z,curr_p;
-         int n=0;
-         while (!binary_instream.eof())
+         for (const xyzp_float_record* r=xyzp_records.begin();
+              r != xyzp_records.end(); r++)
          {
-            filefunc::readobject(binary_instream,curr_x);
-            filefunc::readobject(binary_instream,curr_y);
-            filefunc::readobject(binary_instream,curr_z);
-            XYZ.push_back(threevector(curr_x,curr_y,curr_z));
+            XYZ.push_back(threevector(r->x,r->y,r->z));
 
 // In cleaned versions of xyzp datafiles, we indicate null
 // probabilities with xyzpfunc::null_value values.  So when reading
 // back in cleaned files, we interpret any negative probability value
 // as null...
 
-            filefunc::readobject(binary_instream,curr_p);
-            if (curr_p >= 0)
+            if (r->p >= 0)
             {
 
 // As of 1/20/05, we no longer follow the old Group 94 convention of
@@ -258,18 +246,14 @@ namespace xyzpfunc
 // files.  So we no longer need to divide p-values by 10 when reading
 // them in from XYZP files:
 
-               P.push_back(curr_p);
-//               P.push_back(0.1*curr_p);
+               P.push_back(r->p);
             }
             else
             {
                n_null_values++;
                P.push_back(xyzpfunc::null_value);
             }
-            n++;
-            
-         } // loop over index n labeling XYZP points
-         binary_instream.close();  
+         } // loop over XYZP records
       }
 
 // ---------------------------------------------------------------------
@@ -290,42 +274,32 @@ namespace xyzpfunc
       string xyzp_filename,double pnull_threshold,
       vector<fourvector>* xyzp_pnt_ptr)
       {
-         ifstream binary_instream;
+         xyzp_mmap_file xyzp_file(xyzp_filename);
+         if (!xyzp_file.get_opened_flag()) exit(-1);
+         xyzp_span xyzp_records=xyzp_file.get_xyzp_span();
 
-         bool file_opened=false;
-         do
-         {
-            filefunc::gunzip_file_if_gzipped(xyzp_filename);
-            file_opened=filefunc::open_binaryfile(
-               xyzp_filename,binary_instream);
-         }
-         while (!file_opened);
-
-         unsigned int npoints=npoints_inside_xyzp_file(xyzp_filename);
-         xyzp_pnt_ptr->reserve(npoints+xyzp_pnt_ptr->size());
+         outputfunc::newline();
+         cout << "Number of points within input binary xyzp file = " 
+              << xyzp_records.size() << endl;
+         xyzp_pnt_ptr->reserve(xyzp_records.size()+xyzp_pnt_ptr->size());
 
          int n_null_values=0;
-         float curr_x,curr_y,curr_z,curr_p;
          fourvector curr_point;
-         for (unsigned int n=0; n<npoints; n++)
+         for (const xyzp_float_record* r=xyzp_records.begin();
+              r != xyzp_records.end(); r++)
          {
-            filefunc::readobject(binary_instream,curr_x);
-            filefunc::readobject(binary_instream,curr_y);
-            filefunc::readobject(binary_instream,curr_z);
-            filefunc::readobject(binary_instream,curr_p);
-
-            curr_point.put(0,curr_x);
-            curr_point.put(1,curr_y);
-            curr_point.put(2,curr_z);
+            curr_point.put(0,r->x);
+            curr_point.put(1,r->y);
+            curr_point.put(2,r->z);
 
 // In cleaned versions of xyzp datafiles, we indicate null
 // probabilities with xyzpfunc::null_value values.  So when reading
 // back in cleaned files, we interpret any probability value less than
 // pnull_threshold as null...
 
-            if (curr_p >= pnull_threshold)
+            if (r->p >= pnull_threshold)
             {
-               curr_point.put(3,curr_p);
+               curr_point.put(3,r->p);
             }
             else
             {
@@ -333,8 +307,7 @@ namespace xyzpfunc
                curr_point.put(3,xyzpfunc::null_value);
             }
             xyzp_pnt_ptr->push_back(curr_point);
-         } // loop over index n labeling input points
-         binary_instream.close();  
+         } // loop over XYZP records
 
          cout << "Number of null values within input XYZP file = "
               << n_null_values << endl;
@@ -537,6 +510,79 @@ namespace xyzpfunc
          return n_coincidence;
       }
 
+// ---------------------------------------------------------------------
+// This overloaded version of fill_image_with_z_and_p_values() bins
+// XYZP records directly from a (generally memory mapped) record span.
+// Input offset is added to every record's xyz values before binning.
+// Set initialize_values_flag to false when filling the same images
+// chunk by chunk.  Negative p values are interpreted as null just as
+// in read_xyzp_float_data().
+
+   int fill_image_with_z_and_p_values(
+      const xyzp_span& xyzp_records,const threevector& offset,
+      twoDarray* ztwoDarray_ptr,twoDarray* ptwoDarray_ptr,
+      bool initialize_values_flag)
+      {
+         if (initialize_values_flag)
+         {
+            ztwoDarray_ptr->initialize_values(xyzpfunc::null_value);
+            ptwoDarray_ptr->initialize_values(xyzpfunc::null_value);
+         }
+
+         int n_coincidence=0;
+         unsigned int px,py;
+         for (const xyzp_float_record* r=xyzp_records.begin();
+              r != xyzp_records.end(); r++)
+         {
+            if (ztwoDarray_ptr->point_to_pixel(
+                   r->x+offset.get(0),r->y+offset.get(1),px,py))
+            {
+               double currz=ztwoDarray_ptr->get(px,py);
+               if (currz != xyzpfunc::null_value) n_coincidence++;
+               ztwoDarray_ptr->put(px,py,r->z+offset.get(2));
+               if (r->p >= 0)
+               {
+                  ptwoDarray_ptr->put(px,py,r->p);
+               }
+               else
+               {
+                  ptwoDarray_ptr->put(px,py,xyzpfunc::null_value);
+               }
+            }
+         } // loop over XYZP records
+         return n_coincidence;
+      }
+
+// ---------------------------------------------------------------------
+// Method compute_xyzp_extrema() streams over input XYZP records and
+// returns their minimal and maximal x, y, z and non-null p values.
+
+   void compute_xyzp_extrema(
+      const xyzp_span& xyzp_records,fourvector& min_value,
+      fourvector& max_value)
+      {
+         double xmin,ymin,zmin,pmin,xmax,ymax,zmax,pmax;
+         xmin=ymin=zmin=pmin=POSITIVEINFINITY;
+         xmax=ymax=zmax=pmax=NEGATIVEINFINITY;
+         for (const xyzp_float_record* r=xyzp_records.begin();
+              r != xyzp_records.end(); r++)
+         {
+            xmin=basic_math::min(xmin,double(r->x));
+            xmax=basic_math::max(xmax,double(r->x));
+            ymin=basic_math::min(ymin,double(r->y));
+            ymax=basic_math::max(ymax,double(r->y));
+            zmin=basic_math::min(zmin,double(r->z));
+            zmax=basic_math::max(zmax,double(r->z));
+            if (r->p >= 0)
+            {
+               pmin=basic_math::min(pmin,double(r->p));
+               pmax=basic_math::max(pmax,double(r->p));
+            }
+         }
+         min_value=fourvector(xmin,ymin,zmin,pmin);
+         max_value=fourvector(xmax,ymax,zmax,pmax);
+      }
+
 // ---------------------------------------------------------------------
    int fill_image_with_z_and_p_values(
       osg::Vec3Array* vertices_ptr,const osg::FloatArray* probs_ptr,
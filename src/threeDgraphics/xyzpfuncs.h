@@ -1,7 +1,7 @@
 // =========================================================================
 // Header file for stand-alone XYZP data manipulation functions.
 // =========================================================================
-// Last modified on 12/2/10; 11/20/11; 1/29/12; 4/5/14
+// Last modified on 12/2/10; 11/20/11; 1/29/12; 4/5/14; 10/18/26
 // =========================================================================
 
 #ifndef XYZPFUNCS_H
@@ -16,6 +16,7 @@
 #include "general/filefuncs.h"
 #include "math/fourvector.h"
 #include "math/genvector.h"
+#include "threeDgraphics/xyzp_mmap_file.h"
 
 class rotation;
 class threevector;
@@ -72,6 +73,13 @@ namespace xyzpfunc
    int fill_image_with_z_and_p_values(
       const std::vector<threevector>& XYZ,const std::vector<double>& p,
       twoDarray* ztwoDarray_ptr,twoDarray* ptwoDarray_ptr);
+   int fill_image_with_z_and_p_values(
+      const xyzp_span& xyzp_records,const threevector& offset,
+      twoDarray* ztwoDarray_ptr,twoDarray* ptwoDarray_ptr,
+      bool initialize_values_flag=true);
+   void compute_xyzp_extrema(
+      const xyzp_span& xyzp_records,fourvector& min_value,
+      fourvector& max_value);
    int fill_image_with_z_and_p_values(
       osg::Vec3Array* vertices_ptr,const osg::FloatArray* probs_ptr,
       twoDarray* ztwoDarray_ptr,twoDarray* ptwoDarray_ptr);
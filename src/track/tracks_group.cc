@@ -1,13 +1,14 @@
 // ==========================================================================
 // tracks_group class member function definitions
 // ==========================================================================
-// Last updated on 10/11/09; 12/4/10; 3/20/13; 4/5/14
+// Last updated on 10/11/09; 12/4/10; 3/20/13; 4/5/14; 10/18/26
 // ==========================================================================
 
 #include <iostream>
 #include <string>
 #include "math/constant_vectors.h"
 #include "general/filefuncs.h"
+#include "general/numeric_text_reader.h"
 #include "track/tracks_group.h"
 
 using std::cout;
@@ -467,20 +468,29 @@ void tracks_group::read_speeds_from_file(string filename)
    cout << "filename = " << filename << endl;
    outputfunc::enter_continue_char();
 
-   if (!filefunc::ReadInfile(filename))
+// Only convert vehicle label, time, speed and azimuth columns:
+
+   numeric_text_reader speeds_reader;
+   vector<unsigned int> columns;
+   for (unsigned int c=1; c<=4; c++)
+   {
+      columns.push_back(c);
+   }
+   speeds_reader.set_columns(columns);
+
+   if (!speeds_reader.read(filename))
    {
       cout << "Error in tracks_group::read_speeds_from_file()!" << endl;
       return;
    }
  
-   for (unsigned int i=0; i<filefunc::text_line.size(); i++)
+   for (unsigned int i=0; i<speeds_reader.get_n_rows(); i++)
    {
-      vector<double> curr_line_values=
-         stringfunc::string_to_numbers(filefunc::text_line[i]);
-      int vehicle_label_ID=curr_line_values[1];
-      double curr_time=curr_line_values[2];
-      double curr_speed=curr_line_values[3];
-      double curr_azimuth=curr_line_values[4];
+      const double* curr_line_values=speeds_reader.get_row(i);
+      int vehicle_label_ID=curr_line_values[0];
+      double curr_time=curr_line_values[1];
+      double curr_speed=curr_line_values[2];
+      double curr_azimuth=curr_line_values[3];
       double curr_phi=(90-curr_azimuth)*PI/180.0;
       threevector curr_velocity(curr_speed*cos(curr_phi),
                                 curr_speed*sin(curr_phi));
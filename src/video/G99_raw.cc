@@ -1,12 +1,13 @@
 // ========================================================================
 // Group 99 raw data file parser class
 // ========================================================================
-// Last updated on 8/24/05
+// Last updated on 8/24/05; 10/18/26
 // ========================================================================
 
 #include <iostream>
 #include <string> 	// needed for memset
 #include "general/filefuncs.h"
+#include "video/frame_prefetcher.h"
 #include "video/G99_raw.h"
 #include "video/VidFile.h"
 #include "general/stringfuncs.h"
@@ -37,12 +38,14 @@ void RawFile::initialize_member_objects()
    scale=1;
    fpImg=NULL;
    hdrD10in_ptr=NULL;
+   frame_prefetcher_ptr=NULL;
 }		       
 
 RawFile::RawFile(string raw_filename)
 {
    initialize_member_objects();
    allocate_member_objects();
+   this->raw_filename=raw_filename;
    fpImg=fopen(raw_filename.c_str(), "rb" );
    if (!fpImg)
    {
@@ -53,6 +56,7 @@ RawFile::RawFile(string raw_filename)
 
 RawFile::~RawFile()
 {
+   delete frame_prefetcher_ptr;
    if (fpImg != NULL) fclose(fpImg);
    delete hdrD10in_ptr;
 }
@@ -245,13 +249,33 @@ void RawFile::advance_raw_file_counter()
 
 // Next skip over frames 0 through start_frame-1:
 
-   fseeko(fpImg,start_frame*total_bytes_per_raw_image,SEEK_CUR);
+   fseeko(fpImg,off_t(start_frame)*total_bytes_per_raw_image,SEEK_CUR);
 
 //   off_t curr_counter=ftello(fpImg);
 //   cout << "curr_counter = " << curr_counter << endl;
 //   cout << "fpImg = " << fpImg << endl << endl;
 }
 
+// ------------------------------------------------------------------------
+// Member function enable_prefetching() must be called after
+// read_file_header().  Raw frames are subsequently read on a
+// background thread n_read_ahead frames ahead of the conversion loop
+// within write_output_video_images().  The reader follows the loop's
+// frame skip.
+
+void RawFile::enable_prefetching(unsigned int n_read_ahead,bool direct_io_flag)
+{
+   delete frame_prefetcher_ptr;
+   frame_prefetcher_ptr=new frame_prefetcher(
+      raw_filename,sizeof(*hdrD10in_ptr),total_bytes_per_raw_image,
+      total_bytes_per_raw_image,0,n_read_ahead,0,direct_io_flag);
+   if (!frame_prefetcher_ptr->get_open_flag())
+   {
+      delete frame_prefetcher_ptr;
+      frame_prefetcher_ptr=NULL;
+   }
+}
+
 // ------------------------------------------------------------------------
 void RawFile::write_output_video_images()
 {
@@ -272,17 +296,29 @@ void RawFile::write_output_video_images()
 
 // Read in next raw image:      
 
-      if(fread( pbyImgIn, 1, total_bytes_per_raw_image, fpImg ) == 0)
+      if (frame_prefetcher_ptr == NULL ||
+          !frame_prefetcher_ptr->read_frame(i, pbyImgIn))
       {
-         cout << "No elements read in RawFile::write_output_video_images()"
-              << endl;
-      }
-      
+
+// The prefetcher does not advance fpImg.  So if it fails, seek
+// directly to frame i before reading:
+
+         if (frame_prefetcher_ptr != NULL)
+         {
+            fseeko( fpImg, off_t(sizeof(*hdrD10in_ptr)) + 
+                    off_t(i)*total_bytes_per_raw_image, SEEK_SET );
+         }
+         if(fread( pbyImgIn, 1, total_bytes_per_raw_image, fpImg ) == 0)
+         {
+            cout << "No elements read in RawFile::write_output_video_images()"
+                 << endl;
+         }
 
 // Skip over nframes_to_skip-1 images to get to next raw image:
 
-      fseeko( fpImg, total_bytes_per_raw_image*(nframes_to_skip - 1), 
-              SEEK_CUR );
+         fseeko( fpImg, total_bytes_per_raw_image*(nframes_to_skip - 1), 
+                 SEEK_CUR );
+      }
 
       if (wholeImage) 
       { //just copy the whole image
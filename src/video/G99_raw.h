@@ -1,7 +1,7 @@
 // ========================================================================
 // Header for Group 99 raw data file parser class
 // ========================================================================
-// Last updated on 8/12/05
+// Last updated on 8/12/05; 10/18/26
 // ========================================================================
 
 #ifndef G99_RAW_H
@@ -11,6 +11,7 @@
 #include <string>
 #include "video/D10GrabberFileHdr.h"
 
+class frame_prefetcher;
 class VidFile;
 
 class RawFile
@@ -35,6 +36,8 @@ class RawFile
    void compute_output_video_image_params();
    void write_output_header();
    void advance_raw_file_counter();
+   void enable_prefetching(
+      unsigned int n_read_ahead=8,bool direct_io_flag=false);
    void write_output_video_images();
 
   private:
@@ -48,8 +51,9 @@ class RawFile
    int start_frame,stop_frame,nframes_to_skip,n_output_images;
    int crop_x0,crop_y0,crop_width,crop_height;
    double scale;
-   std::string output_filename;
+   std::string raw_filename,output_filename;
    FILE* fpImg;
+   frame_prefetcher* frame_prefetcher_ptr;
    tD10GrabberFileHdr* hdrD10in_ptr;
    VidFile* output_image_ptr;
 
@@ -6,7 +6,7 @@
 // ========================================================================
 // Group 99 RGB video file parser class
 // ========================================================================
-// Last updated on 9/18/07; 10/22/07; 7/25/10
+// Last updated on 9/18/07; 10/22/07; 7/25/10; 10/18/26
 // ========================================================================
 
 #include <iostream>
@@ -16,6 +16,7 @@
 #include "image/drawfuncs.h"
 #include "general/filefuncs.h"
 #include "general/outputfuncs.h"
+#include "video/frame_prefetcher.h"
 #include "math/prob_distribution.h"
 #include "video/VidFile.h"
 #include "general/stringfuncs.h"
@@ -34,7 +35,9 @@ void VidFile::allocate_member_objects()
 
 void VidFile::initialize_member_objects()
 {
+   next_imagenumber=0;
    intensity_twoDarray_ptr=NULL;
+   frame_prefetcher_ptr=NULL;
 }
 
 // ----------------------------------------------------------------
@@ -55,6 +58,7 @@ VidFile::VidFile(string filename)
 
 VidFile::~VidFile()
 {
+   delete frame_prefetcher_ptr;
    fclose(fp);
 }
 
@@ -63,6 +67,7 @@ VidFile::~VidFile()
 
 int VidFile::Open(const char* name)
 {
+   filename=name;
    if ( NULL == (fp = fopen(name, "rb")) ) return 0;
    if(fread(&header, sizeof(header), 1, fp) == 0)	//Read short header
    {
@@ -179,6 +184,7 @@ void VidFile::query_structure_values()
 void VidFile::reset()
 {
    byte_counter = sizeof(header);
+   next_imagenumber = 0;
 }
 
 // ------------------------------------------------------------------------
@@ -188,19 +194,54 @@ void VidFile::read_next_image(unsigned char* data_ptr)
 //   cout << "frame number = " << (byte_counter-header.bytes_in_header)/
 //      image_size_in_bytes() << endl;
 
+// If the prefetcher cannot supply the frame, read it directly:
+
+   if (frame_prefetcher_ptr != NULL &&
+       frame_prefetcher_ptr->read_frame(next_imagenumber, data_ptr))
+   {
+      next_imagenumber++;
+      byte_counter += image_size_in_bytes();
+      return;
+   }
+
    fseeko(fp,byte_counter,SEEK_SET);
    if(fread(reinterpret_cast<void*>(data_ptr), image_size_in_bytes(), 1, fp) ==
       0) cout << "No elements read wtihin VidFile::read_next_image()" << endl;
    byte_counter += image_size_in_bytes();
+   next_imagenumber++;
 }
 
 // ------------------------------------------------------------------------
+// Member function read_image() may be called with p_imageNum equal to
+// -1 so that a subsequent call to read_next_image() returns the
+// zeroth frame.
+
 void VidFile::read_image(
    const unsigned int p_imageNum,unsigned char* p_dataPtr)
 {
+   if (frame_prefetcher_ptr != NULL && 
+       p_imageNum < frame_prefetcher_ptr->get_n_frames() &&
+       frame_prefetcher_ptr->read_frame(p_imageNum, p_dataPtr))
+   {
+      byte_counter = sizeof(header) + 
+         off_t(image_size_in_bytes()) * (p_imageNum+1);
+      next_imagenumber = p_imageNum+1;
+      return;
+   }
+
+// Since byte offsets are 64-bit, p_imageNum==-1 no longer wraps
+// byte_counter back onto the header.  So rewind explicitly:
+
+   if (int(p_imageNum) < 0)
+   {
+      reset();
+      return;
+   }
+
    if (p_imageNum >= 0)
    {
-      byte_counter = sizeof(header) + image_size_in_bytes() * p_imageNum;
+      byte_counter = sizeof(header) + 
+         off_t(image_size_in_bytes()) * p_imageNum;
 
       fseeko(fp,byte_counter,SEEK_SET);
       if(fread(reinterpret_cast<void*>(p_dataPtr), 
@@ -210,9 +251,32 @@ void VidFile::read_image(
       }
       
       byte_counter += image_size_in_bytes();
+      next_imagenumber = p_imageNum+1;
    }
 }
 
+// ------------------------------------------------------------------------
+// Member function enable_prefetching() launches a background reader
+// which holds decoded frames surrounding the most recently requested
+// image.  Subsequent calls to read_image() and read_next_image() are
+// served from its ring buffer.
+
+void VidFile::enable_prefetching(
+   unsigned int n_read_ahead,unsigned int n_read_behind,bool direct_io_flag)
+{
+   delete frame_prefetcher_ptr;
+   frame_prefetcher_ptr=new frame_prefetcher(
+      filename,sizeof(header),image_size_in_bytes(),image_size_in_bytes(),
+      getNumFrames(),n_read_ahead,n_read_behind,direct_io_flag);
+   if (!frame_prefetcher_ptr->get_open_flag()) disable_prefetching();
+}
+
+void VidFile::disable_prefetching()
+{
+   delete frame_prefetcher_ptr;
+   frame_prefetcher_ptr=NULL;
+}
+
 // ========================================================================
 // Greyscale methods:
 // ========================================================================
@@ -1,7 +1,7 @@
 // ========================================================================
 // Header for Group 99 RGB video file parser class
 // ========================================================================
-// Last updated on 9/18/07; 10/22/07; 7/25/10
+// Last updated on 9/18/07; 10/22/07; 7/25/10; 10/18/26
 // ========================================================================
 
 #ifndef VIDFILE_H
@@ -12,10 +12,12 @@
 // 3*image_size_in_bytes() RGB triples.
 
 #include <string>
+#include <sys/types.h>
 #include "datastructures/Quadruple.h"
 #include "datastructures/Triple.h"
 #include "image/TwoDarray.h"
 
+class frame_prefetcher;
 class prob_distribution;
 
 typedef unsigned short _uint16;
@@ -99,6 +101,15 @@ class VidFile
    void read_next_image(unsigned char* data_ptr);
    void read_image(const unsigned int p_imageNum, unsigned char* p_dataPtr);
 
+// Frames may be read on a background thread ahead of and behind the
+// most recently requested image:
+
+   void enable_prefetching(
+      unsigned int n_read_ahead=8,unsigned int n_read_behind=2,
+      bool direct_io_flag=false);
+   void disable_prefetching();
+   frame_prefetcher* get_frame_prefetcher_ptr();
+
 // Greyscale member functions:
 
    int pixel_greyscale_intensity_value(
@@ -112,7 +123,9 @@ class VidFile
 
   private:
 
-   unsigned int byte_counter;
+   off_t byte_counter;
+   unsigned int next_imagenumber;
+   std::string filename;
 
 // Note: As of Aug 2005, we do not know how to successfully read in
 // files larger than 2 GByte in size using C++ ifstream calls.  So in
@@ -122,6 +135,7 @@ class VidFile
    FILE* fp;	
    VID_HEADER header;
    twoDarray* intensity_twoDarray_ptr;
+   frame_prefetcher* frame_prefetcher_ptr;
 
    void allocate_member_objects();
    void initialize_member_objects();
@@ -150,4 +164,9 @@ inline const twoDarray* VidFile::get_intensity_twoDarray_ptr() const
    return intensity_twoDarray_ptr;
 }
 
+inline frame_prefetcher* VidFile::get_frame_prefetcher_ptr()
+{
+   return frame_prefetcher_ptr;
+}
+
 #endif // VidFile.h
@@ -0,0 +1,333 @@
+// ==========================================================================
+// Colorspacefuncs namespace method definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <algorithm>
+#include <iostream>
+#include "color/colorfuncs.h"
+#include "video/colorspacefuncs.h"
+
+using std::cout;
+using std::endl;
+
+namespace colorspacefunc
+{
+
+// Pixels within each row are processed in planar chunks of the
+// following length.  Chunk arrays live on the stack and comfortably
+// fit within L1 cache:
+
+   const unsigned int chunk_size=256;
+
+// ==========================================================================
+// Chunk loading methods
+// ==========================================================================
+
+// Method load_RGB_chunk deinterleaves n_pixels starting at pixel_ptr
+// into planar R, G and B float arrays.  Greyscale inputs (1 or 2
+// channels) are replicated across all three planes.  Flag
+// transparent[i] is set only for 4-channel pixels whose alpha equals
+// zero.
+
+   void load_RGB_chunk(
+      const unsigned char* pixel_ptr,unsigned int n_pixels,
+      unsigned int n_channels,float* R,float* G,float* B,bool* transparent)
+   {
+      if (n_channels==1 || n_channels==2)
+      {
+         for (unsigned int i=0; i<n_pixels; i++)
+         {
+            R[i]=G[i]=B[i]=pixel_ptr[n_channels*i];
+            transparent[i]=false;
+         }
+      }
+      else if (n_channels==3)
+      {
+         for (unsigned int i=0; i<n_pixels; i++)
+         {
+            R[i]=pixel_ptr[3*i+0];
+            G[i]=pixel_ptr[3*i+1];
+            B[i]=pixel_ptr[3*i+2];
+            transparent[i]=false;
+         }
+      }
+      else
+      {
+         for (unsigned int i=0; i<n_pixels; i++)
+         {
+            R[i]=pixel_ptr[4*i+0];
+            G[i]=pixel_ptr[4*i+1];
+            B[i]=pixel_ptr[4*i+2];
+            transparent[i]=(pixel_ptr[4*i+3]==0);
+         }
+      }
+   }
+
+// ==========================================================================
+// RGB to single channel methods
+// ==========================================================================
+
+// Method RGB_to_h_s_or_v fills row-major output array grey_ptr (which
+// must hold width*height bytes) with the hue (color_channel=0),
+// saturation (1) or value (2) of every input pixel rescaled to lie
+// within [0,255].  Transparent RGBA pixels as well as the hue of
+// grey pixels are mapped to zero.
+
+// The double precision operations below are performed in exactly
+// the same order as within colorfunc::RGB_to_hsv().  So the output
+// bytes match those formerly generated by texture_rectangle's
+// per-pixel conversions.
+
+   void RGB_to_h_s_or_v(
+      const unsigned char* data_ptr,unsigned int width,unsigned int height,
+      unsigned int n_channels,int color_channel,unsigned char* grey_ptr)
+   {
+#pragma omp parallel for schedule(static)
+      for (int py=0; py<int(height); py++)
+      {
+         float R[chunk_size],G[chunk_size],B[chunk_size];
+         double out[chunk_size];
+         bool transparent[chunk_size];
+
+         const unsigned char* row_ptr=data_ptr+size_t(py)*width*n_channels;
+         unsigned char* grey_row_ptr=grey_ptr+size_t(py)*width;
+
+         for (unsigned int px_start=0; px_start<width; px_start += chunk_size)
+         {
+            unsigned int n_pixels=std::min(chunk_size,width-px_start);
+            load_RGB_chunk(row_ptr+px_start*n_channels,n_pixels,n_channels,
+                           R,G,B,transparent);
+
+            if (color_channel==0)
+            {
+#pragma omp simd
+               for (unsigned int i=0; i<n_pixels; i++)
+               {
+                  double r=R[i]/255.0;
+                  double g=G[i]/255.0;
+                  double b=B[i]/255.0;
+                  double max_value=std::max(r,std::max(g,b));
+                  double min_value=std::min(r,std::min(g,b));
+                  double delta=max_value-min_value;
+                  double safe_delta=(delta > 0) ? delta : 1;
+                  double h=(r==max_value) ? (g-b)/safe_delta :
+                     (g==max_value) ? 2+(b-r)/safe_delta :
+                     4+(r-g)/safe_delta;
+                  h *= 60;
+                  if (h < 0) h += 360;
+
+// Hue is undefined for grey pixels:
+
+                  out[i]=(delta > 0) ? 255*h/360.0 : 0;
+               }
+            }
+            else if (color_channel==1)
+            {
+#pragma omp simd
+               for (unsigned int i=0; i<n_pixels; i++)
+               {
+                  double r=R[i]/255.0;
+                  double g=G[i]/255.0;
+                  double b=B[i]/255.0;
+                  double max_value=std::max(r,std::max(g,b));
+                  double min_value=std::min(r,std::min(g,b));
+                  double safe_max=(max_value != 0) ? max_value : 1;
+                  double s=(max_value-min_value)/safe_max;
+                  out[i]=255*s;
+               }
+            }
+            else
+            {
+#pragma omp simd
+               for (unsigned int i=0; i<n_pixels; i++)
+               {
+                  double v=std::max(R[i],std::max(G[i],B[i]))/255.0;
+                  out[i]=255*v;
+               }
+            }
+
+            for (unsigned int i=0; i<n_pixels; i++)
+            {
+               grey_row_ptr[px_start+i]=transparent[i] ? 0 :
+                  static_cast<unsigned char>(out[i]);
+            }
+         } // loop over px_start labeling chunks within current row
+      } // loop over py index
+   }
+
+// ---------------------------------------------------------------------
+// Method RGB_to_luminosity fills row-major output array grey_ptr with
+// 0.2126 R + 0.7152 G + 0.0722 B truncated to [0,255].  Transparent
+// RGBA pixels are mapped to zero.  Double precision is retained so
+// that the output bytes match colorfunc::RGB_to_luminosity() exactly.
+
+   void RGB_to_luminosity(
+      const unsigned char* data_ptr,unsigned int width,unsigned int height,
+      unsigned int n_channels,unsigned char* grey_ptr)
+   {
+#pragma omp parallel for schedule(static)
+      for (int py=0; py<int(height); py++)
+      {
+         float R[chunk_size],G[chunk_size],B[chunk_size];
+         double luminosity[chunk_size];
+         bool transparent[chunk_size];
+
+         const unsigned char* row_ptr=data_ptr+size_t(py)*width*n_channels;
+         unsigned char* grey_row_ptr=grey_ptr+size_t(py)*width;
+
+         for (unsigned int px_start=0; px_start<width; px_start += chunk_size)
+         {
+            unsigned int n_pixels=std::min(chunk_size,width-px_start);
+            load_RGB_chunk(row_ptr+px_start*n_channels,n_pixels,n_channels,
+                           R,G,B,transparent);
+
+#pragma omp simd
+            for (unsigned int i=0; i<n_pixels; i++)
+            {
+               double curr_luminosity=
+                  0.2126*double(R[i])+0.7152*double(G[i])+
+                  0.0722*double(B[i]);
+               luminosity[i]=std::min(curr_luminosity,255.0);
+            }
+
+            for (unsigned int i=0; i<n_pixels; i++)
+            {
+               grey_row_ptr[px_start+i]=transparent[i] ? 0 :
+                  static_cast<unsigned char>(luminosity[i]);
+            }
+         } // loop over px_start labeling chunks within current row
+      } // loop over py index
+   }
+
+// ==========================================================================
+// Single channel to RGB methods
+// ==========================================================================
+
+// Method replicate_grey_values writes each byte within row-major
+// input array grey_ptr into the R, G and B channels of the
+// corresponding pixel within data_ptr.  4-channel alpha values are
+// left unchanged, while 2-channel alpha values are reset to 255 as in
+// texture_rectangle::set_pixel_RGB_values().
+
+   void replicate_grey_values(
+      const unsigned char* grey_ptr,unsigned int width,unsigned int height,
+      unsigned int n_channels,unsigned char* data_ptr)
+   {
+#pragma omp parallel for schedule(static)
+      for (int py=0; py<int(height); py++)
+      {
+         const unsigned char* grey_row_ptr=grey_ptr+size_t(py)*width;
+         unsigned char* row_ptr=data_ptr+size_t(py)*width*n_channels;
+
+         if (n_channels==1)
+         {
+            std::copy(grey_row_ptr,grey_row_ptr+width,row_ptr);
+         }
+         else if (n_channels==2)
+         {
+            for (unsigned int px=0; px<width; px++)
+            {
+               row_ptr[2*px+0]=grey_row_ptr[px];
+               row_ptr[2*px+1]=255;
+            }
+         }
+         else
+         {
+            for (unsigned int px=0; px<width; px++)
+            {
+               unsigned char* pixel_ptr=row_ptr+n_channels*px;
+               pixel_ptr[0]=pixel_ptr[1]=pixel_ptr[2]=grey_row_ptr[px];
+            }
+         }
+      } // loop over py index
+   }
+
+// ---------------------------------------------------------------------
+// Method grey_values_to_hues resets every pixel whose max(R,G,B)
+// value v is nonzero to the fully saturated color with hue
+// hue_min+(hue_max-hue_min)*v and value 0.5+0.5*v.  Pixels which are
+// black are left unchanged.  Since the output color depends solely
+// upon v, all 255 possible colors are computed just once via
+// colorfunc::hsv_to_RGB() and stored within a lookup table.
+
+   void grey_values_to_hues(
+      unsigned char* data_ptr,unsigned int width,unsigned int height,
+      unsigned int n_channels,double hue_min,double hue_max)
+   {
+      unsigned char hue_LUT[256][3];
+      for (int V=0; V<256; V++)
+      {
+         double v=V/255.0;
+         double new_hue=hue_min+(hue_max-hue_min)*v;
+         colorfunc::HSV hsv(new_hue,1,0.5+0.5*v);
+         colorfunc::RGB rgb=colorfunc::hsv_to_RGB(hsv);
+         hue_LUT[V][0]=static_cast<unsigned char>(int(255*rgb.first));
+         hue_LUT[V][1]=static_cast<unsigned char>(int(255*rgb.second));
+         hue_LUT[V][2]=static_cast<unsigned char>(int(255*rgb.third));
+      }
+
+      unsigned int n_color_channels=std::min(n_channels,3U);
+      bool alpha_flag=(n_channels==2 || n_channels==4);
+
+#pragma omp parallel for schedule(static)
+      for (int py=0; py<int(height); py++)
+      {
+         unsigned char* row_ptr=data_ptr+size_t(py)*width*n_channels;
+         for (unsigned int px=0; px<width; px++)
+         {
+            unsigned char* pixel_ptr=row_ptr+n_channels*px;
+            unsigned char V=pixel_ptr[0];
+            if (n_color_channels==3)
+            {
+               V=std::max(V,std::max(pixel_ptr[1],pixel_ptr[2]));
+            }
+            if (V==0) continue;
+
+            const unsigned char* rgb_ptr=hue_LUT[V];
+            for (unsigned int c=0; c<n_color_channels; c++)
+            {
+               pixel_ptr[c]=rgb_ptr[c];
+            }
+            if (alpha_flag) pixel_ptr[n_channels-1]=255;
+         } // loop over px index
+      } // loop over py index
+   }
+
+// ==========================================================================
+// Row-major to twoDarray transfer methods
+// ==========================================================================
+
+// Method copy_grey_values_to_twoDarray transfers row-major array
+// grey_ptr into *ztwoDarray_ptr whose (px,py) entries are stored
+// column by column.  The transpose is performed in square tiles so
+// that neither the reads nor the writes stride across entire rows.
+
+   void copy_grey_values_to_twoDarray(
+      const unsigned char* grey_ptr,unsigned int width,unsigned int height,
+      twoDarray* ztwoDarray_ptr)
+   {
+      const int tile_size=32;
+      double* e_ptr=ztwoDarray_ptr->get_e_ptr();
+
+#pragma omp parallel for schedule(static)
+      for (int px_tile=0; px_tile<int(width); px_tile += tile_size)
+      {
+         int px_stop=std::min(px_tile+tile_size,int(width));
+         for (int py_tile=0; py_tile<int(height); py_tile += tile_size)
+         {
+            int py_stop=std::min(py_tile+tile_size,int(height));
+            for (int px=px_tile; px<px_stop; px++)
+            {
+               double* column_ptr=e_ptr+size_t(px)*height;
+               for (int py=py_tile; py<py_stop; py++)
+               {
+                  column_ptr[py]=grey_ptr[size_t(py)*width+px];
+               }
+            }
+         } // loop over py_tile
+      } // loop over px_tile
+   }
+
+} // colorspacefunc namespace
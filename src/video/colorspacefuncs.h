@@ -0,0 +1,46 @@
+// ==========================================================================
+// Header file for colorspacefunc namespace which holds whole-image
+// color conversion kernels.  Each kernel operates directly upon a
+// row-major, interleaved byte buffer with 1, 2, 3 or 4 channels.
+// Rows are distributed across threads in contiguous bands.  Within
+// each row, pixels are deinterleaved into short planar chunks so that
+// the RGB -> hsv and luminosity arithmetic can be vectorized.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef COLORSPACEFUNCS_H
+#define COLORSPACEFUNCS_H
+
+#include "image/TwoDarray.h"
+
+namespace colorspacefunc
+{
+
+// RGB to single channel methods:
+
+   void RGB_to_h_s_or_v(
+      const unsigned char* data_ptr,unsigned int width,unsigned int height,
+      unsigned int n_channels,int color_channel,unsigned char* grey_ptr);
+   void RGB_to_luminosity(
+      const unsigned char* data_ptr,unsigned int width,unsigned int height,
+      unsigned int n_channels,unsigned char* grey_ptr);
+
+// Single channel to RGB methods:
+
+   void replicate_grey_values(
+      const unsigned char* grey_ptr,unsigned int width,unsigned int height,
+      unsigned int n_channels,unsigned char* data_ptr);
+   void grey_values_to_hues(
+      unsigned char* data_ptr,unsigned int width,unsigned int height,
+      unsigned int n_channels,double hue_min,double hue_max);
+
+// Row-major to twoDarray transfer methods:
+
+   void copy_grey_values_to_twoDarray(
+      const unsigned char* grey_ptr,unsigned int width,unsigned int height,
+      twoDarray* ztwoDarray_ptr);
+
+} // colorspacefunc namespace
+
+#endif  // colorspacefuncs.h
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Descriptorfuncs namespace method definitions
 // ==========================================================================
-// Last modified on 3/24/14; 3/28/14; 5/10/14; 6/7/14
+// Last modified on 3/24/14; 3/28/14; 5/10/14; 6/7/14; 10/18/26
 // ==========================================================================
 
 #include <iostream>
@@ -12,6 +12,8 @@
 #include "general/filefuncs.h"
 #include "math/genmatrix.h"
 #include "video/descriptorfuncs.h"
+#include "video/gist_descriptor.h"
+#include "image/image_resampler.h"
 #include "image/imagefuncs.h"
 #include "templates/mytemplates.h"
 #include "video/RGB_analyzer.h"
@@ -39,116 +41,104 @@ namespace descriptorfunc
 // ==========================================================================
 
 // Method compute_gist_descriptor() takes an input image and first
-// rescales/crops it down to output_width x output_height (256x256).
-// It next converts the resized image to PPM format.  The Lear GIST
-// descriptor is calculated and exported to output text file
-// gist_filename.
+// rescales/crops it down to 256x256 pixels.  Its GIST descriptor is
+// then calculated and exported to output text file gist_filename.
+// This convenience version instantiates its own image buffer and
+// Gabor filter bank.  Callers processing many images should reuse
+// them via the overloaded version below.
    
    bool compute_gist_descriptor(string image_filename,string gist_filename)
    {
-//      cout << "inside descriptorfunc::compute_gist_descriptor()" << endl;
-//      cout << "image_filename = " << image_filename << endl;
-      unsigned int input_width,input_height;
-      imagefunc::get_image_width_height(
-         image_filename,input_width,input_height);
-//      cout << "  input_width = " << input_width 
-//           << " input_height = " << input_height << endl;
-   
-      unsigned int output_width=256;
-      unsigned int output_height=256;
-
-      string downsized_filename="downsized.jpg";
-      string unix_cmd="convert "+image_filename+
-         " -resize "+stringfunc::number_to_string(output_width)+"x"+
-         stringfunc::number_to_string(output_height)+"^ "+
-         downsized_filename;
-      sysfunc::unix_command(unix_cmd);
-
-      unsigned int downsized_width,downsized_height;
-      imagefunc::get_image_width_height(
-         downsized_filename,downsized_width,downsized_height);
-//      cout << "  downsized_width = " << downsized_width
-//           << " downsized_height = " << downsized_height << endl;
-
-      int delta_width=downsized_width-output_width;
-      int delta_height=downsized_height-output_height;
-//      cout << "  delta_width = " << delta_width
-//           << " delta_height = " << delta_height << endl;
-
-      string output_filename="output.jpg";
-      if (delta_width==0 && delta_height==0)
-      {
-         unix_cmd="mv "+downsized_filename+" "+output_filename;
-         sysfunc::unix_command(unix_cmd);
-      }
-      else if (fabs(delta_width) > fabs(delta_height))
-      {
-         // Crop excess horizontal pixels
+      texture_rectangle* texture_rectangle_ptr=new texture_rectangle();
+      gist_descriptor* gist_descriptor_ptr=new gist_descriptor();
+      bool gist_calculated_flag=compute_gist_descriptor(
+         image_filename,gist_filename,texture_rectangle_ptr,
+         gist_descriptor_ptr);
+      delete gist_descriptor_ptr;
+      delete texture_rectangle_ptr;
+      return gist_calculated_flag;
+   }
 
-         int xoffset=delta_width/2;
-         int yoffset=0;
-         imagefunc::extract_subimage(
-            downsized_filename,output_filename,
-            output_width,output_height,xoffset,yoffset);
-      }
-      else
+// ------------------------------------------------------------------------
+// This overloaded version of compute_gist_descriptor() decodes the
+// input image into *texture_rectangle_ptr.  Its GIST descriptor is
+// computed entirely in memory and exported to gist_filename.  No
+// temporary files are written and no external programs are invoked.
+// So distinct threads may process distinct images concurrently so
+// long as each owns its texture_rectangle.  *gist_descriptor_ptr may
+// be shared.
+
+   bool compute_gist_descriptor(
+      string image_filename,string gist_filename,
+      texture_rectangle* texture_rectangle_ptr,
+      const gist_descriptor* gist_descriptor_ptr)
+   {
+      if (!texture_rectangle_ptr->reset_texture_content(image_filename))
       {
-         // Crop excess vertical pixels
-         int xoffset=0;
-         int yoffset=delta_height/2;
-         imagefunc::extract_subimage(
-            downsized_filename,output_filename,
-            output_width,output_height,xoffset,yoffset);
+         return false;
       }
 
-      imagefunc::get_image_width_height(
-         output_filename,output_width,output_height);
-//      cout << "Exported "+output_filename << endl;
-//      cout << "output width = " << output_width
-//           << " output height = " << output_height << endl;
-
-// Convert resized image to PPM format 
-
-      string prefix=stringfunc::prefix(output_filename);
-      string suffix=stringfunc::suffix(output_filename);
-      string ppm_filename=prefix+".ppm";
-      string pgm_filename=prefix+".pgm";
-
-// In August 2013, we empirically found that ImageMagick's CONVERT
-// utility fails a non-negligible number of times to generate a PPM
-// file which LEAR GIST can import.  So we use the jpegtopnm utility
-// instead to convert JPEG to PPM files:
-
-//      unix_cmd="convert "+output_filename+" "+ppm_filename;
-      unix_cmd="jpegtopnm "+output_filename+" > "+ppm_filename;
-
-//      cout << "unix_cmd = " << unix_cmd << endl;
-      sysfunc::unix_command(unix_cmd);
-
-// Compute Lear GIST descriptor for resized PPM image:
-
-//         string gist_filename=gist_subdir+image_filename_prefix+".gist";
-      unix_cmd="lear_gist "+ppm_filename+" > "+gist_filename;
-//      unix_cmd="lear_gist "+pgm_filename+" > "+gist_filename;
-//      cout << "unix_cmd = " << unix_cmd << endl;
-      sysfunc::unix_command(unix_cmd);
-
-// For reasons we don't understand as of 3/31/13, LEAR gist sometimes
-// fails to generate descriptors for seemingly reasonable .ppm files.
-// So delete any small-sized gist output files:
-
-      long long filesize=filefunc::size_of_file_in_bytes(gist_filename);
-      if (filesize < 10)
+      vector<double> gist;
+      if (!compute_gist_descriptor(
+             texture_rectangle_ptr,gist_descriptor_ptr,gist))
       {
-         filefunc::deletefile(gist_filename);
          return false;
       }
-      else
+
+      ofstream giststream;
+      filefunc::openfile(gist_filename,giststream);
+      for (unsigned int c=0; c<gist.size(); c++)
       {
-         string banner="Exported "+gist_filename;
-         outputfunc::write_banner(banner);
-         return true;
+         giststream << gist[c] << " ";
       }
+      giststream << endl;
+      filefunc::closefile(gist_filename,giststream);
+
+      string banner="Exported "+gist_filename;
+      outputfunc::write_banner(banner);
+      return true;
+   }
+
+// ------------------------------------------------------------------------
+// This overloaded version of compute_gist_descriptor() takes in an
+// image already held within *texture_rectangle_ptr.  Its RGB channels
+// are area-resampled and centrally cropped down to the descriptor's
+// square input size.  This matches ImageMagick's "convert -resize
+// 256x256^" followed by cropping of excess pixels.  The GIST
+// descriptor is returned within output STL vector gist.
+
+   bool compute_gist_descriptor(
+      texture_rectangle* texture_rectangle_ptr,
+      const gist_descriptor* gist_descriptor_ptr,
+      vector<double>& gist)
+   {
+      unsigned int width=texture_rectangle_ptr->getWidth();
+      unsigned int height=texture_rectangle_ptr->getHeight();
+      if (width==0 || height==0) return false;
+
+      RGBA_array rgba_array=
+         texture_rectangle_ptr->get_RGBA_twoDarrays(false);
+
+      unsigned int image_size=gist_descriptor_ptr->get_image_size();
+      twoDarray RtwoDarray(image_size,image_size);
+      twoDarray GtwoDarray(image_size,image_size);
+      twoDarray BtwoDarray(image_size,image_size);
+
+// Images are already processed in parallel by callers.  So
+// resampling passes are kept single-threaded:
+
+      image_resampler resampler(image_resampler::area_filter);
+      resampler.set_n_threads(1);
+      resampler.resize_and_crop(rgba_array.first,&RtwoDarray);
+      resampler.resize_and_crop(rgba_array.second,&GtwoDarray);
+      resampler.resize_and_crop(rgba_array.third,&BtwoDarray);
+
+      vector<twoDarray const *> channel_twoDarray_ptrs;
+      channel_twoDarray_ptrs.push_back(&RtwoDarray);
+      channel_twoDarray_ptrs.push_back(&GtwoDarray);
+      channel_twoDarray_ptrs.push_back(&BtwoDarray);
+      return gist_descriptor_ptr->compute_descriptor(
+         channel_twoDarray_ptrs,gist);
    }
 
 // ------------------------------------------------------------------------
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for descriptorfunc namespace
 // ==========================================================================
-// Last modified on 10/5/13; 10/6/13; 10/8/13
+// Last modified on 10/5/13; 10/6/13; 10/8/13; 10/18/26
 // ==========================================================================
 
 #ifndef DESCRIPTORFUNCS_H
@@ -9,9 +9,11 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 class descriptor;
 class genmatrix;
+class gist_descriptor;
 class RGB_analyzer;
 class texture_rectangle;
 
@@ -24,6 +26,14 @@ namespace descriptorfunc
 
    bool compute_gist_descriptor(
       std::string image_filename,std::string gist_filename);
+   bool compute_gist_descriptor(
+      std::string image_filename,std::string gist_filename,
+      texture_rectangle* texture_rectangle_ptr,
+      const gist_descriptor* gist_descriptor_ptr);
+   bool compute_gist_descriptor(
+      texture_rectangle* texture_rectangle_ptr,
+      const gist_descriptor* gist_descriptor_ptr,
+      std::vector<double>& gist);
    genmatrix* GIST_descriptor_matrix(
       const std::vector<std::string>& gist_filenames,
       int n_descriptors=-1);
@@ -0,0 +1,454 @@
+// ==========================================================================
+// FRAME_PREFETCHER class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "video/frame_prefetcher.h"
+
+using std::cout;
+using std::endl;
+using std::mutex;
+using std::ostream;
+using std::string;
+using std::unique_lock;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+// One slot beyond the read window is reserved so that a newly
+// requested frame can always be loaded while the caller copies out
+// the previous one:
+
+void frame_prefetcher::allocate_member_objects()
+{
+   frame_slot empty;
+   empty.frame=-1;
+   empty.state=empty_slot;
+   empty.n_pins=0;
+   slots.assign(n_read_ahead+n_read_behind+2,empty);
+   for (unsigned int s=0; s<slots.size(); s++)
+   {
+      slots[s].data.resize(frame_size);
+   }
+}
+
+void frame_prefetcher::initialize_member_objects()
+{
+   buffered_fd=direct_fd=-1;
+   aligned_buffer=NULL;
+   aligned_buffer_size=0;
+   n_hits=n_misses=0;
+   shutdown_flag=false;
+   center_frame=last_requested_frame=-1;
+   last_frame_delta=0;
+   frame_step=1;
+}
+
+frame_prefetcher::frame_prefetcher(
+   string filename,off_t data_offset,unsigned int frame_stride,
+   unsigned int frame_size,unsigned int n_frames,
+   unsigned int n_read_ahead,unsigned int n_read_behind,bool direct_io_flag)
+{
+   initialize_member_objects();
+
+   this->filename=filename;
+   this->data_offset=data_offset;
+   this->frame_stride=frame_stride;
+   this->frame_size=frame_size;
+   this->n_frames=n_frames;
+   this->n_read_ahead=n_read_ahead;
+   this->n_read_behind=n_read_behind;
+
+   if (!open_file(direct_io_flag)) return;
+   allocate_member_objects();
+   reader_thread=std::thread(&frame_prefetcher::reader_loop,this);
+}
+
+// ---------------------------------------------------------------------
+frame_prefetcher::~frame_prefetcher()
+{
+   {
+      std::lock_guard<mutex> slots_lock(slots_mutex);
+      shutdown_flag=true;
+   }
+   work_available.notify_all();
+   frame_loaded.notify_all();
+   if (reader_thread.joinable()) reader_thread.join();
+
+   close_file();
+   free(aligned_buffer);
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const frame_prefetcher& F)
+{
+   outstream << endl;
+   outstream << "n_frames = " << F.get_n_frames()
+             << " frame_size = " << F.get_frame_size()
+             << " n_slots = " << F.get_n_slots()
+             << " direct_io = " << F.get_direct_io_flag()
+             << " n_hits = " << F.get_n_hits()
+             << " n_misses = " << F.get_n_misses()
+             << endl;
+   return outstream;
+}
+
+// ==========================================================================
+// File member functions
+// ==========================================================================
+
+bool frame_prefetcher::open_file(bool direct_io_flag)
+{
+   buffered_fd=open(filename.c_str(),O_RDONLY);
+   if (buffered_fd < 0)
+   {
+      cout << "Error in frame_prefetcher::open_file()!" << endl;
+      cout << "Cannot open " << filename << endl;
+      return false;
+   }
+
+   if (n_frames==0 && frame_stride > 0)
+   {
+      struct stat file_stat;
+      if (fstat(buffered_fd,&file_stat)==0 &&
+          file_stat.st_size > data_offset)
+      {
+         n_frames=(file_stat.st_size-data_offset)/frame_stride;
+      }
+   }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+   posix_fadvise(buffered_fd,data_offset,0,POSIX_FADV_SEQUENTIAL);
+#endif
+
+#ifdef O_DIRECT
+   if (direct_io_flag)
+   {
+      direct_fd=open(filename.c_str(),O_RDONLY | O_DIRECT);
+      if (direct_fd < 0)
+      {
+         cout << "O_DIRECT unavailable for " << filename
+              << ".  Falling back to buffered reads." << endl;
+      }
+   }
+#endif
+
+   return true;
+}
+
+void frame_prefetcher::close_file()
+{
+   if (buffered_fd >= 0) close(buffered_fd);
+   if (direct_fd >= 0) close(direct_fd);
+   buffered_fd=direct_fd=-1;
+}
+
+// ---------------------------------------------------------------------
+// Member function read_frame_bytes() is called only from the reader
+// thread.  O_DIRECT transfers must begin and end upon aligned file
+// offsets and target aligned memory.  So the aligned span covering
+// the requested frame is read into a bounce buffer.  If the
+// filesystem rejects O_DIRECT, all further reads are buffered.
+
+bool frame_prefetcher::read_frame_bytes(int frame,unsigned char* data_ptr)
+{
+   off_t offset=data_offset+off_t(frame)*frame_stride;
+
+   if (direct_fd >= 0)
+   {
+      off_t aligned_offset=offset-offset%direct_io_alignment;
+      size_t lead=offset-aligned_offset;
+      size_t span=lead+frame_size;
+      span=(span+direct_io_alignment-1)/direct_io_alignment*
+         direct_io_alignment;
+
+      if (span > aligned_buffer_size)
+      {
+         free(aligned_buffer);
+         aligned_buffer=NULL;
+         aligned_buffer_size=0;
+         void* buffer_ptr=NULL;
+         if (posix_memalign(&buffer_ptr,direct_io_alignment,span)==0)
+         {
+            aligned_buffer=static_cast<unsigned char*>(buffer_ptr);
+            aligned_buffer_size=span;
+         }
+      }
+
+      size_t n_read=0;
+      bool direct_failed_flag=(aligned_buffer==NULL);
+      while (!direct_failed_flag && n_read < span)
+      {
+         ssize_t n=pread(direct_fd,aligned_buffer+n_read,span-n_read,
+                         aligned_offset+n_read);
+         if (n < 0 && errno==EINTR) continue;
+         if (n < 0) direct_failed_flag=true;
+         if (n <= 0) break;
+         n_read += n;
+      }
+
+      if (!direct_failed_flag)
+      {
+         if (n_read < lead+frame_size) return false;
+         memcpy(data_ptr,aligned_buffer+lead,frame_size);
+         return true;
+      }
+
+      cout << "O_DIRECT read failed for " << filename
+           << ".  Falling back to buffered reads." << endl;
+      close(direct_fd);
+      direct_fd=-1;
+   }
+
+   size_t n_read=0;
+   while (n_read < frame_size)
+   {
+      ssize_t n=pread(buffered_fd,data_ptr+n_read,frame_size-n_read,
+                      offset+n_read);
+      if (n < 0 && errno==EINTR) continue;
+      if (n <= 0) return false;
+      n_read += n;
+   }
+   return true;
+}
+
+// ==========================================================================
+// Frame access member functions
+// ==========================================================================
+
+// Member function read_frame() copies the specified frame into
+// *data_ptr which must hold at least frame_size bytes.  It blocks
+// until the reader thread has loaded the frame.
+
+bool frame_prefetcher::read_frame(unsigned int frame,unsigned char* data_ptr)
+{
+   if (!get_open_flag() || frame >= n_frames)
+   {
+      cout << "Error in frame_prefetcher::read_frame()!" << endl;
+      cout << "frame = " << frame << " n_frames = " << n_frames << endl;
+      return false;
+   }
+
+   unique_lock<mutex> slots_lock(slots_mutex);
+   update_center_frame(frame);
+
+   int s=find_slot(frame);
+   if (s >= 0 && slots[s].state != loading_slot)
+   {
+      n_hits++;
+   }
+   else
+   {
+      n_misses++;
+   }
+
+// A failed slot is released so that the reader thread loads its frame
+// again.  If the retry also fails, the slot is still released so that
+// later requests try once more:
+
+   bool retry_flag=false;
+   while (true)
+   {
+      if (shutdown_flag) return false;
+      s=find_slot(frame);
+      if (s >= 0 && slots[s].state==ready_slot) break;
+      if (s >= 0 && slots[s].state==failed_slot)
+      {
+         slots[s].frame=-1;
+         slots[s].state=empty_slot;
+         if (retry_flag)
+         {
+            cout << "Error in frame_prefetcher::read_frame()!" << endl;
+            cout << "Could not read frame " << frame << " from " 
+                 << filename << endl;
+            return false;
+         }
+         retry_flag=true;
+         work_available.notify_one();
+         continue;
+      }
+      frame_loaded.wait(slots_lock);
+   }
+
+// Pin the slot so that it cannot be recycled while its contents are
+// copied outside the lock:
+
+   slots[s].n_pins++;
+   slots_lock.unlock();
+   memcpy(data_ptr,&(slots[s].data[0]),frame_size);
+   slots_lock.lock();
+   slots[s].n_pins--;
+   return true;
+}
+
+// ---------------------------------------------------------------------
+// Member function prefetch() recenters the read window upon the
+// specified frame without waiting for any data.
+
+void frame_prefetcher::prefetch(unsigned int frame)
+{
+   if (!get_open_flag() || frame >= n_frames) return;
+   std::lock_guard<mutex> slots_lock(slots_mutex);
+   update_center_frame(frame);
+}
+
+// ==========================================================================
+// Read window member functions.  These are called with slots_mutex
+// held.
+// ==========================================================================
+
+// Member function update_center_frame() takes the difference between
+// successive requests as the step separating frames within the read
+// window.  A single jump larger than the ring is treated as a seek
+// and leaves the step unchanged.  But once the same large difference
+// repeats, it becomes the step.  So batch loops which skip more frames
+// than the ring holds still read ahead along their stride.
+
+void frame_prefetcher::update_center_frame(int frame)
+{
+   if (last_requested_frame >= 0)
+   {
+      int delta=frame-last_requested_frame;
+      int max_step=slots.size();
+      if (delta != 0 && (abs(delta) <= max_step || delta==last_frame_delta))
+      {
+         frame_step=delta;
+      }
+      last_frame_delta=delta;
+   }
+   last_requested_frame=frame;
+
+   if (frame != center_frame)
+   {
+      center_frame=frame;
+      work_available.notify_one();
+   }
+}
+
+// ---------------------------------------------------------------------
+int frame_prefetcher::find_slot(int frame) const
+{
+   for (unsigned int s=0; s<slots.size(); s++)
+   {
+      if (slots[s].frame==frame && slots[s].state != empty_slot) return s;
+   }
+   return -1;
+}
+
+// ---------------------------------------------------------------------
+// Boolean member function frame_in_window() returns true if the
+// specified frame equals center_frame + k*frame_step for some
+// -n_read_behind <= k <= n_read_ahead.
+
+bool frame_prefetcher::frame_in_window(int frame) const
+{
+   if (center_frame < 0) return false;
+   int delta=frame-center_frame;
+   if (delta%frame_step != 0) return false;
+   int k=delta/frame_step;
+   return (k >= -int(n_read_behind) && k <= int(n_read_ahead));
+}
+
+// ---------------------------------------------------------------------
+// Member function select_next_read() returns the highest priority
+// window frame which is not yet held within the ring.  The center
+// frame comes first, followed by frames ahead and then behind it.
+// The chosen frame is assigned to an empty slot or else to the
+// unpinned slot holding the frame farthest from the window's center.
+
+bool frame_prefetcher::select_next_read(int& frame,int& slot_index)
+{
+   if (center_frame < 0) return false;
+
+   int n_candidates=n_read_ahead+n_read_behind+1;
+   for (int c=0; c<n_candidates; c++)
+   {
+      int k=(c <= int(n_read_ahead) ? c : int(n_read_ahead)-c);
+      int candidate_frame=center_frame+k*frame_step;
+      if (candidate_frame < 0 || candidate_frame >= int(n_frames)) continue;
+      if (find_slot(candidate_frame) >= 0) continue;
+
+      int victim=-1;
+      int max_distance=-1;
+      for (unsigned int s=0; s<slots.size(); s++)
+      {
+         const frame_slot& curr_slot=slots[s];
+         if (curr_slot.state==empty_slot)
+         {
+            victim=s;
+            break;
+         }
+         if (curr_slot.state==loading_slot || curr_slot.n_pins > 0) continue;
+         if (frame_in_window(curr_slot.frame)) continue;
+
+         int distance=abs(curr_slot.frame-center_frame);
+         if (distance > max_distance)
+         {
+            max_distance=distance;
+            victim=s;
+         }
+      }
+      if (victim < 0) return false;
+
+      frame=candidate_frame;
+      slot_index=victim;
+      slots[victim].frame=frame;
+      slots[victim].state=loading_slot;
+      return true;
+   }
+   return false;
+}
+
+// ---------------------------------------------------------------------
+// Member function reader_loop() runs on the background thread.  Disk
+// reads proceed without holding slots_mutex.  Whenever the window
+// moves, the kernel is asked to start fetching its read-ahead frames.
+
+void frame_prefetcher::reader_loop()
+{
+   int advised_center=-1;
+   unique_lock<mutex> slots_lock(slots_mutex);
+   while (!shutdown_flag)
+   {
+      if (direct_fd < 0 && center_frame >= 0 &&
+          center_frame != advised_center)
+      {
+         advised_center=center_frame;
+#ifdef POSIX_FADV_WILLNEED
+         for (unsigned int k=1; k<=n_read_ahead; k++)
+         {
+            int curr_frame=center_frame+k*frame_step;
+            if (curr_frame < 0 || curr_frame >= int(n_frames)) break;
+            posix_fadvise(buffered_fd,
+                          data_offset+off_t(curr_frame)*frame_stride,
+                          frame_size,POSIX_FADV_WILLNEED);
+         }
+#endif
+      }
+
+      int frame,slot_index;
+      if (!select_next_read(frame,slot_index))
+      {
+         work_available.wait(slots_lock);
+         continue;
+      }
+
+      slots_lock.unlock();
+      bool read_flag=read_frame_bytes(frame,&(slots[slot_index].data[0]));
+      slots_lock.lock();
+
+      slots[slot_index].state=(read_flag ? ready_slot : failed_slot);
+      frame_loaded.notify_all();
+   }
+}
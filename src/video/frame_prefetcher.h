@@ -0,0 +1,167 @@
+// ==========================================================================
+// Header file for FRAME_PREFETCHER class which reads fixed-size video
+// frames from Group 99 .vid and D10 grabber .raw files on a
+// background thread.  Frame f occupies frame_size bytes starting at
+// byte data_offset + f*frame_stride within the file.
+
+// Decoded frames are held within a ring of n_slots pooled buffers
+// which are allocated once.  Whenever a frame is requested, the
+// reader thread refills the ring with the n_read_ahead frames
+// following it and the n_read_behind frames preceding it.  The
+// spacing and direction between successive requests is tracked.  So
+// reverse scrubbing and batch tools which skip frames read ahead in
+// the order in which frames will actually be consumed.  Requests for
+// frames already within the ring return without touching the disk.
+// Frames which fail to load are retried when next requested.
+
+// Reads go through pread() on a private file descriptor.  The kernel
+// is advised of sequential access via posix_fadvise().  If requested,
+// a second descriptor opened with O_DIRECT bypasses the page cache so
+// that scanning multi-GB collects does not evict other data.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef FRAME_PREFETCHER_H
+#define FRAME_PREFETCHER_H
+
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+
+class frame_prefetcher
+{
+
+  public:
+
+// If n_frames==0, the number of frames is inferred from the file's
+// size:
+
+   frame_prefetcher(
+      std::string filename,off_t data_offset,unsigned int frame_stride,
+      unsigned int frame_size,unsigned int n_frames=0,
+      unsigned int n_read_ahead=8,unsigned int n_read_behind=2,
+      bool direct_io_flag=false);
+   ~frame_prefetcher();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const frame_prefetcher& F);
+
+// Set and get member functions:
+
+   bool get_open_flag() const;
+   unsigned int get_n_frames() const;
+   unsigned int get_frame_size() const;
+   unsigned int get_n_slots() const;
+   bool get_direct_io_flag() const;
+   unsigned int get_n_hits() const;
+   unsigned int get_n_misses() const;
+
+// Frame access member functions:
+
+   bool read_frame(unsigned int frame,unsigned char* data_ptr);
+   void prefetch(unsigned int frame);
+
+  private:
+
+   enum Slot_state
+   {
+      empty_slot, loading_slot, ready_slot, failed_slot
+   };
+
+   struct frame_slot
+   {
+         int frame;
+         Slot_state state;
+         unsigned int n_pins;
+         std::vector<unsigned char> data;
+   };
+
+   static const unsigned int direct_io_alignment=4096;
+
+   std::string filename;
+   off_t data_offset;
+   unsigned int frame_stride,frame_size,n_frames;
+   unsigned int n_read_ahead,n_read_behind;
+   int buffered_fd,direct_fd;
+   unsigned char* aligned_buffer;
+   size_t aligned_buffer_size;
+   unsigned int n_hits,n_misses;
+
+// Mutex slots_mutex guards every member below.  Condition variable
+// work_available wakes the reader thread when the requested frame
+// changes.  Condition variable frame_loaded wakes callers waiting for
+// a slot to be filled:
+
+   bool shutdown_flag;
+   int center_frame,last_requested_frame,last_frame_delta,frame_step;
+   std::vector<frame_slot> slots;
+   std::mutex slots_mutex;
+   std::condition_variable work_available,frame_loaded;
+   std::thread reader_thread;
+
+   void allocate_member_objects();
+   void initialize_member_objects();
+
+   bool open_file(bool direct_io_flag);
+   void close_file();
+
+   void update_center_frame(int frame);
+   int find_slot(int frame) const;
+   bool select_next_read(int& frame,int& slot_index);
+   bool frame_in_window(int frame) const;
+   bool read_frame_bytes(int frame,unsigned char* data_ptr);
+   void reader_loop();
+
+// Disallow copying since the reader thread holds a pointer to this
+// prefetcher:
+
+   frame_prefetcher(const frame_prefetcher& F);
+   frame_prefetcher& operator= (const frame_prefetcher& F);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+// Set and get member functions:
+
+inline bool frame_prefetcher::get_open_flag() const
+{
+   return buffered_fd >= 0;
+}
+
+inline unsigned int frame_prefetcher::get_n_frames() const
+{
+   return n_frames;
+}
+
+inline unsigned int frame_prefetcher::get_frame_size() const
+{
+   return frame_size;
+}
+
+inline unsigned int frame_prefetcher::get_n_slots() const
+{
+   return slots.size();
+}
+
+inline bool frame_prefetcher::get_direct_io_flag() const
+{
+   return direct_fd >= 0;
+}
+
+inline unsigned int frame_prefetcher::get_n_hits() const
+{
+   return n_hits;
+}
+
+inline unsigned int frame_prefetcher::get_n_misses() const
+{
+   return n_misses;
+}
+
+#endif  // frame_prefetcher.h
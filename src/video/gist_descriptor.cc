@@ -0,0 +1,365 @@
+// ==========================================================================
+// GIST_DESCRIPTOR class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <cmath>
+#include "math/basic_math.h"
+#include "math/constants.h"
+#include "video/gist_descriptor.h"
+
+using std::cout;
+using std::endl;
+using std::ostream;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void gist_descriptor::initialize_member_objects()
+{
+   n_filters=n_scales*n_orientations;
+   prefilter_size=image_size+2*prefilter_padding;
+   gabor_size=image_size+2*gabor_padding;
+}
+
+// ---------------------------------------------------------------------
+// FFTW's planner is not reentrant.  So plans are created within a
+// named critical section in case several descriptors are instantiated
+// by concurrent threads.  By default, an fftwnd plan holds a single
+// work array which concurrent executions would share.  FFTW_THREADSAFE
+// makes each execution allocate its own, so plans may be executed by
+// several threads at once.
+
+void gist_descriptor::allocate_member_objects()
+{
+#pragma omp critical(fftw_planner)
+   {
+      prefilter_forward=fftw2d_create_plan(
+         prefilter_size,prefilter_size,FFTW_FORWARD,
+         FFTW_ESTIMATE | FFTW_IN_PLACE | FFTW_THREADSAFE);
+      prefilter_backward=fftw2d_create_plan(
+         prefilter_size,prefilter_size,FFTW_BACKWARD,
+         FFTW_ESTIMATE | FFTW_IN_PLACE | FFTW_THREADSAFE);
+      gabor_forward=fftw2d_create_plan(
+         gabor_size,gabor_size,FFTW_FORWARD,
+         FFTW_ESTIMATE | FFTW_IN_PLACE | FFTW_THREADSAFE);
+      gabor_backward=fftw2d_create_plan(
+         gabor_size,gabor_size,FFTW_BACKWARD,
+         FFTW_ESTIMATE | FFTW_IN_PLACE | FFTW_THREADSAFE);
+   }
+}
+
+// ---------------------------------------------------------------------
+gist_descriptor::gist_descriptor(
+   unsigned int image_size,unsigned int n_blocks,
+   unsigned int n_scales,unsigned int n_orientations)
+{
+   this->image_size=image_size;
+   this->n_blocks=n_blocks;
+   this->n_scales=n_scales;
+   this->n_orientations=n_orientations;
+
+   initialize_member_objects();
+   allocate_member_objects();
+   compute_transfer_functions();
+}
+
+// ---------------------------------------------------------------------
+gist_descriptor::~gist_descriptor()
+{
+#pragma omp critical(fftw_planner)
+   {
+      fftwnd_destroy_plan(prefilter_forward);
+      fftwnd_destroy_plan(prefilter_backward);
+      fftwnd_destroy_plan(gabor_forward);
+      fftwnd_destroy_plan(gabor_backward);
+   }
+}
+
+// ---------------------------------------------------------------------
+// Overload << operator:
+
+ostream& operator<< (ostream& outstream,const gist_descriptor& G)
+{
+   outstream << endl;
+   outstream << "image_size = " << G.get_image_size()
+             << " n_blocks = " << G.get_n_blocks()
+             << " n_scales = " << G.get_n_scales()
+             << " n_orientations = " << G.get_n_orientations()
+             << endl;
+   return outstream;
+}
+
+// ---------------------------------------------------------------------
+// Member function compute_transfer_functions() fills the gaussian
+// prefilter with cutoff frequency fc = 4 cycles/image and the Gabor
+// filter bank.  Following LEAR, the Gabor filter for scale s and
+// orientation o has radial center frequency 0.3/1.85^s cycles/pixel
+// and orientation PI*o/n_orientations.  Its radial and angular
+// widths scale with the center frequency and n_orientations.
+
+void gist_descriptor::compute_transfer_functions()
+{
+   const double fc=4;
+   double s1_sqr=sqr(fc)/log(2.0);
+
+   lowpass_transfer.resize(prefilter_size*prefilter_size);
+   for (unsigned int v=0; v<prefilter_size; v++)
+   {
+      double fy=frequency(v,prefilter_size);
+      for (unsigned int u=0; u<prefilter_size; u++)
+      {
+         double fx=frequency(u,prefilter_size);
+         lowpass_transfer[v*prefilter_size+u]=
+            exp(-(sqr(fx)+sqr(fy))/s1_sqr);
+      }
+   }
+
+   unsigned int n_pixels=gabor_size*gabor_size;
+   gabor_transfer.resize(n_filters*n_pixels);
+   for (unsigned int s=0; s<n_scales; s++)
+   {
+      double radial_sigma=0.35;
+      double center_frequency=0.3/pow(1.85,double(s));
+      double angular_sigma=16.0*sqr(n_orientations)/sqr(32.0);
+
+      for (unsigned int o=0; o<n_orientations; o++)
+      {
+         double theta=PI*o/n_orientations;
+         float* transfer_ptr=&gabor_transfer[
+            (s*n_orientations+o)*n_pixels];
+
+         for (unsigned int v=0; v<gabor_size; v++)
+         {
+            double fy=frequency(v,gabor_size);
+            for (unsigned int u=0; u<gabor_size; u++)
+            {
+               double fx=frequency(u,gabor_size);
+               double fr=sqrt(sqr(fx)+sqr(fy));
+               double t=atan2(fy,fx)+theta;
+               if (t > PI) t -= 2*PI;
+               if (t < -PI) t += 2*PI;
+
+               transfer_ptr[v*gabor_size+u]=exp(
+                  -10*radial_sigma*sqr(fr/gabor_size/center_frequency-1)
+                  -2*angular_sigma*PI*sqr(t));
+            }
+         }
+      } // loop over index o labeling orientations
+   } // loop over index s labeling scales
+}
+
+// ==========================================================================
+// Descriptor member functions
+// ==========================================================================
+
+// Member function compute_descriptor() takes in 1 or 3
+// image_size x image_size channels whose intensities range from 0 to
+// 1.  It returns the GIST descriptor within output STL vector
+// descriptor.
+
+bool gist_descriptor::compute_descriptor(
+   const vector<twoDarray const *>& channel_twoDarray_ptrs,
+   vector<double>& descriptor) const
+{
+   unsigned int n_channels=channel_twoDarray_ptrs.size();
+   for (unsigned int c=0; c<n_channels; c++)
+   {
+      if (channel_twoDarray_ptrs[c]->get_mdim() != image_size ||
+          channel_twoDarray_ptrs[c]->get_ndim() != image_size)
+      {
+         cout << "Error in gist_descriptor::compute_descriptor()!" << endl;
+         cout << "Channel " << c << " has dimensions "
+              << channel_twoDarray_ptrs[c]->get_mdim() << " x "
+              << channel_twoDarray_ptrs[c]->get_ndim()
+              << " rather than " << image_size << " x " << image_size
+              << endl;
+         return false;
+      }
+   }
+   if (n_channels==0) return false;
+
+// LEAR operates upon intensities ranging from 0 to 255:
+
+   vector<vector<double> > channels(n_channels);
+   for (unsigned int c=0; c<n_channels; c++)
+   {
+      channels[c].resize(image_size*image_size);
+      for (unsigned int py=0; py<image_size; py++)
+      {
+         for (unsigned int px=0; px<image_size; px++)
+         {
+            channels[c][py*image_size+px]=
+               255*channel_twoDarray_ptrs[c]->get(px,py);
+         }
+      }
+   }
+
+   prefilter(channels);
+
+   descriptor.assign(get_n_features(n_channels),0);
+   for (unsigned int c=0; c<n_channels; c++)
+   {
+      gabor_filter(
+         channels[c],&descriptor[c*n_filters*n_blocks*n_blocks]);
+   }
+   return true;
+}
+
+// ---------------------------------------------------------------------
+// Member function lowpass_filter() multiplies the transform of the
+// prefilter_size x prefilter_size input by the gaussian transfer
+// function.  FFTW's unnormalized inverse is divided by the number of
+// samples.
+
+void gist_descriptor::lowpass_filter(vector<fftw_complex>& data) const
+{
+   fftwnd_one(prefilter_forward,&data[0],NULL);
+
+   double norm=1.0/data.size();
+   for (unsigned int i=0; i<data.size(); i++)
+   {
+      double curr_gain=norm*lowpass_transfer[i];
+      data[i].re *= curr_gain;
+      data[i].im *= curr_gain;
+   }
+
+   fftwnd_one(prefilter_backward,&data[0],NULL);
+}
+
+// ---------------------------------------------------------------------
+// Member function prefilter() symmetrically pads each channel by
+// prefilter_padding pixels and takes logarithms.  Low-pass copies
+// are subtracted in order to whiten the channels.  The whitened
+// channels are then divided by 0.2 plus their low-passed RMS
+// amplitude averaged over all channels.  Padding is finally removed.
+
+void gist_descriptor::prefilter(vector<vector<double> >& channels) const
+{
+   unsigned int n_channels=channels.size();
+   unsigned int n_pixels=prefilter_size*prefilter_size;
+   int pad=prefilter_padding;
+
+   vector<vector<double> > whitened(n_channels);
+   vector<fftw_complex> data(n_pixels);
+   vector<fftw_complex> energy(n_pixels);
+   for (unsigned int i=0; i<n_pixels; i++)
+   {
+      energy[i].re=energy[i].im=0;
+   }
+
+   for (unsigned int c=0; c<n_channels; c++)
+   {
+      whitened[c].resize(n_pixels);
+      for (unsigned int qy=0; qy<prefilter_size; qy++)
+      {
+         int py=symmetric_index(int(qy)-pad,image_size);
+         for (unsigned int qx=0; qx<prefilter_size; qx++)
+         {
+            int px=symmetric_index(int(qx)-pad,image_size);
+            unsigned int i=qy*prefilter_size+qx;
+            whitened[c][i]=log(1+channels[c][py*image_size+px]);
+            data[i].re=whitened[c][i];
+            data[i].im=0;
+         }
+      }
+
+      lowpass_filter(data);
+      for (unsigned int i=0; i<n_pixels; i++)
+      {
+         whitened[c][i] -= data[i].re;
+         energy[i].re += sqr(whitened[c][i])/n_channels;
+      }
+   } // loop over index c labeling channels
+
+   lowpass_filter(energy);
+
+   for (unsigned int c=0; c<n_channels; c++)
+   {
+      for (unsigned int py=0; py<image_size; py++)
+      {
+         for (unsigned int px=0; px<image_size; px++)
+         {
+            unsigned int i=(py+pad)*prefilter_size+px+pad;
+            double local_std=sqrt(sqrt(
+               sqr(energy[i].re)+sqr(energy[i].im)));
+            channels[c][py*image_size+px]=whitened[c][i]/(0.2+local_std);
+         }
+      }
+   }
+}
+
+// ---------------------------------------------------------------------
+// Member function gabor_filter() symmetrically pads a prefiltered
+// channel by gabor_padding pixels and transforms it once.  For each
+// Gabor filter, the product of the transforms is inverted.  The
+// magnitudes of unpadded responses are averaged over n_blocks x
+// n_blocks blocks whose boundaries fall at integer pixels.  Averages
+// for filter f are written to descriptor_ptr[f*n_blocks^2] onwards.
+
+void gist_descriptor::gabor_filter(
+   const vector<double>& channel,double* descriptor_ptr) const
+{
+   unsigned int n_pixels=gabor_size*gabor_size;
+   int pad=gabor_padding;
+
+   vector<fftw_complex> channel_tilde(n_pixels);
+   for (unsigned int qy=0; qy<gabor_size; qy++)
+   {
+      int py=symmetric_index(int(qy)-pad,image_size);
+      for (unsigned int qx=0; qx<gabor_size; qx++)
+      {
+         int px=symmetric_index(int(qx)-pad,image_size);
+         channel_tilde[qy*gabor_size+qx].re=channel[py*image_size+px];
+         channel_tilde[qy*gabor_size+qx].im=0;
+      }
+   }
+   fftwnd_one(gabor_forward,&channel_tilde[0],NULL);
+
+   vector<unsigned int> block_edges(n_blocks+1);
+   for (unsigned int b=0; b<=n_blocks; b++)
+   {
+      block_edges[b]=b*image_size/n_blocks;
+   }
+
+   double norm=1.0/n_pixels;
+   vector<fftw_complex> response(n_pixels);
+   for (unsigned int f=0; f<n_filters; f++)
+   {
+      const float* transfer_ptr=&gabor_transfer[f*n_pixels];
+      for (unsigned int i=0; i<n_pixels; i++)
+      {
+         double curr_gain=norm*transfer_ptr[i];
+         response[i].re=curr_gain*channel_tilde[i].re;
+         response[i].im=curr_gain*channel_tilde[i].im;
+      }
+      fftwnd_one(gabor_backward,&response[0],NULL);
+
+      for (unsigned int bx=0; bx<n_blocks; bx++)
+      {
+         for (unsigned int by=0; by<n_blocks; by++)
+         {
+            double sum=0;
+            for (unsigned int py=block_edges[by]; py<block_edges[by+1];
+                 py++)
+            {
+               const fftw_complex* row_ptr=
+                  &response[(py+pad)*gabor_size+pad];
+               for (unsigned int px=block_edges[bx];
+                    px<block_edges[bx+1]; px++)
+               {
+                  sum += sqrt(sqr(row_ptr[px].re)+sqr(row_ptr[px].im));
+               }
+            }
+            unsigned int n_block_pixels=
+               (block_edges[bx+1]-block_edges[bx])*
+               (block_edges[by+1]-block_edges[by]);
+            descriptor_ptr[(f*n_blocks+bx)*n_blocks+by]=
+               sum/basic_math::max(1U,n_block_pixels);
+         }
+      }
+   } // loop over index f labeling Gabor filters
+}
@@ -0,0 +1,153 @@
+// ==========================================================================
+// Header file for GIST_DESCRIPTOR class which computes Oliva and
+// Torralba's GIST scene descriptor in process.  It follows the LEAR
+// implementation which was formerly invoked as an external binary.
+// Square image_size x image_size input channels are first
+// prefiltered: log intensities are whitened by subtracting a gaussian
+// low-pass copy, and local contrast is then normalized by the
+// low-passed RMS amplitude across all channels.  Each prefiltered
+// channel is next convolved with a bank of n_scales x n_orientations
+// Gabor filters in the frequency domain.  Filter response magnitudes
+// are finally averaged over n_blocks x n_blocks image blocks.
+
+// Descriptor components are ordered by channel, then filter, then
+// horizontal block and finally vertical block.  With default
+// parameters, RGB images yield 3 x 32 x 16 = 3*512 components.
+
+// Gabor transfer functions and FFTW plans are computed once by the
+// constructor.  compute_descriptor() is const and allocates its own
+// work buffers.  Its FFTW plans are created with FFTW_THREADSAFE so
+// that their executions do not share fftwnd's work array.  Only then
+// may a single gist_descriptor be shared by multiple threads.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef GIST_DESCRIPTOR_H
+#define GIST_DESCRIPTOR_H
+
+#include <fftw.h>
+#include <iostream>
+#include <vector>
+#include "image/TwoDarray.h"
+
+class gist_descriptor
+{
+
+  public:
+
+   gist_descriptor(unsigned int image_size=256,unsigned int n_blocks=4,
+                   unsigned int n_scales=4,unsigned int n_orientations=8);
+   ~gist_descriptor();
+   friend std::ostream& operator<<
+      (std::ostream& outstream,const gist_descriptor& G);
+
+// Set and get member functions:
+
+   unsigned int get_image_size() const;
+   unsigned int get_n_blocks() const;
+   unsigned int get_n_scales() const;
+   unsigned int get_n_orientations() const;
+   unsigned int get_n_filters() const;
+   unsigned int get_n_features(unsigned int n_channels) const;
+
+// Descriptor member functions:
+
+   bool compute_descriptor(
+      const std::vector<twoDarray const *>& channel_twoDarray_ptrs,
+      std::vector<double>& descriptor) const;
+
+  private:
+
+   static const unsigned int prefilter_padding=5;
+   static const unsigned int gabor_padding=32;
+
+   unsigned int image_size,n_blocks,n_scales,n_orientations,n_filters;
+   unsigned int prefilter_size,gabor_size;
+   fftwnd_plan prefilter_forward,prefilter_backward;
+   fftwnd_plan gabor_forward,gabor_backward;
+
+// Transfer functions are stored in FFTW's unshifted frequency order.
+// Gabor filter f occupies entries f*gabor_size^2 through
+// (f+1)*gabor_size^2-1 of gabor_transfer:
+
+   std::vector<double> lowpass_transfer;
+   std::vector<float> gabor_transfer;
+
+   void initialize_member_objects();
+   void allocate_member_objects();
+
+   static double frequency(unsigned int u,unsigned int n);
+   static int symmetric_index(int i,unsigned int n);
+   void compute_transfer_functions();
+
+   void lowpass_filter(std::vector<fftw_complex>& data) const;
+   void prefilter(std::vector<std::vector<double> >& channels) const;
+   void gabor_filter(
+      const std::vector<double>& channel,double* descriptor_ptr) const;
+
+// Disallow copying since gist_descriptors own and destroy their FFTW
+// plans:
+
+   gist_descriptor(const gist_descriptor& G);
+   gist_descriptor& operator= (const gist_descriptor& G);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+// Set and get member functions:
+
+inline unsigned int gist_descriptor::get_image_size() const
+{
+   return image_size;
+}
+
+inline unsigned int gist_descriptor::get_n_blocks() const
+{
+   return n_blocks;
+}
+
+inline unsigned int gist_descriptor::get_n_scales() const
+{
+   return n_scales;
+}
+
+inline unsigned int gist_descriptor::get_n_orientations() const
+{
+   return n_orientations;
+}
+
+inline unsigned int gist_descriptor::get_n_filters() const
+{
+   return n_filters;
+}
+
+inline unsigned int gist_descriptor::get_n_features(
+   unsigned int n_channels) const
+{
+   return n_channels*n_filters*n_blocks*n_blocks;
+}
+
+// Private inlined methods:
+
+// Frequency index u within an n-point FFT corresponds to signed
+// integer frequency u or u-n:
+
+inline double gist_descriptor::frequency(unsigned int u,unsigned int n)
+{
+   return (u < (n+1)/2) ? double(u) : double(u)-double(n);
+}
+
+// Indices lying outside [0,n) are mirrored about the image's borders
+// with edge samples repeated:
+
+inline int gist_descriptor::symmetric_index(int i,unsigned int n)
+{
+   if (i < 0) return -i-1;
+   if (i >= int(n)) return 2*int(n)-1-i;
+   return i;
+}
+
+#endif  // gist_descriptor.h
@@ -0,0 +1,309 @@
+// ==========================================================================
+// IMAGE_PAIR_SCHEDULER class member function definitions
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#include <algorithm>
+#include <iostream>
+#include "video/image_pair_scheduler.h"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+// ---------------------------------------------------------------------
+// Initialization, constructor and destructor functions:
+// ---------------------------------------------------------------------
+
+void image_pair_scheduler::allocate_member_objects()
+{
+   for (unsigned int t=0; t<n_threads; t++)
+   {
+      worker_deques.push_back(new worker_deque);
+   }
+}
+
+void image_pair_scheduler::initialize_member_objects()
+{
+   shutdown_flag=false;
+   run_counter=n_active_workers=0;
+   next_deal_index=next_commit_index=deal_counter=0;
+   task_ptr=NULL;
+}
+
+image_pair_scheduler::image_pair_scheduler(int n_threads,int pairs_per_thread)
+{
+   if (n_threads <= 0) n_threads=std::thread::hardware_concurrency();
+   this->n_threads=std::max(1,n_threads);
+
+// Blocks hold a quarter of the pending window so that a few blocks may
+// be in flight while an expensive pair holds back commits:
+
+   max_pending_pairs=this->n_threads*std::max(4,pairs_per_thread);
+   block_size=max_pending_pairs/4;
+
+   allocate_member_objects();
+   initialize_member_objects();
+
+// Worker threads persist for the lifetime of this scheduler.  Between
+// calls to run(), they sleep upon condition variable run_started:
+
+   for (unsigned int t=0; t<this->n_threads; t++)
+   {
+      worker_threads.push_back(
+         std::thread(&image_pair_scheduler::worker_loop,this,t));
+   }
+}
+
+image_pair_scheduler::~image_pair_scheduler()
+{
+   {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      shutdown_flag=true;
+   }
+   run_started.notify_all();
+   for (unsigned int t=0; t<worker_threads.size(); t++)
+   {
+      worker_threads[t].join();
+   }
+   for (unsigned int t=0; t<worker_deques.size(); t++)
+   {
+      delete worker_deques[t];
+   }
+}
+
+// ==========================================================================
+// Scheduling member functions
+// ==========================================================================
+
+void image_pair_scheduler::clear_pairs()
+{
+   pairs.clear();
+}
+
+// ---------------------------------------------------------------------
+// Member function add_pair appends image pair (i,j) to the list of
+// pairs processed by the next call to run().  Input cost need only be
+// proportional to the pair's expected processing time.
+
+void image_pair_scheduler::add_pair(int i,int j,double cost)
+{
+   image_pair curr_pair;
+   curr_pair.i=i;
+   curr_pair.j=j;
+   curr_pair.cost=cost;
+   pairs.push_back(curr_pair);
+}
+
+// ---------------------------------------------------------------------
+// Member function run processes every pair added since the last call
+// to clear_pairs() via *task_ptr.  It blocks until all pairs have
+// been both processed and committed.
+
+void image_pair_scheduler::run(image_pair_task* task_ptr)
+{
+   if (pairs.size()==0) return;
+
+   this->task_ptr=task_ptr;
+   processed_flags.assign(max_pending_pairs,false);
+   next_deal_index=next_commit_index=0;
+   for (unsigned int t=0; t<n_threads; t++)
+   {
+      worker_deques[t]->pair_indices.clear();
+   }
+
+   std::unique_lock<std::mutex> lock(pool_mutex);
+   n_active_workers=n_threads;
+   run_counter++;
+   run_started.notify_all();
+   while (n_active_workers > 0)
+   {
+      run_finished.wait(lock);
+   }
+   this->task_ptr=NULL;
+}
+
+// ---------------------------------------------------------------------
+// Private member function deal_next_block_to_workers sorts the next
+// block_size pairs by decreasing cost.  Each pair is then appended to
+// the deque of the worker whose total cost within the block is
+// currently smallest.  So every worker takes a block's most expensive
+// pairs first.  This method must be called with commit_mutex held.
+
+void image_pair_scheduler::deal_next_block_to_workers()
+{
+   unsigned int block_stop=std::min(
+      next_deal_index+block_size,(unsigned int) pairs.size());
+   vector<int> sorted_indices;
+   for (unsigned int p=next_deal_index; p<block_stop; p++)
+   {
+      sorted_indices.push_back(p);
+   }
+
+   struct decreasing_cost
+   {
+         const vector<image_pair>* pairs_ptr;
+         bool operator() (int p,int q) const
+         {
+            return (*pairs_ptr)[p].cost > (*pairs_ptr)[q].cost;
+         }
+   } comparison;
+   comparison.pairs_ptr=&pairs;
+   std::stable_sort(sorted_indices.begin(),sorted_indices.end(),comparison);
+
+   vector<double> assigned_costs(n_threads,0);
+   for (unsigned int s=0; s<sorted_indices.size(); s++)
+   {
+      unsigned int t_min=std::min_element(
+         assigned_costs.begin(),assigned_costs.end())-assigned_costs.begin();
+      int p=sorted_indices[s];
+      {
+         worker_deque* curr_deque_ptr=worker_deques[t_min];
+         std::lock_guard<std::mutex> lock(curr_deque_ptr->m);
+         curr_deque_ptr->pair_indices.push_back(p);
+      }
+      assigned_costs[t_min] += pairs[p].cost;
+   }
+
+   next_deal_index=block_stop;
+   deal_counter++;
+}
+
+// ---------------------------------------------------------------------
+// Private member function pop_queued_pair first takes the most
+// expensive pair from the front of worker_ID's own deque.  If the
+// deque is empty, the worker steals the least expensive pair from the
+// back of another worker's deque.  This boolean method returns false
+// if every deque is currently empty.
+
+bool image_pair_scheduler::pop_queued_pair(
+   unsigned int worker_ID,int& pair_index)
+{
+   {
+      worker_deque* own_deque_ptr=worker_deques[worker_ID];
+      std::lock_guard<std::mutex> lock(own_deque_ptr->m);
+      if (own_deque_ptr->pair_indices.size() > 0)
+      {
+         pair_index=own_deque_ptr->pair_indices.front();
+         own_deque_ptr->pair_indices.pop_front();
+         return true;
+      }
+   }
+
+   for (unsigned int v=1; v<n_threads; v++)
+   {
+      worker_deque* victim_deque_ptr=worker_deques[(worker_ID+v)%n_threads];
+      std::lock_guard<std::mutex> lock(victim_deque_ptr->m);
+      if (victim_deque_ptr->pair_indices.size() > 0)
+      {
+         pair_index=victim_deque_ptr->pair_indices.back();
+         victim_deque_ptr->pair_indices.pop_back();
+         return true;
+      }
+   } // loop over index v labeling victim workers
+   return false;
+}
+
+// ---------------------------------------------------------------------
+// Private member function pop_next_pair returns a queued pair if one
+// exists.  Otherwise it deals the next block once the block fits
+// within the pending window.  If the window is full, the worker
+// sleeps until commits advance or another worker deals a block.  This
+// boolean method returns false once every pair has been dealt and
+// every deque is empty.
+
+bool image_pair_scheduler::pop_next_pair(
+   unsigned int worker_ID,int& pair_index)
+{
+   while (true)
+   {
+      unsigned int prev_deal_counter;
+      {
+         std::lock_guard<std::mutex> lock(commit_mutex);
+         prev_deal_counter=deal_counter;
+      }
+
+      if (pop_queued_pair(worker_ID,pair_index)) return true;
+
+      std::unique_lock<std::mutex> lock(commit_mutex);
+      if (deal_counter != prev_deal_counter) continue;
+      if (next_deal_index >= pairs.size()) return false;
+
+      unsigned int block_stop=std::min(
+         next_deal_index+block_size,(unsigned int) pairs.size());
+      if (block_stop-next_commit_index <= max_pending_pairs)
+      {
+         deal_next_block_to_workers();
+         continue;
+      }
+
+      unsigned int prev_commit_index=next_commit_index;
+      while (next_commit_index==prev_commit_index &&
+             deal_counter==prev_deal_counter)
+      {
+         window_advanced.wait(lock);
+      }
+   } // infinite while loop
+}
+
+// ---------------------------------------------------------------------
+// Private member function commit_processed_pairs marks input pair as
+// processed.  It then commits every pair which directly follows the
+// last committed pair and has already been processed.  Since no pair
+// is dealt more than max_pending_pairs beyond next_commit_index,
+// processed_flags is a ring buffer indexed modulo max_pending_pairs.
+
+void image_pair_scheduler::commit_processed_pairs(int pair_index)
+{
+   std::lock_guard<std::mutex> lock(commit_mutex);
+   processed_flags[pair_index%max_pending_pairs]=true;
+
+   unsigned int prev_commit_index=next_commit_index;
+   while (next_commit_index < pairs.size() &&
+          processed_flags[next_commit_index%max_pending_pairs])
+   {
+      const image_pair& curr_pair=pairs[next_commit_index];
+      task_ptr->commit_pair(next_commit_index,curr_pair.i,curr_pair.j);
+      processed_flags[next_commit_index%max_pending_pairs]=false;
+      next_commit_index++;
+   }
+   if (next_commit_index != prev_commit_index) window_advanced.notify_all();
+}
+
+// ---------------------------------------------------------------------
+// Private member function worker_loop is executed by each persistent
+// worker thread.  It waits for run() to post a new batch of pairs,
+// drains its own and other workers' deques and then reports back
+// that it has become idle.
+
+void image_pair_scheduler::worker_loop(unsigned int worker_ID)
+{
+   unsigned int prev_run_counter=0;
+   while (true)
+   {
+      {
+         std::unique_lock<std::mutex> lock(pool_mutex);
+         while (!shutdown_flag && run_counter==prev_run_counter)
+         {
+            run_started.wait(lock);
+         }
+         if (shutdown_flag) return;
+         prev_run_counter=run_counter;
+      }
+
+      int pair_index;
+      while (pop_next_pair(worker_ID,pair_index))
+      {
+         const image_pair& curr_pair=pairs[pair_index];
+         task_ptr->process_pair(pair_index,curr_pair.i,curr_pair.j);
+         commit_processed_pairs(pair_index);
+      }
+
+      {
+         std::lock_guard<std::mutex> lock(pool_mutex);
+         n_active_workers--;
+         if (n_active_workers==0) run_finished.notify_all();
+      }
+   } // infinite while loop
+}
@@ -0,0 +1,152 @@
+// ==========================================================================
+// Header file for IMAGE_PAIR_SCHEDULER class which distributes (i,j)
+// image pair tasks across a persistent pool of worker threads.  Pairs
+// are sorted by decreasing estimated cost (e.g. the product of the two
+// images' feature counts) and dealt to per-thread deques so that the
+// most expensive pairs start first.  A worker whose own deque empties
+// steals the cheapest remaining pair from the back of another
+// worker's deque.  So a few huge image pairs no longer leave most
+// cores idle at the end of a run.
+
+// Pairs are dealt in consecutive index blocks, and each block is
+// sorted by cost only within itself.  A new block is not dealt until
+// every outstanding pair lies within max_pending_pairs of the next
+// pair to be committed.  So buffered results occupy O(n_threads)
+// rather than O(n_pairs) memory no matter how many pairs are added.
+
+// Each pair is processed via image_pair_task::process_pair() on
+// whichever thread grabs it.  Results are then handed to
+// image_pair_task::commit_pair() strictly in the order in which pairs
+// were added.  Commits are serialized, so they may safely append to
+// shared output files or union-find structures.  Output therefore
+// matches that of a serial loop over the same pairs.  Tasks may store
+// per-pair results within get_max_pending_pairs() slots indexed by
+// pair_index modulo that number.
+// ==========================================================================
+// Last modified on 10/18/26
+// ==========================================================================
+
+#ifndef IMAGE_PAIR_SCHEDULER_H
+#define IMAGE_PAIR_SCHEDULER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Abstract base class for work performed upon individual image pairs:
+
+class image_pair_task
+{
+  public:
+
+   virtual ~image_pair_task() {}
+
+// Member function process_pair() is called concurrently from worker
+// threads.  Member function commit_pair() is called from one thread
+// at a time in increasing pair_index order:
+
+   virtual void process_pair(int pair_index,int i,int j) = 0;
+   virtual void commit_pair(int pair_index,int i,int j) = 0;
+};
+
+class image_pair_scheduler
+{
+
+  public:
+
+   struct image_pair
+   {
+         int i,j;
+         double cost;
+   };
+
+// If n_threads <= 0, one worker is launched per hardware thread.  At
+// most pairs_per_thread*n_threads pairs are processed but not yet
+// committed at any time:
+
+   image_pair_scheduler(int n_threads=0,int pairs_per_thread=8);
+   ~image_pair_scheduler();
+
+// Set and get member functions:
+
+   unsigned int get_n_threads() const;
+   unsigned int get_n_pairs() const;
+   unsigned int get_max_pending_pairs() const;
+   const image_pair& get_pair(int pair_index) const;
+
+// Scheduling member functions:
+
+   void clear_pairs();
+   void add_pair(int i,int j,double cost);
+   void run(image_pair_task* task_ptr);
+
+  private:
+
+   struct worker_deque
+   {
+         std::mutex m;
+         std::deque<int> pair_indices;
+   };
+
+   bool shutdown_flag;
+   unsigned int n_threads,max_pending_pairs,block_size;
+   unsigned int run_counter,n_active_workers;
+   unsigned int next_deal_index,next_commit_index,deal_counter;
+   std::vector<image_pair> pairs;
+   std::vector<bool> processed_flags;
+   std::vector<worker_deque*> worker_deques;
+   std::vector<std::thread> worker_threads;
+   image_pair_task* task_ptr;
+
+// Mutex pool_mutex guards run_counter, n_active_workers and
+// shutdown_flag.  Mutex commit_mutex guards processed_flags,
+// next_deal_index, next_commit_index and deal_counter.  It is always
+// acquired before any worker_deque mutex:
+
+   std::mutex pool_mutex,commit_mutex;
+   std::condition_variable run_started,run_finished,window_advanced;
+
+   void allocate_member_objects();
+   void initialize_member_objects();
+
+   void deal_next_block_to_workers();
+   bool pop_queued_pair(unsigned int worker_ID,int& pair_index);
+   bool pop_next_pair(unsigned int worker_ID,int& pair_index);
+   void commit_processed_pairs(int pair_index);
+   void worker_loop(unsigned int worker_ID);
+
+// Disallow copying since worker threads hold pointers into this
+// scheduler:
+
+   image_pair_scheduler(const image_pair_scheduler& s);
+   image_pair_scheduler& operator= (const image_pair_scheduler& s);
+};
+
+// ==========================================================================
+// Inlined methods:
+// ==========================================================================
+
+inline unsigned int image_pair_scheduler::get_n_threads() const
+{
+   return n_threads;
+}
+
+inline unsigned int image_pair_scheduler::get_n_pairs() const
+{
+   return pairs.size();
+}
+
+inline unsigned int image_pair_scheduler::get_max_pending_pairs() const
+{
+   return max_pending_pairs;
+}
+
+inline const image_pair_scheduler::image_pair&
+image_pair_scheduler::get_pair(int pair_index) const
+{
+   return pairs[pair_index];
+}
+
+#endif  // image_pair_scheduler.h
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Photogroup class member function definitions
 // ==========================================================================
-// Last modified on 3/28/14; 4/6/14; 6/7/14; 11/28/15
+// Last modified on 3/28/14; 4/6/14; 6/7/14; 11/28/15; 10/18/26
 // ==========================================================================
 
 #include <iostream>
@@ -14,6 +14,7 @@
 #include "general/filefuncs.h"
 #include "graphs/graph_edge.h"
 #include "image/imagefuncs.h"
+#include "general/numeric_text_reader.h"
 #include "general/outputfuncs.h"
 #include "passes/PassesGroup.h"
 #include "video/photodbfuncs.h"
@@ -1163,10 +1164,9 @@ void photogroup::reconstruct_bundler_cameras(
 //   cout << "bundle_filename = " << bundle_filename
 //        << endl;
 
-   filefunc::ReadInfile(bundle_filename);
-   string first_line=filefunc::text_line[0];
-//   cout <<  "first_line = " << first_line << endl;
-   vector<double> bundler_params=stringfunc::string_to_numbers(first_line);
+   numeric_text_reader bundle_reader(bundle_filename);
+//   cout <<  "first_line = " << bundle_reader.get_line(0) << endl;
+   const double* bundler_params=bundle_reader.get_row(0);
    unsigned int n_cameras=bundler_params[0];
    unsigned int n_reconstructed_3D_points=bundler_params[1];
    cout << "n_cameras = " << n_cameras 
@@ -1186,19 +1186,11 @@ void photogroup::reconstruct_bundler_cameras(
 
 // Parse Noah's camera parameters file:
 
-      vector<string> line;
-      for (unsigned int j=0; j<5; j++)
-      {
-         line.push_back(filefunc::text_line[curr_linenumber]);
-         curr_linenumber++;
-//         cout << line.back() << endl;
-      }
-
-      vector<double> fkk=stringfunc::string_to_numbers(line[0]);
-      vector<double> R0=stringfunc::string_to_numbers(line[1]);
-      vector<double> R1=stringfunc::string_to_numbers(line[2]);
-      vector<double> R2=stringfunc::string_to_numbers(line[3]);
-      vector<double> t=stringfunc::string_to_numbers(line[4]);
+      const double* fkk=bundle_reader.get_row(curr_linenumber);
+      const double* R0=bundle_reader.get_row(curr_linenumber+1);
+      const double* R1=bundle_reader.get_row(curr_linenumber+2);
+      const double* t=bundle_reader.get_row(curr_linenumber+4);
+      curr_linenumber += 5;
 
       double f=-fkk[0]/photograph_ptr->get_ydim();
       double kappa2=fkk[1];
@@ -1,10 +1,12 @@
 // =========================================================================
 // Sift_Detector class member function definitions
 // =========================================================================
-// Last modified on 4/3/14; 4/5/14; 4/11/15; 11/28/15
+// Last modified on 4/3/14; 4/5/14; 4/11/15; 11/28/15; 10/18/26
 // =========================================================================
 
+#include <algorithm>
 #include <map>
+#include <thread>
 #include "opencv2/core/core.hpp"
 #include "opencv2/features2d/features2d.hpp"
 #include "opencv2/highgui/highgui.hpp"
@@ -18,6 +20,7 @@
 #include "kdtree/ann_analyzer.h"
 #include "math/basic_math.h"
 #include "math/binaryfuncs.h"
+#include "image/convolution_engine.h"
 #include "general/filefuncs.h"
 #include "filter/filterfuncs.h"
 #include "math/fourvector.h"
@@ -27,12 +30,15 @@
 #include "math/ltduple.h"
 #include "math/lttwovector.h"
 #include "datastructures/map_unionfind.h"
+#include "datastructures/packed_descriptor.h"
 #include "math/mathfuncs.h"
 #include "numrec/nrfuncs.h"
 #include "video/photograph.h"
 #include "video/photogroup.h"
 #include "image/pngfuncs.h"
+#include "structmotion/ransac_engine.h"
 #include "video/RGB_analyzer.h"
+#include "video/image_pair_scheduler.h"
 #include "video/sift_detector.h"
 #include "general/stringfuncs.h"
 #include "general/sysfuncs.h"
@@ -71,7 +77,11 @@ void sift_detector::allocate_member_objects()
 void sift_detector::initialize_member_objects()
 {
    forward_feature_matching_flag=true;
-   num_threads=6;
+
+// Size worker thread pools from the hardware rather than assuming a
+// fixed number of cores:
+
+   num_threads=std::max(1U,std::thread::hardware_concurrency());
    max_n_features_to_consider_per_image=100000;
    sampson_error_flag=false;
    root_sift_matching_flag=true;
@@ -87,6 +97,7 @@ void sift_detector::initialize_member_objects()
 
    photogroup_ptr=NULL;
    akm_ptr=NULL;
+   pair_scheduler_ptr=NULL;
 
    ANN_ptr=NULL;
    inverse_ANN_ptr=NULL;
@@ -175,6 +186,7 @@ sift_detector::~sift_detector()
    delete inverse_ANN_ptr;
    delete H_ptr;
    delete fundamental_ptr;
+   delete pair_scheduler_ptr;
 
    for (unsigned int i=0; i<image_feature_info.size(); i++)
    {
@@ -1408,39 +1420,74 @@ void sift_detector::raw_match_OpenCV_FREAK_features(
    cv::Mat& descriptors1,cv::Mat& descriptors2,
    vector<cv::DMatch>& matches)
 {
-
-// Comment out this method for OpenCV 3.0.0
-
-/*
 //   cout << "inside sift_detector::raw_match_OpenCV_FREAK_features()" 
 //        << endl;
 
-// Here is an example on how to use the descriptor presented in the
-// following paper:
-// A. Alahi, R. Ortiz, and P. Vandergheynst. FREAK: Fast Retina
-// Keypoint. In IEEE Conference on Computer Vision and Pattern
-// Recognition, 2012.
-//
-//	Copyright (C) 2011-2012  Signal processing laboratory 2, EPFL,
-//	Kirell Benzi (kirell.benzi@epfl.ch),
-//	Raphael Ortiz (raphael.ortiz@a3.epfl.ch),
-//	Alexandre Alahi (alexandre.alahi@epfl.ch)
-//	and Pierre Vandergheynst (pierre.vandergheynst@epfl.ch)
+// cv::BruteForceMatcher<cv::Hamming> no longer exists in OpenCV 3.0.0.
+// So as of Oct 2026, we pack each CV_8U descriptor row into 64-bit
+// words and find nearest neighbors via a Hamming-distance VP tree
+// whose node separations are computed by POPCNT instructions.
 
-// Compute FREAK matching using standard Hamming distance as
-// BruteForceMatcher<Hamming> matcher;
-// or the proposed cascade of hamming distance using SSSE3
+   matches.clear();
+   if (descriptors1.rows==0 || descriptors2.rows==0) return;
 
-// FREAK descriptors do not appear to be supported in OpenCV 3.0.0
+   int n_bits=8*descriptors2.cols;
+   vector<packed_descriptor*> packed_descriptors2;
+   packed_descriptors2.reserve(descriptors2.rows);
+   for (int r=0; r<descriptors2.rows; r++)
+   {
+      packed_descriptor* packed_ptr=new packed_descriptor(
+         n_bits,descriptors2.ptr<unsigned char>(r));
+      packed_ptr->set_ID(r);
+      packed_descriptors2.push_back(packed_ptr);
+   }
 
-//   cv::BruteForceMatcher<cv::Hamming> matcher;
-//   matcher.match(descriptors1, descriptors2, matches);
+   vptree FREAK_vptree;
+   FREAK_vptree.construct_tree(packed_descriptors2);
 
-//   cout << "Raw FREAK matches = " << matches.size() << endl;
-//   outputfunc::enter_continue_char();
+   vector<packed_descriptor*> packed_descriptors1;
+   packed_descriptors1.reserve(descriptors1.rows);
+   for (int r=0; r<descriptors1.rows; r++)
+   {
+      packed_descriptors1.push_back(new packed_descriptor(
+         8*descriptors1.cols,descriptors1.ptr<unsigned char>(r)));
+   }
 
-*/
+// Query all rows of descriptors1 against the VP tree in parallel:
+
+   int n_threads=0;
+   vector<vector<int> > nearest_neighbor_node_IDs;
+   vector<vector<double> > query_to_neighbor_distances;
+   vector<vector<packed_descriptor*> > closest_ptrs;
+   FREAK_vptree.batch_knn(
+      packed_descriptors1,1,n_threads,nearest_neighbor_node_IDs,
+      query_to_neighbor_distances,closest_ptrs);
+
+// As for OpenCV's NORM_HAMMING brute force matcher, each DMatch's
+// distance equals the number of bits by which its two FREAK
+// descriptors differ.  batch_knn() performs an exact search when no
+// max_node_visits budget is imposed.  So this distance also equals
+// the tau value which find_closest_node() would previously have left
+// behind for the same query:
+
+   matches.reserve(descriptors1.rows);
+   for (int r=0; r<descriptors1.rows; r++)
+   {
+      matches.push_back(cv::DMatch(
+         r,closest_ptrs[r][0]->get_ID(),
+         float(query_to_neighbor_distances[r][0])));
+   }
+
+//   cout << "Raw FREAK matches = " << matches.size() << endl;
 
+   for (unsigned int i=0; i<packed_descriptors1.size(); i++)
+   {
+      delete packed_descriptors1[i];
+   }
+   for (unsigned int i=0; i<packed_descriptors2.size(); i++)
+   {
+      delete packed_descriptors2[i];
+   }
 }
 
 // ---------------------------------------------------------------------
@@ -1751,15 +1798,26 @@ vector<cv::KeyPoint> sift_detector::extract_harris_corners(
       } // loop over px 
    } // loop over py
 
+// Sum gaussian-weighted derivative products over windows surrounding
+// each pixel.  The separable gaussian kernel is applied via 1D passes:
+
    double dx=1;
    double sigma=1;
    double e_folding_distance=3;
    genmatrix* gaussian_filter_ptr=filterfunc::gaussian_2D_filter(
       dx,sigma,e_folding_distance);
-//   cout << "gaussian_filter = " << *gaussian_filter_ptr << endl;
-//   int n_rows=gaussian_filter_ptr->get_mdim();
    int n_columns=gaussian_filter_ptr->get_ndim();
-//   cout << "n_rows = " << n_rows << " n_columns = " << n_columns << endl;
+
+   twoDarray Sxx_twoDarray(xxderiv_twoDarray_ptr);
+   twoDarray Sxy_twoDarray(xyderiv_twoDarray_ptr);
+   twoDarray Syy_twoDarray(yyderiv_twoDarray_ptr);
+   convolution_engine engine(convolution_engine::interior_only);
+   engine.convolve(
+      gaussian_filter_ptr,xxderiv_twoDarray_ptr,&Sxx_twoDarray);
+   engine.convolve(
+      gaussian_filter_ptr,xyderiv_twoDarray_ptr,&Sxy_twoDarray);
+   engine.convolve(
+      gaussian_filter_ptr,yyderiv_twoDarray_ptr,&Syy_twoDarray);
 
    int n_offset=n_columns/2;
    int px_start=n_offset;
@@ -1769,35 +1827,18 @@ vector<cv::KeyPoint> sift_detector::extract_harris_corners(
    
    int n_corner_pixels=0;
    double kappa=0.05;
-   genmatrix M(2,2);
 
    vector<cv::KeyPoint> corner_pixel_keypoints;
    for (int py=py_start; py<py_stop; py++)
    {
       for (int px=px_start; px<px_stop; px++)
       {
-         M.clear_matrix_values();
+         double Sxx=Sxx_twoDarray.get(px,py);
+         double Sxy=Sxy_twoDarray.get(px,py);
+         double Syy=Syy_twoDarray.get(px,py);
 
-         for (int i=-n_offset; i<=n_offset; i++)
-         {
-            int qx=px+i;
-            for (int j=-n_offset; j<=n_offset; j++)
-            {
-               double w=gaussian_filter_ptr->get(i,j);
-
-               int qy=py+j;
-               double xxderiv=M.get(0,0)+w*xxderiv_twoDarray_ptr->get(qx,qy);
-               double xyderiv=M.get(0,1)+w*xyderiv_twoDarray_ptr->get(qx,qy);
-               double yyderiv=M.get(1,1)+w*yyderiv_twoDarray_ptr->get(qx,qy);
-               M.put(0,0,xxderiv);
-               M.put(0,1,xyderiv);
-               M.put(1,0,xyderiv);
-               M.put(1,1,yyderiv);
-            } // loop over j index
-         } // loop over i index
-
-         double detM=M.get(0,0)*M.get(1,1)-M.get(0,1)*M.get(1,0);
-         double traceM=M.get(0,0)+M.get(1,1);
+         double detM=Sxx*Syy-Sxy*Sxy;
+         double traceM=Sxx+Syy;
          double R=detM-kappa*sqr(traceM);
          
          if (R > R_min)
@@ -3343,43 +3384,45 @@ void sift_detector::identify_CHOG_feature_matches_for_image_pair(
 //   cout << "n_curr_features = " << n_curr_features << endl;
 //   outputfunc::enter_continue_char();   
 
-// Loop over all features within current image.  Find a candidate
-// feature within the next image as its tiepoint match.  Then inverse
-// map next image feature back to current image.  Only declare
-// candidate tiepoint pair if matching is one-to-one and onto:
+// Find candidate features within the next image as tiepoint matches
+// for all current image features via a single batched VP tree query.
+// Then inverse map surviving next image features back to the current
+// image via a second batched query.  Only declare candidate tiepoint
+// pair if matching is one-to-one and onto:
 
-   vector<int> nearest_neighbor_node_IDs;
-   vector<double> query_to_neighbor_distances;
-   vector<double> separation_distance_ratios;
-   vector<descriptor*> metric_space_element_ptrs;
+   vector<descriptor*> Dcurr_ptrs;
+   Dcurr_ptrs.reserve(n_curr_features);
    for (unsigned int f=0; f<n_curr_features; f++)
    {
-//      cout << "f = " << f << endl;
-      if (f%100==0) cout << f << " " << flush;
-      descriptor* Fcurr_ptr=currimage_feature_info[f].first;
-      descriptor* Dcurr_ptr=currimage_feature_info[f].second;
+      Dcurr_ptrs.push_back(currimage_feature_info[f].second);
+   }
 
-//      cout << "f = " << f
-//           << " Fcurr_ptr = " << Fcurr_ptr 
-//           << " Dcurr_ptr = " << Dcurr_ptr 
-//           << endl;
+   int n_threads=0;
+   vector<vector<int> > nearest_neighbor_node_IDs;
+   vector<vector<double> > query_to_neighbor_distances;
+   vector<vector<descriptor*> > metric_space_element_ptrs;
+   next_vptree_ptr->batch_knn(
+      Dcurr_ptrs,2,n_threads,nearest_neighbor_node_IDs,
+      query_to_neighbor_distances,metric_space_element_ptrs);
 
-      next_vptree_ptr->incrementally_find_nearest_nodes(
-         2,Dcurr_ptr,nearest_neighbor_node_IDs,query_to_neighbor_distances,
-         metric_space_element_ptrs);
+   vector<double> separation_distance_ratios;
+   vector<unsigned int> forward_match_indices;
+   vector<descriptor*> Dnext_ptrs,Fnext_ptrs;
+   for (unsigned int f=0; f<n_curr_features; f++)
+   {
       double neighbor_distance_ratio=
-         query_to_neighbor_distances[0]/query_to_neighbor_distances[1];
+         query_to_neighbor_distances[f][0]/query_to_neighbor_distances[f][1];
       separation_distance_ratios.push_back(neighbor_distance_ratio);
 
 //      cout << "f = " << f 
-//           << " sep distance 0 = " << query_to_neighbor_distances[0] 
-//           << " sep distance 1 = " << query_to_neighbor_distances[1] 
+//           << " sep distance 0 = " << query_to_neighbor_distances[f][0] 
+//           << " sep distance 1 = " << query_to_neighbor_distances[f][1] 
 //           << " ratio = " << separation_distance_ratios.back()
 //           << endl;
 
       if (neighbor_distance_ratio > max_ratio) continue;
 
-      descriptor* Dnext_ptr=metric_space_element_ptrs[0];
+      descriptor* Dnext_ptr=metric_space_element_ptrs[f][0];
       FEATURE_PAIR_MAP::iterator iter=
          nextimage_feature_pair_map.find(Dnext_ptr);
       if (iter == nextimage_feature_pair_map.end())
@@ -3387,23 +3430,24 @@ void sift_detector::identify_CHOG_feature_matches_for_image_pair(
          cout << "Error!" << endl;
          exit(-1);
       }
-      descriptor* Fnext_ptr=iter->second;
-
-      curr_vptree_ptr->incrementally_find_nearest_nodes(
-         2,Dnext_ptr,nearest_neighbor_node_IDs,query_to_neighbor_distances,
-         metric_space_element_ptrs);
-      neighbor_distance_ratio=
-         query_to_neighbor_distances[0]/query_to_neighbor_distances[1];
+      forward_match_indices.push_back(f);
+      Dnext_ptrs.push_back(Dnext_ptr);
+      Fnext_ptrs.push_back(iter->second);
+   } // loop over index f labeling features within currimage
 
-//      cout << "f = " << f 
-//           << " sep distance 0 = " << query_to_neighbor_distances[0] 
-//           << " sep distance 1 = " << query_to_neighbor_distances[1] 
-//           << endl;
+   curr_vptree_ptr->batch_knn(
+      Dnext_ptrs,2,n_threads,nearest_neighbor_node_IDs,
+      query_to_neighbor_distances,metric_space_element_ptrs);
 
+   for (unsigned int m=0; m<forward_match_indices.size(); m++)
+   {
+      double neighbor_distance_ratio=
+         query_to_neighbor_distances[m][0]/query_to_neighbor_distances[m][1];
       if (neighbor_distance_ratio > max_ratio) continue;
 
-      descriptor* Dcurrent_ptr=metric_space_element_ptrs[0];
-      iter=currimage_feature_pair_map.find(Dcurrent_ptr);
+      descriptor* Dcurrent_ptr=metric_space_element_ptrs[m][0];
+      FEATURE_PAIR_MAP::iterator iter=
+         currimage_feature_pair_map.find(Dcurrent_ptr);
       if (iter == currimage_feature_pair_map.end())
       {
          cout << "Error!" << endl;
@@ -3411,17 +3455,13 @@ void sift_detector::identify_CHOG_feature_matches_for_image_pair(
       }
       descriptor* Fcurrent_ptr=iter->second;
 
+      descriptor* Fcurr_ptr=
+         currimage_feature_info[forward_match_indices[m]].first;
       if (Fcurr_ptr != Fcurrent_ptr) continue;
 
-      candidate_tiepoint_pairs.push_back(feature_pair(Fcurr_ptr,Fnext_ptr));
-
-//      cout << "f = " << f 
-//           << " candidate_tiepoint_pair.size() = "
-//           << candidate_tiepoint_pairs.size()
-//           << " Dmatch_ptr = " << Dmatch_ptr 
-//           << " Fmatch_ptr = " << Fmatch_ptr << endl;
-
-   } // loop over index f labeling features within currimage
+      candidate_tiepoint_pairs.push_back(
+         feature_pair(Fcurr_ptr,Fnext_ptrs[m]));
+   } // loop over index m labeling forward matches
 //   cout << endl;
    delete curr_vptree_ptr;
    delete next_vptree_ptr;
@@ -3658,11 +3698,17 @@ int sift_detector::identify_candidate_FLANN_feature_matches_for_image_pair(
    const int min_SOH_corner_angle_matches=3;
 //   const int min_SOH_corner_angle_matches=4;
 
+// Prior to Oct 2026, binaryfunc::hamming_distance() compared only 32
+// of each descriptor's bits, and the maximum distance thresholds below
+// were tuned against that count.  Since all descriptor bits now
+// contribute, thresholds are rescaled by n_bits/32 so that the same
+// fraction of differing bits is accepted:
+
    int n_hamming_rejects=0;
 //   const int max_hamming_dist=9;
 //   const int max_hamming_dist=10;
 //   const int max_hamming_dist=11;
-   const int max_hamming_dist=12;
+   const double max_hamming_fraction=12.0/32.0;
 //   const int max_hamming_dist=25;
 //   const int max_hamming_dist=50;
 
@@ -3689,6 +3735,7 @@ int sift_detector::identify_candidate_FLANN_feature_matches_for_image_pair(
 // Reject tiepoint pair if its Hamming distance exceeds maximum
 // threshold:
 
+      int max_hamming_dist=max_hamming_fraction*Dcurr_ptr->get_mdim();
       int hamming_dist=binaryfunc::hamming_distance(Dcurr_ptr,Dnext_ptr);
       if (hamming_dist > max_hamming_dist)
       {
@@ -3785,19 +3832,25 @@ int sift_detector::identify_candidate_FLANN_feature_matches_for_image_pair(
 
    vector<pair<int,int> >* initial_SIFT_matches_ptr=
       curr_akm_ptr->get_initial_SIFT_matches_ptr();
+   const vector<float>* initial_SIFT_match_ratios_ptr=
+      curr_akm_ptr->get_initial_SIFT_match_ratios_ptr();
    unsigned int n_initial_matches=initial_SIFT_matches_ptr->size();
 //   cout << "n_initial_matches = " << n_initial_matches << endl;
 
    const int min_SOH_corner_angle_matches=3;
 //   const int min_SOH_corner_angle_matches=4;
 
+// Maximum Hamming distance threshold is rescaled by n_bits/32 as in
+// identify_candidate_FLANN_feature_matches_for_image_pair():
+
    int n_hamming_rejects=0;
 //   const int max_hamming_dist=9;
 //   const int max_hamming_dist=10;
-   const int max_hamming_dist=12;
+   const double max_hamming_fraction=12.0/32.0;
 
    int n_entropy_rejects=0;
 
+   vector<double> candidate_distance_ratios;
    curr_candidate_tiepoint_pairs.clear();
    for (unsigned int t=0; t<n_initial_matches; t++)
    {
@@ -3841,6 +3894,7 @@ int sift_detector::identify_candidate_FLANN_feature_matches_for_image_pair(
 // Reject tiepoint pair if its Hamming distance exceeds maximum
 // threshold:
 
+         int max_hamming_dist=max_hamming_fraction*Dcurr_ptr->get_mdim();
          int hamming_dist=binaryfunc::hamming_distance(Dcurr_ptr,Dnext_ptr);
          if (hamming_dist > max_hamming_dist)
          {
@@ -3869,9 +3923,22 @@ int sift_detector::identify_candidate_FLANN_feature_matches_for_image_pair(
       descriptor* Fnext_ptr=nextimage_feature_info_ptr->at(g).first;
       curr_candidate_tiepoint_pairs.push_back(
          feature_pair(Fcurr_ptr,Fnext_ptr));
+      candidate_distance_ratios.push_back(
+         initial_SIFT_match_ratios_ptr->at(t));
    } // loop over index t labeling tiepoint pairs
 //   cout << endl;
 
+// As of 10/18/26, we return candidate tiepoint pairs sorted by
+// increasing Lowe distance ratio.  PROSAC sampling within
+// compute_fundamental_matrix_via_RANSAC() draws its first hypotheses
+// from the most distinctive matches:
+
+   if (curr_candidate_tiepoint_pairs.size() > 1)
+   {
+      templatefunc::Quicksort(
+         candidate_distance_ratios,curr_candidate_tiepoint_pairs);
+   }
+
 //   double entropy_rejection_frac=double(n_entropy_rejects)/n_initial_matches;
 //   cout << "n_entropy_rejects = " << n_entropy_rejects << endl;
 //   cout << "entropy_rejection_frac = " << entropy_rejection_frac << endl;
@@ -4003,24 +4070,27 @@ void sift_detector::match_image_pair_features(
 }
 
 // ---------------------------------------------------------------------
-// On 5/21/13, Davis King reminded us that the following structure is
-// completely independent of the sift_detector class!  So to call
-// member functions of sift_detector, we must pass in a copy of *this
-// or equivalently the "this" pointer:
-
-struct function_object_match_image_pair_features
-{
-   function_object_match_image_pair_features( 
-      bool export_fundamental_matrices_flag_,
-      int i_,double sqrd_max_ratio_,
+// Structure image_pair_matching_task performs FLANN candidate matching
+// and fundamental matrix RANSAC for individual image pairs on
+// image_pair_scheduler worker threads.  Each pair's inliers are
+// buffered until the scheduler commits the pair in its serial order.
+// Buffers are reused modulo the scheduler's max_pending_pairs window.
+// So memory does not grow with the total number of pairs.
+// Only then are its features linked within *map_unionfind_ptr and its
+// tiepoints exported.  So neither the union-find structure nor
+// ntiepoints_stream is ever touched by two threads at once.
+
+struct image_pair_matching_task : public image_pair_task
+{
+   image_pair_matching_task(
+      bool export_fundamental_matrices_flag_,double sqrd_max_ratio_,
       double worst_frac_to_reject_,double max_scalar_product_,
       int max_n_good_RANSAC_iters_,int min_candidate_tiepoints_,
       int minimal_number_of_inliers_,string bundler_IO_subdir_,
-      map_unionfind* map_unionfind_ptr_,
-      ofstream& ntiepoints_stream_,
-      sift_detector* this_ptr_) :
+      map_unionfind* map_unionfind_ptr_,ofstream& ntiepoints_stream_,
+      int n_slots_,sift_detector* this_ptr_) :
       export_fundamental_matrices_flag(export_fundamental_matrices_flag_),
-         i(i_),sqrd_max_ratio(sqrd_max_ratio_),
+         sqrd_max_ratio(sqrd_max_ratio_),
          worst_frac_to_reject(worst_frac_to_reject_),
          max_scalar_product(max_scalar_product_),
          max_n_good_RANSAC_iters(max_n_good_RANSAC_iters_),
@@ -4029,97 +4099,101 @@ struct function_object_match_image_pair_features
          bundler_IO_subdir(bundler_IO_subdir_),
          map_unionfind_ptr(map_unionfind_ptr_),
          ntiepoints_stream(ntiepoints_stream_),
-	 this_ptr(this_ptr_)  {}
+         n_slots(n_slots_),
+         fundamental_ptrs(n_slots_,static_cast<fundamental*>(NULL)),
+         inlier_tiepoint_pairs(n_slots_),
+         this_ptr(this_ptr_)  {}
 
       bool export_fundamental_matrices_flag;
-      int i,max_n_good_RANSAC_iters,min_candidate_tiepoints,
-         minimal_number_of_inliers;
       double sqrd_max_ratio,worst_frac_to_reject,max_scalar_product;
+      int max_n_good_RANSAC_iters,min_candidate_tiepoints,
+         minimal_number_of_inliers;
       string bundler_IO_subdir;      
       map_unionfind* map_unionfind_ptr;
-      sift_detector* this_ptr;
       ofstream& ntiepoints_stream;
-//      dlib::mutex m;
 
-      void operator() (long j) const
-      {
-//         cout << "inside function_object_match_image_pair_features()"
-//              << endl;
-//         cout << "i = " << i << " j = " << j << endl;
+// Per-pair results indexed by pair_index modulo n_slots.  A non-NULL
+// fundamental_ptrs entry indicates that inliers were found:
 
+      int n_slots;
+      vector<fundamental*> fundamental_ptrs;
+      vector<vector<sift_detector::feature_pair> > inlier_tiepoint_pairs;
+      sift_detector* this_ptr;
 
+      void process_pair(int pair_index,int i,int j)
+      {
          akm* curr_akm_ptr=new akm();      
-         curr_akm_ptr->load_SIFT_descriptors(
-            this_ptr->get_image_feature_info_ptr(i));
-         curr_akm_ptr->load_SIFT_descriptors2(
-            this_ptr->get_image_feature_info_ptr(j));
-
-         if (this_ptr->get_forward_feature_matching_flag())
-         {
-// FORWARD SIFT searches match SIFT features from image i with those
-// from image j > i :
+         bool valid_input_image_pair_flag=
+            curr_akm_ptr->load_SIFT_descriptors(
+               this_ptr->get_image_feature_info_ptr(i)) &&
+            curr_akm_ptr->load_SIFT_descriptors2(
+               this_ptr->get_image_feature_info_ptr(j));
 
-            curr_akm_ptr->initialize_forward_SIFT_feature_search();
-         }
-         else
+         int n_candidate_matches=0;
+         vector<sift_detector::feature_pair> curr_candidate_tiepoint_pairs;
+         if (valid_input_image_pair_flag)
          {
-// BACKWARD SIFT searches match SIFT features from image j > i with
-// those from image i:
+            if (this_ptr->get_forward_feature_matching_flag())
+            {
+               curr_akm_ptr->initialize_forward_SIFT_feature_search();
+            }
+            else
+            {
+               curr_akm_ptr->initialize_backward_SIFT_feature_search();
+            }
 
-            curr_akm_ptr->initialize_backward_SIFT_feature_search();
+            n_candidate_matches=this_ptr->
+               identify_candidate_FLANN_feature_matches_for_image_pair(
+                  curr_akm_ptr,sqrd_max_ratio,
+                  this_ptr->get_image_feature_info_ptr(i),
+                  this_ptr->get_image_feature_info_ptr(j),
+                  curr_candidate_tiepoint_pairs);
          }
+         delete curr_akm_ptr;
 
-//         outputfunc::print_elapsed_time();
-         string banner="Matching features from image "+
-            stringfunc::number_to_string(i)+" with those from image "+
-            stringfunc::number_to_string(j);
-         outputfunc::write_banner(banner);
-
-         vector<sift_detector::feature_pair> curr_candidate_tiepoint_pairs;
-         int n_candidate_matches=
-            this_ptr->identify_candidate_FLANN_feature_matches_for_image_pair(
-               curr_akm_ptr,sqrd_max_ratio,
-               this_ptr->get_image_feature_info_ptr(i),
-               this_ptr->get_image_feature_info_ptr(j),
-               curr_candidate_tiepoint_pairs);
-
-         cout << "******************************************************" 
-              << endl;
-         cout << "i = " << i << " j = " << j 
-              << " n_candidate_matches = " << n_candidate_matches << endl;
-         cout << "******************************************************" 
-              << endl;
+         if (n_candidate_matches == 0) return;
 
-         vector<sift_detector::feature_pair> curr_inlier_tiepoint_pairs;
-         if (n_candidate_matches > 0)
+         int slot=pair_index%n_slots;
+         fundamental* curr_fundamental_ptr=new fundamental();
+         if (this_ptr->identify_inlier_matches_via_fundamental_matrix(
+                i,j,curr_candidate_tiepoint_pairs,
+                inlier_tiepoint_pairs[slot],curr_fundamental_ptr,
+                worst_frac_to_reject,max_scalar_product,
+                max_n_good_RANSAC_iters,min_candidate_tiepoints,
+                minimal_number_of_inliers))
          {
-            fundamental curr_fundamental;
+            fundamental_ptrs[slot]=curr_fundamental_ptr;
+         }
+         else
+         {
+            delete curr_fundamental_ptr;
+            inlier_tiepoint_pairs[slot].clear();
+         }
+      }
 
-            if (this_ptr->identify_inlier_matches_via_fundamental_matrix(
-               i,j,curr_candidate_tiepoint_pairs,curr_inlier_tiepoint_pairs,
-               &curr_fundamental,worst_frac_to_reject,
-               max_scalar_product,max_n_good_RANSAC_iters,
-               min_candidate_tiepoints,minimal_number_of_inliers)) 
-            {
-               if (export_fundamental_matrices_flag)
-                  this_ptr->export_fundamental_matrix(
-                     &curr_fundamental,bundler_IO_subdir,i,j);
-               this_ptr->link_matching_node_IDs(
-                  i,j,curr_inlier_tiepoint_pairs,map_unionfind_ptr);
+      void commit_pair(int pair_index,int i,int j)
+      {
+         int slot=pair_index%n_slots;
+         fundamental* curr_fundamental_ptr=fundamental_ptrs[slot];
+         if (curr_fundamental_ptr==NULL) return;
 
-               int n_duplicate_features=0;
-               string tiepoints_subdir=bundler_IO_subdir+"tiepoints/";
-               this_ptr->export_feature_tiepoints(
-                  i,j,curr_inlier_tiepoint_pairs,tiepoints_subdir,
-                  this_ptr->get_photogroup_ptr(),n_duplicate_features,
-                  map_unionfind_ptr,ntiepoints_stream);
-            }
+         if (export_fundamental_matrices_flag)
+            this_ptr->export_fundamental_matrix(
+               curr_fundamental_ptr,bundler_IO_subdir,i,j);
+         this_ptr->link_matching_node_IDs(
+            i,j,inlier_tiepoint_pairs[slot],map_unionfind_ptr);
 
-         } // n_candidate_matches > 0 conditional
+         int n_duplicate_features=0;
+         string tiepoints_subdir=bundler_IO_subdir+"tiepoints/";
+         this_ptr->export_feature_tiepoints(
+            i,j,inlier_tiepoint_pairs[slot],tiepoints_subdir,
+            this_ptr->get_photogroup_ptr(),n_duplicate_features,
+            map_unionfind_ptr,ntiepoints_stream);
 
-         delete curr_akm_ptr;
-//         cout << "Finished matching i = " << i << " with j = " << j 
-//              << endl;
+         delete curr_fundamental_ptr;
+         fundamental_ptrs[slot]=NULL;
+         vector<sift_detector::feature_pair>().swap(
+            inlier_tiepoint_pairs[slot]);
       }
 };
 
@@ -4132,13 +4206,101 @@ void sift_detector::parallel_match_image_pair_features(
    int minimal_number_of_inliers,string bundler_IO_subdir,
    map_unionfind* map_unionfind_ptr,ofstream& ntiepoints_stream)
 {
-   function_object_match_image_pair_features funct(
-      export_fundamental_matrices_flag,
-      i,sqrd_max_ratio,worst_frac_to_reject,
+   image_pair_scheduler* scheduler_ptr=get_pair_scheduler_ptr();
+   scheduler_ptr->clear_pairs();
+   double n_features_i=get_image_feature_info_ptr(i)->size();
+   for (int j=j_start; j<j_stop; j++)
+   {
+      double n_features_j=get_image_feature_info_ptr(j)->size();
+      scheduler_ptr->add_pair(i,j,n_features_i*n_features_j);
+   }
+
+   run_image_pair_matching(
+      export_fundamental_matrices_flag,sqrd_max_ratio,worst_frac_to_reject,
       max_scalar_product,max_n_good_RANSAC_iters,min_candidate_tiepoints,
-      minimal_number_of_inliers,
-      bundler_IO_subdir,map_unionfind_ptr,ntiepoints_stream,this);
-   dlib::parallel_for(num_threads, j_start, j_stop, funct);
+      minimal_number_of_inliers,bundler_IO_subdir,map_unionfind_ptr,
+      ntiepoints_stream);
+}
+
+// ---------------------------------------------------------------------
+// Member function scheduled_match_image_pair_features() matches
+// features for every image pair (i,j) with i_start <= i < i_stop and
+// i < j < n_images.  The entire O(n**2) pair list is streamed into a
+// single work-stealing pool run.  Each pair's cost is estimated as the
+// product of its two images' feature counts.  Inlier tiepoints are
+// linked and exported in the same (i,j) order as a serial loop.  So
+// reorder_parallelized_tiepoints_file() no longer needs to be called
+// afterwards.
+
+void sift_detector::scheduled_match_image_pair_features(
+   bool export_fundamental_matrices_flag,
+   int i_start,int i_stop,double sqrd_max_ratio,
+   double worst_frac_to_reject,double max_scalar_product,
+   int max_n_good_RANSAC_iters,int min_candidate_tiepoints,
+   int minimal_number_of_inliers,string bundler_IO_subdir,
+   map_unionfind* map_unionfind_ptr,ofstream& ntiepoints_stream)
+{
+   string banner="Matching image pairs via "+
+      stringfunc::number_to_string(num_threads)+" worker threads";
+   outputfunc::write_banner(banner);
+
+   image_pair_scheduler* scheduler_ptr=get_pair_scheduler_ptr();
+   scheduler_ptr->clear_pairs();
+   for (int i=i_start; i<i_stop; i++)
+   {
+      double n_features_i=get_image_feature_info_ptr(i)->size();
+      for (int j=i+1; j<int(n_images); j++)
+      {
+         double n_features_j=get_image_feature_info_ptr(j)->size();
+         scheduler_ptr->add_pair(i,j,n_features_i*n_features_j);
+      }
+   }
+
+   run_image_pair_matching(
+      export_fundamental_matrices_flag,sqrd_max_ratio,worst_frac_to_reject,
+      max_scalar_product,max_n_good_RANSAC_iters,min_candidate_tiepoints,
+      minimal_number_of_inliers,bundler_IO_subdir,map_unionfind_ptr,
+      ntiepoints_stream);
+}
+
+// ---------------------------------------------------------------------
+// Private member function get_pair_scheduler_ptr() returns a
+// persistent worker pool containing num_threads threads.  The pool is
+// only rebuilt if num_threads has been reset since its construction.
+
+image_pair_scheduler* sift_detector::get_pair_scheduler_ptr()
+{
+   if (pair_scheduler_ptr != NULL && 
+       int(pair_scheduler_ptr->get_n_threads()) != num_threads)
+   {
+      delete pair_scheduler_ptr;
+      pair_scheduler_ptr=NULL;
+   }
+   if (pair_scheduler_ptr==NULL)
+   {
+      pair_scheduler_ptr=new image_pair_scheduler(num_threads);
+   }
+   return pair_scheduler_ptr;
+}
+
+// ---------------------------------------------------------------------
+// Private member function run_image_pair_matching() matches every
+// pair currently held within *pair_scheduler_ptr via
+// image_pair_matching_task.
+
+void sift_detector::run_image_pair_matching(
+   bool export_fundamental_matrices_flag,double sqrd_max_ratio,
+   double worst_frac_to_reject,double max_scalar_product,
+   int max_n_good_RANSAC_iters,int min_candidate_tiepoints,
+   int minimal_number_of_inliers,string bundler_IO_subdir,
+   map_unionfind* map_unionfind_ptr,ofstream& ntiepoints_stream)
+{
+   image_pair_matching_task task(
+      export_fundamental_matrices_flag,sqrd_max_ratio,worst_frac_to_reject,
+      max_scalar_product,max_n_good_RANSAC_iters,min_candidate_tiepoints,
+      minimal_number_of_inliers,bundler_IO_subdir,map_unionfind_ptr,
+      ntiepoints_stream,pair_scheduler_ptr->get_max_pending_pairs(),this);
+   pair_scheduler_ptr->run(&task);
 }
 
 // ---------------------------------------------------------------------
@@ -4630,6 +4792,11 @@ bool sift_detector::identify_inlier_matches_via_fundamental_matrix(
 // approach.  If a minimal number of inlier tiepoint pairs is not
 // found, this boolean method returns false.
 
+// As of 10/18/26, Sampson error RANSAC is delegated to a
+// ransac_engine which terminates adaptively once the inlier fraction
+// warrants.  max_n_good_RANSAC_iters then only caps the number of
+// hypotheses.
+
 bool sift_detector::compute_fundamental_matrix_via_RANSAC(
    const vector<twovector>& tiepoint_UV,
    const vector<twovector>& tiepoint_UVmatch,
@@ -4646,39 +4813,68 @@ bool sift_detector::compute_fundamental_matrix_via_RANSAC(
 //   cout << "Before entering RANSAC loop" << endl;
 
    max_n_inliers=0;
-   int n_iters=0;
-   int n_good_iters=0;
-   int n_7pt_failures=0;
-   while (n_good_iters < max_n_good_RANSAC_iters)
+   if (sampson_error_flag)
    {
-      n_iters++;
-      double seed=n_iters;
-      dlib::random_subset_selector<feature_pair> tiepoint_samples=
-         dlib::randomly_subsample(
-            curr_candidate_tiepoint_pairs,7,seed);
+      fundamental_ransac_model fundamental_model;
+      ransac_engine RANSAC_engine(&fundamental_model);
+      RANSAC_engine.set_max_n_iters(max_n_good_RANSAC_iters);
+      RANSAC_engine.set_tiepoints(tiepoint_UV,tiepoint_UVmatch);
 
-      if (!compute_seven_point_fundamental_matrix(
-         tiepoint_samples,curr_fundamental_ptr,thread_i,thread_j))
+      if (RANSAC_engine.estimate(max_scalar_product))
       {
-         n_7pt_failures++;
-//         if (thread_i==0 && thread_j==1)
-//         {
-//            cout << "i = " << thread_i << " j = " << thread_j
-//                 << " n_7pt_failures = " << n_7pt_failures << endl;
-//         }
-         continue;
+         const double* F=RANSAC_engine.get_best_model();
+         genmatrix Fbest(3,3);
+         for (unsigned int r=0; r<3; r++)
+         {
+            for (unsigned int c=0; c<3; c++)
+            {
+               Fbest.put(r,c,F[3*r+c]);
+            }
+         }
+         curr_fundamental_ptr->set_F_values(Fbest);
+         curr_fundamental_ptr->set_Fbest(curr_fundamental_ptr->get_F_ptr());
+
+         min_RANSAC_cost=RANSAC_engine.get_min_cost();
+         max_n_inliers=RANSAC_engine.get_n_inliers();
+         const vector<int>& inlier_indices=
+            RANSAC_engine.get_inlier_indices();
+         curr_inlier_tiepoint_pairs.clear();
+         for (unsigned int f=0; f<inlier_indices.size(); f++)
+         {
+            curr_inlier_tiepoint_pairs.push_back(
+               curr_candidate_tiepoint_pairs[inlier_indices[f]]);
+         }
       }
-    
-//      if (n_good_iters%10==0) cout << n_good_iters/10 << " " << flush;
+//      cout << RANSAC_engine << endl;
+   }
+   else
+   {
+      int n_iters=0;
+      int n_good_iters=0;
+      int n_7pt_failures=0;
+      while (n_good_iters < max_n_good_RANSAC_iters)
+      {
+         n_iters++;
+         double seed=n_iters;
+         dlib::random_subset_selector<feature_pair> tiepoint_samples=
+            dlib::randomly_subsample(
+               curr_candidate_tiepoint_pairs,7,seed);
 
-      identify_inliers_via_fundamental_matrix(
-         max_scalar_product,tiepoint_UV,tiepoint_UVmatch,
-         curr_candidate_tiepoint_pairs,curr_inlier_tiepoint_pairs,
-         curr_fundamental_ptr,min_RANSAC_cost,thread_i,thread_j);
+         if (!compute_seven_point_fundamental_matrix(
+            tiepoint_samples,curr_fundamental_ptr,thread_i,thread_j))
+         {
+            n_7pt_failures++;
+            continue;
+         }
+    
+         identify_inliers_via_fundamental_matrix(
+            max_scalar_product,tiepoint_UV,tiepoint_UVmatch,
+            curr_candidate_tiepoint_pairs,curr_inlier_tiepoint_pairs,
+            curr_fundamental_ptr,min_RANSAC_cost,thread_i,thread_j);
 
-      n_good_iters++;
-//      cout << "n_good_iters = " << n_good_iters << endl;
-   } // while loop
+         n_good_iters++;
+      } // while loop
+   }
    cout << endl;
 
 //   int minimal_number_of_inliers=10;
@@ -5569,8 +5765,11 @@ int sift_detector::identify_candidate_SOH_feature_matches_for_image_pair(
 //        << endl;
 //   outputfunc::print_elapsed_time();
 
+// Maximum Hamming distance threshold is rescaled by n_bits/32 as in
+// identify_candidate_FLANN_feature_matches_for_image_pair():
+
    int n_matches=0;
-   unsigned int max_hamming_dist=1;
+   const double max_hamming_fraction=1.0/32.0;
 //   int max_hamming_dist=5;
 //   int max_hamming_dist=12;
    for (unsigned int f=0; f<currimage_feature_info.size(); f++)
@@ -5582,6 +5781,8 @@ int sift_detector::identify_candidate_SOH_feature_matches_for_image_pair(
          descriptor* Fnext_ptr=nextimage_feature_info[g].first;
          descriptor* Dnext_ptr=nextimage_feature_info[g].second;
 
+         unsigned long max_hamming_dist=
+            max_hamming_fraction*Dcurr_ptr->get_mdim();
          unsigned long hamming_dist=binaryfunc::hamming_distance(
             Dcurr_ptr,Dnext_ptr);
          if (hamming_dist > max_hamming_dist) continue;
@@ -5984,7 +6185,6 @@ bool sift_detector::compute_homography_via_RANSAC(
    cout << "inside compute_homography_via_RANSAC()" << endl;
 
    max_n_inliers=0;
-   int n_good_iters=0;
 
 //   int max_n_good_RANSAC_iters=100;	       
 //   int max_n_good_RANSAC_iters=1000;	       
@@ -5993,15 +6193,27 @@ bool sift_detector::compute_homography_via_RANSAC(
 //   int max_n_good_RANSAC_iters=25000;	       
    inlier_tiepoint_pairs.clear();
 
-   while (n_good_iters < max_n_good_RANSAC_iters)
+// As of 10/18/26, RANSAC iterations terminate adaptively.  So
+// max_n_good_RANSAC_iters only caps the number of hypotheses:
+
+   vector<twovector> tiepoint_UV,tiepoint_UVmatch;
+   store_tiepoint_twovectors(
+      curr_candidate_tiepoint_pairs,tiepoint_UV,tiepoint_UVmatch);
+
+   homography_ransac_model homography_model;
+   ransac_engine RANSAC_engine(&homography_model);
+   RANSAC_engine.set_max_n_iters(max_n_good_RANSAC_iters);
+   RANSAC_engine.set_tiepoints(tiepoint_UV,tiepoint_UVmatch);
+   if (RANSAC_engine.estimate(max_sqrd_delta))
    {
-      compute_four_point_homography(curr_candidate_tiepoint_pairs);
-      identify_inliers_via_homography(
-         curr_candidate_tiepoint_pairs,max_sqrd_delta);
-      n_good_iters++;
-//      cout << "n_good_iters = " << n_good_iters << endl;
-   } // while loop
-   cout << endl;
+      max_n_inliers=RANSAC_engine.get_n_inliers();
+      const vector<int>& inlier_indices=RANSAC_engine.get_inlier_indices();
+      for (unsigned int f=0; f<inlier_indices.size(); f++)
+      {
+         inlier_tiepoint_pairs.push_back(
+            curr_candidate_tiepoint_pairs[inlier_indices[f]]);
+      }
+   }
 
    int minimal_number_of_inliers=10;
 //   int minimal_number_of_inliers=25;
@@ -8283,7 +8495,10 @@ void sift_detector::binary_quantize_SIFT_descriptors()
 }
 
 // ---------------------------------------------------------------------
-// Member function generate_VPtrees()
+// Member function generate_VPtrees() builds one Hamming-distance VP
+// tree per image from the binary quantized descriptors in
+// Dbinary_ptrs.  vptree::construct_tree() packs these into 64-bit
+// words so that node separations are counted via POPCNT.
 
 void sift_detector::generate_VPtrees()
 {
@@ -1,7 +1,7 @@
 // ==========================================================================
 // Header file for sift_detector class
 // ==========================================================================
-// Last modified on 12/17/13; 12/23/13; 3/30/14; 4/3/14
+// Last modified on 12/17/13; 12/23/13; 3/30/14; 4/3/14; 10/18/26
 // ==========================================================================
 
 #ifndef SIFT_DETECTOR_H
@@ -29,6 +29,7 @@ class ann_analyzer;
 class camera;
 class fundamental;
 class homography;
+class image_pair_scheduler;
 class map_unionfind;
 class photograph;
 class photogroup;
@@ -349,6 +350,13 @@ class sift_detector
       int max_n_good_RANSAC_iters,int min_candidate_tiepoints,
       int minimal_number_of_inliers,std::string bundler_IO_subdir,
       map_unionfind* map_unionfind_ptr,std::ofstream& ntiepoints_stream);
+   void scheduled_match_image_pair_features(
+      bool export_fundamental_matrices_flag,
+      int i_start,int i_stop,double sqrd_max_ratio,
+      double worst_frac_to_reject,double max_scalar_product,
+      int max_n_good_RANSAC_iters,int min_candidate_tiepoints,
+      int minimal_number_of_inliers,std::string bundler_IO_subdir,
+      map_unionfind* map_unionfind_ptr,std::ofstream& ntiepoints_stream);
    void match_successive_image_features(
       int i,int j,double sqrd_max_ratio,
       double worst_frac_to_reject,double max_scalar_product,
@@ -651,6 +659,7 @@ class sift_detector
 
    homography* H_ptr;
    fundamental* fundamental_ptr;
+   image_pair_scheduler* pair_scheduler_ptr;
 
    FEATURES_MAP features_map;
    CANDIDATE_TIEPOINT_CURRFEATURE_IDS_MAP 
@@ -673,6 +682,13 @@ class sift_detector
    void destroy_allocated_features_for_specified_image(
       std::vector<feature_pair>* currimage_feature_info_ptr);
    void initialize_ANN_analyzers();
+   image_pair_scheduler* get_pair_scheduler_ptr();
+   void run_image_pair_matching(
+      bool export_fundamental_matrices_flag,double sqrd_max_ratio,
+      double worst_frac_to_reject,double max_scalar_product,
+      int max_n_good_RANSAC_iters,int min_candidate_tiepoints,
+      int minimal_number_of_inliers,std::string bundler_IO_subdir,
+      map_unionfind* map_unionfind_ptr,std::ofstream& ntiepoints_stream);
 
    double bin_features_into_quadrants(int n_min_quadrant_features);
    int identify_candidate_feature_matches_for_image_pair(
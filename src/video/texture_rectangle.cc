@@ -9,7 +9,7 @@
 // ========================================================================
 // texture_rectangle provides functionality for displaying video files.
 // ========================================================================
-// Last updated on 8/1/16; 8/5/16; 8/9/16; 8/28/16
+// Last updated on 8/1/16; 8/5/16; 8/9/16; 8/28/16; 10/18/26
 // ========================================================================
 
 #include <iostream>
@@ -29,6 +29,7 @@
 #include "math/basic_math.h"
 #include "geometry/bounding_box.h"
 #include "color/colorfuncs.h"
+#include "video/colorspacefuncs.h"
 #include "osg/osgSceneGraph/ColorMap.h"
 #include "distance_transform/dtfuncs.h"
 #include "image/extremal_region.h"
@@ -788,6 +789,12 @@ void texture_rectangle::initialize_G99_video()
    m_g99Video = new VidFile( video_filename );
    m_g99Video->query_structure_values(); // print out video information
 
+// Frames surrounding the currently displayed one are read on a
+// background thread so that scrubbing in either direction rarely
+// waits upon the disk:
+
+   m_g99Video->enable_prefetching();
+
    setWidth(m_g99Video->getWidth());
    setHeight(m_g99Video->getHeight());
 
@@ -2969,65 +2976,21 @@ void texture_rectangle::convert_color_image_to_h_s_or_v(int color_channel)
 
    instantiate_ptwoDarray_ptr();
 
-   unsigned int n_channels=getNchannels();
-//   cout << "n_channels = " << n_channels << endl;
-   
-   int R,G,B,A;
-   R=G=B=A=0;
-   double h,s,v;
-   for (unsigned int pu=0; pu<getWidth(); pu++)
-   {
-      for (unsigned int pv=0; pv<getHeight(); pv++)
-      {
-         if (n_channels==4)
-         {
-            get_pixel_RGBA_values(pu,pv,image_refptr->data(),R,G,B,A);
-         }
-         else
-         {
-            get_pixel_RGB_values(pu,pv,image_refptr->data(),R,G,B);
-            A=-255;
-         }
+// Convert all pixels via row-major kernels rather than per-pixel get
+// and set calls:
 
-         double r=R/255.0;
-         double g=G/255.0;
-         double b=B/255.0;
-         double a=A/255.0;
-//         cout << "r = " << r << " g = " << g << " b = " << b
-//              << " a = " << a << endl;
+   unsigned int width=getWidth();
+   unsigned int height=getHeight();
+   unsigned int n_channels=getNchannels();
+   vector<unsigned char> grey_values(width*height);
 
-         if (n_channels==4 && nearly_equal(a,0))
-         {
-            R=G=B=A=0;
-//            R=G=B=A=255;
-         }
-         else
-         {
-            colorfunc::RGB_to_hsv(r,g,b,h,s,v);
-            if (color_channel==0)
-            {
-               R=G=B=255*h/360.0;
-            }
-            else if (color_channel==1)
-            {
-               R=G=B=255*s;
-            }
-            else if (color_channel==2)
-            {
-               R=G=B=255*v;
-            }
-         }
-         if (n_channels==4)
-         {
-            set_pixel_RGBA_values(pu,pv,image_refptr->data(),R,G,B,A);
-         }
-         else
-         {
-            set_pixel_RGB_values(pu,pv,image_refptr->data(),R,G,B);
-         }
-         ptwoDarray_ptr->put(pu,pv,R);
-      }
-   }
+   colorspacefunc::RGB_to_h_s_or_v(
+      image_refptr->data(),width,height,n_channels,color_channel,
+      &grey_values[0]);
+   colorspacefunc::replicate_grey_values(
+      &grey_values[0],width,height,n_channels,image_refptr->data());
+   colorspacefunc::copy_grey_values_to_twoDarray(
+      &grey_values[0],width,height,ptwoDarray_ptr);
 
    image_refptr->dirty();
 }
@@ -3094,47 +3057,17 @@ void texture_rectangle::convert_color_image_to_luminosity()
 
    instantiate_ptwoDarray_ptr();
 
+   unsigned int width=getWidth();
+   unsigned int height=getHeight();
    unsigned int n_channels=getNchannels();
-//   cout << "n_channels = " << n_channels << endl;
-   
-   int R,G,B,A;
-   R=G=B=A=0;
-   for (unsigned int pu=0; pu<getWidth(); pu++)
-   {
-      for (unsigned int pv=0; pv<getHeight(); pv++)
-      {
-         if (n_channels==4)
-         {
-            get_pixel_RGBA_values(pu,pv,image_refptr->data(),R,G,B,A);
-         }
-         else
-         {
-            get_pixel_RGB_values(pu,pv,image_refptr->data(),R,G,B);
-            A=-255;
-         }
+   vector<unsigned char> grey_values(width*height);
 
-         if (n_channels==4 && A==0)
-         {
-            R=G=B=A=0;
-         }
-         else
-         {
-            double Luminosity=colorfunc::RGB_to_luminosity(R,G,B);
-            if (Luminosity > 255) Luminosity=255;
-            R=G=B=Luminosity;
-         }
-
-         if (n_channels==4)
-         {
-            set_pixel_RGBA_values(pu,pv,image_refptr->data(),R,G,B,A);
-         }
-         else
-         {
-            set_pixel_RGB_values(pu,pv,image_refptr->data(),R,G,B);
-         }
-         ptwoDarray_ptr->put(pu,pv,R);
-      }
-   }
+   colorspacefunc::RGB_to_luminosity(
+      image_refptr->data(),width,height,n_channels,&grey_values[0]);
+   colorspacefunc::replicate_grey_values(
+      &grey_values[0],width,height,n_channels,image_refptr->data());
+   colorspacefunc::copy_grey_values_to_twoDarray(
+      &grey_values[0],width,height,ptwoDarray_ptr);
 
    image_refptr->dirty();
 }
@@ -3163,44 +3096,9 @@ void texture_rectangle::convert_grey_values_to_hues(
 //   cout << "inside texture_rectangle::convert_grey_values_to_hues()"
 //	  << endl;
 
-   int R,G,B;
-   double h,s,v;
-   R=G=B=0;
-   for (unsigned int pu=0; pu<getWidth(); pu++)
-   {
-      for (unsigned int pv=0; pv<getHeight(); pv++)
-      {
-         get_pixel_RGB_values(pu,pv,image_refptr->data(),R,G,B);
-
-         if (R < 1 && G < 1 && B < 1) continue;
-         
-//	 cout << "R = " << R << " G = " << G << " B = " << B << endl;
-
-         double r=R/255.0;
-         double g=G/255.0;
-         double b=B/255.0;
-         colorfunc::RGB_to_hsv(r,g,b,h,s,v);
-         double new_hue=hue_min+(hue_max-hue_min)*v;
-
-/*
-         cout << "R = " << R << " G = " << G << " B = " << B << endl;
-         cout << "h = " << h << " s = " << s << " v = " << v << endl;
-         cout << " new_hue = " << new_hue << endl;
-         outputfunc::enter_continue_char();
-*/
-
-         s=1;	// Recall s = 0 corresponds to grey scale!
-         v=0.5+0.5*v;
-
-         colorfunc::HSV hsv(new_hue,s,v);
-         colorfunc::RGB rgb=colorfunc::hsv_to_RGB(hsv);
-
-         R=255*rgb.first;
-         G=255*rgb.second;
-         B=255*rgb.third;
-         set_pixel_RGB_values(pu,pv,image_refptr->data(),R,G,B);
-      }
-   }
+   colorspacefunc::grey_values_to_hues(
+      image_refptr->data(),getWidth(),getHeight(),getNchannels(),
+      hue_min,hue_max);
    image_refptr->dirty();
 }
 
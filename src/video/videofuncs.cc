@@ -7,7 +7,7 @@
 // ==========================================================================
 // Videofuncs namespace method definitions
 // ==========================================================================
-// Last modified on 8/1/16; 8/19/16; 9/6/16; 9/10/16
+// Last modified on 8/1/16; 8/19/16; 9/6/16; 9/10/16; 10/18/26
 // ==========================================================================
 
 #include <iostream>
@@ -30,6 +30,7 @@
 #include "image/lsd.h"
 #include "math/mathfuncs.h"
 #include "messenger/Messenger.h"
+#include "general/numeric_text_reader.h"
 #include "templates/mytemplates.h"
 #include "general/outputfuncs.h"
 #include "video/pa_struct.h"
@@ -1080,12 +1081,15 @@ namespace videofunc
     XYZ_ID.clear();
     UV_sift.clear();
    
-    filefunc::ReadInfile(camera_views_filename);
-    for (unsigned int i=0; i<filefunc::text_line.size(); i++)
-    {
-      //      cout << "i = " << i << " line = " << filefunc::text_line[i] << endl;
-      vector<double> fields=
-        stringfunc::string_to_numbers(filefunc::text_line[i]);
+    numeric_text_reader views_reader(camera_views_filename);
+    unsigned int n_rows=views_reader.get_n_rows();
+    photo_ID.reserve(n_rows);
+    XYZ_ID.reserve(n_rows);
+    UV_sift.reserve(n_rows);
+    for (unsigned int i=0; i<n_rows; i++)
+    {
+      //      cout << "i = " << i << " line = " << views_reader.get_line(i) << endl;
+      const double* fields=views_reader.get_row(i);
       photo_ID.push_back(fields[0]);
       XYZ_ID.push_back(fields[1]);
       UV_sift.push_back(twovector(fields[2],fields[3]));
@@ -1114,16 +1118,15 @@ namespace videofunc
     //            cout << "xyz_map_ptr = " << xyz_map_ptr << endl;
     xyz_map_ptr->clear();
 
-    filefunc::ReadInfile(xyz_points_filename);
-    for (unsigned int i=0; i<filefunc::text_line.size(); i++)
+    numeric_text_reader xyz_reader(xyz_points_filename);
+    for (unsigned int i=0; i<xyz_reader.get_n_rows(); i++)
     {
-      vector<double> fields=
-        stringfunc::string_to_numbers(filefunc::text_line[i]);
+      const double* fields=xyz_reader.get_row(i);
       int curr_xyz_id=fields[0];
       threevector curr_xyz_point(fields[1],fields[2],fields[3]);
 
       vector<int> camera_IDs;
-      for (unsigned int j=4; j<fields.size(); j++)
+      for (unsigned int j=4; j<xyz_reader.get_n_values(i); j++)
       {
         int curr_camera_ID=fields[j];
         camera_IDs.push_back(curr_camera_ID);